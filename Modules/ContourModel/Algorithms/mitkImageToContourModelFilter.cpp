@@ -149,6 +149,9 @@ void mitk::ImageToContourModelFilter::Itk2DContourExtraction(const itk::Image<TP
     if (contour.IsNull())
       contour = mitk::ContourModel::New();
 
+    std::vector<mitk::Point3D> worldPoints;
+    worldPoints.reserve(currentPath->Size());
+
     for (unsigned int j = 0; j < currentPath->Size(); j++)
     {
       currentPoint[0] = currentPath->ElementAt(j)[0];
@@ -157,9 +160,11 @@ void mitk::ImageToContourModelFilter::Itk2DContourExtraction(const itk::Image<TP
 
       m_SliceGeometry->IndexToWorld(currentPoint, currentWorldPoint);
 
-      contour->AddVertex(currentWorldPoint);
+      worldPoints.push_back(currentWorldPoint);
     } // for2
 
+    contour->AddVertices(worldPoints);
+
     contour->Close();
 
   } // for1
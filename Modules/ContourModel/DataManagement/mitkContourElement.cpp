@@ -10,17 +10,34 @@ found in the LICENSE file.
 
 ============================================================================*/
 #include <algorithm>
+#include <cmath>
 #include <mitkContourElement.h>
 #include <vtkMath.h>
 
-mitk::ContourElement::ContourElement()
+namespace
+{
+  // below this number of vertices, a linear search is faster than building the spatial index
+  const mitk::ContourElement::VertexListType::size_type MinimumNumberOfVerticesForSpatialIndex = 256;
+
+  template <typename TEntry>
+  bool CompareCells(const TEntry &a, const TEntry &b)
+  {
+    return std::lexicographical_compare(a.Cell, a.Cell + 3, b.Cell, b.Cell + 3);
+  }
+}
+
+mitk::ContourElement::ContourElement() : m_SpatialIndexCellSize(0), m_SpatialIndexValid(false)
 {
   this->m_Vertices = new VertexListType();
   this->m_IsClosed = false;
 }
 
 mitk::ContourElement::ContourElement(const mitk::ContourElement &other)
-  : itk::LightObject(), m_Vertices(other.m_Vertices), m_IsClosed(other.m_IsClosed)
+  : itk::LightObject(),
+    m_Vertices(other.m_Vertices),
+    m_IsClosed(other.m_IsClosed),
+    m_SpatialIndexCellSize(0),
+    m_SpatialIndexValid(false)
 {
 }
 
@@ -32,21 +49,33 @@ mitk::ContourElement::~ContourElement()
 void mitk::ContourElement::AddVertex(mitk::Point3D &vertex, bool isControlPoint)
 {
   this->m_Vertices->push_back(new VertexType(vertex, isControlPoint));
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::AddVertex(VertexType &vertex)
 {
   this->m_Vertices->push_back(&vertex);
+  this->InvalidateSpatialIndex();
+}
+
+void mitk::ContourElement::AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint)
+{
+  for (auto point : points)
+    this->m_Vertices->push_back(new VertexType(point, isControlPoint));
+
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::AddVertexAtFront(mitk::Point3D &vertex, bool isControlPoint)
 {
   this->m_Vertices->push_front(new VertexType(vertex, isControlPoint));
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::AddVertexAtFront(VertexType &vertex)
 {
   this->m_Vertices->push_front(&vertex);
+  this->InvalidateSpatialIndex();
 }
 
 void mitk::ContourElement::InsertVertexAtIndex(mitk::Point3D &vertex, bool isControlPoint, int index)
@@ -56,6 +85,7 @@ void mitk::ContourElement::InsertVertexAtIndex(mitk::Point3D &vertex, bool isCon
     auto _where = this->m_Vertices->begin();
     _where += index;
     this->m_Vertices->insert(_where, new VertexType(vertex, isControlPoint));
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -64,6 +94,7 @@ void mitk::ContourElement::SetVertexAt(int pointId, const Point3D &point)
   if (pointId >= 0 && this->GetSize() > pointId)
   {
     this->m_Vertices->at(pointId)->Coordinates = point;
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -73,6 +104,7 @@ void mitk::ContourElement::SetVertexAt(int pointId, const VertexType *vertex)
   {
     this->m_Vertices->at(pointId)->Coordinates = vertex->Coordinates;
     this->m_Vertices->at(pointId)->IsControlPoint = vertex->IsControlPoint;
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -88,12 +120,12 @@ bool mitk::ContourElement::IsEmpty()
 
 mitk::ContourElement::VertexType *mitk::ContourElement::GetVertexAt(const mitk::Point3D &point, float eps)
 {
-  /* current version iterates over the whole deque - should some kind of an octree with spatial query*/
-
   if (eps > 0)
   {
-    // currently no method with better performance is available
-    return BruteForceGetVertexAt(point, eps);
+    if (this->m_Vertices->size() < MinimumNumberOfVerticesForSpatialIndex)
+      return BruteForceGetVertexAt(point, eps);
+
+    return IndexedGetVertexAt(point, eps);
   } // if eps < 0
   return nullptr;
 }
@@ -152,70 +184,86 @@ mitk::ContourElement::VertexType *mitk::ContourElement::BruteForceGetVertexAt(co
   return nullptr;
 }
 
-/*mitk::ContourElement::VertexType* mitk::ContourElement::OptimizedGetVertexAt(const mitk::Point3D &point, float eps)
+mitk::ContourElement::VertexType *mitk::ContourElement::IndexedGetVertexAt(const mitk::Point3D &point, float eps)
 {
-  if( (eps > 0) && (this->m_Vertices->size()>0) )
-  {
-      int k = 1;
-      int dim = 3;
-      int nPoints = this->m_Vertices->size();
-      ANNpointArray pointsArray;
-      ANNpoint queryPoint;
-      ANNidxArray indexArray;
-      ANNdistArray distanceArray;
-      ANNkd_tree* kdTree;
+  if (eps <= 0)
+    return nullptr;
 
-      queryPoint = annAllocPt(dim);
-      pointsArray = annAllocPts(nPoints, dim);
-      indexArray = new ANNidx[k];
-      distanceArray = new ANNdist[k];
+  if (!m_SpatialIndexValid || m_SpatialIndexCellSize != eps)
+    this->BuildSpatialIndex(eps);
 
+  long long queryCell[3];
+  for (int i = 0; i < 3; ++i)
+    queryCell[i] = static_cast<long long>(std::floor(point[i] / eps));
 
-       int i = 0;
-
-      //fill points array with our control points
-      for(VertexIterator it = this->m_Vertices->begin(); it != this->m_Vertices->end(); it++, i++)
+  // all vertices closer than eps lie in the cell of the query point or in one of its neighbors
+  std::vector<std::pair<int, double>> candidates;
+  SpatialIndexEntry key;
+  for (key.Cell[0] = queryCell[0] - 1; key.Cell[0] <= queryCell[0] + 1; ++key.Cell[0])
+  {
+    for (key.Cell[1] = queryCell[1] - 1; key.Cell[1] <= queryCell[1] + 1; ++key.Cell[1])
+    {
+      for (key.Cell[2] = queryCell[2] - 1; key.Cell[2] <= queryCell[2] + 1; ++key.Cell[2])
       {
-        mitk::Point3D cur = (*it)->Coordinates;
-        pointsArray[i][0]= cur[0];
-        pointsArray[i][1]= cur[1];
-        pointsArray[i][2]= cur[2];
+        auto range =
+          std::equal_range(m_SpatialIndex.begin(), m_SpatialIndex.end(), key, CompareCells<SpatialIndexEntry>);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          const double distance = it->Coordinates.EuclideanDistanceTo(point);
+          if (distance < eps)
+            candidates.emplace_back(it->Index, distance);
+        }
       }
+    }
+  }
 
-      //create the kd tree
-      kdTree = new ANNkd_tree(pointsArray,nPoints, dim);
+  // same choice as BruteForceGetVertexAt: of the vertices that were closer than all vertices before them, the last
+  // control point or the closest one
+  std::sort(candidates.begin(), candidates.end());
 
-      //fill mitk::Point3D into ANN query point
-      queryPoint[0] = point[0];
-      queryPoint[1] = point[1];
-      queryPoint[2] = point[2];
+  VertexType *closest = nullptr;
+  VertexType *closestControlPoint = nullptr;
+  double closestDistance = 0;
+  for (const auto &candidate : candidates)
+  {
+    if (closest == nullptr || candidate.second < closestDistance)
+    {
+      closest = (*m_Vertices)[candidate.first];
+      closestDistance = candidate.second;
+      if (closest->IsControlPoint)
+        closestControlPoint = closest;
+    }
+  }
 
-      //k nearest neighbour search
-      kdTree->annkSearch(queryPoint, k, indexArray, distanceArray, eps);
+  return closestControlPoint != nullptr ? closestControlPoint : closest;
+}
 
-      VertexType* ret = nullptr;
+void mitk::ContourElement::BuildSpatialIndex(float cellSize)
+{
+  m_SpatialIndex.clear();
+  m_SpatialIndex.reserve(m_Vertices->size());
 
-      try
-      {
-        ret = this->m_Vertices->at(indexArray[0]);
-      }
-      catch(std::out_of_range ex)
-      {
-        //ret stays nullptr
-        return ret;
-      }
+  int index = 0;
+  for (const VertexType *vertex : *m_Vertices)
+  {
+    SpatialIndexEntry entry;
+    for (int i = 0; i < 3; ++i)
+      entry.Cell[i] = static_cast<long long>(std::floor(vertex->Coordinates[i] / cellSize));
+    entry.Index = index++;
+    entry.Coordinates = vertex->Coordinates;
+    m_SpatialIndex.push_back(entry);
+  }
 
-      //clean up ANN
-      delete [] indexArray;
-      delete [] distanceArray;
-      delete kdTree;
-      annClose();
+  std::sort(m_SpatialIndex.begin(), m_SpatialIndex.end(), CompareCells<SpatialIndexEntry>);
 
-      return ret;
-  }
-  return nullptr;
+  m_SpatialIndexCellSize = cellSize;
+  m_SpatialIndexValid = true;
+}
+
+void mitk::ContourElement::InvalidateSpatialIndex()
+{
+  m_SpatialIndexValid = false;
 }
-*/
 
 mitk::ContourElement::VertexListType *mitk::ContourElement::GetVertexList()
 {
@@ -338,6 +386,7 @@ void mitk::ContourElement::Concatenate(mitk::ContourElement *other, bool check)
       }
       otherIt++;
     }
+    this->InvalidateSpatialIndex();
   }
 }
 
@@ -353,6 +402,7 @@ bool mitk::ContourElement::RemoveVertex(const VertexType *vertex)
     if ((*it) == vertex)
     {
       this->m_Vertices->erase(it);
+      this->InvalidateSpatialIndex();
       return true;
     }
 
@@ -390,6 +440,7 @@ bool mitk::ContourElement::RemoveVertexAt(int index)
   if (index >= 0 && static_cast<VertexListType::size_type>(index) < this->m_Vertices->size())
   {
     this->m_Vertices->erase(this->m_Vertices->begin() + index);
+    this->InvalidateSpatialIndex();
     return true;
   }
   else
@@ -417,6 +468,7 @@ bool mitk::ContourElement::RemoveVertexAt(mitk::Point3D &point, float eps)
         // approximate point found
         // now erase it
         this->m_Vertices->erase(it);
+        this->InvalidateSpatialIndex();
         return true;
       }
 
@@ -429,6 +481,7 @@ bool mitk::ContourElement::RemoveVertexAt(mitk::Point3D &point, float eps)
 void mitk::ContourElement::Clear()
 {
   this->m_Vertices->clear();
+  this->InvalidateSpatialIndex();
 }
 //----------------------------------------------------------------------
 void mitk::ContourElement::RedistributeControlVertices(const VertexType *selected, int period)
@@ -16,9 +16,8 @@ found in the LICENSE file.
 #include <MitkContourModelExports.h>
 #include <mitkNumericTypes.h>
 
-//#include <ANN/ANN.h>
-
 #include <deque>
+#include <vector>
 
 namespace mitk
 {
@@ -95,6 +94,12 @@ namespace mitk
     */
     virtual void AddVertex(VertexType &vertex);
 
+    /** \brief Add several vertices at the end of the contour
+    \param points - coordinates in 3D space.
+    \param isControlPoint - are the vertices special control points.
+    */
+    virtual void AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint);
+
     /** \brief Add a vertex at the front of the contour
     \param point - coordinates in 3D space.
     \param isControlPoint - is the vertex a control point.
@@ -133,6 +138,8 @@ namespace mitk
     /** \brief Returns the approximate nearest vertex a given posoition in 3D space
     \param point - query position in 3D space.
     \param eps - the error bound for search algorithm.
+
+    Large contours are searched with a spatial index, see IndexedGetVertexAt().
     */
     virtual VertexType *GetVertexAt(const mitk::Point3D &point, float eps);
 
@@ -208,11 +215,18 @@ namespace mitk
     */
     VertexType *BruteForceGetVertexAt(const mitk::Point3D &point, float eps);
 
-    /** \brief Returns the approximate nearest vertex a given posoition in 3D space
+    /** \brief Returns the same vertex as BruteForceGetVertexAt, using a grid of cells with the size eps.
+    The grid is built at the first query and rebuilt after the contour or eps changed.
     \param point - query position in 3D space.
     \param eps - the error bound for search algorithm.
     */
-    // VertexType* OptimizedGetVertexAt(const mitk::Point3D &point, float eps);
+    VertexType *IndexedGetVertexAt(const mitk::Point3D &point, float eps);
+
+    /** \brief Discard the spatial index of IndexedGetVertexAt.
+    Needs to be called after vertices were changed through their pointers. mitk::ContourModel does this
+    whenever it is modified.
+    */
+    void InvalidateSpatialIndex();
 
     VertexListType *GetControlVertices();
 
@@ -229,8 +243,23 @@ namespace mitk
     ContourElement(const mitk::ContourElement &other);
     ~ContourElement() override;
 
+    /** \brief Coordinates of a vertex with its index and grid cell, sorted by cell.
+    */
+    struct SpatialIndexEntry
+    {
+      long long Cell[3];
+      int Index;
+      mitk::Point3D Coordinates;
+    };
+
+    void BuildSpatialIndex(float cellSize);
+
     VertexListType *m_Vertices; // double ended queue with vertices
     bool m_IsClosed;
+
+    std::vector<SpatialIndexEntry> m_SpatialIndex;
+    float m_SpatialIndexCellSize;
+    bool m_SpatialIndexValid;
   };
 } // namespace mitk
 
@@ -68,6 +68,17 @@ void mitk::ContourModel::AddVertex(const VertexType *vertex, int timestep)
   }
 }
 
+void mitk::ContourModel::AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint, int timestep)
+{
+  if (!this->IsEmptyTimeStep(timestep))
+  {
+    this->m_ContourSeries[timestep]->AddVertices(points, isControlPoint);
+    this->InvokeEvent(ContourModelSizeChangeEvent());
+    this->Modified();
+    this->m_UpdateBoundingBox = true;
+  }
+}
+
 void mitk::ContourModel::AddVertexAtFront(mitk::Point3D &vertex, int timestep)
 {
   if (!this->IsEmptyTimeStep(timestep))
@@ -633,3 +644,13 @@ void mitk::ContourModel::ExecuteOperation(mitk::Operation * /*operation*/)
 {
   // not supported yet
 }
+
+void mitk::ContourModel::Modified() const
+{
+  for (const auto &contourElement : this->m_ContourSeries)
+  {
+    contourElement->InvalidateSpatialIndex();
+  }
+
+  Superclass::Modified();
+}
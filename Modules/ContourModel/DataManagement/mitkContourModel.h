@@ -146,6 +146,18 @@ namespace mitk
     */
     void AddVertex(mitk::Point3D &vertex, bool isControlPoint, int timestep = 0);
 
+    /** \brief Add several vertices to the end of the contour at once.
+    Unlike calling AddVertex for each point, the contour is modified and the size change event is sent only once.
+
+    \param points - coordinates of the vertices
+    \param isControlPoint - specifies the vertices to be handled in a special way
+    \param timestep - the timestep at which the vertices will be added ( default 0)
+
+    @Note Adding vertices to a timestep which exceeds the timebounds of the contour
+    will not add them, the TimeGeometry will not be expanded.
+    */
+    void AddVertices(const std::vector<mitk::Point3D> &points, bool isControlPoint = false, int timestep = 0);
+
     /** \brief Add a vertex to the contour at given timestep AT THE FRONT of the contour.
     The vertex is added at the FRONT of contour.
 
@@ -406,6 +418,11 @@ namespace mitk
     */
     void ExecuteOperation(Operation *operation) override;
 
+    /** \brief Also discards the spatial indices of the contour elements, as vertices may have been changed through
+    their pointers.
+    */
+    void Modified() const override;
+
     /** \brief Redistributes ontrol vertices with a given period (as number of vertices)
     \param period - the number of vertices between control points.
     \param timestep - at this timestep all lines will be rebuilt.
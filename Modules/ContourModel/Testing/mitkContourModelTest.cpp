@@ -396,6 +396,59 @@ static void TestContourModelAPI()
   MITK_TEST_CONDITION(contour2->GetNumberOfVertices() == 1, "Add call with another contour");
 }
 
+// Add many vertices at once and compare selection with the spatial index against the linear search
+static void TestAddVerticesAndSelectVertexAtLargeContour()
+{
+  mitk::ContourModel::Pointer contour = mitk::ContourModel::New();
+
+  std::vector<mitk::Point3D> points;
+  for (int i = 0; i < 2000; ++i)
+  {
+    mitk::Point3D p;
+    p[0] = 0.1 * (i % 50);
+    p[1] = 0.1 * (i / 50);
+    p[2] = 0.05 * (i % 3);
+    points.push_back(p);
+  }
+
+  contour->AddVertices(points);
+
+  MITK_TEST_CONDITION(contour->GetNumberOfVertices() == 2000, "Add vertices at once");
+
+  auto contourElement = mitk::ContourElement::New();
+  contourElement->AddVertices(points, false);
+  contourElement->GetVertexAt(777)->IsControlPoint = true;
+
+  bool sameVertices = true;
+  for (int i = 0; i < 200; ++i)
+  {
+    mitk::Point3D query;
+    query[0] = 0.037 * i - 1;
+    query[1] = 0.021 * i;
+    query[2] = 0.01 * (i % 7);
+
+    for (float eps : {0.01f, 0.08f, 0.3f})
+    {
+      const auto *expected = contourElement->BruteForceGetVertexAt(query, eps);
+      const auto *indexed = contourElement->IndexedGetVertexAt(query, eps);
+      if (expected != indexed)
+        sameVertices = false;
+    }
+  }
+  MITK_TEST_CONDITION(sameVertices, "Spatial index selects the same vertices as linear search");
+
+  // moving a vertex through the contour has to update the spatial index
+  mitk::Point3D target;
+  target[0] = target[1] = target[2] = 100;
+  contour->SelectVertexAt(points[5], 0.01);
+  mitk::Vector3D translation = target - points[5];
+  contour->ShiftSelectedVertex(translation);
+  contour->Deselect();
+
+  MITK_TEST_CONDITION(contour->SelectVertexAt(target, 0.01) && contour->GetIndex(contour->GetSelectedVertex()) == 5,
+                      "Select moved vertex");
+}
+
 int mitkContourModelTest(int /*argc*/, char * /*argv*/ [])
 {
   MITK_TEST_BEGIN("mitkContourModelTest")
@@ -414,6 +467,7 @@ int mitkContourModelTest(int /*argc*/, char * /*argv*/ [])
   TestSetVertices();
   TestSelectVertexAtWrongPosition();
   TestContourModelAPI();
+  TestAddVerticesAndSelectVertexAtLargeContour();
 
   MITK_TEST_END()
 }
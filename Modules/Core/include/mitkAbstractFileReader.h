@@ -106,6 +106,12 @@ namespace mitk
      */
     std::vector< std::string > GetReadFiles() override;
 
+    /**
+     * @return \c true by default. Readers which use global state (e.g. of a third party
+     * library) that is not protected against concurrent access must override this method.
+     */
+    bool IsThreadSafe() const override;
+
   protected:
     /**
      * @brief An input stream wrapper.
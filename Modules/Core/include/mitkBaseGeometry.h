@@ -26,8 +26,11 @@ found in the LICENSE file.
 #include <mitkAffineTransform3D.h>
 
 #include <mitkGeometryTransformHolder.h>
+#include <mitkGeometryTransformSnapshot.h>
 #include <vtkTransform.h>
 
+#include <mutex>
+
 class vtkMatrix4x4;
 class vtkMatrixToLinearTransform;
 class vtkLinearTransform;
@@ -247,6 +250,15 @@ namespace mitk
     //##@brief executes affine operations (translate, rotate, scale)
     void ExecuteOperation(Operation *operation) override;
 
+    //##Documentation
+    //## @brief Get an immutable copy of the IndexToWorldTransform and of its inverse
+    //##
+    //## The snapshot is cached until the IndexToWorldTransform is modified, so getting it is cheap.
+    //## It can be shared between threads and transforms single points or arrays of points without
+    //## touching the geometry again, e.g. in loops over many points.
+    //## \sa GeometryTransformSnapshot
+    GeometryTransformSnapshot::ConstPointer GetTransformSnapshot() const;
+
     //##Documentation
     //## @brief Convert world coordinates (in mm) of a \em point to (continuous!) index coordinates
     //## \warning If you need (discrete) integer index coordinates (e.g., for iterating easily over an image),
@@ -608,9 +620,13 @@ namespace mitk
 
     static const unsigned int m_NDimensions = 3;
 
-    mutable TransformType::Pointer m_InvertedTransform;
-
-    mutable unsigned long m_IndexToWorldTransformLastModified;
+    //##Documentation
+    //## @brief Cached snapshot of the IndexToWorldTransform (and its inverse)
+    //##
+    //## Read and replaced with std::atomic_load/std::atomic_store. m_TransformSnapshotMutex only
+    //## serializes rebuilding the snapshot after the transform was modified.
+    mutable GeometryTransformSnapshot::ConstPointer m_TransformSnapshot;
+    mutable std::mutex m_TransformSnapshotMutex;
 
     bool m_ImageGeometry;
 
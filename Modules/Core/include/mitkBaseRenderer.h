@@ -22,6 +22,7 @@ found in the LICENSE file.
 
 #include "mitkBindDispatcherInteractor.h"
 #include "mitkDispatcher.h"
+#include "mitkPropertyKey.h"
 
 #include <vtkRenderWindow.h>
 #include <vtkRenderer.h>
@@ -334,6 +335,10 @@ namespace mitk
       return m_Name.c_str();
     }
 
+    //##Documentation
+    //## @brief get the interned name of the Renderer, used for fast lookups of renderer specific properties
+    const PropertyKey &GetNameKey() const { return m_NameKey; }
+
     //##Documentation
     //## @brief get the x_size of the RendererWindow
     //## @note
@@ -505,6 +510,8 @@ namespace mitk
 
     std::string m_Name;
 
+    PropertyKey m_NameKey;
+
     double m_Bounds[6];
 
     bool m_EmptyWorldGeometry;
@@ -31,6 +31,7 @@ found in the LICENSE file.
 #include "mitkLevelWindow.h"
 #include <map>
 #include <set>
+#include <unordered_map>
 
 class vtkLinearTransform;
 
@@ -286,6 +287,45 @@ namespace mitk
       return false;
     }
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey, see
+     * GetProperty(const char *, const mitk::BaseRenderer *, bool) const.
+     *
+     * Neither the property key nor the name of the \a renderer are compared as strings,
+     * use this method (and the typed variants below) for lookups that are done for every
+     * rendering, e.g. in mappers.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey,
+                                    const mitk::BaseRenderer *renderer = nullptr,
+                                    bool fallBackOnDataProperties = true) const;
+
+    /**
+     * \brief Get the property of type T with the interned key \a propertyKey.
+     * \sa GetProperty(const PropertyKey &, const mitk::BaseRenderer *, bool) const
+     */
+    template <typename T>
+    bool GetProperty(T *&property, const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr) const
+    {
+      property = PropertyCast<T>(GetProperty(propertyKey, renderer));
+      return property != nullptr;
+    }
+
+    /**
+     * \brief Convenience access method for GenericProperty<T> properties with an interned key.
+     * \return \a true property was found
+     */
+    template <typename T>
+    bool GetPropertyValue(const PropertyKey &propertyKey, T &value, const mitk::BaseRenderer *renderer = nullptr) const
+    {
+      GenericProperty<T> *gp = PropertyCast<GenericProperty<T>>(GetProperty(propertyKey, renderer));
+      if (gp != nullptr)
+      {
+        value = gp->GetValue();
+        return true;
+      }
+      return false;
+    }
+
     /// \brief Get a set of all group tags from this node's property list
     GroupTagList GetGroupTags() const;
 
@@ -296,6 +336,14 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for bool properties with an interned key
+     * \return \a true property was found
+     */
+    bool GetBoolProperty(const PropertyKey &propertyKey,
+                         bool &boolValue,
+                         const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -583,6 +631,9 @@ namespace mitk
     /// \brief Map associating each BaseRenderer with its own PropertyList
     mutable MapOfPropertyLists m_MapOfPropertyLists;
 
+    /// \brief The lists of m_MapOfPropertyLists by the ids of the interned renderer names
+    mutable std::unordered_map<PropertyKey::IdType, PropertyList *> m_PropertyListIndex;
+
     DataInteractor::Pointer m_DataInteractor;
 
     /// \brief Timestamp of the last change of m_Data
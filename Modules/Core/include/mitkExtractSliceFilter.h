@@ -108,6 +108,28 @@ namespace mitk
       this->m_ZMax = zMax;
     }
 
+    /** \brief Restricts the output to a rectangular region of the slice.
+    * The region is given in pixel indices of the whole slice ([0, width) x [0, height)) and is clipped to the slice.
+    * The geometry of the output is adapted, so that it covers only the region. In combination with
+    * mitkVtkImageOverwrite this writes back only the region of an edited slice.
+    */
+    void SetOutputRegion(int x, int y, unsigned int width, unsigned int height)
+    {
+      this->m_OutputRegion[0] = x;
+      this->m_OutputRegion[1] = y;
+      this->m_OutputRegion[2] = static_cast<int>(width);
+      this->m_OutputRegion[3] = static_cast<int>(height);
+      this->m_UseOutputRegion = true;
+      this->Modified();
+    }
+
+    /** \brief Extracts the whole slice again (see SetOutputRegion()).*/
+    void ResetOutputRegion()
+    {
+      this->m_UseOutputRegion = false;
+      this->Modified();
+    }
+
     /** \brief Get the bounding box of the slice [xMin, xMax, yMin, yMax, zMin, zMax]
     * The method uses the input of the filter to calculate the bounds.
     * It is recommended to use
@@ -159,6 +181,8 @@ namespace mitk
       this->m_InterpolationMode = interpolation;
     }
 
+    ExtractSliceFilter::ResliceInterpolation GetInterpolationMode() const { return this->m_InterpolationMode; }
+
   protected:
     ExtractSliceFilter(vtkImageReslice *reslicer = nullptr);
     ~ExtractSliceFilter() override;
@@ -192,6 +216,11 @@ namespace mitk
 
     unsigned int m_Component;
 
+    bool m_UseOutputRegion;
+
+    /* Region of the slice [x, y, width, height] if m_UseOutputRegion is set.*/
+    int m_OutputRegion[4];
+
   private:
     BaseGeometry::ConstPointer m_ResliceTransform;
     /* Axis vectors of the relevant geometry. Set in GenerateOutputInformation() and also used in GenerateData().*/
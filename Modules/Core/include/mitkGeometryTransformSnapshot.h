@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKGEOMETRYTRANSFORMSNAPSHOT_H
+#define MITKGEOMETRYTRANSFORMSNAPSHOT_H
+
+#include <MitkCoreExports.h>
+#include <mitkAffineTransform3D.h>
+#include <mitkMatrix.h>
+#include <mitkPoint.h>
+#include <mitkVector.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace mitk
+{
+  /**
+   * \brief Immutable copy of the index-to-world transform of a geometry and of its inverse.
+   *
+   * A snapshot is obtained with BaseGeometry::GetTransformSnapshot(). It does not change when the
+   * geometry is modified afterwards and has no mutable state, so it can be shared between threads and
+   * used to transform points without calling into the ITK transform. The results are the ones of
+   * BaseGeometry::IndexToWorld() and BaseGeometry::WorldToIndex().
+   *
+   * Besides single points and vectors, arrays of points can be transformed in one call, either as
+   * Point3D arrays or as packed xyz coordinates (e.g. the data of a vtkPoints object). The input and
+   * output arrays may be the same.
+   */
+  class MITKCORE_EXPORT GeometryTransformSnapshot
+  {
+  public:
+    typedef std::shared_ptr<const GeometryTransformSnapshot> ConstPointer;
+
+    /** Copies the matrix and offset of the transform and computes the inverse matrix.*/
+    explicit GeometryTransformSnapshot(const AffineTransform3D *indexToWorldTransform);
+
+    /** False if the matrix is singular; the WorldToIndex methods throw an mitk::Exception in this case.*/
+    bool IsInvertible() const { return m_Invertible; }
+
+    const Matrix3D &GetIndexToWorldMatrix() const { return m_IndexToWorldMatrix; }
+    const Matrix3D &GetWorldToIndexMatrix() const { return m_WorldToIndexMatrix; }
+    const Vector3D &GetOffset() const { return m_Offset; }
+
+    /** MTime of the transform at the time the snapshot was taken.*/
+    itk::ModifiedTimeType GetTransformMTime() const { return m_TransformMTime; }
+
+    void IndexToWorld(const Point3D &pt_units, Point3D &pt_mm) const;
+    void IndexToWorld(const Vector3D &vec_units, Vector3D &vec_mm) const;
+    void WorldToIndex(const Point3D &pt_mm, Point3D &pt_units) const;
+    void WorldToIndex(const Vector3D &vec_mm, Vector3D &vec_units) const;
+
+    /** Transforms numberOfPoints points from index to world coordinates.*/
+    void IndexToWorld(const Point3D *pts_units, Point3D *pts_mm, std::size_t numberOfPoints) const;
+    /** Transforms numberOfPoints points given as packed xyz coordinates from index to world coordinates.*/
+    void IndexToWorld(const ScalarType *xyz_units, ScalarType *xyz_mm, std::size_t numberOfPoints) const;
+
+    /** Transforms numberOfPoints points from world to (continuous) index coordinates.*/
+    void WorldToIndex(const Point3D *pts_mm, Point3D *pts_units, std::size_t numberOfPoints) const;
+    /** Transforms numberOfPoints points given as packed xyz coordinates from world to (continuous) index coordinates.*/
+    void WorldToIndex(const ScalarType *xyz_mm, ScalarType *xyz_units, std::size_t numberOfPoints) const;
+
+  private:
+    void CheckInvertible() const;
+
+    Matrix3D m_IndexToWorldMatrix;
+    Matrix3D m_WorldToIndexMatrix;
+    Vector3D m_Offset;
+    itk::ModifiedTimeType m_TransformMTime;
+    bool m_Invertible;
+
+    /** Row major 3x4 matrices (matrix | offset) used by the batch methods. The world-to-index
+     * offset is applied before the matrix, as in BaseGeometry::WorldToIndex().*/
+    ScalarType m_IndexToWorld[12];
+    ScalarType m_WorldToIndex[12];
+  };
+}
+
+#endif // MITKGEOMETRYTRANSFORMSNAPSHOT_H
@@ -122,6 +122,14 @@ namespace mitk
      * @return A list of files that were loaded during the last call of Read.
      */
     virtual std::vector< std::string > GetReadFiles() = 0;
+
+    /**
+     * @brief Check whether this reader can be used while other instances of it read on other threads.
+     *
+     * IOUtil reads several files concurrently, each with its own reader instance, only
+     * if the selected readers return \c true.
+     */
+    virtual bool IsThreadSafe() const = 0;
   };
 
 } // namespace mitk
@@ -48,6 +48,18 @@ namespace mitk
     static std::string SIZE_Y();
     static std::string SIZE_Z();
     static std::string SIZE_T();
+
+    static std::string FIRST_TIME_STEP();
+    static std::string NUMBER_OF_TIME_STEPS();
+    static std::string REGION();
+    static std::string LOAD_TIME_STEPS_ON_DEMAND();
+
+    static std::string COMPRESSION();
+    static std::string COMPRESSION_GZIP();
+    static std::string COMPRESSION_NONE();
+    static std::string COMPRESSION_ENUM();
+    static std::string COMPRESSION_LEVEL();
+    static std::string NUMBER_OF_THREADS();
   };
 }
 
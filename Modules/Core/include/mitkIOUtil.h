@@ -293,6 +293,37 @@ namespace mitk
       return dynamic_cast<T*>(Load(path, options).at(0).GetPointer());
     }
 
+    /**
+    * @brief Load a range of time steps of an image file.
+    *
+    * This method calls Load(const std::string&, const IFileReader::Options&) with the
+    * time step options of mitk::ItkImageIO. Image formats whose ITK ImageIO supports
+    * streaming only read the requested time steps from the file.
+    *
+    * @param path The absolute file name including the file extension.
+    * @param firstTimeStep The first time step to read.
+    * @param numberOfTimeSteps The number of time steps to read, 0 reads all remaining time steps.
+    * @param loadOnDemand Read only the first time step immediately and the remaining ones when
+    * their data is accessed first.
+    * @return The loaded data.
+    * @throws mitk::Exception if \c path could not be loaded or the time steps are out of range.
+    *
+    * @sa mitk::IOConstants::FIRST_TIME_STEP(), mitk::IOConstants::NUMBER_OF_TIME_STEPS()
+    */
+    static std::vector<BaseData::Pointer> Load(const std::string &path,
+                                               TimeStepType firstTimeStep,
+                                               TimeStepType numberOfTimeSteps,
+                                               bool loadOnDemand = false);
+
+    template <typename T>
+    static typename T::Pointer Load(const std::string &path,
+                                    TimeStepType firstTimeStep,
+                                    TimeStepType numberOfTimeSteps,
+                                    bool loadOnDemand = false)
+    {
+      return dynamic_cast<T*>(Load(path, firstTimeStep, numberOfTimeSteps, loadOnDemand).at(0).GetPointer());
+    }
+
     /**
      * @brief Loads a list of file paths into the given DataStorage.
      *
@@ -313,6 +344,34 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of file paths concurrently into the given DataStorage.
+     *
+     * Reader selection and the options callback are processed on the calling thread,
+     * the files are read by up to \c numberOfThreads threads. Readers which are not
+     * thread-safe (see IFileReader::IsThreadSafe()) read on the calling thread as soon
+     * as they are selected, so files they read along (e.g. a DICOM series) are skipped
+     * before the options callback is called for them. The data is added to \c storage
+     * in the order of \c paths. If the options callback cancels, the files selected
+     * before are still read.
+     *
+     * @param paths A list of absolute file names including the file extension.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param numberOfThreads The maximum number of threads used for reading, 0 uses
+     * one thread per core and 1 reads all files on the calling thread.
+     * @param optionsCallback Pointer to a callback instance, see Load(const std::vector<std::string>&, DataStorage&, const ReaderOptionsFunctorBase*).
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception if an entry in \c paths could not be loaded.
+     */
+    static DataStorage::SetOfObjects::Pointer Load(const std::vector<std::string> &paths,
+                                                   DataStorage &storage,
+                                                   unsigned int numberOfThreads,
+                                                   const ReaderOptionsFunctorBase *optionsCallback);
+
+    static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
+                                               unsigned int numberOfThreads,
+                                               const ReaderOptionsFunctorBase *optionsCallback);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -408,7 +467,8 @@ namespace mitk
     static std::string Load(std::vector<LoadInfo> &loadInfos,
                             DataStorage::SetOfObjects *nodeResult,
                             DataStorage *ds,
-                            const ReaderOptionsFunctorBase *optionsCallback);
+                            const ReaderOptionsFunctorBase *optionsCallback,
+                            unsigned int numberOfThreads = 1);
 
     static std::string Save(const BaseData *data,
                             const std::string &mimeType,
@@ -31,6 +31,8 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <functional>
+
 class vtkImageData;
 
 namespace itk
@@ -259,6 +261,25 @@ namespace mitk
                                   int n = 0,
                                   ImportMemoryManagementType importMemoryManagement = CopyMemory);
 
+    //##Documentation
+    //## @brief Function that fills @a buffer with the data of the volume at time @a t in channel @a n.
+    //##
+    //## The buffer is allocated by the image and has the size of one volume. Returns false
+    //## if the data could not be provided.
+    typedef std::function<bool(int t, int n, void *buffer)> VolumeLoaderType;
+
+    //##Documentation
+    //## @brief Set a function that provides the data of volumes that are not set yet.
+    //##
+    //## Readers use this to load time steps lazily: the loader is called (with the
+    //## data arrays of the image locked) the first time a volume, a slice of it or the
+    //## complete channel is requested. Re-initializing the image removes the loader.
+    void SetVolumeLoader(const VolumeLoaderType &loader);
+
+    //##Documentation
+    //## @brief Check whether a loader for volumes that are not set yet is attached.
+    bool HasVolumeLoader() const;
+
     //##Documentation
     //## initialize new (or re-initialize) image information
     //## @warning Initialize() by pic assumes a plane, evenly spaced geometry starting at (0,0,0).
@@ -690,6 +711,8 @@ namespace mitk
     mutable ImageDataItemPointerArray m_Slices;
     mutable itk::SimpleFastMutexLock m_ImageDataArraysLock;
 
+    VolumeLoaderType m_VolumeLoader;
+
     unsigned int m_Dimension;
 
     unsigned int *m_Dimensions;
@@ -728,6 +751,10 @@ namespace mitk
     bool IsVolumeSet_unlocked(int t, int n) const;
     bool IsChannelSet_unlocked(int n) const;
 
+    /** Loads the volume at time t in channel n through m_VolumeLoader. Returns false if no loader
+        is attached or the loader failed. */
+    bool LoadVolume_unlocked(int t, int n) const;
+
     /** Stores all existing ImageReadAccessors */
     mutable std::vector<ImageAccessorBase *> m_Readers;
     /** Stores all existing ImageWriteAccessors */
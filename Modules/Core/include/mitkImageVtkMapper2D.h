@@ -19,6 +19,7 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkThickSlabProjector.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -34,7 +35,6 @@ class vtkImageExtractComponents;
 class vtkImageReslice;
 class vtkImageChangeInformation;
 class vtkPoints;
-class vtkMitkThickSlicesFilter;
 class vtkPolyData;
 class vtkMitkApplyLevelWindowToRGBFilter;
 class vtkMitkLevelWindowFilter;
@@ -171,8 +171,10 @@ namespace mitk
       vtkSmartPointer<vtkLookupTable> m_ColorLookupTable;
       /** \brief The actual reslicer (one per renderer) */
       mitk::ExtractSliceFilter::Pointer m_Reslicer;
-      /** \brief Filter for thick slices */
-      vtkSmartPointer<vtkMitkThickSlicesFilter> m_TSFilter;
+      /** \brief Projection of thick slices, keeps the slices of the slab while scrolling */
+      mitk::ThickSlabProjector::Pointer m_ThickSlabProjector;
+      /** \brief Sampling grid of the slab slices kept by m_ThickSlabProjector */
+      std::vector<double> m_ThickSlabFrame;
       /** \brief PolyData object containg all lines/points needed for outlining the contour.
             This container is used to save a computed contour for the next rendering execution.
             For instance, if you zoom or pann, there is no need to recompute the contour. */
@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include "mitkAbstractFileIO.h"
 
+#include <mitkTimeGeometry.h>
+
 #include <itkImageIOBase.h>
 
 namespace mitk
@@ -26,6 +28,20 @@ namespace mitk
    * Instantiating this class with a given itk::ImageIOBase instance
    * will register corresponding MITK reader/writer services for that
    * ITK ImageIO object.
+   *
+   * The reader options IOConstants::FIRST_TIME_STEP() and IOConstants::NUMBER_OF_TIME_STEPS()
+   * (0 reads all remaining time steps) restrict reading to a range of time steps,
+   * IOConstants::REGION() ("x y z sx sy sz" in voxels, empty for the whole image) to a
+   * spatial sub-region. ImageIOs that support streaming only read the requested part of
+   * the file. With IOConstants::LOAD_TIME_STEPS_ON_DEMAND() only the first requested time
+   * step is read immediately and the remaining ones when their data is accessed first, if
+   * the ImageIO can stream single time steps.
+   *
+   * The writer option IOConstants::COMPRESSION() selects gzip compression (if supported by
+   * the format) or no compression. NRRD files are compressed in chunks on
+   * IOConstants::NUMBER_OF_THREADS() threads (0 uses all cores) with the zlib level
+   * IOConstants::COMPRESSION_LEVEL(); they remain standard gzip encoded NRRD files and
+   * are decompressed with multiple threads when read by this class again.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -57,6 +73,14 @@ namespace mitk
 
     ItkImageIO *IOClone() const override;
 
+    void InitializeDefaultReaderOptions();
+    void InitializeDefaultWriterOptions();
+
+    /** Restricts the region read from the file according to the reader options and returns the first time step. */
+    TimeStepType RestrictIORegion(unsigned int ndim,
+                                  itk::ImageIORegion::IndexType &ioStart,
+                                  itk::ImageIORegion::SizeType &ioSize) const;
+
     itk::ImageIOBase::Pointer m_ImageIO;
 
     std::vector<std::string> m_DefaultMetaDataKeys;
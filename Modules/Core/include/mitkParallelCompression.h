@@ -0,0 +1,85 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelCompression_h
+#define mitkParallelCompression_h
+
+#include <MitkCoreExports.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Multithreaded gzip compression of large buffers.
+
+    The buffer is split into chunks that are deflated independently on a pool of
+    threads. The compressed chunks are concatenated to a single, standard conforming
+    gzip stream (each chunk but the last ends with a sync flush, so the chunks are
+    byte aligned and do not reference data of other chunks). The stream can be read
+    by every gzip implementation, e.g. the one used by the NRRD format.
+
+    If the compressed sizes of the chunks are known (WriteGzip() returns them), the
+    chunks can be inflated in parallel again by ReadGzip().
+
+    \ingroup IO
+  */
+  class MITKCORE_EXPORT ParallelCompression
+  {
+  public:
+    struct Parameters
+    {
+      Parameters();
+
+      /** zlib compression level from 1 (fastest) to 9 (best compression). */
+      int Level;
+
+      /** Number of uncompressed bytes per chunk. */
+      std::size_t ChunkSize;
+
+      /** Number of threads, 0 uses all available cores. */
+      unsigned int NumberOfThreads;
+    };
+
+    /** \brief Number of chunks a buffer of the given size is split into. */
+    static std::size_t GetNumberOfChunks(std::size_t size, std::size_t chunkSize);
+
+    /**
+      \brief Writes the data as one gzip stream to the current position of the stream.
+
+      \return The compressed sizes of the chunks (without gzip header and trailer).
+      \throws mitk::Exception if compressing or writing fails.
+    */
+    static std::vector<std::uint64_t> WriteGzip(std::ostream &stream,
+                                                const void *data,
+                                                std::size_t size,
+                                                const Parameters &parameters);
+
+    /**
+      \brief Reads a gzip stream written by WriteGzip() from the current position of the stream.
+
+      \param chunkSizes The compressed sizes of the chunks as returned by WriteGzip().
+      \param chunkSize The number of uncompressed bytes per chunk used for writing.
+      \throws mitk::Exception if the stream is corrupted or does not match the chunk sizes.
+    */
+    static void ReadGzip(std::istream &stream,
+                         const std::vector<std::uint64_t> &chunkSizes,
+                         std::size_t chunkSize,
+                         void *data,
+                         std::size_t size,
+                         unsigned int numberOfThreads = 0);
+  };
+}
+
+#endif
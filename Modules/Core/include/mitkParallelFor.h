@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFor_h
+#define mitkParallelFor_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace mitk
+{
+  /**
+    \brief Runs the iterations of a loop on the calling thread and a process-wide pool of worker threads.
+
+    The worker threads are started once and shared by all loops, so short loops (e.g. one per rendered
+    slice) do not pay for creating threads. Iterations are claimed in increasing order. The calling thread
+    takes part in the loop, so a loop finishes even if all worker threads are busy. This also makes nested
+    loops safe: an iteration that runs a loop itself never waits for iterations that no thread has started.
+
+    The constructor starts the worker threads on the loop. Iterations are run on the calling thread by
+    RunNext() and Wait(). If an iteration throws, the remaining iterations are skipped and Wait() rethrows
+    the first exception on the calling thread. The destructor skips the remaining iterations and waits for
+    the running ones, so the job may refer to local variables of the calling scope.
+
+    \sa ParallelFor(), ParallelForRanges()
+  */
+  class MITKCORE_EXPORT ParallelLoop
+  {
+  public:
+    using Job = std::function<void(std::size_t)>;
+
+    /**
+      \param numberOfIterations The job is called for each i in [0, numberOfIterations).
+      \param numberOfThreads The maximum number of threads including the calling thread, 0 uses all cores.
+      \param job The job which is called for each iteration.
+    */
+    ParallelLoop(std::size_t numberOfIterations, unsigned int numberOfThreads, Job job);
+    ~ParallelLoop();
+
+    ParallelLoop(const ParallelLoop &) = delete;
+    ParallelLoop &operator=(const ParallelLoop &) = delete;
+
+    /**
+      \brief Runs the next iteration that was not claimed yet on the calling thread.
+      \return false if all iterations were claimed already.
+    */
+    bool RunNext();
+
+    /**
+      \brief Runs the unclaimed iterations on the calling thread and waits for the others.
+      \throws The first exception thrown by an iteration.
+    */
+    void Wait();
+
+    /**
+      \brief Number of threads for a requested number (0 uses all cores) and a number of iterations.
+    */
+    static unsigned int GetNumberOfThreads(unsigned int requested, std::size_t numberOfIterations);
+
+  private:
+    struct State;
+    std::shared_ptr<State> m_State;
+  };
+
+  /**
+    \brief Calls job(i) for each i in [0, numberOfIterations) on up to numberOfThreads threads.
+
+    Blocks until all iterations are finished, see ParallelLoop.
+
+    \param numberOfThreads The maximum number of threads including the calling thread, 0 uses all cores.
+    \throws The first exception thrown by an iteration.
+  */
+  MITKCORE_EXPORT void ParallelFor(std::size_t numberOfIterations,
+                                   unsigned int numberOfThreads,
+                                   const std::function<void(std::size_t)> &job);
+
+  /**
+    \brief Splits [0, size) into consecutive ranges of about equal size and calls job(begin, end) for each
+    range on its own thread.
+
+    \param numberOfRanges The number of ranges and threads, 0 uses all cores. Never more than size ranges are used.
+    \throws The first exception thrown by the job.
+  */
+  MITKCORE_EXPORT void ParallelForRanges(std::size_t size,
+                                         unsigned int numberOfRanges,
+                                         const std::function<void(std::size_t, std::size_t)> &job);
+}
+
+#endif
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKPointSet_H_HEADER_INCLUDED
 
 #include "mitkBaseData.h"
+#include "mitkPointSetArrays.h"
 
 #include <itkDefaultDynamicMeshTraits.h>
 #include <itkMesh.h>
@@ -44,6 +45,10 @@ namespace mitk
    * (MapContainer). The points are best accessed by using a ConstIterator (as
    * defined in MapContainer); avoid access via index.
    *
+   * For large point sets (10^5 points and more), the points of a time step can be read as contiguous
+   * arrays with GetPointArrays() and set, inserted or removed in bulk with SetPointArrays(),
+   * InsertPoints() and RemovePoints(). These methods modify the point set only once.
+   *
    * The class internally uses an itk::Mesh for each time step, because
    * mitk::Mesh is derived from mitk::PointSet and needs the itk::Mesh structure
    * which is also derived from itk::PointSet. Thus several typedefs which seem
@@ -214,6 +219,32 @@ namespace mitk
     */
     PointsIterator RemovePointAtEnd(int t = 0);
 
+    /**
+    * \brief Insert the given points in world coordinate system with consecutive ids after the max id at time step t.
+    *
+    * Returns the id of the first inserted point.
+    */
+    PointIdentifier InsertPoints(const std::vector<PointType> &points, int t = 0);
+
+    /**
+    * \brief Remove the points with the given ids at timestep t, if existent. Returns the number of removed points.
+    */
+    unsigned int RemovePoints(const std::vector<PointIdentifier> &ids, int t = 0);
+
+    /**
+    * \brief Get the points of timestep t as contiguous arrays (in index coordinates of the geometry).
+    *
+    * The arrays are built on the first call and shared until the point set is modified; a modification
+    * creates new arrays on the next call, so returned arrays never change. An empty object is returned
+    * for a timestep that does not exist.
+    */
+    PointSetArrays::ConstPointer GetPointArrays(int t = 0) const;
+
+    /**
+    * \brief Replace all points of timestep t by the given arrays (in index coordinates of the geometry).
+    */
+    void SetPointArrays(const PointSetArrays *arrays, int t = 0);
+
     /**
     * \brief Swap a point at the given position (id) with the upper point (moveUpwards=true) or with the lower point
     * (moveUpwards=false).
@@ -287,6 +318,10 @@ namespace mitk
 
     DataType::PointsContainer::Pointer m_EmptyPointsContainer;
 
+    /** Contiguous copies of the timesteps and the modification times they were built for, see GetPointArrays().*/
+    mutable std::vector<PointSetArrays::ConstPointer> m_PointArrays;
+    mutable std::vector<itk::ModifiedTimeType> m_PointArraysTime;
+
     /**
     * @brief flag to indicate the right time to call SetBounds
     **/
@@ -0,0 +1,123 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKPOINTSETARRAYS_H
+#define MITKPOINTSETARRAYS_H
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+#include <mitkPoint.h>
+
+#include <itkIntTypes.h>
+#include <itkObject.h>
+#include <vtkSmartPointer.h>
+
+#include <cstddef>
+#include <vector>
+
+class vtkDoubleArray;
+class vtkPoints;
+
+namespace mitk
+{
+  /**
+   * \brief Contiguous storage of the points of one time step of a point set.
+   *
+   * The points are stored as columns: an array of packed xyz coordinates, an array of point
+   * identifiers and the optional selection and point specification columns, which are only
+   * allocated once a point is selected or gets a specification other than PTUNDEFINED. Points
+   * are addressed by their position; identifiers are kept in ascending order, so positions
+   * and identifiers can be mapped by binary search.
+   *
+   * Compared to the map containers of the itk::Mesh in mitk::PointSet, adding, removing and
+   * iterating many points (10^5 and more) is cheap, and the coordinates can be handed to VTK
+   * without copying them (see GetVtkPoints()).
+   *
+   * mitk::PointSet provides its time steps in this layout (PointSet::GetPointArrays()) and
+   * accepts them in bulk (PointSet::SetPointArrays()). Coordinates are index coordinates of
+   * the point set geometry, like the coordinates stored in the itk::Mesh.
+   */
+  class MITKCORE_EXPORT PointSetArrays : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(PointSetArrays, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    typedef itk::IdentifierType PointIdentifier;
+
+    std::size_t GetNumberOfPoints() const { return m_Ids.size(); }
+
+    /** Reserves memory for numberOfPoints points in all columns.*/
+    void Reserve(std::size_t numberOfPoints);
+
+    /** Removes all points.*/
+    void Clear();
+
+    /** Appends a point. The identifier has to be greater than the identifiers of all stored points.*/
+    void Append(const Point3D &point,
+                PointIdentifier id,
+                bool selected = false,
+                PointSpecificationType spec = PTUNDEFINED);
+
+    /** Appends numberOfPoints points given as packed xyz coordinates. The identifiers are taken
+     * from ids (ascending and greater than the identifiers of all stored points) or, if ids is
+     * nullptr, counted up from the largest stored identifier.*/
+    void Append(const ScalarType *xyz, std::size_t numberOfPoints, const PointIdentifier *ids = nullptr);
+
+    /** Removes the points at the given positions (in any order) by compacting all columns once.*/
+    void RemovePositions(std::vector<std::size_t> positions);
+
+    /** Packed xyz coordinates of all points.*/
+    const ScalarType *GetCoordinates() const { return m_Coordinates.data(); }
+    ScalarType *GetCoordinates() { return m_Coordinates.data(); }
+
+    Point3D GetPoint(std::size_t position) const;
+    void SetPoint(std::size_t position, const Point3D &point);
+
+    PointIdentifier GetId(std::size_t position) const { return m_Ids[position]; }
+    const std::vector<PointIdentifier> &GetIds() const { return m_Ids; }
+
+    /** Finds the position of the point with the given identifier; returns false if there is no such point.*/
+    bool FindPosition(PointIdentifier id, std::size_t &position) const;
+
+    bool HasSelection() const { return !m_Selected.empty(); }
+    bool IsSelected(std::size_t position) const { return !m_Selected.empty() && m_Selected[position] != 0; }
+    void SetSelected(std::size_t position, bool selected);
+
+    bool HasSpecifications() const { return !m_Specifications.empty(); }
+    PointSpecificationType GetSpecification(std::size_t position) const
+    {
+      return m_Specifications.empty() ? PTUNDEFINED : m_Specifications[position];
+    }
+    void SetSpecification(std::size_t position, PointSpecificationType spec);
+
+    /** vtkPoints sharing the coordinate array (no copy). The vtkPoints object stays the same, but
+     * its data is only valid until points are added or removed; call GetVtkPoints() again then.*/
+    vtkPoints *GetVtkPoints() const;
+
+  protected:
+    PointSetArrays();
+    ~PointSetArrays() override;
+
+  private:
+    std::vector<ScalarType> m_Coordinates;
+    std::vector<PointIdentifier> m_Ids;
+    std::vector<unsigned char> m_Selected;
+    std::vector<PointSpecificationType> m_Specifications;
+
+    vtkSmartPointer<vtkDoubleArray> m_VtkCoordinates;
+    vtkSmartPointer<vtkPoints> m_VtkPoints;
+    mutable itk::ModifiedTimeType m_VtkPointsTime;
+  };
+}
+
+#endif // MITKPOINTSETARRAYS_H
@@ -0,0 +1,92 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <MitkCoreExports.h>
+#include <mitkBaseProperty.h>
+
+#include <string>
+#include <typeinfo>
+
+namespace mitk
+{
+  /**
+   * @brief Interned name of a property.
+   *
+   * Every distinct property name is registered once in a process wide table and
+   * gets a unique integer id. PropertyList and DataNode keep an index of their
+   * properties by these ids, so that looking up a property by a PropertyKey
+   * neither hashes nor compares strings. A PropertyList only interns the names of
+   * its properties when it is first searched by a PropertyKey after a change.
+   *
+   * The table is never shrunk. It holds the names used as keys and the names of
+   * properties of lists searched by keys, so it is bounded by the number of
+   * distinct property names of the application rather than by the number of
+   * properties.
+   *
+   * Constructing a PropertyKey registers the name (which locks the table), so keys
+   * are meant to be constructed once and reused, e.g. as static constants of a mapper:
+   *
+   * \code
+   * static const mitk::PropertyKey visibleKey("visible");
+   * bool visible = true;
+   * node->GetBoolProperty(visibleKey, visible, renderer);
+   * \endcode
+   *
+   * The default constructed key refers to the empty name.
+   *
+   * @ingroup DataManagement
+   */
+  class MITKCORE_EXPORT PropertyKey
+  {
+  public:
+    typedef unsigned int IdType;
+
+    PropertyKey();
+    explicit PropertyKey(const std::string &name);
+    explicit PropertyKey(const char *name);
+
+    /** @brief The unique id of the name. */
+    IdType GetId() const { return m_Id; }
+
+    /** @brief The name; the reference is valid until the end of the process. */
+    const std::string &GetName() const { return *m_Name; }
+
+    bool operator==(const PropertyKey &other) const { return m_Id == other.m_Id; }
+    bool operator!=(const PropertyKey &other) const { return m_Id != other.m_Id; }
+
+  private:
+    IdType m_Id;
+    const std::string *m_Name;
+  };
+
+  /**
+   * @brief Casts a property to T, avoiding the dynamic_cast if the dynamic type is exactly T.
+   *
+   * @return nullptr if \a property is nullptr or not a T.
+   */
+  template <typename T>
+  T *PropertyCast(BaseProperty *property)
+  {
+    if (property == nullptr)
+      return nullptr;
+
+    if (typeid(*property) == typeid(T))
+      return static_cast<T *>(property);
+
+    return dynamic_cast<T *>(property);
+  }
+}
+
+#endif
@@ -17,12 +17,16 @@ found in the LICENSE file.
 #include "mitkGenericProperty.h"
 #include "mitkUIDGenerator.h"
 #include "mitkIPropertyOwner.h"
+#include "mitkPropertyKey.h"
 #include <MitkCoreExports.h>
 
 #include <itkObjectFactory.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace mitk
 {
@@ -94,6 +98,25 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * Looks the property up in an index by the id of the key, no strings are compared. The index is
+     * rebuilt by the first lookup after properties have been added or removed.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
+    /**
+     * @brief Get a property of type T by its interned key.
+     * @return @a true if a property of type T was found
+     */
+    template <typename T>
+    bool GetProperty(T *&property, const PropertyKey &propertyKey) const
+    {
+      property = PropertyCast<T>(this->GetProperty(propertyKey));
+      return property != nullptr;
+    }
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -125,6 +148,22 @@ namespace mitk
       return false;
     }
 
+    /**
+     * @brief Convenience access method for GenericProperty<T> properties by an interned key
+     * @return @a true property was found
+     */
+    template <typename T>
+    bool GetPropertyValue(const PropertyKey &propertyKey, T &value) const
+    {
+      GenericProperty<T> *gp = PropertyCast<GenericProperty<T>>(this->GetProperty(propertyKey));
+      if (gp != nullptr)
+      {
+        value = gp->GetValue();
+        return true;
+      }
+      return false;
+    }
+
     /**
     * @brief Convenience method to access the value of a BoolProperty
     */
@@ -246,6 +285,23 @@ namespace mitk
     PropertyMap m_Properties;
 
   private:
+    /** Inserts into m_Properties and invalidates m_PropertyIndex. */
+    void InsertProperty(const std::string &propertyKey, BaseProperty *property);
+
+    /** Erases from m_Properties and invalidates m_PropertyIndex. */
+    void EraseProperty(PropertyMap::iterator it);
+
+    /** Rebuilds m_PropertyIndex if it has been invalidated. */
+    void UpdatePropertyIndex() const;
+
+    /**
+     * The properties of m_Properties by the ids of their interned keys. Only built for lookups by
+     * PropertyKey, so adding and removing properties does not intern their names.
+     */
+    mutable std::unordered_map<PropertyKey::IdType, BaseProperty *> m_PropertyIndex;
+    mutable std::atomic<bool> m_PropertyIndexValid;
+    mutable std::mutex m_PropertyIndexMutex;
+
     itk::LightObject::Pointer InternalClone() const override;
   };
 
@@ -0,0 +1,135 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKTHICKSLABPROJECTOR_H
+#define MITKTHICKSLABPROJECTOR_H
+
+#include <MitkCoreExports.h>
+#include <mitkCommon.h>
+
+#include <itkObject.h>
+#include <vtkSmartPointer.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+class vtkImageData;
+
+namespace mitk
+{
+  /**
+   * \brief Projects a thick slab of slices onto one slice (MIP, MinIP, mean, ...) and keeps the
+   * state of the slab between updates.
+   *
+   * The slab consists of the slices [center - halfThickness, center + halfThickness], where the slice
+   * indices count along the slab direction. Slices are requested from a SliceExtractorType callback and
+   * kept until they leave the slab, so moving the slab by one slice only extracts the one slice that
+   * entered it. The projection modes and their results are the ones of vtkMitkThickSlicesFilter.
+   *
+   * The projection keeps a state that is updated incrementally when the slab moves:
+   * - SUM and MEAN use an accumulator, to which the entering slices are added and from which the
+   *   leaving slices are subtracted.
+   * - MIP and MINIP use a block decomposition of the slice indices (van Herk/Gil-Werman). Blocks have
+   *   the size of the slab, so every slab spans at most two blocks and its extremum is the combination
+   *   of a suffix extremum of the first and a prefix extremum of the second block. Prefix and suffix
+   *   extrema are computed once per block and reused while the slab moves through the block.
+   * - WEIGHTED is recomputed from the kept slices.
+   *
+   * All reductions run over the contiguous rows of the slices and are distributed over the shared worker threads
+   * of mitk::ParallelFor.
+   *
+   * Kept slices are only valid as long as the sampling of the slab does not change. Callers have to call
+   * Reset() whenever the image, its geometry, the slice orientation or the in-plane sampling changes.
+   */
+  class MITKCORE_EXPORT ThickSlabProjector : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ThickSlabProjector, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /** Callback extracting the slice with the given offset (in slices) to the slab center. The returned
+     * image must be a single component 2D image with the same extent and scalar type for all slices.*/
+    typedef std::function<vtkImageData *(int offset)> SliceExtractorType;
+
+    /** Discards all kept slices and projection states.*/
+    void Reset();
+
+    /** Number of threads used for the reductions; 0 (default) uses all available cores.*/
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /** Computes the projection of the slab [center - halfThickness, center + halfThickness].
+     * @param mode Projection mode as defined by vtkMitkThickSlicesFilter (MIP, SUM, WEIGHTED, MINIP, MEAN).
+     * @param center Index of the center slice. Consecutive calls with the same sampling of the slices use
+     * the same indexing, e.g. the index of the plane position along the normal in units of the slice distance.
+     * @param halfThickness Number of slices on each side of the center slice.
+     * @param extractor Callback for the slices that are not kept from previous calls.
+     * @return The projection (owned by the projector) with the extent and geometry of the center slice,
+     * or nullptr if a slice could not be extracted.*/
+    vtkImageData *Project(int mode, int center, int halfThickness, const SliceExtractorType &extractor);
+
+    /** Number of slices extracted by the last call of Project().*/
+    itkGetConstMacro(NumberOfExtractedSlices, unsigned int);
+
+  protected:
+    ThickSlabProjector();
+    ~ThickSlabProjector() override;
+
+  private:
+    typedef vtkSmartPointer<vtkImageData> SlicePointer;
+    typedef std::map<int, SlicePointer> SliceMapType;
+
+    template <typename TPixel>
+    void ProjectTemplate(int low, int high);
+
+    template <typename TPixel>
+    void ProjectExtremum(int low, int high, bool maximum);
+
+    template <typename TPixel>
+    void ProjectSum(int low, int high);
+
+    template <typename TPixel>
+    void ProjectWeighted(int low, int high);
+
+    template <typename TPixel>
+    vtkImageData *GetPrefixExtremum(int index, int blockStart, bool maximum);
+
+    template <typename TPixel>
+    vtkImageData *GetSuffixExtremum(int index, int blockEnd, bool maximum);
+
+    SlicePointer NewSliceLike(vtkImageData *slice) const;
+
+    unsigned int m_NumberOfThreads;
+    unsigned int m_NumberOfExtractedSlices;
+
+    int m_Mode;
+    int m_HalfThickness;
+
+    /** Slices of the current slab by index.*/
+    SliceMapType m_Slices;
+
+    /** Prefix and suffix extrema within the blocks of the MIP/MINIP decomposition, by index.*/
+    SliceMapType m_PrefixExtrema;
+    SliceMapType m_SuffixExtrema;
+
+    /** Sum of the slices [m_SumLow, m_SumHigh] for SUM/MEAN.*/
+    std::vector<double> m_Sum;
+    int m_SumLow;
+    int m_SumHigh;
+    unsigned int m_SumUpdates;
+
+    SlicePointer m_Output;
+  };
+}
+
+#endif // MITKTHICKSLABPROJECTOR_H
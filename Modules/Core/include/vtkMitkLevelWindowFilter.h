@@ -19,6 +19,8 @@ class vtkPiecewiseFunction;
 #include <vtkThreadedImageAlgorithm.h>
 
 #include <MitkCoreExports.h>
+
+#include <vector>
 /** Documentation
 * \brief Applies the grayvalue or color/opacity level window to scalar or RGB(A) images.
 *
@@ -28,6 +30,11 @@ class vtkPiecewiseFunction;
 *
 * The filter is also able to apply an opacity level window to RGBA images.
 *
+* Scalar images are mapped with a color table that is built once per update of the lookup table
+* (and opacity function) and shared by all threads: 8 and 16 bit images use a table holding the
+* RGBA value of every possible input value. Other scalar types are mapped with a quantized index into
+* the lookup table (vtkLookupTable with linear scale) or into a sampled color transfer function.
+*
 * \ingroup Renderer
 */
 class MITKCORE_EXPORT vtkMitkLevelWindowFilter : public vtkThreadedImageAlgorithm
@@ -75,6 +82,12 @@ protected:
    */
   void ThreadedExecute(vtkImageData *inData, vtkImageData *outData, int extent[6], int id) override;
 
+  /** Builds the lookup table and the color table for the scalar type of the input before
+   * the threads are started. See VTK documentation.*/
+  int RequestData(vtkInformation *request,
+                  vtkInformationVector **inputVector,
+                  vtkInformationVector *outputVector) override;
+
   //  /** Standard VTK filter method to apply the filter. See VTK documentation.*/
   int RequestInformation(vtkInformation *request,
                          vtkInformationVector **inputVector,
@@ -93,5 +106,32 @@ private:
   double m_MaxOpacity;
 
   double m_ClippingBounds[4];
+
+  /** \brief Rebuilds m_ColorTable if the lookup table, the opacity function or the scalar type changed.*/
+  void UpdateColorTable(int scalarType);
+
+  enum ColorTableType
+  {
+    NoColorTable,
+    /** One RGBA value per value of an 8 or 16 bit scalar type.*/
+    ValueColorTable,
+    /** RGBA values of a color transfer function sampled at m_ColorTableSize values over m_ColorTableRange.*/
+    QuantizedColorTable
+  };
+
+  /** RGBA values (4 chars in output order) of the current lookup table, see ColorTableType.*/
+  std::vector<unsigned int> m_ColorTable;
+  ColorTableType m_ColorTableType;
+  /** Index of the input value 0 in a ValueColorTable.*/
+  int m_ColorTableOffset;
+  /** Value range sampled by a QuantizedColorTable.*/
+  double m_ColorTableRange[2];
+
+  /** State m_ColorTable was built for.*/
+  int m_ColorTableScalarType;
+  vtkScalarsToColors *m_ColorTableLookupTable;
+  vtkMTimeType m_ColorTableLookupTableTime;
+  vtkPiecewiseFunction *m_ColorTableOpacityFunction;
+  vtkMTimeType m_ColorTableOpacityFunctionTime;
 };
 #endif
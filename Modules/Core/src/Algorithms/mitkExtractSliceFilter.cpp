@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include <vtkImageExtractComponents.h>
 #include <vtkLinearTransform.h>
 
+#include <algorithm>
+
 mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(0), m_XMax(0), m_YMin(0), m_YMax(0)
 {
   if (reslicer == nullptr)
@@ -45,6 +47,8 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_VtkOutputRequested = false;
   m_BackgroundLevel = -32768.0;
   m_Component = 0;
+  m_UseOutputRegion = false;
+  std::fill(m_OutputRegion, m_OutputRegion + 4, 0);
 }
 
 mitk::ExtractSliceFilter::~ExtractSliceFilter()
@@ -128,8 +132,10 @@ void mitk::ExtractSliceFilter::GenerateOutputInformation()
         // associated input image, regardless of the currently selected world
         // geometry.
         Vector3D rightInIndex, bottomInIndex;
-        inputTimeGeometry->GetGeometryForTimeStep(m_TimeStep)->WorldToIndex(right, rightInIndex);
-        inputTimeGeometry->GetGeometryForTimeStep(m_TimeStep)->WorldToIndex(bottom, bottomInIndex);
+        const GeometryTransformSnapshot::ConstPointer inputTransform =
+          inputTimeGeometry->GetGeometryForTimeStep(m_TimeStep)->GetTransformSnapshot();
+        inputTransform->WorldToIndex(right, rightInIndex);
+        inputTransform->WorldToIndex(bottom, bottomInIndex);
         extent[0] = rightInIndex.GetNorm();
         extent[1] = bottomInIndex.GetNorm();
       }
@@ -177,6 +183,17 @@ void mitk::ExtractSliceFilter::GenerateOutputInformation()
     } // ELSE we use the default values
   }
 
+  if (m_UseOutputRegion)
+  {
+    // restrict the extent to the requested region of the slice
+    const int regionXMin = std::min(std::max(xMin + m_OutputRegion[0], xMin), xMax);
+    const int regionYMin = std::min(std::max(yMin + m_OutputRegion[1], yMin), yMax);
+    xMax = std::max(std::min(regionXMin + m_OutputRegion[2], xMax), regionXMin);
+    yMax = std::max(std::min(regionYMin + m_OutputRegion[3], yMax), regionYMin);
+    xMin = regionXMin;
+    yMin = regionYMin;
+  }
+
 
   sliceOrigin += right * (m_OutPutSpacing[0] * 0.5);
   sliceOrigin += bottom * (m_OutPutSpacing[1] * 0.5);
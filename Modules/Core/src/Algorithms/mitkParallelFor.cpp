@@ -0,0 +1,219 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /**
+    Worker threads shared by all loops. The pool is never destroyed: joining threads while
+    static objects are destroyed or a library is unloaded may dead-lock on some platforms.
+  */
+  class WorkerPool
+  {
+  public:
+    static WorkerPool &GetInstance()
+    {
+      static auto *instance = new WorkerPool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+      return *instance;
+    }
+
+    unsigned int GetNumberOfThreads() const { return m_NumberOfThreads; }
+
+    void Post(std::function<void()> task)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push_back(std::move(task));
+      }
+      m_TaskAvailable.notify_one();
+    }
+
+  private:
+    explicit WorkerPool(unsigned int numberOfThreads) : m_NumberOfThreads(numberOfThreads)
+    {
+      for (unsigned int i = 0; i < numberOfThreads; ++i)
+        std::thread(&WorkerPool::Work, this).detach();
+    }
+
+    void Work()
+    {
+      while (true)
+      {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(m_Mutex);
+          m_TaskAvailable.wait(lock, [this]() { return !m_Tasks.empty(); });
+          task = std::move(m_Tasks.front());
+          m_Tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+    const unsigned int m_NumberOfThreads;
+    std::mutex m_Mutex;
+    std::condition_variable m_TaskAvailable;
+    std::deque<std::function<void()>> m_Tasks;
+  };
+}
+
+struct mitk::ParallelLoop::State
+{
+  State(std::size_t numberOfIterations, Job job)
+    : NumberOfIterations(numberOfIterations), Function(std::move(job)), NextIteration(0), NumberOfRunningThreads(0),
+      Stopped(false)
+  {
+  }
+
+  /** Claims and runs one iteration. Returns false if there is none left. */
+  bool RunNext()
+  {
+    // A thread counts as running before it claims an iteration, so Finish() cannot miss an iteration
+    // that is claimed concurrently. Threads that start after the loop finished do not touch the job.
+    ++NumberOfRunningThreads;
+
+    const std::size_t i = NextIteration++;
+    const bool claimed = i < NumberOfIterations && !Stopped;
+
+    if (claimed)
+    {
+      try
+      {
+        Function(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (!Error)
+          Error = std::current_exception();
+        Stopped = true;
+      }
+    }
+
+    if (0 == --NumberOfRunningThreads)
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Finished.notify_all();
+    }
+
+    return claimed;
+  }
+
+  /** Waits until no other thread runs an iteration. */
+  void WaitForRunningThreads()
+  {
+    std::unique_lock<std::mutex> lock(Mutex);
+    Finished.wait(lock, [this]() { return 0 == NumberOfRunningThreads; });
+  }
+
+  const std::size_t NumberOfIterations;
+  const Job Function;
+
+  std::atomic<std::size_t> NextIteration;
+  std::atomic<unsigned int> NumberOfRunningThreads;
+  std::atomic<bool> Stopped;
+
+  std::mutex Mutex;
+  std::condition_variable Finished;
+  std::exception_ptr Error;
+};
+
+mitk::ParallelLoop::ParallelLoop(std::size_t numberOfIterations, unsigned int numberOfThreads, Job job)
+  : m_State(std::make_shared<State>(numberOfIterations, std::move(job)))
+{
+  numberOfThreads = std::min(GetNumberOfThreads(numberOfThreads, numberOfIterations),
+                             WorkerPool::GetInstance().GetNumberOfThreads() + 1);
+
+  // the calling thread is the first thread of the loop
+  for (unsigned int t = 1; t < numberOfThreads; ++t)
+  {
+    std::shared_ptr<State> state = m_State;
+    WorkerPool::GetInstance().Post([state]() {
+      while (state->RunNext())
+      {
+      }
+    });
+  }
+}
+
+mitk::ParallelLoop::~ParallelLoop()
+{
+  m_State->Stopped = true;
+  m_State->WaitForRunningThreads();
+}
+
+bool mitk::ParallelLoop::RunNext()
+{
+  return m_State->RunNext();
+}
+
+void mitk::ParallelLoop::Wait()
+{
+  while (m_State->RunNext())
+  {
+  }
+
+  m_State->WaitForRunningThreads();
+
+  std::lock_guard<std::mutex> lock(m_State->Mutex);
+  if (m_State->Error)
+  {
+    auto error = m_State->Error;
+    m_State->Error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+unsigned int mitk::ParallelLoop::GetNumberOfThreads(unsigned int requested, std::size_t numberOfIterations)
+{
+  unsigned int numberOfThreads = requested;
+  if (numberOfThreads == 0)
+    numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  return static_cast<unsigned int>(
+    std::min<std::size_t>(numberOfThreads, std::max<std::size_t>(numberOfIterations, 1)));
+}
+
+void mitk::ParallelFor(std::size_t numberOfIterations,
+                       unsigned int numberOfThreads,
+                       const std::function<void(std::size_t)> &job)
+{
+  if (ParallelLoop::GetNumberOfThreads(numberOfThreads, numberOfIterations) < 2)
+  {
+    for (std::size_t i = 0; i < numberOfIterations; ++i)
+      job(i);
+    return;
+  }
+
+  ParallelLoop loop(numberOfIterations, numberOfThreads, job);
+  loop.Wait();
+}
+
+void mitk::ParallelForRanges(std::size_t size,
+                             unsigned int numberOfRanges,
+                             const std::function<void(std::size_t, std::size_t)> &job)
+{
+  numberOfRanges = ParallelLoop::GetNumberOfThreads(numberOfRanges, size);
+
+  auto rangeBegin = [size, numberOfRanges](std::size_t r) { return size * r / numberOfRanges; };
+
+  ParallelFor(numberOfRanges, numberOfRanges, [&](std::size_t r) { job(rangeBegin(r), rangeBegin(r + 1)); });
+}
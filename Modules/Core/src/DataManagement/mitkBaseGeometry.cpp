@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <iomanip>
+#include <memory>
 #include <sstream>
 
 #include <vtkMatrix4x4.h>
@@ -32,7 +33,6 @@ mitk::BaseGeometry::BaseGeometry()
   : Superclass(),
     mitk::OperationActor(),
     m_FrameOfReferenceID(0),
-    m_IndexToWorldTransformLastModified(0),
     m_ImageGeometry(false),
     m_ModifiedLockFlag(false),
     m_ModifiedCalledFlag(false)
@@ -45,7 +45,6 @@ mitk::BaseGeometry::BaseGeometry(const BaseGeometry &other)
   : Superclass(),
     mitk::OperationActor(),
     m_FrameOfReferenceID(other.m_FrameOfReferenceID),
-    m_IndexToWorldTransformLastModified(other.m_IndexToWorldTransformLastModified),
     m_ImageGeometry(other.m_ImageGeometry),
     m_ModifiedLockFlag(false),
     m_ModifiedCalledFlag(false)
@@ -417,46 +416,55 @@ bool mitk::BaseGeometry::IsIndexInside(const mitk::Point3D &index) const
   return inside;
 }
 
-void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D &pt_mm, mitk::Point3D &pt_units) const
+mitk::GeometryTransformSnapshot::ConstPointer mitk::BaseGeometry::GetTransformSnapshot() const
 {
-  mitk::Vector3D tempIn, tempOut;
-  const TransformType::OffsetType &offset = this->GetIndexToWorldTransform()->GetOffset();
-  tempIn = pt_mm.GetVectorFromOrigin() - offset;
+  const TransformType *transform = this->GetIndexToWorldTransform();
+
+  // the cached snapshot is read without locking as long as the transform was not modified
+  GeometryTransformSnapshot::ConstPointer snapshot = std::atomic_load(&m_TransformSnapshot);
+  if (snapshot && snapshot->GetTransformMTime() == transform->GetMTime())
+    return snapshot;
+
+  std::lock_guard<std::mutex> lock(m_TransformSnapshotMutex);
 
-  WorldToIndex(tempIn, tempOut);
+  // another thread may have rebuilt the snapshot in the meantime
+  snapshot = std::atomic_load(&m_TransformSnapshot);
+  if (!snapshot || snapshot->GetTransformMTime() != transform->GetMTime())
+  {
+    snapshot = std::make_shared<const GeometryTransformSnapshot>(transform);
+    std::atomic_store(&m_TransformSnapshot, snapshot);
+  }
 
-  pt_units = tempOut;
+  return snapshot;
 }
 
-void mitk::BaseGeometry::WorldToIndex(const mitk::Vector3D &vec_mm, mitk::Vector3D &vec_units) const
+void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D &pt_mm, mitk::Point3D &pt_units) const
 {
-  // Get WorldToIndex transform
-  if (m_IndexToWorldTransformLastModified != this->GetIndexToWorldTransform()->GetMTime())
+  const GeometryTransformSnapshot::ConstPointer snapshot = this->GetTransformSnapshot();
+  if (!snapshot->IsInvertible())
   {
-    if (!m_InvertedTransform)
-    {
-      m_InvertedTransform = TransformType::New();
-    }
-    if (!this->GetIndexToWorldTransform()->GetInverse(m_InvertedTransform.GetPointer()))
-    {
-      itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed.");
-    }
-    m_IndexToWorldTransformLastModified = this->GetIndexToWorldTransform()->GetMTime();
+    itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed. Matrix was: "
+                      << std::endl
+                      << snapshot->GetIndexToWorldMatrix());
   }
 
+  snapshot->WorldToIndex(pt_mm, pt_units);
+}
+
+void mitk::BaseGeometry::WorldToIndex(const mitk::Vector3D &vec_mm, mitk::Vector3D &vec_units) const
+{
+  // Get WorldToIndex transform
+  const GeometryTransformSnapshot::ConstPointer snapshot = this->GetTransformSnapshot();
+
   // Check for valid matrix inversion
-  const TransformType::MatrixType &inverse = m_InvertedTransform->GetMatrix();
-  if (inverse.GetVnlMatrix().has_nans())
+  if (!snapshot->IsInvertible())
   {
     itkExceptionMacro("Internal ITK matrix inversion error, cannot proceed. Matrix was: "
                       << std::endl
-                      << this->GetIndexToWorldTransform()->GetMatrix()
-                      << "Suggested inverted matrix is:"
-                      << std::endl
-                      << inverse);
+                      << snapshot->GetIndexToWorldMatrix());
   }
 
-  vec_units = inverse * vec_mm;
+  snapshot->WorldToIndex(vec_mm, vec_units);
 }
 
 void mitk::BaseGeometry::WorldToIndex(const mitk::Point3D & /*atPt3d_mm*/,
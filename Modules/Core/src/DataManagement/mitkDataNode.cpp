@@ -204,7 +204,10 @@ mitk::PropertyList *mitk::DataNode::GetPropertyList(const std::string &rendererN
   mitk::PropertyList::Pointer &propertyList = m_MapOfPropertyLists[rendererName];
 
   if (propertyList.IsNull())
+  {
     propertyList = mitk::PropertyList::New();
+    m_PropertyListIndex[PropertyKey(rendererName).GetId()] = propertyList;
+  }
 
   assert(m_MapOfPropertyLists[rendererName].IsNotNull());
 
@@ -242,6 +245,31 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey,
+                                                const mitk::BaseRenderer *renderer,
+                                                bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer)
+  {
+    auto it = m_PropertyListIndex.find(renderer->GetNameKey().GetId());
+
+    if (m_PropertyListIndex.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -272,6 +300,18 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey,
+                                     bool &boolValue,
+                                     const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = PropertyCast<mitk::BoolProperty>(GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkGeometryTransformSnapshot.h"
+#include "mitkExceptionMacro.h"
+
+namespace
+{
+  // Both kernels sum up the matrix products in the order of itk::Matrix, so the results are the ones of
+  // itk::MatrixOffsetTransformBase::TransformPoint() and of BaseGeometry::WorldToIndex().
+  inline void TransformIndexToWorld(const mitk::ScalarType *m, const mitk::ScalarType *in, mitk::ScalarType *out)
+  {
+    const mitk::ScalarType x = in[0], y = in[1], z = in[2];
+    out[0] = (m[0] * x + m[1] * y + m[2] * z) + m[3];
+    out[1] = (m[4] * x + m[5] * y + m[6] * z) + m[7];
+    out[2] = (m[8] * x + m[9] * y + m[10] * z) + m[11];
+  }
+
+  inline void TransformWorldToIndex(const mitk::ScalarType *m, const mitk::ScalarType *in, mitk::ScalarType *out)
+  {
+    const mitk::ScalarType x = in[0] - m[3], y = in[1] - m[7], z = in[2] - m[11];
+    out[0] = m[0] * x + m[1] * y + m[2] * z;
+    out[1] = m[4] * x + m[5] * y + m[6] * z;
+    out[2] = m[8] * x + m[9] * y + m[10] * z;
+  }
+}
+
+mitk::GeometryTransformSnapshot::GeometryTransformSnapshot(const AffineTransform3D *indexToWorldTransform)
+  : m_IndexToWorldMatrix(indexToWorldTransform->GetMatrix()),
+    m_Offset(indexToWorldTransform->GetOffset()),
+    m_TransformMTime(indexToWorldTransform->GetMTime()),
+    m_Invertible(true)
+{
+  // invert a copy of the matrix, the inverse cached by the transform must not be touched here
+  try
+  {
+    m_WorldToIndexMatrix = m_IndexToWorldMatrix.GetInverse();
+    m_Invertible = !m_WorldToIndexMatrix.GetVnlMatrix().has_nans();
+  }
+  catch (...)
+  {
+    m_Invertible = false;
+  }
+
+  if (!m_Invertible)
+    m_WorldToIndexMatrix.Fill(0);
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      m_IndexToWorld[4 * i + j] = m_IndexToWorldMatrix[i][j];
+      m_WorldToIndex[4 * i + j] = m_WorldToIndexMatrix[i][j];
+    }
+    m_IndexToWorld[4 * i + 3] = m_Offset[i];
+    m_WorldToIndex[4 * i + 3] = m_Offset[i];
+  }
+}
+
+void mitk::GeometryTransformSnapshot::CheckInvertible() const
+{
+  if (!m_Invertible)
+  {
+    mitkThrow() << "Matrix inversion error, cannot transform from world to index coordinates. Matrix was: "
+                << std::endl
+                << m_IndexToWorldMatrix;
+  }
+}
+
+void mitk::GeometryTransformSnapshot::IndexToWorld(const Point3D &pt_units, Point3D &pt_mm) const
+{
+  TransformIndexToWorld(m_IndexToWorld, pt_units.GetDataPointer(), pt_mm.GetDataPointer());
+}
+
+void mitk::GeometryTransformSnapshot::IndexToWorld(const Vector3D &vec_units, Vector3D &vec_mm) const
+{
+  vec_mm = m_IndexToWorldMatrix * vec_units;
+}
+
+void mitk::GeometryTransformSnapshot::WorldToIndex(const Point3D &pt_mm, Point3D &pt_units) const
+{
+  this->CheckInvertible();
+  TransformWorldToIndex(m_WorldToIndex, pt_mm.GetDataPointer(), pt_units.GetDataPointer());
+}
+
+void mitk::GeometryTransformSnapshot::WorldToIndex(const Vector3D &vec_mm, Vector3D &vec_units) const
+{
+  this->CheckInvertible();
+  vec_units = m_WorldToIndexMatrix * vec_mm;
+}
+
+void mitk::GeometryTransformSnapshot::IndexToWorld(const Point3D *pts_units,
+                                                   Point3D *pts_mm,
+                                                   std::size_t numberOfPoints) const
+{
+  for (std::size_t i = 0; i < numberOfPoints; ++i)
+  {
+    TransformIndexToWorld(m_IndexToWorld, pts_units[i].GetDataPointer(), pts_mm[i].GetDataPointer());
+  }
+}
+
+void mitk::GeometryTransformSnapshot::IndexToWorld(const ScalarType *xyz_units,
+                                                   ScalarType *xyz_mm,
+                                                   std::size_t numberOfPoints) const
+{
+  for (std::size_t i = 0; i < 3 * numberOfPoints; i += 3)
+  {
+    TransformIndexToWorld(m_IndexToWorld, xyz_units + i, xyz_mm + i);
+  }
+}
+
+void mitk::GeometryTransformSnapshot::WorldToIndex(const Point3D *pts_mm,
+                                                   Point3D *pts_units,
+                                                   std::size_t numberOfPoints) const
+{
+  this->CheckInvertible();
+  for (std::size_t i = 0; i < numberOfPoints; ++i)
+  {
+    TransformWorldToIndex(m_WorldToIndex, pts_mm[i].GetDataPointer(), pts_units[i].GetDataPointer());
+  }
+}
+
+void mitk::GeometryTransformSnapshot::WorldToIndex(const ScalarType *xyz_mm,
+                                                   ScalarType *xyz_units,
+                                                   std::size_t numberOfPoints) const
+{
+  this->CheckInvertible();
+  for (std::size_t i = 0; i < 3 * numberOfPoints; i += 3)
+  {
+    TransformWorldToIndex(m_WorldToIndex, xyz_mm + i, xyz_units + i);
+  }
+}
@@ -293,6 +293,10 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
     return m_Slices[pos] = sl;
   }
 
+  // is the volume of the slice not loaded yet?
+  if (LoadVolume_unlocked(t, n))
+    return GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+
   // slice is unavailable. Can we calculate it?
   if ((GetSource().IsNotNull()) && (GetSource()->Updating() == false))
   {
@@ -424,6 +428,10 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
     return m_Volumes[pos] = vol;
   }
 
+  // is the volume not loaded yet?
+  if (LoadVolume_unlocked(t, n))
+    return m_Volumes[pos];
+
   // volume is unavailable. Can we calculate it?
   if ((GetSource().IsNotNull()) && (GetSource()->Updating() == false))
   {
@@ -472,6 +480,16 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
   if ((ch.GetPointer() != nullptr) && (ch->IsComplete()))
     return ch;
 
+  // load the volumes that are not loaded yet, so that they can be combined below
+  if (m_VolumeLoader)
+  {
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      if (IsVolumeSet_unlocked(t, n) == false)
+        LoadVolume_unlocked(t, n);
+    }
+  }
+
   // let's see if all volumes are set, so that we can (could) combine them to a channel
   if (IsChannelSet_unlocked(n))
   {
@@ -633,6 +651,51 @@ bool mitk::Image::IsVolumeSet_unlocked(int t, int n) const
   return true;
 }
 
+bool mitk::Image::LoadVolume_unlocked(int t, int n) const
+{
+  if (!m_VolumeLoader)
+    return false;
+
+  mitk::PixelType chPixelType = this->m_ImageDescriptor->GetChannelTypeById(n);
+  const size_t ptypeSize = chPixelType.GetSize();
+
+  ImageDataItemPointer vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, nullptr, true);
+  if (!m_VolumeLoader(t, n, vol->GetData()))
+  {
+    MITK_ERROR << "Loading volume " << t << " of channel " << n << " failed.";
+    return false;
+  }
+
+  // slices that have been set before the volume was loaded overwrite the loaded data
+  size_t size = m_OffsetTable[2] * (ptypeSize);
+  for (unsigned int s = 0; s < m_Dimensions[2]; ++s)
+  {
+    int posSl = GetSliceIndex(s, t, n);
+    ImageDataItemPointer sl = m_Slices[posSl];
+    if (sl.GetPointer() != nullptr)
+    {
+      std::memcpy(static_cast<char *>(vol->GetData()) + ((size_t)s) * size, sl->GetData(), size);
+      m_Slices[posSl] = nullptr;
+    }
+  }
+
+  vol->SetComplete(true);
+  m_Volumes[GetVolumeIndex(t, n)] = vol;
+  return true;
+}
+
+void mitk::Image::SetVolumeLoader(const VolumeLoaderType &loader)
+{
+  MutexHolder lock(m_ImageDataArraysLock);
+  m_VolumeLoader = loader;
+}
+
+bool mitk::Image::HasVolumeLoader() const
+{
+  MutexHolder lock(m_ImageDataArraysLock);
+  return static_cast<bool>(m_VolumeLoader);
+}
+
 bool mitk::Image::IsChannelSet(int n) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
@@ -842,6 +905,7 @@ void mitk::Image::Initialize(const mitk::PixelType &type,
 {
   Clear();
 
+  m_VolumeLoader = nullptr;
   m_Dimension = dimension;
 
   if (!dimensions)
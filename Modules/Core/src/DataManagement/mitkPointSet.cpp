@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include "mitkInteractionConst.h"
 #include "mitkPointOperation.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <mitkNumericTypes.h>
 
@@ -425,6 +426,174 @@ mitk::PointSet::PointsIterator mitk::PointSet::RemovePointAtEnd(int t)
   return m_EmptyPointsContainer->End();
 }
 
+mitk::PointSet::PointIdentifier mitk::PointSet::InsertPoints(const std::vector<PointType> &points, int t)
+{
+  // Adapt the size of the data vector if necessary
+  this->Expand(t + 1);
+
+  DataType *pointSet = m_PointSetSeries[t];
+  if (pointSet->GetPointData() == nullptr)
+  {
+    pointSet->SetPointData(PointDataContainer::New());
+  }
+
+  PointIdentifier id = 0;
+  if (pointSet->GetNumberOfPoints() > 0)
+  {
+    PointsIterator it = --End(t);
+    id = it.Index();
+    ++id;
+  }
+  const PointIdentifier firstId = id;
+
+  if (points.empty())
+  {
+    return firstId;
+  }
+
+  std::vector<PointType> indexPoints(points.size());
+  this->GetGeometry(t)->GetTransformSnapshot()->WorldToIndex(points.data(), indexPoints.data(), points.size());
+
+  // all new ids are larger than the existing ones, so every point is inserted at the end of the maps
+  PointsContainer::STLContainerType &pointMap = pointSet->GetPoints()->CastToSTLContainer();
+  PointDataContainer::STLContainerType &pointDataMap = pointSet->GetPointData()->CastToSTLContainer();
+  for (const auto &indexPoint : indexPoints)
+  {
+    PointDataType defaultPointData;
+    defaultPointData.id = id;
+    defaultPointData.selected = false;
+    defaultPointData.pointSpec = mitk::PTUNDEFINED;
+
+    pointMap.emplace_hint(pointMap.end(), id, indexPoint);
+    pointDataMap.emplace_hint(pointDataMap.end(), id, defaultPointData);
+    ++id;
+  }
+  pointSet->GetPoints()->Modified();
+  pointSet->GetPointData()->Modified();
+
+  // boundingbox has to be computed anyway
+  m_CalculateBoundingBox = true;
+  this->Modified();
+
+  return firstId;
+}
+
+unsigned int mitk::PointSet::RemovePoints(const std::vector<PointIdentifier> &ids, int t)
+{
+  unsigned int numberOfRemovedPoints = 0;
+
+  if ((unsigned int)t < m_PointSetSeries.size())
+  {
+    DataType *pointSet = m_PointSetSeries[t];
+
+    PointsContainer *points = pointSet->GetPoints();
+    PointDataContainer *pdata = pointSet->GetPointData();
+
+    for (const auto id : ids)
+    {
+      if (points->IndexExists(id))
+      {
+        points->DeleteIndex(id);
+        if (pdata != nullptr)
+          pdata->DeleteIndex(id);
+        ++numberOfRemovedPoints;
+      }
+    }
+  }
+
+  if (numberOfRemovedPoints > 0)
+  {
+    m_CalculateBoundingBox = true;
+    this->Modified();
+  }
+  return numberOfRemovedPoints;
+}
+
+mitk::PointSetArrays::ConstPointer mitk::PointSet::GetPointArrays(int t) const
+{
+  if (t < 0 || t >= static_cast<int>(m_PointSetSeries.size()))
+  {
+    return PointSetArrays::New().GetPointer();
+  }
+
+  if (m_PointArrays.size() != m_PointSetSeries.size())
+  {
+    m_PointArrays.resize(m_PointSetSeries.size());
+    m_PointArraysTime.resize(m_PointSetSeries.size(), 0);
+  }
+
+  DataType *pointSet = m_PointSetSeries[t];
+  PointsContainer *points = pointSet->GetPoints();
+  PointDataContainer *pdata = pointSet->GetPointData();
+
+  itk::ModifiedTimeType time = std::max(this->GetMTime(), std::max(pointSet->GetMTime(), points->GetMTime()));
+  if (pdata != nullptr)
+  {
+    time = std::max(time, pdata->GetMTime());
+  }
+
+  if (m_PointArrays[t].IsNull() || m_PointArraysTime[t] != time)
+  {
+    PointSetArrays::Pointer arrays = PointSetArrays::New();
+    arrays->Reserve(points->Size());
+
+    for (PointsIterator it = points->Begin(); it != points->End(); ++it)
+    {
+      PointDataType pointData;
+      if (pdata != nullptr && pdata->GetElementIfIndexExists(it.Index(), &pointData))
+      {
+        arrays->Append(it.Value(), it.Index(), pointData.selected, pointData.pointSpec);
+      }
+      else
+      {
+        arrays->Append(it.Value(), it.Index());
+      }
+    }
+
+    m_PointArrays[t] = arrays.GetPointer();
+    m_PointArraysTime[t] = time;
+  }
+
+  return m_PointArrays[t];
+}
+
+void mitk::PointSet::SetPointArrays(const PointSetArrays *arrays, int t)
+{
+  if (arrays == nullptr || t < 0)
+  {
+    return;
+  }
+
+  // Adapt the size of the data vector if necessary
+  this->Expand(t + 1);
+
+  PointsContainer::Pointer points = PointsContainer::New();
+  PointDataContainer::Pointer pointData = PointDataContainer::New();
+
+  // the ids of the arrays are ascending, so every point is inserted at the end of the maps
+  PointsContainer::STLContainerType &pointMap = points->CastToSTLContainer();
+  PointDataContainer::STLContainerType &pointDataMap = pointData->CastToSTLContainer();
+  for (std::size_t i = 0; i < arrays->GetNumberOfPoints(); ++i)
+  {
+    const PointIdentifier id = arrays->GetId(i);
+
+    PointDataType data;
+    data.id = id;
+    data.selected = arrays->IsSelected(i);
+    data.pointSpec = arrays->GetSpecification(i);
+
+    pointMap.emplace_hint(pointMap.end(), id, arrays->GetPoint(i));
+    pointDataMap.emplace_hint(pointDataMap.end(), id, data);
+  }
+
+  m_PointSetSeries[t]->SetPoints(points);
+  m_PointSetSeries[t]->SetPointData(pointData);
+
+  // boundingbox has to be computed anyway
+  m_CalculateBoundingBox = true;
+  this->Modified();
+}
+
 bool mitk::PointSet::SwapPointPosition(PointIdentifier id, bool moveUpwards, int t)
 {
   if (IndexExists(id, t))
@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPointSetArrays.h"
+#include "mitkExceptionMacro.h"
+
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+
+#include <algorithm>
+
+mitk::PointSetArrays::PointSetArrays()
+  : m_VtkCoordinates(vtkSmartPointer<vtkDoubleArray>::New()),
+    m_VtkPoints(vtkSmartPointer<vtkPoints>::New()),
+    m_VtkPointsTime(0)
+{
+  m_VtkCoordinates->SetNumberOfComponents(3);
+  m_VtkPoints->SetData(m_VtkCoordinates);
+}
+
+mitk::PointSetArrays::~PointSetArrays()
+{
+}
+
+void mitk::PointSetArrays::Reserve(std::size_t numberOfPoints)
+{
+  m_Coordinates.reserve(3 * numberOfPoints);
+  m_Ids.reserve(numberOfPoints);
+  if (!m_Selected.empty())
+    m_Selected.reserve(numberOfPoints);
+  if (!m_Specifications.empty())
+    m_Specifications.reserve(numberOfPoints);
+}
+
+void mitk::PointSetArrays::Clear()
+{
+  m_Coordinates.clear();
+  m_Ids.clear();
+  m_Selected.clear();
+  m_Specifications.clear();
+  this->Modified();
+}
+
+void mitk::PointSetArrays::Append(const Point3D &point,
+                                  PointIdentifier id,
+                                  bool selected,
+                                  PointSpecificationType spec)
+{
+  if (!m_Ids.empty() && id <= m_Ids.back())
+  {
+    mitkThrow() << "Point identifier " << id << " is not greater than the last identifier " << m_Ids.back();
+  }
+
+  m_Coordinates.insert(m_Coordinates.end(), point.GetDataPointer(), point.GetDataPointer() + 3);
+  m_Ids.push_back(id);
+
+  if (!m_Selected.empty() || selected)
+  {
+    m_Selected.resize(m_Ids.size() - 1, 0);
+    m_Selected.push_back(selected ? 1 : 0);
+  }
+
+  if (!m_Specifications.empty() || spec != PTUNDEFINED)
+  {
+    m_Specifications.resize(m_Ids.size() - 1, PTUNDEFINED);
+    m_Specifications.push_back(spec);
+  }
+
+  this->Modified();
+}
+
+void mitk::PointSetArrays::Append(const ScalarType *xyz, std::size_t numberOfPoints, const PointIdentifier *ids)
+{
+  if (numberOfPoints == 0)
+    return;
+
+  if (ids != nullptr)
+  {
+    const bool ascending =
+      (m_Ids.empty() || ids[0] > m_Ids.back()) &&
+      std::adjacent_find(ids, ids + numberOfPoints, [](PointIdentifier a, PointIdentifier b) { return a >= b; }) ==
+        ids + numberOfPoints;
+    if (!ascending)
+    {
+      mitkThrow() << "Point identifiers have to be ascending and greater than the last identifier.";
+    }
+    m_Ids.insert(m_Ids.end(), ids, ids + numberOfPoints);
+  }
+  else
+  {
+    PointIdentifier id = m_Ids.empty() ? 0 : m_Ids.back() + 1;
+    m_Ids.reserve(m_Ids.size() + numberOfPoints);
+    for (std::size_t i = 0; i < numberOfPoints; ++i)
+    {
+      m_Ids.push_back(id++);
+    }
+  }
+
+  m_Coordinates.insert(m_Coordinates.end(), xyz, xyz + 3 * numberOfPoints);
+
+  if (!m_Selected.empty())
+    m_Selected.resize(m_Ids.size(), 0);
+  if (!m_Specifications.empty())
+    m_Specifications.resize(m_Ids.size(), PTUNDEFINED);
+
+  this->Modified();
+}
+
+void mitk::PointSetArrays::RemovePositions(std::vector<std::size_t> positions)
+{
+  std::sort(positions.begin(), positions.end());
+  positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+  if (positions.empty())
+    return;
+
+  if (positions.back() >= m_Ids.size())
+  {
+    mitkThrow() << "Point position " << positions.back() << " out of range, number of points is " << m_Ids.size();
+  }
+
+  // move the kept points to the front, starting at the first removed position
+  auto removed = positions.cbegin();
+  std::size_t target = *removed;
+  for (std::size_t source = target; source < m_Ids.size(); ++source)
+  {
+    if (removed != positions.cend() && source == *removed)
+    {
+      ++removed;
+      continue;
+    }
+
+    std::copy_n(&m_Coordinates[3 * source], 3, &m_Coordinates[3 * target]);
+    m_Ids[target] = m_Ids[source];
+    if (!m_Selected.empty())
+      m_Selected[target] = m_Selected[source];
+    if (!m_Specifications.empty())
+      m_Specifications[target] = m_Specifications[source];
+    ++target;
+  }
+
+  m_Coordinates.resize(3 * target);
+  m_Ids.resize(target);
+  if (!m_Selected.empty())
+    m_Selected.resize(target);
+  if (!m_Specifications.empty())
+    m_Specifications.resize(target);
+
+  this->Modified();
+}
+
+mitk::Point3D mitk::PointSetArrays::GetPoint(std::size_t position) const
+{
+  Point3D point;
+  std::copy_n(&m_Coordinates[3 * position], 3, point.GetDataPointer());
+  return point;
+}
+
+void mitk::PointSetArrays::SetPoint(std::size_t position, const Point3D &point)
+{
+  std::copy_n(point.GetDataPointer(), 3, &m_Coordinates[3 * position]);
+  this->Modified();
+}
+
+bool mitk::PointSetArrays::FindPosition(PointIdentifier id, std::size_t &position) const
+{
+  auto it = std::lower_bound(m_Ids.cbegin(), m_Ids.cend(), id);
+  if (it == m_Ids.cend() || *it != id)
+    return false;
+
+  position = it - m_Ids.cbegin();
+  return true;
+}
+
+void mitk::PointSetArrays::SetSelected(std::size_t position, bool selected)
+{
+  if (m_Selected.empty())
+  {
+    if (!selected)
+      return;
+    m_Selected.resize(m_Ids.size(), 0);
+  }
+  m_Selected[position] = selected ? 1 : 0;
+  this->Modified();
+}
+
+void mitk::PointSetArrays::SetSpecification(std::size_t position, PointSpecificationType spec)
+{
+  if (m_Specifications.empty())
+  {
+    if (spec == PTUNDEFINED)
+      return;
+    m_Specifications.resize(m_Ids.size(), PTUNDEFINED);
+  }
+  m_Specifications[position] = spec;
+  this->Modified();
+}
+
+vtkPoints *mitk::PointSetArrays::GetVtkPoints() const
+{
+  if (m_VtkPointsTime != this->GetMTime())
+  {
+    // let the VTK array use the coordinates without taking ownership
+    m_VtkCoordinates->SetArray(
+      const_cast<ScalarType *>(m_Coordinates.data()), static_cast<vtkIdType>(m_Coordinates.size()), 1);
+    m_VtkPoints->Modified();
+    m_VtkPointsTime = this->GetMTime();
+  }
+  return m_VtkPoints;
+}
@@ -0,0 +1,73 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKey.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  class PropertyKeyTable
+  {
+  public:
+    static PropertyKeyTable &GetInstance()
+    {
+      static PropertyKeyTable instance;
+      return instance;
+    }
+
+    void Intern(const std::string &name, mitk::PropertyKey::IdType &id, const std::string *&internedName)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      auto iter = m_Ids.find(name);
+      if (iter == m_Ids.end())
+      {
+        // the elements of a deque are not moved when appending
+        m_Names.push_back(name);
+        iter = m_Ids.insert(std::make_pair(name, static_cast<mitk::PropertyKey::IdType>(m_Names.size() - 1))).first;
+      }
+
+      id = iter->second;
+      internedName = &m_Names[id];
+    }
+
+  private:
+    PropertyKeyTable()
+    {
+      // id 0 is the empty name
+      m_Names.push_back(std::string());
+      m_Ids.insert(std::make_pair(std::string(), 0));
+    }
+
+    std::mutex m_Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::IdType> m_Ids;
+    std::deque<std::string> m_Names;
+  };
+}
+
+mitk::PropertyKey::PropertyKey()
+{
+  PropertyKeyTable::GetInstance().Intern(std::string(), m_Id, m_Name);
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+{
+  PropertyKeyTable::GetInstance().Intern(name, m_Id, m_Name);
+}
+
+mitk::PropertyKey::PropertyKey(const char *name)
+{
+  PropertyKeyTable::GetInstance().Intern(name != nullptr ? std::string(name) : std::string(), m_Id, m_Name);
+}
@@ -103,7 +103,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
   }
 
   // no? add it.
-  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertProperty(propertyKey, property);
   this->Modified();
 }
 
@@ -117,12 +117,11 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
   // Is a property with key @a propertyKey contained in the list?
   if (it != m_Properties.cend())
   {
-    it->second = nullptr;
-    m_Properties.erase(it);
+    this->EraseProperty(it);
   }
 
   // no? add/replace it.
-  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InsertProperty(propertyKey, property);
   Modified();
 }
 
@@ -133,21 +132,20 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   // Is a property with key @a propertyKey contained in the list?
   if (it != m_Properties.cend())
   {
-    it->second = nullptr;
-    m_Properties.erase(it);
+    this->EraseProperty(it);
     Modified();
   }
 }
 
-mitk::PropertyList::PropertyList()
+mitk::PropertyList::PropertyList() : m_PropertyIndexValid(false)
 {
 }
 
-mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object()
+mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(), m_PropertyIndexValid(false)
 {
   for (auto i = other.m_Properties.cbegin(); i != other.m_Properties.cend(); ++i)
   {
-    m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
+    this->InsertProperty(i->first, i->second->Clone());
   }
 }
 
@@ -184,8 +182,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
 
   if (it != m_Properties.end())
   {
-    it->second = nullptr;
-    m_Properties.erase(it);
+    this->EraseProperty(it);
     Modified();
     return true;
   }
@@ -201,6 +198,49 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  m_PropertyIndex.clear();
+  m_PropertyIndexValid.store(false, std::memory_order_relaxed);
+}
+
+void mitk::PropertyList::InsertProperty(const std::string &propertyKey, BaseProperty *property)
+{
+  m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  m_PropertyIndexValid.store(false, std::memory_order_relaxed);
+}
+
+void mitk::PropertyList::EraseProperty(PropertyMap::iterator it)
+{
+  it->second = nullptr;
+  m_Properties.erase(it);
+  m_PropertyIndexValid.store(false, std::memory_order_relaxed);
+}
+
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  this->UpdatePropertyIndex();
+
+  auto it = m_PropertyIndex.find(propertyKey.GetId());
+  return it != m_PropertyIndex.end() ? it->second : nullptr;
+}
+
+void mitk::PropertyList::UpdatePropertyIndex() const
+{
+  // Lookups may run concurrently and race to rebuild the index. Modifications of the list must not run
+  // concurrently to lookups, like for any other method.
+  if (m_PropertyIndexValid.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(m_PropertyIndexMutex);
+
+  if (m_PropertyIndexValid.load(std::memory_order_relaxed))
+    return;
+
+  m_PropertyIndex.clear();
+
+  for (const auto &property : m_Properties)
+    m_PropertyIndex[PropertyKey(property.first).GetId()] = property.second;
+
+  m_PropertyIndexValid.store(true, std::memory_order_release);
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -133,4 +133,64 @@ namespace mitk
     static std::string s("org.mitk.io.Size t");
     return s;
   }
+
+  std::string IOConstants::FIRST_TIME_STEP()
+  {
+    static std::string s("org.mitk.io.First time step");
+    return s;
+  }
+
+  std::string IOConstants::NUMBER_OF_TIME_STEPS()
+  {
+    static std::string s("org.mitk.io.Number of time steps");
+    return s;
+  }
+
+  std::string IOConstants::REGION()
+  {
+    static std::string s("org.mitk.io.Region");
+    return s;
+  }
+
+  std::string IOConstants::LOAD_TIME_STEPS_ON_DEMAND()
+  {
+    static std::string s("org.mitk.io.Load time steps on demand");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION()
+  {
+    static std::string s("org.mitk.io.Compression");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_GZIP()
+  {
+    static std::string s("gzip");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_NONE()
+  {
+    static std::string s("none");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_ENUM()
+  {
+    static std::string s("org.mitk.io.Compression.enum");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_LEVEL()
+  {
+    static std::string s("org.mitk.io.Compression level");
+    return s;
+  }
+
+  std::string IOConstants::NUMBER_OF_THREADS()
+  {
+    static std::string s("org.mitk.io.Number of threads");
+    return s;
+  }
 }
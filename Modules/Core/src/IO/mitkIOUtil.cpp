@@ -17,7 +17,10 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkFileReaderRegistry.h>
 #include <mitkFileWriterRegistry.h>
+#include <mitkIOConstants.h>
 #include <mitkIMimeTypeProvider.h>
+#include <mitkLocaleSwitch.h>
+#include <mitkParallelFor.h>
 #include <mitkProgressBar.h>
 #include <mitkStandaloneDataStorage.h>
 #include <usGetModuleContext.h>
@@ -35,8 +38,11 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdlib>
+#include <mutex>
 
 static std::string GetLastErrorStr()
 {
@@ -314,6 +320,58 @@ namespace mitk
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
 
     static void SetDefaultDataNodeProperties(mitk::DataNode *node, const std::string &filePath = std::string());
+
+    /** The reading of one file with its selected reader. */
+    struct ReadJob
+    {
+      ReadJob(LoadInfo *loadInfo, IFileReader *reader)
+        : m_LoadInfo(loadInfo), m_Reader(reader), m_Concurrent(false), m_Done(false)
+      {
+      }
+
+      LoadInfo *m_LoadInfo;
+      IFileReader *m_Reader;
+
+      /** Storage the nodes are read into if the job is run on another thread. */
+      DataStorage::Pointer m_Storage;
+
+      DataStorage::SetOfObjects::Pointer m_Nodes;
+      std::vector<std::string> m_ReadFiles;
+      std::string m_Error;
+
+      bool m_Concurrent;
+      bool m_Done;
+    };
+
+    /** Reads the file of the job into ds (if not nullptr). Errors are stored in the job. */
+    static void Read(ReadJob &job, DataStorage *ds);
+
+    /**
+     * Reads the file of the job while the readers are still selected. The nodes are read into a
+     * private storage (if ds is not nullptr), the result is added later by ReadConcurrently().
+     */
+    static void ReadAhead(ReadJob &job, DataStorage *ds);
+
+    /** Adds the result of a job to its LoadInfo, nodeResult and ds. Returns the error message of the job. */
+    static std::string AddResult(ReadJob &job,
+                                 DataStorage::SetOfObjects *nodeResult,
+                                 DataStorage *ds,
+                                 std::vector<std::string> &readFiles);
+
+    /** Adds node and its sources in source to target, if they are not yet contained. */
+    static void AddNode(DataNode *node, const DataStorage &source, DataStorage &target);
+
+    /**
+     * Runs the jobs of thread-safe readers on up to numberOfThreads threads and the others on
+     * the calling thread. The results are added in the order of the jobs, on the calling thread.
+     * Jobs that have been read ahead are only added.
+     */
+    static std::string ReadConcurrently(std::vector<ReadJob> &jobs,
+                                        DataStorage::SetOfObjects *nodeResult,
+                                        DataStorage *ds,
+                                        unsigned int numberOfThreads,
+                                        std::vector<std::string> &readFiles,
+                                        int &filesToRead);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -326,6 +384,210 @@ namespace mitk
     return baseDataList.front();
   }
 
+  void IOUtil::Impl::Read(ReadJob &job, DataStorage *ds)
+  {
+    try
+    {
+      if (ds != nullptr)
+      {
+        job.m_Nodes = job.m_Reader->Read(*ds);
+      }
+      else
+      {
+        job.m_Nodes = DataStorage::SetOfObjects::New();
+        std::vector<mitk::BaseData::Pointer> baseData = job.m_Reader->Read();
+        for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+        {
+          if (iter->IsNotNull())
+          {
+            mitk::DataNode::Pointer node = mitk::DataNode::New();
+            node->SetData(*iter);
+            job.m_Nodes->InsertElement(job.m_Nodes->Size(), node);
+          }
+        }
+      }
+      job.m_ReadFiles = job.m_Reader->GetReadFiles();
+    }
+    catch (const std::exception &e)
+    {
+      job.m_Error = "Exception occured when reading file " + job.m_LoadInfo->m_Path + ":\n" + e.what() + "\n\n";
+    }
+    catch (...)
+    {
+      job.m_Error = "Unknown exception occured when reading file " + job.m_LoadInfo->m_Path + "\n\n";
+    }
+  }
+
+  void IOUtil::Impl::ReadAhead(ReadJob &job, DataStorage *ds)
+  {
+    if (ds != nullptr)
+    {
+      job.m_Storage = StandaloneDataStorage::New().GetPointer();
+    }
+    Read(job, job.m_Storage);
+    job.m_Done = true;
+  }
+
+  std::string IOUtil::Impl::AddResult(ReadJob &job,
+                                      DataStorage::SetOfObjects *nodeResult,
+                                      DataStorage *ds,
+                                      std::vector<std::string> &readFiles)
+  {
+    if (!job.m_Error.empty())
+    {
+      return job.m_Error;
+    }
+
+    LoadInfo &loadInfo = *job.m_LoadInfo;
+    readFiles.insert(readFiles.end(), job.m_ReadFiles.begin(), job.m_ReadFiles.end());
+
+    try
+    {
+      for (DataStorage::SetOfObjects::ConstIterator nodeIter = job.m_Nodes->Begin(), nodeIterEnd = job.m_Nodes->End();
+           nodeIter != nodeIterEnd;
+           ++nodeIter)
+      {
+        const mitk::DataNode::Pointer &node = nodeIter->Value();
+
+        // nodes read on another thread are transferred to ds in the order of the files
+        if (ds != nullptr && job.m_Storage.IsNotNull())
+        {
+          AddNode(node, *job.m_Storage, *ds);
+        }
+
+        mitk::BaseData::Pointer data = node->GetData();
+        if (data.IsNull())
+        {
+          continue;
+        }
+
+        mitk::StringProperty::Pointer pathProp = mitk::StringProperty::New(loadInfo.m_Path);
+        data->SetProperty("path", pathProp);
+
+        loadInfo.m_Output.push_back(data);
+        if (nodeResult)
+        {
+          nodeResult->push_back(nodeIter->Value());
+        }
+      }
+    }
+    catch (const std::exception &e)
+    {
+      return "Exception occured when adding the data of file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      return "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+    return std::string();
+  }
+
+  void IOUtil::Impl::AddNode(DataNode *node, const DataStorage &source, DataStorage &target)
+  {
+    if (target.Exists(node))
+    {
+      return;
+    }
+
+    DataStorage::SetOfObjects::ConstPointer sources = source.GetSources(node, nullptr, true);
+    for (auto iter = sources->Begin(); iter != sources->End(); ++iter)
+    {
+      AddNode(iter->Value(), source, target);
+    }
+    target.Add(node, sources);
+  }
+
+  std::string IOUtil::Impl::ReadConcurrently(std::vector<ReadJob> &jobs,
+                                             DataStorage::SetOfObjects *nodeResult,
+                                             DataStorage *ds,
+                                             unsigned int numberOfThreads,
+                                             std::vector<std::string> &readFiles,
+                                             int &filesToRead)
+  {
+    // A reader instance selected for several files (i.e. not registered as a prototype)
+    // must not read them concurrently.
+    std::map<IFileReader *, int> readerCount;
+    for (const auto &job : jobs)
+    {
+      if (!job.m_Done)
+      {
+        ++readerCount[job.m_Reader];
+      }
+    }
+
+    std::vector<ReadJob *> concurrentJobs;
+    for (auto &job : jobs)
+    {
+      job.m_Concurrent = !job.m_Done && job.m_Reader->IsThreadSafe() && readerCount[job.m_Reader] == 1;
+      if (job.m_Concurrent)
+      {
+        if (ds != nullptr)
+        {
+          job.m_Storage = StandaloneDataStorage::New().GetPointer();
+        }
+        concurrentJobs.push_back(&job);
+      }
+    }
+
+    // The readers switch to the "C" locale on their own, but setlocale() changes the locale of the
+    // whole process. Switching once on this thread turns the switches of the readers into no-ops.
+    LocaleSwitch localeSwitch("C");
+
+    std::mutex mutex;
+    std::condition_variable jobDone;
+    auto isDone = [&mutex](const ReadJob &job) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return job.m_Done;
+    };
+
+    ParallelLoop loop(concurrentJobs.size(), numberOfThreads, [&](std::size_t i) {
+      ReadJob &job = *concurrentJobs[i];
+      Read(job, job.m_Storage);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        job.m_Done = true;
+      }
+      jobDone.notify_all();
+    });
+
+    // Readers which are not thread-safe read on this thread, in between the results
+    // of the other readers are added (and the progress is reported) in the original order.
+    std::string errMsg;
+    for (auto &job : jobs)
+    {
+      if (job.m_Concurrent)
+      {
+        // the jobs are claimed in order, so this thread reads until the job is done or claimed by another thread
+        while (!isDone(job) && loop.RunNext())
+        {
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        jobDone.wait(lock, [&job]() { return job.m_Done; });
+      }
+      else if (!job.m_Done &&
+               std::find(readFiles.begin(), readFiles.end(), job.m_LoadInfo->m_Path) == readFiles.end())
+      {
+        Read(job, ds);
+      }
+
+      // the file has already been read together with a file before (e.g. as part of a series)
+      if (std::find(readFiles.begin(), readFiles.end(), job.m_LoadInfo->m_Path) != readFiles.end())
+      {
+        continue;
+      }
+
+      errMsg += AddResult(job, nodeResult, ds, readFiles);
+      mitk::ProgressBar::GetInstance()->Progress(2);
+      --filesToRead;
+    }
+
+    loop.Wait();
+
+    return errMsg;
+  }
+
 #ifdef US_PLATFORM_WINDOWS
   std::string IOUtil::GetProgramPath()
   {
@@ -529,7 +791,27 @@ namespace mitk
     return loadInfos.front().m_Output;
   }
 
+  std::vector<BaseData::Pointer> IOUtil::Load(const std::string &path,
+                                              TimeStepType firstTimeStep,
+                                              TimeStepType numberOfTimeSteps,
+                                              bool loadOnDemand)
+  {
+    IFileReader::Options options;
+    options[IOConstants::FIRST_TIME_STEP()] = static_cast<int>(firstTimeStep);
+    options[IOConstants::NUMBER_OF_TIME_STEPS()] = static_cast<int>(numberOfTimeSteps);
+    options[IOConstants::LOAD_TIME_STEPS_ON_DEMAND()] = loadOnDemand;
+    return Load(path, options);
+  }
+
   DataStorage::SetOfObjects::Pointer IOUtil::Load(const std::vector<std::string> &paths, DataStorage &storage, const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    return Load(paths, storage, 1, optionsCallback);
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Load(const std::vector<std::string> &paths,
+                                                  DataStorage &storage,
+                                                  unsigned int numberOfThreads,
+                                                  const ReaderOptionsFunctorBase *optionsCallback)
   {
     DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
     std::vector<LoadInfo> loadInfos;
@@ -537,7 +819,7 @@ namespace mitk
     {
       loadInfos.push_back(loadInfo);
     }
-    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback);
+    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback, numberOfThreads);
     if (!errMsg.empty())
     {
       mitkThrow() << errMsg;
@@ -546,6 +828,13 @@ namespace mitk
   }
 
   std::vector<BaseData::Pointer> IOUtil::Load(const std::vector<std::string> &paths, const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    return Load(paths, 1, optionsCallback);
+  }
+
+  std::vector<BaseData::Pointer> IOUtil::Load(const std::vector<std::string> &paths,
+                                              unsigned int numberOfThreads,
+                                              const ReaderOptionsFunctorBase *optionsCallback)
   {
     std::vector<BaseData::Pointer> result;
     std::vector<LoadInfo> loadInfos;
@@ -553,7 +842,7 @@ namespace mitk
     {
       loadInfos.push_back(loadInfo);
     }
-    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback);
+    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback, numberOfThreads);
     if (!errMsg.empty())
     {
       mitkThrow() << errMsg;
@@ -570,13 +859,16 @@ namespace mitk
   std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
                            DataStorage::SetOfObjects *nodeResult,
                            DataStorage *ds,
-                           const ReaderOptionsFunctorBase *optionsCallback)
+                           const ReaderOptionsFunctorBase *optionsCallback,
+                           unsigned int numberOfThreads)
   {
     if (loadInfos.empty())
     {
       return "No input files given";
     }
 
+    numberOfThreads = ParallelLoop::GetNumberOfThreads(numberOfThreads, loadInfos.size());
+
     int filesToRead = loadInfos.size();
     mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * filesToRead);
 
@@ -585,11 +877,17 @@ namespace mitk
     std::map<std::string, FileReaderSelector::Item> usedReaderItems;
 
     std::vector< std::string > read_files;
+    std::vector<Impl::ReadJob> readJobs;
+    // files read by the jobs which have been read ahead, their results are not added yet
+    std::vector<std::string> readAheadFiles;
     for (auto &loadInfo : loadInfos)
     {
       if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
         continue;
 
+      if (std::find(readAheadFiles.begin(), readAheadFiles.end(), loadInfo.m_Path) != readAheadFiles.end())
+        continue;
+
       std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
 
       if (readers.empty())
@@ -669,69 +967,33 @@ namespace mitk
         break;
       }
 
-      // Do the actual reading
-      try
+      Impl::ReadJob readJob(&loadInfo, reader);
+      if (numberOfThreads > 1)
       {
-        DataStorage::SetOfObjects::Pointer nodes;
-        if (ds != nullptr)
-        {
-          nodes = reader->Read(*ds);
-
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-        else
-        {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
-          {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
-          }
-
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
-        {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
-          {
-            continue;
-          }
-
-          mitk::StringProperty::Pointer pathProp = mitk::StringProperty::New(loadInfo.m_Path);
-          data->SetProperty("path", pathProp);
-
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
-          {
-            nodeResult->push_back(nodeIter->Value());
-          }
-        }
-
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+        // Thread-safe readers read after all readers have been selected. The others read right away,
+        // so files they read along (e.g. the other files of a DICOM series) are skipped before the
+        // options callback is called for them.
+        if (!reader->IsThreadSafe())
         {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+          Impl::ReadAhead(readJob, ds);
+          readAheadFiles.insert(readAheadFiles.end(), readJob.m_ReadFiles.begin(), readJob.m_ReadFiles.end());
         }
+        readJobs.push_back(readJob);
+        continue;
       }
-      catch (const std::exception &e)
-      {
-        errMsg += "Exception occured when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
-      }
+
+      // Do the actual reading
+      Impl::Read(readJob, ds);
+      errMsg += Impl::AddResult(readJob, nodeResult, ds, read_files);
       mitk::ProgressBar::GetInstance()->Progress(2);
       --filesToRead;
     }
 
+    if (!readJobs.empty())
+    {
+      errMsg += Impl::ReadConcurrently(readJobs, nodeResult, ds, numberOfThreads, read_files, filesToRead);
+    }
+
     if (!errMsg.empty())
     {
       MITK_ERROR << errMsg;
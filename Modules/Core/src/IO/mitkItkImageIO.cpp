@@ -11,12 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkItkImageIO.h"
+#include "mitkParallelNrrdIO.h"
 
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkCoreServices.h>
 #include <mitkCustomMimeType.h>
 #include <mitkIOMimeTypes.h>
 #include <mitkIPropertyPersistence.h>
+#include <mitkIOConstants.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
@@ -28,6 +30,8 @@ found in the LICENSE file.
 #include <itkMetaDataObject.h>
 
 #include <algorithm>
+#include <cstring>
+#include <sstream>
 
 namespace mitk
 {
@@ -36,6 +40,111 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TYPE = "org_mitk_timegeometry_type";
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
 
+  namespace
+  {
+    int GetIntOption(const IFileReader::Options &options, const std::string &name)
+    {
+      auto iter = options.find(name);
+      if (iter == options.end() || iter->second.Empty())
+        return 0;
+
+      const us::Any &value = iter->second;
+      if (value.Type() == typeid(int))
+        return us::any_cast<int>(value);
+      if (value.Type() == typeid(unsigned int))
+        return static_cast<int>(us::any_cast<unsigned int>(value));
+
+      int result = 0;
+      std::istringstream stream(value.ToString());
+      if (!(stream >> result))
+        mitkThrow() << "Invalid value \"" << value.ToString() << "\" for reader option " << name;
+      return result;
+    }
+
+    bool GetBoolOption(const IFileReader::Options &options, const std::string &name)
+    {
+      auto iter = options.find(name);
+      if (iter == options.end() || iter->second.Empty())
+        return false;
+
+      if (iter->second.Type() == typeid(bool))
+        return us::any_cast<bool>(iter->second);
+
+      return iter->second.ToString() == "true" || iter->second.ToString() == "1";
+    }
+
+    /** Copies the pixels of targetRegion from a buffer holding sourceRegion (which contains targetRegion). */
+    void CopyRegion(const char *source,
+                    const itk::ImageIORegion &sourceRegion,
+                    char *target,
+                    const itk::ImageIORegion &targetRegion,
+                    std::size_t pixelSize)
+    {
+      const unsigned int dimension = targetRegion.GetImageDimension();
+      const unsigned int sourceDimension = sourceRegion.GetImageDimension();
+
+      std::vector<std::size_t> strides(dimension, pixelSize);
+      for (unsigned int i = 1; i < dimension; ++i)
+        strides[i] = strides[i - 1] * (i - 1 < sourceDimension ? sourceRegion.GetSize(i - 1) : 1);
+
+      const std::size_t lineSize = targetRegion.GetSize(0) * pixelSize;
+      const std::size_t numberOfLines = targetRegion.GetNumberOfPixels() / targetRegion.GetSize(0);
+
+      // position of the current line relative to the start of the target region
+      std::vector<itk::ImageIORegion::SizeValueType> position(dimension, 0);
+      for (std::size_t line = 0; line < numberOfLines; ++line)
+      {
+        std::size_t offset = 0;
+        for (unsigned int i = 0; i < dimension; ++i)
+        {
+          const itk::ImageIORegion::IndexValueType sourceStart = i < sourceDimension ? sourceRegion.GetIndex(i) : 0;
+          offset += (targetRegion.GetIndex(i) - sourceStart + position[i]) * strides[i];
+        }
+
+        std::memcpy(target + line * lineSize, source + offset, lineSize);
+
+        for (unsigned int i = 1; i < dimension; ++i)
+        {
+          if (++position[i] < targetRegion.GetSize(i))
+            break;
+          position[i] = 0;
+        }
+      }
+    }
+
+    /** Reads the pixels of region into buffer. ImageIOs that cannot stream the region read the smallest
+        region they support, from which the requested part is copied. */
+    void ReadImageRegion(itk::ImageIOBase *imageIO, const itk::ImageIORegion &region, void *buffer)
+    {
+      if (region.GetImageDimension() != imageIO->GetNumberOfDimensions())
+      {
+        imageIO->SetIORegion(region);
+        imageIO->Read(buffer);
+        return;
+      }
+
+      const itk::ImageIORegion streamableRegion = imageIO->GenerateStreamableReadRegionFromRequestedRegion(region);
+      imageIO->SetIORegion(streamableRegion);
+
+      if (streamableRegion == region)
+      {
+        imageIO->Read(buffer);
+        return;
+      }
+
+      const std::size_t pixelSize = imageIO->GetComponentSize() * imageIO->GetNumberOfComponents();
+      std::vector<char> streamableBuffer(streamableRegion.GetNumberOfPixels() * pixelSize);
+      imageIO->Read(streamableBuffer.data());
+      CopyRegion(streamableBuffer.data(), streamableRegion, static_cast<char *>(buffer), region, pixelSize);
+    }
+
+    bool CanStreamRegion(itk::ImageIOBase *imageIO, const itk::ImageIORegion &region)
+    {
+      return region.GetImageDimension() == imageIO->GetNumberOfDimensions() && imageIO->CanStreamRead() &&
+             imageIO->GenerateStreamableReadRegionFromRequestedRegion(region) == region;
+    }
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
   {
@@ -120,6 +229,8 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
+    this->InitializeDefaultWriterOptions();
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -205,6 +316,8 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
+    this->InitializeDefaultWriterOptions();
 
     if (rank)
     {
@@ -249,6 +362,30 @@ namespace mitk
     return result.GetPointer();
   };
 
+  void ItkImageIO::InitializeDefaultReaderOptions()
+  {
+    Options defaultOptions;
+    defaultOptions[IOConstants::FIRST_TIME_STEP()] = 0;
+    defaultOptions[IOConstants::NUMBER_OF_TIME_STEPS()] = 0;
+    defaultOptions[IOConstants::REGION()] = std::string();
+    defaultOptions[IOConstants::LOAD_TIME_STEPS_ON_DEMAND()] = false;
+    this->SetDefaultReaderOptions(defaultOptions);
+  }
+
+  void ItkImageIO::InitializeDefaultWriterOptions()
+  {
+    std::vector<std::string> compressionEnum;
+    compressionEnum.push_back(IOConstants::COMPRESSION_GZIP());
+    compressionEnum.push_back(IOConstants::COMPRESSION_NONE());
+
+    Options defaultOptions;
+    defaultOptions[IOConstants::COMPRESSION()] = IOConstants::COMPRESSION_GZIP();
+    defaultOptions[IOConstants::COMPRESSION_ENUM()] = compressionEnum;
+    defaultOptions[IOConstants::COMPRESSION_LEVEL()] = 6;
+    defaultOptions[IOConstants::NUMBER_OF_THREADS()] = 0;
+    this->SetDefaultWriterOptions(defaultOptions);
+  }
+
   std::vector<BaseData::Pointer> ItkImageIO::Read()
   {
     std::vector<BaseData::Pointer> result;
@@ -308,7 +445,6 @@ namespace mitk
       ioSize[i] = m_ImageIO->GetDimensions(i);
       if (i < MAXDIM)
       {
-        dimensions[i] = m_ImageIO->GetDimensions(i);
         spacing[i] = m_ImageIO->GetSpacing(i);
         if (spacing[i] <= 0)
           spacing[i] = 1.0f;
@@ -319,18 +455,18 @@ namespace mitk
       }
     }
 
-    ioRegion.SetSize(ioSize);
-    ioRegion.SetIndex(ioStart);
-
-    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
-    m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
+    const itk::ImageIORegion::SizeType fileSize = ioSize;
+    const TimeStepType numberOfTimeStepsInFile = ndim > 3 ? fileSize[3] : 1;
+    const TimeStepType firstTimeStep = this->RestrictIORegion(ndim, ioStart, ioSize);
+    const bool restrictedRegion = ioSize != fileSize;
 
-    image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    for (i = 0; i < ndim && i < MAXDIM; ++i)
+    {
+      dimensions[i] = ioSize[i];
+    }
 
-    const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
+    ioRegion.SetSize(ioSize);
+    ioRegion.SetIndex(ioStart);
 
     // access direction of itk::Image and include spacing
     mitk::Matrix3D matrix;
@@ -340,6 +476,101 @@ namespace mitk
       for (j = 0; j < itkDimMax3; ++j)
         matrix[i][j] = m_ImageIO->GetDirection(j)[i];
 
+    // move the origin to the first voxel of the requested region
+    for (i = 0; i < itkDimMax3; ++i)
+      for (j = 0; j < itkDimMax3; ++j)
+        origin[i] += matrix[i][j] * spacing[j] * ioStart[j];
+
+    itk::ImageIORegion timeStepRegion = ioRegion;
+    if (ndim > 3)
+      timeStepRegion.SetSize(3, 1);
+
+    bool loadOnDemand = GetBoolOption(this->GetReaderOptions(), IOConstants::LOAD_TIME_STEPS_ON_DEMAND());
+    if (loadOnDemand)
+    {
+      if (ndim < 4 || ioSize[3] < 2)
+      {
+        loadOnDemand = false;
+      }
+      else if (!CanStreamRegion(m_ImageIO, timeStepRegion))
+      {
+        MITK_WARN << m_ImageIO->GetNameOfClass() << " cannot stream single time steps of " << path
+                  << ". Loading all requested time steps.";
+        loadOnDemand = false;
+      }
+    }
+
+    if (ndim != m_ImageIO->GetNumberOfDimensions() && (restrictedRegion || loadOnDemand))
+    {
+      mitkThrow() << "Reading a part of " << path << " is not supported, since the image has "
+                  << m_ImageIO->GetNumberOfDimensions() << " dimensions.";
+    }
+
+    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
+
+    image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
+
+    const std::size_t pixelSize = m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+    void *buffer = nullptr;
+
+    if (loadOnDemand)
+    {
+      // read the first time step now and the remaining ones when they are accessed first
+      buffer = new unsigned char[timeStepRegion.GetNumberOfPixels() * pixelSize];
+      ReadImageRegion(m_ImageIO, timeStepRegion, buffer);
+      image->SetImportVolume(buffer, 0, 0, Image::ManageMemory);
+
+      itk::ImageIOBase::Pointer imageIO = dynamic_cast<itk::ImageIOBase *>(m_ImageIO->Clone().GetPointer());
+      imageIO->SetFileName(path);
+      imageIO->ReadImageInformation();
+
+      image->SetVolumeLoader([imageIO, timeStepRegion](int t, int, void *volumeBuffer) {
+        // the header has been parsed above, reading the binary region does not depend on the locale
+        try
+        {
+          itk::ImageIORegion region = timeStepRegion;
+          region.SetIndex(3, timeStepRegion.GetIndex(3) + t);
+          ReadImageRegion(imageIO, region, volumeBuffer);
+        }
+        catch (const std::exception &e)
+        {
+          MITK_ERROR << "Could not load time step " << t << " of " << imageIO->GetFileName() << ": " << e.what();
+          return false;
+        }
+        return true;
+      });
+    }
+    else
+    {
+      const std::size_t bufferSize =
+        restrictedRegion ? ioRegion.GetNumberOfPixels() * pixelSize : m_ImageIO->GetImageSizeInBytes();
+      buffer = new unsigned char[bufferSize];
+
+      // NRRD files written with multiple threads can be decompressed with multiple threads
+      bool parallelRead = false;
+      if (!restrictedRegion)
+      {
+        try
+        {
+          parallelRead = ParallelNrrdIO::Read(m_ImageIO, path, buffer);
+        }
+        catch (const mitk::Exception &e)
+        {
+          // e.g. a stale chunk index if the data has been rewritten by another tool
+          MITK_WARN << "Cannot decompress " << path << " with multiple threads, using the NRRD reader instead: "
+                    << e.GetDescription();
+        }
+      }
+
+      if (!parallelRead)
+      {
+        ReadImageRegion(m_ImageIO, ioRegion, buffer);
+      }
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
+
+    const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
+
     // re-initialize PlaneGeometry with origin and direction
     PlaneGeometry *planeGeometry = image->GetSlicedGeometry(0)->GetPlaneGeometry(0);
     planeGeometry->SetOrigin(origin);
@@ -390,18 +621,19 @@ namespace mitk
         {
           MITK_ERROR << "Stored timepoints are empty. Meta information seems to bee invalid. Switch to ProportionalTimeGeometry fallback";
         }
-        else if (timePoints.size() - 1 != image->GetDimension(3))
+        else if (timePoints.size() - 1 != numberOfTimeStepsInFile)
         {
           MITK_ERROR << "Stored timepoints (" << timePoints.size() - 1 << ") and size of image time dimension ("
-                     << image->GetDimension(3) << ") do not match. Switch to ProportionalTimeGeometry fallback";
+                     << numberOfTimeStepsInFile << ") do not match. Switch to ProportionalTimeGeometry fallback";
         }
         else
         {
           ArbitraryTimeGeometry::Pointer arbitraryTimeGeometry = ArbitraryTimeGeometry::New();
-          TimePointVector::const_iterator pos = timePoints.begin();
+          TimePointVector::const_iterator pos = timePoints.begin() + firstTimeStep;
+          const TimePointVector::const_iterator end = pos + image->GetDimension(3) + 1;
           auto prePos = pos++;
 
-          for (; pos != timePoints.end(); ++prePos, ++pos)
+          for (; pos != end; ++prePos, ++pos)
           {
             arbitraryTimeGeometry->AppendNewTimeStepClone(slicedGeometry, *prePos, *pos);
           }
@@ -416,6 +648,10 @@ namespace mitk
       MITK_INFO << "used time geometry: " << ProportionalTimeGeometry::GetStaticNameOfClass();
       ProportionalTimeGeometry::Pointer propTimeGeometry = ProportionalTimeGeometry::New();
       propTimeGeometry->Initialize(slicedGeometry, image->GetDimension(3));
+      if (firstTimeStep > 0)
+      {
+        propTimeGeometry->SetFirstTimePoint(firstTimeStep * propTimeGeometry->GetStepDuration());
+      }
       timeGeometry = propTimeGeometry;
     }
 
@@ -427,7 +663,8 @@ namespace mitk
     for (auto iter = dictionary.Begin(), iterEnd = dictionary.End(); iter != iterEnd;
          ++iter)
     {
-      if (iter->second->GetMetaDataObjectTypeInfo() == typeid(std::string))
+      if (iter->second->GetMetaDataObjectTypeInfo() == typeid(std::string) &&
+          iter->first != ParallelNrrdIO::CHUNKS_KEY())
       {
         const std::string &key = iter->first;
         std::string assumedPropertyName = key;
@@ -504,6 +741,72 @@ namespace mitk
     return result;
   }
 
+  TimeStepType ItkImageIO::RestrictIORegion(unsigned int ndim,
+                                            itk::ImageIORegion::IndexType &ioStart,
+                                            itk::ImageIORegion::SizeType &ioSize) const
+  {
+    const Options options = this->GetReaderOptions();
+
+    auto regionOption = options.find(IOConstants::REGION());
+    const std::string region = regionOption != options.end() ? regionOption->second.ToString() : std::string();
+    if (!region.empty())
+    {
+      const unsigned int spatialDimension = std::min(ndim, 3u);
+
+      std::istringstream stream(region);
+      std::vector<long> values;
+      long value;
+      while (stream >> value)
+      {
+        values.push_back(value);
+      }
+
+      if (!stream.eof() || values.size() != 2 * spatialDimension)
+      {
+        mitkThrow() << "Invalid region \"" << region << "\". Expected " << spatialDimension
+                    << " start indices followed by " << spatialDimension << " sizes.";
+      }
+
+      for (unsigned int i = 0; i < spatialDimension; ++i)
+      {
+        const long start = values[i];
+        const long size = values[spatialDimension + i];
+        if (start < 0 || size < 1 || static_cast<unsigned long>(start + size) > ioSize[i])
+        {
+          mitkThrow() << "Region \"" << region << "\" exceeds the image size in dimension " << i << " ("
+                      << ioSize[i] << ").";
+        }
+        ioStart[i] = start;
+        ioSize[i] = size;
+      }
+    }
+
+    const int firstTimeStep = GetIntOption(options, IOConstants::FIRST_TIME_STEP());
+    const int numberOfTimeSteps = GetIntOption(options, IOConstants::NUMBER_OF_TIME_STEPS());
+    const TimeStepType numberOfTimeStepsInFile = ndim > 3 ? ioSize[3] : 1;
+
+    if (firstTimeStep < 0 || static_cast<TimeStepType>(firstTimeStep) >= numberOfTimeStepsInFile)
+    {
+      mitkThrow() << "First time step " << firstTimeStep << " is out of range. The image has "
+                  << numberOfTimeStepsInFile << " time steps.";
+    }
+
+    if (numberOfTimeSteps < 0 ||
+        static_cast<TimeStepType>(firstTimeStep + numberOfTimeSteps) > numberOfTimeStepsInFile)
+    {
+      mitkThrow() << "Cannot read " << numberOfTimeSteps << " time steps starting at time step " << firstTimeStep
+                  << ". The image has " << numberOfTimeStepsInFile << " time steps.";
+    }
+
+    if (ndim > 3)
+    {
+      ioStart[3] = firstTimeStep;
+      ioSize[3] = numberOfTimeSteps > 0 ? numberOfTimeSteps : numberOfTimeStepsInFile - firstTimeStep;
+    }
+
+    return static_cast<TimeStepType>(firstTimeStep);
+  }
+
   AbstractFileIO::ConfidenceLevel ItkImageIO::GetReaderConfidenceLevel() const
   {
     return m_ImageIO->CanReadFile(GetLocalFileName().c_str()) ? IFileReader::Supported : IFileReader::Unsupported;
@@ -615,8 +918,17 @@ namespace mitk
         ioRegion.SetIndex(i, image->GetLargestPossibleRegion().GetIndex(i));
       }
 
+      const Options options = this->GetWriterOptions();
+      const bool useCompression =
+        options.find(IOConstants::COMPRESSION())->second.ToString() != IOConstants::COMPRESSION_NONE();
+
+      ParallelCompression::Parameters compressionParameters;
+      compressionParameters.Level = GetIntOption(options, IOConstants::COMPRESSION_LEVEL());
+      compressionParameters.NumberOfThreads =
+        static_cast<unsigned int>(std::max(0, GetIntOption(options, IOConstants::NUMBER_OF_THREADS())));
+
       // use compression if available
-      m_ImageIO->UseCompressionOn();
+      m_ImageIO->SetUseCompression(useCompression);
 
       m_ImageIO->SetIORegion(ioRegion);
       m_ImageIO->SetFileName(path);
@@ -660,7 +972,17 @@ namespace mitk
 
       ImageReadAccessor imageAccess(image);
       LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+
+      // The ITK ImageIOs compress in a single thread. For NRRD files the data is
+      // compressed in chunks on multiple threads instead, the files are still gzip encoded.
+      if (useCompression && ParallelNrrdIO::CanWrite(m_ImageIO, path))
+      {
+        ParallelNrrdIO::Write(m_ImageIO, path, imageAccess.GetData(), compressionParameters);
+      }
+      else
+      {
+        m_ImageIO->Write(imageAccess.GetData());
+      }
     }
     catch (const std::exception &e)
     {
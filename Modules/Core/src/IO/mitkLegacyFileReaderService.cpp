@@ -107,6 +107,11 @@ std::vector<itk::SmartPointer<mitk::BaseData>> mitk::LegacyFileReaderService::Re
   return result;
 }
 
+bool mitk::LegacyFileReaderService::IsThreadSafe() const
+{
+  return false;
+}
+
 mitk::LegacyFileReaderService *mitk::LegacyFileReaderService::Clone() const
 {
   return new LegacyFileReaderService(*this);
@@ -31,6 +31,9 @@ namespace mitk
     using AbstractFileReader::Read;
     std::vector<itk::SmartPointer<BaseData>> Read() override;
 
+    // The wrapped readers are created by the ITK object factory and may share state
+    bool IsThreadSafe() const override;
+
   private:
     LegacyFileReaderService *Clone() const override;
 
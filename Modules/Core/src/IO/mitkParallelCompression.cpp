@@ -0,0 +1,246 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelCompression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkParallelFor.h>
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace
+{
+  // gzip header without optional fields: magic, deflate, no flags, no modification time, unknown OS
+  const unsigned char GzipHeader[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+
+  // keep the chunks within the range of the 32 bit counters of zlib
+  const std::size_t MaximumChunkSize = std::size_t(1) << 30;
+
+  void WriteLittleEndian32(std::ostream &stream, std::uint32_t value)
+  {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i)
+      bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    stream.write(bytes, 4);
+  }
+
+  std::uint32_t ReadLittleEndian32(const unsigned char *bytes)
+  {
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+  }
+
+  std::size_t GetChunkLength(std::size_t chunk, std::size_t size, std::size_t chunkSize)
+  {
+    return std::min(chunkSize, size - std::min(size, chunk * chunkSize));
+  }
+
+  std::string DeflateChunk(const unsigned char *input,
+                           std::size_t length,
+                           int level,
+                           bool last,
+                           std::vector<unsigned char> &output)
+  {
+    z_stream stream = {};
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      return "Cannot initialize zlib compression";
+
+    // deflateBound() covers the final block, the sync flush adds at most one empty stored block
+    output.resize(deflateBound(&stream, static_cast<uLong>(length)) + 16);
+
+    stream.next_in = const_cast<Bytef *>(input);
+    stream.avail_in = static_cast<uInt>(length);
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool complete = last ? result == Z_STREAM_END : (result == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return complete ? std::string() : std::string("Compressing a chunk failed");
+  }
+
+  std::string InflateChunk(const unsigned char *input, std::size_t length, unsigned char *output, std::size_t outputLength)
+  {
+    z_stream stream = {};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+      return "Cannot initialize zlib decompression";
+
+    stream.next_in = const_cast<Bytef *>(input);
+    stream.avail_in = static_cast<uInt>(length);
+    stream.next_out = output;
+    stream.avail_out = static_cast<uInt>(outputLength);
+
+    int result = Z_OK;
+    while (result == Z_OK && stream.avail_in > 0 && stream.avail_out > 0)
+      result = inflate(&stream, Z_SYNC_FLUSH);
+
+    const bool complete = (result == Z_OK || result == Z_STREAM_END) && stream.total_out == outputLength;
+    inflateEnd(&stream);
+
+    return complete ? std::string() : std::string("Compressed chunk is corrupted");
+  }
+}
+
+mitk::ParallelCompression::Parameters::Parameters()
+  : Level(6), ChunkSize(std::size_t(4) << 20), NumberOfThreads(0)
+{
+}
+
+std::size_t mitk::ParallelCompression::GetNumberOfChunks(std::size_t size, std::size_t chunkSize)
+{
+  return std::max<std::size_t>((size + chunkSize - 1) / chunkSize, 1);
+}
+
+std::vector<std::uint64_t> mitk::ParallelCompression::WriteGzip(std::ostream &stream,
+                                                                const void *data,
+                                                                std::size_t size,
+                                                                const Parameters &parameters)
+{
+  if (parameters.ChunkSize == 0 || parameters.ChunkSize > MaximumChunkSize)
+    mitkThrow() << "Invalid chunk size " << parameters.ChunkSize << " for compression.";
+
+  const int level = std::max(1, std::min(9, parameters.Level));
+  const std::size_t numberOfChunks = GetNumberOfChunks(size, parameters.ChunkSize);
+  const unsigned int numberOfThreads = ParallelLoop::GetNumberOfThreads(parameters.NumberOfThreads, numberOfChunks);
+  const auto *input = static_cast<const unsigned char *>(data);
+
+  std::vector<std::uint64_t> chunkSizes(numberOfChunks);
+  std::vector<uLong> checksums(numberOfChunks);
+
+  // Compress a few chunks per thread at a time and write them in order, so the
+  // memory needed for the compressed data is independent of the image size.
+  const std::size_t batchSize = 4 * static_cast<std::size_t>(numberOfThreads);
+  std::vector<std::vector<unsigned char>> output(batchSize);
+
+  stream.write(reinterpret_cast<const char *>(GzipHeader), sizeof(GzipHeader));
+
+  for (std::size_t batchBegin = 0; batchBegin < numberOfChunks; batchBegin += batchSize)
+  {
+    const std::size_t batchEnd = std::min(batchBegin + batchSize, numberOfChunks);
+
+    ParallelFor(batchEnd - batchBegin, numberOfThreads, [&](std::size_t i) {
+      const std::size_t chunk = batchBegin + i;
+      const unsigned char *chunkData = input + chunk * parameters.ChunkSize;
+      const std::size_t length = GetChunkLength(chunk, size, parameters.ChunkSize);
+
+      checksums[chunk] = crc32(crc32(0L, Z_NULL, 0), chunkData, static_cast<uInt>(length));
+      const std::string error = DeflateChunk(chunkData, length, level, chunk + 1 == numberOfChunks, output[i]);
+      if (!error.empty())
+        mitkThrow() << error;
+    });
+
+    for (std::size_t chunk = batchBegin; chunk < batchEnd; ++chunk)
+    {
+      const std::vector<unsigned char> &compressed = output[chunk - batchBegin];
+      stream.write(reinterpret_cast<const char *>(compressed.data()), compressed.size());
+      chunkSizes[chunk] = compressed.size();
+    }
+
+    if (!stream)
+      mitkThrow() << "Writing compressed data failed.";
+  }
+
+  uLong checksum = checksums[0];
+  for (std::size_t chunk = 1; chunk < numberOfChunks; ++chunk)
+    checksum = crc32_combine(checksum, checksums[chunk], GetChunkLength(chunk, size, parameters.ChunkSize));
+
+  WriteLittleEndian32(stream, static_cast<std::uint32_t>(checksum));
+  WriteLittleEndian32(stream, static_cast<std::uint32_t>(size & 0xffffffff));
+
+  if (!stream)
+    mitkThrow() << "Writing compressed data failed.";
+
+  return chunkSizes;
+}
+
+void mitk::ParallelCompression::ReadGzip(std::istream &stream,
+                                         const std::vector<std::uint64_t> &chunkSizes,
+                                         std::size_t chunkSize,
+                                         void *data,
+                                         std::size_t size,
+                                         unsigned int numberOfThreads)
+{
+  if (chunkSize == 0 || chunkSize > MaximumChunkSize)
+    mitkThrow() << "Invalid chunk size " << chunkSize << " of compressed data.";
+
+  const std::size_t numberOfChunks = GetNumberOfChunks(size, chunkSize);
+  if (chunkSizes.size() != numberOfChunks)
+    mitkThrow() << "Compressed data has " << chunkSizes.size() << " chunks, expected " << numberOfChunks << ".";
+
+  unsigned char header[sizeof(GzipHeader)];
+  stream.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!stream || header[0] != GzipHeader[0] || header[1] != GzipHeader[1] || header[2] != Z_DEFLATED ||
+      header[3] != 0)
+    mitkThrow() << "Compressed data does not start with a gzip header written by mitk::ParallelCompression.";
+
+  numberOfThreads = ParallelLoop::GetNumberOfThreads(numberOfThreads, numberOfChunks);
+  auto *output = static_cast<unsigned char *>(data);
+
+  std::vector<uLong> checksums(numberOfChunks);
+
+  // Read the compressed data of a few chunks per thread at a time and inflate them in parallel.
+  const std::size_t batchSize = 4 * static_cast<std::size_t>(numberOfThreads);
+  std::vector<unsigned char> input;
+  std::vector<std::size_t> inputOffsets(batchSize + 1);
+
+  for (std::size_t batchBegin = 0; batchBegin < numberOfChunks; batchBegin += batchSize)
+  {
+    const std::size_t batchEnd = std::min(batchBegin + batchSize, numberOfChunks);
+
+    inputOffsets[0] = 0;
+    for (std::size_t chunk = batchBegin; chunk < batchEnd; ++chunk)
+    {
+      if (chunkSizes[chunk] > MaximumChunkSize + (MaximumChunkSize >> 4))
+        mitkThrow() << "Invalid size of compressed chunk " << chunk << ".";
+      inputOffsets[chunk - batchBegin + 1] = inputOffsets[chunk - batchBegin] + chunkSizes[chunk];
+    }
+
+    input.resize(inputOffsets[batchEnd - batchBegin]);
+    stream.read(reinterpret_cast<char *>(input.data()), input.size());
+    if (!stream)
+      mitkThrow() << "Compressed data is truncated.";
+
+    ParallelFor(batchEnd - batchBegin, numberOfThreads, [&](std::size_t i) {
+      const std::size_t chunk = batchBegin + i;
+      unsigned char *chunkData = output + chunk * chunkSize;
+      const std::size_t length = GetChunkLength(chunk, size, chunkSize);
+
+      const std::string error = InflateChunk(
+        input.data() + inputOffsets[i], static_cast<std::size_t>(chunkSizes[chunk]), chunkData, length);
+      if (!error.empty())
+        mitkThrow() << error;
+
+      checksums[chunk] = crc32(crc32(0L, Z_NULL, 0), chunkData, static_cast<uInt>(length));
+    });
+  }
+
+  unsigned char trailer[8];
+  stream.read(reinterpret_cast<char *>(trailer), sizeof(trailer));
+  if (!stream)
+    mitkThrow() << "Compressed data is truncated.";
+
+  uLong checksum = checksums[0];
+  for (std::size_t chunk = 1; chunk < numberOfChunks; ++chunk)
+    checksum = crc32_combine(checksum, checksums[chunk], GetChunkLength(chunk, size, chunkSize));
+
+  if (ReadLittleEndian32(trailer) != static_cast<std::uint32_t>(checksum) ||
+      ReadLittleEndian32(trailer + 4) != static_cast<std::uint32_t>(size & 0xffffffff))
+    mitkThrow() << "Checksum of compressed data does not match.";
+}
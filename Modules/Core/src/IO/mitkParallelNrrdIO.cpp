@@ -0,0 +1,380 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelNrrdIO.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itkByteSwapper.h>
+#include <itkMetaDataObject.h>
+#include <itksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  std::string GetNrrdType(const itk::ImageIOBase *imageIO)
+  {
+    const std::size_t bits = 8 * imageIO->GetComponentSize();
+
+    switch (imageIO->GetComponentType())
+    {
+      case itk::ImageIOBase::CHAR:
+      case itk::ImageIOBase::SHORT:
+      case itk::ImageIOBase::INT:
+      case itk::ImageIOBase::LONG:
+      case itk::ImageIOBase::LONGLONG:
+        return "int" + std::to_string(bits);
+      case itk::ImageIOBase::UCHAR:
+      case itk::ImageIOBase::USHORT:
+      case itk::ImageIOBase::UINT:
+      case itk::ImageIOBase::ULONG:
+      case itk::ImageIOBase::ULONGLONG:
+        return "uint" + std::to_string(bits);
+      case itk::ImageIOBase::FLOAT:
+        return "float";
+      case itk::ImageIOBase::DOUBLE:
+        return "double";
+      default:
+        return std::string();
+    }
+  }
+
+  /** NRRD kind of the axis holding the pixel components, empty for scalar images. */
+  std::string GetComponentKind(const itk::ImageIOBase *imageIO)
+  {
+    switch (imageIO->GetPixelType())
+    {
+      case itk::ImageIOBase::RGB:
+        return "RGB-color";
+      case itk::ImageIOBase::RGBA:
+        return "RGBA-color";
+      case itk::ImageIOBase::VECTOR:
+        return "vector";
+      case itk::ImageIOBase::COVARIANTVECTOR:
+        return "covariant-vector";
+      case itk::ImageIOBase::POINT:
+        return "point";
+      default:
+        return std::string();
+    }
+  }
+
+  std::string EscapeValue(const std::string &value)
+  {
+    std::string result;
+    result.reserve(value.size());
+    for (char c : value)
+    {
+      if (c == '\\')
+        result += "\\\\";
+      else if (c == '\n')
+        result += "\\n";
+      else
+        result += c;
+    }
+    return result;
+  }
+
+  void WriteVector(std::ostream &stream, const std::vector<double> &vector)
+  {
+    stream << '(';
+    for (std::size_t i = 0; i < vector.size(); ++i)
+      stream << (i > 0 ? "," : "") << vector[i];
+    stream << ')';
+  }
+
+  /** Key of a per-axis field in the meta data dictionary of itk::NrrdImageIO, e.g. "NRRD_kinds[0]". */
+  std::string GetAxisKey(const std::string &field, unsigned int axis)
+  {
+    return "NRRD_" + field + '[' + std::to_string(axis) + ']';
+  }
+
+  /**
+   * Writes a per-axis NRRD field from the NRRD_<field>[i] entries of the dictionary, if there is one.
+   * Axes without an entry and the component axis get the default value.
+   */
+  template <typename TValue>
+  void WriteAxisField(std::ostream &stream,
+                      const itk::MetaDataDictionary &dictionary,
+                      const std::string &field,
+                      unsigned int dimension,
+                      bool hasComponentAxis,
+                      const std::string &defaultValue,
+                      bool quote)
+  {
+    std::ostringstream values;
+    values.imbue(stream.getloc());
+    values.precision(stream.precision());
+
+    bool found = false;
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      TValue value;
+      if (itk::ExposeMetaData<TValue>(dictionary, GetAxisKey(field, i), value))
+      {
+        found = true;
+        values << ' ' << (quote ? "\"" : "") << value << (quote ? "\"" : "");
+      }
+      else
+      {
+        values << ' ' << defaultValue;
+      }
+    }
+
+    if (found)
+      stream << field << ':' << (hasComponentAxis ? " " + defaultValue : std::string()) << values.str() << '\n';
+  }
+
+  const std::size_t ChunkSizeDigits = 16;
+}
+
+const char *mitk::ParallelNrrdIO::CHUNKS_KEY()
+{
+  return "org_mitk_io_gzip_chunks";
+}
+
+bool mitk::ParallelNrrdIO::CanWrite(const itk::ImageIOBase *imageIO, const std::string &path)
+{
+  if (std::string(imageIO->GetNameOfClass()) != "NrrdImageIO")
+    return false;
+
+  if (itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(path)) != ".nrrd")
+    return false;
+
+  if (GetNrrdType(imageIO).empty() || imageIO->GetNumberOfDimensions() < 1)
+    return false;
+
+  const unsigned int components = imageIO->GetNumberOfComponents();
+  switch (imageIO->GetPixelType())
+  {
+    case itk::ImageIOBase::SCALAR:
+      return components == 1;
+    case itk::ImageIOBase::RGB:
+      return components == 3;
+    case itk::ImageIOBase::RGBA:
+      return components == 4;
+    case itk::ImageIOBase::VECTOR:
+    case itk::ImageIOBase::COVARIANTVECTOR:
+    case itk::ImageIOBase::POINT:
+      return components > 0;
+    default:
+      return false;
+  }
+}
+
+void mitk::ParallelNrrdIO::Write(const itk::ImageIOBase *imageIO,
+                                 const std::string &path,
+                                 const void *data,
+                                 const ParallelCompression::Parameters &parameters)
+{
+  const unsigned int dimension = imageIO->GetNumberOfDimensions();
+  const std::string componentKind = GetComponentKind(imageIO);
+  const std::size_t size = imageIO->GetImageSizeInBytes();
+  const std::size_t numberOfChunks = ParallelCompression::GetNumberOfChunks(size, parameters.ChunkSize);
+
+  std::ostringstream header;
+  header.imbue(std::locale::classic());
+  header.precision(17);
+
+  header << "NRRD0004\n";
+  header << "# Complete NRRD file format specification at:\n";
+  header << "# http://teem.sourceforge.net/nrrd/format.html\n";
+  header << "type: " << GetNrrdType(imageIO) << '\n';
+  header << "dimension: " << dimension + (componentKind.empty() ? 0 : 1) << '\n';
+
+  if (dimension == 3)
+    header << "space: left-posterior-superior\n";
+  else
+    header << "space dimension: " << dimension << '\n';
+
+  header << "sizes:";
+  if (!componentKind.empty())
+    header << ' ' << imageIO->GetNumberOfComponents();
+  for (unsigned int i = 0; i < dimension; ++i)
+    header << ' ' << imageIO->GetDimensions(i);
+  header << '\n';
+
+  header << "space directions:";
+  if (!componentKind.empty())
+    header << " none";
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    std::vector<double> direction = imageIO->GetDirection(i);
+    direction.resize(dimension, 0.0);
+    for (auto &value : direction)
+      value *= imageIO->GetSpacing(i);
+
+    header << ' ';
+    WriteVector(header, direction);
+  }
+  header << '\n';
+
+  const itk::MetaDataDictionary &dictionary = imageIO->GetMetaDataDictionary();
+
+  header << "kinds:";
+  if (!componentKind.empty())
+    header << ' ' << componentKind;
+  for (unsigned int i = 0; i < dimension; ++i)
+  {
+    std::string kind;
+    header << ' ' << (itk::ExposeMetaData<std::string>(dictionary, GetAxisKey("kinds", i), kind) ? kind : "domain");
+  }
+  header << '\n';
+
+  // further NRRD fields read by itk::NrrdImageIO
+  WriteAxisField<double>(header, dictionary, "thicknesses", dimension, !componentKind.empty(), "nan", false);
+  WriteAxisField<std::string>(header, dictionary, "centers", dimension, !componentKind.empty(), "???", false);
+  WriteAxisField<std::string>(header, dictionary, "labels", dimension, !componentKind.empty(), "\"\"", true);
+
+  std::string content;
+  if (itk::ExposeMetaData<std::string>(dictionary, "NRRD_content", content) && content.find('\n') == std::string::npos)
+    header << "content: " << content << '\n';
+
+  double oldValue = 0.0;
+  if (itk::ExposeMetaData<double>(dictionary, "NRRD_old min", oldValue))
+    header << "old min: " << oldValue << '\n';
+  if (itk::ExposeMetaData<double>(dictionary, "NRRD_old max", oldValue))
+    header << "old max: " << oldValue << '\n';
+
+  if (imageIO->GetComponentSize() > 1)
+    header << "endian: " << (itk::ByteSwapper<short>::SystemIsLittleEndian() ? "little" : "big") << '\n';
+
+  header << "encoding: gzip\n";
+
+  std::vector<double> origin(dimension);
+  for (unsigned int i = 0; i < dimension; ++i)
+    origin[i] = imageIO->GetOrigin(i);
+  header << "space origin: ";
+  WriteVector(header, origin);
+  header << '\n';
+
+  std::vector<std::vector<double>> measurementFrame;
+  if (itk::ExposeMetaData<std::vector<std::vector<double>>>(dictionary, "NRRD_measurement frame", measurementFrame) &&
+      measurementFrame.size() == dimension)
+  {
+    header << "measurement frame:";
+    for (auto vector : measurementFrame)
+    {
+      vector.resize(dimension, 0.0);
+      header << ' ';
+      WriteVector(header, vector);
+    }
+    header << '\n';
+  }
+
+  for (const auto &key : dictionary.GetKeys())
+  {
+    std::string value;
+    if (key.compare(0, 5, "NRRD_") == 0 || key == CHUNKS_KEY() || key.find(":=") != std::string::npos ||
+        key.find('\n') != std::string::npos || !itk::ExposeMetaData<std::string>(dictionary, key, value))
+      continue;
+
+    header << key << ":=" << EscapeValue(value) << '\n';
+  }
+
+  // The compressed sizes are known after writing the data, reserve space for them.
+  header << CHUNKS_KEY() << ":=";
+  const std::size_t chunkSizesPosition = header.str().size();
+  header << parameters.ChunkSize;
+  for (std::size_t i = 0; i < numberOfChunks; ++i)
+    header << ' ' << std::string(ChunkSizeDigits, '0');
+  header << "\n\n";
+
+  std::ofstream stream(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream)
+    mitkThrow() << "Cannot open " << path << " for writing.";
+
+  const std::string headerString = header.str();
+  stream.write(headerString.data(), headerString.size());
+
+  const std::vector<std::uint64_t> chunkSizes = ParallelCompression::WriteGzip(stream, data, size, parameters);
+
+  std::ostringstream chunkSizesString;
+  chunkSizesString.imbue(std::locale::classic());
+  chunkSizesString << parameters.ChunkSize;
+  for (auto chunkSize : chunkSizes)
+  {
+    char digits[ChunkSizeDigits + 1];
+    std::snprintf(digits, sizeof(digits), "%016llx", static_cast<unsigned long long>(chunkSize));
+    chunkSizesString << ' ' << digits;
+  }
+
+  stream.seekp(chunkSizesPosition);
+  stream << chunkSizesString.str();
+
+  if (!stream)
+    mitkThrow() << "Writing " << path << " failed.";
+}
+
+bool mitk::ParallelNrrdIO::Read(const itk::ImageIOBase *imageIO,
+                                const std::string &path,
+                                void *buffer,
+                                unsigned int numberOfThreads)
+{
+  std::string chunks;
+  if (!itk::ExposeMetaData<std::string>(imageIO->GetMetaDataDictionary(), CHUNKS_KEY(), chunks))
+    return false;
+
+  std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+  if (!stream)
+    return false;
+
+  std::string line;
+  if (!std::getline(stream, line) || line.compare(0, 4, "NRRD") != 0)
+    return false;
+
+  bool gzipEncoding = false;
+  const std::string hostEndian = itk::ByteSwapper<short>::SystemIsLittleEndian() ? "little" : "big";
+
+  while (std::getline(stream, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    if (line.empty())
+      break;
+
+    if (line == "encoding: gzip" || line == "encoding: gz")
+      gzipEncoding = true;
+    else if (line.compare(0, 10, "data file:") == 0 || line.compare(0, 9, "datafile:") == 0 ||
+             line.compare(0, 10, "line skip:") == 0 || line.compare(0, 9, "lineskip:") == 0 ||
+             line.compare(0, 10, "byte skip:") == 0 || line.compare(0, 9, "byteskip:") == 0)
+      return false;
+    else if (line.compare(0, 7, "endian:") == 0 && line.find(hostEndian) == std::string::npos)
+      return false;
+  }
+
+  if (!gzipEncoding || !stream)
+    return false;
+
+  std::istringstream chunksStream(chunks);
+  chunksStream.imbue(std::locale::classic());
+
+  std::size_t chunkSize = 0;
+  chunksStream >> chunkSize;
+
+  std::vector<std::uint64_t> chunkSizes;
+  unsigned long long compressedSize = 0;
+  while (chunksStream >> std::hex >> compressedSize)
+    chunkSizes.push_back(compressedSize);
+
+  if (chunkSize == 0 || chunkSizes.empty())
+    return false;
+
+  ParallelCompression::ReadGzip(stream, chunkSizes, chunkSize, buffer, imageIO->GetImageSizeInBytes(), numberOfThreads);
+  return true;
+}
@@ -0,0 +1,63 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelNrrdIO_h
+#define mitkParallelNrrdIO_h
+
+#include "mitkParallelCompression.h"
+
+#include <itkImageIOBase.h>
+
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @internal
+   *
+   * @brief Helper of ItkImageIO for writing and reading gzip encoded NRRD files with multiple threads.
+   *
+   * The header is written from the information of an itk::NrrdImageIO that has been set up for
+   * writing, the data is compressed by ParallelCompression. The compressed sizes of the chunks are
+   * stored in the header (key CHUNKS_KEY()), which is ignored by other NRRD readers. The files can
+   * be read by every NRRD reader; files with the chunk index are decompressed in parallel by Read().
+   * The NRRD fields that itk::NrrdImageIO exposes as NRRD_* meta data (e.g. kinds, labels, content
+   * and the measurement frame) are written like itk::NrrdImageIO does.
+   *
+   * @ingroup IO
+   */
+  class ParallelNrrdIO
+  {
+  public:
+    /** Key of the header field holding the chunk size and the compressed sizes of the chunks. */
+    static const char *CHUNKS_KEY();
+
+    /** Checks whether the image set up in imageIO can be written to path by Write(). */
+    static bool CanWrite(const itk::ImageIOBase *imageIO, const std::string &path);
+
+    /** Writes the image set up in imageIO (geometry, pixel type and meta data dictionary) with the given data. */
+    static void Write(const itk::ImageIOBase *imageIO,
+                      const std::string &path,
+                      const void *data,
+                      const ParallelCompression::Parameters &parameters);
+
+    /**
+     * Reads the data of the file (whose information has been read by imageIO) into buffer.
+     * Returns false without reading anything if the file has not been written by Write().
+     * Throws mitk::Exception if the chunk index does not match the data, e.g. because the file
+     * was modified by another tool. The content of the buffer is undefined then.
+     */
+    static bool Read(const itk::ImageIOBase *imageIO, const std::string &path, void *buffer, unsigned int numberOfThreads = 0);
+  };
+}
+
+#endif
@@ -131,6 +131,8 @@ mitk::BaseRenderer::BaseRenderer(const char *name,
     itkWarningMacro(<< "Created unnamed renderer. Bad for serialization. Please choose a name.");
   }
 
+  m_NameKey = PropertyKey(m_Name);
+
   if (renWin != nullptr)
   {
     m_RenderWindow = renWin;
@@ -31,7 +31,6 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkImageVtkMapper2D.h"
 #include "vtkMitkLevelWindowFilter.h"
-#include "vtkMitkThickSlicesFilter.h"
 #include "vtkNeverTranslucentTexture.h"
 
 // VTK
@@ -55,6 +54,48 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <cmath>
+
+namespace
+{
+  // Interned keys of the properties that are read for every rendering
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey BinaryKey("binary");
+  const mitk::PropertyKey HoveringKey("binaryimage.ishovering");
+  const mitk::PropertyKey SelectedKey("selected");
+  const mitk::PropertyKey ColorKey("color");
+  const mitk::PropertyKey HoveringColorKey("binaryimage.hoveringcolor");
+  const mitk::PropertyKey SelectedColorKey("binaryimage.selectedcolor");
+  const mitk::PropertyKey ShadowColorKey("outline binary shadow color");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey RenderingModeKey("Image Rendering.Mode");
+
+  bool ReadColor(const mitk::DataNode *node, const mitk::PropertyKey &key, mitk::BaseRenderer *renderer, float rgb[3])
+  {
+    mitk::ColorProperty *colorprop = nullptr;
+    if (!node->GetProperty(colorprop, key, renderer))
+      return false;
+
+    memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+    return true;
+  }
+
+  /** Compares the sampling grids of the thick slab slices of two renderings (see GenerateDataForRenderer()).
+   * The tolerance absorbs the rounding of plane geometries, which are recomputed while scrolling.*/
+  bool IsSameThickSlabFrame(const std::vector<double> &frame, const std::vector<double> &otherFrame)
+  {
+    if (frame.size() != otherFrame.size())
+      return false;
+
+    for (std::size_t i = 0; i < frame.size(); ++i)
+    {
+      if (std::abs(frame[i] - otherFrame[i]) > 1e-6)
+        return false;
+    }
+    return true;
+  }
+}
+
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
 {
 }
@@ -250,25 +291,65 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     localStorage->m_Reslicer->SetOutputDimensionality(3);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+    localStorage->m_Reslicer->UpdateOutputInformation();
+
+    // The projector keeps the slices of the slab as long as they are sampled on the same grid, so scrolling
+    // only reslices the slices that enter the slab. Slices are indexed by their position along the normal.
+    const PlaneGeometry *slabPlane = abstractGeometry != nullptr ? abstractGeometry->GetPlane() : planeGeometry;
+    const Vector3D slabOrigin = slabPlane->GetOrigin().GetVectorFromOrigin();
+    const double position = slabOrigin * normal / dataZSpacing;
+    const int center = static_cast<int>(std::floor(position + 0.5));
+
+    std::vector<double> frame;
+    if (abstractGeometry == nullptr)
+    {
+      double sliceBounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
+      const Vector3D inPlaneOrigin = slabOrigin - normal * (slabOrigin * normal);
+      const mitk::ScalarType *spacing = localStorage->m_Reslicer->GetOutputSpacing();
+
+      frame = {static_cast<double>(image->GetMTime()), static_cast<double>(this->GetTimestep()),
+               static_cast<double>(localStorage->m_Reslicer->GetInterpolationMode()),
+               static_cast<double>(inPlaneResampleExtentByGeometry), position - center, dataZSpacing,
+               spacing[0], spacing[1], sliceBounds[0], sliceBounds[1], sliceBounds[2], sliceBounds[3]};
+      for (const auto &vector : {inPlaneOrigin, slabPlane->GetAxisVector(0), slabPlane->GetAxisVector(1), normal})
+      {
+        frame.insert(frame.end(), vector.GetDataPointer(), vector.GetDataPointer() + 3);
+      }
+    }
 
-    // Do the reslicing. Modified() is called to make sure that the reslicer is
-    // executed even though the input geometry information did not change; this
-    // is necessary when the input /em data, but not the /em geometry changes.
-    localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+    // curved planes are never reused
+    if (frame.empty() || !IsSameThickSlabFrame(frame, localStorage->m_ThickSlabFrame))
+    {
+      localStorage->m_ThickSlabProjector->Reset();
+    }
+    localStorage->m_ThickSlabFrame = frame;
 
+    // Every change of the center extracts at least the slice entering the slab, so the reslice axes of the
+    // reslicer (used by TransformActor()) always belong to the current plane.
     // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+    auto extractSlice = [localStorage](int offset) -> vtkImageData * {
+      localStorage->m_Reslicer->SetOutputExtentZDirection(offset, offset);
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->Update();
+      return localStorage->m_Reslicer->GetVtkOutput();
+    };
+
+    localStorage->m_ReslicedImage =
+      localStorage->m_ThickSlabProjector->Project(thickSlicesMode - 1, center, thickSlicesNum, extractSlice);
 
-    localStorage->m_TSFilter->Modified();
-    localStorage->m_TSFilter->Update();
-    localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    if (!localStorage->m_ReslicedImage)
+    {
+      localStorage->m_ThickSlabFrame.clear();
+      localStorage->m_Mapper->SetInputData(localStorage->m_EmptyPolyData);
+      return;
+    }
   }
   else
   {
     // this is needed when thick mode was enable bevore. These variable have to be reset to default values
+    localStorage->m_ThickSlabProjector->Reset();
+    localStorage->m_ThickSlabFrame.clear();
     localStorage->m_Reslicer->SetOutputDimensionality(2);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
     localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
@@ -471,38 +552,27 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
   bool hover = false;
   bool selected = false;
   bool binary = false;
-  GetDataNode()->GetBoolProperty("binaryimage.ishovering", hover, renderer);
-  GetDataNode()->GetBoolProperty("selected", selected, renderer);
-  GetDataNode()->GetBoolProperty("binary", binary, renderer);
+  const DataNode *node = GetDataNode();
+  node->GetBoolProperty(HoveringKey, hover, renderer);
+  node->GetBoolProperty(SelectedKey, selected, renderer);
+  node->GetBoolProperty(BinaryKey, binary, renderer);
   if (binary && hover && !selected)
   {
-    mitk::ColorProperty::Pointer colorprop =
-      dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("binaryimage.hoveringcolor", renderer));
-    if (colorprop.IsNotNull())
+    if (!ReadColor(node, HoveringColorKey, renderer, rgb))
     {
-      memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-    }
-    else
-    {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      ReadColor(node, ColorKey, renderer, rgb);
     }
   }
   if (binary && selected)
   {
-    mitk::ColorProperty::Pointer colorprop =
-      dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("binaryimage.selectedcolor", renderer));
-    if (colorprop.IsNotNull())
+    if (!ReadColor(node, SelectedColorKey, renderer, rgb))
     {
-      memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-    }
-    else
-    {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      ReadColor(node, ColorKey, renderer, rgb);
     }
   }
   if (!binary || (!hover && !selected))
   {
-    GetDataNode()->GetColor(rgb, renderer, "color");
+    ReadColor(node, ColorKey, renderer, rgb);
   }
 
   double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
@@ -512,12 +582,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
   if (localStorage->m_Actors->GetParts()->GetNumberOfItems() > 1)
   {
     float rgb[3] = {1.0f, 1.0f, 1.0f};
-    mitk::ColorProperty::Pointer colorprop =
-      dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("outline binary shadow color", renderer));
-    if (colorprop.IsNotNull())
-    {
-      memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-    }
+    ReadColor(node, ShadowColorKey, renderer, rgb);
     double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
     dynamic_cast<vtkActor *>(localStorage->m_Actors->GetParts()->GetItemAsObject(0))->GetProperty()->SetColor(rgbConv);
   }
@@ -528,7 +593,7 @@ void mitk::ImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   // check for opacity prop and use it for rendering if it exists
-  GetDataNode()->GetOpacity(opacity, renderer, "opacity");
+  GetDataNode()->GetPropertyValue(OpacityKey, opacity, renderer);
   // set the opacity according to the properties
   localStorage->m_Actor->GetProperty()->SetOpacity(opacity);
   if (localStorage->m_Actors->GetParts()->GetNumberOfItems() > 1)
@@ -544,7 +609,7 @@ void mitk::ImageVtkMapper2D::ApplyRenderingMode(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
 
   bool binary = false;
-  this->GetDataNode()->GetBoolProperty("binary", binary, renderer);
+  this->GetDataNode()->GetBoolProperty(BinaryKey, binary, renderer);
   if (binary) // is it a binary image?
   {
     // for binary images, we always use our default LuT and map every value to (0,1)
@@ -555,9 +620,8 @@ void mitk::ImageVtkMapper2D::ApplyRenderingMode(mitk::BaseRenderer *renderer)
   {
     // all other image types can make use of the rendering mode
     int renderingMode = mitk::RenderingModeProperty::LOOKUPTABLE_LEVELWINDOW_COLOR;
-    mitk::RenderingModeProperty::Pointer mode =
-      dynamic_cast<mitk::RenderingModeProperty *>(this->GetDataNode()->GetProperty("Image Rendering.Mode", renderer));
-    if (mode.IsNotNull())
+    mitk::RenderingModeProperty *mode = nullptr;
+    if (this->GetDataNode()->GetProperty(mode, RenderingModeKey, renderer))
     {
       renderingMode = mode->GetRenderingMode();
     }
@@ -636,7 +700,7 @@ void mitk::ImageVtkMapper2D::ApplyColorTransferFunction(mitk::BaseRenderer *rend
 void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetBoolProperty(VisibleKey, visible, renderer);
 
   if (!visible)
   {
@@ -1091,15 +1155,13 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_Actor = vtkSmartPointer<vtkActor>::New();
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
   m_Reslicer = mitk::ExtractSliceFilter::New();
-  m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+  m_ThickSlabProjector = mitk::ThickSlabProjector::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
 
   // the following actions are always the same and thus can be performed
   // in the constructor for each image (i.e. the image-corresponding local storage)
-  m_TSFilter->ReleaseDataFlagOn();
-
   mitk::LookupTable::Pointer mitkLUT = mitk::LookupTable::New();
   // built a default lookuptable
   mitkLUT->SetType(mitk::LookupTable::GRAYSCALE);
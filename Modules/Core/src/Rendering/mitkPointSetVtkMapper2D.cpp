@@ -27,6 +27,7 @@ found in the LICENSE file.
 #include <vtkGlyphSource2D.h>
 #include <vtkLine.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPropAssembly.h>
 #include <vtkTextActor.h>
@@ -204,14 +205,6 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
     return;
   }
 
-  // iterator for point set
-  mitk::PointSet::PointsContainer::Iterator pointsIter = itkPointSet->GetPoints()->Begin();
-
-  // PointDataContainer has additional information to each point, e.g. whether
-  // it is selected or not
-  mitk::PointSet::PointDataContainer::Iterator pointDataIter;
-  pointDataIter = itkPointSet->GetPointData()->Begin();
-
   // check if the list for the PointDataContainer is the same size as the PointsContainer.
   // If not, then the points were inserted manually and can not be visualized according to the PointData
   // (selected/unselected)
@@ -225,6 +218,10 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
 
   ls->m_PropAssembly->VisibilityOn();
 
+  // contiguous copy of the points with their ids and whether they are selected or not
+  mitk::PointSetArrays::ConstPointer pointArrays = input->GetPointArrays(timestep);
+  const std::size_t numberOfPoints = pointArrays->GetNumberOfPoints();
+
   // empty point sets, cellarrays, scalars
   ls->m_UnselectedPoints->Reset();
   ls->m_SelectedPoints->Reset();
@@ -252,7 +249,7 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
   // initialize points with a random start value
 
   // current point in point set
-  itk::Point<ScalarType> point = pointsIter->Value();
+  itk::Point<ScalarType> point = pointArrays->GetPoint(0);
 
   mitk::Point3D p = point;     // currently visited point
   mitk::Point3D lastP = point; // last visited point (predecessor in point set of "point")
@@ -269,11 +266,15 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
 
   const mitk::PlaneGeometry *geo2D = renderer->GetCurrentWorldPlaneGeometry();
 
+  // transform all points at once
   vtkLinearTransform *dataNodeTransform = input->GetGeometry()->GetVtkTransform();
+  vtkSmartPointer<vtkPoints> transformedPoints = vtkSmartPointer<vtkPoints>::New();
+  transformedPoints->Allocate(numberOfPoints);
+  dataNodeTransform->TransformPoints(pointArrays->GetVtkPoints(), transformedPoints);
 
   int count = 0;
 
-  for (pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End(); pointsIter++)
+  for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
   {
     lastP = p;              // valid for number of points count > 0
     preLastPt2d = lastPt2d; // valid only for count > 1
@@ -281,16 +282,8 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
 
     lastVec = vec; // valid only for counter > 1
 
-    // get current point in point set
-    point = pointsIter->Value();
-
-    // transform point
-    {
-      float vtkp[3];
-      itk2vtk(point, vtkp);
-      dataNodeTransform->TransformPoint(vtkp, vtkp);
-      vtk2itk(vtkp, point);
-    }
+    // get current transformed point in point set
+    vtk2itk(transformedPoints->GetPoint(pointIndex), point);
 
     p[0] = point[0];
     p[1] = point[1];
@@ -308,7 +301,7 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
     if (dist < m_DistanceToPlane)
     {
       // is point selected or not?
-      if (pointDataIter->Value().selected)
+      if (pointArrays->IsSelected(pointIndex))
       {
         ls->m_SelectedPoints->InsertNextPoint(point[0], point[1], point[2]);
         // point is scaled according to its distance to the plane
@@ -331,7 +324,7 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
         if (input->GetSize() > 1)
         {
           std::stringstream ss;
-          ss << pointsIter->Index();
+          ss << pointArrays->GetId(pointIndex);
           l.append(ss.str());
         }
 
@@ -427,11 +420,7 @@ void mitk::PointSetVtkMapper2D::CreateVTKRenderObjects(mitk::BaseRenderer *rende
       }
     }
 
-    if (pointDataIter != itkPointSet->GetPointData()->End())
-    {
-      pointDataIter++;
-      count++;
-    }
+    count++;
   }
 
   // add each single text actor to the assembly
@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <vtkConeSource.h>
 #include <vtkCubeSource.h>
 #include <vtkCylinderSource.h>
+#include <vtkPoints.h>
 #include <vtkPolyDataAlgorithm.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPropAssembly.h>
@@ -165,26 +166,20 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
       contourPointLimit = nbPoints - 1;
   }
 
-  // build list of all positions for later transform in one go
-  mitk::PointSet::PointsContainer::Iterator pointsIter;
+  // all positions are transformed in one go, directly from the contiguous coordinates of the point set
   int ptIdx;
 
   m_NumberOfSelectedAdded = 0;
   m_NumberOfUnselectedAdded = 0;
-  vtkSmartPointer<vtkPoints> localPoints = vtkSmartPointer<vtkPoints>::New();
+  mitk::PointSetArrays::ConstPointer pointArrays = input->GetPointArrays(timestep);
+  vtkPoints *localPoints = pointArrays->GetVtkPoints();
   m_WorldPositions = vtkSmartPointer<vtkPoints>::New();
   m_PointConnections = vtkSmartPointer<vtkCellArray>::New(); // m_PointConnections between points
-  for (ptIdx = 0, pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End();
-       pointsIter++, ptIdx++)
+  const int numberOfPositions = static_cast<int>(pointArrays->GetNumberOfPoints());
+  for (ptIdx = 0; makeContour && ptIdx < contourPointLimit && ptIdx < numberOfPositions; ++ptIdx)
   {
-    itk::Point<float> currentPoint = pointsIter->Value();
-    localPoints->InsertPoint(ptIdx, currentPoint[0], currentPoint[1], currentPoint[2]);
-
-    if (makeContour && ptIdx < contourPointLimit)
-    {
-      vtkIdType cell[2] = {(ptIdx + 1) % nbPoints, ptIdx};
-      m_PointConnections->InsertNextCell(2, cell);
-    }
+    vtkIdType cell[2] = {(ptIdx + 1) % nbPoints, ptIdx};
+    m_PointConnections->InsertNextCell(2, cell);
   }
 
   vtkSmartPointer<vtkLinearTransform> vtktransform = this->GetDataNode()->GetVtkTransform(this->GetTimestep());
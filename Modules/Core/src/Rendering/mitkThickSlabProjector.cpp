@@ -0,0 +1,460 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkThickSlabProjector.h"
+
+#include "vtkMitkThickSlicesFilter.h"
+
+#include <mitkLogMacros.h>
+#include <mitkParallelFor.h>
+
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  /** Slices smaller than this are reduced on one thread.*/
+  const std::size_t MinimumPixelsPerThread = 1 << 15;
+
+  /** Number of pixels whose accumulators are kept in the cache while all slices are added to them.*/
+  const std::size_t PixelBlockSize = 1 << 12;
+
+  /** Calls job(begin, end) for consecutive pixel ranges of whole rows on the shared worker threads.*/
+  template <typename JobType>
+  void ParallelForRows(unsigned int numberOfThreads, std::size_t rows, std::size_t rowLength, JobType job)
+  {
+    const std::size_t pixels = rows * rowLength;
+    numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(
+      mitk::ParallelLoop::GetNumberOfThreads(numberOfThreads, rows),
+      std::max<std::size_t>(pixels / MinimumPixelsPerThread, 1)));
+
+    if (numberOfThreads <= 1)
+    {
+      job(std::size_t(0), pixels);
+      return;
+    }
+
+    mitk::ParallelForRanges(rows, numberOfThreads, [&job, rowLength](std::size_t begin, std::size_t end) {
+      job(begin * rowLength, end * rowLength);
+    });
+  }
+
+  template <typename TPixel>
+  TPixel *GetPixels(vtkImageData *image)
+  {
+    return static_cast<TPixel *>(image->GetScalarPointer());
+  }
+
+  std::size_t GetNumberOfRows(vtkImageData *image) { return image->GetDimensions()[1]; }
+
+  std::size_t GetRowLength(vtkImageData *image) { return image->GetDimensions()[0]; }
+
+  int FloorDivision(int value, int divisor)
+  {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+  }
+
+  bool HaveSameLayout(vtkImageData *slice, vtkImageData *reference)
+  {
+    const int *extent = slice->GetExtent();
+    const int *referenceExtent = reference->GetExtent();
+
+    return slice->GetScalarType() == reference->GetScalarType() && extent[0] == referenceExtent[0] &&
+           extent[1] == referenceExtent[1] && extent[2] == referenceExtent[2] && extent[3] == referenceExtent[3];
+  }
+}
+
+mitk::ThickSlabProjector::ThickSlabProjector()
+  : m_NumberOfThreads(0),
+    m_NumberOfExtractedSlices(0),
+    m_Mode(-1),
+    m_HalfThickness(-1),
+    m_SumLow(0),
+    m_SumHigh(-1),
+    m_SumUpdates(0),
+    m_Output(SlicePointer::New())
+{
+}
+
+mitk::ThickSlabProjector::~ThickSlabProjector()
+{
+}
+
+void mitk::ThickSlabProjector::Reset()
+{
+  m_Slices.clear();
+  m_PrefixExtrema.clear();
+  m_SuffixExtrema.clear();
+  m_Sum.clear();
+  m_SumLow = 0;
+  m_SumHigh = -1;
+  m_SumUpdates = 0;
+}
+
+mitk::ThickSlabProjector::SlicePointer mitk::ThickSlabProjector::NewSliceLike(vtkImageData *slice) const
+{
+  SlicePointer result = SlicePointer::New();
+  result->CopyStructure(slice);
+  result->AllocateScalars(slice->GetScalarType(), 1);
+  return result;
+}
+
+vtkImageData *mitk::ThickSlabProjector::Project(int mode, int center, int halfThickness, const SliceExtractorType &extractor)
+{
+  m_NumberOfExtractedSlices = 0;
+  halfThickness = std::max(halfThickness, 0);
+
+  if (mode != m_Mode || halfThickness != m_HalfThickness)
+  {
+    // the projection states depend on the mode and the block size; the slices stay valid
+    m_PrefixExtrema.clear();
+    m_SuffixExtrema.clear();
+    m_Sum.clear();
+    m_Mode = mode;
+    m_HalfThickness = halfThickness;
+  }
+
+  const int low = center - halfThickness;
+  const int high = center + halfThickness;
+
+  for (int index = low; index <= high; ++index)
+  {
+    if (m_Slices.find(index) != m_Slices.end())
+      continue;
+
+    vtkImageData *slice = extractor(index - center);
+
+    if (nullptr == slice || slice->GetNumberOfScalarComponents() != 1 || slice->GetDimensions()[2] != 1)
+    {
+      MITK_ERROR << "ThickSlabProjector: Slice " << index - center << " of the slab could not be extracted.";
+      this->Reset();
+      return nullptr;
+    }
+
+    if (!m_Slices.empty() && !HaveSameLayout(slice, m_Slices.begin()->second))
+    {
+      if (m_NumberOfExtractedSlices == 0)
+      {
+        // the slice layout changed since the last call, nothing kept is valid anymore
+        this->Reset();
+        index = low - 1;
+        continue;
+      }
+
+      MITK_ERROR << "ThickSlabProjector: Slices of the slab differ in extent or pixel type.";
+      this->Reset();
+      return nullptr;
+    }
+
+    SlicePointer copy = SlicePointer::New();
+    copy->DeepCopy(slice);
+    m_Slices[index] = copy;
+    ++m_NumberOfExtractedSlices;
+  }
+
+  vtkImageData *centerSlice = m_Slices[center];
+  const int *extent = centerSlice->GetExtent();
+  const int *outputExtent = m_Output->GetExtent();
+
+  if (m_Output->GetScalarType() != centerSlice->GetScalarType() || m_Output->GetPointData()->GetScalars() == nullptr ||
+      !std::equal(extent, extent + 4, outputExtent) || outputExtent[4] != 0 || outputExtent[5] != 0)
+  {
+    m_Output->SetExtent(extent[0], extent[1], extent[2], extent[3], 0, 0);
+    m_Output->AllocateScalars(centerSlice->GetScalarType(), 1);
+  }
+  m_Output->SetOrigin(centerSlice->GetOrigin());
+  m_Output->SetSpacing(centerSlice->GetSpacing());
+
+  switch (centerSlice->GetScalarType())
+  {
+    vtkTemplateMacro(this->ProjectTemplate<VTK_TT>(low, high));
+    default:
+      MITK_ERROR << "ThickSlabProjector: Unknown scalar type " << centerSlice->GetScalarType();
+      this->Reset();
+      return nullptr;
+  }
+
+  // forget everything that left the slab
+  for (auto *map : {&m_Slices, &m_PrefixExtrema, &m_SuffixExtrema})
+  {
+    map->erase(map->begin(), map->lower_bound(low));
+    map->erase(map->upper_bound(high), map->end());
+  }
+
+  m_Output->Modified();
+  return m_Output;
+}
+
+template <typename TPixel>
+void mitk::ThickSlabProjector::ProjectTemplate(int low, int high)
+{
+  switch (m_Mode)
+  {
+    default:
+    case vtkMitkThickSlicesFilter::MIP:
+      this->ProjectExtremum<TPixel>(low, high, true);
+      break;
+    case vtkMitkThickSlicesFilter::MINIP:
+      this->ProjectExtremum<TPixel>(low, high, false);
+      break;
+    case vtkMitkThickSlicesFilter::SUM:
+    case vtkMitkThickSlicesFilter::MEAN:
+      this->ProjectSum<TPixel>(low, high);
+      break;
+    case vtkMitkThickSlicesFilter::WEIGHTED:
+      this->ProjectWeighted<TPixel>(low, high);
+      break;
+  }
+}
+
+template <typename TPixel>
+void mitk::ThickSlabProjector::ProjectExtremum(int low, int high, bool maximum)
+{
+  const int blockSize = high - low + 1;
+  const int highBlockStart = FloorDivision(high, blockSize) * blockSize;
+
+  TPixel *output = GetPixels<TPixel>(m_Output);
+
+  if (highBlockStart <= low)
+  {
+    // the slab is exactly one block
+    vtkImageData *extremum = this->GetSuffixExtremum<TPixel>(low, high, maximum);
+    std::memcpy(output, GetPixels<TPixel>(extremum), GetNumberOfRows(m_Output) * GetRowLength(m_Output) * sizeof(TPixel));
+    return;
+  }
+
+  const TPixel *suffix = GetPixels<TPixel>(this->GetSuffixExtremum<TPixel>(low, highBlockStart - 1, maximum));
+  const TPixel *prefix = GetPixels<TPixel>(this->GetPrefixExtremum<TPixel>(high, highBlockStart, maximum));
+
+  ParallelForRows(m_NumberOfThreads, GetNumberOfRows(m_Output), GetRowLength(m_Output), [=](std::size_t begin, std::size_t end) {
+    if (maximum)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        output[i] = std::max(suffix[i], prefix[i]);
+    }
+    else
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        output[i] = std::min(suffix[i], prefix[i]);
+    }
+  });
+}
+
+template <typename TPixel>
+vtkImageData *mitk::ThickSlabProjector::GetPrefixExtremum(int index, int blockStart, bool maximum)
+{
+  // find the last prefix extremum that is already known
+  int first = index;
+  while (first > blockStart && m_PrefixExtrema.find(first) == m_PrefixExtrema.end())
+    --first;
+
+  if (first == blockStart && m_PrefixExtrema.find(first) == m_PrefixExtrema.end())
+    m_PrefixExtrema[first] = m_Slices[first];
+
+  for (int i = first + 1; i <= index; ++i)
+  {
+    vtkImageData *slice = m_Slices[i];
+    SlicePointer extremum = this->NewSliceLike(slice);
+
+    const TPixel *a = GetPixels<TPixel>(m_PrefixExtrema[i - 1]);
+    const TPixel *b = GetPixels<TPixel>(slice);
+    TPixel *result = GetPixels<TPixel>(extremum);
+
+    ParallelForRows(m_NumberOfThreads, GetNumberOfRows(slice), GetRowLength(slice), [=](std::size_t begin, std::size_t end) {
+      if (maximum)
+      {
+        for (std::size_t p = begin; p < end; ++p)
+          result[p] = std::max(a[p], b[p]);
+      }
+      else
+      {
+        for (std::size_t p = begin; p < end; ++p)
+          result[p] = std::min(a[p], b[p]);
+      }
+    });
+
+    m_PrefixExtrema[i] = extremum;
+  }
+
+  return m_PrefixExtrema[index];
+}
+
+template <typename TPixel>
+vtkImageData *mitk::ThickSlabProjector::GetSuffixExtremum(int index, int blockEnd, bool maximum)
+{
+  // find the first suffix extremum that is already known
+  int last = index;
+  while (last < blockEnd && m_SuffixExtrema.find(last) == m_SuffixExtrema.end())
+    ++last;
+
+  if (last == blockEnd && m_SuffixExtrema.find(last) == m_SuffixExtrema.end())
+    m_SuffixExtrema[last] = m_Slices[last];
+
+  for (int i = last - 1; i >= index; --i)
+  {
+    vtkImageData *slice = m_Slices[i];
+    SlicePointer extremum = this->NewSliceLike(slice);
+
+    const TPixel *a = GetPixels<TPixel>(m_SuffixExtrema[i + 1]);
+    const TPixel *b = GetPixels<TPixel>(slice);
+    TPixel *result = GetPixels<TPixel>(extremum);
+
+    ParallelForRows(m_NumberOfThreads, GetNumberOfRows(slice), GetRowLength(slice), [=](std::size_t begin, std::size_t end) {
+      if (maximum)
+      {
+        for (std::size_t p = begin; p < end; ++p)
+          result[p] = std::max(a[p], b[p]);
+      }
+      else
+      {
+        for (std::size_t p = begin; p < end; ++p)
+          result[p] = std::min(a[p], b[p]);
+      }
+    });
+
+    m_SuffixExtrema[i] = extremum;
+  }
+
+  return m_SuffixExtrema[index];
+}
+
+template <typename TPixel>
+void mitk::ThickSlabProjector::ProjectSum(int low, int high)
+{
+  const int size = high - low + 1;
+  const std::size_t rows = GetNumberOfRows(m_Output);
+  const std::size_t rowLength = GetRowLength(m_Output);
+  const std::size_t pixels = rows * rowLength;
+
+  // slices to add (+1) to and to subtract (-1) from the sum
+  std::vector<std::pair<const TPixel *, double>> updates;
+
+  bool rebuild = m_Sum.size() != pixels || m_SumLow > m_SumHigh || high < m_SumLow || low > m_SumHigh ||
+                 std::abs(low - m_SumLow) + std::abs(high - m_SumHigh) >= size;
+
+  // floating point sums drift when slices are added and subtracted repeatedly
+  if (!std::numeric_limits<TPixel>::is_integer && m_SumUpdates >= static_cast<unsigned int>(size))
+    rebuild = true;
+
+  if (rebuild)
+  {
+    m_Sum.assign(pixels, 0.0);
+    m_SumUpdates = 0;
+
+    for (int i = low; i <= high; ++i)
+      updates.emplace_back(GetPixels<TPixel>(m_Slices[i]), 1.0);
+  }
+  else
+  {
+    for (int i = m_SumLow; i < low; ++i)
+      updates.emplace_back(GetPixels<TPixel>(m_Slices[i]), -1.0);
+    for (int i = low; i < m_SumLow; ++i)
+      updates.emplace_back(GetPixels<TPixel>(m_Slices[i]), 1.0);
+    for (int i = high + 1; i <= m_SumHigh; ++i)
+      updates.emplace_back(GetPixels<TPixel>(m_Slices[i]), -1.0);
+    for (int i = m_SumHigh + 1; i <= high; ++i)
+      updates.emplace_back(GetPixels<TPixel>(m_Slices[i]), 1.0);
+
+    ++m_SumUpdates;
+  }
+
+  m_SumLow = low;
+  m_SumHigh = high;
+
+  // SUM averages over all slices, MEAN divides by the number of slices - 1 (as vtkMitkThickSlicesFilter)
+  const bool mean = m_Mode == vtkMitkThickSlicesFilter::MEAN;
+  const double invNum = 1.0 / size;
+  const long double meanDivisor = std::max(size - 1, 1);
+
+  double *sum = m_Sum.data();
+  TPixel *output = GetPixels<TPixel>(m_Output);
+
+  ParallelForRows(m_NumberOfThreads, rows, rowLength, [&, sum, output](std::size_t begin, std::size_t end) {
+    for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += PixelBlockSize)
+    {
+      const std::size_t blockEnd = std::min(blockBegin + PixelBlockSize, end);
+
+      for (const auto &update : updates)
+      {
+        const TPixel *slice = update.first;
+        if (update.second > 0)
+        {
+          for (std::size_t i = blockBegin; i < blockEnd; ++i)
+            sum[i] += slice[i];
+        }
+        else
+        {
+          for (std::size_t i = blockBegin; i < blockEnd; ++i)
+            sum[i] -= slice[i];
+        }
+      }
+
+      if (mean)
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+          output[i] = static_cast<TPixel>(sum[i] / meanDivisor);
+      }
+      else
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+          output[i] = static_cast<TPixel>(invNum * sum[i]);
+      }
+    }
+  });
+}
+
+template <typename TPixel>
+void mitk::ThickSlabProjector::ProjectWeighted(int low, int high)
+{
+  // Gaussian weights of the slices 1..size of the slab, as computed by vtkMitkThickSlicesFilter
+  const int size = high - low;
+  std::vector<double> weights(size);
+  const double mean = 0.5 * size;
+  double sigma_sq = double(size) / 6.0;
+  sigma_sq *= sigma_sq;
+  double weightSum = 0;
+  for (int z = 1; z <= size; ++z)
+  {
+    weights[z - 1] = std::exp(-((z - mean) / sigma_sq));
+    weightSum += weights[z - 1];
+  }
+
+  std::vector<std::pair<const TPixel *, double>> slices;
+  for (int z = 1; z <= size; ++z)
+    slices.emplace_back(GetPixels<TPixel>(m_Slices[low + z]), weights[z - 1] / weightSum);
+
+  TPixel *output = GetPixels<TPixel>(m_Output);
+
+  ParallelForRows(m_NumberOfThreads, GetNumberOfRows(m_Output), GetRowLength(m_Output), [&, output](std::size_t begin, std::size_t end) {
+    std::vector<double> accumulator(PixelBlockSize);
+
+    for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += PixelBlockSize)
+    {
+      const std::size_t blockEnd = std::min(blockBegin + PixelBlockSize, end);
+
+      std::fill(accumulator.begin(), accumulator.end(), 0.0);
+      for (const auto &slice : slices)
+      {
+        for (std::size_t i = blockBegin; i < blockEnd; ++i)
+          accumulator[i - blockBegin] += slice.first[i] * slice.second;
+      }
+
+      for (std::size_t i = blockBegin; i < blockEnd; ++i)
+        output[i] = static_cast<TPixel>(accumulator[i - blockBegin]);
+    }
+  });
+}
@@ -25,6 +25,10 @@ found in the LICENSE file.
 // used for acos etc.
 #include <cmath>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 // used for PI
 #include <itkMath.h>
 
@@ -35,8 +39,21 @@ static const double PI = itk::Math::pi;
 vtkStandardNewMacro(vtkMitkLevelWindowFilter);
 
 vtkMitkLevelWindowFilter::vtkMitkLevelWindowFilter()
-  : m_LookupTable(nullptr), m_OpacityFunction(nullptr), m_MinOpacity(0.0), m_MaxOpacity(255.0)
+  : m_LookupTable(nullptr),
+    m_OpacityFunction(nullptr),
+    m_MinOpacity(0.0),
+    m_MaxOpacity(255.0),
+    m_ColorTableType(NoColorTable),
+    m_ColorTableOffset(0),
+    m_ColorTableScalarType(VTK_VOID),
+    m_ColorTableLookupTable(nullptr),
+    m_ColorTableLookupTableTime(0),
+    m_ColorTableOpacityFunction(nullptr),
+    m_ColorTableOpacityFunctionTime(0)
 {
+  m_ColorTableRange[0] = 0.0;
+  m_ColorTableRange[1] = 0.0;
+
   // MITK_INFO << "mitk level/window filter uses " << GetNumberOfThreads() << " thread(s)";
 }
 
@@ -55,6 +72,12 @@ vtkMTimeType vtkMitkLevelWindowFilter::GetMTime()
     mTime = (time > mTime ? time : mTime);
   }
 
+  if (this->m_OpacityFunction != nullptr)
+  {
+    time = this->m_OpacityFunction->GetMTime();
+    mTime = (time > mTime ? time : mTime);
+  }
+
   return mTime;
 }
 
@@ -274,120 +297,119 @@ void vtkApplyLookupTableOnRGBA(vtkMitkLevelWindowFilter *self,
 }
 
 // Internal method which should never be used anywhere else and should not be in th header.
-//----------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
-template <class T>
-void vtkApplyLookupTableOnScalarsFast(
-  vtkMitkLevelWindowFilter *self, vtkImageData *inData, vtkImageData *outData, int outExt[6], T *)
+// Computes the range [begin, end) of the pixels of row y within the clipping bounds, relative to outExt[0].
+static void GetUnclippedRowRange(int y, int outExt[6], double *clippingBounds, int &begin, int &end)
 {
-  vtkImageIterator<T> inputIt(inData, outExt);
-  vtkImageIterator<unsigned char> outputIt(outData, outExt);
+  const int length = outExt[1] - outExt[0] + 1;
 
-  double tableRange[2];
-
-  // access vtkLookupTable
-  auto *lookupTable = dynamic_cast<vtkLookupTable *>(self->GetLookupTable());
-  lookupTable->GetTableRange(tableRange);
-
-  // access elements of the vtkLookupTable
-  const int *realLookupTable = reinterpret_cast<int *>(lookupTable->GetTable()->GetPointer(0));
-  int maxIndex = lookupTable->GetNumberOfColors() - 1;
-
-  const float scale = (tableRange[1] - tableRange[0] > 0 ? (maxIndex + 1) / (tableRange[1] - tableRange[0]) : 0.0);
-  // ensuring that starting point is zero
-  float bias = -tableRange[0] * scale;
-  // due to later conversion to int for rounding
-  bias += 0.5f;
-
-  // Loop through ouput pixels
-  while (!outputIt.IsAtEnd())
+  begin = 0;
+  end = 0;
+  if (y >= clippingBounds[2] && y < clippingBounds[3])
   {
-    unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
+    // x >= bound and x < bound hold for all integers x from std::ceil(bound) on and below std::ceil(bound)
+    begin = std::max(0, std::min(length, static_cast<int>(std::ceil(clippingBounds[0])) - outExt[0]));
+    end = std::max(begin, std::min(length, static_cast<int>(std::ceil(clippingBounds[1])) - outExt[0]));
+  }
+}
 
-    T *inputSI = inputIt.BeginSpan();
+// Internal method which should never be used anywhere else and should not be in th header.
+// Maps a value with a color transfer function and an optional opacity function to an RGBA pixel.
+static unsigned int MapColorTransferFunction(vtkColorTransferFunction *lookupTable,
+                                             vtkPiecewiseFunction *opacityFunction,
+                                             double grayValue)
+{
+  // applying directly colortransferfunction
+  // because vtkColorTransferFunction::MapValue is not threadsafe
+  double rgba[4];
+  lookupTable->GetColor(grayValue, rgba); // RGB mapping
+  rgba[3] = 1.0;
+  if (opacityFunction)
+    rgba[3] = opacityFunction->GetValue(grayValue); // Alpha mapping
+
+  unsigned char pixel[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    pixel[i] = static_cast<unsigned char>(255.0 * rgba[i] + 0.5);
+  }
 
-    while (outputSI != outputSIEnd)
-    {
-      // map to an index
-      auto idx = static_cast<int>(*inputSI * scale + bias);
+  unsigned int result;
+  std::memcpy(&result, pixel, sizeof(result));
+  return result;
+}
 
-      if (idx < 0)
-        idx = 0;
-      else if (idx > maxIndex)
-        idx = maxIndex;
+// Internal method which should never be used anywhere else and should not be in th header.
+// Maps values to the RGBA pixels of a vtkLookupTable with linear scale by rounding to the nearest table index.
+class LinearLookupTableMapping
+{
+public:
+  explicit LinearLookupTableMapping(vtkLookupTable *lookupTable)
+  {
+    double tableRange[2];
+    lookupTable->GetTableRange(tableRange);
+
+    // access elements of the vtkLookupTable
+    m_Table = reinterpret_cast<const unsigned int *>(lookupTable->GetTable()->GetPointer(0));
+    m_MaxIndex = lookupTable->GetNumberOfColors() - 1;
+
+    m_Scale = (tableRange[1] - tableRange[0] > 0 ? (m_MaxIndex + 1) / (tableRange[1] - tableRange[0]) : 0.0);
+    // ensuring that starting point is zero
+    m_Bias = -tableRange[0] * m_Scale;
+    // due to later conversion to int for rounding
+    m_Bias += 0.5f;
+  }
 
-      *reinterpret_cast<int *>(outputSI) = realLookupTable[idx];
+  template <class T>
+  unsigned int operator()(T value) const
+  {
+    // map to an index
+    auto idx = static_cast<int>(value * m_Scale + m_Bias);
 
-      inputSI++;
-      outputSI += 4;
-    }
+    if (idx < 0)
+      idx = 0;
+    else if (idx > m_MaxIndex)
+      idx = m_MaxIndex;
 
-    inputIt.NextSpan();
-    outputIt.NextSpan();
+    return m_Table[idx];
   }
-}
+
+private:
+  const unsigned int *m_Table;
+  int m_MaxIndex;
+  float m_Scale;
+  float m_Bias;
+};
 
 // Internal method which should never be used anywhere else and should not be in th header.
 //----------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
-template <class T>
-void vtkApplyLookupTableOnScalars(vtkMitkLevelWindowFilter *self,
-                                  vtkImageData *inData,
-                                  vtkImageData *outData,
-                                  int outExt[6],
-                                  double *clippingBounds,
-                                  T *)
+// Applies a mapping from values to RGBA pixels to the pixels within the clipping bounds
+// and writes transparent pixels outside of them.
+template <class T, class MappingType>
+void vtkApplyMappingOnScalars(
+  const MappingType &mapping, vtkImageData *inData, vtkImageData *outData, int outExt[6], double *clippingBounds, T *)
 {
   vtkImageIterator<T> inputIt(inData, outExt);
   vtkImageIterator<unsigned char> outputIt(outData, outExt);
-  vtkScalarsToColors *lookupTable = self->GetLookupTable();
 
+  const int length = outExt[1] - outExt[0] + 1;
   int y = outExt[2];
 
   // Loop through ouput pixels
   while (!outputIt.IsAtEnd())
   {
-    unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
-
-    // do we iterate over the inner vertical clipping bounds
-    if (y >= clippingBounds[2] && y < clippingBounds[3])
-    {
-      T *inputSI = inputIt.BeginSpan();
+    const T *inputSI = inputIt.BeginSpan();
+    // RGBA pixels are written as single ints
+    auto *outputSI = reinterpret_cast<unsigned int *>(outputIt.BeginSpan());
 
-      int x = outExt[0];
+    int begin, end;
+    GetUnclippedRowRange(y, outExt, clippingBounds, begin, end);
 
-      while (outputSI != outputSIEnd)
-      {
-        // is this pixel within horizontal clipping bounds
-        if (x >= clippingBounds[0] && x < clippingBounds[1])
-        {
-          // fetching original value
-          auto grayValue = static_cast<double>(*inputSI);
-          // applying lookuptable - copy the 4 (RGBA) chars as a single int
-          *reinterpret_cast<int *>(outputSI) = *reinterpret_cast<int *>(lookupTable->MapValue(grayValue));
-        }
-        else
-        {
-          // outer horizontal clipping bounds - write a transparent RGBA pixel as a single int
-          *reinterpret_cast<int *>(outputSI) = 0;
-        }
-
-        inputSI++;
-        outputSI += 4;
-        x++;
-      }
-    }
-    else
+    // outer clipping bounds - write transparent RGBA pixels
+    std::fill(outputSI, outputSI + begin, 0u);
+    for (int x = begin; x < end; ++x)
     {
-      // outer vertical clipping bounds - write a transparent RGBA line as ints
-      while (outputSI != outputSIEnd)
-      {
-        *reinterpret_cast<int *>(outputSI) = 0;
-        outputSI += 4;
-      }
+      outputSI[x] = mapping(inputSI[x]);
     }
+    std::fill(outputSI + end, outputSI + length, 0u);
 
     inputIt.NextSpan();
     outputIt.NextSpan();
@@ -397,76 +419,33 @@ void vtkApplyLookupTableOnScalars(vtkMitkLevelWindowFilter *self,
 
 // Internal method which should never be used anywhere else and should not be in th header.
 //----------------------------------------------------------------------------
-// This templated function executes the filter for any type of data.
+// Applies a color table with one RGBA pixel per value of the 8/16 bit type T. colorTable points to
+// the entry of value 0. The inner loop is a plain gather without branches, so it can be vectorized.
 template <class T>
-void vtkApplyLookupTableOnScalarsCTF(vtkMitkLevelWindowFilter *self,
-                                     vtkImageData *inData,
-                                     vtkImageData *outData,
-                                     int outExt[6],
-                                     double *clippingBounds,
-                                     T *)
+void vtkApplyColorTableOnScalars(
+  const unsigned int *colorTable, vtkImageData *inData, vtkImageData *outData, int outExt[6], double *clippingBounds, T *)
 {
   vtkImageIterator<T> inputIt(inData, outExt);
   vtkImageIterator<unsigned char> outputIt(outData, outExt);
-  auto *lookupTable = dynamic_cast<vtkColorTransferFunction *>(self->GetLookupTable());
-  vtkPiecewiseFunction *opacityFunction = self->GetOpacityPiecewiseFunction();
 
+  const int length = outExt[1] - outExt[0] + 1;
   int y = outExt[2];
 
   // Loop through ouput pixels
   while (!outputIt.IsAtEnd())
   {
-    unsigned char *outputSI = outputIt.BeginSpan();
-    unsigned char *outputSIEnd = outputIt.EndSpan();
+    const T *inputSI = inputIt.BeginSpan();
+    auto *outputSI = reinterpret_cast<unsigned int *>(outputIt.BeginSpan());
 
-    // do we iterate over the inner vertical clipping bounds
-    if (y >= clippingBounds[2] && y < clippingBounds[3])
-    {
-      T *inputSI = inputIt.BeginSpan();
-
-      int x = outExt[0];
-
-      while (outputSI != outputSIEnd)
-      {
-        // is this pixel within horizontal clipping bounds
-        if (x >= clippingBounds[0] && x < clippingBounds[1])
-        {
-          // fetching original value
-          auto grayValue = static_cast<double>(*inputSI);
-
-          // applying directly colortransferfunction
-          // because vtkColorTransferFunction::MapValue is not threadsafe
-          double rgba[4];
-          lookupTable->GetColor(grayValue, rgba); // RGB mapping
-          rgba[3] = 1.0;
-          if (opacityFunction)
-            rgba[3] = opacityFunction->GetValue(grayValue); // Alpha mapping
-
-          for (int i = 0; i < 4; ++i)
-          {
-            outputSI[i] = static_cast<unsigned char>(255.0 * rgba[i] + 0.5);
-          }
-        }
-        else
-        {
-          // outer horizontal clipping bounds - write a transparent RGBA pixel as a single int
-          *reinterpret_cast<int *>(outputSI) = 0;
-        }
+    int begin, end;
+    GetUnclippedRowRange(y, outExt, clippingBounds, begin, end);
 
-        inputSI++;
-        outputSI += 4;
-        x++;
-      }
-    }
-    else
+    std::fill(outputSI, outputSI + begin, 0u);
+    for (int x = begin; x < end; ++x)
     {
-      // outer vertical clipping bounds - write a transparent RGBA line as ints
-      while (outputSI != outputSIEnd)
-      {
-        *reinterpret_cast<int *>(outputSI) = 0;
-        outputSI += 4;
-      }
+      outputSI[x] = colorTable[static_cast<int>(inputSI[x])];
     }
+    std::fill(outputSI + end, outputSI + length, 0u);
 
     inputIt.NextSpan();
     outputIt.NextSpan();
@@ -474,6 +453,98 @@ void vtkApplyLookupTableOnScalarsCTF(vtkMitkLevelWindowFilter *self,
   }
 }
 
+// Internal method which should never be used anywhere else and should not be in th header.
+//----------------------------------------------------------------------------
+// Fills a color table with the RGBA pixels of all values of the 8/16 bit type T.
+template <class T, class MappingType>
+void BuildValueColorTable(const MappingType &mapping, std::vector<unsigned int> &colorTable, int &offset)
+{
+  const int minimum = std::numeric_limits<T>::min();
+  const int maximum = std::numeric_limits<T>::max();
+
+  colorTable.resize(maximum - minimum + 1);
+  offset = -minimum;
+
+  for (int value = minimum; value <= maximum; ++value)
+  {
+    colorTable[value - minimum] = mapping(static_cast<T>(value));
+  }
+}
+
+template <class T>
+void BuildValueColorTable(vtkScalarsToColors *lookupTable,
+                          vtkPiecewiseFunction *opacityFunction,
+                          std::vector<unsigned int> &colorTable,
+                          int &offset)
+{
+  auto *vlt = dynamic_cast<vtkLookupTable *>(lookupTable);
+  auto *ctf = dynamic_cast<vtkColorTransferFunction *>(lookupTable);
+
+  if (ctf)
+  {
+    BuildValueColorTable<T>(
+      [ctf, opacityFunction](T value) {
+        return MapColorTransferFunction(ctf, opacityFunction, static_cast<double>(value));
+      },
+      colorTable,
+      offset);
+  }
+  else if (vlt && vlt->GetScale() == VTK_SCALE_LINEAR)
+  {
+    BuildValueColorTable<T>(LinearLookupTableMapping(vlt), colorTable, offset);
+  }
+  else
+  {
+    BuildValueColorTable<T>(
+      [lookupTable](T value) {
+        // copy the 4 (RGBA) chars as a single int
+        unsigned int result;
+        std::memcpy(&result, lookupTable->MapValue(static_cast<double>(value)), sizeof(result));
+        return result;
+      },
+      colorTable,
+      offset);
+  }
+}
+
+// Internal method which should never be used anywhere else and should not be in th header.
+// Maps values within the range of a quantized color table to the nearest table entry and
+// all other values directly with the color transfer function.
+class QuantizedColorTableMapping
+{
+public:
+  QuantizedColorTableMapping(const std::vector<unsigned int> &colorTable,
+                             const double range[2],
+                             vtkColorTransferFunction *lookupTable,
+                             vtkPiecewiseFunction *opacityFunction)
+    : m_Table(colorTable.data()),
+      m_Minimum(range[0]),
+      m_Maximum(range[1]),
+      m_Scale((colorTable.size() - 1) / (range[1] - range[0])),
+      m_LookupTable(lookupTable),
+      m_OpacityFunction(opacityFunction)
+  {
+  }
+
+  template <class T>
+  unsigned int operator()(T value) const
+  {
+    const auto grayValue = static_cast<double>(value);
+    if (grayValue >= m_Minimum && grayValue <= m_Maximum)
+      return m_Table[static_cast<int>((grayValue - m_Minimum) * m_Scale + 0.5)];
+
+    return MapColorTransferFunction(m_LookupTable, m_OpacityFunction, grayValue);
+  }
+
+private:
+  const unsigned int *m_Table;
+  double m_Minimum;
+  double m_Maximum;
+  double m_Scale;
+  vtkColorTransferFunction *m_LookupTable;
+  vtkPiecewiseFunction *m_OpacityFunction;
+};
+
 int vtkMitkLevelWindowFilter::RequestInformation(vtkInformation *request,
                                                  vtkInformationVector **inputVector,
                                                  vtkInformationVector *outputVector)
@@ -502,38 +573,81 @@ void vtkMitkLevelWindowFilter::ThreadedExecute(vtkImageData *inData, vtkImageDat
         return;
     }
   }
-  else
+  else if (m_ColorTableType == ValueColorTable && inData->GetScalarType() == m_ColorTableScalarType)
   {
-    bool dontClip = extent[2] >= m_ClippingBounds[2] && extent[3] <= m_ClippingBounds[3] &&
-                    extent[0] >= m_ClippingBounds[0] && extent[1] <= m_ClippingBounds[1];
-
-    if (this->GetLookupTable())
-      this->GetLookupTable()->Build();
+    const unsigned int *colorTable = m_ColorTable.data() + m_ColorTableOffset;
 
+    switch (inData->GetScalarType())
+    {
+      case VTK_CHAR:
+        vtkApplyColorTableOnScalars(
+          colorTable, inData, outData, extent, m_ClippingBounds, static_cast<char *>(nullptr));
+        break;
+      case VTK_SIGNED_CHAR:
+        vtkApplyColorTableOnScalars(
+          colorTable, inData, outData, extent, m_ClippingBounds, static_cast<signed char *>(nullptr));
+        break;
+      case VTK_UNSIGNED_CHAR:
+        vtkApplyColorTableOnScalars(
+          colorTable, inData, outData, extent, m_ClippingBounds, static_cast<unsigned char *>(nullptr));
+        break;
+      case VTK_SHORT:
+        vtkApplyColorTableOnScalars(
+          colorTable, inData, outData, extent, m_ClippingBounds, static_cast<short *>(nullptr));
+        break;
+      case VTK_UNSIGNED_SHORT:
+        vtkApplyColorTableOnScalars(
+          colorTable, inData, outData, extent, m_ClippingBounds, static_cast<unsigned short *>(nullptr));
+        break;
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return;
+    }
+  }
+  else
+  {
     auto *vlt = dynamic_cast<vtkLookupTable *>(this->GetLookupTable());
     auto *ctf = dynamic_cast<vtkColorTransferFunction *>(this->GetLookupTable());
 
     bool linearLookupTable = vlt && vlt->GetScale() == VTK_SCALE_LINEAR;
 
-    bool useFast = dontClip && linearLookupTable;
+    if (ctf && m_ColorTableType == QuantizedColorTable)
+    {
+      const QuantizedColorTableMapping mapping(m_ColorTable, m_ColorTableRange, ctf, m_OpacityFunction);
 
-    if (ctf)
+      switch (inData->GetScalarType())
+      {
+        vtkTemplateMacro(vtkApplyMappingOnScalars(
+          mapping, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
+        default:
+          vtkErrorMacro(<< "Execute: Unknown ScalarType");
+          return;
+      }
+    }
+    else if (ctf)
     {
+      vtkPiecewiseFunction *opacityFunction = m_OpacityFunction;
+      auto mapping = [ctf, opacityFunction](double grayValue) {
+        return MapColorTransferFunction(ctf, opacityFunction, grayValue);
+      };
+
       switch (inData->GetScalarType())
       {
-        vtkTemplateMacro(vtkApplyLookupTableOnScalarsCTF(
-          this, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
+        vtkTemplateMacro(vtkApplyMappingOnScalars(
+          mapping, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
         default:
           vtkErrorMacro(<< "Execute: Unknown ScalarType");
           return;
       }
     }
-    else if (useFast)
+    else if (linearLookupTable)
     {
+      const LinearLookupTableMapping mapping(vlt);
+
       switch (inData->GetScalarType())
       {
-        vtkTemplateMacro(
-          vtkApplyLookupTableOnScalarsFast(this, inData, outData, extent, static_cast<VTK_TT *>(nullptr)));
+        vtkTemplateMacro(vtkApplyMappingOnScalars(
+          mapping, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
         default:
           vtkErrorMacro(<< "Execute: Unknown ScalarType");
           return;
@@ -541,10 +655,18 @@ void vtkMitkLevelWindowFilter::ThreadedExecute(vtkImageData *inData, vtkImageDat
     }
     else
     {
+      vtkScalarsToColors *lookupTable = this->GetLookupTable();
+      auto mapping = [lookupTable](double grayValue) {
+        // applying lookuptable - copy the 4 (RGBA) chars as a single int
+        unsigned int result;
+        std::memcpy(&result, lookupTable->MapValue(grayValue), sizeof(result));
+        return result;
+      };
+
       switch (inData->GetScalarType())
       {
-        vtkTemplateMacro(vtkApplyLookupTableOnScalars(
-          this, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
+        vtkTemplateMacro(vtkApplyMappingOnScalars(
+          mapping, inData, outData, extent, m_ClippingBounds, static_cast<VTK_TT *>(nullptr)));
         default:
           vtkErrorMacro(<< "Execute: Unknown ScalarType");
           return;
@@ -553,6 +675,95 @@ void vtkMitkLevelWindowFilter::ThreadedExecute(vtkImageData *inData, vtkImageDat
   }
 }
 
+int vtkMitkLevelWindowFilter::RequestData(vtkInformation *request,
+                                          vtkInformationVector **inputVector,
+                                          vtkInformationVector *outputVector)
+{
+  vtkImageData *input = vtkImageData::GetData(inputVector[0]);
+
+  if (input != nullptr && input->GetNumberOfScalarComponents() <= 2 && this->GetLookupTable() != nullptr)
+  {
+    // build once, all threads only read the tables
+    this->GetLookupTable()->Build();
+    this->UpdateColorTable(input->GetScalarType());
+  }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+void vtkMitkLevelWindowFilter::UpdateColorTable(int scalarType)
+{
+  vtkMTimeType lookupTableTime = m_LookupTable->GetMTime();
+  vtkMTimeType opacityFunctionTime = m_OpacityFunction != nullptr ? m_OpacityFunction->GetMTime() : 0;
+
+  if (m_ColorTableType != NoColorTable && scalarType == m_ColorTableScalarType &&
+      m_LookupTable == m_ColorTableLookupTable && lookupTableTime == m_ColorTableLookupTableTime &&
+      m_OpacityFunction == m_ColorTableOpacityFunction && opacityFunctionTime == m_ColorTableOpacityFunctionTime)
+  {
+    return;
+  }
+
+  m_ColorTableScalarType = scalarType;
+  m_ColorTableLookupTable = m_LookupTable;
+  m_ColorTableLookupTableTime = lookupTableTime;
+  m_ColorTableOpacityFunction = m_OpacityFunction;
+  m_ColorTableOpacityFunctionTime = opacityFunctionTime;
+
+  m_ColorTableType = ValueColorTable;
+  switch (scalarType)
+  {
+    case VTK_CHAR:
+      BuildValueColorTable<char>(m_LookupTable, m_OpacityFunction, m_ColorTable, m_ColorTableOffset);
+      return;
+    case VTK_SIGNED_CHAR:
+      BuildValueColorTable<signed char>(m_LookupTable, m_OpacityFunction, m_ColorTable, m_ColorTableOffset);
+      return;
+    case VTK_UNSIGNED_CHAR:
+      BuildValueColorTable<unsigned char>(m_LookupTable, m_OpacityFunction, m_ColorTable, m_ColorTableOffset);
+      return;
+    case VTK_SHORT:
+      BuildValueColorTable<short>(m_LookupTable, m_OpacityFunction, m_ColorTable, m_ColorTableOffset);
+      return;
+    case VTK_UNSIGNED_SHORT:
+      BuildValueColorTable<unsigned short>(m_LookupTable, m_OpacityFunction, m_ColorTable, m_ColorTableOffset);
+      return;
+    default:
+      break;
+  }
+
+  m_ColorTableType = NoColorTable;
+  m_ColorTable.clear();
+
+  // vtkLookupTables with linear scale are already indexed directly, other vtkLookupTables are mapped exactly
+  auto *ctf = dynamic_cast<vtkColorTransferFunction *>(m_LookupTable);
+  if (ctf == nullptr)
+    return;
+
+  // sample the color transfer function over the range of its nodes and of the opacity function
+  const double *range = ctf->GetRange();
+  m_ColorTableRange[0] = range[0];
+  m_ColorTableRange[1] = range[1];
+  if (m_OpacityFunction != nullptr && m_OpacityFunction->GetSize() > 0)
+  {
+    const double *opacityRange = m_OpacityFunction->GetRange();
+    m_ColorTableRange[0] = std::min(m_ColorTableRange[0], opacityRange[0]);
+    m_ColorTableRange[1] = std::max(m_ColorTableRange[1], opacityRange[1]);
+  }
+
+  if (!(m_ColorTableRange[1] > m_ColorTableRange[0]))
+    return;
+
+  const unsigned int size = 1 << 14;
+  const double step = (m_ColorTableRange[1] - m_ColorTableRange[0]) / (size - 1);
+
+  m_ColorTable.resize(size);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    m_ColorTable[i] = MapColorTransferFunction(ctf, m_OpacityFunction, m_ColorTableRange[0] + i * step);
+  }
+  m_ColorTableType = QuantizedColorTable;
+}
+
 // void vtkMitkLevelWindowFilter::ExecuteInformation(
 //    vtkImageData *vtkNotUsed(inData), vtkImageData *vtkNotUsed(outData))
 //{
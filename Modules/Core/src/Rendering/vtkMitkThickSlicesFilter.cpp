@@ -20,8 +20,10 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
@@ -165,175 +167,122 @@ r[2] = -0.5 / r[2];
 
   double invNum = 1.0 / (_maxZ - _minZ + 1);
 
-  switch (self->GetThickSliceMode())
+  // The slices are reduced row by row: for every row, the rows of all slices are combined into one row buffer.
+  // So the inner loop runs over contiguous pixels instead of striding through the slab along z.
+  const int rowLength = maxX + 1;
+  const vtkIdType sliceIncrement = inIncs[2];
+  const int mode = self->GetThickSliceMode();
+
+  std::vector<double> weights;
+  if (mode == vtkMitkThickSlicesFilter::WEIGHTED)
   {
-    default:
-    case vtkMitkThickSlicesFilter::MIP:
+    const int size = _maxZ - _minZ;
+    weights.resize(size);
+    double mean = 0.5 * double(_minZ + _maxZ);
+    double sigma_sq = double(size) / 6.0;
+    sigma_sq *= sigma_sq;
+    double sum = 0;
+    int i = 0;
+    for (int z = _minZ + 1; z <= _maxZ; z++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value > mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      double val = exp(-(((double)z - mean) / sigma_sq));
+      weights[i++] = val;
+      sum += val;
     }
-    break;
-
-    case vtkMitkThickSlicesFilter::SUM:
+    for (i = 0; i < size; i++)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          double sum = 0;
-
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          // do X axis
-          *outPtr = static_cast<T>(invNum * sum);
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      weights[i] /= sum;
     }
-    break;
+  }
+
+  std::vector<double> rowSum(rowLength);
+  std::vector<long double> rowLongSum(rowLength);
 
-    case vtkMitkThickSlicesFilter::WEIGHTED:
+  for (idxY = 0; idxY <= maxY; idxY++)
+  {
+    switch (mode)
     {
-      const int size = _maxZ - _minZ;
-      std::vector<double> weights(size);
-      double mean = 0.5 * double(_minZ + _maxZ);
-      double sigma_sq = double(size) / 6.0;
-      sigma_sq *= sigma_sq;
-      double sum = 0;
-      int i = 0;
-      for (int z = _minZ + 1; z <= _maxZ; z++)
+      default:
+      case vtkMitkThickSlicesFilter::MIP:
+      case vtkMitkThickSlicesFilter::MINIP:
       {
-        double val = exp(-(((double)z - mean) / sigma_sq));
-        weights[i++] = val;
-        sum += val;
-      }
-      for (i = 0; i < size; i++)
-      {
-        weights[i] /= sum;
-      }
+        const bool maximum = mode != vtkMitkThickSlicesFilter::MINIP;
+        std::copy(inPtr + _minZ * sliceIncrement, inPtr + _minZ * sliceIncrement + rowLength, outPtr);
 
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
+        for (int z = _minZ + 1; z <= _maxZ; z++)
         {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-          i = 0;
-          double mymip = 0;
-          for (int z = _minZ + 1; z <= _maxZ; z++)
+          const T *slice = inPtr + z * sliceIncrement;
+          if (maximum)
+          {
+            for (idxX = 0; idxX < rowLength; idxX++)
+              if (slice[idxX] > outPtr[idxX])
+                outPtr[idxX] = slice[idxX];
+          }
+          else
           {
-            double value = inPtr[z * inIncs[2]];
-            mymip += value * weights[i++];
+            for (idxX = 0; idxX < rowLength; idxX++)
+              if (slice[idxX] < outPtr[idxX])
+                outPtr[idxX] = slice[idxX];
           }
-          mip = static_cast<T>(mymip);
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
       }
-    }
-    break;
+      break;
 
-    case vtkMitkThickSlicesFilter::MINIP:
-    {
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::SUM:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
+        std::fill(rowSum.begin(), rowSum.end(), 0.0);
+        for (int z = _minZ; z <= _maxZ; z++)
         {
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value < mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+          const T *slice = inPtr + z * sliceIncrement;
+          for (idxX = 0; idxX < rowLength; idxX++)
+            rowSum[idxX] += slice[idxX];
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
 
-    case vtkMitkThickSlicesFilter::MEAN:
-    {
-      const int size = _maxZ - _minZ;
+        for (idxX = 0; idxX < rowLength; idxX++)
+          outPtr[idxX] = static_cast<T>(invNum * rowSum[idxX]);
+      }
+      break;
 
-      // MEAN
-      for (idxY = 0; idxY <= maxY; idxY++)
+      case vtkMitkThickSlicesFilter::WEIGHTED:
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
+        std::fill(rowSum.begin(), rowSum.end(), 0.0);
+        int i = 0;
+        for (int z = _minZ + 1; z <= _maxZ; z++)
         {
-          long double sum = 0;
-          for (int z = _minZ; z <= _maxZ; z++)
+          const T *slice = inPtr + z * sliceIncrement;
+          const double weight = weights[i++];
+          for (idxX = 0; idxX < rowLength; idxX++)
           {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
+            double value = slice[idxX];
+            rowSum[idxX] += value * weight;
           }
+        }
 
-          T mip = static_cast<T>(sum / size);
+        for (idxX = 0; idxX < rowLength; idxX++)
+          outPtr[idxX] = static_cast<T>(rowSum[idxX]);
+      }
+      break;
+
+      case vtkMitkThickSlicesFilter::MEAN:
+      {
+        const int size = _maxZ - _minZ;
 
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+        std::fill(rowLongSum.begin(), rowLongSum.end(), 0.0L);
+        for (int z = _minZ; z <= _maxZ; z++)
+        {
+          const T *slice = inPtr + z * sliceIncrement;
+          for (idxX = 0; idxX < rowLength; idxX++)
+            rowLongSum[idxX] += slice[idxX];
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
+
+        for (idxX = 0; idxX < rowLength; idxX++)
+          outPtr[idxX] = static_cast<T>(rowLongSum[idxX] / size);
       }
+      break;
     }
-    break;
+
+    outPtr += rowLength + outIncY;
+    inPtr += rowLength + inIncY;
   }
 }
 
@@ -31,9 +31,14 @@ found in the LICENSE file.
 #include <mitkImageCast.h>
 #include <mitkInteractionConst.h>
 #include <mitkMatrixConvert.h>
+#include <mitkParallelFor.h>
 #include <mitkRotationOperation.h>
 #include <mitkScaleOperation.h>
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 class vtkMatrix4x4;
 class vtkMatrixToLinearTransform;
 class vtkLinearTransform;
@@ -110,6 +115,8 @@ class mitkBaseGeometryTestSuite : public mitk::TestFixture
   MITK_TEST(TestComposeVtkMatrix);
   MITK_TEST(TestTranslate);
   MITK_TEST(TestIndexToWorld);
+  MITK_TEST(TestTransformSnapshot);
+  MITK_TEST(TestTransformSnapshotConcurrently);
   MITK_TEST(TestExecuteOperation);
   MITK_TEST(TestCalculateBoundingBoxRelToTransform);
   // MITK_TEST(TestSetTimeBounds);
@@ -899,6 +906,95 @@ public:
     testIndexAndWorldConsistencyForIndex(dummy);
   }
 
+  void TestTransformSnapshot()
+  {
+    DummyTestClass::Pointer dummy = DummyTestClass::New();
+    dummy->SetIndexToWorldTransform(anotherTransform);
+    dummy->SetOrigin(anotherPoint);
+    dummy->SetSpacing(anotherSpacing);
+
+    mitk::GeometryTransformSnapshot::ConstPointer snapshot = dummy->GetTransformSnapshot();
+    CPPUNIT_ASSERT_MESSAGE("Snapshot is cached", snapshot == dummy->GetTransformSnapshot());
+    CPPUNIT_ASSERT(snapshot->IsInvertible());
+
+    std::vector<mitk::Point3D> points(5);
+    std::vector<mitk::ScalarType> xyz(3 * points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      mitk::FillVector3D(points[i], 1.5 * i - 2, 0.25 * i * i, 7 - 3.0 * i);
+      std::copy_n(points[i].GetDataPointer(), 3, xyz.begin() + 3 * i);
+    }
+
+    std::vector<mitk::Point3D> indices(points.size());
+    snapshot->WorldToIndex(points.data(), indices.data(), points.size());
+    snapshot->WorldToIndex(xyz.data(), xyz.data(), points.size());
+
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      mitk::Point3D index, world;
+      dummy->WorldToIndex(points[i], index);
+      CPPUNIT_ASSERT(mitk::EqualArray(index, indices[i], 3, mitk::eps, true));
+      CPPUNIT_ASSERT(mitk::EqualArray(index, &xyz[3 * i], 3, mitk::eps, true));
+
+      dummy->IndexToWorld(index, world);
+      snapshot->IndexToWorld(index, index);
+      CPPUNIT_ASSERT(mitk::EqualArray(world, index, 3, mitk::eps, true));
+    }
+
+    snapshot->IndexToWorld(xyz.data(), xyz.data(), points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      CPPUNIT_ASSERT(mitk::EqualArray(points[i], &xyz[3 * i], 3, mitk::eps, true));
+    }
+
+    // snapshots do not change with the geometry
+    const mitk::Point3D oldOrigin = dummy->GetOrigin();
+    dummy->SetOrigin(aPoint);
+    mitk::Point3D world;
+    mitk::FillVector3D(world, 0, 0, 0);
+    snapshot->IndexToWorld(world, world);
+    CPPUNIT_ASSERT(mitk::Equal(world, oldOrigin));
+    CPPUNIT_ASSERT_MESSAGE("Snapshot is updated", snapshot != dummy->GetTransformSnapshot());
+    CPPUNIT_ASSERT(mitk::Equal(dummy->GetTransformSnapshot()->GetOffset(), aPoint.GetVectorFromOrigin()));
+  }
+
+  void TestTransformSnapshotConcurrently()
+  {
+    DummyTestClass::Pointer dummy = DummyTestClass::New();
+    dummy->SetIndexToWorldTransform(anotherTransform);
+    dummy->SetOrigin(aPoint);
+
+    std::vector<mitk::Point3D> points(1000);
+    std::vector<mitk::Point3D> expectedIndices(points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      mitk::FillVector3D(points[i], 0.5 * i, 3.0 - i, 0.01 * i * i);
+      dummy->WorldToIndex(points[i], expectedIndices[i]);
+    }
+
+    // modify the transform without changing it, so all threads start with an outdated snapshot
+    dummy->SetOrigin(anotherPoint);
+    dummy->SetOrigin(aPoint);
+
+    std::vector<mitk::GeometryTransformSnapshot::ConstPointer> snapshots(points.size());
+    std::atomic<unsigned int> numberOfWrongIndices(0);
+
+    mitk::ParallelFor(points.size(), 0, [&](std::size_t i) {
+      snapshots[i] = dummy->GetTransformSnapshot();
+
+      mitk::Point3D index;
+      dummy->WorldToIndex(points[i], index);
+      if (!mitk::Equal(index, expectedIndices[i]))
+        ++numberOfWrongIndices;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(0u, numberOfWrongIndices.load());
+    CPPUNIT_ASSERT(std::all_of(snapshots.begin(), snapshots.end(), [&](const auto &snapshot) {
+      return snapshot == snapshots.front();
+    }));
+    CPPUNIT_ASSERT_MESSAGE("Snapshot is rebuilt once", snapshots.front() == dummy->GetTransformSnapshot());
+  }
+
   void TestExecuteOperation()
   {
     DummyTestClass::Pointer dummy = DummyTestClass::New();
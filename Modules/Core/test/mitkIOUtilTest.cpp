@@ -16,6 +16,7 @@ found in the LICENSE file.
 
 #include <mitkIOUtil.h>
 #include <mitkImageGenerator.h>
+#include <mitkStandaloneDataStorage.h>
 
 #include <itksys/SystemTools.hxx>
 
@@ -29,6 +30,7 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestNullSave);
   MITK_TEST(TestLoadAndSavePointSet);
   MITK_TEST(TestLoadAndSaveSurface);
+  MITK_TEST(TestConcurrentLoad);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   CPPUNIT_TEST_SUITE_END();
@@ -226,6 +228,41 @@ public:
     // delete the files after the test is done
     std::remove(surfacePath.c_str());
   }
+
+  void TestConcurrentLoad()
+  {
+    std::vector<std::string> paths;
+    paths.push_back(m_ImagePath);
+    paths.push_back(m_SurfacePath);
+    paths.push_back(m_PointSetPath);
+    paths.push_back(m_ImagePath);
+
+    mitk::StandaloneDataStorage::Pointer storage = mitk::StandaloneDataStorage::New();
+    mitk::DataStorage::SetOfObjects::Pointer nodes = mitk::IOUtil::Load(paths, *storage, 4, nullptr);
+
+    // the nodes are returned in the order of the paths
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(storage->GetAll()->Size()));
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image *>(nodes->GetElement(0)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Surface *>(nodes->GetElement(1)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::PointSet *>(nodes->GetElement(2)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image *>(nodes->GetElement(3)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(nodes->GetElement(0)->GetData() != nodes->GetElement(3)->GetData());
+
+    std::vector<mitk::BaseData::Pointer> data = mitk::IOUtil::Load(paths, 0, nullptr);
+    CPPUNIT_ASSERT_EQUAL(paths.size(), data.size());
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(std::string(nodes->GetElement(i)->GetData()->GetNameOfClass()),
+                           std::string(data[i]->GetNameOfClass()));
+    }
+
+    // the other files are loaded if one file cannot be loaded
+    paths.insert(paths.begin() + 1, "fileWhichDoesNotExist.nrrd");
+    storage = mitk::StandaloneDataStorage::New();
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Load(paths, *storage, 4, nullptr), mitk::Exception);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), static_cast<std::size_t>(storage->GetAll()->Size()));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkIOUtil)
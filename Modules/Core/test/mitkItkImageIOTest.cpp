@@ -15,13 +15,21 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include "mitkIOConstants.h"
 #include "mitkIOUtil.h"
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
+#include <mitkCoreServices.h>
+#include <mitkIPropertyPersistence.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkPropertyPersistenceInfo.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkImageIOFactory.h>
 #include <itkImageRegionIterator.h>
+#include <itkMetaDataObject.h>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -43,6 +51,12 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestReadTimeStepRange);
+  MITK_TEST(TestReadSingleTimeStep);
+  MITK_TEST(TestReadTimeStepsOnDemand);
+  MITK_TEST(TestReadRegion);
+  MITK_TEST(TestParallelNrrdCompression);
+  MITK_TEST(TestParallelNrrdCompressionKeepsNrrdFields);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -67,6 +81,224 @@ public:
     // TODO
   }
 
+  void TestReadTimeStepRange()
+  {
+    const std::string path = GetTestDataFilePath("3D+t-ITKIO-TestData/LinearModel_4D_arbitrary_time_geometry.nrrd");
+    mitk::Image::Pointer reference = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT_MESSAGE("Test image has enough time steps", reference->GetDimension(3) > 2);
+
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(path, 1, 2);
+    CPPUNIT_ASSERT_EQUAL(2u, image->GetDimension(3));
+    CPPUNIT_ASSERT_EQUAL(reference->GetDimension(0), image->GetDimension(0));
+
+    for (unsigned int t = 0; t < 2; ++t)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Volume data equals the data of the corresponding time step",
+                             CompareVolumes(image, t, reference, t + 1));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(reference->GetTimeGeometry()->TimeStepToTimePoint(t + 1),
+                                   image->GetTimeGeometry()->TimeStepToTimePoint(t),
+                                   mitk::eps);
+    }
+
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Load(path, reference->GetDimension(3), 0), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Load(path, 1, reference->GetDimension(3)), mitk::Exception);
+  }
+
+  void TestReadSingleTimeStep()
+  {
+    const std::string path = GetTestDataFilePath("3D+t-ITKIO-TestData/LinearModel_4D_prop_time_geometry.nrrd");
+    mitk::Image::Pointer reference = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT_MESSAGE("Test image has enough time steps", reference->GetDimension(3) > 2);
+
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(path, 2, 1);
+    CPPUNIT_ASSERT_EQUAL(1u, image->GetTimeSteps());
+    CPPUNIT_ASSERT_MESSAGE("Volume data equals the data of the time step", CompareVolumes(image, 0, reference, 2));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference->GetTimeGeometry()->TimeStepToTimePoint(2),
+                                 image->GetTimeGeometry()->TimeStepToTimePoint(0),
+                                 mitk::eps);
+  }
+
+  void TestReadTimeStepsOnDemand()
+  {
+    mitk::Image::Pointer reference =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("3D+t-ITKIO-TestData/LinearModel_4D_prop_time_geometry.nrrd"));
+
+    // MetaImage files can be streamed, so the time steps are read when they are accessed
+    std::ofstream tmpStream;
+    std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, "XXXXXX.mhd");
+    tmpStream.close();
+    std::string tmpFilePathWithoutExt = tmpFilePath.substr(0, tmpFilePath.size() - 4);
+    mitk::IOUtil::Save(reference, tmpFilePath);
+
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(tmpFilePath, 0, 0, true);
+    CPPUNIT_ASSERT_EQUAL(reference->GetDimension(3), image->GetDimension(3));
+
+    for (unsigned int t = image->GetDimension(3); t > 0; --t)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Time step loaded on demand equals the reference",
+                             CompareVolumes(image, t - 1, reference, t - 1));
+    }
+
+    std::remove(tmpFilePath.c_str());
+    std::remove((tmpFilePathWithoutExt + ".raw").c_str());
+    std::remove((tmpFilePathWithoutExt + ".zraw").c_str());
+  }
+
+  void TestReadRegion()
+  {
+    const std::string path = GetTestDataFilePath("Pic3D.nrrd");
+    mitk::Image::Pointer reference = mitk::IOUtil::Load<mitk::Image>(path);
+
+    mitk::IFileReader::Options options;
+    options[mitk::IOConstants::REGION()] = std::string("10 20 5 30 40 3");
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(path, options);
+
+    CPPUNIT_ASSERT_EQUAL(30u, image->GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(40u, image->GetDimension(1));
+    CPPUNIT_ASSERT_EQUAL(3u, image->GetDimension(2));
+
+    mitk::Point3D origin;
+    mitk::Point3D index;
+    index[0] = 10;
+    index[1] = 20;
+    index[2] = 5;
+    reference->GetGeometry()->IndexToWorld(index, origin);
+    CPPUNIT_ASSERT_MESSAGE("Origin is moved to the start of the region",
+                           mitk::Equal(origin, image->GetGeometry()->GetOrigin(), mitk::eps, true));
+
+    const std::size_t pixelSize = reference->GetPixelType().GetSize();
+    mitk::ImageReadAccessor referenceAccessor(reference);
+    mitk::ImageReadAccessor imageAccessor(image);
+    const char *referenceData = static_cast<const char *>(referenceAccessor.GetData());
+    const char *imageData = static_cast<const char *>(imageAccessor.GetData());
+
+    for (unsigned int z = 0; z < 3; ++z)
+    {
+      for (unsigned int y = 0; y < 40; ++y)
+      {
+        const std::size_t referenceOffset =
+          (((z + 5) * reference->GetDimension(1) + y + 20) * reference->GetDimension(0) + 10) * pixelSize;
+        const std::size_t imageOffset = ((z * 40 + y) * 30) * pixelSize;
+        CPPUNIT_ASSERT(std::memcmp(referenceData + referenceOffset, imageData + imageOffset, 30 * pixelSize) == 0);
+      }
+    }
+
+    options[mitk::IOConstants::REGION()] = std::string("10 20 5 300 40 3");
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Load(path, options), mitk::Exception);
+  }
+
+  void TestParallelNrrdCompression()
+  {
+    mitk::Image::Pointer reference = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+
+    std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile("ParallelCompressionXXXXXX.nrrd");
+
+    mitk::IFileWriter::Options options;
+    options[mitk::IOConstants::NUMBER_OF_THREADS()] = 4;
+    options[mitk::IOConstants::COMPRESSION_LEVEL()] = 1;
+    mitk::IOUtil::Save(reference, tmpFilePath, options);
+
+    // read with multiple threads
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    CPPUNIT_ASSERT_MESSAGE("Image written with multiple threads equals the original image",
+                           mitk::Equal(*reference, *image, mitk::eps, true));
+    CPPUNIT_ASSERT_MESSAGE("Chunk index is not exposed as property",
+                           image->GetProperty("org.mitk.io.gzip.chunks").IsNull());
+
+    // the file remains readable by the plain ITK NRRD reader
+    itk::ImageIOBase::Pointer imageIO =
+      itk::ImageIOFactory::CreateImageIO(tmpFilePath.c_str(), itk::ImageIOFactory::ReadMode);
+    CPPUNIT_ASSERT(imageIO.IsNotNull());
+    imageIO->SetFileName(tmpFilePath);
+    imageIO->ReadImageInformation();
+
+    mitk::ImageReadAccessor referenceAccessor(reference);
+    const std::size_t size = imageIO->GetImageSizeInBytes();
+    CPPUNIT_ASSERT_EQUAL(reference->GetPixelType().GetSize() * reference->GetDimension(0) *
+                           reference->GetDimension(1) * reference->GetDimension(2),
+                         size);
+
+    std::vector<char> buffer(size);
+    imageIO->Read(buffer.data());
+    CPPUNIT_ASSERT_MESSAGE("Image read by ITK equals the original image",
+                           std::memcmp(buffer.data(), referenceAccessor.GetData(), size) == 0);
+
+    // a stale chunk index, e.g. after another tool rewrote the data, falls back to the NRRD reader
+    {
+      std::fstream file(tmpFilePath.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+      std::string header(4096, '\0');
+      file.read(&header[0], header.size());
+      const std::size_t keyPosition = header.find("org_mitk_io_gzip_chunks:=");
+      CPPUNIT_ASSERT(keyPosition != std::string::npos);
+
+      // the chunk size is followed by the compressed size of the first chunk
+      file.clear();
+      file.seekp(header.find(' ', keyPosition) + 1);
+      file.put('f');
+    }
+
+    image = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    CPPUNIT_ASSERT_MESSAGE("Image with a stale chunk index equals the original image",
+                           mitk::Equal(*reference, *image, mitk::eps, true));
+
+    // uncompressed files
+    options[mitk::IOConstants::COMPRESSION()] = mitk::IOConstants::COMPRESSION_NONE();
+    mitk::IOUtil::Save(reference, tmpFilePath, options);
+    image = mitk::IOUtil::Load<mitk::Image>(tmpFilePath);
+    CPPUNIT_ASSERT_MESSAGE("Uncompressed image equals the original image",
+                           mitk::Equal(*reference, *image, mitk::eps, true));
+
+    std::remove(tmpFilePath.c_str());
+  }
+
+  void TestParallelNrrdCompressionKeepsNrrdFields()
+  {
+    mitk::Image::Pointer image = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+
+    mitk::CoreServicePointer<mitk::IPropertyPersistence> persistence(mitk::CoreServices::GetPropertyPersistence());
+    for (const std::string field : {"content", "labels[1]"})
+    {
+      auto info = mitk::PropertyPersistenceInfo::New();
+      info->SetNameAndKey("NRRD." + field, "NRRD_" + field);
+      persistence->AddInfo(info);
+    }
+
+    image->SetStringProperty("NRRD.content", "parallel compression test");
+    image->SetStringProperty("NRRD.labels[1]", "y axis");
+
+    std::string tmpFilePath = mitk::IOUtil::CreateTemporaryFile("ParallelCompressionXXXXXX.nrrd");
+
+    mitk::IFileWriter::Options options;
+    options[mitk::IOConstants::NUMBER_OF_THREADS()] = 4;
+    mitk::IOUtil::Save(image, tmpFilePath, options);
+
+    persistence->RemoveInfo("NRRD.content");
+    persistence->RemoveInfo("NRRD.labels[1]");
+
+    itk::ImageIOBase::Pointer imageIO =
+      itk::ImageIOFactory::CreateImageIO(tmpFilePath.c_str(), itk::ImageIOFactory::ReadMode);
+    CPPUNIT_ASSERT(imageIO.IsNotNull());
+    imageIO->SetFileName(tmpFilePath);
+    imageIO->ReadImageInformation();
+
+    std::string value;
+    CPPUNIT_ASSERT(itk::ExposeMetaData<std::string>(imageIO->GetMetaDataDictionary(), "NRRD_content", value));
+    CPPUNIT_ASSERT_EQUAL(std::string("parallel compression test"), value);
+    CPPUNIT_ASSERT(itk::ExposeMetaData<std::string>(imageIO->GetMetaDataDictionary(), "NRRD_labels[1]", value));
+    CPPUNIT_ASSERT_EQUAL(std::string("y axis"), value);
+
+    std::remove(tmpFilePath.c_str());
+  }
+
+  bool CompareVolumes(mitk::Image *image, unsigned int t, mitk::Image *reference, unsigned int referenceT)
+  {
+    mitk::ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    mitk::ImageReadAccessor referenceAccessor(reference, reference->GetVolumeData(referenceT));
+    const std::size_t size = reference->GetPixelType().GetSize() * reference->GetDimension(0) *
+                             reference->GetDimension(1) * reference->GetDimension(2);
+    return std::memcmp(accessor.GetData(), referenceAccessor.GetData(), size) == 0;
+  }
+
   std::string AppendExtension(const std::string &filename, const char *extension)
   {
     std::string new_filename = filename;
@@ -0,0 +1,150 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkTestFixture.h>
+
+#include <mitkException.h>
+#include <mitkParallelCompression.h>
+
+#include <sstream>
+
+class mitkParallelCompressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelCompressionTestSuite);
+  MITK_TEST(TestRoundTrip);
+  MITK_TEST(TestEmptyData);
+  MITK_TEST(TestGzipStream);
+  MITK_TEST(TestCorruptedData);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::vector<unsigned char> m_Data;
+
+  std::vector<unsigned char> CreateData(std::size_t size)
+  {
+    // compressible, but not trivial content
+    std::vector<unsigned char> data(size);
+    unsigned int state = 12345;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      data[i] = (i / 64) % 3 == 0 ? static_cast<unsigned char>(state >> 24) : static_cast<unsigned char>(i % 17);
+    }
+    return data;
+  }
+
+  std::vector<unsigned char> RoundTrip(const std::vector<unsigned char> &data,
+                                       const mitk::ParallelCompression::Parameters &parameters,
+                                       unsigned int numberOfReadThreads)
+  {
+    std::stringstream stream;
+    std::vector<std::uint64_t> chunkSizes =
+      mitk::ParallelCompression::WriteGzip(stream, data.data(), data.size(), parameters);
+
+    CPPUNIT_ASSERT_EQUAL(mitk::ParallelCompression::GetNumberOfChunks(data.size(), parameters.ChunkSize),
+                         chunkSizes.size());
+
+    std::vector<unsigned char> result(data.size());
+    stream.seekg(0);
+    mitk::ParallelCompression::ReadGzip(
+      stream, chunkSizes, parameters.ChunkSize, result.data(), result.size(), numberOfReadThreads);
+
+    return result;
+  }
+
+public:
+  void setUp() override { m_Data = this->CreateData(1000003); }
+
+  void tearDown() override { m_Data.clear(); }
+
+  void TestRoundTrip()
+  {
+    mitk::ParallelCompression::Parameters parameters;
+    parameters.ChunkSize = 65536;
+
+    for (int level = 1; level <= 9; level += 4)
+    {
+      for (unsigned int threads = 1; threads <= 4; threads *= 2)
+      {
+        parameters.Level = level;
+        parameters.NumberOfThreads = threads;
+        CPPUNIT_ASSERT_MESSAGE("Data is restored", RoundTrip(m_Data, parameters, 5 - threads) == m_Data);
+      }
+    }
+
+    // a single chunk
+    parameters.ChunkSize = 2 * m_Data.size();
+    CPPUNIT_ASSERT_MESSAGE("Data of a single chunk is restored", RoundTrip(m_Data, parameters, 0) == m_Data);
+  }
+
+  void TestEmptyData()
+  {
+    std::vector<unsigned char> empty;
+    CPPUNIT_ASSERT(RoundTrip(empty, mitk::ParallelCompression::Parameters(), 0).empty());
+  }
+
+  void TestGzipStream()
+  {
+    mitk::ParallelCompression::Parameters parameters;
+    parameters.ChunkSize = 65536;
+
+    std::stringstream stream;
+    mitk::ParallelCompression::WriteGzip(stream, m_Data.data(), m_Data.size(), parameters);
+    const std::string compressed = stream.str();
+
+    // gzip magic number, deflate method and the uncompressed size (modulo 2^32) in the trailer
+    CPPUNIT_ASSERT(compressed.size() > 18);
+    CPPUNIT_ASSERT_EQUAL(0x1f, static_cast<int>(static_cast<unsigned char>(compressed[0])));
+    CPPUNIT_ASSERT_EQUAL(0x8b, static_cast<int>(static_cast<unsigned char>(compressed[1])));
+    CPPUNIT_ASSERT_EQUAL(8, static_cast<int>(compressed[2]));
+
+    std::size_t size = 0;
+    for (int i = 3; i >= 0; --i)
+      size = (size << 8) | static_cast<unsigned char>(compressed[compressed.size() - 4 + i]);
+    CPPUNIT_ASSERT_EQUAL(m_Data.size(), size);
+
+    CPPUNIT_ASSERT_MESSAGE("Data is compressed", compressed.size() < m_Data.size());
+  }
+
+  void TestCorruptedData()
+  {
+    mitk::ParallelCompression::Parameters parameters;
+    parameters.ChunkSize = 65536;
+
+    std::stringstream stream;
+    std::vector<std::uint64_t> chunkSizes =
+      mitk::ParallelCompression::WriteGzip(stream, m_Data.data(), m_Data.size(), parameters);
+
+    std::string compressed = stream.str();
+    compressed[compressed.size() / 2] ^= 0x55;
+
+    std::vector<unsigned char> result(m_Data.size());
+    std::istringstream corruptedStream(compressed);
+    CPPUNIT_ASSERT_THROW(mitk::ParallelCompression::ReadGzip(
+                           corruptedStream, chunkSizes, parameters.ChunkSize, result.data(), result.size()),
+                         mitk::Exception);
+
+    std::istringstream truncatedStream(stream.str().substr(0, compressed.size() / 2));
+    CPPUNIT_ASSERT_THROW(mitk::ParallelCompression::ReadGzip(
+                           truncatedStream, chunkSizes, parameters.ChunkSize, result.data(), result.size()),
+                         mitk::Exception);
+
+    chunkSizes.pop_back();
+    std::istringstream wrongChunksStream(stream.str());
+    CPPUNIT_ASSERT_THROW(mitk::ParallelCompression::ReadGzip(
+                           wrongChunksStream, chunkSizes, parameters.ChunkSize, result.data(), result.size()),
+                         mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelCompression)
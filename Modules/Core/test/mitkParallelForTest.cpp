@@ -0,0 +1,119 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkTestFixture.h>
+
+#include <mitkParallelFor.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+class mitkParallelForTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelForTestSuite);
+  MITK_TEST(TestAllIterationsRunOnce);
+  MITK_TEST(TestRanges);
+  MITK_TEST(TestNestedLoops);
+  MITK_TEST(TestException);
+  MITK_TEST(TestRunNextInOrder);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void TestAllIterationsRunOnce()
+  {
+    for (unsigned int numberOfThreads : {0u, 1u, 3u, 64u})
+    {
+      std::vector<std::atomic<int>> counts(1000);
+      for (auto &count : counts)
+        count = 0;
+
+      mitk::ParallelFor(counts.size(), numberOfThreads, [&counts](std::size_t i) { ++counts[i]; });
+
+      for (const auto &count : counts)
+        CPPUNIT_ASSERT_EQUAL(1, count.load());
+    }
+  }
+
+  void TestRanges()
+  {
+    for (unsigned int numberOfRanges : {0u, 1u, 3u, 64u})
+    {
+      std::vector<std::atomic<int>> counts(10);
+      for (auto &count : counts)
+        count = 0;
+
+      std::atomic<unsigned int> ranges(0);
+      mitk::ParallelForRanges(counts.size(), numberOfRanges, [&](std::size_t begin, std::size_t end) {
+        CPPUNIT_ASSERT(begin < end);
+        ++ranges;
+        for (std::size_t i = begin; i < end; ++i)
+          ++counts[i];
+      });
+
+      for (const auto &count : counts)
+        CPPUNIT_ASSERT_EQUAL(1, count.load());
+
+      CPPUNIT_ASSERT(ranges <= counts.size());
+      if (numberOfRanges != 0)
+        CPPUNIT_ASSERT_EQUAL(std::min<unsigned int>(numberOfRanges, counts.size()), ranges.load());
+    }
+  }
+
+  void TestNestedLoops()
+  {
+    // more outer iterations than worker threads, each of them waits for an inner loop
+    std::atomic<int> sum(0);
+    mitk::ParallelFor(64, 0, [&sum](std::size_t) {
+      mitk::ParallelFor(64, 0, [&sum](std::size_t j) { sum += static_cast<int>(j); });
+    });
+
+    CPPUNIT_ASSERT_EQUAL(64 * (63 * 64 / 2), sum.load());
+  }
+
+  void TestException()
+  {
+    std::atomic<int> count(0);
+    CPPUNIT_ASSERT_THROW(mitk::ParallelFor(1000,
+                                           4,
+                                           [&count](std::size_t i) {
+                                             ++count;
+                                             if (i == 10)
+                                               throw std::runtime_error("iteration failed");
+                                           }),
+                         std::runtime_error);
+
+    // the loop can be used again after an exception
+    count = 0;
+    mitk::ParallelFor(100, 4, [&count](std::size_t) { ++count; });
+    CPPUNIT_ASSERT_EQUAL(100, count.load());
+  }
+
+  void TestRunNextInOrder()
+  {
+    // with a single thread, the calling thread claims the iterations in increasing order
+    std::vector<std::size_t> order;
+    mitk::ParallelLoop loop(5, 1, [&order](std::size_t i) { order.push_back(i); });
+
+    CPPUNIT_ASSERT(loop.RunNext());
+    CPPUNIT_ASSERT(loop.RunNext());
+    loop.Wait();
+    CPPUNIT_ASSERT(!loop.RunNext());
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), order.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL(i, order[i]);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFor)
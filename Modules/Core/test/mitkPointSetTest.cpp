@@ -18,7 +18,10 @@ found in the LICENSE file.
 #include <mitkPointOperation.h>
 #include <mitkPointSet.h>
 
+#include <vtkPoints.h>
+
 #include <fstream>
+#include <vector>
 
 /**
  * TestSuite for PointSet stuff not only operating on an empty PointSet
@@ -41,6 +44,8 @@ class mitkPointSetTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemovePointInterface);
   MITK_TEST(TestMaxIdAccess);
   MITK_TEST(TestInsertPointAtEnd);
+  MITK_TEST(TestPointArrays);
+  MITK_TEST(TestBulkInsertAndRemove);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -478,6 +483,76 @@ std::cout<<"[PASSED]"<<std::endl;
     pointSet->InsertPoint(in4, 7);
     MITK_ASSERT_EQUAL(pointSet, refPs4, "Check point insertion for time step 7.");
   }
+
+  void TestPointArrays()
+  {
+    mitk::PointSetArrays::ConstPointer arrays = pointSet->GetPointArrays();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Arrays contain all points", std::size_t(5), arrays->GetNumberOfPoints());
+    CPPUNIT_ASSERT_MESSAGE("Arrays are cached", arrays == pointSet->GetPointArrays());
+
+    for (std::size_t i = 0; i < arrays->GetNumberOfPoints(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Ids are ascending", mitk::PointSet::PointIdentifier(i), arrays->GetId(i));
+      CPPUNIT_ASSERT_MESSAGE("Coordinates", mitk::Equal(arrays->GetPoint(i), pointSet->GetPoint(i)));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Selection", pointSet->GetSelectInfo(static_cast<int>(i)), arrays->IsSelected(i));
+    }
+
+    double vtkPoint[3];
+    arrays->GetVtkPoints()->GetPoint(1, vtkPoint);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("vtkPoints share the coordinates", vtkIdType(5), arrays->GetVtkPoints()->GetNumberOfPoints());
+    CPPUNIT_ASSERT_MESSAGE("vtkPoints coordinates", mitk::Equal(arrays->GetPoint(1), mitk::Point3D(vtkPoint)));
+
+    // modifications create new arrays, returned arrays do not change
+    pointSet->RemovePoints({1});
+    CPPUNIT_ASSERT_MESSAGE("Arrays are updated", arrays != pointSet->GetPointArrays());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), arrays->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), pointSet->GetPointArrays()->GetNumberOfPoints());
+
+    // round trip through SetPointArrays
+    mitk::PointSet::Pointer copy = mitk::PointSet::New();
+    copy->SetPointArrays(pointSet->GetPointArrays());
+    CPPUNIT_ASSERT_MESSAGE("Point set from arrays", mitk::Equal(*pointSet, *copy, mitk::eps, true, false));
+    CPPUNIT_ASSERT_MESSAGE("Selection from arrays", copy->GetSelectInfo(selectedPointId));
+  }
+
+  void TestBulkInsertAndRemove()
+  {
+    std::vector<mitk::Point3D> points(1000);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      mitk::FillVector3D(points[i], i, 2.0 * i, -0.5 * i);
+    }
+
+    const mitk::PointSet::PointIdentifier firstId = pointSet->InsertPoints(points);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Ids continue after the max id", mitk::PointSet::PointIdentifier(5), firstId);
+    CPPUNIT_ASSERT_EQUAL(1005, pointSet->GetSize());
+    CPPUNIT_ASSERT_MESSAGE("Inserted point", mitk::Equal(points[999], pointSet->GetPoint(firstId + 999)));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Inserted points are not selected", 1, pointSet->GetNumberOfSelected());
+
+    std::vector<mitk::PointSet::PointIdentifier> ids;
+    for (mitk::PointSet::PointIdentifier id = 0; id < 1005; id += 2)
+    {
+      ids.push_back(id);
+    }
+    ids.push_back(5000);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Removed existing points", 503u, pointSet->RemovePoints(ids));
+    CPPUNIT_ASSERT_EQUAL(502, pointSet->GetSize());
+    CPPUNIT_ASSERT(!pointSet->IndexExists(4));
+    CPPUNIT_ASSERT(pointSet->IndexExists(5));
+
+    mitk::PointSetArrays::Pointer arrays = mitk::PointSetArrays::New();
+    arrays->Append(pointSet->GetPointArrays()->GetCoordinates(), 502);
+    std::vector<std::size_t> positions = {501, 0, 7, 7};
+    arrays->RemovePositions(positions);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(499), arrays->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(mitk::PointSet::PointIdentifier(8), arrays->GetId(6));
+
+    std::size_t position = 0;
+    CPPUNIT_ASSERT(arrays->FindPosition(100, position) && position == 98);
+    CPPUNIT_ASSERT(!arrays->FindPosition(7, position));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkPointSet)
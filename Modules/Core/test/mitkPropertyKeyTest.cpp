@@ -0,0 +1,113 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include <mitkTestFixture.h>
+
+#include <mitkDataNode.h>
+#include <mitkPointSet.h>
+#include <mitkProperties.h>
+#include <mitkPropertyKey.h>
+#include <mitkPropertyList.h>
+
+class mitkPropertyKeyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyTestSuite);
+  MITK_TEST(TestInterning);
+  MITK_TEST(TestPropertyListLookup);
+  MITK_TEST(TestDataNodeLookup);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void TestInterning()
+  {
+    mitk::PropertyKey key1("org.mitk.test.key");
+    mitk::PropertyKey key2(std::string("org.mitk.test.key"));
+    mitk::PropertyKey key3("org.mitk.test.other key");
+
+    CPPUNIT_ASSERT(key1 == key2);
+    CPPUNIT_ASSERT_EQUAL(key1.GetId(), key2.GetId());
+    CPPUNIT_ASSERT(key1 != key3);
+    CPPUNIT_ASSERT_EQUAL(std::string("org.mitk.test.key"), key1.GetName());
+    CPPUNIT_ASSERT_EQUAL(&key1.GetName(), &key2.GetName());
+
+    CPPUNIT_ASSERT(mitk::PropertyKey() == mitk::PropertyKey(""));
+    CPPUNIT_ASSERT(mitk::PropertyKey().GetName().empty());
+  }
+
+  void TestPropertyListLookup()
+  {
+    const mitk::PropertyKey boolKey("bool");
+    const mitk::PropertyKey intKey("int");
+
+    mitk::PropertyList::Pointer list = mitk::PropertyList::New();
+    CPPUNIT_ASSERT(list->GetProperty(boolKey) == nullptr);
+
+    list->SetProperty("bool", mitk::BoolProperty::New(true));
+    list->SetIntProperty("int", 3);
+    CPPUNIT_ASSERT(list->GetProperty(boolKey) == list->GetProperty("bool"));
+
+    mitk::BoolProperty *boolProperty = nullptr;
+    CPPUNIT_ASSERT(list->GetProperty(boolProperty, boolKey));
+    CPPUNIT_ASSERT(boolProperty->GetValue());
+
+    mitk::IntProperty *intProperty = nullptr;
+    CPPUNIT_ASSERT(!list->GetProperty(intProperty, boolKey));
+
+    int intValue = 0;
+    CPPUNIT_ASSERT(list->GetPropertyValue(intKey, intValue));
+    CPPUNIT_ASSERT_EQUAL(3, intValue);
+
+    // the index follows replacing, removing and copying
+    list->ReplaceProperty("bool", mitk::IntProperty::New(5));
+    CPPUNIT_ASSERT(!list->GetProperty(boolProperty, boolKey));
+    CPPUNIT_ASSERT(list->GetPropertyValue(boolKey, intValue));
+    CPPUNIT_ASSERT_EQUAL(5, intValue);
+
+    mitk::PropertyList::Pointer clone = list->Clone();
+    CPPUNIT_ASSERT(clone->GetProperty(intKey) != nullptr);
+    CPPUNIT_ASSERT(clone->GetProperty(intKey) == clone->GetProperty("int"));
+    CPPUNIT_ASSERT(clone->GetProperty(intKey) != list->GetProperty(intKey));
+
+    list->DeleteProperty("bool");
+    CPPUNIT_ASSERT(list->GetProperty(boolKey) == nullptr);
+    list->RemoveProperty("int");
+    CPPUNIT_ASSERT(list->GetProperty(intKey) == nullptr);
+
+    clone->Clear();
+    CPPUNIT_ASSERT(clone->GetProperty(intKey) == nullptr);
+  }
+
+  void TestDataNodeLookup()
+  {
+    const mitk::PropertyKey visibleKey("visible");
+    const mitk::PropertyKey dataKey("org.mitk.test.data property");
+
+    mitk::DataNode::Pointer node = mitk::DataNode::New();
+    node->SetBoolProperty("visible", false);
+
+    bool visible = true;
+    CPPUNIT_ASSERT(node->GetBoolProperty(visibleKey, visible));
+    CPPUNIT_ASSERT(!visible);
+
+    mitk::PointSet::Pointer data = mitk::PointSet::New();
+    data->SetProperty("org.mitk.test.data property", mitk::FloatProperty::New(2.5f));
+    node->SetData(data);
+
+    float value = 0.0f;
+    CPPUNIT_ASSERT(node->GetPropertyValue(dataKey, value));
+    CPPUNIT_ASSERT_EQUAL(2.5f, value);
+    CPPUNIT_ASSERT(node->GetProperty(dataKey, nullptr, false) == nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKey)
@@ -0,0 +1,133 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+
+#include <mitkThickSlabProjector.h>
+#include <vtkMitkThickSlicesFilter.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <cstring>
+
+class mitkThickSlabProjectorTestHelper
+{
+public:
+  static const int SizeX = 17;
+  static const int SizeY = 11;
+  static const int SizeZ = 40;
+
+  /** Pixel values of the volume; slices outside the volume are extracted as background.*/
+  static short GetValue(int x, int y, int z)
+  {
+    if (z < 0 || z >= SizeZ)
+      return -1024;
+    return static_cast<short>(((x * 37 + y * 11 + z * 73) * 2654435761u >> 16) % 2000 - 500);
+  }
+
+  /** Creates an image of the slices [firstSlice, lastSlice] of the volume with the z extent [0, lastSlice - firstSlice].*/
+  static vtkSmartPointer<vtkImageData> CreateSlab(int firstSlice, int lastSlice)
+  {
+    auto slab = vtkSmartPointer<vtkImageData>::New();
+    slab->SetExtent(0, SizeX - 1, 0, SizeY - 1, 0, lastSlice - firstSlice);
+    slab->AllocateScalars(VTK_SHORT, 1);
+
+    for (int z = firstSlice; z <= lastSlice; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+          *static_cast<short *>(slab->GetScalarPointer(x, y, z - firstSlice)) = GetValue(x, y, z);
+
+    return slab;
+  }
+
+  static bool IsEqualProjection(vtkImageData *projection, vtkImageData *reference)
+  {
+    if (nullptr == projection || projection->GetDimensions()[0] != SizeX || projection->GetDimensions()[1] != SizeY ||
+        projection->GetDimensions()[2] != 1)
+      return false;
+
+    return 0 == std::memcmp(projection->GetScalarPointer(), reference->GetScalarPointer(), SizeX * SizeY * sizeof(short));
+  }
+};
+
+/**
+*  Test for mitk::ThickSlabProjector. The projections of a slab that is moved through a volume are compared
+*  with the projections of vtkMitkThickSlicesFilter.
+*/
+int mitkThickSlabProjectorTest(int, char *[])
+{
+  MITK_TEST_BEGIN("mitkThickSlabProjectorTest")
+
+  const int halfThickness = 4;
+  const int centers[] = {10, 11, 12, 13, 12, 11, 20, 21, 22, 2, 1, 0, -1, 38, 39, 40, 41};
+
+  const unsigned int slabSize = 2 * halfThickness + 1;
+
+  int center = 0;
+  unsigned int numberOfExtractions = 0;
+  vtkSmartPointer<vtkImageData> slice;
+  mitk::ThickSlabProjector::SliceExtractorType extractor = [&](int offset) -> vtkImageData * {
+    slice = mitkThickSlabProjectorTestHelper::CreateSlab(center + offset, center + offset);
+    ++numberOfExtractions;
+    return slice;
+  };
+
+  const int modes[] = {vtkMitkThickSlicesFilter::MIP,
+                       vtkMitkThickSlicesFilter::SUM,
+                       vtkMitkThickSlicesFilter::WEIGHTED,
+                       vtkMitkThickSlicesFilter::MINIP,
+                       vtkMitkThickSlicesFilter::MEAN};
+
+  mitk::ThickSlabProjector::Pointer projector = mitk::ThickSlabProjector::New();
+  auto filter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+
+  for (const int mode : modes)
+  {
+    filter->SetThickSliceMode(mode);
+
+    bool equal = true;
+    for (const int slabCenter : centers)
+    {
+      center = slabCenter;
+      vtkImageData *projection = projector->Project(mode, center, halfThickness, extractor);
+
+      filter->SetInputData(mitkThickSlabProjectorTestHelper::CreateSlab(center - halfThickness, center + halfThickness));
+      filter->Modified();
+      filter->Update();
+
+      equal = equal && mitkThickSlabProjectorTestHelper::IsEqualProjection(projection, filter->GetOutput());
+    }
+
+    MITK_TEST_CONDITION(equal, "Testing projections of a moving slab in mode " << mode);
+  }
+
+  // moving the slab by one slice extracts only the entering slice
+  projector->Reset();
+  center = 20;
+  projector->Project(vtkMitkThickSlicesFilter::MIP, center, halfThickness, extractor);
+  MITK_TEST_CONDITION(projector->GetNumberOfExtractedSlices() == slabSize, "Testing extraction of a new slab");
+
+  center = 21;
+  projector->Project(vtkMitkThickSlicesFilter::MIP, center, halfThickness, extractor);
+  MITK_TEST_CONDITION(projector->GetNumberOfExtractedSlices() == 1, "Testing extraction after scrolling");
+
+  projector->Project(vtkMitkThickSlicesFilter::MEAN, center, halfThickness, extractor);
+  MITK_TEST_CONDITION(projector->GetNumberOfExtractedSlices() == 0, "Testing reuse of slices for another mode");
+
+  projector->Reset();
+  numberOfExtractions = 0;
+  projector->Project(vtkMitkThickSlicesFilter::MEAN, center, halfThickness, extractor);
+  MITK_TEST_CONDITION(numberOfExtractions == slabSize, "Testing extraction after reset");
+
+  MITK_TEST_END()
+}
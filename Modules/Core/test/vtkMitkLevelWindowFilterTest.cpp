@@ -0,0 +1,150 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+
+#include <vtkMitkLevelWindowFilter.h>
+
+#include <vtkColorTransferFunction.h>
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkSmartPointer.h>
+
+#include <cstdlib>
+#include <cstring>
+
+class vtkMitkLevelWindowFilterTestHelper
+{
+public:
+  static const int SizeX = 23;
+  static const int SizeY = 13;
+
+  /** Creates an image with the same values for all scalar types.*/
+  static vtkSmartPointer<vtkImageData> CreateImage(int scalarType)
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetExtent(0, SizeX - 1, 0, SizeY - 1, 0, 0);
+    image->AllocateScalars(scalarType, 1);
+
+    for (int y = 0; y < SizeY; ++y)
+      for (int x = 0; x < SizeX; ++x)
+        image->SetScalarComponentFromDouble(x, y, 0, 0, (x * 37 + y * 101) % 400 - 100);
+
+    return image;
+  }
+
+  static vtkImageData *Apply(vtkMitkLevelWindowFilter *filter, vtkImageData *image, double *clippingBounds)
+  {
+    filter->SetClippingBounds(clippingBounds);
+    filter->SetInputData(image);
+    filter->Modified();
+    filter->Update();
+    return filter->GetOutput();
+  }
+
+  static bool IsEqual(vtkImageData *image, vtkImageData *reference)
+  {
+    return 0 == std::memcmp(image->GetScalarPointer(), reference->GetScalarPointer(), SizeX * SizeY * 4);
+  }
+
+  /** Checks the output against the color transfer function with a tolerance for quantized values.*/
+  static bool IsColorTransferFunctionMapping(vtkImageData *output,
+                                             vtkImageData *image,
+                                             vtkColorTransferFunction *ctf,
+                                             vtkPiecewiseFunction *opacityFunction,
+                                             int tolerance)
+  {
+    for (int y = 0; y < SizeY; ++y)
+      for (int x = 0; x < SizeX; ++x)
+      {
+        const double value = image->GetScalarComponentAsDouble(x, y, 0, 0);
+        double rgba[4];
+        ctf->GetColor(value, rgba);
+        rgba[3] = opacityFunction->GetValue(value);
+
+        const auto *pixel = static_cast<unsigned char *>(output->GetScalarPointer(x, y, 0));
+        for (int i = 0; i < 4; ++i)
+          if (std::abs(pixel[i] - static_cast<int>(255.0 * rgba[i] + 0.5)) > tolerance)
+            return false;
+      }
+    return true;
+  }
+};
+
+/**
+*  Test for the color mapping of scalar images by vtkMitkLevelWindowFilter. The color tables of
+*  8/16 bit images have to give the same results as the direct mapping of other scalar types.
+*/
+int vtkMitkLevelWindowFilterTest(int, char *[])
+{
+  MITK_TEST_BEGIN("vtkMitkLevelWindowFilterTest")
+
+  double noClipping[4] = {-1000.0, 1000.0, -1000.0, 1000.0};
+  double clipping[4] = {3.5, 17.0, 2.0, 9.0};
+
+  auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+  lookupTable->SetTableRange(-50.0, 200.0);
+  lookupTable->SetHueRange(0.0, 0.7);
+  lookupTable->Build();
+
+  auto filter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+  filter->SetLookupTable(lookupTable);
+  auto referenceFilter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
+  referenceFilter->SetLookupTable(lookupTable);
+
+  auto floatImage = vtkMitkLevelWindowFilterTestHelper::CreateImage(VTK_FLOAT);
+  auto shortImage = vtkMitkLevelWindowFilterTestHelper::CreateImage(VTK_SHORT);
+
+  vtkImageData *reference = vtkMitkLevelWindowFilterTestHelper::Apply(referenceFilter, floatImage, noClipping);
+  vtkImageData *output = vtkMitkLevelWindowFilterTestHelper::Apply(filter, shortImage, noClipping);
+  MITK_TEST_CONDITION(vtkMitkLevelWindowFilterTestHelper::IsEqual(output, reference),
+                      "Testing color table of a 16 bit image");
+
+  // changing the level window has to rebuild the color table
+  lookupTable->SetTableRange(0.0, 100.0);
+  reference = vtkMitkLevelWindowFilterTestHelper::Apply(referenceFilter, floatImage, noClipping);
+  output = vtkMitkLevelWindowFilterTestHelper::Apply(filter, shortImage, noClipping);
+  MITK_TEST_CONDITION(vtkMitkLevelWindowFilterTestHelper::IsEqual(output, reference),
+                      "Testing color table after changing the level window");
+
+  reference = vtkMitkLevelWindowFilterTestHelper::Apply(referenceFilter, floatImage, clipping);
+  output = vtkMitkLevelWindowFilterTestHelper::Apply(filter, shortImage, clipping);
+  bool clipped = vtkMitkLevelWindowFilterTestHelper::IsEqual(output, reference);
+  clipped = clipped && 0 == *static_cast<unsigned int *>(output->GetScalarPointer(3, 5, 0)) &&
+            0 == *static_cast<unsigned int *>(output->GetScalarPointer(8, 9, 0));
+  MITK_TEST_CONDITION(clipped, "Testing clipping");
+
+  // color transfer function with opacity
+  auto ctf = vtkSmartPointer<vtkColorTransferFunction>::New();
+  ctf->AddRGBPoint(-100.0, 0.0, 0.0, 1.0);
+  ctf->AddRGBPoint(50.0, 1.0, 0.0, 0.0);
+  ctf->AddRGBPoint(250.0, 1.0, 1.0, 1.0);
+  auto opacityFunction = vtkSmartPointer<vtkPiecewiseFunction>::New();
+  opacityFunction->AddPoint(0.0, 0.0);
+  opacityFunction->AddPoint(200.0, 1.0);
+
+  filter->SetLookupTable(ctf);
+  filter->SetOpacityPiecewiseFunction(opacityFunction);
+
+  output = vtkMitkLevelWindowFilterTestHelper::Apply(filter, shortImage, noClipping);
+  MITK_TEST_CONDITION(
+    vtkMitkLevelWindowFilterTestHelper::IsColorTransferFunctionMapping(output, shortImage, ctf, opacityFunction, 0),
+    "Testing color table of a color transfer function");
+
+  output = vtkMitkLevelWindowFilterTestHelper::Apply(filter, floatImage, noClipping);
+  MITK_TEST_CONDITION(
+    vtkMitkLevelWindowFilterTestHelper::IsColorTransferFunctionMapping(output, floatImage, ctf, opacityFunction, 1),
+    "Testing quantized color transfer function");
+
+  MITK_TEST_END()
+}
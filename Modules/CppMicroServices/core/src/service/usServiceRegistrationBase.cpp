@@ -122,6 +122,7 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
         classes = ref_any_cast<std::vector<std::string> >(d->properties.Value(ServiceConstants::OBJECTCLASS()));
         long int sid = any_cast<long int>(d->properties.Value(ServiceConstants::SERVICE_ID()));
         d->properties = ServiceRegistry::CreateServiceProperties(props, classes, false, false, sid);
+        d->module->coreCtx->services.InvalidateLookupCache();
 
         {
           const Any& any = d->properties.Value(ServiceConstants::SERVICE_RANKING());
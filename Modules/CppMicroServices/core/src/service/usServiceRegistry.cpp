@@ -67,6 +67,9 @@ ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProp
 
 ServiceRegistry::ServiceRegistry(CoreModuleContext* coreCtx)
   : core(coreCtx)
+  , lookupTables(std::make_shared<LookupTables>())
+  , lookupCache(std::make_shared<LookupCache>(0))
+  , generation(0)
 {
 
 }
@@ -81,9 +84,56 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  std::atomic_store(&lookupTables, std::shared_ptr<const LookupTables>(std::make_shared<LookupTables>()));
+  InvalidateLookupCache();
   core = nullptr;
 }
 
+std::shared_ptr<const ServiceRegistry::LookupTables> ServiceRegistry::GetLookupTables() const
+{
+  return std::atomic_load(&lookupTables);
+}
+
+void ServiceRegistry::PublishLookupTables()
+{
+  std::shared_ptr<LookupTables> tables = std::make_shared<LookupTables>();
+  tables->classServices = classServices;
+  tables->serviceRegistrations = serviceRegistrations;
+  std::atomic_store(&lookupTables, std::shared_ptr<const LookupTables>(tables));
+  InvalidateLookupCache();
+}
+
+void ServiceRegistry::InvalidateLookupCache()
+{
+  // drop the cached results, they must not keep unregistered services alive
+  MutexLock lock(cacheMutex);
+  ++generation;
+  std::atomic_store(&lookupCache, std::shared_ptr<const LookupCache>(std::make_shared<LookupCache>(generation)));
+}
+
+LDAPExpr ServiceRegistry::GetFilter(const std::string& filter) const
+{
+  {
+    MutexLock lock(cacheMutex);
+    MapFilters::const_iterator i = filters.find(filter);
+    if (i != filters.end())
+    {
+      return i->second;
+    }
+  }
+
+  // parse outside of the lock, invalid filters throw and are not cached
+  LDAPExpr ldap(filter);
+
+  MutexLock lock(cacheMutex);
+  if (filters.size() >= MaxCacheSize)
+  {
+    filters.clear();
+  }
+  filters.insert(std::make_pair(filter, ldap));
+  return ldap;
+}
+
 ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
                                                      const InterfaceMap& service,
                                                      const ServiceProperties& properties)
@@ -123,6 +173,7 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
     }
+    PublishLookupTables();
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -145,20 +196,21 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
     s.erase(std::remove(s.begin(), s.end(), sr), s.end());
     s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
   }
+  PublishLookupTables();
 }
 
 void ServiceRegistry::Get(const std::string& clazz,
                           std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
-  MutexLock lock(mutex);
   Get_unlocked(clazz, serviceRegs);
 }
 
 void ServiceRegistry::Get_unlocked(const std::string& clazz,
                                    std::vector<ServiceRegistrationBase>& serviceRegs) const
 {
-  MapClassServices::const_iterator i = classServices.find(clazz);
-  if (i != classServices.end())
+  std::shared_ptr<const LookupTables> tables = GetLookupTables();
+  MapClassServices::const_iterator i = tables->classServices.find(clazz);
+  if (i != tables->classServices.end())
   {
     serviceRegs = i->second;
   }
@@ -166,7 +218,6 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz,
 
 ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::string& clazz) const
 {
-  MutexLock lock(mutex);
   try
   {
     std::vector<ServiceReferenceBase> srs;
@@ -188,12 +239,67 @@ ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::stri
 void ServiceRegistry::Get(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
 {
-  MutexLock lock(mutex);
   Get_unlocked(clazz, filter, module, res);
 }
 
 void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
+{
+  // The generation has to be read before the lookup tables: if the registry
+  // changes in between, the result is still returned but not cached.
+  const unsigned long gen = generation;
+  const std::string key = clazz + '\0' + filter;
+
+  std::shared_ptr<const LookupCache> cache = std::atomic_load(&lookupCache);
+  MapLookupResults::const_iterator hit = cache->results.end();
+  if (cache->generation == gen)
+  {
+    hit = cache->results.find(key);
+  }
+
+  if (hit != cache->results.end())
+  {
+    res.insert(res.end(), hit->second.begin(), hit->second.end());
+  }
+  else
+  {
+    std::vector<ServiceReferenceBase> found;
+    Lookup(*GetLookupTables(), clazz, filter, found);
+    res.insert(res.end(), found.begin(), found.end());
+
+    MutexLock lock(cacheMutex);
+    if (gen == generation)
+    {
+      std::shared_ptr<const LookupCache> current = std::atomic_load(&lookupCache);
+      std::shared_ptr<LookupCache> updated;
+      if (current->generation == gen && current->results.size() < MaxCacheSize)
+      {
+        updated = std::make_shared<LookupCache>(*current);
+      }
+      else
+      {
+        updated = std::make_shared<LookupCache>(gen);
+      }
+      updated->results[key].swap(found);
+      std::atomic_store(&lookupCache, std::shared_ptr<const LookupCache>(updated));
+    }
+  }
+
+  if (!res.empty())
+  {
+    if (module != nullptr)
+    {
+      core->serviceHooks.FilterServiceReferences(module->moduleContext, clazz, filter, res);
+    }
+    else
+    {
+      core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
+    }
+  }
+}
+
+void ServiceRegistry::Lookup(const LookupTables& tables, const std::string& clazz, const std::string& filter,
+                             std::vector<ServiceReferenceBase>& res) const
 {
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
@@ -203,7 +309,7 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetFilter(filter);
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched))
       {
@@ -211,8 +317,8 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
         for(LDAPExpr::ObjectClassSet::const_iterator className = matched.begin();
             className != matched.end(); ++className)
         {
-          MapClassServices::const_iterator i = classServices.find(*className);
-          if (i != classServices.end())
+          MapClassServices::const_iterator i = tables.classServices.find(*className);
+          if (i != tables.classServices.end())
           {
             std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
           }
@@ -229,20 +335,20 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
       }
       else
       {
-        s = serviceRegistrations.begin();
-        send = serviceRegistrations.end();
+        s = tables.serviceRegistrations.begin();
+        send = tables.serviceRegistrations.end();
       }
     }
     else
     {
-      s = serviceRegistrations.begin();
-      send = serviceRegistrations.end();
+      s = tables.serviceRegistrations.begin();
+      send = tables.serviceRegistrations.end();
     }
   }
   else
   {
-    MapClassServices::const_iterator it = classServices.find(clazz);
-    if (it != classServices.end())
+    MapClassServices::const_iterator it = tables.classServices.find(clazz);
+    if (it != tables.classServices.end())
     {
       s = it->second.begin();
       send = it->second.end();
@@ -253,29 +359,29 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetFilter(filter);
     }
   }
 
   for (; s != send; ++s)
   {
-    ServiceReferenceBase sri = s->GetReference(clazz);
-
-    if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+    // the snapshot may still contain services which are being unregistered,
+    // the properties may be changed concurrently by SetProperties()
+    bool matches = false;
     {
-      res.push_back(sri);
+      MutexLock lock(s->d->propsLock);
+      matches = s->d->available && (filter.empty() || ldap.Evaluate(s->d->properties, false));
     }
-  }
 
-  if (!res.empty())
-  {
-    if (module != nullptr)
+    if (matches)
     {
-      core->serviceHooks.FilterServiceReferences(module->moduleContext, clazz, filter, res);
-    }
-    else
-    {
-      core->serviceHooks.FilterServiceReferences(nullptr, clazz, filter, res);
+      try
+      {
+        res.push_back(s->GetReference(clazz));
+      }
+      catch (const std::logic_error&)
+      {
+      }
     }
   }
 }
@@ -303,6 +409,7 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
       classServices.erase(*i);
     }
   }
+  PublishLookupTables();
 }
 
 void ServiceRegistry::GetRegisteredByModule(ModulePrivate* p,
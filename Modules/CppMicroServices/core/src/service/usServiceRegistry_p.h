@@ -26,8 +26,12 @@
 #include "usServiceInterface.h"
 #include "usServiceRegistration.h"
 
+#include "usLDAPExpr_p.h"
 #include "usThreads_p.h"
 
+#include <atomic>
+#include <memory>
+
 US_BEGIN_NAMESPACE
 
 class CoreModuleContext;
@@ -81,6 +85,17 @@ public:
 
   CoreModuleContext* core;
 
+  /**
+   * Immutable copy of the lookup tables above. Writers publish a new snapshot
+   * while holding <code>mutex</code>, readers load the current one without
+   * locking.
+   */
+  struct LookupTables
+  {
+    MapClassServices classServices;
+    std::vector<ServiceRegistrationBase> serviceRegistrations;
+  };
+
   ServiceRegistry(CoreModuleContext* coreCtx);
 
   ~ServiceRegistry();
@@ -169,8 +184,48 @@ public:
    */
   void GetUsedByModule(Module* m, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  /**
+   * Invalidate and release all cached lookup results. Must be called whenever
+   * the properties of a registered service change.
+   */
+  void InvalidateLookupCache();
+
 private:
 
+  typedef US_UNORDERED_MAP_TYPE<std::string, std::vector<ServiceReferenceBase> > MapLookupResults;
+  typedef US_UNORDERED_MAP_TYPE<std::string, LDAPExpr> MapFilters;
+
+  /**
+   * Lookup results (before applying find hooks) for a class name and filter,
+   * valid as long as <code>generation</code> matches the registry generation.
+   */
+  struct LookupCache
+  {
+    LookupCache(unsigned long gen) : generation(gen) {}
+    unsigned long generation;
+    MapLookupResults results;
+  };
+
+  /** Upper bound for cached lookup results and compiled filters. */
+  static const std::size_t MaxCacheSize = 1024;
+
+  std::shared_ptr<const LookupTables> GetLookupTables() const;
+
+  /** Publish the current lookup tables. Must be called with <code>mutex</code> held. */
+  void PublishLookupTables();
+
+  LDAPExpr GetFilter(const std::string& filter) const;
+
+  void Lookup(const LookupTables& tables, const std::string& clazz, const std::string& filter,
+              std::vector<ServiceReferenceBase>& serviceRefs) const;
+
+  std::shared_ptr<const LookupTables> lookupTables;
+
+  mutable Mutex cacheMutex;
+  mutable std::shared_ptr<const LookupCache> lookupCache;
+  mutable MapFilters filters;
+  std::atomic<unsigned long> generation;
+
   friend class ServiceHooks;
 
   void Get_unlocked(const std::string& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
@@ -46,8 +46,14 @@ US_USE_NAMESPACE
 #error High precision timer support nod available on this platform
 #endif
 
+#include <algorithm>
 #include <vector>
 
+#ifdef US_ENABLE_THREADING_SUPPORT
+#include <atomic>
+#include <thread>
+#endif
+
 class HighPrecisionTimer
 {
 
@@ -204,6 +210,9 @@ public:
   void TestAddListeners();
   void TestRegisterServices();
 
+  void TestLookupServices(int value, std::size_t expectedIndex);
+  void TestConcurrentLookups();
+
   void TestModifyServices();
   void TestUnregisterServices();
 
@@ -358,6 +367,79 @@ void ServiceRegistryPerformanceTest::RegisterServices(int n)
   }
 }
 
+void ServiceRegistryPerformanceTest::TestLookupServices(int value, std::size_t expectedIndex)
+{
+  std::vector<ServiceReference<IPerfTestService> > all = mc->GetServiceReferences<IPerfTestService>();
+  US_TEST_CONDITION_REQUIRED(all.size() == regs.size(), "Unfiltered lookup returns all services");
+
+  std::stringstream filter;
+  filter << "(perf.service.value=" << value << ")";
+
+  // the second lookup is answered from the cache and must not differ
+  for (int i = 0; i < 2; ++i)
+  {
+    std::vector<ServiceReference<IPerfTestService> > refs = mc->GetServiceReferences<IPerfTestService>(filter.str());
+    US_TEST_CONDITION_REQUIRED(refs.size() == 1, "Filtered lookup returns exactly one service");
+    US_TEST_CONDITION_REQUIRED(refs.front() == regs[expectedIndex].GetReference(),
+                               "Filtered lookup returns the service with matching properties");
+  }
+}
+
+void ServiceRegistryPerformanceTest::TestConcurrentLookups()
+{
+#ifdef US_ENABLE_THREADING_SUPPORT
+  const unsigned int nThreads = std::max(std::thread::hardware_concurrency(), 4u);
+  const int nLookups = 10000;
+  const int nFilters = 100;
+
+  Log() << "Look up services with " << nFilters << " different filters from " << nThreads << " threads, "
+        << nLookups << " lookups per thread\n";
+
+  std::vector<std::string> filters;
+  for (int i = 0; i < nFilters; ++i)
+  {
+    std::stringstream ss;
+    ss << "(perf.service.value=" << i + 1 << ")";
+    filters.push_back(ss.str());
+  }
+
+  std::atomic<int> failures(0);
+
+  HighPrecisionTimer t;
+  t.Start();
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < nThreads; ++i)
+  {
+    threads.push_back(std::thread([&, i]() {
+      for (int j = 0; j < nLookups; ++j)
+      {
+        const std::string& filter = filters[(i + j) % nFilters];
+        if (mc->GetServiceReferences<IPerfTestService>(filter).size() != 1)
+        {
+          ++failures;
+        }
+        if (!mc->GetServiceReference<IPerfTestService>())
+        {
+          ++failures;
+        }
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  long long us = t.ElapsedMicro();
+  Log() << "concurrent lookups took " << us / 1000 << "ms (" << (us * 1000) / (2LL * nLookups * nThreads)
+        << "ns per lookup)\n";
+
+  US_TEST_CONDITION_REQUIRED(failures == 0, "All concurrent lookups find their service");
+#endif
+}
+
 void ServiceRegistryPerformanceTest::TestModifyServices()
 {
   Log() << "Modify all services, and check that we get #of services ("
@@ -420,7 +502,10 @@ int usServiceRegistryPerformanceTest(int /*argc*/, char* /*argv*/[])
   perfTest.InitTestCase();
   perfTest.TestAddListeners();
   perfTest.TestRegisterServices();
+  perfTest.TestLookupServices(4, 3);
+  perfTest.TestConcurrentLookups();
   perfTest.TestModifyServices();
+  perfTest.TestLookupServices(4, 2);
   perfTest.TestUnregisterServices();
   perfTest.CleanupTestCase();
 
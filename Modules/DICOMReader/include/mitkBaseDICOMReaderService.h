@@ -38,6 +38,10 @@ public:
 
   IFileReader::ConfidenceLevel GetConfidenceLevel() const override;
 
+  /** DICOM files are read on the calling thread: a reader loads all files of a series,
+   * so that the other files of the series do not have to be read again.*/
+  bool IsThreadSafe() const override;
+
 protected:
   /** Returns the list of all DCM files that are in the same directory
    * like this->GetLocalFileName().*/
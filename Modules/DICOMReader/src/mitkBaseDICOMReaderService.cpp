@@ -189,6 +189,11 @@ IFileReader::ConfidenceLevel BaseDICOMReaderService::GetConfidenceLevel() const
   return abstractConfidence;
 }
 
+bool BaseDICOMReaderService::IsThreadSafe() const
+{
+  return false;
+}
+
 std::string GenerateNameFromDICOMProperties(const mitk::IPropertyProvider* provider)
 {
   std::string nodeName = mitk::DataNode::NO_NAME_VALUE();
@@ -11,10 +11,12 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkNavigationDataEvaluationFilter.h"
-#include <mitkPointSetStatisticsCalculator.h>
+#include <itkMath.h>
 
 mitk::NavigationDataEvaluationFilter::NavigationDataEvaluationFilter()
-  : mitk::NavigationDataToNavigationDataFilter()
+  : mitk::NavigationDataToNavigationDataFilter(),
+    m_SlidingWindowSize(0),
+    m_MaximumNumberOfStoredSamples(10000)
 {
 }
 
@@ -38,11 +40,10 @@ void mitk::NavigationDataEvaluationFilter::GenerateData()
     if (input->IsDataValid() == false) { output->SetDataValid(false); }
     else { output->Graft(input); }
 
-    //then save statistics
+    //then update statistics
     if (input->IsDataValid())
     {
-      m_LoggedPositions[i].push_back(input->GetPosition());
-      m_LoggedQuaternions[i].push_back(input->GetOrientation());
+      m_Statistics[i].Add(input->GetPosition(), input->GetOrientation());
     }
     else
     {
@@ -52,15 +53,10 @@ void mitk::NavigationDataEvaluationFilter::GenerateData()
 }
 void mitk::NavigationDataEvaluationFilter::CreateMembersForAllInputs()
 {
-  while (this->m_LoggedPositions.size() < this->GetNumberOfInputs())
+  while (this->m_Statistics.size() < this->GetNumberOfInputs())
   {
-    std::pair<std::size_t, std::vector<mitk::Point3D> > newElement(m_LoggedPositions.size(), std::vector<mitk::Point3D>());
-    m_LoggedPositions.insert(newElement);
-  }
-  while (this->m_LoggedQuaternions.size() < this->GetNumberOfInputs())
-  {
-    std::pair<std::size_t, std::vector<mitk::Quaternion> > newElement(m_LoggedQuaternions.size(), std::vector<mitk::Quaternion>());
-    m_LoggedQuaternions.insert(newElement);
+    m_Statistics.emplace(m_Statistics.size(),
+                         mitk::NavigationDataStatistics(m_SlidingWindowSize, m_MaximumNumberOfStoredSamples));
   }
   while (this->m_InvalidSamples.size() < this->GetNumberOfInputs())
   {
@@ -71,224 +67,153 @@ void mitk::NavigationDataEvaluationFilter::CreateMembersForAllInputs()
 
 void mitk::NavigationDataEvaluationFilter::ResetStatistic()
 {
-  for (unsigned int i = 0; i < m_LoggedPositions.size(); i++) m_LoggedPositions[i] = std::vector<mitk::Point3D>();
-  for (unsigned int i = 0; i < m_LoggedQuaternions.size(); i++) m_LoggedQuaternions[i] = std::vector<mitk::Quaternion>();
+  for (auto& statistics : m_Statistics)
+    statistics.second = mitk::NavigationDataStatistics(m_SlidingWindowSize, m_MaximumNumberOfStoredSamples);
   for (unsigned int i = 0; i < m_InvalidSamples.size(); i++) m_InvalidSamples[i] = 0;
 }
 
+void mitk::NavigationDataEvaluationFilter::SetSlidingWindowSize(unsigned int size)
+{
+  if (m_SlidingWindowSize == size)
+    return;
+  m_SlidingWindowSize = size;
+  this->ResetStatistic();
+  this->Modified();
+}
+
+void mitk::NavigationDataEvaluationFilter::SetMaximumNumberOfStoredSamples(unsigned int number)
+{
+  if (m_MaximumNumberOfStoredSamples == number)
+    return;
+  m_MaximumNumberOfStoredSamples = number;
+  this->ResetStatistic();
+  this->Modified();
+}
+
 int mitk::NavigationDataEvaluationFilter::GetNumberOfAnalysedNavigationData(int input)
 {
-  return this->m_LoggedPositions[input].size();
+  return this->m_Statistics[input].GetNumberOfSamples();
 }
 
 mitk::Point3D mitk::NavigationDataEvaluationFilter::GetPositionMean(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionMean();
+  return m_Statistics[input].GetPositionMean();
 }
 
 mitk::Vector3D mitk::NavigationDataEvaluationFilter::GetPositionStandardDeviation(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionStandardDeviation();
+  return m_Statistics[input].GetPositionStandardDeviation();
 }
 
 mitk::Vector3D mitk::NavigationDataEvaluationFilter::GetPositionSampleStandardDeviation(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionSampleStandardDeviation();
+  return m_Statistics[input].GetPositionSampleStandardDeviation();
 }
 
 mitk::Quaternion mitk::NavigationDataEvaluationFilter::GetQuaternionMean(int input)
 {
-  return GetMean(m_LoggedQuaternions[input]);
+  return m_Statistics[input].GetQuaternionMean();
 }
 
 mitk::Quaternion mitk::NavigationDataEvaluationFilter::GetQuaternionStandardDeviation(int input)
 {
-  mitk::Quaternion returnValue;
-  std::vector<double> list1 = std::vector<double>();
-  std::vector<double> list2 = std::vector<double>();
-  std::vector<double> list3 = std::vector<double>();
-  std::vector<double> list4 = std::vector<double>();
-  for (unsigned int i = 0; i < m_LoggedQuaternions[input].size(); i++)
-  {
-    list1.push_back(m_LoggedQuaternions[input].at(i)[0]);
-    list2.push_back(m_LoggedQuaternions[input].at(i)[1]);
-    list3.push_back(m_LoggedQuaternions[input].at(i)[2]);
-    list4.push_back(m_LoggedQuaternions[input].at(i)[3]);
-  }
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New();
-  returnValue[0] = myCalculator->GetStabw(list1);
-  returnValue[1] = myCalculator->GetStabw(list2);
-  returnValue[2] = myCalculator->GetStabw(list3);
-  returnValue[3] = myCalculator->GetStabw(list4);
-  return returnValue;
+  return m_Statistics[input].GetQuaternionStandardDeviation();
 }
 
 mitk::Vector3D mitk::NavigationDataEvaluationFilter::GetEulerAnglesMean(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(QuaternionsToEulerAngles(m_LoggedQuaternions[input])));
-  mitk::Vector3D returnValue;
-  returnValue[0] = myCalculator->GetPositionMean()[0];
-  returnValue[1] = myCalculator->GetPositionMean()[1];
-  returnValue[2] = myCalculator->GetPositionMean()[2];
-  return returnValue;
+  return m_Statistics[input].GetEulerAnglesMean();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetEulerAnglesRMS(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(QuaternionsToEulerAngles(m_LoggedQuaternions[input])));
-  return myCalculator->GetPositionErrorRMS();
+  return m_Statistics[input].GetEulerAnglesRMS();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetEulerAnglesRMSDegree(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(QuaternionsToEulerAnglesGrad(m_LoggedQuaternions[input])));
-  return myCalculator->GetPositionErrorRMS();
+  return (m_Statistics[input].GetEulerAnglesRMS() / itk::Math::pi) * 180;
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorMean(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorMean();
+  return m_Statistics[input].GetPositionErrorMean();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorStandardDeviation(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorStandardDeviation();
+  return m_Statistics[input].GetPositionErrorStandardDeviation();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorSampleStandardDeviation(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorSampleStandardDeviation();
+  return m_Statistics[input].GetPositionErrorSampleStandardDeviation();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorRMS(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorRMS();
+  return m_Statistics[input].GetPositionErrorRMS();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorMedian(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorMedian();
+  return m_Statistics[input].GetPositionErrorMedian();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorMax(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorMax();
+  return m_Statistics[input].GetPositionErrorMax();
 }
 
 double mitk::NavigationDataEvaluationFilter::GetPositionErrorMin(int input)
 {
-  mitk::PointSetStatisticsCalculator::Pointer myCalculator = mitk::PointSetStatisticsCalculator::New(VectorToPointSet(m_LoggedPositions[input]));
-  return myCalculator->GetPositionErrorMin();
+  return m_Statistics[input].GetPositionErrorMin();
 }
 
-int mitk::NavigationDataEvaluationFilter::GetNumberOfInvalidSamples(int input)
+double mitk::NavigationDataEvaluationFilter::GetPositionErrorPercentile(double percentile, int input)
 {
-  return m_InvalidSamples[input];
+  return m_Statistics[input].GetPositionErrorPercentile(percentile);
 }
 
-double mitk::NavigationDataEvaluationFilter::GetPercentageOfInvalidSamples(int input)
+bool mitk::NavigationDataEvaluationFilter::IsPositionErrorStatisticExact(int input)
 {
-  return (m_InvalidSamples[input] / (m_InvalidSamples[input] + ((double)m_LoggedPositions[input].size())))*100.0;
+  return m_Statistics[input].IsPositionErrorStatisticExact();
 }
 
-mitk::Quaternion mitk::NavigationDataEvaluationFilter::GetMean(std::vector<mitk::Quaternion> list)
-{
-  //calculate mean
-  mitk::Quaternion mean;
-  mean[0] = 0;
-  mean[1] = 0;
-  mean[2] = 0;
-  mean[3] = 0;
-
-  for (unsigned int i = 0; i < list.size(); i++)
-  {
-    mean[0] += list.at(i)[0];
-    mean[1] += list.at(i)[1];
-    mean[2] += list.at(i)[2];
-    mean[3] += list.at(i)[3];
-  }
-
-  mean[0] /= list.size();
-  mean[1] /= list.size();
-  mean[2] /= list.size();
-  mean[3] /= list.size();
-
-  return mean;
-}
-
-mitk::PointSet::Pointer mitk::NavigationDataEvaluationFilter::VectorToPointSet(std::vector<mitk::Point3D> pSet)
-{
-  mitk::PointSet::Pointer returnValue = mitk::PointSet::New();
-  for (unsigned int i = 0; i < pSet.size(); i++) returnValue->InsertPoint(i, pSet.at(i));
-  return returnValue;
-}
-
-mitk::PointSet::Pointer mitk::NavigationDataEvaluationFilter::VectorToPointSet(std::vector<mitk::Vector3D> pSet)
+int mitk::NavigationDataEvaluationFilter::GetNumberOfInvalidSamples(int input)
 {
-  mitk::PointSet::Pointer returnValue = mitk::PointSet::New();
-  for (unsigned int i = 0; i < pSet.size(); i++)
-  {
-    mitk::Point3D thisPoint;
-    thisPoint[0] = pSet.at(i)[0];
-    thisPoint[1] = pSet.at(i)[1];
-    thisPoint[2] = pSet.at(i)[2];
-    returnValue->InsertPoint(i, thisPoint);
-  }
-  return returnValue;
+  return m_InvalidSamples[input];
 }
 
-std::vector<mitk::Vector3D> mitk::NavigationDataEvaluationFilter::QuaternionsToEulerAngles(std::vector<mitk::Quaternion> quaterions)
+double mitk::NavigationDataEvaluationFilter::GetPercentageOfInvalidSamples(int input)
 {
-  std::vector<mitk::Vector3D> returnValue = std::vector<mitk::Vector3D>();
-  for (unsigned int i = 0; i < quaterions.size(); i++)
-  {
-    mitk::Vector3D eulerAngles;
-    mitk::Quaternion currentQuaternion = quaterions.at(i);
-    currentQuaternion.normalize(); //must be normalized due to the documentation of the vnl method rotation_euler_angles()
-    eulerAngles[0] = currentQuaternion.rotation_euler_angles()[0];
-    eulerAngles[1] = currentQuaternion.rotation_euler_angles()[1];
-    eulerAngles[2] = currentQuaternion.rotation_euler_angles()[2];
-    returnValue.push_back(eulerAngles);
-  }
-  return returnValue;
+  const double numberOfValidSamples = m_Statistics[input].GetNumberOfAddedSamples();
+  return (m_InvalidSamples[input] / (m_InvalidSamples[input] + numberOfValidSamples))*100.0;
 }
 
-std::vector<mitk::Vector3D> mitk::NavigationDataEvaluationFilter::QuaternionsToEulerAnglesGrad(std::vector<mitk::Quaternion> quaterions)
+unsigned int mitk::NavigationDataEvaluationFilter::GetNumberOfLoggedNavigationData(int input)
 {
-  std::vector<mitk::Vector3D> returnValue = std::vector<mitk::Vector3D>();
-  std::vector<mitk::Vector3D> eulerAnglesRadians = QuaternionsToEulerAngles(quaterions);
-  for (unsigned int i = 0; i < eulerAnglesRadians.size(); i++)
-  {
-    mitk::Vector3D currentAngles;
-    currentAngles[0] = (eulerAnglesRadians.at(i)[0] / itk::Math::pi) * 180;
-    currentAngles[1] = (eulerAnglesRadians.at(i)[1] / itk::Math::pi) * 180;
-    currentAngles[2] = (eulerAnglesRadians.at(i)[2] / itk::Math::pi) * 180;
-    returnValue.push_back(currentAngles);
-  }
-  return returnValue;
+  return m_Statistics[input].GetNumberOfStoredSamples();
 }
 
 mitk::Point3D  mitk::NavigationDataEvaluationFilter::GetLoggedPosition(unsigned int i, int input)
 {
+  const mitk::NavigationDataStatistics& statistics = m_Statistics[input];
+  const unsigned long firstStoredSample = statistics.GetNumberOfAddedSamples() - statistics.GetNumberOfStoredSamples();
+
   mitk::Point3D returnValue;
-  if (m_LoggedPositions[input].size() <= i) returnValue.Fill(0);
-  else returnValue = m_LoggedPositions[input].at(i);
+  mitk::Quaternion orientation;
+  if (!statistics.GetStoredSample(firstStoredSample + i, returnValue, orientation)) returnValue.Fill(0);
   return returnValue;
 }
 
 mitk::Quaternion  mitk::NavigationDataEvaluationFilter::GetLoggedOrientation(unsigned int i, int input)
 {
+  const mitk::NavigationDataStatistics& statistics = m_Statistics[input];
+  const unsigned long firstStoredSample = statistics.GetNumberOfAddedSamples() - statistics.GetNumberOfStoredSamples();
+
+  mitk::Point3D position;
   mitk::Quaternion returnValue;
-  if (m_LoggedQuaternions[input].size() <= i) returnValue.fill(0);
-  else returnValue = m_LoggedQuaternions[input].at(i);
+  if (!statistics.GetStoredSample(firstStoredSample + i, position, returnValue)) returnValue.fill(0);
   return returnValue;
 }
@@ -15,9 +15,8 @@ found in the LICENSE file.
 #define MITKNavigationDataEvaluationFilter_H_HEADER_INCLUDED_
 
 #include <mitkNavigationDataToNavigationDataFilter.h>
+#include <mitkNavigationDataStatistics.h>
 #include <mitkPointSet.h>
-#include <itkQuaternionRigidTransform.h>
-#include <itkTransform.h>
 
 
 namespace mitk {
@@ -26,6 +25,16 @@ namespace mitk {
   * \brief NavigationDataEvaluationFilter calculates statistical data (mean value, mean error, etc.) on the input navigation data.
   * Input navigation data are set 1:1 on output navigation data.
   *
+  * The statistics are updated online with every sample (see mitk::NavigationDataStatistics), so
+  * long recordings neither slow down the filter nor let its memory grow. Optionally, the statistics
+  * only cover a sliding window of the most recent samples.
+  *
+  * Only the most recent samples are stored (see SetMaximumNumberOfStoredSamples()). Without a sliding
+  * window, the position error statistics (GetPositionError...()) of more samples than that do not
+  * match the values of a batch computation: the errors are measured against the mean at the time
+  * each sample was added, and the median and percentiles are estimates. IsPositionErrorStatisticExact()
+  * tells whether this is the case. The logged positions and orientations are the stored samples.
+  *
   * \ingroup IGT
   */
   class MITKIGT_EXPORT NavigationDataEvaluationFilter : public NavigationDataToNavigationDataFilter
@@ -40,6 +49,17 @@ namespace mitk {
     /** @brief Resets all statistics and starts again. */
     void ResetStatistic();
 
+    /** @brief Sets the number of recent samples the statistics cover, 0 (default) for all samples since the last reset.
+      * Changing the window size resets all statistics. */
+    void SetSlidingWindowSize(unsigned int size);
+    itkGetConstMacro(SlidingWindowSize, unsigned int);
+
+    /** @brief Sets the number of samples that are kept per input if there is no sliding window. Up to this number of
+      * samples, the position error statistics are exact; beyond, they are estimated online. Default is 10000.
+      * Changing the number resets all statistics. */
+    void SetMaximumNumberOfStoredSamples(unsigned int number);
+    itkGetConstMacro(MaximumNumberOfStoredSamples, unsigned int);
+
     /** @return Returns the number of analysed navigation datas for the specified input (without invalid samples). */
     int GetNumberOfAnalysedNavigationData(int input);
     /** @return Returns the number of invalid samples for the specified input. Invalid samples are ignored for the statistical calculation.*/
@@ -78,11 +98,20 @@ namespace mitk {
     double GetPositionErrorMax(int input);
     /** @return Returns the minimum of the errors of all positions to the specified input. */
     double GetPositionErrorMin(int input);
+    /** @return Returns the given percentile (0 to 100) of the errors of all positions to the specified input. */
+    double GetPositionErrorPercentile(double percentile, int input);
+    /** @return Returns true if the error statistics of the specified input are computed from all samples. If false,
+      * they are estimated online (see SetMaximumNumberOfStoredSamples()). */
+    bool IsPositionErrorStatisticExact(int input);
+
+    /** @return Returns the number of logged (stored) samples of the specified input. This is less than
+      * GetNumberOfAnalysedNavigationData() if more samples were analysed than are stored. */
+    unsigned int GetNumberOfLoggedNavigationData(int input);
 
-    /** @return Returns a logged point on position i of the specified input. If there is no point on position i the method returns [0,0,0] */
+    /** @return Returns the logged point on position i of the specified input, 0 is the oldest stored sample. If i is not smaller than GetNumberOfLoggedNavigationData(), the method returns [0,0,0] */
     mitk::Point3D GetLoggedPosition(unsigned int i, int input);
 
-    /** @return Returns a logged orientation on position i of the specified input. If there is no orientation on position i the method returns [0,0,0,0] */
+    /** @return Returns the logged orientation on position i of the specified input, 0 is the oldest stored sample. If i is not smaller than GetNumberOfLoggedNavigationData(), the method returns [0,0,0,0] */
     mitk::Quaternion GetLoggedOrientation(unsigned int i, int input);
 
   protected:
@@ -101,20 +130,11 @@ namespace mitk {
     void CreateMembersForAllInputs();
 
 
-    std::map<std::size_t,std::vector<mitk::Point3D> > m_LoggedPositions; //a map here, to have one list for every navigation data
-    std::map<std::size_t,std::vector<mitk::Quaternion> > m_LoggedQuaternions;
+    std::map<std::size_t, mitk::NavigationDataStatistics> m_Statistics; //a map here, to have statistics for every navigation data
     std::map<std::size_t,int> m_InvalidSamples;
 
-    mitk::Quaternion GetMean(std::vector<mitk::Quaternion> list);
-
-    mitk::PointSet::Pointer VectorToPointSet(std::vector<mitk::Point3D> pSet);
-
-    mitk::PointSet::Pointer VectorToPointSet(std::vector<mitk::Vector3D> pSet);
-
-    /** @brief Converts a list of quaterions to a list of euler angles (theta_x, theta_y, theta_z) */
-    std::vector<mitk::Vector3D> QuaternionsToEulerAngles(std::vector<mitk::Quaternion> quaterions); //in radians
-    std::vector<mitk::Vector3D> QuaternionsToEulerAnglesGrad(std::vector<mitk::Quaternion> quaterions); //in degree
-
+    unsigned int m_SlidingWindowSize;
+    unsigned int m_MaximumNumberOfStoredSamples;
   };
 } // namespace mitk
 
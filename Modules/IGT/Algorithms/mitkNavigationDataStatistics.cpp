@@ -0,0 +1,342 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataStatistics.h"
+
+#include <cmath>
+#include <limits>
+
+mitk::QuantileSketch::QuantileSketch(double relativeAccuracy, unsigned int maximumNumberOfBins)
+  : m_Gamma((1.0 + relativeAccuracy) / (1.0 - relativeAccuracy)),
+    m_LogGamma(std::log(m_Gamma)),
+    m_MaximumNumberOfBins(std::max(1u, maximumNumberOfBins)),
+    m_ZeroCount(0),
+    m_Count(0)
+{
+}
+
+void mitk::QuantileSketch::Add(double value)
+{
+  ++m_Count;
+
+  if (value <= std::numeric_limits<double>::min())
+  {
+    ++m_ZeroCount;
+    return;
+  }
+
+  ++m_Bins[static_cast<int>(std::ceil(std::log(value) / m_LogGamma))];
+
+  if (m_Bins.size() > m_MaximumNumberOfBins)
+  {
+    //merge the two lowest bins
+    auto lowest = m_Bins.begin();
+    auto second = std::next(lowest);
+    second->second += lowest->second;
+    m_Bins.erase(lowest);
+  }
+}
+
+double mitk::QuantileSketch::GetQuantile(double quantile) const
+{
+  if (m_Count == 0)
+    return 0.0;
+
+  quantile = std::min(1.0, std::max(0.0, quantile));
+  const unsigned long rank = std::min(m_Count - 1, static_cast<unsigned long>(quantile * m_Count));
+
+  if (rank < m_ZeroCount)
+    return 0.0;
+
+  unsigned long count = m_ZeroCount;
+  for (const auto& bin : m_Bins)
+  {
+    count += bin.second;
+    if (count > rank)
+    {
+      //all values in bin i lie in (gamma^(i-1), gamma^i], this estimate has a relative error below the accuracy
+      return 2.0 * std::pow(m_Gamma, bin.first) / (m_Gamma + 1.0);
+    }
+  }
+
+  return 2.0 * std::pow(m_Gamma, m_Bins.rbegin()->first) / (m_Gamma + 1.0);
+}
+
+unsigned long mitk::QuantileSketch::GetCount() const
+{
+  return m_Count;
+}
+
+void mitk::QuantileSketch::Clear()
+{
+  m_Bins.clear();
+  m_ZeroCount = 0;
+  m_Count = 0;
+}
+
+mitk::NavigationDataStatistics::NavigationDataStatistics(unsigned int slidingWindowSize,
+                                                         unsigned int maximumNumberOfStoredSamples)
+  : m_SlidingWindowSize(slidingWindowSize),
+    m_MaximumNumberOfStoredSamples(slidingWindowSize > 0 ? slidingWindowSize : maximumNumberOfStoredSamples)
+{
+  this->Reset();
+}
+
+void mitk::NavigationDataStatistics::Reset()
+{
+  m_NumberOfAddedSamples = 0;
+  m_StoredSamples.clear();
+  m_Positions.Clear();
+  m_Quaternions.Clear();
+  m_EulerAngles.Clear();
+  m_StreamedErrors.Clear();
+  m_StreamedErrorMin = std::numeric_limits<double>::max();
+  m_StreamedErrorMax = 0.0;
+  m_StreamedErrorQuantiles.Clear();
+}
+
+void mitk::NavigationDataStatistics::Add(const mitk::Point3D& position, const mitk::Quaternion& orientation)
+{
+  Sample sample;
+  sample.Position = position;
+  sample.Orientation = orientation;
+  sample.EulerAngles = ToEulerAngles(orientation);
+
+  ++m_NumberOfAddedSamples;
+  m_Positions.Add(ToArray(position));
+  m_Quaternions.Add(ToArray(orientation));
+  m_EulerAngles.Add(sample.EulerAngles);
+
+  m_StoredSamples.push_back(sample);
+  if (m_StoredSamples.size() > m_MaximumNumberOfStoredSamples)
+  {
+    if (m_SlidingWindowSize > 0)
+    {
+      const Sample& oldest = m_StoredSamples.front();
+      m_Positions.Remove(ToArray(oldest.Position));
+      m_Quaternions.Remove(ToArray(oldest.Orientation));
+      m_EulerAngles.Remove(oldest.EulerAngles);
+    }
+    m_StoredSamples.pop_front();
+  }
+
+  if (m_SlidingWindowSize > 0 || m_NumberOfAddedSamples < 2)
+    return;
+
+  //the first sample has no reference, all later ones are compared to the running mean
+  mitk::Point3D mean;
+  for (unsigned int i = 0; i < 3; ++i)
+    mean[i] = m_Positions.GetMean()[i];
+
+  const double error = mean.EuclideanDistanceTo(position);
+  m_StreamedErrors.Add({{error}});
+  m_StreamedErrorMin = std::min(m_StreamedErrorMin, error);
+  m_StreamedErrorMax = std::max(m_StreamedErrorMax, error);
+  m_StreamedErrorQuantiles.Add(error);
+}
+
+unsigned long mitk::NavigationDataStatistics::GetNumberOfSamples() const
+{
+  return m_Positions.GetCount();
+}
+
+unsigned long mitk::NavigationDataStatistics::GetNumberOfAddedSamples() const
+{
+  return m_NumberOfAddedSamples;
+}
+
+unsigned long mitk::NavigationDataStatistics::GetNumberOfStoredSamples() const
+{
+  return static_cast<unsigned long>(m_StoredSamples.size());
+}
+
+bool mitk::NavigationDataStatistics::IsPositionErrorStatisticExact() const
+{
+  return m_StoredSamples.size() == m_Positions.GetCount();
+}
+
+mitk::Point3D mitk::NavigationDataStatistics::GetPositionMean() const
+{
+  mitk::Point3D mean;
+  for (unsigned int i = 0; i < 3; ++i)
+    mean[i] = m_Positions.GetMean()[i];
+  return mean;
+}
+
+mitk::Vector3D mitk::NavigationDataStatistics::GetPositionStandardDeviation() const
+{
+  mitk::Vector3D result;
+  for (unsigned int i = 0; i < 3; ++i)
+    result[i] = std::sqrt(m_Positions.GetVariance(i));
+  return result;
+}
+
+mitk::Vector3D mitk::NavigationDataStatistics::GetPositionSampleStandardDeviation() const
+{
+  mitk::Vector3D result;
+  for (unsigned int i = 0; i < 3; ++i)
+    result[i] = std::sqrt(m_Positions.GetSampleVariance(i));
+  return result;
+}
+
+mitk::Quaternion mitk::NavigationDataStatistics::GetQuaternionMean() const
+{
+  mitk::Quaternion mean;
+  for (unsigned int i = 0; i < 4; ++i)
+    mean[i] = m_Quaternions.GetMean()[i];
+  return mean;
+}
+
+mitk::Quaternion mitk::NavigationDataStatistics::GetQuaternionStandardDeviation() const
+{
+  mitk::Quaternion result;
+  for (unsigned int i = 0; i < 4; ++i)
+    result[i] = std::sqrt(m_Quaternions.GetVariance(i));
+  return result;
+}
+
+mitk::Vector3D mitk::NavigationDataStatistics::GetEulerAnglesMean() const
+{
+  mitk::Vector3D mean;
+  for (unsigned int i = 0; i < 3; ++i)
+    mean[i] = m_EulerAngles.GetMean()[i];
+  return mean;
+}
+
+double mitk::NavigationDataStatistics::GetEulerAnglesRMS() const
+{
+  return std::sqrt(m_EulerAngles.GetTotalVariance());
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorMean() const
+{
+  if (!this->IsPositionErrorStatisticExact())
+    return m_StreamedErrors.GetMean()[0];
+
+  const std::vector<double> errors = this->GetStoredPositionErrors();
+  if (errors.empty())
+    return 0.0;
+
+  double sum = 0.0;
+  for (double error : errors)
+    sum += error;
+  return sum / errors.size();
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorStandardDeviation() const
+{
+  if (!this->IsPositionErrorStatisticExact())
+    return std::sqrt(m_StreamedErrors.GetVariance(0));
+
+  RunningMoments<1> moments;
+  for (double error : this->GetStoredPositionErrors())
+    moments.Add({{error}});
+  return std::sqrt(moments.GetVariance(0));
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorSampleStandardDeviation() const
+{
+  if (!this->IsPositionErrorStatisticExact())
+    return std::sqrt(m_StreamedErrors.GetSampleVariance(0));
+
+  RunningMoments<1> moments;
+  for (double error : this->GetStoredPositionErrors())
+    moments.Add({{error}});
+  return std::sqrt(moments.GetSampleVariance(0));
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorRMS() const
+{
+  //the mean squared distance to the mean is the sum of the variances, so this is exact in any case
+  return std::sqrt(m_Positions.GetTotalVariance());
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorMin() const
+{
+  if (!this->IsPositionErrorStatisticExact())
+    return m_StreamedErrorMin;
+
+  const std::vector<double> errors = this->GetStoredPositionErrors();
+  return errors.empty() ? 0.0 : *std::min_element(errors.begin(), errors.end());
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorMax() const
+{
+  if (!this->IsPositionErrorStatisticExact())
+    return m_StreamedErrorMax;
+
+  const std::vector<double> errors = this->GetStoredPositionErrors();
+  return errors.empty() ? 0.0 : *std::max_element(errors.begin(), errors.end());
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorMedian() const
+{
+  return this->GetPositionErrorPercentile(50.0);
+}
+
+double mitk::NavigationDataStatistics::GetPositionErrorPercentile(double percentile) const
+{
+  const double quantile = std::min(1.0, std::max(0.0, percentile / 100.0));
+
+  if (!this->IsPositionErrorStatisticExact())
+    return m_StreamedErrorQuantiles.GetQuantile(quantile);
+
+  std::vector<double> errors = this->GetStoredPositionErrors();
+  if (errors.empty())
+    return 0.0;
+
+  const std::size_t rank = std::min(errors.size() - 1, static_cast<std::size_t>(quantile * errors.size()));
+  std::nth_element(errors.begin(), errors.begin() + rank, errors.end());
+  return errors[rank];
+}
+
+bool mitk::NavigationDataStatistics::GetStoredSample(unsigned long i,
+                                                     mitk::Point3D& position,
+                                                     mitk::Quaternion& orientation) const
+{
+  const unsigned long firstStoredSample = m_NumberOfAddedSamples - m_StoredSamples.size();
+  if (i < firstStoredSample || i >= m_NumberOfAddedSamples)
+    return false;
+
+  position = m_StoredSamples[i - firstStoredSample].Position;
+  orientation = m_StoredSamples[i - firstStoredSample].Orientation;
+  return true;
+}
+
+std::vector<double> mitk::NavigationDataStatistics::GetStoredPositionErrors() const
+{
+  const mitk::Point3D mean = this->GetPositionMean();
+
+  std::vector<double> errors;
+  errors.reserve(m_StoredSamples.size());
+  for (const auto& sample : m_StoredSamples)
+    errors.push_back(mean.EuclideanDistanceTo(sample.Position));
+  return errors;
+}
+
+mitk::RunningMoments<3>::ValueType mitk::NavigationDataStatistics::ToArray(const mitk::Point3D& point)
+{
+  return {{point[0], point[1], point[2]}};
+}
+
+mitk::RunningMoments<4>::ValueType mitk::NavigationDataStatistics::ToArray(const mitk::Quaternion& quaternion)
+{
+  return {{quaternion[0], quaternion[1], quaternion[2], quaternion[3]}};
+}
+
+mitk::RunningMoments<3>::ValueType mitk::NavigationDataStatistics::ToEulerAngles(mitk::Quaternion quaternion)
+{
+  //must be normalized due to the documentation of the vnl method rotation_euler_angles()
+  quaternion.normalize();
+  const auto angles = quaternion.rotation_euler_angles();
+  return {{angles[0], angles[1], angles[2]}};
+}
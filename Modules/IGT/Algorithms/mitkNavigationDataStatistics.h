@@ -0,0 +1,246 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKNavigationDataStatistics_H_HEADER_INCLUDED_
+#define MITKNavigationDataStatistics_H_HEADER_INCLUDED_
+
+#include <MitkIGTExports.h>
+#include <mitkNavigationData.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace mitk {
+
+  /**Documentation
+  * \brief Running mean and variance of VDimension-dimensional values (Welford's algorithm).
+  *
+  * Values can also be removed again, which is used for sliding windows.
+  *
+  * \ingroup IGT
+  */
+  template <unsigned int VDimension>
+  class RunningMoments
+  {
+  public:
+    typedef std::array<double, VDimension> ValueType;
+
+    RunningMoments() { this->Clear(); }
+
+    void Clear()
+    {
+      m_Count = 0;
+      m_Mean.fill(0.0);
+      m_M2.fill(0.0);
+    }
+
+    void Add(const ValueType& value)
+    {
+      ++m_Count;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        const double delta = value[i] - m_Mean[i];
+        m_Mean[i] += delta / m_Count;
+        m_M2[i] += delta * (value[i] - m_Mean[i]);
+      }
+    }
+
+    /** @brief Removes a value that was added before. */
+    void Remove(const ValueType& value)
+    {
+      if (m_Count <= 1)
+      {
+        this->Clear();
+        return;
+      }
+
+      --m_Count;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        const double delta = value[i] - m_Mean[i];
+        m_Mean[i] -= delta / m_Count;
+        m_M2[i] = std::max(0.0, m_M2[i] - delta * (value[i] - m_Mean[i]));
+      }
+    }
+
+    unsigned long GetCount() const { return m_Count; }
+
+    const ValueType& GetMean() const { return m_Mean; }
+
+    /** @return Returns the population variance of component i, 0 if there are no values. */
+    double GetVariance(unsigned int i) const { return m_Count > 0 ? m_M2[i] / m_Count : 0.0; }
+
+    /** @return Returns the sample variance of component i, 0 if there are less than two values. */
+    double GetSampleVariance(unsigned int i) const { return m_Count > 1 ? m_M2[i] / (m_Count - 1) : 0.0; }
+
+    /** @return Returns the sum of the population variances, i.e. the mean squared distance to the mean. */
+    double GetTotalVariance() const
+    {
+      double result = 0.0;
+      for (unsigned int i = 0; i < VDimension; ++i)
+        result += this->GetVariance(i);
+      return result;
+    }
+
+  private:
+    unsigned long m_Count;
+    ValueType m_Mean;
+    ValueType m_M2;
+  };
+
+  /**Documentation
+  * \brief Streaming quantile estimate of non-negative values with a bounded number of bins.
+  *
+  * Values are counted in logarithmic bins, so every quantile is estimated with a relative
+  * error of at most the given relative accuracy. If there are more bins than allowed, the
+  * bins of the smallest values are merged, which only reduces the accuracy of the lowest
+  * quantiles.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT QuantileSketch
+  {
+  public:
+    explicit QuantileSketch(double relativeAccuracy = 0.005, unsigned int maximumNumberOfBins = 2048);
+
+    /** @brief Adds a value. Negative values are counted as zero. */
+    void Add(double value);
+
+    /**
+    * @return Returns an estimate of the value with rank floor(quantile * count) in the sorted list
+    *         of all added values, quantile is in [0, 1]. Returns 0 if no value was added.
+    */
+    double GetQuantile(double quantile) const;
+
+    unsigned long GetCount() const;
+
+    void Clear();
+
+  private:
+    double m_Gamma;
+    double m_LogGamma;
+    unsigned int m_MaximumNumberOfBins;
+    std::map<int, unsigned long> m_Bins;
+    unsigned long m_ZeroCount;
+    unsigned long m_Count;
+  };
+
+  /**Documentation
+  * \brief Online statistics of the positions and orientations of one tool.
+  *
+  * Means, standard deviations and RMS values of positions, quaternions and euler angles are
+  * running moments and cost O(1) per sample. The statistics of the position errors (the
+  * distances to the mean position) depend on the final mean, so they are computed from the
+  * stored samples as long as all samples in scope are stored. Only the most recent samples
+  * are stored, so the memory footprint is bounded:
+  *
+  *  - With a sliding window, the statistics cover the last slidingWindowSize samples, which
+  *    are all stored. All results equal the results of a batch computation over the window.
+  *  - Without a sliding window, the statistics cover all samples since the last Reset().
+  *    Once there are more than maximumNumberOfStoredSamples samples, the position errors are
+  *    measured against the running mean at the time each sample was added and their median
+  *    and percentiles are estimated with a QuantileSketch (see IsPositionErrorStatisticExact()).
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataStatistics
+  {
+  public:
+    /**
+    * @param slidingWindowSize Number of recent samples the statistics cover, 0 for all samples.
+    * @param maximumNumberOfStoredSamples Number of samples that are stored if there is no sliding window.
+    */
+    explicit NavigationDataStatistics(unsigned int slidingWindowSize = 0,
+                                      unsigned int maximumNumberOfStoredSamples = 10000);
+
+    void Add(const mitk::Point3D& position, const mitk::Quaternion& orientation);
+
+    void Reset();
+
+    /** @return Returns the number of samples the statistics cover. */
+    unsigned long GetNumberOfSamples() const;
+
+    /** @return Returns the number of samples added since the last Reset(). */
+    unsigned long GetNumberOfAddedSamples() const;
+
+    /** @return Returns the number of stored samples, these are the most recently added ones. */
+    unsigned long GetNumberOfStoredSamples() const;
+
+    /** @return Returns true if the position error statistics are computed from all samples in scope. */
+    bool IsPositionErrorStatisticExact() const;
+
+    mitk::Point3D GetPositionMean() const;
+    mitk::Vector3D GetPositionStandardDeviation() const;
+    mitk::Vector3D GetPositionSampleStandardDeviation() const;
+
+    mitk::Quaternion GetQuaternionMean() const;
+    mitk::Quaternion GetQuaternionStandardDeviation() const;
+
+    /** @return Returns the mean of the euler angles (theta_x, theta_y, theta_z) in radians. */
+    mitk::Vector3D GetEulerAnglesMean() const;
+    /** @return Returns the RMS of the distances of the euler angles to their mean in radians. */
+    double GetEulerAnglesRMS() const;
+
+    double GetPositionErrorMean() const;
+    double GetPositionErrorStandardDeviation() const;
+    double GetPositionErrorSampleStandardDeviation() const;
+    double GetPositionErrorRMS() const;
+    double GetPositionErrorMin() const;
+    double GetPositionErrorMax() const;
+    /** @return Returns the position error with rank floor(n / 2), the upper median for an even n. */
+    double GetPositionErrorMedian() const;
+    /** @return Returns the position error with rank floor(percentile / 100 * n), percentile is in [0, 100]. */
+    double GetPositionErrorPercentile(double percentile) const;
+
+    /**
+    * @brief Returns the i-th sample added since the last Reset().
+    * @return Returns false if this sample is not stored (anymore).
+    */
+    bool GetStoredSample(unsigned long i, mitk::Point3D& position, mitk::Quaternion& orientation) const;
+
+  private:
+    struct Sample
+    {
+      mitk::Point3D Position;
+      mitk::Quaternion Orientation;
+      RunningMoments<3>::ValueType EulerAngles;
+    };
+
+    static RunningMoments<3>::ValueType ToArray(const mitk::Point3D& point);
+    static RunningMoments<4>::ValueType ToArray(const mitk::Quaternion& quaternion);
+    static RunningMoments<3>::ValueType ToEulerAngles(mitk::Quaternion quaternion);
+
+    /** @brief Distances of all stored samples to the mean position, in the order of the samples. */
+    std::vector<double> GetStoredPositionErrors() const;
+
+    unsigned int m_SlidingWindowSize;
+    unsigned int m_MaximumNumberOfStoredSamples;
+    unsigned long m_NumberOfAddedSamples;
+
+    std::deque<Sample> m_StoredSamples;
+
+    RunningMoments<3> m_Positions;
+    RunningMoments<4> m_Quaternions;
+    RunningMoments<3> m_EulerAngles;
+
+    // position errors against the running mean, only used without sliding window
+    RunningMoments<1> m_StreamedErrors;
+    double m_StreamedErrorMin;
+    double m_StreamedErrorMax;
+    QuantileSketch m_StreamedErrorQuantiles;
+  };
+} // namespace mitk
+
+#endif /* MITKNavigationDataStatistics_H_HEADER_INCLUDED_ */
@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataSynchronizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  bool IsEarlier(const mitk::NavigationDataSample& sample, double igtTimeStamp)
+  {
+    return sample.IGTTimeStamp < igtTimeStamp;
+  }
+}
+
+mitk::NavigationDataSynchronizer::NavigationDataSynchronizer() : m_HistoryLength(2000.0)
+{
+}
+
+mitk::NavigationDataSynchronizer::~NavigationDataSynchronizer()
+{
+}
+
+void mitk::NavigationDataSynchronizer::AddSample(const NavigationDataSample& sample)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (sample.ToolIndex >= m_Histories.size())
+    m_Histories.resize(sample.ToolIndex + 1);
+
+  HistoryType& history = m_Histories[sample.ToolIndex];
+
+  //samples of one tool usually arrive in order, so this is an append in almost all cases
+  if (history.empty() || history.back().IGTTimeStamp <= sample.IGTTimeStamp)
+    history.push_back(sample);
+  else
+    history.insert(std::lower_bound(history.begin(), history.end(), sample.IGTTimeStamp, IsEarlier), sample);
+
+  const double oldestTimeStamp = history.back().IGTTimeStamp - m_HistoryLength;
+  while (history.size() > 2 && history[1].IGTTimeStamp <= oldestTimeStamp)
+    history.pop_front();
+}
+
+bool mitk::NavigationDataSynchronizer::GetNavigationDataAt(unsigned int toolIndex,
+                                                          double igtTimeStamp,
+                                                          NavigationData* result) const
+{
+  if (result == nullptr)
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (toolIndex >= m_Histories.size())
+    return false;
+
+  const HistoryType& history = m_Histories[toolIndex];
+  if (history.empty() || igtTimeStamp < history.front().IGTTimeStamp || igtTimeStamp > history.back().IGTTimeStamp)
+    return false;
+
+  auto after = std::lower_bound(history.begin(), history.end(), igtTimeStamp, IsEarlier);
+  auto before = after == history.begin() ? after : after - 1;
+
+  double weight = 1.0;
+  if (after->IGTTimeStamp > before->IGTTimeStamp)
+    weight = (igtTimeStamp - before->IGTTimeStamp) / (after->IGTTimeStamp - before->IGTTimeStamp);
+
+  NavigationData::PositionType position;
+  for (unsigned int i = 0; i < 3; ++i)
+    position[i] = before->Position[i] + weight * (after->Position[i] - before->Position[i]);
+
+  result->SetPosition(position);
+  result->SetOrientation(Slerp(before->Orientation, after->Orientation, weight));
+  const double trackingError = before->TrackingError + weight * (after->TrackingError - before->TrackingError);
+  result->SetPositionAccuracy(trackingError);
+  result->SetOrientationAccuracy(trackingError);
+  result->SetDataValid(before->DataValid && after->DataValid);
+  result->SetIGTTimeStamp(igtTimeStamp);
+
+  return true;
+}
+
+bool mitk::NavigationDataSynchronizer::GetTimeRange(unsigned int toolIndex, double& oldest, double& newest) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (toolIndex >= m_Histories.size() || m_Histories[toolIndex].empty())
+    return false;
+
+  oldest = m_Histories[toolIndex].front().IGTTimeStamp;
+  newest = m_Histories[toolIndex].back().IGTTimeStamp;
+  return true;
+}
+
+void mitk::NavigationDataSynchronizer::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Histories.clear();
+}
+
+mitk::NavigationData::OrientationType mitk::NavigationDataSynchronizer::Slerp(
+  const NavigationData::OrientationType& a, const NavigationData::OrientationType& b, double weight)
+{
+  double dot = a.x() * b.x() + a.y() * b.y() + a.z() * b.z() + a.r() * b.r();
+
+  //q and -q describe the same rotation, take the shorter arc
+  double sign = 1.0;
+  if (dot < 0.0)
+  {
+    dot = -dot;
+    sign = -1.0;
+  }
+
+  double weightA = 1.0 - weight;
+  double weightB = weight;
+
+  //for nearly identical orientations the linear interpolation is accurate and avoids dividing by sin(0)
+  if (dot < 0.9995)
+  {
+    const double angle = std::acos(dot);
+    const double sinAngle = std::sin(angle);
+    weightA = std::sin((1.0 - weight) * angle) / sinAngle;
+    weightB = std::sin(weight * angle) / sinAngle;
+  }
+  weightB *= sign;
+
+  NavigationData::OrientationType result(weightA * a.x() + weightB * b.x(),
+                                         weightA * a.y() + weightB * b.y(),
+                                         weightA * a.z() + weightB * b.z(),
+                                         weightA * a.r() + weightB * b.r());
+  result.normalize();
+  return result;
+}
@@ -0,0 +1,98 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKNAVIGATIONDATASYNCHRONIZER_H_HEADER_INCLUDED_
+#define MITKNAVIGATIONDATASYNCHRONIZER_H_HEADER_INCLUDED_
+
+#include <MitkIGTExports.h>
+#include <mitkNavigationDataRingBuffer.h>
+
+#include <itkObject.h>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace mitk
+{
+  /**Documentation
+  * \brief Keeps a short history of tool poses and interpolates them to arbitrary timestamps
+  *
+  * Data from different devices (e.g. a tracking device and an ultrasound device) is
+  * acquired at different rates. If all devices stamp their data with mitk::IGTTimeStamp,
+  * GetNavigationDataAt() returns the pose of a tool at the time an image was acquired:
+  * the position is interpolated linearly, the orientation by spherical linear interpolation
+  * between the two samples that enclose the requested timestamp. Timestamps outside the
+  * recorded history are not extrapolated.
+  *
+  * Samples are added by a mitk::TrackingDevicePushSource on its pipeline thread, all
+  * methods are thread safe.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataSynchronizer : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataSynchronizer, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Sets how long samples are kept, in milliseconds. Default is 2000 ms.
+    */
+    itkSetMacro(HistoryLength, double);
+    itkGetConstMacro(HistoryLength, double);
+
+    /**
+    * \brief Adds a sample to the history of its tool and discards samples older than the history length.
+    */
+    void AddSample(const NavigationDataSample& sample);
+
+    /**
+    * \brief Interpolates the pose of a tool at the given timestamp (in milliseconds).
+    *
+    * \return Returns false and leaves result unchanged if the timestamp lies outside of the
+    *         recorded history of the tool. The result is marked invalid if one of the enclosing
+    *         samples is invalid.
+    */
+    bool GetNavigationDataAt(unsigned int toolIndex, double igtTimeStamp, NavigationData* result) const;
+
+    /**
+    * \return Returns the time span [oldest, newest] covered by the history of a tool.
+    *         Returns false if there are no samples for this tool.
+    */
+    bool GetTimeRange(unsigned int toolIndex, double& oldest, double& newest) const;
+
+    /**
+    * \brief Removes all samples.
+    */
+    void Clear();
+
+    /**
+    * \brief Spherical linear interpolation between the orientations a (weight = 0) and b (weight = 1).
+    */
+    static NavigationData::OrientationType Slerp(const NavigationData::OrientationType& a,
+                                                 const NavigationData::OrientationType& b,
+                                                 double weight);
+
+  protected:
+    NavigationDataSynchronizer();
+    ~NavigationDataSynchronizer() override;
+
+    typedef std::deque<NavigationDataSample> HistoryType;
+
+    std::vector<HistoryType> m_Histories; ///< time sorted samples, one history per tool index
+    double m_HistoryLength;
+    mutable std::mutex m_Mutex;
+  };
+} // namespace mitk
+
+#endif /* MITKNAVIGATIONDATASYNCHRONIZER_H_HEADER_INCLUDED_ */
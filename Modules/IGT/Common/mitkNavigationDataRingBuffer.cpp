@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataRingBuffer.h"
+
+#include <chrono>
+
+mitk::NavigationDataRingBuffer::NavigationDataRingBuffer(unsigned int capacity)
+  : m_Mask(0), m_Head(0), m_Tail(0), m_NumberOfDroppedSamples(0), m_WakeUpRequested(false)
+{
+  std::size_t size = 2;
+  while (size < capacity)
+    size *= 2;
+
+  m_Samples.resize(size);
+  m_Mask = size - 1;
+}
+
+mitk::NavigationDataRingBuffer::~NavigationDataRingBuffer()
+{
+}
+
+bool mitk::NavigationDataRingBuffer::Push(const NavigationDataSample &sample)
+{
+  const std::size_t head = m_Head.load(std::memory_order_relaxed);
+
+  if (head - m_Tail.load(std::memory_order_acquire) > m_Mask)
+  {
+    m_NumberOfDroppedSamples.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  m_Samples[head & m_Mask] = sample;
+  m_Head.store(head + 1, std::memory_order_release);
+
+  // A consumer in WaitForSamples() checks for samples and starts waiting while it holds the mutex. Taking the mutex
+  // once here makes sure that the notification does not fall between these two steps and get lost.
+  {
+    std::lock_guard<std::mutex> lock(m_WaitMutex);
+  }
+  m_SamplesAvailable.notify_one();
+  return true;
+}
+
+bool mitk::NavigationDataRingBuffer::Pop(NavigationDataSample &sample)
+{
+  const std::size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+  if (tail == m_Head.load(std::memory_order_acquire))
+    return false;
+
+  sample = m_Samples[tail & m_Mask];
+  m_Tail.store(tail + 1, std::memory_order_release);
+
+  return true;
+}
+
+bool mitk::NavigationDataRingBuffer::WaitForSamples(unsigned int timeoutInMilliseconds)
+{
+  if (!this->IsEmpty())
+    return true;
+
+  std::unique_lock<std::mutex> lock(m_WaitMutex);
+  m_SamplesAvailable.wait_for(lock, std::chrono::milliseconds(timeoutInMilliseconds), [this] {
+    return m_WakeUpRequested || !this->IsEmpty();
+  });
+  m_WakeUpRequested = false;
+
+  return !this->IsEmpty();
+}
+
+void mitk::NavigationDataRingBuffer::WakeUp()
+{
+  std::lock_guard<std::mutex> lock(m_WaitMutex);
+  m_WakeUpRequested = true;
+  m_SamplesAvailable.notify_all();
+}
+
+bool mitk::NavigationDataRingBuffer::IsEmpty() const
+{
+  return m_Tail.load(std::memory_order_acquire) == m_Head.load(std::memory_order_acquire);
+}
+
+unsigned int mitk::NavigationDataRingBuffer::GetCapacity() const
+{
+  return static_cast<unsigned int>(m_Samples.size());
+}
+
+unsigned long mitk::NavigationDataRingBuffer::GetNumberOfDroppedSamples() const
+{
+  return m_NumberOfDroppedSamples.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKNAVIGATIONDATARINGBUFFER_H_HEADER_INCLUDED_
+#define MITKNAVIGATIONDATARINGBUFFER_H_HEADER_INCLUDED_
+
+#include <MitkIGTExports.h>
+#include <mitkCommon.h>
+#include <mitkNavigationData.h>
+
+#include <itkObject.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace mitk
+{
+  /**Documentation
+  * \brief Pose of one tool at one point in time, as published by a tracking device.
+  *
+  * Unlike mitk::NavigationData this is a plain value type, so it can be copied into a
+  * mitk::NavigationDataRingBuffer without allocations.
+  *
+  * \ingroup IGT
+  */
+  struct NavigationDataSample
+  {
+    unsigned int ToolIndex = 0;                  ///< index of the tool in the tracking device
+    NavigationData::PositionType Position;       ///< position in tracking device coordinates
+    NavigationData::OrientationType Orientation; ///< orientation in tracking device coordinates
+    double TrackingError = 0.0;                  ///< tracking error reported by the tool
+    bool DataValid = false;                      ///< true if the tool delivered valid data
+    double IGTTimeStamp = 0.0;                   ///< time of the measurement in ms, see mitk::IGTTimeStamp
+  };
+
+  /**Documentation
+  * \brief Single producer / single consumer queue of navigation data samples
+  *
+  * Tracking devices push samples from their tracking thread with Push(), a
+  * mitk::TrackingDevicePushSource pops them on its pipeline thread with Pop(). The
+  * slots are exchanged lock-free. If the consumer does not keep up, Push() drops the
+  * new sample and counts it in GetNumberOfDroppedSamples().
+  *
+  * WaitForSamples() lets the consumer sleep until new samples arrive. To wake it up,
+  * Push() briefly locks the mutex the consumer waits on before it notifies, so no
+  * notification is missed. The producer only contends for this short section with a
+  * consumer that is about to wait or has just woken up.
+  *
+  * \warning Only one thread may call Push() and only one thread may call Pop().
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT NavigationDataRingBuffer : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataRingBuffer, itk::Object);
+    mitkNewMacro1Param(Self, unsigned int);
+
+    /**
+    * \brief Appends a sample. Returns false and drops the sample if the buffer is full.
+    */
+    bool Push(const NavigationDataSample &sample);
+
+    /**
+    * \brief Removes the oldest sample. Returns false if the buffer is empty.
+    */
+    bool Pop(NavigationDataSample &sample);
+
+    /**
+    * \brief Blocks until the buffer contains samples or timeoutInMilliseconds elapsed.
+    * \return Returns true if samples are available.
+    */
+    bool WaitForSamples(unsigned int timeoutInMilliseconds);
+
+    /**
+    * \brief Wakes up a consumer that waits in WaitForSamples(), e.g. to let it terminate.
+    */
+    void WakeUp();
+
+    bool IsEmpty() const;
+
+    /**
+    * \return Returns the number of samples that can be stored, which is the
+    *         requested capacity rounded up to a power of two.
+    */
+    unsigned int GetCapacity() const;
+
+    /**
+    * \return Returns the number of samples that were dropped because the buffer was full.
+    */
+    unsigned long GetNumberOfDroppedSamples() const;
+
+  protected:
+    explicit NavigationDataRingBuffer(unsigned int capacity);
+    ~NavigationDataRingBuffer() override;
+
+    std::vector<NavigationDataSample> m_Samples;
+    std::size_t m_Mask;
+
+    std::atomic<std::size_t> m_Head; ///< next slot to write, only written by the producer
+    std::atomic<std::size_t> m_Tail; ///< next slot to read, only written by the consumer
+    std::atomic<unsigned long> m_NumberOfDroppedSamples;
+
+    std::mutex m_WaitMutex;
+    std::condition_variable m_SamplesAvailable;
+    bool m_WakeUpRequested; ///< set by WakeUp(), guarded by m_WaitMutex
+  };
+} // namespace mitk
+
+#endif /* MITKNAVIGATIONDATARINGBUFFER_H_HEADER_INCLUDED_ */
@@ -0,0 +1,245 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTrackingDevicePushSource.h"
+
+#include "mitkIGTException.h"
+#include "mitkIGTTimeStamp.h"
+
+#include <algorithm>
+
+mitk::TrackingDevicePushSource::TrackingDevicePushSource()
+  : mitk::TrackingDeviceSource(),
+    m_RingBuffer(NavigationDataRingBuffer::New(1024)),
+    m_Synchronizer(NavigationDataSynchronizer::New()),
+    m_StopPipeline(false),
+    m_WaitTimeout(100),
+    m_LatencySum(0.0),
+    m_MaximumLatency(0.0),
+    m_NumberOfProcessedSamples(0)
+{
+}
+
+mitk::TrackingDevicePushSource::~TrackingDevicePushSource()
+{
+  this->StopPipeline();
+
+  if (m_TrackingDevice.IsNotNull() && m_TrackingDevice->GetState() != mitk::TrackingDevice::Tracking)
+    m_TrackingDevice->RemoveNavigationDataRingBuffer(m_RingBuffer);
+}
+
+void mitk::TrackingDevicePushSource::SetTrackingDevice(mitk::TrackingDevice* td)
+{
+  if (this->IsPipelineRunning())
+    mitkThrowException(mitk::IGTException) << "The tracking device cannot be changed while the pipeline is running.";
+  if (td != nullptr && td->GetState() == mitk::TrackingDevice::Tracking)
+    mitkThrowException(mitk::IGTException) << "The tracking device must not be tracking when it is set.";
+
+  if (m_TrackingDevice.IsNotNull())
+    m_TrackingDevice->RemoveNavigationDataRingBuffer(m_RingBuffer);
+
+  Superclass::SetTrackingDevice(td);
+
+  if (td != nullptr)
+    td->AddNavigationDataRingBuffer(m_RingBuffer);
+
+  std::lock_guard<std::mutex> lock(m_SamplesMutex);
+  m_LatestSamples.assign(this->GetNumberOfIndexedOutputs(), NavigationDataSample());
+  m_HasSample.assign(this->GetNumberOfIndexedOutputs(), false);
+  m_Synchronizer->Clear();
+}
+
+void mitk::TrackingDevicePushSource::AddPipelineFilter(mitk::NavigationDataSource* filter)
+{
+  if (this->IsPipelineRunning())
+    mitkThrowException(mitk::IGTException) << "Filters cannot be added while the pipeline is running.";
+
+  if (filter == nullptr)
+    return;
+
+  if (std::find(m_PipelineFilters.begin(), m_PipelineFilters.end(), filter) == m_PipelineFilters.end())
+    m_PipelineFilters.push_back(filter);
+}
+
+void mitk::TrackingDevicePushSource::RemovePipelineFilter(mitk::NavigationDataSource* filter)
+{
+  if (this->IsPipelineRunning())
+    mitkThrowException(mitk::IGTException) << "Filters cannot be removed while the pipeline is running.";
+
+  m_PipelineFilters.erase(std::remove(m_PipelineFilters.begin(), m_PipelineFilters.end(), filter),
+                          m_PipelineFilters.end());
+}
+
+void mitk::TrackingDevicePushSource::StartPipeline()
+{
+  if (this->IsPipelineRunning())
+    return;
+
+  m_StopPipeline = false;
+  m_PipelineThread = std::thread(&TrackingDevicePushSource::RunPipeline, this);
+}
+
+void mitk::TrackingDevicePushSource::StopPipeline()
+{
+  if (!this->IsPipelineRunning())
+    return;
+
+  m_StopPipeline = true;
+  m_RingBuffer->WakeUp();
+  m_PipelineThread.join();
+}
+
+bool mitk::TrackingDevicePushSource::IsPipelineRunning() const
+{
+  return m_PipelineThread.joinable();
+}
+
+mitk::NavigationDataSynchronizer* mitk::TrackingDevicePushSource::GetSynchronizer() const
+{
+  return m_Synchronizer;
+}
+
+mitk::NavigationDataRingBuffer* mitk::TrackingDevicePushSource::GetRingBuffer() const
+{
+  return m_RingBuffer;
+}
+
+double mitk::TrackingDevicePushSource::GetMeanLatency() const
+{
+  std::lock_guard<std::mutex> lock(m_StatisticsMutex);
+  return m_NumberOfProcessedSamples > 0 ? m_LatencySum / m_NumberOfProcessedSamples : 0.0;
+}
+
+double mitk::TrackingDevicePushSource::GetMaximumLatency() const
+{
+  std::lock_guard<std::mutex> lock(m_StatisticsMutex);
+  return m_MaximumLatency;
+}
+
+unsigned long mitk::TrackingDevicePushSource::GetNumberOfProcessedSamples() const
+{
+  std::lock_guard<std::mutex> lock(m_StatisticsMutex);
+  return m_NumberOfProcessedSamples;
+}
+
+void mitk::TrackingDevicePushSource::ResetLatencyStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_StatisticsMutex);
+  m_LatencySum = 0.0;
+  m_MaximumLatency = 0.0;
+  m_NumberOfProcessedSamples = 0;
+}
+
+void mitk::TrackingDevicePushSource::GenerateData()
+{
+  std::lock_guard<std::mutex> lock(m_SamplesMutex);
+
+  // UpdateOutputInformation() creates outputs for tools that were added after the tracking device was set
+  const unsigned int numberOfOutputs = this->GetNumberOfIndexedOutputs();
+  if (m_LatestSamples.size() < numberOfOutputs)
+  {
+    m_LatestSamples.resize(numberOfOutputs);
+    m_HasSample.resize(numberOfOutputs, false);
+  }
+
+  for (unsigned int i = 0; i < numberOfOutputs; ++i)
+  {
+    mitk::NavigationData* nd = this->GetOutput(i);
+    assert(nd);
+
+    if (!m_HasSample[i] || !m_LatestSamples[i].DataValid)
+    {
+      nd->SetDataValid(false);
+      continue;
+    }
+
+    const NavigationDataSample& sample = m_LatestSamples[i];
+    nd->SetDataValid(true);
+    nd->SetPosition(sample.Position);
+    nd->SetOrientation(sample.Orientation);
+    nd->SetOrientationAccuracy(sample.TrackingError);
+    nd->SetPositionAccuracy(sample.TrackingError);
+    nd->SetIGTTimeStamp(sample.IGTTimeStamp);
+  }
+}
+
+void mitk::TrackingDevicePushSource::UpdatePipelineFilters()
+{
+  if (m_PipelineFilters.empty())
+  {
+    this->Update();
+    return;
+  }
+
+  for (const auto& filter : m_PipelineFilters)
+    filter->Update();
+}
+
+void mitk::TrackingDevicePushSource::RunPipeline()
+{
+  std::vector<NavigationDataSample> batch;
+  batch.reserve(m_RingBuffer->GetCapacity());
+
+  while (!m_StopPipeline)
+  {
+    if (!m_RingBuffer->WaitForSamples(m_WaitTimeout))
+      continue;
+
+    batch.clear();
+    NavigationDataSample sample;
+    while (m_RingBuffer->Pop(sample))
+      batch.push_back(sample);
+
+    {
+      std::lock_guard<std::mutex> lock(m_SamplesMutex);
+      for (const auto& s : batch)
+      {
+        // keep samples of tools whose outputs are not created yet, GenerateData() only reads the existing outputs
+        if (s.ToolIndex >= m_LatestSamples.size())
+        {
+          m_LatestSamples.resize(s.ToolIndex + 1);
+          m_HasSample.resize(s.ToolIndex + 1, false);
+        }
+
+        m_LatestSamples[s.ToolIndex] = s;
+        m_HasSample[s.ToolIndex] = true;
+      }
+    }
+
+    for (const auto& s : batch)
+      m_Synchronizer->AddSample(s);
+
+    this->Modified();
+    try
+    {
+      this->UpdatePipelineFilters();
+    }
+    catch (const std::exception& e)
+    {
+      MITK_ERROR << "Error while updating the navigation pipeline: " << e.what();
+      continue;
+    }
+
+    const double now = mitk::IGTTimeStamp::GetInstance()->GetElapsed();
+    if (now < 0)
+      continue;
+
+    std::lock_guard<std::mutex> lock(m_StatisticsMutex);
+    for (const auto& s : batch)
+    {
+      const double latency = std::max(0.0, now - s.IGTTimeStamp);
+      m_LatencySum += latency;
+      m_MaximumLatency = std::max(m_MaximumLatency, latency);
+      ++m_NumberOfProcessedSamples;
+    }
+  }
+}
@@ -0,0 +1,154 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKTRACKINGDEVICEPUSHSOURCE_H_HEADER_INCLUDED_
+#define MITKTRACKINGDEVICEPUSHSOURCE_H_HEADER_INCLUDED_
+
+#include "mitkTrackingDeviceSource.h"
+#include "mitkNavigationDataRingBuffer.h"
+#include "mitkNavigationDataSynchronizer.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk {
+  /**Documentation
+  * \brief Tracking device source that drives its navigation pipeline as soon as new data arrives
+  *
+  * A TrackingDeviceSource is updated when a consumer pulls, usually from a GUI timer, so the
+  * latency of the navigation data depends on the timer rate. This source registers a
+  * mitk::NavigationDataRingBuffer with its tracking device instead. The tracking thread of
+  * the device publishes every new tool pose into this buffer and a dedicated pipeline thread,
+  * started with StartPipeline(), wakes up, copies the newest pose of each tool to the outputs
+  * and updates all filters added with AddPipelineFilter().
+  *
+  * All published samples are also added to a mitk::NavigationDataSynchronizer, which
+  * interpolates the tool poses to the timestamps of data from other devices, e.g. images.
+  *
+  * The latency statistics measure the time from the mitk::IGTTimeStamp of a sample to the
+  * end of the filter updates it triggered.
+  *
+  * \warning The ring buffer can only be attached while the device is not tracking, so
+  * SetTrackingDevice() must be called before tracking is started. While the pipeline runs,
+  * the pipeline filters are updated on the pipeline thread and must not be updated from
+  * other threads. Observe itk::EndEvent of a pipeline filter to be notified about new data.
+  * Only devices that call TrackingDevice::PublishToolSamples() (e.g. mitk::VirtualTrackingDevice)
+  * can drive this source.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGT_EXPORT TrackingDevicePushSource : public TrackingDeviceSource
+  {
+  public:
+    mitkClassMacro(TrackingDevicePushSource, TrackingDeviceSource);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Sets the tracking device and registers the ring buffer of this source with it.
+    * @throw mitk::IGTException Throws an exception if the pipeline is running or the device is tracking.
+    */
+    void SetTrackingDevice(mitk::TrackingDevice* td) override;
+
+    /**
+    * \brief Adds a filter that is updated on the pipeline thread whenever new samples arrive.
+    *
+    * Usually these are the last filters of the navigation pipelines connected to this source.
+    * If no filter is added, only the outputs of this source are updated.
+    * @throw mitk::IGTException Throws an exception if the pipeline is running.
+    */
+    void AddPipelineFilter(mitk::NavigationDataSource* filter);
+
+    /**
+    * \brief Removes a filter that was added with AddPipelineFilter().
+    * @throw mitk::IGTException Throws an exception if the pipeline is running.
+    */
+    void RemovePipelineFilter(mitk::NavigationDataSource* filter);
+
+    /**
+    * \brief Starts the pipeline thread. Does nothing if it is already running.
+    */
+    void StartPipeline();
+
+    /**
+    * \brief Stops the pipeline thread and waits until it has finished.
+    */
+    void StopPipeline();
+
+    bool IsPipelineRunning() const;
+
+    /**
+    * \brief Returns the synchronizer that records all samples of the tracking device.
+    */
+    mitk::NavigationDataSynchronizer* GetSynchronizer() const;
+
+    /**
+    * \brief Returns the ring buffer that is registered with the tracking device.
+    */
+    mitk::NavigationDataRingBuffer* GetRingBuffer() const;
+
+    /**
+    * \brief Sets the maximum time in milliseconds the pipeline thread sleeps without new data
+    *        before it checks whether it should stop. Default is 100 ms.
+    */
+    itkSetMacro(WaitTimeout, unsigned int);
+    itkGetConstMacro(WaitTimeout, unsigned int);
+
+    ///@{
+    /**
+    * \brief Latency statistics in milliseconds and the number of samples they are based on.
+    */
+    double GetMeanLatency() const;
+    double GetMaximumLatency() const;
+    unsigned long GetNumberOfProcessedSamples() const;
+    void ResetLatencyStatistics();
+    ///@}
+
+  protected:
+    TrackingDevicePushSource();
+    ~TrackingDevicePushSource() override;
+
+    /**
+    * \brief Copies the newest published sample of each tool to the outputs.
+    */
+    void GenerateData() override;
+
+    /**
+    * \brief Main loop of the pipeline thread.
+    */
+    void RunPipeline();
+
+    /**
+    * \brief Updates the pipeline filters, or this source if there are none.
+    */
+    void UpdatePipelineFilters();
+
+    NavigationDataRingBuffer::Pointer m_RingBuffer;
+    NavigationDataSynchronizer::Pointer m_Synchronizer;
+    std::vector<NavigationDataSource::Pointer> m_PipelineFilters;
+
+    std::vector<NavigationDataSample> m_LatestSamples; ///< newest sample of each tool, guarded by m_SamplesMutex
+    std::vector<bool> m_HasSample;
+    std::mutex m_SamplesMutex;
+
+    std::thread m_PipelineThread;
+    std::atomic<bool> m_StopPipeline;
+    unsigned int m_WaitTimeout;
+
+    double m_LatencySum;
+    double m_MaximumLatency;
+    unsigned long m_NumberOfProcessedSamples;
+    mutable std::mutex m_StatisticsMutex;
+  };
+} // namespace mitk
+#endif /* MITKTRACKINGDEVICEPUSHSOURCE_H_HEADER_INCLUDED_ */
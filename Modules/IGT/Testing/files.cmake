@@ -45,8 +45,10 @@ set(MODULE_TESTS
    # mitkNavigationDataPlayerTest.cpp # random fails see bug 16485.
    # We decided to won't fix because of complete restructuring via bug 15959.
    mitkTrackingDeviceSourceTest.cpp
+   mitkTrackingDevicePushSourceTest.cpp
    mitkTrackingDeviceSourceConfiguratorTest.cpp
    mitkNavigationDataEvaluationFilterTest.cpp
+   mitkNavigationDataStatisticsTest.cpp
    mitkTrackingTypesTest.cpp
    mitkOpenIGTLinkTrackingDeviceTest.cpp
    # ------------------ Navigation Tool Management Tests -------------------
@@ -136,6 +136,32 @@ static void TestComplexCase()
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(myNavigationDataEvaluationFilter->GetNumberOfAnalysedNavigationData(0),0),".. Testing ResetStatistic");
 
     }
+
+static void TestLoggedSamples()
+    {
+    MITK_TEST_OUTPUT(<< "Starting logged samples test case...");
+    mitk::NavigationData::Pointer testData = mitk::NavigationData::New();
+    testData->SetDataValid(true);
+    mitk::NavigationDataEvaluationFilter::Pointer myNavigationDataEvaluationFilter = mitk::NavigationDataEvaluationFilter::New();
+    myNavigationDataEvaluationFilter->SetInput(testData);
+    myNavigationDataEvaluationFilter->SetMaximumNumberOfStoredSamples(2);
+
+    mitk::Point3D test;
+    test.Fill(0);
+    for (int i = 1; i <= 3; ++i)
+    {
+      test[0] = i;
+      testData->SetPosition(test);
+      myNavigationDataEvaluationFilter->Update();
+    }
+
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetNumberOfAnalysedNavigationData(0)==3,".. Testing GetNumberOfAnalysedNavigationData");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetNumberOfLoggedNavigationData(0)==2,".. Testing GetNumberOfLoggedNavigationData");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetLoggedPosition(0,0)[0]==2,".. Testing GetLoggedPosition of the oldest logged sample");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetLoggedPosition(1,0)[0]==3,".. Testing GetLoggedPosition of the newest logged sample");
+    MITK_TEST_CONDITION_REQUIRED(myNavigationDataEvaluationFilter->GetLoggedPosition(2,0)[0]==0,".. Testing GetLoggedPosition beyond the logged samples");
+    MITK_TEST_CONDITION_REQUIRED(!myNavigationDataEvaluationFilter->IsPositionErrorStatisticExact(0),".. Testing IsPositionErrorStatisticExact");
+    }
 };
 
 /**
@@ -149,6 +175,7 @@ int mitkNavigationDataEvaluationFilterTest(int /* argc */, char* /*argv*/[])
   NavigationDataEvaluationFilterTestClass::TestInstantiation();
   NavigationDataEvaluationFilterTestClass::TestSimpleCase();
   NavigationDataEvaluationFilterTestClass::TestComplexCase();
+  NavigationDataEvaluationFilterTestClass::TestLoggedSamples();
 
   // always end with this!
   MITK_TEST_END()
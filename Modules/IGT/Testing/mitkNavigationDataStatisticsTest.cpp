@@ -0,0 +1,183 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+//Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkNavigationDataStatistics.h"
+#include "mitkPointSetStatisticsCalculator.h"
+
+//Std includes
+#include <algorithm>
+#include <random>
+
+class mitkNavigationDataStatisticsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNavigationDataStatisticsTestSuite);
+
+  MITK_TEST(AllSamples_MatchesBatchComputation);
+  MITK_TEST(SlidingWindow_MatchesBatchComputationOverWindow);
+  MITK_TEST(MoreSamplesThanStored_EstimatesErrorStatistics);
+  MITK_TEST(QuantileSketch_RelativeAccuracy);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::vector<mitk::Point3D> m_Positions;
+  mitk::Quaternion m_Orientation;
+
+  void AssertEqualsBatchComputation(const mitk::NavigationDataStatistics& statistics,
+                                    const std::vector<mitk::Point3D>& positions)
+  {
+    auto pointSet = mitk::PointSet::New();
+    for (unsigned int i = 0; i < positions.size(); ++i)
+      pointSet->InsertPoint(i, positions[i]);
+    auto calculator = mitk::PointSetStatisticsCalculator::New(pointSet);
+
+    CPPUNIT_ASSERT(statistics.IsPositionErrorStatisticExact());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long>(positions.size()), statistics.GetNumberOfSamples());
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionMean()[i], statistics.GetPositionMean()[i], 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionStandardDeviation()[i],
+                                   statistics.GetPositionStandardDeviation()[i], 1e-9);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionSampleStandardDeviation()[i],
+                                   statistics.GetPositionSampleStandardDeviation()[i], 1e-9);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorMean(), statistics.GetPositionErrorMean(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorRMS(), statistics.GetPositionErrorRMS(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorStandardDeviation(),
+                                 statistics.GetPositionErrorStandardDeviation(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorSampleStandardDeviation(),
+                                 statistics.GetPositionErrorSampleStandardDeviation(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorMedian(), statistics.GetPositionErrorMedian(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorMin(), statistics.GetPositionErrorMin(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(calculator->GetPositionErrorMax(), statistics.GetPositionErrorMax(), 1e-9);
+  }
+
+public:
+
+  void setUp() override
+  {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0.0, 0.3);
+
+    m_Positions.clear();
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+      mitk::Point3D position;
+      mitk::FillVector3D(position, 10.0 + noise(generator), -3.0 + noise(generator), noise(generator));
+      m_Positions.push_back(position);
+    }
+
+    m_Orientation = mitk::Quaternion(0.0, 0.0, 0.0, 1.0);
+  }
+
+  void tearDown() override
+  {
+    m_Positions.clear();
+  }
+
+  void AllSamples_MatchesBatchComputation()
+  {
+    mitk::NavigationDataStatistics statistics;
+    for (const auto& position : m_Positions)
+      statistics.Add(position, m_Orientation);
+
+    this->AssertEqualsBatchComputation(statistics, m_Positions);
+
+    statistics.Reset();
+    CPPUNIT_ASSERT_EQUAL(0ul, statistics.GetNumberOfSamples());
+  }
+
+  void SlidingWindow_MatchesBatchComputationOverWindow()
+  {
+    const unsigned int windowSize = 300;
+    mitk::NavigationDataStatistics statistics(windowSize);
+    for (const auto& position : m_Positions)
+      statistics.Add(position, m_Orientation);
+
+    const std::vector<mitk::Point3D> window(m_Positions.end() - windowSize, m_Positions.end());
+    this->AssertEqualsBatchComputation(statistics, window);
+
+    mitk::Point3D position;
+    mitk::Quaternion orientation;
+    CPPUNIT_ASSERT(!statistics.GetStoredSample(m_Positions.size() - windowSize - 1, position, orientation));
+    CPPUNIT_ASSERT(statistics.GetStoredSample(m_Positions.size() - windowSize, position, orientation));
+    CPPUNIT_ASSERT_EQUAL(window.front(), position);
+  }
+
+  void MoreSamplesThanStored_EstimatesErrorStatistics()
+  {
+    mitk::NavigationDataStatistics exact;
+    mitk::NavigationDataStatistics streamed(0, 100);
+    for (const auto& position : m_Positions)
+    {
+      exact.Add(position, m_Orientation);
+      streamed.Add(position, m_Orientation);
+    }
+
+    CPPUNIT_ASSERT(!streamed.IsPositionErrorStatisticExact());
+    CPPUNIT_ASSERT_EQUAL(exact.GetNumberOfSamples(), streamed.GetNumberOfSamples());
+
+    //running moments do not depend on the stored samples
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(exact.GetPositionErrorRMS(), streamed.GetPositionErrorRMS(), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      exact.GetPositionStandardDeviation()[0], streamed.GetPositionStandardDeviation()[0], 1e-12);
+
+    //errors against the running mean converge to the errors against the final mean
+    const double mean = exact.GetPositionErrorMean();
+    const double median = exact.GetPositionErrorMedian();
+    const double percentile = exact.GetPositionErrorPercentile(95);
+    const double standardDeviation = exact.GetPositionErrorStandardDeviation();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, streamed.GetPositionErrorMean(), 0.01 * mean);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(median, streamed.GetPositionErrorMedian(), 0.02 * median);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(percentile, streamed.GetPositionErrorPercentile(95), 0.02 * percentile);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(
+      standardDeviation, streamed.GetPositionErrorStandardDeviation(), 0.02 * standardDeviation);
+
+    mitk::Point3D position;
+    mitk::Quaternion orientation;
+    CPPUNIT_ASSERT(!streamed.GetStoredSample(0, position, orientation));
+    CPPUNIT_ASSERT(streamed.GetStoredSample(m_Positions.size() - 1, position, orientation));
+    CPPUNIT_ASSERT_EQUAL(m_Positions.back(), position);
+  }
+
+  void QuantileSketch_RelativeAccuracy()
+  {
+    std::mt19937 generator(7);
+    std::lognormal_distribution<double> distribution(0.0, 2.0);
+
+    mitk::QuantileSketch sketch(0.01);
+    std::vector<double> values;
+    for (unsigned int i = 0; i < 20000; ++i)
+    {
+      values.push_back(distribution(generator));
+      sketch.Add(values.back());
+    }
+    sketch.Add(0.0);
+    values.push_back(0.0);
+    std::sort(values.begin(), values.end());
+
+    CPPUNIT_ASSERT_EQUAL(0.0, sketch.GetQuantile(0.0));
+    for (double quantile : {0.01, 0.25, 0.5, 0.9, 0.99, 1.0})
+    {
+      const double expected = values[std::min(values.size() - 1, static_cast<std::size_t>(quantile * values.size()))];
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, sketch.GetQuantile(quantile), 0.01 * expected);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNavigationDataStatistics)
@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+//Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkTrackingDevicePushSource.h"
+#include "mitkVirtualTrackingDevice.h"
+#include "mitkNavigationDataPassThroughFilter.h"
+#include "mitkIGTException.h"
+
+//ITK includes
+#include "itksys/SystemTools.hxx"
+
+#include <cmath>
+
+class mitkTrackingDevicePushSourceTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkTrackingDevicePushSourceTestSuite);
+
+  MITK_TEST(RingBuffer_PushAndPop_FirstInFirstOut);
+  MITK_TEST(RingBuffer_Full_DropsSamples);
+  MITK_TEST(Synchronizer_InterpolatesBetweenSamples);
+  MITK_TEST(Synchronizer_OutsideOfHistory_ReturnsFalse);
+  MITK_TEST(SetTrackingDevice_DeviceIsTracking_Throws);
+  MITK_TEST(StartPipeline_VirtualTrackingDevice_FiltersAreUpdated);
+  MITK_TEST(StartPipeline_ToolAddedAfterSetTrackingDevice_OutputIsValid);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::VirtualTrackingDevice::Pointer m_Tracker;
+
+  static mitk::NavigationDataSample CreateSample(double timeStamp, double x, double angle)
+  {
+    mitk::NavigationDataSample sample;
+    sample.Position[0] = x;
+    sample.Position[1] = 2.0 * x;
+    sample.Position[2] = 0.0;
+    sample.Orientation = mitk::Quaternion(0.0, 0.0, std::sin(angle / 2), std::cos(angle / 2));
+    sample.DataValid = true;
+    sample.IGTTimeStamp = timeStamp;
+    return sample;
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_Tracker = mitk::VirtualTrackingDevice::New();
+    m_Tracker->SetRefreshRate(10);
+    m_Tracker->AddTool("Tool1");
+    m_Tracker->AddTool("Tool2");
+  }
+
+  void tearDown() override
+  {
+    m_Tracker->StopTracking();
+    m_Tracker->CloseConnection();
+  }
+
+  void RingBuffer_PushAndPop_FirstInFirstOut()
+  {
+    auto buffer = mitk::NavigationDataRingBuffer::New(3);
+    CPPUNIT_ASSERT_EQUAL(4u, buffer->GetCapacity());
+    CPPUNIT_ASSERT(buffer->IsEmpty());
+
+    for (int i = 0; i < 10; ++i)
+    {
+      CPPUNIT_ASSERT(buffer->Push(CreateSample(i, i, 0.0)));
+      CPPUNIT_ASSERT(buffer->Push(CreateSample(i + 0.5, i, 0.0)));
+
+      mitk::NavigationDataSample sample;
+      CPPUNIT_ASSERT(buffer->Pop(sample));
+      CPPUNIT_ASSERT_EQUAL(double(i), sample.IGTTimeStamp);
+      CPPUNIT_ASSERT(buffer->Pop(sample));
+      CPPUNIT_ASSERT_EQUAL(i + 0.5, sample.IGTTimeStamp);
+      CPPUNIT_ASSERT(!buffer->Pop(sample));
+    }
+    CPPUNIT_ASSERT(!buffer->WaitForSamples(1));
+  }
+
+  void RingBuffer_Full_DropsSamples()
+  {
+    auto buffer = mitk::NavigationDataRingBuffer::New(4);
+    for (int i = 0; i < 6; ++i)
+      buffer->Push(CreateSample(i, i, 0.0));
+
+    CPPUNIT_ASSERT_EQUAL(2ul, buffer->GetNumberOfDroppedSamples());
+    CPPUNIT_ASSERT(buffer->WaitForSamples(1));
+
+    mitk::NavigationDataSample sample;
+    for (int i = 0; i < 4; ++i)
+    {
+      CPPUNIT_ASSERT(buffer->Pop(sample));
+      CPPUNIT_ASSERT_EQUAL(double(i), sample.IGTTimeStamp);
+    }
+    CPPUNIT_ASSERT(buffer->IsEmpty());
+  }
+
+  void Synchronizer_InterpolatesBetweenSamples()
+  {
+    auto synchronizer = mitk::NavigationDataSynchronizer::New();
+    synchronizer->AddSample(CreateSample(10.0, 0.0, 0.0));
+    synchronizer->AddSample(CreateSample(30.0, 4.0, 1.0));
+    synchronizer->AddSample(CreateSample(20.0, 2.0, 0.5)); // out of order
+
+    auto nd = mitk::NavigationData::New();
+    CPPUNIT_ASSERT(synchronizer->GetNavigationDataAt(0, 25.0, nd));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, nd->GetPosition()[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, nd->GetPosition()[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sin(0.75 / 2), nd->GetOrientation().z(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::cos(0.75 / 2), nd->GetOrientation().r(), 1e-9);
+    CPPUNIT_ASSERT_EQUAL(25.0, nd->GetIGTTimeStamp());
+    CPPUNIT_ASSERT(nd->IsDataValid());
+
+    CPPUNIT_ASSERT(synchronizer->GetNavigationDataAt(0, 10.0, nd));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, nd->GetPosition()[0], mitk::eps);
+  }
+
+  void Synchronizer_OutsideOfHistory_ReturnsFalse()
+  {
+    auto synchronizer = mitk::NavigationDataSynchronizer::New();
+    synchronizer->SetHistoryLength(100.0);
+    for (int i = 0; i <= 20; ++i)
+      synchronizer->AddSample(CreateSample(10.0 * i, i, 0.0));
+
+    double oldest = 0.0;
+    double newest = 0.0;
+    CPPUNIT_ASSERT(synchronizer->GetTimeRange(0, oldest, newest));
+    CPPUNIT_ASSERT_EQUAL(100.0, oldest);
+    CPPUNIT_ASSERT_EQUAL(200.0, newest);
+
+    auto nd = mitk::NavigationData::New();
+    CPPUNIT_ASSERT(!synchronizer->GetNavigationDataAt(0, 50.0, nd));
+    CPPUNIT_ASSERT(!synchronizer->GetNavigationDataAt(0, 201.0, nd));
+    CPPUNIT_ASSERT(!synchronizer->GetNavigationDataAt(1, 150.0, nd));
+  }
+
+  void SetTrackingDevice_DeviceIsTracking_Throws()
+  {
+    m_Tracker->OpenConnection();
+    m_Tracker->StartTracking();
+
+    auto source = mitk::TrackingDevicePushSource::New();
+    CPPUNIT_ASSERT_THROW(source->SetTrackingDevice(m_Tracker), mitk::IGTException);
+  }
+
+  void StartPipeline_VirtualTrackingDevice_FiltersAreUpdated()
+  {
+    auto source = mitk::TrackingDevicePushSource::New();
+    source->SetTrackingDevice(m_Tracker);
+
+    auto filter = mitk::NavigationDataPassThroughFilter::New();
+    filter->ConnectTo(source);
+    source->AddPipelineFilter(filter);
+
+    source->Connect();
+    source->StartPipeline();
+    source->StartTracking();
+    itksys::SystemTools::Delay(300); // the virtual device publishes every 10 ms
+    CPPUNIT_ASSERT_THROW(source->AddPipelineFilter(mitk::NavigationDataPassThroughFilter::New()), mitk::IGTException);
+    source->StopPipeline();
+    source->StopTracking();
+
+    CPPUNIT_ASSERT(!source->IsPipelineRunning());
+    CPPUNIT_ASSERT(source->GetNumberOfProcessedSamples() > 0);
+    CPPUNIT_ASSERT(source->GetMeanLatency() >= 0.0);
+    CPPUNIT_ASSERT(source->GetMaximumLatency() >= source->GetMeanLatency());
+
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      CPPUNIT_ASSERT(filter->GetOutput(i)->IsDataValid());
+      CPPUNIT_ASSERT(filter->GetOutput(i)->GetIGTTimeStamp() > 0.0);
+
+      double oldest = 0.0;
+      double newest = 0.0;
+      CPPUNIT_ASSERT(source->GetSynchronizer()->GetTimeRange(i, oldest, newest));
+      CPPUNIT_ASSERT(newest >= filter->GetOutput(i)->GetIGTTimeStamp());
+
+      auto nd = mitk::NavigationData::New();
+      CPPUNIT_ASSERT(source->GetSynchronizer()->GetNavigationDataAt(i, (oldest + newest) / 2, nd));
+    }
+  }
+
+  void StartPipeline_ToolAddedAfterSetTrackingDevice_OutputIsValid()
+  {
+    auto source = mitk::TrackingDevicePushSource::New();
+    source->SetTrackingDevice(m_Tracker);
+
+    // the output of this tool is created by the pipeline, not by SetTrackingDevice()
+    m_Tracker->AddTool("Tool3");
+
+    source->Connect();
+    source->StartPipeline();
+    source->StartTracking();
+    itksys::SystemTools::Delay(300);
+    source->StopPipeline();
+    source->StopTracking();
+
+    CPPUNIT_ASSERT(source->GetNumberOfIndexedOutputs() == 3);
+    CPPUNIT_ASSERT(source->GetOutput(2)->IsDataValid());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkTrackingDevicePushSource)
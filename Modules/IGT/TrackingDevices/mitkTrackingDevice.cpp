@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkTrackingDevice.h"
 #include "mitkIGTTimeStamp.h"
 #include "mitkTrackingTool.h"
+#include "mitkIGTException.h"
 
 #include <itkMutexLockHolder.h>
 
@@ -22,6 +23,8 @@ found in the LICENSE file.
 #include "mitkUnspecifiedTrackingTypeInformation.h"
 #include "mitkTrackingDeviceTypeCollection.h"
 
+#include <algorithm>
+
 typedef itk::MutexLockHolder<itk::FastMutexLock> MutexLockHolder;
 
 
@@ -151,3 +154,51 @@ std::string mitk::TrackingDevice::GetTrackingDeviceName()
 {
   return this->GetData().Line;
 }
+
+void mitk::TrackingDevice::AddNavigationDataRingBuffer(NavigationDataRingBuffer* buffer)
+{
+  if (buffer == nullptr)
+    return;
+  if (this->GetState() == Tracking)
+    mitkThrowException(mitk::IGTException) << "Ring buffers cannot be added while the device is tracking.";
+
+  if (std::find(m_RingBuffers.begin(), m_RingBuffers.end(), buffer) == m_RingBuffers.end())
+    m_RingBuffers.push_back(buffer);
+}
+
+void mitk::TrackingDevice::RemoveNavigationDataRingBuffer(NavigationDataRingBuffer* buffer)
+{
+  if (this->GetState() == Tracking)
+    mitkThrowException(mitk::IGTException) << "Ring buffers cannot be removed while the device is tracking.";
+
+  m_RingBuffers.erase(std::remove(m_RingBuffers.begin(), m_RingBuffers.end(), buffer), m_RingBuffers.end());
+}
+
+void mitk::TrackingDevice::PublishToolSamples()
+{
+  if (m_RingBuffers.empty())
+    return;
+
+  const unsigned int toolCount = this->GetToolCount();
+  for (unsigned int i = 0; i < toolCount; ++i)
+  {
+    const mitk::TrackingTool* tool = this->GetTool(i);
+    if (tool == nullptr || !tool->IsEnabled())
+      continue;
+
+    NavigationDataSample sample;
+    sample.ToolIndex = i;
+    sample.DataValid = tool->IsDataValid();
+    tool->GetPosition(sample.Position);
+    tool->GetOrientation(sample.Orientation);
+    sample.TrackingError = tool->GetTrackingError();
+    sample.IGTTimeStamp = tool->GetIGTTimeStamp();
+
+    //same fallback as in TrackingDeviceSource for devices that do not stamp their tools
+    if (sample.IGTTimeStamp == 0)
+      sample.IGTTimeStamp = mitk::IGTTimeStamp::GetInstance()->GetElapsed();
+
+    for (const auto& buffer : m_RingBuffers)
+      buffer->Push(sample);
+  }
+}
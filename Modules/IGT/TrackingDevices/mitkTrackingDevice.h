@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include "mitkTrackingTypes.h"
 #include "itkFastMutexLock.h"
 #include "mitkNavigationToolStorage.h"
+#include "mitkNavigationDataRingBuffer.h"
 
 
 namespace mitk {
@@ -179,6 +180,22 @@ namespace mitk {
      */
     virtual mitk::NavigationToolStorage::Pointer AutoDetectTools();
 
+    /**
+     * \brief Registers a ring buffer into which the device publishes every new tool pose.
+     *
+     * Devices that support push mode call PublishToolSamples() from their tracking thread.
+     * Buffers can only be added or removed while the device is not tracking, so publishing
+     * does not need to lock the list of buffers.
+     * @throw mitk::IGTException Throws an exception if the device is tracking.
+     */
+    void AddNavigationDataRingBuffer(NavigationDataRingBuffer* buffer);
+
+    /**
+     * \brief Unregisters a ring buffer that was added with AddNavigationDataRingBuffer().
+     * @throw mitk::IGTException Throws an exception if the device is tracking.
+     */
+    void RemoveNavigationDataRingBuffer(NavigationDataRingBuffer* buffer);
+
     private:
       TrackingDeviceState m_State; ///< current object state (Setup, Ready or Tracking)
     protected:
@@ -192,6 +209,14 @@ namespace mitk {
       TrackingDevice();
       ~TrackingDevice() override;
 
+      /**
+      * \brief Pushes the current pose of all tools into the registered ring buffers.
+      *
+      * Meant to be called by the tracking thread after all tools were updated. Tools without
+      * a timestamp are stamped with the current mitk::IGTTimeStamp.
+      */
+      void PublishToolSamples();
+
     TrackingDeviceData m_Data; ///< current device Data
 
       bool m_StopTracking;       ///< signal stop to tracking thread
@@ -199,6 +224,7 @@ namespace mitk {
       itk::FastMutexLock::Pointer m_TrackingFinishedMutex; ///< mutex to manage control flow of StopTracking()
       itk::FastMutexLock::Pointer m_StateMutex; ///< mutex to control access to m_State
       RotationMode m_RotationMode; ///< defines the rotation mode Standard or Transposed, Standard is default
+      std::vector<NavigationDataRingBuffer::Pointer> m_RingBuffers; ///< buffers that receive the published tool poses
     };
 } // namespace mitk
 
@@ -263,8 +263,10 @@ void mitk::VirtualTrackingDevice::TrackTools()
 
       currentTool->SetTrackingError(2 * (rand() / (RAND_MAX + 1.0)));  // tracking error in 0 .. 2 Range
       currentTool->SetDataValid(true);
+      currentTool->SetIGTTimeStamp(mitk::IGTTimeStamp::GetInstance()->GetElapsed());
       currentTool->Modified();
     }
+    this->PublishToolSamples();
     itksys::SystemTools::Delay(m_RefreshRate);
     /* Update the local copy of m_StopTracking */
     this->m_StopTrackingMutex->Lock();
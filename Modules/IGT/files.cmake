@@ -9,6 +9,8 @@ set(CPP_FILES
   Algorithms/mitkNavigationDataPassThroughFilter.cpp
   Algorithms/mitkNavigationDataReferenceTransformFilter.cpp
   Algorithms/mitkNavigationDataSmoothingFilter.cpp
+  Algorithms/mitkNavigationDataStatistics.cpp
+  Algorithms/mitkNavigationDataSynchronizer.cpp
   Algorithms/mitkNavigationDataToMessageFilter.cpp
   Algorithms/mitkNavigationDataToNavigationDataFilter.cpp
   Algorithms/mitkNavigationDataToPointSetFilter.cpp
@@ -19,6 +21,7 @@ set(CPP_FILES
   Algorithms/mitkPivotCalibration.cpp
 
   Common/mitkIGTTimeStamp.cpp
+  Common/mitkNavigationDataRingBuffer.cpp
   Common/mitkSerialCommunication.cpp
 
   DataManagement/mitkNavigationDataSource.cpp
@@ -26,6 +29,7 @@ set(CPP_FILES
   DataManagement/mitkNavigationToolStorage.cpp
   DataManagement/mitkTrackingDeviceSourceConfigurator.cpp
   DataManagement/mitkTrackingDeviceSource.cpp
+  DataManagement/mitkTrackingDevicePushSource.cpp
   DataManagement/mitkTrackingDeviceTypeCollection.cpp
 
   ExceptionHandling/mitkIGTException.cpp
@@ -61,5 +61,6 @@ namespace mitk
   }
 
   std::vector<BaseData::Pointer> SceneFileReader::Read() { return AbstractFileReader::Read(); }
+  bool SceneFileReader::IsThreadSafe() const { return false; }
   SceneFileReader *SceneFileReader::Clone() const { return new SceneFileReader(*this); }
 }
@@ -27,6 +27,9 @@ namespace mitk
     std::vector<itk::SmartPointer<BaseData>> Read() override;
     DataStorage::SetOfObjects::Pointer Read(DataStorage &ds) override;
 
+    // SceneIO extracts and deserializes with its own threads
+    bool IsThreadSafe() const override;
+
   private:
     SceneFileReader *Clone() const override;
   };
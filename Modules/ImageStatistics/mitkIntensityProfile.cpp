@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <mitkImageStatisticsContainer.h>
 #include "mitkIntensityProfile.h"
 
+#include <vector>
+
 using namespace mitk;
 
 template <class T>
@@ -164,41 +166,25 @@ static IntensityProfile::Pointer ComputeIntensityProfile(Image::Pointer image, i
   return intensityProfile;
 }
 
-class AddPolyLineElementToPath
-{
-public:
-  AddPolyLineElementToPath(const PlaneGeometry* planarFigureGeometry, const BaseGeometry* imageGeometry, itk::PolyLineParametricPath<3>::Pointer path)
-    : m_PlanarFigureGeometry(planarFigureGeometry),
-      m_ImageGeometry(imageGeometry),
-      m_Path(path)
-  {
-  }
-
-  void operator()(const PlanarFigure::PolyLineElement& polyLineElement)
-  {
-    m_PlanarFigureGeometry->Map(polyLineElement, m_WorldPoint);
-    m_ImageGeometry->WorldToIndex(m_WorldPoint, m_ContinuousIndexPoint);
-    m_Vertex.CastFrom(m_ContinuousIndexPoint);
-    m_Path->AddVertex(m_Vertex);
-  }
-
-private:
-  const PlaneGeometry* m_PlanarFigureGeometry;
-  const BaseGeometry* m_ImageGeometry;
-  itk::PolyLineParametricPath<3>::Pointer m_Path;
-
-  Point3D m_WorldPoint;
-  Point3D m_ContinuousIndexPoint;
-  itk::PolyLineParametricPath<3>::ContinuousIndexType m_Vertex;
-};
-
 static itk::PolyLineParametricPath<3>::Pointer CreatePathFromPlanarFigure(BaseGeometry* imageGeometry, PlanarFigure* planarFigure)
 {
   itk::PolyLineParametricPath<3>::Pointer path = itk::PolyLineParametricPath<3>::New();
   const PlanarFigure::PolyLineType polyLine = planarFigure->GetPolyLine(0);
+  const PlaneGeometry* planarFigureGeometry = planarFigure->GetPlaneGeometry();
+
+  // Map all polyline elements into the world first and transform them to continuous indices at once
+  std::vector<Point3D> points(polyLine.size());
+  for (std::size_t i = 0; i < polyLine.size(); ++i)
+    planarFigureGeometry->Map(polyLine[i], points[i]);
+
+  imageGeometry->GetTransformSnapshot()->WorldToIndex(points.data(), points.data(), points.size());
 
-  std::for_each(polyLine.begin(), polyLine.end(),
-    AddPolyLineElementToPath(planarFigure->GetPlaneGeometry(), imageGeometry, path));
+  itk::PolyLineParametricPath<3>::ContinuousIndexType vertex;
+  for (const auto& point : points)
+  {
+    vertex.CastFrom(point);
+    path->AddVertex(vertex);
+  }
 
   return path;
 }
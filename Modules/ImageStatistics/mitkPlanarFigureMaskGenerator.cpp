@@ -33,7 +33,23 @@ found in the LICENSE file.
 #include <vtkLassoStencilSource.h>
 #include <vtkSmartPointer.h>
 
+#include <vector>
 
+namespace
+{
+  // Maps the points of a polyline into the world and transforms all of them to continuous index coordinates at once
+  std::vector<mitk::Point3D> MapPolyLineToIndex(const mitk::PlaneGeometry *planeGeometry,
+                                                const mitk::PlanarFigure::PolyLineType &polyLine,
+                                                const mitk::GeometryTransformSnapshot &imageTransform)
+  {
+    std::vector<mitk::Point3D> points(polyLine.size());
+    for (std::size_t i = 0; i < polyLine.size(); ++i)
+      planeGeometry->Map(polyLine[i], points[i]);
+
+    imageTransform.WorldToIndex(points.data(), points.data(), points.size());
+    return points;
+  }
+}
 
 namespace mitk
 {
@@ -97,6 +113,8 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
   const mitk::PlaneGeometry *planarFigurePlaneGeometry = m_PlanarFigure->GetPlaneGeometry();
   const typename PlanarFigure::PolyLineType planarFigurePolyline = m_PlanarFigure->GetPolyLine( 0 );
   const mitk::BaseGeometry *imageGeometry3D = m_inputImage->GetGeometry( 0 );
+  // transforms the polyline points in batches without going through the geometry for each of them
+  const mitk::GeometryTransformSnapshot::ConstPointer imageTransform = imageGeometry3D->GetTransformSnapshot();
   // If there is a second poly line in a closed planar figure, treat it as a hole.
   PlanarFigure::PolyLineType planarFigureHolePolyline;
 
@@ -127,15 +145,10 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
   }
 
   // store the polyline contour as vtkPoints object
+  // Convert 2D points back to the local index coordinates of the selected image
   vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  for (const auto& point : planarFigurePolyline)
+  for (const auto& point3D : MapPolyLineToIndex(planarFigurePlaneGeometry, planarFigurePolyline, *imageTransform))
   {
-    Point3D point3D;
-
-    // Convert 2D point back to the local index coordinates of the selected image
-    planarFigurePlaneGeometry->Map(point, point3D);
-    imageGeometry3D->WorldToIndex(point3D, point3D);
-
     points->InsertNextPoint(point3D[i0], point3D[i1], 0);
   }
 
@@ -144,12 +157,9 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromPlanarFigure(
   if (!planarFigureHolePolyline.empty())
   {
     holePoints = vtkSmartPointer<vtkPoints>::New();
-    Point3D point3D;
 
-    for (const auto& point : planarFigureHolePolyline)
+    for (const auto& point3D : MapPolyLineToIndex(planarFigurePlaneGeometry, planarFigureHolePolyline, *imageTransform))
     {
-      planarFigurePlaneGeometry->Map(point, point3D);
-      imageGeometry3D->WorldToIndex(point3D, point3D);
       holePoints->InsertNextPoint(point3D[i0], point3D[i1], 0);
     }
   }
@@ -256,6 +266,8 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromOpenPlanarFigure(
   const mitk::PlaneGeometry *planarFigurePlaneGeometry = m_PlanarFigure->GetPlaneGeometry();
   const typename PlanarFigure::PolyLineType planarFigurePolyline = m_PlanarFigure->GetPolyLine( 0 );
   const mitk::BaseGeometry *imageGeometry3D = m_inputImage->GetGeometry( 0 );
+  // transforms the polyline points in batches without going through the geometry for each of them
+  const mitk::GeometryTransformSnapshot::ConstPointer imageTransform = imageGeometry3D->GetTransformSnapshot();
 
   // Determine x- and y-dimensions depending on principal axis
   // TODO use plane geometry normal to determine that automatically, then check whether the PF is aligned with one of the three principal axis
@@ -284,13 +296,8 @@ void PlanarFigureMaskGenerator::InternalCalculateMaskFromOpenPlanarFigure(
   {
     // store the polyline contour as vtkPoints object
     IndexVecType pointIndices;
-    for(const auto& point : planarFigurePolyline)
+    for (const auto& point3D : MapPolyLineToIndex(planarFigurePlaneGeometry, planarFigurePolyline, *imageTransform))
     {
-      Point3D point3D;
-
-      planarFigurePlaneGeometry->Map(point, point3D);
-      imageGeometry3D->WorldToIndex(point3D, point3D);
-
       IndexType2D index2D;
       index2D[0] = point3D[i0];
       index2D[1] = point3D[i1];
@@ -13,6 +13,7 @@ set(CPP_FILES
 
   vtkMaskedGlyph2D.cpp
   vtkMaskedGlyph3D.cpp
+  vtkMitkCPUVolumeRayCastMapper.cpp
   vtkMitkGPUVolumeRayCastMapper.cpp
   vtkUnstructuredGridMapper.cpp
 
@@ -29,6 +29,7 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 #include <vtkImageChangeInformation.h>
 
+class vtkMitkCPUVolumeRayCastMapper;
 class vtkRenderingOpenGL2ObjectFactory;
 class vtkRenderingVolumeOpenGL2ObjectFactory;
 
@@ -38,6 +39,11 @@ namespace mitk
   //##Documentation
   //## @brief Vtk-based mapper for VolumeData
   //##
+  //## If the property "volumerendering.cpu.multiresolution" is set, the volume is rendered by
+  //## vtkMitkCPUVolumeRayCastMapper instead of vtkSmartVolumeMapper. It does not require GPU
+  //## volume rendering support and, with "volumerendering.uselod" enabled, renders a coarse
+  //## representation during interaction which is refined when the interaction stops.
+  //##
   //## @ingroup Mapper
   class MITKMAPPEREXT_EXPORT VolumeMapperVtkSmart3D : public VtkMapper
   {
@@ -53,6 +59,8 @@ namespace mitk
     void ApplyProperties(vtkActor *actor, mitk::BaseRenderer *renderer) override;
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
+    bool IsLODEnabled(BaseRenderer *renderer) const override;
+
   protected:
     VolumeMapperVtkSmart3D();
     ~VolumeMapperVtkSmart3D() override;
@@ -67,6 +75,7 @@ namespace mitk
     vtkSmartPointer<vtkVolume> m_Volume;
     vtkSmartPointer<vtkImageChangeInformation> m_ImageChangeInformation;
     vtkSmartPointer<vtkSmartVolumeMapper> m_SmartVolumeMapper;
+    vtkSmartPointer<vtkMitkCPUVolumeRayCastMapper> m_CPURayCastMapper;
     vtkSmartPointer<vtkVolumeProperty> m_VolumeProperty;
 
     vtkSmartPointer<vtkRenderingOpenGL2ObjectFactory> m_RenderingOpenGL2ObjectFactory;
@@ -0,0 +1,170 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __vtkMitkCPUVolumeRayCastMapper_h
+#define __vtkMitkCPUVolumeRayCastMapper_h
+
+#include "MitkMapperExtExports.h"
+
+#include <vtkSmartPointer.h>
+#include <vtkVolumeMapper.h>
+
+#include <vector>
+
+class vtkRayCastImageDisplayHelper;
+class vtkVolumeProperty;
+
+/** Documentation
+* \brief Multiresolution CPU ray casting volume mapper with empty space skipping.
+*
+* This mapper does not need any GPU-side volume rendering support and is meant for
+* headless render servers without a GPU. The input volume is converted into a mip-mapped
+* pyramid of float volumes (each level halves the resolution). For every pyramid level a
+* min/max octree is built. Whenever the scalar opacity transfer function changes, the
+* octree nodes are classified as empty or non-empty, so rays can skip large empty
+* regions of the volume at once. In maximum intensity mode nodes are skipped if their
+* maximum does not exceed the current maximum of the ray.
+*
+* The image is split into tiles which are ray cast in parallel. The level of detail
+* selects the pyramid level and the image sample distance: level 0 renders the coarse
+* interactive representation, higher levels render the full resolution volume. This is
+* meant to be driven by the level of detail requests of mitk::RenderingManager, so
+* interactive frames render coarse and idle frames refine.
+*
+* Supported are composite and maximum intensity blending of single component volumes,
+* optionally with gradient based shading (headlight).
+*
+* \ingroup Mapper
+*/
+class MITKMAPPEREXT_EXPORT vtkMitkCPUVolumeRayCastMapper : public vtkVolumeMapper
+{
+public:
+  vtkTypeMacro(vtkMitkCPUVolumeRayCastMapper, vtkVolumeMapper);
+
+  static vtkMitkCPUVolumeRayCastMapper *New();
+
+  void PrintSelf(ostream &os, vtkIndent indent) override;
+
+  /** \brief Set/Get the level of detail. 0 renders the interactive representation, every
+   * other value renders the full resolution volume. */
+  vtkSetMacro(LevelOfDetail, int);
+  vtkGetMacro(LevelOfDetail, int);
+
+  /** \brief Set/Get the pyramid level used for the interactive level of detail. Level 0 is the
+   * full resolution, every level halves the resolution in each direction. Default is 1. */
+  vtkSetClampMacro(InteractiveResolutionLevel, int, 0, 8);
+  vtkGetMacro(InteractiveResolutionLevel, int);
+
+  /** \brief Set/Get the image sample distance (in pixels) used for the interactive level of detail. Default is 2. */
+  vtkSetClampMacro(InteractiveImageSampleDistance, float, 1.0f, 16.0f);
+  vtkGetMacro(InteractiveImageSampleDistance, float);
+
+  /** \brief Set/Get the distance between samples along a ray in voxels of the rendered
+   * pyramid level. Default is 0.5. */
+  vtkSetClampMacro(SampleDistance, float, 0.05f, 8.0f);
+  vtkGetMacro(SampleDistance, float);
+
+  /** \brief Set/Get the number of threads used for ray casting. 0 (the default) uses all available cores. */
+  vtkSetClampMacro(NumberOfThreads, int, 0, 256);
+  vtkGetMacro(NumberOfThreads, int);
+
+  /** \brief Returns the number of pyramid levels built for the current input. */
+  int GetNumberOfResolutionLevels() const { return static_cast<int>(m_Levels.size()); }
+
+  /** \brief Returns the pyramid level rendered with the current level of detail. */
+  int GetRenderedResolutionLevel() const;
+
+  /** \brief Returns the fraction of octree leaves of a pyramid level that are classified as
+   * empty by the current transfer function. Valid after the first render call. */
+  double GetEmptyFraction(int level) const;
+
+  /** \brief Builds the pyramid and the octrees (if the input changed) and classifies the
+   * octree nodes with the given volume property. This is done automatically by Render(). */
+  void UpdateAcceleration(vtkVolumeProperty *property);
+
+  void Render(vtkRenderer *renderer, vtkVolume *volume) override;
+
+  void ReleaseGraphicsResources(vtkWindow *window) override;
+
+  /** \brief Edge length (in voxels) of the octree leaves. */
+  static const int LeafSize = 8;
+
+  /** \brief Number of entries of the sampled transfer function tables. */
+  static const int TableSize = 1024;
+
+protected:
+  vtkMitkCPUVolumeRayCastMapper();
+  ~vtkMitkCPUVolumeRayCastMapper() override;
+
+  /** \brief One level of the min/max octree. */
+  struct OctreeLevel
+  {
+    int Dimensions[3];
+    int NodeSize;
+    std::vector<float> Min;
+    std::vector<float> Max;
+    std::vector<unsigned char> NonEmpty;
+  };
+
+  /** \brief One level of the volume pyramid together with its octree. */
+  struct ResolutionLevel
+  {
+    int Dimensions[3];
+    std::vector<float> Scalars;
+    std::vector<OctreeLevel> Octree;
+  };
+
+  /** \brief Per ray parameters shared by all pixels of one render call. */
+  struct RayCastParameters;
+
+  void BuildPyramid();
+  void BuildOctree(ResolutionLevel &level);
+  void ClassifyOctree(ResolutionLevel &level);
+  void UpdateTransferFunctionTables(vtkVolumeProperty *property);
+
+  void CastRay(const RayCastParameters &parameters, int x, int y, unsigned char *pixel) const;
+  /** \brief Searches the coarsest octree node containing the position that can be skipped. In composite mode
+   * these are nodes classified as empty, in maximum intensity mode nodes whose maximum does not exceed the
+   * current maximum of the ray. Returns false if the position has to be sampled. */
+  bool FindSkippableNode(const ResolutionLevel &level,
+                         const double position[3],
+                         bool maximumIntensity,
+                         float currentMaximum,
+                         double nodeMin[3],
+                         double nodeMax[3]) const;
+
+  int LevelOfDetail;
+  int InteractiveResolutionLevel;
+  float InteractiveImageSampleDistance;
+  float SampleDistance;
+  int NumberOfThreads;
+
+  std::vector<ResolutionLevel> m_Levels;
+  vtkMTimeType m_PyramidBuildTime;
+
+  /** \brief Scalar range of the input and the sampled transfer functions. */
+  double m_ScalarRange[2];
+  std::vector<float> m_ColorTable;
+  std::vector<float> m_OpacityTable;
+  /** \brief Number of table entries with non-zero opacity up to (including) each entry. */
+  std::vector<int> m_NonZeroOpacityPrefix;
+  vtkMTimeType m_TransferFunctionTime;
+
+  std::vector<unsigned char> m_Image;
+  vtkSmartPointer<vtkRayCastImageDisplayHelper> m_ImageDisplayHelper;
+
+private:
+  vtkMitkCPUVolumeRayCastMapper(const vtkMitkCPUVolumeRayCastMapper &) = delete;
+  void operator=(const vtkMitkCPUVolumeRayCastMapper &) = delete;
+};
+
+#endif
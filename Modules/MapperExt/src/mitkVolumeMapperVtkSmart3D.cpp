@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include "mitkTransferFunctionProperty.h"
 #include "mitkTransferFunctionInitializer.h"
 #include "mitkLevelWindowProperty.h"
+#include "mitkRenderingManager.h"
+#include "vtkMitkCPUVolumeRayCastMapper.h"
 #include <vtkObjectFactory.h>
 #include <vtkRenderingOpenGL2ObjectFactory.h>
 #include <vtkRenderingVolumeOpenGL2ObjectFactory.h>
@@ -67,6 +69,9 @@ void mitk::VolumeMapperVtkSmart3D::SetDefaultProperties(mitk::DataNode *node, mi
   node->AddProperty("volumerendering.cpu.diffuse", mitk::FloatProperty::New(0.50f), renderer, overwrite);
   node->AddProperty("volumerendering.cpu.specular", mitk::FloatProperty::New(0.40f), renderer, overwrite);
   node->AddProperty("volumerendering.cpu.specular.power", mitk::FloatProperty::New(16.0f), renderer, overwrite);
+  node->AddProperty("volumerendering.cpu.multiresolution", mitk::BoolProperty::New(false), renderer, overwrite);
+  node->AddProperty("volumerendering.cpu.interactivelevel", mitk::IntProperty::New(1), renderer, overwrite);
+  node->AddProperty("volumerendering.uselod", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("volumerendering.usegpu", mitk::BoolProperty::New(false), renderer, overwrite);
   node->AddProperty("volumerendering.useray", mitk::BoolProperty::New(false), renderer, overwrite);
 
@@ -109,6 +114,9 @@ void mitk::VolumeMapperVtkSmart3D::createMapper(vtkImageData* imageData)
 
   m_SmartVolumeMapper->SetBlendModeToComposite();
   m_SmartVolumeMapper->SetInputConnection(m_ImageChangeInformation->GetOutputPort());
+
+  m_CPURayCastMapper->SetBlendModeToComposite();
+  m_CPURayCastMapper->SetInputConnection(m_ImageChangeInformation->GetOutputPort());
 }
 
 void mitk::VolumeMapperVtkSmart3D::createVolume()
@@ -172,14 +180,49 @@ void mitk::VolumeMapperVtkSmart3D::UpdateTransferFunctions(mitk::BaseRenderer *r
 }
 
 
+bool mitk::VolumeMapperVtkSmart3D::IsLODEnabled(mitk::BaseRenderer *renderer) const
+{
+  bool value = false;
+  return GetDataNode()->GetBoolProperty("volumerendering.uselod", value, renderer) && value;
+}
+
 void mitk::VolumeMapperVtkSmart3D::UpdateRenderMode(mitk::BaseRenderer *renderer)
 {
   bool usegpu = false;
   bool useray = false;
   bool usemip = false;
+  bool multiresolution = false;
   this->GetDataNode()->GetBoolProperty("volumerendering.usegpu", usegpu);
   this->GetDataNode()->GetBoolProperty("volumerendering.useray", useray);
   this->GetDataNode()->GetBoolProperty("volumerendering.usemip", usemip);
+  this->GetDataNode()->GetBoolProperty("volumerendering.cpu.multiresolution", multiresolution);
+
+  if (multiresolution && !usegpu)
+  {
+    if (m_Volume->GetMapper() != m_CPURayCastMapper)
+      m_Volume->SetMapper(m_CPURayCastMapper);
+
+    // coarse pyramid level while interacting, full resolution otherwise
+    int level = 1;
+    if (this->GetDataNode()->GetIntProperty("volumerendering.cpu.interactivelevel", level, renderer))
+      m_CPURayCastMapper->SetInteractiveResolutionLevel(level);
+
+    int lod = 1;
+    if (IsLODEnabled(renderer))
+      lod = mitk::RenderingManager::GetInstance()->GetNextLOD(renderer);
+    m_CPURayCastMapper->SetLevelOfDetail(lod);
+
+    int blendMode;
+    if (this->GetDataNode()->GetIntProperty("volumerendering.blendmode", blendMode))
+      m_CPURayCastMapper->SetBlendMode(blendMode);
+    else
+      m_CPURayCastMapper->SetBlendMode(usemip ? vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND
+                                              : vtkVolumeMapper::COMPOSITE_BLEND);
+  }
+  else if (m_Volume->GetMapper() != m_SmartVolumeMapper)
+  {
+    m_Volume->SetMapper(m_SmartVolumeMapper);
+  }
 
   if (usegpu)
     m_SmartVolumeMapper->SetRequestedRenderModeToGPU();
@@ -231,6 +274,7 @@ mitk::VolumeMapperVtkSmart3D::VolumeMapperVtkSmart3D()
 
   m_SmartVolumeMapper = vtkSmartPointer<vtkSmartVolumeMapper>::New();
   m_SmartVolumeMapper->SetBlendModeToComposite();
+  m_CPURayCastMapper = vtkSmartPointer<vtkMitkCPUVolumeRayCastMapper>::New();
   m_ImageChangeInformation = vtkSmartPointer<vtkImageChangeInformation>::New();
   m_VolumeProperty = vtkSmartPointer<vtkVolumeProperty>::New();
   m_Volume = vtkSmartPointer<vtkVolume>::New();
@@ -0,0 +1,765 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "vtkMitkCPUVolumeRayCastMapper.h"
+
+#include <mitkParallelFor.h>
+
+#include <vtkAlgorithm.h>
+#include <vtkCamera.h>
+#include <vtkColorTransferFunction.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkRayCastImageDisplayHelper.h>
+#include <vtkRenderer.h>
+#include <vtkVolume.h>
+#include <vtkVolumeProperty.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+vtkStandardNewMacro(vtkMitkCPUVolumeRayCastMapper);
+
+const int vtkMitkCPUVolumeRayCastMapper::LeafSize;
+const int vtkMitkCPUVolumeRayCastMapper::TableSize;
+
+struct vtkMitkCPUVolumeRayCastMapper::RayCastParameters
+{
+  const ResolutionLevel *Level;
+  double ViewToIndex[16];
+  int ViewportImageSize[2];
+  double Step;
+  bool MaximumIntensity;
+  bool Shade;
+  double Ambient;
+  double Diffuse;
+  double Specular;
+  double SpecularPower;
+  double TableScale;
+  std::vector<float> CorrectedOpacity;
+};
+
+namespace
+{
+  const int TileSize = 16;
+
+  /** Index of the first voxel used for linear interpolation and the interpolation weight. */
+  inline void InterpolationIndex(double position, int dimension, int &index, double &weight)
+  {
+    if (dimension < 2)
+    {
+      index = 0;
+      weight = 0.0;
+      return;
+    }
+
+    index = std::min(std::max(static_cast<int>(position), 0), dimension - 2);
+    weight = position - index;
+  }
+
+  inline float SampleTrilinear(const float *scalars, const int *dims, const double *position)
+  {
+    int i, j, k;
+    double fx, fy, fz;
+    InterpolationIndex(position[0], dims[0], i, fx);
+    InterpolationIndex(position[1], dims[1], j, fy);
+    InterpolationIndex(position[2], dims[2], k, fz);
+
+    const size_t strideY = dims[0];
+    const size_t strideZ = strideY * dims[1];
+    const size_t dx = dims[0] > 1 ? 1 : 0;
+    const size_t dy = dims[1] > 1 ? strideY : 0;
+    const size_t dz = dims[2] > 1 ? strideZ : 0;
+
+    const float *v = scalars + i + j * strideY + k * strideZ;
+
+    const double c00 = v[0] + fx * (v[dx] - v[0]);
+    const double c10 = v[dy] + fx * (v[dy + dx] - v[dy]);
+    const double c01 = v[dz] + fx * (v[dz + dx] - v[dz]);
+    const double c11 = v[dz + dy] + fx * (v[dz + dy + dx] - v[dz + dy]);
+
+    const double c0 = c00 + fy * (c10 - c00);
+    const double c1 = c01 + fy * (c11 - c01);
+
+    return static_cast<float>(c0 + fz * (c1 - c0));
+  }
+
+  template <typename T>
+  void ConvertScalars(const T *input, int numberOfComponents, size_t numberOfVoxels, float *output, double range[2])
+  {
+    double minimum = std::numeric_limits<double>::max();
+    double maximum = std::numeric_limits<double>::lowest();
+
+    for (size_t i = 0; i < numberOfVoxels; ++i)
+    {
+      const float value = static_cast<float>(input[i * numberOfComponents]);
+      output[i] = value;
+      minimum = std::min(minimum, static_cast<double>(value));
+      maximum = std::max(maximum, static_cast<double>(value));
+    }
+
+    range[0] = minimum;
+    range[1] = maximum;
+  }
+
+  void MultiplyPoint(const double matrix[16], const double in[4], double out[4])
+  {
+    for (int r = 0; r < 4; ++r)
+      out[r] = matrix[4 * r] * in[0] + matrix[4 * r + 1] * in[1] + matrix[4 * r + 2] * in[2] + matrix[4 * r + 3] * in[3];
+  }
+}
+
+vtkMitkCPUVolumeRayCastMapper::vtkMitkCPUVolumeRayCastMapper()
+  : LevelOfDetail(1),
+    InteractiveResolutionLevel(1),
+    InteractiveImageSampleDistance(2.0f),
+    SampleDistance(0.5f),
+    NumberOfThreads(0),
+    m_PyramidBuildTime(0),
+    m_TransferFunctionTime(0)
+{
+  m_ScalarRange[0] = 0.0;
+  m_ScalarRange[1] = 1.0;
+  m_ImageDisplayHelper = vtkSmartPointer<vtkRayCastImageDisplayHelper>::Take(vtkRayCastImageDisplayHelper::New());
+  if (m_ImageDisplayHelper != nullptr)
+    m_ImageDisplayHelper->PreMultipliedColorsOn();
+}
+
+vtkMitkCPUVolumeRayCastMapper::~vtkMitkCPUVolumeRayCastMapper()
+{
+}
+
+void vtkMitkCPUVolumeRayCastMapper::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Level Of Detail: " << this->LevelOfDetail << "\n";
+  os << indent << "Interactive Resolution Level: " << this->InteractiveResolutionLevel << "\n";
+  os << indent << "Interactive Image Sample Distance: " << this->InteractiveImageSampleDistance << "\n";
+  os << indent << "Sample Distance: " << this->SampleDistance << "\n";
+  os << indent << "Number Of Threads: " << this->NumberOfThreads << "\n";
+  os << indent << "Number Of Resolution Levels: " << m_Levels.size() << "\n";
+}
+
+double vtkMitkCPUVolumeRayCastMapper::GetEmptyFraction(int level) const
+{
+  if (level < 0 || level >= static_cast<int>(m_Levels.size()) || m_Levels[level].Octree.empty())
+    return 0.0;
+
+  const std::vector<unsigned char> &nonEmpty = m_Levels[level].Octree.front().NonEmpty;
+  if (nonEmpty.empty())
+    return 0.0;
+
+  const auto numberOfEmptyLeaves = std::count(nonEmpty.begin(), nonEmpty.end(), 0);
+  return static_cast<double>(numberOfEmptyLeaves) / nonEmpty.size();
+}
+
+int vtkMitkCPUVolumeRayCastMapper::GetRenderedResolutionLevel() const
+{
+  if (this->LevelOfDetail != 0 || m_Levels.empty())
+    return 0;
+
+  return std::min(this->InteractiveResolutionLevel, static_cast<int>(m_Levels.size()) - 1);
+}
+
+void vtkMitkCPUVolumeRayCastMapper::BuildPyramid()
+{
+  m_Levels.clear();
+
+  vtkImageData *input = this->GetInput();
+  if (input == nullptr || input->GetPointData()->GetScalars() == nullptr)
+    return;
+
+  vtkDataArray *scalars = input->GetPointData()->GetScalars();
+
+  ResolutionLevel base;
+  input->GetDimensions(base.Dimensions);
+  const size_t numberOfVoxels = static_cast<size_t>(base.Dimensions[0]) * base.Dimensions[1] * base.Dimensions[2];
+  base.Scalars.resize(numberOfVoxels);
+
+  switch (scalars->GetDataType())
+  {
+    vtkTemplateMacro(ConvertScalars(static_cast<const VTK_TT *>(scalars->GetVoidPointer(0)),
+                                    scalars->GetNumberOfComponents(),
+                                    numberOfVoxels,
+                                    base.Scalars.data(),
+                                    m_ScalarRange));
+    default:
+      vtkErrorMacro(<< "Unsupported scalar type " << scalars->GetDataTypeAsString());
+      return;
+  }
+
+  if (m_ScalarRange[1] <= m_ScalarRange[0])
+    m_ScalarRange[1] = m_ScalarRange[0] + 1.0;
+
+  m_Levels.push_back(std::move(base));
+
+  // Each further level halves the resolution by averaging 2x2x2 voxels.
+  while (m_Levels.size() < 9)
+  {
+    const ResolutionLevel &fine = m_Levels.back();
+    if (fine.Dimensions[0] <= LeafSize && fine.Dimensions[1] <= LeafSize && fine.Dimensions[2] <= LeafSize)
+      break;
+
+    ResolutionLevel coarse;
+    for (int d = 0; d < 3; ++d)
+      coarse.Dimensions[d] = (fine.Dimensions[d] + 1) / 2;
+    coarse.Scalars.resize(static_cast<size_t>(coarse.Dimensions[0]) * coarse.Dimensions[1] * coarse.Dimensions[2]);
+
+    const int *fd = fine.Dimensions;
+    const int *cd = coarse.Dimensions;
+
+    mitk::ParallelFor(cd[2], 0, [&](std::size_t slice) {
+      const int z = static_cast<int>(slice);
+      for (int y = 0; y < cd[1]; ++y)
+      {
+        for (int x = 0; x < cd[0]; ++x)
+        {
+          double sum = 0.0;
+          int count = 0;
+          for (int k = 2 * z; k < std::min(2 * z + 2, fd[2]); ++k)
+            for (int j = 2 * y; j < std::min(2 * y + 2, fd[1]); ++j)
+              for (int i = 2 * x; i < std::min(2 * x + 2, fd[0]); ++i, ++count)
+                sum += fine.Scalars[i + static_cast<size_t>(fd[0]) * (j + static_cast<size_t>(fd[1]) * k)];
+
+          coarse.Scalars[x + static_cast<size_t>(cd[0]) * (y + static_cast<size_t>(cd[1]) * z)] =
+            static_cast<float>(sum / count);
+        }
+      }
+    });
+
+    m_Levels.push_back(std::move(coarse));
+  }
+
+  for (auto &level : m_Levels)
+    this->BuildOctree(level);
+}
+
+void vtkMitkCPUVolumeRayCastMapper::BuildOctree(ResolutionLevel &level)
+{
+  level.Octree.clear();
+
+  const int *dims = level.Dimensions;
+
+  // The leaves store min/max of their voxels including a one voxel border,
+  // which covers everything that trilinear interpolation and central
+  // differences access for positions inside the leaf.
+  OctreeLevel leaves;
+  leaves.NodeSize = LeafSize;
+  for (int d = 0; d < 3; ++d)
+    leaves.Dimensions[d] = (dims[d] + LeafSize - 1) / LeafSize;
+
+  const size_t numberOfLeaves = static_cast<size_t>(leaves.Dimensions[0]) * leaves.Dimensions[1] * leaves.Dimensions[2];
+  leaves.Min.resize(numberOfLeaves);
+  leaves.Max.resize(numberOfLeaves);
+  leaves.NonEmpty.assign(numberOfLeaves, 1);
+
+  mitk::ParallelFor(leaves.Dimensions[2], 0, [&](std::size_t slice) {
+    const int nz = static_cast<int>(slice);
+    for (int ny = 0; ny < leaves.Dimensions[1]; ++ny)
+    {
+      for (int nx = 0; nx < leaves.Dimensions[0]; ++nx)
+      {
+        float minimum = std::numeric_limits<float>::max();
+        float maximum = std::numeric_limits<float>::lowest();
+
+        const int z0 = std::max(nz * LeafSize - 1, 0), z1 = std::min((nz + 1) * LeafSize + 1, dims[2] - 1);
+        const int y0 = std::max(ny * LeafSize - 1, 0), y1 = std::min((ny + 1) * LeafSize + 1, dims[1] - 1);
+        const int x0 = std::max(nx * LeafSize - 1, 0), x1 = std::min((nx + 1) * LeafSize + 1, dims[0] - 1);
+
+        for (int z = z0; z <= z1; ++z)
+        {
+          for (int y = y0; y <= y1; ++y)
+          {
+            const float *row = level.Scalars.data() + static_cast<size_t>(dims[0]) * (y + static_cast<size_t>(dims[1]) * z);
+            for (int x = x0; x <= x1; ++x)
+            {
+              minimum = std::min(minimum, row[x]);
+              maximum = std::max(maximum, row[x]);
+            }
+          }
+        }
+
+        const size_t node = nx + static_cast<size_t>(leaves.Dimensions[0]) * (ny + static_cast<size_t>(leaves.Dimensions[1]) * nz);
+        leaves.Min[node] = minimum;
+        leaves.Max[node] = maximum;
+      }
+    }
+  });
+
+  level.Octree.push_back(std::move(leaves));
+
+  // Inner nodes combine 2x2x2 children until a single root node remains.
+  while (true)
+  {
+    const OctreeLevel &children = level.Octree.back();
+    if (children.Dimensions[0] == 1 && children.Dimensions[1] == 1 && children.Dimensions[2] == 1)
+      break;
+
+    OctreeLevel parents;
+    parents.NodeSize = 2 * children.NodeSize;
+    for (int d = 0; d < 3; ++d)
+      parents.Dimensions[d] = (children.Dimensions[d] + 1) / 2;
+
+    const size_t numberOfNodes = static_cast<size_t>(parents.Dimensions[0]) * parents.Dimensions[1] * parents.Dimensions[2];
+    parents.Min.assign(numberOfNodes, std::numeric_limits<float>::max());
+    parents.Max.assign(numberOfNodes, std::numeric_limits<float>::lowest());
+    parents.NonEmpty.assign(numberOfNodes, 1);
+
+    const int *cd = children.Dimensions;
+    for (int z = 0; z < cd[2]; ++z)
+    {
+      for (int y = 0; y < cd[1]; ++y)
+      {
+        for (int x = 0; x < cd[0]; ++x)
+        {
+          const size_t child = x + static_cast<size_t>(cd[0]) * (y + static_cast<size_t>(cd[1]) * z);
+          const size_t parent =
+            x / 2 + static_cast<size_t>(parents.Dimensions[0]) * (y / 2 + static_cast<size_t>(parents.Dimensions[1]) * (z / 2));
+          parents.Min[parent] = std::min(parents.Min[parent], children.Min[child]);
+          parents.Max[parent] = std::max(parents.Max[parent], children.Max[child]);
+        }
+      }
+    }
+
+    level.Octree.push_back(std::move(parents));
+  }
+}
+
+void vtkMitkCPUVolumeRayCastMapper::UpdateTransferFunctionTables(vtkVolumeProperty *property)
+{
+  m_OpacityTable.resize(TableSize);
+  m_ColorTable.resize(3 * TableSize);
+
+  property->GetScalarOpacity(0)->GetTable(m_ScalarRange[0], m_ScalarRange[1], TableSize, m_OpacityTable.data());
+
+  if (property->GetColorChannels(0) == 1)
+  {
+    std::vector<float> gray(TableSize);
+    property->GetGrayTransferFunction(0)->GetTable(m_ScalarRange[0], m_ScalarRange[1], TableSize, gray.data());
+    for (int i = 0; i < TableSize; ++i)
+      m_ColorTable[3 * i] = m_ColorTable[3 * i + 1] = m_ColorTable[3 * i + 2] = gray[i];
+  }
+  else
+  {
+    property->GetRGBTransferFunction(0)->GetTable(m_ScalarRange[0], m_ScalarRange[1], TableSize, m_ColorTable.data());
+  }
+
+  m_NonZeroOpacityPrefix.resize(TableSize);
+  int count = 0;
+  for (int i = 0; i < TableSize; ++i)
+  {
+    if (m_OpacityTable[i] > 0.0f)
+      ++count;
+    m_NonZeroOpacityPrefix[i] = count;
+  }
+}
+
+void vtkMitkCPUVolumeRayCastMapper::ClassifyOctree(ResolutionLevel &level)
+{
+  const double scale = (TableSize - 1) / (m_ScalarRange[1] - m_ScalarRange[0]);
+
+  // A node is empty if no table entry between its minimum and maximum has a non-zero opacity.
+  for (auto &octreeLevel : level.Octree)
+  {
+    const size_t numberOfNodes = octreeLevel.NonEmpty.size();
+    for (size_t node = 0; node < numberOfNodes; ++node)
+    {
+      const int first =
+        std::min(std::max(static_cast<int>(std::floor((octreeLevel.Min[node] - m_ScalarRange[0]) * scale)), 0), TableSize - 1);
+      const int last =
+        std::min(std::max(static_cast<int>(std::ceil((octreeLevel.Max[node] - m_ScalarRange[0]) * scale)), 0), TableSize - 1);
+
+      const int nonZeroEntries = m_NonZeroOpacityPrefix[last] - (first > 0 ? m_NonZeroOpacityPrefix[first - 1] : 0);
+      octreeLevel.NonEmpty[node] = nonZeroEntries > 0 ? 1 : 0;
+    }
+  }
+}
+
+void vtkMitkCPUVolumeRayCastMapper::UpdateAcceleration(vtkVolumeProperty *property)
+{
+  vtkAlgorithm *inputAlgorithm = this->GetInputAlgorithm();
+  if (inputAlgorithm != nullptr)
+    inputAlgorithm->Update();
+
+  vtkImageData *input = this->GetInput();
+  if (input == nullptr)
+  {
+    m_Levels.clear();
+    return;
+  }
+
+  bool rebuilt = false;
+  if (m_Levels.empty() || input->GetMTime() != m_PyramidBuildTime)
+  {
+    this->BuildPyramid();
+    m_PyramidBuildTime = input->GetMTime();
+    rebuilt = true;
+  }
+
+  if (property == nullptr || m_Levels.empty())
+    return;
+
+  if (rebuilt || property->GetMTime() != m_TransferFunctionTime)
+  {
+    this->UpdateTransferFunctionTables(property);
+    for (auto &level : m_Levels)
+      this->ClassifyOctree(level);
+    m_TransferFunctionTime = property->GetMTime();
+  }
+}
+
+bool vtkMitkCPUVolumeRayCastMapper::FindSkippableNode(const ResolutionLevel &level,
+                                                      const double position[3],
+                                                      bool maximumIntensity,
+                                                      float currentMaximum,
+                                                      double nodeMin[3],
+                                                      double nodeMax[3]) const
+{
+  // Descend from the root: a skippable inner node is skipped as a whole.
+  for (auto octreeLevel = level.Octree.rbegin(); octreeLevel != level.Octree.rend(); ++octreeLevel)
+  {
+    int node[3];
+    for (int d = 0; d < 3; ++d)
+      node[d] = std::min(std::max(static_cast<int>(position[d] / octreeLevel->NodeSize), 0), octreeLevel->Dimensions[d] - 1);
+
+    const size_t index =
+      node[0] + static_cast<size_t>(octreeLevel->Dimensions[0]) * (node[1] + static_cast<size_t>(octreeLevel->Dimensions[1]) * node[2]);
+
+    const bool skippable = maximumIntensity ? octreeLevel->Max[index] <= currentMaximum : !octreeLevel->NonEmpty[index];
+    if (skippable)
+    {
+      for (int d = 0; d < 3; ++d)
+      {
+        nodeMin[d] = node[d] * octreeLevel->NodeSize;
+        nodeMax[d] = (node[d] + 1) * octreeLevel->NodeSize;
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void vtkMitkCPUVolumeRayCastMapper::CastRay(const RayCastParameters &parameters,
+                                            int x,
+                                            int y,
+                                            unsigned char *pixel) const
+{
+  pixel[0] = pixel[1] = pixel[2] = pixel[3] = 0;
+
+  const ResolutionLevel &level = *parameters.Level;
+  const int *dims = level.Dimensions;
+
+  // Ray from the near to the far plane in index coordinates of the level.
+  const double ndcX = 2.0 * (x + 0.5) / parameters.ViewportImageSize[0] - 1.0;
+  const double ndcY = 2.0 * (y + 0.5) / parameters.ViewportImageSize[1] - 1.0;
+  const double nearView[4] = {ndcX, ndcY, -1.0, 1.0};
+  const double farView[4] = {ndcX, ndcY, 1.0, 1.0};
+  double nearPoint[4], farPoint[4];
+  MultiplyPoint(parameters.ViewToIndex, nearView, nearPoint);
+  MultiplyPoint(parameters.ViewToIndex, farView, farPoint);
+  if (nearPoint[3] == 0.0 || farPoint[3] == 0.0)
+    return;
+
+  double origin[3], direction[3];
+  for (int d = 0; d < 3; ++d)
+  {
+    origin[d] = nearPoint[d] / nearPoint[3];
+    direction[d] = farPoint[d] / farPoint[3] - origin[d];
+  }
+
+  const double length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+  if (length == 0.0)
+    return;
+  for (auto &component : direction)
+    component /= length;
+
+  // Clip the ray against the volume [0, dim - 1] (slab method).
+  double tStart = 0.0;
+  double tEnd = length;
+  for (int d = 0; d < 3; ++d)
+  {
+    const double upper = dims[d] - 1;
+    if (std::abs(direction[d]) < 1e-12)
+    {
+      if (origin[d] < 0.0 || origin[d] > upper)
+        return;
+      continue;
+    }
+
+    double t0 = -origin[d] / direction[d];
+    double t1 = (upper - origin[d]) / direction[d];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    tStart = std::max(tStart, t0);
+    tEnd = std::min(tEnd, t1);
+  }
+
+  if (tStart > tEnd)
+    return;
+
+  const double step = parameters.Step;
+  const double scale = parameters.TableScale;
+  const float *colorTable = m_ColorTable.data();
+  const float *opacityTable = parameters.CorrectedOpacity.data();
+
+  double color[3] = {0.0, 0.0, 0.0};
+  double alpha = 0.0;
+  float maximum = std::numeric_limits<float>::lowest();
+  bool hasMaximum = false;
+
+  double position[3];
+  double nodeMin[3], nodeMax[3];
+
+  double t = tStart;
+  while (t <= tEnd)
+  {
+    for (int d = 0; d < 3; ++d)
+      position[d] = origin[d] + t * direction[d];
+
+    if (this->FindSkippableNode(level, position, parameters.MaximumIntensity, maximum, nodeMin, nodeMax))
+    {
+      // Advance to the exit of the node and snap to the sampling grid of the ray.
+      double tExit = std::numeric_limits<double>::max();
+      for (int d = 0; d < 3; ++d)
+      {
+        if (direction[d] > 1e-12)
+          tExit = std::min(tExit, (nodeMax[d] - position[d]) / direction[d]);
+        else if (direction[d] < -1e-12)
+          tExit = std::min(tExit, (nodeMin[d] - position[d]) / direction[d]);
+      }
+
+      const double next = t + std::max(tExit, 0.0) + 1e-6;
+      t = tStart + std::ceil((next - tStart) / step) * step;
+      continue;
+    }
+
+    const float value = SampleTrilinear(level.Scalars.data(), dims, position);
+
+    if (parameters.MaximumIntensity)
+    {
+      if (!hasMaximum || value > maximum)
+      {
+        maximum = value;
+        hasMaximum = true;
+      }
+    }
+    else
+    {
+      const int entry = std::min(std::max(static_cast<int>((value - m_ScalarRange[0]) * scale + 0.5), 0), TableSize - 1);
+      const double sampleAlpha = opacityTable[entry];
+
+      if (sampleAlpha > 0.0)
+      {
+        double shading = 1.0;
+        double highlight = 0.0;
+
+        if (parameters.Shade)
+        {
+          double gradient[3];
+          for (int d = 0; d < 3; ++d)
+          {
+            double forward[3] = {position[0], position[1], position[2]};
+            double backward[3] = {position[0], position[1], position[2]};
+            forward[d] = std::min(forward[d] + 1.0, static_cast<double>(dims[d] - 1));
+            backward[d] = std::max(backward[d] - 1.0, 0.0);
+            gradient[d] = SampleTrilinear(level.Scalars.data(), dims, forward) -
+                          SampleTrilinear(level.Scalars.data(), dims, backward);
+          }
+
+          const double magnitude =
+            std::sqrt(gradient[0] * gradient[0] + gradient[1] * gradient[1] + gradient[2] * gradient[2]);
+          if (magnitude > 0.0)
+          {
+            // Headlight: the light direction is the viewing direction.
+            const double cosine =
+              std::abs(gradient[0] * direction[0] + gradient[1] * direction[1] + gradient[2] * direction[2]) / magnitude;
+            shading = parameters.Ambient + parameters.Diffuse * cosine;
+            highlight = parameters.Specular * std::pow(cosine, parameters.SpecularPower);
+          }
+          else
+          {
+            shading = parameters.Ambient + parameters.Diffuse;
+          }
+        }
+
+        const double weight = (1.0 - alpha) * sampleAlpha;
+        for (int c = 0; c < 3; ++c)
+          color[c] += weight * std::min(colorTable[3 * entry + c] * shading + highlight, 1.0);
+        alpha += weight;
+
+        // early ray termination
+        if (alpha > 0.99)
+          break;
+      }
+    }
+
+    t += step;
+  }
+
+  if (parameters.MaximumIntensity)
+  {
+    if (!hasMaximum)
+      return;
+
+    const int entry = std::min(std::max(static_cast<int>((maximum - m_ScalarRange[0]) * scale + 0.5), 0), TableSize - 1);
+    alpha = m_OpacityTable[entry];
+    for (int c = 0; c < 3; ++c)
+      color[c] = colorTable[3 * entry + c] * alpha;
+  }
+
+  // premultiplied colors
+  for (int c = 0; c < 3; ++c)
+    pixel[c] = static_cast<unsigned char>(std::min(color[c], 1.0) * 255.0 + 0.5);
+  pixel[3] = static_cast<unsigned char>(std::min(alpha, 1.0) * 255.0 + 0.5);
+}
+
+void vtkMitkCPUVolumeRayCastMapper::Render(vtkRenderer *renderer, vtkVolume *volume)
+{
+  vtkVolumeProperty *property = volume->GetProperty();
+  this->UpdateAcceleration(property);
+
+  vtkImageData *input = this->GetInput();
+  if (m_Levels.empty() || input == nullptr || property == nullptr || m_ImageDisplayHelper == nullptr)
+    return;
+
+  const bool interactive = this->LevelOfDetail == 0;
+  const int levelIndex = this->GetRenderedResolutionLevel();
+  const double imageSampleDistance = interactive ? this->InteractiveImageSampleDistance : 1.0;
+  const ResolutionLevel &level = m_Levels[levelIndex];
+
+  int viewportSize[2], viewportOrigin[2];
+  renderer->GetTiledSizeAndOrigin(&viewportSize[0], &viewportSize[1], &viewportOrigin[0], &viewportOrigin[1]);
+  if (viewportSize[0] <= 0 || viewportSize[1] <= 0)
+    return;
+
+  // level index -> base index -> model -> world -> view
+  const double levelScale = static_cast<double>(1 << levelIndex);
+  double *spacing = input->GetSpacing();
+  double *inputOrigin = input->GetOrigin();
+
+  vtkSmartPointer<vtkMatrix4x4> levelToModel = vtkSmartPointer<vtkMatrix4x4>::New();
+  for (int d = 0; d < 3; ++d)
+  {
+    levelToModel->SetElement(d, d, spacing[d] * levelScale);
+    levelToModel->SetElement(d, 3, inputOrigin[d] + spacing[d] * 0.5 * (levelScale - 1.0));
+  }
+
+  const double aspect = static_cast<double>(viewportSize[0]) / viewportSize[1];
+  vtkSmartPointer<vtkMatrix4x4> levelToView = vtkSmartPointer<vtkMatrix4x4>::New();
+  vtkMatrix4x4::Multiply4x4(volume->GetMatrix(), levelToModel, levelToView);
+  vtkMatrix4x4::Multiply4x4(
+    renderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(aspect, -1.0, 1.0), levelToView, levelToView);
+
+  vtkSmartPointer<vtkMatrix4x4> viewToLevel = vtkSmartPointer<vtkMatrix4x4>::New();
+  vtkMatrix4x4::Invert(levelToView, viewToLevel);
+
+  RayCastParameters parameters;
+  parameters.Level = &level;
+  std::copy(&viewToLevel->Element[0][0], &viewToLevel->Element[0][0] + 16, parameters.ViewToIndex);
+  parameters.ViewportImageSize[0] = std::max(1, static_cast<int>(std::ceil(viewportSize[0] / imageSampleDistance)));
+  parameters.ViewportImageSize[1] = std::max(1, static_cast<int>(std::ceil(viewportSize[1] / imageSampleDistance)));
+  parameters.Step = this->SampleDistance;
+  parameters.MaximumIntensity = this->GetBlendMode() == vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND;
+  parameters.Shade = property->GetShade(0) != 0;
+  parameters.Ambient = property->GetAmbient(0);
+  parameters.Diffuse = property->GetDiffuse(0);
+  parameters.Specular = property->GetSpecular(0);
+  parameters.SpecularPower = property->GetSpecularPower(0);
+  parameters.TableScale = (TableSize - 1) / (m_ScalarRange[1] - m_ScalarRange[0]);
+
+  // Opacity correction for the sample distance, measured in voxels of the full resolution level.
+  const double unitDistance = std::max(property->GetScalarOpacityUnitDistance(0), 1e-6);
+  const double exponent = this->SampleDistance * levelScale / unitDistance;
+  parameters.CorrectedOpacity.resize(TableSize);
+  for (int i = 0; i < TableSize; ++i)
+    parameters.CorrectedOpacity[i] = static_cast<float>(1.0 - std::pow(1.0 - std::min(m_OpacityTable[i], 1.0f), exponent));
+
+  // Only cast rays within the projected bounding box of the volume.
+  int imageMin[2] = {parameters.ViewportImageSize[0], parameters.ViewportImageSize[1]};
+  int imageMax[2] = {-1, -1};
+  bool cornerBehindCamera = false;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    const double point[4] = {(corner & 1) ? level.Dimensions[0] - 0.5 : -0.5,
+                             (corner & 2) ? level.Dimensions[1] - 0.5 : -0.5,
+                             (corner & 4) ? level.Dimensions[2] - 0.5 : -0.5,
+                             1.0};
+    double view[4];
+    levelToView->MultiplyPoint(point, view);
+    if (view[3] <= 0.0)
+    {
+      cornerBehindCamera = true;
+      break;
+    }
+
+    for (int d = 0; d < 2; ++d)
+    {
+      const double imageCoordinate = (view[d] / view[3] + 1.0) * 0.5 * parameters.ViewportImageSize[d];
+      imageMin[d] = std::min(imageMin[d], static_cast<int>(std::floor(imageCoordinate)));
+      imageMax[d] = std::max(imageMax[d], static_cast<int>(std::ceil(imageCoordinate)));
+    }
+  }
+
+  if (cornerBehindCamera)
+  {
+    imageMin[0] = imageMin[1] = 0;
+    imageMax[0] = parameters.ViewportImageSize[0] - 1;
+    imageMax[1] = parameters.ViewportImageSize[1] - 1;
+  }
+
+  for (int d = 0; d < 2; ++d)
+  {
+    imageMin[d] = std::max(imageMin[d], 0);
+    imageMax[d] = std::min(imageMax[d], parameters.ViewportImageSize[d] - 1);
+    if (imageMax[d] < imageMin[d])
+      return;
+  }
+
+  int imageInUseSize[2] = {imageMax[0] - imageMin[0] + 1, imageMax[1] - imageMin[1] + 1};
+  int imageMemorySize[2] = {imageInUseSize[0], imageInUseSize[1]};
+  m_Image.assign(static_cast<size_t>(imageMemorySize[0]) * imageMemorySize[1] * 4, 0);
+
+  const int tilesX = (imageInUseSize[0] + TileSize - 1) / TileSize;
+  const int tilesY = (imageInUseSize[1] + TileSize - 1) / TileSize;
+  const int numberOfTiles = tilesX * tilesY;
+
+  // Tiles are processed in parallel; rays within a tile are coherent and share octree nodes.
+  mitk::ParallelFor(numberOfTiles, static_cast<unsigned int>(this->NumberOfThreads), [&](std::size_t tile) {
+    const int tileX = static_cast<int>(tile % tilesX) * TileSize;
+    const int tileY = static_cast<int>(tile / tilesX) * TileSize;
+
+    for (int y = tileY; y < std::min(tileY + TileSize, imageInUseSize[1]); ++y)
+    {
+      for (int x = tileX; x < std::min(tileX + TileSize, imageInUseSize[0]); ++x)
+      {
+        unsigned char *pixel = m_Image.data() + 4 * (x + static_cast<size_t>(imageMemorySize[0]) * y);
+        this->CastRay(parameters, imageMin[0] + x, imageMin[1] + y, pixel);
+      }
+    }
+  });
+
+  m_ImageDisplayHelper->RenderTexture(
+    volume, renderer, imageMemorySize, parameters.ViewportImageSize, imageInUseSize, imageMin, -1.0f, m_Image.data());
+}
+
+void vtkMitkCPUVolumeRayCastMapper::ReleaseGraphicsResources(vtkWindow *window)
+{
+  if (m_ImageDisplayHelper != nullptr)
+    m_ImageDisplayHelper->ReleaseGraphicsResources(window);
+}
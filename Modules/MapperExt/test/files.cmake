@@ -1,3 +1,4 @@
 set(MODULE_TESTS
   mitkSplineVtkMapper3DTest.cpp
+  mitkVolumeMapperVtkSmart3DTest.cpp
 )
@@ -0,0 +1,98 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkDataNode.h>
+#include <mitkImage.h>
+#include <mitkVolumeMapperVtkSmart3D.h>
+#include <vtkMitkCPUVolumeRayCastMapper.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+class mitkVolumeMapperVtkSmart3DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkVolumeMapperVtkSmart3DTestSuite);
+  MITK_TEST(IsLODEnabled_FollowsProperty);
+  MITK_TEST(LevelOfDetail_SelectsResolutionLevel);
+  MITK_TEST(InteractiveResolutionLevel_LimitedByPyramid);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  vtkSmartPointer<vtkMitkCPUVolumeRayCastMapper> m_RayCastMapper;
+
+public:
+  void setUp() override
+  {
+    // a 32x32x32 volume results in pyramid levels of 32, 16 and 8 voxels
+    auto volume = vtkSmartPointer<vtkImageData>::New();
+    volume->SetDimensions(32, 32, 32);
+    volume->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto *scalars = static_cast<unsigned char *>(volume->GetScalarPointer());
+    for (vtkIdType i = 0; i < volume->GetNumberOfPoints(); ++i)
+      scalars[i] = static_cast<unsigned char>(i % 256);
+
+    m_RayCastMapper = vtkSmartPointer<vtkMitkCPUVolumeRayCastMapper>::New();
+    m_RayCastMapper->SetInputData(volume);
+    m_RayCastMapper->UpdateAcceleration(nullptr);
+  }
+
+  void tearDown() override { m_RayCastMapper = nullptr; }
+
+  void IsLODEnabled_FollowsProperty()
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[] = {8, 8, 8};
+    image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    auto node = mitk::DataNode::New();
+    node->SetData(image);
+
+    auto mapper = mitk::VolumeMapperVtkSmart3D::New();
+    mapper->SetDataNode(node);
+
+    CPPUNIT_ASSERT_MESSAGE("LOD is disabled without property", !mapper->IsLODEnabled(nullptr));
+
+    node->SetBoolProperty("volumerendering.uselod", true);
+    CPPUNIT_ASSERT_MESSAGE("LOD is enabled by the property", mapper->IsLODEnabled(nullptr));
+
+    node->SetBoolProperty("volumerendering.uselod", false);
+    CPPUNIT_ASSERT_MESSAGE("LOD is disabled by the property", !mapper->IsLODEnabled(nullptr));
+  }
+
+  void LevelOfDetail_SelectsResolutionLevel()
+  {
+    CPPUNIT_ASSERT_EQUAL(3, m_RayCastMapper->GetNumberOfResolutionLevels());
+
+    m_RayCastMapper->SetInteractiveResolutionLevel(1);
+
+    m_RayCastMapper->SetLevelOfDetail(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Interactive level of detail renders the coarse level",
+                                 1, m_RayCastMapper->GetRenderedResolutionLevel());
+
+    m_RayCastMapper->SetLevelOfDetail(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Final level of detail renders the full resolution",
+                                 0, m_RayCastMapper->GetRenderedResolutionLevel());
+  }
+
+  void InteractiveResolutionLevel_LimitedByPyramid()
+  {
+    m_RayCastMapper->SetInteractiveResolutionLevel(8);
+    m_RayCastMapper->SetLevelOfDetail(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Coarsest available level is rendered",
+                                 2, m_RayCastMapper->GetRenderedResolutionLevel());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkVolumeMapperVtkSmart3D)
@@ -22,6 +22,7 @@ set(CPP_FILES
   Common/mitkModelFitParameterValueExtraction.cpp
   Common/mitkBinaryImageToLabelSetImageFilter.cpp
   Common/mitkFormulaParser.cpp
+  Common/mitkCompiledFormula.cpp
   Common/mitkFresnel.cpp
   Common/mitkModelFitPlotDataHelper.cpp
   Common/mitkModelSignalImageGenerator.cpp
@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __MITKCOMPILEDFORMULA_H__
+#define __MITKCOMPILEDFORMULA_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MitkModelFitExports.h"
+
+namespace mitk
+{
+  /*!
+   *	@brief		A formula string that is parsed once and can then be evaluated many times.
+   *	@details	The formula uses the language of the FormulaParser (sums, differences,
+   *				products, divisions, algebraic signs, parentheses, numbers, variables and the
+   *				unary functions @c abs, @c exp, @c sin, @c cos, @c tan, @c sind, @c cosd,
+   *				@c tand, @c fresnelS and @c fresnelC).
+   *
+   *				The formula is parsed into a syntax tree, constant sub expressions are folded
+   *				and the tree is translated to a stack program. EvaluateSamples() runs every
+   *				instruction of the program over a whole block of samples (e.g. the time grid
+   *				of a model), so the evaluation does not have to be repeated per sample.
+   *
+   *				Derive() returns the analytic partial derivative of the formula with respect
+   *				to one of its variables as a new CompiledFormula.
+   *
+   *				Variables are referenced by their index in the list of variable names given
+   *				for compilation. Instances are immutable and can be evaluated concurrently.
+   */
+  class MITKMODELFIT_EXPORT CompiledFormula
+  {
+  public:
+    using ValueType = double;
+    using VariableNamesType = std::vector<std::string>;
+
+    /*! @brief Constructs the formula "0" without variables. */
+    CompiledFormula();
+
+    /*!
+     *	@brief	Compiles the formula.
+     *	@param[in] formula			The formula string.
+     *	@param[in] variableNames	The names of the variables that may be used in the formula.
+     *	@throw FormulaParserException	If the formula cannot be parsed or uses an unknown
+     *								variable or function.
+     */
+    CompiledFormula(const std::string &formula, const VariableNamesType &variableNames);
+
+    const VariableNamesType &GetVariableNames() const;
+
+    /*! @brief Checks whether the value of the formula does not depend on any variable. */
+    bool IsConstant() const;
+
+    /*! @brief Number of instructions of the stack program. */
+    std::size_t GetNumberOfInstructions() const;
+
+    /*!
+     *	@brief	Evaluates the formula.
+     *	@param[in] values	The values of the variables, in the order of GetVariableNames().
+     */
+    ValueType Evaluate(const ValueType *values) const;
+
+    /*!
+     *	@brief	Evaluates the formula for @b numberOfSamples values of one variable.
+     *	@param[in] values			The values of the variables, in the order of GetVariableNames().
+     *	@param[in] sampledVariable	Index of the variable whose values are taken from @b samples
+     *								(its entry in @b values is ignored).
+     *	@param[in] samples			The values of the sampled variable.
+     *	@param[in] numberOfSamples	The number of samples.
+     *	@param[out] result			Receives the @b numberOfSamples results.
+     */
+    void EvaluateSamples(const ValueType *values,
+                         std::size_t sampledVariable,
+                         const ValueType *samples,
+                         std::size_t numberOfSamples,
+                         ValueType *result) const;
+
+    /*!
+     *	@brief	Returns the partial derivative of the formula with respect to the given variable.
+     *	@details	The derivative of @c abs at 0 is taken to be 0.
+     */
+    CompiledFormula Derive(std::size_t variable) const;
+
+  private:
+    class Impl;
+    explicit CompiledFormula(std::shared_ptr<const Impl> impl);
+
+    std::shared_ptr<const Impl> m_Impl;
+  };
+}
+
+#endif
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define __MITK_GENERIC_PARAM_MODEL_H_
 
 #include "mitkModelBase.h"
+#include "mitkCompiledFormula.h"
 
 #include "MitkModelFitExports.h"
 
@@ -26,11 +27,15 @@ namespace mitk
   The parser is able to recognize:
   - sums, differences, products and divisions (a + b, 4 - 3, 2 * x, 9 / 3)
   - algebraic signs ( +5, -5)
-  - exponentiation ( 2 ^ 4 )
   - parentheses (3 * (4 + 2))
-  - following unary functions: abs, exp, sin, cos, tan, sind (sine in degrees), cosd (cosine in degrees), tand (tangent in degrees)
+  - following unary functions: abs, exp, sin, cos, tan, sind (sine in degrees), cosd (cosine in degrees), tand (tangent in degrees),
+    fresnelS, fresnelC
   - variables (x, a, b, ... j)
 
+  The function string is compiled (see CompiledFormula) when it or the number of parameters is set, the model function
+  then evaluates the compiled formula over the whole time grid. If the string cannot be compiled, the model is invalid
+  and GetSignal() throws with the reason of the parser.
+
   Remark: The variable "x" is reserved. It is the signal position / timepoint.
   Remark: The current version supports up to 10 model parameter.
   Don't use it for a model parameter that should be deduced by fitting (these are a..j).*/
@@ -60,10 +65,11 @@ namespace mitk
     std::string GetModelType() const override;
 
     FunctionStringType GetFunctionString() const override;
-    itkSetStringMacro(FunctionString);
+    void SetFunctionString(const char* functionString);
+    void SetFunctionString(const std::string& functionString);
 
     /**@pre The Number of paremeters must be between 1 and 10.*/
-    itkSetClampMacro(NumberOfParameters, ParametersSizeType, 1, 10);
+    void SetNumberOfParameters(ParametersSizeType numberOfParameters);
 
     std::string GetXName() const override;
 
@@ -75,6 +81,15 @@ namespace mitk
 
     ParametersSizeType GetNumberOfStaticParameters() const override;
 
+    /** Computes the partial derivatives of the model function with respect to the parameters
+     * at every time point of the time grid (rows: time points, columns: parameters). The derivatives
+     * are analytic derivatives of the compiled function string.
+     * @pre The model must be valid (see ValidateModel()).*/
+    JacobianType ComputeModelJacobian(const ParametersType& parameters) const;
+
+    /** Returns true if the function string could be compiled.*/
+    bool ProvidesJacobian() const override;
+
   protected:
     GenericParamModel();
     ~GenericParamModel() override {};
@@ -87,6 +102,12 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Returns false if the function string could not be compiled.*/
+    bool ValidateModel(std::string& error) const override;
+
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         JacobianType& jacobian) const override;
+
     void SetStaticParameter(const ParameterNameType& name,
                                     const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
@@ -98,6 +119,19 @@ namespace mitk
     /**Number of parameters the model should offer / the function string contains.*/
     ParametersSizeType m_NumberOfParameters;
 
+    /**Compiles m_FunctionString for the current number of parameters.*/
+    void CompileFunctionString();
+
+    /**Copies x and the parameters into the variable vector of the compiled formula.*/
+    std::vector<double> GetFormulaVariables(const ParametersType& parameters) const;
+
+    /**Compiled function string (variables: x, a, b, ...) and its derivatives with respect to the parameters.*/
+    CompiledFormula m_Formula;
+    std::vector<CompiledFormula> m_Derivatives;
+
+    /**Reason why m_FunctionString could not be compiled, empty if it was compiled.*/
+    std::string m_FormulaError;
+
     //No copy constructor allowed
     GenericParamModel(const Self& source);
     void operator=(const Self&);  //purposely not implemented
@@ -33,6 +33,8 @@ namespace mitk
  * can always be accounted as a failure if the sum of penalties given by the checker
  * is greater or equal to the threshold. If the evaluation is a failure the wrapped cost function
  * will not be evaluated. Otherwise the penalty will be added to every measure of the cost function.
+ * If the decorator and the wrapped cost function use the same model, the signal computed by the
+ * decorator is passed to the wrapped cost function, so the model is evaluated once per value.
  */
 class MITKMODELFIT_EXPORT MVConstrainedCostFunctionDecorator : public mitk::MVModelFitCostFunction
 {
@@ -58,6 +58,14 @@ protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
+    /** Computes the derivative of the measure with respect to the parameters from the signal and the
+     * Jacobian of the signal (see ModelBase::GetSignalAndJacobian()). Used by GetDerivative() if the
+     * model provides a Jacobian.
+     * @return false if the measure does not support analytic derivatives; then GetDerivative() uses
+     * central differences. The default implementation returns false.*/
+    virtual bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                                       const ModelBase::JacobianType& signalJacobian, DerivativeType& derivative) const;
+
     MVModelFitCostFunction() : m_DerivativeStepLength(1e-5)
     {
     }
@@ -67,6 +75,9 @@ protected:
     SignalType m_Sample;
 
 private:
+    /** The decorator passes the signal it has computed to the wrapped cost function. */
+    friend class MVConstrainedCostFunctionDecorator;
+
     ModelBase::ConstPointer m_Model;
 
     /**value (delta of parameters) used to compute the derivatives numerically*/
@@ -74,6 +74,10 @@ namespace mitk
     typedef double DerivedParameterValueType;
     typedef std::map<ParameterNameType, DerivedParameterValueType> DerivedParameterMapType;
 
+    /** Partial derivatives of the signal with respect to the parameters.
+     * Rows correspond to the time points of the time grid, columns to the parameters.*/
+    typedef itk::Array2D<double> JacobianType;
+
     /**Default implementation returns a scale of 1.0 for every defined parameter.*/
     ParamterScaleMapType GetParameterScales() const override;
 
@@ -168,10 +172,34 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Computes the signals of several parameter sets at once (e.g. all parameter sets needed for a
+     * numerical derivative). Models that can evaluate several parameter sets more efficiently
+     * than one after another reimplement ComputeModelfunctions().
+     * @pre every parameter set must have the size GetNumberOfParameters().*/
+    std::vector<ModelResultType> GetSignals(const std::vector<ParametersType>& parameters) const;
+
+    /** Indicates if the model can compute the partial derivatives of its signal with respect to
+     * the parameters analytically (see GetSignalAndJacobian()). The default implementation returns false.*/
+    virtual bool ProvidesJacobian() const;
+
+    /** Computes the signal and its partial derivatives with respect to the parameters.
+     * @pre ProvidesJacobian() must return true.
+     * @pre parameters must have the size GetNumberOfParameters().*/
+    void GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal, JacobianType& jacobian) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Called by GetSignals() after the model was validated. The default implementation calls
+     * ComputeModelfunction() for every parameter set.*/
+    virtual std::vector<ModelResultType> ComputeModelfunctions(const std::vector<ParametersType>& parameters) const;
+
+    /** Called by GetSignalAndJacobian() after the model was validated. Reimplement together with ProvidesJacobian().
+     * The default implementation throws an exception.*/
+    virtual void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                                 JacobianType& jacobian) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
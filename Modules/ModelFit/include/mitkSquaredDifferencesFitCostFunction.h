@@ -40,6 +40,9 @@ protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
 
+    bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                               const ModelBase::JacobianType& signalJacobian, DerivativeType& derivative) const override;
+
     SquaredDifferencesFitCostFunction()
     {
     }
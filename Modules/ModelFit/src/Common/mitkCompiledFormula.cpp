@@ -0,0 +1,768 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompiledFormula.h"
+#include "mitkFormulaParser.h"
+#include "mitkFresnel.h"
+
+#include <boost/math/constants/constants.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <locale>
+#include <sstream>
+
+namespace
+{
+  using ValueType = mitk::CompiledFormula::ValueType;
+
+  enum class Op
+  {
+    Constant,
+    Variable,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Negate,
+    Abs,
+    Sign,
+    Exp,
+    Sin,
+    Cos,
+    Tan,
+    Sind,
+    Cosd,
+    Tand,
+    FresnelS,
+    FresnelC
+  };
+
+  bool IsBinary(Op op) { return op >= Op::Add && op <= Op::Divide; }
+
+  bool IsUnary(Op op) { return op >= Op::Negate; }
+
+  const ValueType DegToRad = boost::math::constants::pi<ValueType>() / static_cast<ValueType>(180);
+
+  inline ValueType ApplyUnary(Op op, ValueType value)
+  {
+    switch (op)
+    {
+      case Op::Negate:
+        return -value;
+      case Op::Abs:
+        return std::abs(value);
+      case Op::Sign:
+        return static_cast<ValueType>((value > 0) - (value < 0));
+      case Op::Exp:
+        return std::exp(value);
+      case Op::Sin:
+        return std::sin(value);
+      case Op::Cos:
+        return std::cos(value);
+      case Op::Tan:
+        return std::tan(value);
+      case Op::Sind:
+        return std::sin(value * DegToRad);
+      case Op::Cosd:
+        return std::cos(value * DegToRad);
+      case Op::Tand:
+        return std::tan(value * DegToRad);
+      case Op::FresnelS:
+        return static_cast<ValueType>(
+          mitk::fresnel_s(value / boost::math::constants::root_half_pi<ValueType>()) /
+          boost::math::constants::root_two_div_pi<ValueType>());
+      case Op::FresnelC:
+        return static_cast<ValueType>(
+          mitk::fresnel_c(value / boost::math::constants::root_half_pi<ValueType>()) /
+          boost::math::constants::root_two_div_pi<ValueType>());
+      default:
+        return value;
+    }
+  }
+
+  inline ValueType ApplyBinary(Op op, ValueType left, ValueType right)
+  {
+    switch (op)
+    {
+      case Op::Add:
+        return left + right;
+      case Op::Subtract:
+        return left - right;
+      case Op::Multiply:
+        return left * right;
+      case Op::Divide:
+        return left / right;
+      default:
+        return left;
+    }
+  }
+
+  /** Node of the syntax tree. Nodes are immutable and may be shared between trees (e.g. a derivative and its formula). */
+  struct Node;
+  using NodePointer = std::shared_ptr<const Node>;
+
+  struct Node
+  {
+    Op op;
+    ValueType value;
+    std::size_t variable;
+    NodePointer left;
+    NodePointer right;
+  };
+
+  bool IsConstant(const NodePointer &node, ValueType value)
+  {
+    return node->op == Op::Constant && node->value == value;
+  }
+
+  NodePointer MakeConstant(ValueType value)
+  {
+    return std::make_shared<const Node>(Node{Op::Constant, value, 0, nullptr, nullptr});
+  }
+
+  NodePointer MakeVariable(std::size_t variable)
+  {
+    return std::make_shared<const Node>(Node{Op::Variable, 0, variable, nullptr, nullptr});
+  }
+
+  /** Creates a unary node; constant arguments are folded. */
+  NodePointer MakeUnary(Op op, const NodePointer &argument)
+  {
+    if (argument->op == Op::Constant)
+      return MakeConstant(ApplyUnary(op, argument->value));
+
+    if (op == Op::Negate && argument->op == Op::Negate)
+      return argument->left;
+
+    return std::make_shared<const Node>(Node{op, 0, 0, argument, nullptr});
+  }
+
+  /** Creates a binary node; constant operands are folded and neutral elements are removed.
+   * Products with 0 are kept, because 0 * inf and 0 * nan are not 0. */
+  NodePointer MakeBinary(Op op, const NodePointer &left, const NodePointer &right)
+  {
+    if (left->op == Op::Constant && right->op == Op::Constant)
+      return MakeConstant(ApplyBinary(op, left->value, right->value));
+
+    switch (op)
+    {
+      case Op::Add:
+        if (IsConstant(left, 0))
+          return right;
+        if (IsConstant(right, 0))
+          return left;
+        break;
+      case Op::Subtract:
+        if (IsConstant(right, 0))
+          return left;
+        if (IsConstant(left, 0))
+          return MakeUnary(Op::Negate, right);
+        break;
+      case Op::Multiply:
+        if (IsConstant(left, 1))
+          return right;
+        if (IsConstant(right, 1))
+          return left;
+        if (IsConstant(left, -1))
+          return MakeUnary(Op::Negate, right);
+        if (IsConstant(right, -1))
+          return MakeUnary(Op::Negate, left);
+        break;
+      case Op::Divide:
+        if (IsConstant(right, 1))
+          return left;
+        break;
+      default:
+        break;
+    }
+
+    return std::make_shared<const Node>(Node{op, 0, 0, left, right});
+  }
+
+  /** Partial derivative of node with respect to variable. nullptr stands for a derivative that is 0 everywhere. */
+  NodePointer Derive(const NodePointer &node, std::size_t variable)
+  {
+    const Op op = node->op;
+
+    if (op == Op::Constant)
+      return nullptr;
+
+    if (op == Op::Variable)
+      return node->variable == variable ? MakeConstant(1) : nullptr;
+
+    const NodePointer &u = node->left;
+    const NodePointer &v = node->right;
+    const NodePointer du = Derive(u, variable);
+    const NodePointer dv = IsBinary(op) ? Derive(v, variable) : nullptr;
+
+    switch (op)
+    {
+      case Op::Add:
+        if (!du)
+          return dv;
+        return dv ? MakeBinary(Op::Add, du, dv) : du;
+      case Op::Subtract:
+        if (!du)
+          return dv ? MakeUnary(Op::Negate, dv) : nullptr;
+        return dv ? MakeBinary(Op::Subtract, du, dv) : du;
+      case Op::Multiply:
+      {
+        const NodePointer left = du ? MakeBinary(Op::Multiply, du, v) : nullptr;
+        const NodePointer right = dv ? MakeBinary(Op::Multiply, u, dv) : nullptr;
+        if (!left)
+          return right;
+        return right ? MakeBinary(Op::Add, left, right) : left;
+      }
+      case Op::Divide:
+      {
+        // (u/v)' = u'/v - u*v'/(v*v)
+        const NodePointer left = du ? MakeBinary(Op::Divide, du, v) : nullptr;
+        const NodePointer right =
+          dv ? MakeBinary(Op::Divide, MakeBinary(Op::Multiply, u, dv), MakeBinary(Op::Multiply, v, v)) : nullptr;
+        if (!left)
+          return right ? MakeUnary(Op::Negate, right) : nullptr;
+        return right ? MakeBinary(Op::Subtract, left, right) : left;
+      }
+      case Op::Negate:
+        return du ? MakeUnary(Op::Negate, du) : nullptr;
+      case Op::Sign:
+        return nullptr;
+      default:
+        break;
+    }
+
+    if (!du)
+      return nullptr;
+
+    // outer derivative of the unary functions
+    NodePointer outer;
+    switch (op)
+    {
+      case Op::Abs:
+        outer = MakeUnary(Op::Sign, u);
+        break;
+      case Op::Exp:
+        outer = node;
+        break;
+      case Op::Sin:
+        outer = MakeUnary(Op::Cos, u);
+        break;
+      case Op::Cos:
+        outer = MakeUnary(Op::Negate, MakeUnary(Op::Sin, u));
+        break;
+      case Op::Tan:
+      {
+        const NodePointer cos = MakeUnary(Op::Cos, u);
+        outer = MakeBinary(Op::Divide, MakeConstant(1), MakeBinary(Op::Multiply, cos, cos));
+        break;
+      }
+      case Op::Sind:
+        outer = MakeBinary(Op::Multiply, MakeConstant(DegToRad), MakeUnary(Op::Cosd, u));
+        break;
+      case Op::Cosd:
+        outer = MakeBinary(Op::Multiply, MakeConstant(-DegToRad), MakeUnary(Op::Sind, u));
+        break;
+      case Op::Tand:
+      {
+        const NodePointer cos = MakeUnary(Op::Cosd, u);
+        outer = MakeBinary(Op::Divide, MakeConstant(DegToRad), MakeBinary(Op::Multiply, cos, cos));
+        break;
+      }
+      case Op::FresnelS:
+        outer = MakeUnary(Op::Sin, MakeBinary(Op::Multiply, u, u));
+        break;
+      case Op::FresnelC:
+        outer = MakeUnary(Op::Cos, MakeBinary(Op::Multiply, u, u));
+        break;
+      default:
+        mitkThrowException(mitk::FormulaParserException) << "Cannot derive the operation " << static_cast<int>(op);
+    }
+
+    return MakeBinary(Op::Multiply, outer, du);
+  }
+
+  /** Recursive descent parser for the language of mitk::FormulaParser that creates the syntax tree. */
+  class Parser
+  {
+  public:
+    Parser(const std::string &input, const mitk::CompiledFormula::VariableNamesType &variableNames)
+      : m_Input(input), m_VariableNames(variableNames), m_Position(0)
+    {
+    }
+
+    NodePointer Parse()
+    {
+      this->SkipSpaces();
+      if (this->AtEnd())
+      {
+        mitkThrowException(mitk::FormulaParserException)
+          << "Could not parse '" << m_Input << "': Grammar could not be applied to the input at all.";
+      }
+
+      NodePointer result = this->ParseExpression();
+
+      if (!this->AtEnd())
+        this->ThrowUnexpected();
+
+      return result;
+    }
+
+  private:
+    bool AtEnd() const { return m_Position >= m_Input.size(); }
+
+    char Peek() const { return this->AtEnd() ? '\0' : m_Input[m_Position]; }
+
+    void SkipSpaces()
+    {
+      while (!this->AtEnd() && std::isspace(static_cast<unsigned char>(m_Input[m_Position])))
+        ++m_Position;
+    }
+
+    /** Consumes c (and the following spaces) if it is the next character. */
+    bool Accept(char c)
+    {
+      if (this->AtEnd() || m_Input[m_Position] != c)
+        return false;
+
+      ++m_Position;
+      this->SkipSpaces();
+      return true;
+    }
+
+    [[noreturn]] void ThrowUnexpected() const
+    {
+      if (this->AtEnd())
+      {
+        mitkThrowException(mitk::FormulaParserException)
+          << "Error while parsing '" << m_Input << "': Unexpected end of input";
+      }
+
+      mitkThrowException(mitk::FormulaParserException) << "Error while parsing '" << m_Input
+                                                       << "': Unexpected character '" << m_Input[m_Position]
+                                                       << "' after '" << m_Input.substr(0, m_Position) << "'";
+    }
+
+    NodePointer ParseExpression()
+    {
+      NodePointer result = this->ParseTerm();
+
+      while (true)
+      {
+        if (this->Accept('+'))
+          result = MakeBinary(Op::Add, result, this->ParseTerm());
+        else if (this->Accept('-'))
+          result = MakeBinary(Op::Subtract, result, this->ParseTerm());
+        else
+          return result;
+      }
+    }
+
+    NodePointer ParseTerm()
+    {
+      NodePointer result = this->ParsePrimary();
+
+      while (true)
+      {
+        if (this->Accept('*'))
+          result = MakeBinary(Op::Multiply, result, this->ParsePrimary());
+        else if (this->Accept('/'))
+          result = MakeBinary(Op::Divide, result, this->ParsePrimary());
+        else
+          return result;
+      }
+    }
+
+    NodePointer ParsePrimary()
+    {
+      const char c = this->Peek();
+      const char next = m_Position + 1 < m_Input.size() ? m_Input[m_Position + 1] : '\0';
+
+      if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && std::isdigit(static_cast<unsigned char>(next))))
+        return this->ParseNumber();
+
+      if (this->Accept('('))
+      {
+        NodePointer result = this->ParseExpression();
+        if (!this->Accept(')'))
+          this->ThrowUnexpected();
+        return result;
+      }
+
+      if (this->Accept('-'))
+        return MakeUnary(Op::Negate, this->ParsePrimary());
+
+      if (this->Accept('+'))
+        return this->ParsePrimary();
+
+      if (std::isalpha(static_cast<unsigned char>(c)))
+        return this->ParseIdentifier();
+
+      this->ThrowUnexpected();
+    }
+
+    NodePointer ParseNumber()
+    {
+      const std::size_t begin = m_Position;
+
+      while (std::isdigit(static_cast<unsigned char>(this->Peek())))
+        ++m_Position;
+      if (this->Peek() == '.')
+      {
+        ++m_Position;
+        while (std::isdigit(static_cast<unsigned char>(this->Peek())))
+          ++m_Position;
+      }
+      if (this->Peek() == 'e' || this->Peek() == 'E')
+      {
+        std::size_t exponent = m_Position + 1;
+        if (exponent < m_Input.size() && (m_Input[exponent] == '+' || m_Input[exponent] == '-'))
+          ++exponent;
+        if (exponent < m_Input.size() && std::isdigit(static_cast<unsigned char>(m_Input[exponent])))
+        {
+          m_Position = exponent;
+          while (std::isdigit(static_cast<unsigned char>(this->Peek())))
+            ++m_Position;
+        }
+      }
+
+      // independent of the global locale, like the boost::spirit parser
+      std::istringstream stream(m_Input.substr(begin, m_Position - begin));
+      stream.imbue(std::locale::classic());
+      ValueType value = 0;
+      stream >> value;
+
+      this->SkipSpaces();
+      return MakeConstant(value);
+    }
+
+    NodePointer ParseIdentifier()
+    {
+      const std::size_t begin = m_Position;
+      while (std::isalnum(static_cast<unsigned char>(this->Peek())) || this->Peek() == '_')
+        ++m_Position;
+      const std::string name = m_Input.substr(begin, m_Position - begin);
+      this->SkipSpaces();
+
+      if (this->Peek() == '(')
+      {
+        static const std::pair<const char *, Op> functions[] = {{"abs", Op::Abs},
+                                                                {"exp", Op::Exp},
+                                                                {"sin", Op::Sin},
+                                                                {"cos", Op::Cos},
+                                                                {"tan", Op::Tan},
+                                                                {"sind", Op::Sind},
+                                                                {"cosd", Op::Cosd},
+                                                                {"tand", Op::Tand},
+                                                                {"fresnelS", Op::FresnelS},
+                                                                {"fresnelC", Op::FresnelC}};
+
+        for (const auto &function : functions)
+        {
+          if (name == function.first)
+          {
+            this->Accept('(');
+            NodePointer argument = this->ParseExpression();
+            if (!this->Accept(')'))
+              this->ThrowUnexpected();
+            return MakeUnary(function.second, argument);
+          }
+        }
+      }
+
+      const auto pos = std::find(m_VariableNames.begin(), m_VariableNames.end(), name);
+      if (pos == m_VariableNames.end())
+      {
+        mitkThrowException(mitk::FormulaParserException) << "No variable '" << name << "' defined in lookup";
+      }
+
+      return MakeVariable(static_cast<std::size_t>(pos - m_VariableNames.begin()));
+    }
+
+    const std::string &m_Input;
+    const mitk::CompiledFormula::VariableNamesType &m_VariableNames;
+    std::size_t m_Position;
+  };
+
+  struct Instruction
+  {
+    Op op;
+    ValueType value;
+    std::size_t variable;
+  };
+
+  /** Number of samples EvaluateSamples() processes per instruction. */
+  const std::size_t BlockSize = 256;
+
+  /** Stack entry of the block evaluation. Values that do not depend on the sampled variable are kept as scalar. */
+  struct Slot
+  {
+    bool uniform;
+    ValueType scalar;
+    ValueType *data;
+  };
+
+  template <typename TFunction>
+  void ApplyBinary(Slot &left, const Slot &right, std::size_t count, TFunction function)
+  {
+    if (left.uniform && right.uniform)
+    {
+      left.scalar = function(left.scalar, right.scalar);
+      return;
+    }
+
+    ValueType *result = left.data;
+    if (left.uniform)
+    {
+      const ValueType l = left.scalar;
+      const ValueType *r = right.data;
+      for (std::size_t i = 0; i < count; ++i)
+        result[i] = function(l, r[i]);
+    }
+    else if (right.uniform)
+    {
+      const ValueType r = right.scalar;
+      for (std::size_t i = 0; i < count; ++i)
+        result[i] = function(result[i], r);
+    }
+    else
+    {
+      const ValueType *r = right.data;
+      for (std::size_t i = 0; i < count; ++i)
+        result[i] = function(result[i], r[i]);
+    }
+    left.uniform = false;
+  }
+}
+
+class mitk::CompiledFormula::Impl
+{
+public:
+  Impl(const NodePointer &root, const VariableNamesType &variableNames)
+    : m_Root(root), m_VariableNames(variableNames), m_StackSize(0)
+  {
+    std::size_t depth = 0;
+    this->Emit(root, depth);
+  }
+
+  NodePointer m_Root;
+  VariableNamesType m_VariableNames;
+  std::vector<Instruction> m_Program;
+  std::size_t m_StackSize;
+
+  ValueType Evaluate(const ValueType *values, ValueType *stack) const
+  {
+    std::size_t top = 0;
+
+    for (const auto &instruction : m_Program)
+    {
+      switch (instruction.op)
+      {
+        case Op::Constant:
+          stack[top++] = instruction.value;
+          break;
+        case Op::Variable:
+          stack[top++] = values[instruction.variable];
+          break;
+        case Op::Add:
+        case Op::Subtract:
+        case Op::Multiply:
+        case Op::Divide:
+          --top;
+          stack[top - 1] = ApplyBinary(instruction.op, stack[top - 1], stack[top]);
+          break;
+        default:
+          stack[top - 1] = ApplyUnary(instruction.op, stack[top - 1]);
+          break;
+      }
+    }
+
+    return stack[0];
+  }
+
+  void EvaluateBlock(const ValueType *values,
+                     std::size_t sampledVariable,
+                     const ValueType *samples,
+                     std::size_t count,
+                     Slot *stack,
+                     ValueType *result) const
+  {
+    std::size_t top = 0;
+
+    for (const auto &instruction : m_Program)
+    {
+      switch (instruction.op)
+      {
+        case Op::Constant:
+          stack[top].uniform = true;
+          stack[top].scalar = instruction.value;
+          ++top;
+          break;
+        case Op::Variable:
+          if (instruction.variable == sampledVariable)
+          {
+            stack[top].uniform = false;
+            std::copy(samples, samples + count, stack[top].data);
+          }
+          else
+          {
+            stack[top].uniform = true;
+            stack[top].scalar = values[instruction.variable];
+          }
+          ++top;
+          break;
+        case Op::Add:
+          --top;
+          ::ApplyBinary(stack[top - 1], stack[top], count, [](ValueType l, ValueType r) { return l + r; });
+          break;
+        case Op::Subtract:
+          --top;
+          ::ApplyBinary(stack[top - 1], stack[top], count, [](ValueType l, ValueType r) { return l - r; });
+          break;
+        case Op::Multiply:
+          --top;
+          ::ApplyBinary(stack[top - 1], stack[top], count, [](ValueType l, ValueType r) { return l * r; });
+          break;
+        case Op::Divide:
+          --top;
+          ::ApplyBinary(stack[top - 1], stack[top], count, [](ValueType l, ValueType r) { return l / r; });
+          break;
+        default:
+        {
+          Slot &slot = stack[top - 1];
+          if (slot.uniform)
+          {
+            slot.scalar = ApplyUnary(instruction.op, slot.scalar);
+          }
+          else if (instruction.op == Op::Negate)
+          {
+            for (std::size_t i = 0; i < count; ++i)
+              slot.data[i] = -slot.data[i];
+          }
+          else
+          {
+            for (std::size_t i = 0; i < count; ++i)
+              slot.data[i] = ApplyUnary(instruction.op, slot.data[i]);
+          }
+          break;
+        }
+      }
+    }
+
+    if (stack[0].uniform)
+      std::fill(result, result + count, stack[0].scalar);
+    else
+      std::copy(stack[0].data, stack[0].data + count, result);
+  }
+
+private:
+  void Emit(const NodePointer &node, std::size_t &depth)
+  {
+    if (IsBinary(node->op))
+    {
+      this->Emit(node->left, depth);
+      this->Emit(node->right, depth);
+      --depth;
+    }
+    else if (IsUnary(node->op))
+    {
+      this->Emit(node->left, depth);
+    }
+    else
+    {
+      ++depth;
+      m_StackSize = std::max(m_StackSize, depth);
+    }
+
+    m_Program.push_back(Instruction{node->op, node->value, node->variable});
+  }
+};
+
+mitk::CompiledFormula::CompiledFormula() : m_Impl(std::make_shared<const Impl>(MakeConstant(0), VariableNamesType()))
+{
+}
+
+mitk::CompiledFormula::CompiledFormula(const std::string &formula, const VariableNamesType &variableNames)
+  : m_Impl(std::make_shared<const Impl>(Parser(formula, variableNames).Parse(), variableNames))
+{
+}
+
+mitk::CompiledFormula::CompiledFormula(std::shared_ptr<const Impl> impl) : m_Impl(impl)
+{
+}
+
+const mitk::CompiledFormula::VariableNamesType &mitk::CompiledFormula::GetVariableNames() const
+{
+  return m_Impl->m_VariableNames;
+}
+
+bool mitk::CompiledFormula::IsConstant() const
+{
+  return m_Impl->m_Root->op == Op::Constant;
+}
+
+std::size_t mitk::CompiledFormula::GetNumberOfInstructions() const
+{
+  return m_Impl->m_Program.size();
+}
+
+mitk::CompiledFormula::ValueType mitk::CompiledFormula::Evaluate(const ValueType *values) const
+{
+  const std::size_t MaxLocalStackSize = 32;
+
+  if (m_Impl->m_StackSize <= MaxLocalStackSize)
+  {
+    ValueType stack[MaxLocalStackSize];
+    return m_Impl->Evaluate(values, stack);
+  }
+
+  std::vector<ValueType> stack(m_Impl->m_StackSize);
+  return m_Impl->Evaluate(values, stack.data());
+}
+
+void mitk::CompiledFormula::EvaluateSamples(const ValueType *values,
+                                            std::size_t sampledVariable,
+                                            const ValueType *samples,
+                                            std::size_t numberOfSamples,
+                                            ValueType *result) const
+{
+  if (numberOfSamples == 0)
+    return;
+
+  if (this->IsConstant())
+  {
+    std::fill(result, result + numberOfSamples, m_Impl->m_Root->value);
+    return;
+  }
+
+  const std::size_t blockSize = std::min(numberOfSamples, BlockSize);
+  std::vector<ValueType> buffer(m_Impl->m_StackSize * blockSize);
+  std::vector<Slot> stack(m_Impl->m_StackSize);
+  for (std::size_t i = 0; i < stack.size(); ++i)
+    stack[i].data = buffer.data() + i * blockSize;
+
+  for (std::size_t offset = 0; offset < numberOfSamples; offset += blockSize)
+  {
+    const std::size_t count = std::min(blockSize, numberOfSamples - offset);
+    m_Impl->EvaluateBlock(values, sampledVariable, samples + offset, count, stack.data(), result + offset);
+  }
+}
+
+mitk::CompiledFormula mitk::CompiledFormula::Derive(std::size_t variable) const
+{
+  NodePointer derivative = ::Derive(m_Impl->m_Root, variable);
+  if (!derivative)
+    derivative = MakeConstant(0);
+
+  return CompiledFormula(std::make_shared<const Impl>(derivative, m_Impl->m_VariableNames));
+}
@@ -128,6 +128,8 @@ DoModelFit(const SignalType& value, const ModelBase* model,
   ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = ::itk::LevenbergMarquardtOptimizer::New();
 
   optimizer->SetCostFunction(metric);
+  //analytic derivatives of the model are only used without constraints, the penalties have no derivative.
+  optimizer->SetUseCostFunctionGradient(model->ProvidesJacobian() && m_ConstraintChecker.IsNull());
   optimizer->SetEpsilonFunction(m_Epsilon);
   optimizer->SetGradientTolerance(m_GradientTolerance);
   optimizer->SetNumberOfIterations(m_Iterations);
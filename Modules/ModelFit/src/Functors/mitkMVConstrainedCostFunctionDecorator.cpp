@@ -17,7 +17,7 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 
 mitk::MVConstrainedCostFunctionDecorator::MeasureType
-  mitk::MVConstrainedCostFunctionDecorator::CalcMeasure(const ParametersType &parameters, const SignalType & /*signal*/) const
+  mitk::MVConstrainedCostFunctionDecorator::CalcMeasure(const ParametersType &parameters, const SignalType &signal) const
 {
   if (m_ConstraintChecker.IsNull()) mitkThrow()<<"Error. Cannot calc measure. Constraint checker is not set";
   if (m_WrappedCostFunction.IsNull()) mitkThrow()<<"Error. Cannot calc measure. Wrapped metric is not set";
@@ -32,7 +32,10 @@ mitk::MVConstrainedCostFunctionDecorator::MeasureType
 
   if (penalty<m_FailureThreshold || !m_ActivateFailureThreshold)
   {
-    MeasureType wrappedMeasure = m_WrappedCostFunction->GetValue(parameters);
+    // the signal of a shared model has already been computed, so the model is evaluated only once
+    MeasureType wrappedMeasure = m_WrappedCostFunction->GetModel() == this->GetModel()
+                                   ? m_WrappedCostFunction->CalcMeasure(parameters, signal)
+                                   : m_WrappedCostFunction->GetValue(parameters);
     if (wrappedMeasure.Size() != measure.Size()) mitkThrow()<<"Error. Cannot calc measure. Penalty measure and wrapped measure have different size. Penalty size:"<<measure.Size()<<"; wrapped measure size: "<<wrappedMeasure.Size();
 
     for(unsigned int i=0; i<measure.GetSize(); ++i)
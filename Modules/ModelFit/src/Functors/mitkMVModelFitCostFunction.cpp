@@ -34,27 +34,61 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
   ParametersType::SizeValueType paramCount = parameters.Size();
   MeasureType::SizeValueType measureCount = GetNumberOfValues();
 
+  if (m_Model->ProvidesJacobian())
+  {
+    SignalType signal;
+    ModelBase::JacobianType signalJacobian;
+    m_Model->GetSignalAndJacobian(parameters, signal, signalJacobian);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+
+    if (CalcMeasureDerivative(parameters, signal, signalJacobian, derivative))
+    {
+      return;
+    }
+  }
+
   derivative.SetSize(paramCount,m_Sample.Size());
 
+  //evaluate all shifted parameter sets in one go; models may compute them together
+  std::vector<ModelBase::ParametersType> shiftedParameters;
+  shiftedParameters.reserve(2 * paramCount);
+
   for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
   {
     ParametersType newParameters = parameters;
     newParameters[i] -= m_DerivativeStepLength;
-
-    MeasureType e0 = GetValue(newParameters);
+    shiftedParameters.push_back(newParameters);
 
     newParameters = parameters;
     newParameters[i] += m_DerivativeStepLength;
+    shiftedParameters.push_back(newParameters);
+  }
+
+  const std::vector<SignalType> signals = m_Model->GetSignals(shiftedParameters);
+
+  for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
+  {
+    const SignalType& signal0 = signals[2 * i];
+    const SignalType& signal1 = signals[2 * i + 1];
 
-    MeasureType e1 = GetValue(newParameters);
+    if(signal0.GetSize() != m_Sample.GetSize() || signal1.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+    if(signal0.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+
+    MeasureType e0 = CalcMeasure(shiftedParameters[2 * i], signal0);
+    MeasureType e1 = CalcMeasure(shiftedParameters[2 * i + 1], signal1);
 
     for(MeasureType::SizeValueType j = 0; j<measureCount; ++j)
     {
       derivative[i][j] = (e1[j] - e0[j]) / ( 2 * m_DerivativeStepLength );
     }
   }
+};
 
-
+bool mitk::MVModelFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType& /*signal*/,
+  const ModelBase::JacobianType& /*signalJacobian*/, DerivativeType& /*derivative*/) const
+{
+  return false;
 };
 
 unsigned int mitk::MVModelFitCostFunction::GetNumberOfParameters() const
@@ -24,3 +24,21 @@ mitk::SquaredDifferencesFitCostFunction::MeasureType mitk::SquaredDifferencesFit
 
   return measure;
 }
+
+bool mitk::SquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType &parameters, const SignalType &signal,
+  const ModelBase::JacobianType& signalJacobian, DerivativeType& derivative) const
+{
+  derivative.SetSize(parameters.GetSize(), signal.GetSize());
+
+  for(SignalType::size_type i=0; i<signal.GetSize(); ++i)
+  {
+    const double factor = -2 * (m_Sample[i] - signal[i]);
+
+    for(ParametersType::SizeValueType p=0; p<parameters.GetSize(); ++p)
+    {
+      derivative[p][i] = factor * signalJacobian[i][p];
+    }
+  }
+
+  return true;
+}
@@ -13,6 +13,8 @@ found in the LICENSE file.
 #include "mitkGenericParamModel.h"
 #include "mitkFormulaParser.h"
 
+#include <algorithm>
+
 const std::string mitk::GenericParamModel::NAME_STATIC_PARAMETER_number = "number_of_parameters";
 
 std::string mitk::GenericParamModel::GetModelDisplayName() const
@@ -35,8 +37,65 @@ std::string mitk::GenericParamModel::GetXName() const
   return "x";
 };
 
+void mitk::GenericParamModel::SetFunctionString(const char* functionString)
+{
+  this->SetFunctionString(std::string(functionString ? functionString : ""));
+};
+
+void mitk::GenericParamModel::SetFunctionString(const std::string& functionString)
+{
+  if (functionString == m_FunctionString)
+  {
+    return;
+  }
+
+  m_FunctionString = functionString;
+  this->CompileFunctionString();
+  this->Modified();
+};
+
+void mitk::GenericParamModel::SetNumberOfParameters(ParametersSizeType numberOfParameters)
+{
+  const ParametersSizeType clampedNumber = std::min<ParametersSizeType>(std::max<ParametersSizeType>(numberOfParameters, 1), 10);
+
+  if (clampedNumber == m_NumberOfParameters)
+  {
+    return;
+  }
+
+  m_NumberOfParameters = clampedNumber;
+  this->CompileFunctionString();
+  this->Modified();
+};
+
+void mitk::GenericParamModel::CompileFunctionString()
+{
+  CompiledFormula::VariableNamesType variableNames = this->GetParameterNames();
+  variableNames.insert(variableNames.begin(), this->GetXName());
+
+  try
+  {
+    m_Formula = CompiledFormula(m_FunctionString, variableNames);
+
+    m_Derivatives.clear();
+    for (ParametersSizeType i = 0; i < m_NumberOfParameters; ++i)
+    {
+      m_Derivatives.push_back(m_Formula.Derive(i + 1));
+    }
+
+    m_FormulaError.clear();
+  }
+  catch (const FormulaParserException& e)
+  {
+    m_Formula = CompiledFormula();
+    m_Derivatives.clear();
+    m_FormulaError = e.GetDescription();
+  }
+};
+
 mitk::GenericParamModel::GenericParamModel(): m_FunctionString(""), m_NumberOfParameters(1)
 {
+  this->CompileFunctionString();
 };
 
 mitk::GenericParamModel::ParameterNamesType
@@ -91,34 +150,86 @@ mitk::GenericParamModel::GetNumberOfParameters() const
   return m_NumberOfParameters;
 };
 
+std::vector<double>
+mitk::GenericParamModel::GetFormulaVariables(const ParametersType& parameters) const
+{
+  // variable 0 is x, it is sampled from the time grid.
+  std::vector<double> variables(m_NumberOfParameters + 1, 0.0);
+
+  const ParametersType::size_type count = std::min<ParametersType::size_type>(parameters.size(), m_NumberOfParameters);
+  for (ParametersType::size_type i = 0; i < count; ++i)
+  {
+    variables[i + 1] = parameters[i];
+  }
+
+  return variables;
+};
+
+bool mitk::GenericParamModel::ValidateModel(std::string& error) const
+{
+  if (!m_FormulaError.empty())
+  {
+    error = m_FormulaError;
+    return false;
+  }
+
+  return true;
+};
+
 mitk::GenericParamModel::ModelResultType
 mitk::GenericParamModel::ComputeModelfunction(const ParametersType& parameters) const
 {
+  if (!m_FormulaError.empty())
+  {
+    mitkThrowException(FormulaParserException) << m_FormulaError;
+  }
+
   unsigned int timeSteps = m_TimeGrid.GetSize();
   ModelResultType signal(timeSteps);
 
-  std::map<std::string, double> parameterMap;
-  parameterMap.insert(std::make_pair(GetXName(), 0.0));
+  const std::vector<double> variables = this->GetFormulaVariables(parameters);
+  m_Formula.EvaluateSamples(variables.data(), 0, m_TimeGrid.data_block(), timeSteps, signal.data_block());
+
+  return signal;
+};
 
-  auto paramNames = this->GetParameterNames();
-  for (ParametersType::size_type i = 0; i < parameters.size(); ++i)
+mitk::GenericParamModel::JacobianType
+mitk::GenericParamModel::ComputeModelJacobian(const ParametersType& parameters) const
+{
+  if (!m_FormulaError.empty())
   {
-    parameterMap.insert(std::make_pair(paramNames[i], parameters[i]));
+    mitkThrowException(FormulaParserException) << m_FormulaError;
   }
 
-  FormulaParser formulaParser(&parameterMap);
+  unsigned int timeSteps = m_TimeGrid.GetSize();
+  JacobianType jacobian(timeSteps, m_NumberOfParameters);
 
-  TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
-  ModelResultType::iterator signalPos = signal.begin();
+  const std::vector<double> variables = this->GetFormulaVariables(parameters);
+  std::vector<double> derivative(timeSteps);
 
-  for (TimeGridType::const_iterator gridPos = m_TimeGrid.begin(); gridPos != timeGridEnd;
-       ++gridPos, ++signalPos)
+  for (ParametersSizeType i = 0; i < m_NumberOfParameters; ++i)
   {
-    parameterMap[GetXName()] = *gridPos;
-    *signalPos = formulaParser.parse(m_FunctionString);
+    m_Derivatives[i].EvaluateSamples(variables.data(), 0, m_TimeGrid.data_block(), timeSteps, derivative.data());
+
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      jacobian(t, i) = derivative[t];
+    }
   }
 
-  return signal;
+  return jacobian;
+};
+
+bool mitk::GenericParamModel::ProvidesJacobian() const
+{
+  return m_FormulaError.empty();
+};
+
+void mitk::GenericParamModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+    ModelResultType& signal, JacobianType& jacobian) const
+{
+  signal = this->ComputeModelfunction(parameters);
+  jacobian = this->ComputeModelJacobian(parameters);
 };
 
 mitk::GenericParamModel::ParameterNamesType mitk::GenericParamModel::GetStaticParameterNames()
@@ -164,6 +275,7 @@ itk::LightObject::Pointer mitk::GenericParamModel::InternalClone() const
 
   newClone->SetTimeGrid(this->m_TimeGrid);
   newClone->SetNumberOfParameters(this->m_NumberOfParameters);
+  newClone->SetFunctionString(this->m_FunctionString);
 
   return newClone.GetPointer();
 };
@@ -146,6 +146,77 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+std::vector<mitk::ModelBase::ModelResultType> mitk::ModelBase::GetSignals(const std::vector<ParametersType>& parameters) const
+{
+  for (const auto& parameterSet : parameters)
+  {
+    if (parameterSet.size() != this->GetNumberOfParameters())
+    {
+      itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                        << this->GetNumberOfParameters() << "; passed parameters: " << parameterSet);
+    }
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signals. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  return ComputeModelfunctions(parameters);
+}
+
+bool mitk::ModelBase::ProvidesJacobian() const
+{
+  return false;
+}
+
+void mitk::ModelBase::GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                           JacobianType& jacobian) const
+{
+  if (!this->ProvidesJacobian())
+  {
+    itkExceptionMacro("Model does not provide a Jacobian. Use a numerical derivative instead.");
+  }
+
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  ComputeModelfunctionAndJacobian(parameters, signal, jacobian);
+}
+
+std::vector<mitk::ModelBase::ModelResultType> mitk::ModelBase::ComputeModelfunctions(const std::vector<ParametersType>& parameters) const
+{
+  std::vector<ModelResultType> signals;
+  signals.reserve(parameters.size());
+
+  for (const auto& parameterSet : parameters)
+  {
+    signals.push_back(ComputeModelfunction(parameterSet));
+  }
+
+  return signals;
+}
+
+void mitk::ModelBase::ComputeModelfunctionAndJacobian(const ParametersType& /*parameters*/, ModelResultType& /*signal*/,
+                                                      JacobianType& /*jacobian*/) const
+{
+  itkExceptionMacro("Model does not implement ComputeModelfunctionAndJacobian().");
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
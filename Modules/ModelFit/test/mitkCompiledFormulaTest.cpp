@@ -0,0 +1,194 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+#include "mitkCompiledFormula.h"
+#include "mitkFormulaParser.h"
+#include "mitkGenericParamModel.h"
+
+#include <cmath>
+
+using namespace mitk;
+
+namespace
+{
+  const char *formulas[] = {"3.5 + a * x * sin(x) - 1 / 2",
+                            "abs(x - a) * exp(-b * x)",
+                            "tand(a * x) + cosd(b) - sind(x)",
+                            "fresnelS(a * x) + fresnelC(b + x)",
+                            "-(-x) / (a + b)",
+                            "cos(tan(a * x) / b)",
+                            "1e-2 * x + .5 - 3e1 * a"};
+
+  const double samples[] = {0.1, 0.5, 1.0, 2.0, 3.3};
+  const std::size_t numberOfSamples = sizeof(samples) / sizeof(samples[0]);
+
+  bool IsClose(double value, double reference, double epsilon)
+  {
+    return std::abs(value - reference) <= epsilon * (1.0 + std::abs(reference));
+  }
+
+  /** Compares the compiled formula with the (interpreting) FormulaParser. */
+  void TestEvaluation()
+  {
+    const CompiledFormula::VariableNamesType names = {"x", "a", "b"};
+
+    for (const auto formula : formulas)
+    {
+      CompiledFormula compiled(formula, names);
+
+      double values[] = {0.0, 1.3, 0.7};
+      FormulaParser::VariableMapType variableMap = {{"x", 0.0}, {"a", values[1]}, {"b", values[2]}};
+      FormulaParser parser(&variableMap);
+
+      double results[numberOfSamples];
+      compiled.EvaluateSamples(values, 0, samples, numberOfSamples, results);
+
+      bool equal = true;
+      for (std::size_t i = 0; i < numberOfSamples; ++i)
+      {
+        variableMap["x"] = samples[i];
+        values[0] = samples[i];
+        const double reference = parser.parse(formula);
+        equal = equal && IsClose(results[i], reference, 1e-12) && IsClose(compiled.Evaluate(values), reference, 1e-12);
+      }
+
+      MITK_TEST_CONDITION(equal, "Testing compiled evaluation of '" << formula << "'");
+    }
+
+    CompiledFormula constant("2 * (3 + 4) - 1", names);
+    MITK_TEST_CONDITION(constant.IsConstant() && constant.GetNumberOfInstructions() == 1,
+                        "Testing constant folding");
+    MITK_TEST_CONDITION(constant.Evaluate(nullptr) == 13.0, "Testing value of folded constant");
+
+    // more samples than evaluated per block
+    std::vector<double> grid(1000);
+    for (std::size_t i = 0; i < grid.size(); ++i)
+    {
+      grid[i] = i * 0.01;
+    }
+
+    CompiledFormula decay("a * exp(-b * x) + x", names);
+    double values[] = {0.0, 2.0, 0.5};
+    std::vector<double> results(grid.size());
+    decay.EvaluateSamples(values, 0, grid.data(), grid.size(), results.data());
+
+    bool equal = true;
+    for (std::size_t i = 0; i < grid.size(); ++i)
+    {
+      equal = equal && IsClose(results[i], 2.0 * std::exp(-0.5 * grid[i]) + grid[i], 1e-12);
+    }
+    MITK_TEST_CONDITION(equal, "Testing evaluation of many samples");
+  }
+
+  /** Compares the analytic derivatives with central differences. */
+  void TestDerivatives()
+  {
+    const CompiledFormula::VariableNamesType names = {"x", "a", "b"};
+    const double h = 1e-6;
+
+    for (const auto formula : formulas)
+    {
+      CompiledFormula compiled(formula, names);
+
+      bool equal = true;
+      for (std::size_t variable = 0; variable < names.size(); ++variable)
+      {
+        CompiledFormula derivative = compiled.Derive(variable);
+
+        for (std::size_t i = 0; i < numberOfSamples; ++i)
+        {
+          double values[] = {samples[i], 1.3, 0.7};
+          const double value = derivative.Evaluate(values);
+
+          values[variable] += h;
+          const double upper = compiled.Evaluate(values);
+          values[variable] -= 2 * h;
+          const double lower = compiled.Evaluate(values);
+
+          equal = equal && IsClose(value, (upper - lower) / (2 * h), 1e-5);
+        }
+      }
+
+      MITK_TEST_CONDITION(equal, "Testing derivatives of '" << formula << "'");
+    }
+
+    CompiledFormula independent = CompiledFormula("a * x", names).Derive(2);
+    MITK_TEST_CONDITION(independent.IsConstant() && independent.Evaluate(nullptr) == 0.0,
+                        "Testing derivative with respect to an unused variable");
+  }
+
+  void TestErrors()
+  {
+    const CompiledFormula::VariableNamesType names = {"x", "a"};
+
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("_", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("5=", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("x +", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("(x", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("b * x", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("sin x", names));
+  }
+
+  void TestGenericParamModel()
+  {
+    GenericParamModel::Pointer model = GenericParamModel::New();
+    model->SetNumberOfParameters(2);
+    model->SetFunctionString("a * exp(-b * x)");
+
+    GenericParamModel::TimeGridType grid(4);
+    for (unsigned int i = 0; i < grid.size(); ++i)
+    {
+      grid[i] = i;
+    }
+    model->SetTimeGrid(grid);
+
+    GenericParamModel::ParametersType parameters(2);
+    parameters[0] = 3.0;
+    parameters[1] = 0.5;
+
+    GenericParamModel::ModelResultType signal = model->GetSignal(parameters);
+    GenericParamModel::JacobianType jacobian = model->ComputeModelJacobian(parameters);
+
+    bool equal = signal.size() == 4 && jacobian.rows() == 4 && jacobian.cols() == 2;
+    for (unsigned int i = 0; equal && i < grid.size(); ++i)
+    {
+      const double e = std::exp(-0.5 * grid[i]);
+      equal = IsClose(signal[i], 3.0 * e, 1e-12) && IsClose(jacobian(i, 0), e, 1e-12) &&
+              IsClose(jacobian(i, 1), -3.0 * grid[i] * e, 1e-12);
+    }
+    MITK_TEST_CONDITION(equal, "Testing signal and jacobian of GenericParamModel");
+
+    GenericParamModel::Pointer clone = model->Clone();
+    MITK_TEST_CONDITION(clone->GetFunctionString() == model->GetFunctionString(),
+                        "Testing function string of the clone");
+
+    // "b" is not a parameter of a model with one parameter
+    model->SetNumberOfParameters(1);
+    GenericParamModel::ParametersType parameter(1);
+    parameter[0] = 1.0;
+    MITK_TEST_FOR_EXCEPTION(itk::ExceptionObject, model->GetSignal(parameter));
+  }
+}
+
+int mitkCompiledFormulaTest(int /*argc*/, char * /*argv*/[])
+{
+  MITK_TEST_BEGIN("CompiledFormula")
+
+  TestEvaluation();
+  TestDerivatives();
+  TestErrors();
+  TestGenericParamModel();
+
+  MITK_TEST_END()
+}
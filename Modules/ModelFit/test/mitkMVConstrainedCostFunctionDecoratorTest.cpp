@@ -51,6 +51,35 @@ protected:
     ~TestCostFunction() override{}
 };
 
+class CountingLinearModel : public mitk::LinearModel
+{
+public:
+
+    typedef CountingLinearModel Self;
+    typedef mitk::LinearModel Superclass;
+    typedef itk::SmartPointer< Self >                            Pointer;
+    typedef itk::SmartPointer< const Self >                      ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+
+    mutable unsigned int m_evaluations;
+
+protected:
+
+    ModelResultType ComputeModelfunction(const ParametersType& parameters) const override
+    {
+      ++m_evaluations;
+      return Superclass::ComputeModelfunction(parameters);
+    };
+
+    CountingLinearModel()
+    {
+      m_evaluations = 0;
+    }
+
+    ~CountingLinearModel() override{}
+};
+
 int mitkMVConstrainedCostFunctionDecoratorTest(int  /*argc*/, char*[] /*argv[]*/)
 {
 	MITK_TEST_BEGIN("mitkMVConstrainedCostFunctionDecoratorTest")
@@ -58,7 +87,7 @@ int mitkMVConstrainedCostFunctionDecoratorTest(int  /*argc*/, char*[] /*argv[]*/
   mitk::SimpleBarrierConstraintChecker::Pointer checker = mitk::SimpleBarrierConstraintChecker::New();
   mitk::MVConstrainedCostFunctionDecorator::Pointer decorator = mitk::MVConstrainedCostFunctionDecorator::New();
   TestCostFunction::Pointer innerCF = TestCostFunction::New();
-  mitk::LinearModel::Pointer model = mitk::LinearModel::New();
+  CountingLinearModel::Pointer model = CountingLinearModel::New();
   decorator->SetModel(model);
   innerCF->SetModel(model);
 
@@ -148,6 +177,10 @@ int mitkMVConstrainedCostFunctionDecoratorTest(int  /*argc*/, char*[] /*argv[]*/
   MITK_TEST_CONDITION_REQUIRED(measure[2] == 54+(-1*log(1/4.)), "Testing measure 3 with parameters p4.");
   MITK_TEST_CONDITION_REQUIRED(innerCF->m_calls == 3, "Checking calls with parameters p4.");
 
+  const unsigned int evaluations = model->m_evaluations;
+  decorator->GetValue(p4);
+  MITK_TEST_CONDITION_REQUIRED(model->m_evaluations == evaluations + 1, "Checking model evaluations per value.");
+
 
   MITK_TEST_END()
 }
@@ -0,0 +1,173 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkImageCast.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <vtkMassProperties.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+class mitkLabelSetImageToSurfaceFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageToSurfaceFilterTestSuite);
+
+  MITK_TEST(GenerateAllLabels_OneOutputPerLabel);
+  MITK_TEST(GenerateAllLabels_SurfacesWithinLabelBounds);
+  MITK_TEST(GenerateAllLabels_EmptyImage);
+  MITK_TEST(GenerateAllLabels_SigmaSmoothesEachLabel);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<mitk::Label::PixelType, 3> LabelImageType;
+
+  mitk::Image::Pointer m_Image;
+
+  /** Creates a 40x40x40 image with spacing 2 containing two boxes labeled 1 and 3. */
+  mitk::Image::Pointer CreateLabelImage(bool empty)
+  {
+    LabelImageType::Pointer itkImage = LabelImageType::New();
+    LabelImageType::RegionType region;
+    region.SetSize(0, 40);
+    region.SetSize(1, 40);
+    region.SetSize(2, 40);
+    itkImage->SetRegions(region);
+    LabelImageType::SpacingType spacing;
+    spacing.Fill(2.0);
+    itkImage->SetSpacing(spacing);
+    itkImage->Allocate();
+    itkImage->FillBuffer(0);
+
+    if (!empty)
+    {
+      itk::ImageRegionIterator<LabelImageType> it(itkImage, region);
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+        const auto index = it.GetIndex();
+        if (index[0] >= 5 && index[0] < 15 && index[1] >= 5 && index[1] < 15 && index[2] >= 5 && index[2] < 15)
+          it.Set(1);
+        else if (index[0] >= 20 && index[0] < 35 && index[1] >= 20 && index[1] < 30 && index[2] >= 10 && index[2] < 20)
+          it.Set(3);
+      }
+    }
+
+    mitk::Image::Pointer image;
+    mitk::CastToMitkImage(itkImage, image);
+    return image;
+  }
+
+public:
+  void setUp() override { m_Image = this->CreateLabelImage(false); }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void GenerateAllLabels_OneOutputPerLabel()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_Image);
+    filter->GenerateAllLabelsOn();
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), static_cast<size_t>(filter->GetNumberOfIndexedOutputs()));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::Label::PixelType>(1), filter->GetLabelForNthOutput(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::Label::PixelType>(3), filter->GetLabelForNthOutput(1));
+
+    const auto &availableLabels = filter->GetAvailableLabels();
+    CPPUNIT_ASSERT_EQUAL(1000ul, availableLabels.at(1));
+    CPPUNIT_ASSERT_EQUAL(1500ul, availableLabels.at(3));
+
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      vtkPolyData *polyData = filter->GetOutput(i)->GetVtkPolyData();
+      CPPUNIT_ASSERT(polyData != nullptr);
+      CPPUNIT_ASSERT(polyData->GetNumberOfPolys() > 0);
+    }
+  }
+
+  void GenerateAllLabels_SurfacesWithinLabelBounds()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_Image);
+    filter->GenerateAllLabelsOn();
+    filter->SetUseSmoothing(1);
+    filter->SetTargetReduction(0.5f);
+    filter->Update();
+
+    // Label 1 covers indices [5, 14], i.e. world coordinates [10, 28] with spacing 2.
+    double bounds[6];
+    filter->GetOutput(0)->GetVtkPolyData()->GetBounds(bounds);
+    for (int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT(bounds[2 * i] >= 8.0 - mitk::eps);
+      CPPUNIT_ASSERT(bounds[2 * i + 1] <= 30.0 + mitk::eps);
+    }
+
+    // Label 3 starts at index 20 in x, i.e. world coordinate 40.
+    filter->GetOutput(1)->GetVtkPolyData()->GetBounds(bounds);
+    CPPUNIT_ASSERT(bounds[0] >= 38.0 - mitk::eps);
+    CPPUNIT_ASSERT(bounds[1] <= 70.0 + mitk::eps);
+  }
+
+  void GenerateAllLabels_EmptyImage()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(this->CreateLabelImage(true));
+    filter->GenerateAllLabelsOn();
+    filter->Update();
+
+    CPPUNIT_ASSERT(filter->GetAvailableLabels().empty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<vtkIdType>(0), filter->GetOutput()->GetVtkPolyData()->GetNumberOfPoints());
+  }
+
+  void GenerateAllLabels_SigmaSmoothesEachLabel()
+  {
+    auto sharpFilter = mitk::LabelSetImageToSurfaceFilter::New();
+    sharpFilter->SetInput(m_Image);
+    sharpFilter->GenerateAllLabelsOn();
+    sharpFilter->SetUseSmoothing(1);
+    sharpFilter->SetSigma(0.1f);
+    sharpFilter->Update();
+
+    auto smoothFilter = mitk::LabelSetImageToSurfaceFilter::New();
+    smoothFilter->SetInput(m_Image);
+    smoothFilter->GenerateAllLabelsOn();
+    smoothFilter->SetUseSmoothing(1);
+    smoothFilter->SetSigma(4.0f);
+    smoothFilter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), static_cast<size_t>(smoothFilter->GetNumberOfIndexedOutputs()));
+
+    // a large sigma rounds the edges and corners of the boxes, which reduces their volume
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      auto sharpVolume = vtkSmartPointer<vtkMassProperties>::New();
+      sharpVolume->SetInputData(sharpFilter->GetOutput(i)->GetVtkPolyData());
+      sharpVolume->Update();
+
+      auto smoothVolume = vtkSmartPointer<vtkMassProperties>::New();
+      smoothVolume->SetInputData(smoothFilter->GetOutput(i)->GetVtkPolyData());
+      smoothVolume->Update();
+
+      CPPUNIT_ASSERT(smoothVolume->GetVolume() > 0.0);
+      CPPUNIT_ASSERT(smoothVolume->GetVolume() < 0.95 * sharpVolume->GetVolume());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageToSurfaceFilter)
@@ -0,0 +1,113 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageCast.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageVtkMapper2D.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+namespace
+{
+  typedef itk::Image<mitk::Label::PixelType, 3> LabelImageType;
+
+  /** Creates a 20x20x20 label set image containing a box labeled 1, which is the active label. */
+  mitk::LabelSetImage::Pointer CreateLabelSetImage()
+  {
+    LabelImageType::Pointer itkImage = LabelImageType::New();
+    LabelImageType::RegionType region;
+    region.SetSize(0, 20);
+    region.SetSize(1, 20);
+    region.SetSize(2, 20);
+    itkImage->SetRegions(region);
+    itkImage->Allocate();
+    itkImage->FillBuffer(0);
+
+    itk::ImageRegionIterator<LabelImageType> it(itkImage, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      if (index[0] >= 5 && index[0] < 15 && index[1] >= 5 && index[1] < 15)
+        it.Set(1);
+    }
+
+    mitk::Image::Pointer image;
+    mitk::CastToMitkImage(itkImage, image);
+
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByLabeledImage(image);
+    labelSetImage->GetActiveLabelSet()->SetActiveLabel(1);
+    return labelSetImage;
+  }
+}
+
+int mitkLabelSetImageVtkMapper2DTest(int /*argc*/, char * /*argv*/ [])
+{
+  MITK_TEST_BEGIN("mitkLabelSetImageVtkMapper2DTest")
+
+  try
+  {
+    mitk::RenderingTestHelper openGlTest(640, 480);
+  }
+  catch (const mitk::TestNotRunException &e)
+  {
+    MITK_WARN << "Test not run: " << e.GetDescription();
+    return 77;
+  }
+
+  mitk::RenderingTestHelper renderingHelper(640, 480);
+
+  auto image = CreateLabelSetImage();
+  auto node = mitk::DataNode::New();
+  node->SetData(image);
+  node->SetBoolProperty("labelset.contour.active", true);
+  renderingHelper.AddNodeToStorage(node);
+  renderingHelper.Render();
+
+  auto *renderer = mitk::BaseRenderer::GetInstance(renderingHelper.GetVtkRenderWindow());
+  auto *mapper = dynamic_cast<mitk::LabelSetImageVtkMapper2D *>(node->GetMapper(mitk::BaseRenderer::Standard2D));
+  MITK_TEST_CONDITION_REQUIRED(nullptr != mapper, "Label set image is rendered by the LabelSetImageVtkMapper2D");
+
+  // keeps the outline alive, so a regenerated outline cannot reuse its address
+  vtkSmartPointer<vtkPolyData> outline = mapper->GetLocalStorage(renderer)->m_OutlinePolyData;
+  MITK_TEST_CONDITION_REQUIRED(outline->GetNumberOfPoints() > 0, "Outline of the active label is generated");
+
+  // a modified image is resliced again, but the slice itself did not change
+  image->Modified();
+  renderingHelper.Render();
+  MITK_TEST_CONDITION(outline == mapper->GetLocalStorage(renderer)->m_OutlinePolyData,
+                      "Outline is reused if the slice did not change");
+
+  // extend the box in every slice
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    for (int z = 0; z < 20; ++z)
+      for (int y = 5; y < 15; ++y)
+      {
+        itk::Index<3> index = {{15, y, z}};
+        accessor.SetPixelByIndex(index, 1);
+      }
+  }
+  image->Modified();
+  renderingHelper.Render();
+  MITK_TEST_CONDITION(outline != mapper->GetLocalStorage(renderer)->m_OutlinePolyData,
+                      "Outline is regenerated if the slice changed");
+
+  MITK_TEST_END();
+}
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkParallelFor.h>
 
 // itk
 #include <itkAntiAliasBinaryImageFilter.h>
@@ -28,14 +29,74 @@ found in the LICENSE file.
 
 // vtk
 #include <vtkCleanPolyData.h>
+#include <vtkDiscreteMarchingCubes.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
+#include <vtkImageGaussianSmooth.h>
 #include <vtkLinearTransform.h>
 #include <vtkMarchingCubes.h>
+#include <vtkPolyDataNormals.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkSmartPointer.h>
+#include <vtkTransform.h>
+#include <vtkTransformPolyDataFilter.h>
+#include <vtkWindowedSincPolyDataFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  /** Voxel count and index bounding box of a single label. */
+  struct LabelExtent
+  {
+    LabelExtent() : Count(0)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        Min[i] = std::numeric_limits<int>::max();
+        Max[i] = std::numeric_limits<int>::min();
+      }
+    }
+
+    void Add(int x, int y, int z)
+    {
+      Min[0] = std::min(Min[0], x);
+      Max[0] = std::max(Max[0], x);
+      Min[1] = std::min(Min[1], y);
+      Max[1] = std::max(Max[1], y);
+      Min[2] = std::min(Min[2], z);
+      Max[2] = std::max(Max[2], z);
+      ++Count;
+    }
+
+    void Merge(const LabelExtent &other)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        Min[i] = std::min(Min[i], other.Min[i]);
+        Max[i] = std::max(Max[i], other.Max[i]);
+      }
+      Count += other.Count;
+    }
+
+    int Min[3];
+    int Max[3];
+    unsigned long Count;
+  };
+}
 
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
-  : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
+  : m_GenerateAllLabels(false),
+    m_RequestedLabel(1),
+    m_BackgroundLabel(0),
+    m_UseSmoothing(0),
+    m_Sigma(0.1),
+    m_SmoothingIterations(15),
+    m_TargetReduction(0.0f)
 {
 }
 
@@ -79,7 +140,242 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   if (!outputSurface)
     return;
 
-  AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
+  if (m_GenerateAllLabels)
+  {
+    AccessFixedDimensionByItk(inputImage, InternalMultiLabelProcessing, 3);
+  }
+  else
+  {
+    AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
+  }
+}
+
+mitk::LabelSetImageToSurfaceFilter::LabelType mitk::LabelSetImageToSurfaceFilter::GetLabelForNthOutput(
+  unsigned int idx) const
+{
+  auto it = m_IndexToLabels.find(idx);
+  if (it != m_IndexToLabels.end())
+    return it->second;
+
+  itkWarningMacro("Unknown output index encountered: " << idx);
+  return static_cast<LabelType>(m_BackgroundLabel);
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::InternalMultiLabelProcessing(const itk::Image<TPixel, VDimension> *input)
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef std::map<TPixel, LabelExtent> ExtentMapType;
+
+  const typename ImageType::RegionType region = input->GetBufferedRegion();
+  const int dimX = static_cast<int>(region.GetSize(0));
+  const int dimY = static_cast<int>(region.GetSize(1));
+  const int dimZ = static_cast<int>(region.GetSize(2));
+  const TPixel *buffer = input->GetBufferPointer();
+  const TPixel background = static_cast<TPixel>(m_BackgroundLabel);
+
+  // Single pass over the label volume: collect voxel count and bounding box of
+  // every label. Each range of slices is collected in its own map.
+  ExtentMapType extents;
+  std::mutex extentsMutex;
+
+  mitk::ParallelForRanges(dimZ, 0, [&](std::size_t beginZ, std::size_t endZ) {
+    ExtentMapType localExtents;
+
+    for (int z = static_cast<int>(beginZ); z < static_cast<int>(endZ); ++z)
+    {
+      const TPixel *slice = buffer + static_cast<size_t>(z) * dimX * dimY;
+      for (int y = 0; y < dimY; ++y)
+      {
+        const TPixel *row = slice + static_cast<size_t>(y) * dimX;
+
+        // Labels appear in runs, so the map is only consulted when the value changes.
+        TPixel currentLabel = background;
+        LabelExtent *currentExtent = nullptr;
+
+        for (int x = 0; x < dimX; ++x)
+        {
+          const TPixel value = row[x];
+          if (value == background)
+            continue;
+
+          if (currentExtent == nullptr || value != currentLabel)
+          {
+            currentLabel = value;
+            currentExtent = &localExtents[value];
+          }
+          currentExtent->Add(x, y, z);
+        }
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(extentsMutex);
+    for (const auto &entry : localExtents)
+      extents[entry.first].Merge(entry.second);
+  });
+
+  m_AvailableLabels.clear();
+  m_IndexToLabels.clear();
+
+  std::vector<TPixel> labels;
+  std::vector<LabelExtent> labelExtents;
+  for (const auto &entry : extents)
+  {
+    m_AvailableLabels[static_cast<LabelType>(entry.first)] = entry.second.Count;
+    m_IndexToLabels[static_cast<unsigned int>(labels.size())] = static_cast<LabelType>(entry.first);
+    labels.push_back(entry.first);
+    labelExtents.push_back(entry.second);
+  }
+
+  const int numberOfLabels = static_cast<int>(labels.size());
+  std::vector<vtkSmartPointer<vtkPolyData>> polyDatas(numberOfLabels);
+
+  vtkSmartPointer<vtkMatrix4x4> indexToWorld = vtkSmartPointer<vtkMatrix4x4>::New();
+  this->GetInput()->GetGeometry()->GetVtkTransform()->GetMatrix(indexToWorld);
+
+  const bool useSmoothing = m_UseSmoothing != 0;
+  const unsigned int smoothingIterations = m_SmoothingIterations;
+  const float targetReduction = m_TargetReduction;
+
+  // Like in single-label mode, the mask of each label is smoothed by a gaussian with the standard deviation
+  // m_Sigma in world units. The mask is padded by three standard deviations, so the blurred label is not cut off.
+  const bool useGaussianSmoothing = useSmoothing && m_Sigma > 0.0f;
+  double standardDeviations[3] = {0.0, 0.0, 0.0};
+  int padding[3] = {1, 1, 1};
+  if (useGaussianSmoothing)
+  {
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      standardDeviations[d] = m_Sigma / input->GetSpacing()[d];
+      padding[d] = 1 + static_cast<int>(std::ceil(3.0 * standardDeviations[d]));
+    }
+  }
+
+  // Extract the surfaces of all labels concurrently. Each label only touches its
+  // own bounding box (plus a one voxel border of background to close the surface).
+  mitk::ParallelFor(numberOfLabels, 0, [&](std::size_t i) {
+    const TPixel label = labels[i];
+    const LabelExtent &extent = labelExtents[i];
+
+    // The extent is given in index coordinates, so origin 0 and spacing 1 yield
+    // points in index space which are then mapped by the index-to-world matrix.
+    vtkSmartPointer<vtkImageData> mask = vtkSmartPointer<vtkImageData>::New();
+    mask->SetOrigin(0.0, 0.0, 0.0);
+    mask->SetSpacing(1.0, 1.0, 1.0);
+    mask->SetExtent(extent.Min[0] - padding[0],
+                    extent.Max[0] + padding[0],
+                    extent.Min[1] - padding[1],
+                    extent.Max[1] + padding[1],
+                    extent.Min[2] - padding[2],
+                    extent.Max[2] + padding[2]);
+    mask->AllocateScalars(useGaussianSmoothing ? VTK_FLOAT : VTK_UNSIGNED_CHAR, 1);
+
+    auto fillMask = [&](auto *maskBuffer) {
+      for (int z = extent.Min[2] - padding[2]; z <= extent.Max[2] + padding[2]; ++z)
+      {
+        for (int y = extent.Min[1] - padding[1]; y <= extent.Max[1] + padding[1]; ++y)
+        {
+          const bool rowInside = z >= extent.Min[2] && z <= extent.Max[2] && y >= extent.Min[1] && y <= extent.Max[1];
+          const TPixel *row = buffer + (static_cast<size_t>(z) * dimY + y) * dimX;
+
+          for (int x = extent.Min[0] - padding[0]; x <= extent.Max[0] + padding[0]; ++x)
+            *maskBuffer++ = (rowInside && x >= extent.Min[0] && x <= extent.Max[0] && row[x] == label) ? 1 : 0;
+        }
+      }
+    };
+
+    vtkSmartPointer<vtkPolyData> polyData;
+    if (useGaussianSmoothing)
+    {
+      fillMask(static_cast<float *>(mask->GetScalarPointer()));
+
+      // the labels are already processed in parallel
+      vtkSmartPointer<vtkImageGaussianSmooth> gaussian = vtkSmartPointer<vtkImageGaussianSmooth>::New();
+      gaussian->SetInputData(mask);
+      gaussian->SetDimensionality(3);
+      gaussian->SetStandardDeviations(standardDeviations);
+      gaussian->SetRadiusFactors(3.0, 3.0, 3.0);
+      gaussian->SetNumberOfThreads(1);
+
+      vtkSmartPointer<vtkMarchingCubes> marching = vtkSmartPointer<vtkMarchingCubes>::New();
+      marching->SetInputConnection(gaussian->GetOutputPort());
+      marching->ComputeNormalsOff();
+      marching->ComputeGradientsOff();
+      marching->ComputeScalarsOff();
+      marching->SetValue(0, 0.5);
+      marching->Update();
+      polyData = marching->GetOutput();
+    }
+    else
+    {
+      fillMask(static_cast<unsigned char *>(mask->GetScalarPointer()));
+
+      vtkSmartPointer<vtkDiscreteMarchingCubes> marching = vtkSmartPointer<vtkDiscreteMarchingCubes>::New();
+      marching->SetInputData(mask);
+      marching->ComputeNormalsOff();
+      marching->ComputeGradientsOff();
+      marching->ComputeScalarsOff();
+      marching->SetValue(0, 1);
+      marching->Update();
+      polyData = marching->GetOutput();
+    }
+
+    if (useSmoothing && smoothingIterations > 0)
+    {
+      vtkSmartPointer<vtkWindowedSincPolyDataFilter> smoother = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+      smoother->SetInputData(polyData);
+      smoother->SetNumberOfIterations(smoothingIterations);
+      smoother->BoundarySmoothingOff();
+      smoother->FeatureEdgeSmoothingOff();
+      smoother->NonManifoldSmoothingOn();
+      smoother->NormalizeCoordinatesOn();
+      smoother->SetPassBand(0.1);
+      smoother->Update();
+      polyData = smoother->GetOutput();
+    }
+
+    if (targetReduction > 0.0f && polyData->GetNumberOfPolys() > 0)
+    {
+      vtkSmartPointer<vtkQuadricDecimation> decimation = vtkSmartPointer<vtkQuadricDecimation>::New();
+      decimation->SetInputData(polyData);
+      decimation->SetTargetReduction(targetReduction);
+      decimation->Update();
+      polyData = decimation->GetOutput();
+    }
+
+    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
+    transform->SetMatrix(indexToWorld);
+
+    vtkSmartPointer<vtkTransformPolyDataFilter> transformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+    transformFilter->SetInputData(polyData);
+    transformFilter->SetTransform(transform);
+
+    vtkSmartPointer<vtkPolyDataNormals> normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+    normals->SetInputConnection(transformFilter->GetOutputPort());
+    normals->SplittingOff();
+    normals->Update();
+
+    polyDatas[i] = normals->GetOutput();
+  });
+
+  // The outputs are created and filled sequentially, only the extraction itself runs in parallel.
+  const unsigned int numberOfOutputs = std::max(1, numberOfLabels);
+  this->SetNumberOfIndexedOutputs(numberOfOutputs);
+  for (unsigned int i = 0; i < numberOfOutputs; ++i)
+  {
+    if (this->GetOutput(i) == nullptr)
+      this->SetNthOutput(i, this->MakeOutput(i));
+  }
+
+  if (numberOfLabels == 0)
+  {
+    itkWarningMacro("No labels found in the input image.");
+    this->GetOutput(0)->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New(), 0);
+    return;
+  }
+
+  for (int i = 0; i < numberOfLabels; ++i)
+    this->GetOutput(i)->SetVtkPolyData(polyDatas[i], 0);
 }
 
 template <typename TPixel, unsigned int VDimension>
@@ -30,6 +30,12 @@ namespace mitk
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
    * you may call GenerateAllLabelsOn().
+   *
+   * In multi-label mode the label volume is traversed only once to determine the
+   * bounding box and voxel count of every label. The surfaces are then extracted
+   * in parallel with discrete marching cubes, each restricted to the bounding box
+   * of its label, and optionally smoothed and decimated. The filter provides one
+   * output per label; use GetLabelForNthOutput() to map an output to its label.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -101,10 +107,36 @@ namespace mitk
     itkSetMacro(UseSmoothing, int);
 
     /**
-     * Sets the Sigma used in the gaussian smoothing
+     * Sets the Sigma (in world units) used in the gaussian smoothing of the label mask if smoothing is enabled.
+     * In multi-label mode the smoothing is applied to the mask of each label.
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Sets the number of windowed sinc smoothing iterations applied to each mesh in
+     * multi-label mode if smoothing is enabled, by default 15
+     */
+    itkSetMacro(SmoothingIterations, unsigned int);
+    itkGetMacro(SmoothingIterations, unsigned int);
+
+    /**
+     * Sets the target reduction of the decimation applied to each mesh in multi-label
+     * mode. A value of 0 (the default) disables decimation.
+     */
+    itkSetClampMacro(TargetReduction, float, 0.0f, 1.0f);
+    itkGetMacro(TargetReduction, float);
+
+    /**
+     * Returns the label that was used to create the surface of the given output index
+     * in multi-label mode.
+     */
+    LabelType GetLabelForNthOutput(unsigned int idx) const;
+
+    /**
+     * Returns the number of voxels of each label found in the last multi-label run.
+     */
+    itkGetConstReferenceMacro(AvailableLabels, LabelMapType);
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -129,6 +161,9 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
 
+    template <typename TPixel, unsigned int VImageDimension>
+    void InternalMultiLabelProcessing(const itk::Image<TPixel, VImageDimension> *input);
+
     bool m_GenerateAllLabels;
 
     int m_RequestedLabel;
@@ -139,6 +174,10 @@ namespace mitk
 
     float m_Sigma;
 
+    unsigned int m_SmoothingIterations;
+
+    float m_TargetReduction;
+
     LabelMapType m_AvailableLabels;
 
     IndexToLabelMapType m_IndexToLabels;
@@ -15,6 +15,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLevelWindowProperty.h>
@@ -52,6 +53,10 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
 mitk::LabelSetImageVtkMapper2D::LabelSetImageVtkMapper2D()
 {
 }
@@ -97,33 +102,12 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     localStorage->m_NumberOfLayers = numberOfLayers;
     localStorage->m_ReslicedImageVector.clear();
     localStorage->m_ReslicerVector.clear();
-    localStorage->m_LayerTextureVector.clear();
-    localStorage->m_LevelWindowFilterVector.clear();
-    localStorage->m_LayerMapperVector.clear();
-    localStorage->m_LayerActorVector.clear();
-
-    localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
 
     for (int lidx = 0; lidx < numberOfLayers; ++lidx)
     {
       localStorage->m_ReslicedImageVector.push_back(vtkSmartPointer<vtkImageData>::New());
       localStorage->m_ReslicerVector.push_back(mitk::ExtractSliceFilter::New());
-      localStorage->m_LayerTextureVector.push_back(vtkSmartPointer<vtkNeverTranslucentTexture>::New());
-      localStorage->m_LevelWindowFilterVector.push_back(vtkSmartPointer<vtkMitkLevelWindowFilter>::New());
-      localStorage->m_LayerMapperVector.push_back(vtkSmartPointer<vtkPolyDataMapper>::New());
-      localStorage->m_LayerActorVector.push_back(vtkSmartPointer<vtkActor>::New());
-
-      // do not repeat the texture (the image)
-      localStorage->m_LayerTextureVector[lidx]->RepeatOff();
-
-      // set corresponding mappers for the actors
-      localStorage->m_LayerActorVector[lidx]->SetMapper(localStorage->m_LayerMapperVector[lidx]);
-
-      localStorage->m_Actors->AddPart(localStorage->m_LayerActorVector[lidx]);
     }
-
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineShadowActor);
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineActor);
   }
 
   // early out if there is no intersection of the current rendering geometry
@@ -134,128 +118,337 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     // the latest image is used there if the plane is out of the geometry
     // see bug-13275
     for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
       localStorage->m_ReslicedImageVector[lidx] = nullptr;
-      localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
-      localStorage->m_OutlineActor->SetVisibility(false);
-      localStorage->m_OutlineShadowActor->SetVisibility(false);
-    }
+
+    localStorage->m_LabelMapper->SetInputData(localStorage->m_EmptyPolyData);
+    localStorage->m_OutlineActor->SetVisibility(false);
+    localStorage->m_OutlineShadowActor->SetVisibility(false);
     return;
   }
 
-  for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+  // is the geometry of the slice based on the image image or the worldgeometry?
+  bool inPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+
+  // The slice geometry is computed once by the reslicer of the active layer. For planar
+  // geometries, all other layers are sampled on the same grid in a single traversal.
+  // Curved geometries fall back to reslicing every layer separately.
+  mitk::ExtractSliceFilter *activeReslicer = localStorage->m_ReslicerVector[activeLayer];
+  activeReslicer->SetInput(image);
+  activeReslicer->SetWorldGeometry(worldGeometry);
+  activeReslicer->SetTimeStep(this->GetTimestep());
+
+  // set the transformation of the image to adapt reslice axis
+  activeReslicer->SetResliceTransformByGeometry(image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+
+  activeReslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+  activeReslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+  activeReslicer->SetVtkOutputRequest(true);
+
+  // this is needed when thick mode was enabled before. These variables have to be reset to default values
+  activeReslicer->SetOutputDimensionality(2);
+  activeReslicer->SetOutputSpacingZDirection(1.0);
+  activeReslicer->SetOutputExtentZDirection(0, 0);
+
+  // Bounds information for reslicing (only required if reference geometry is present)
+  // this used for generating a vtkPLaneSource with the right size
+  double sliceBounds[6];
+  sliceBounds[0] = 0.0;
+  sliceBounds[1] = 0.0;
+  sliceBounds[2] = 0.0;
+  sliceBounds[3] = 0.0;
+  sliceBounds[4] = 0.0;
+  sliceBounds[5] = 0.0;
+
+  activeReslicer->GetClippedPlaneBounds(sliceBounds);
+
+  // setup the textured plane
+  this->GeneratePlane(renderer, sliceBounds);
+
+  // get the spacing of the slice
+  localStorage->m_mmPerPixel = activeReslicer->GetOutputSpacing();
+  activeReslicer->Modified();
+  // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
+  activeReslicer->UpdateLargestPossibleRegion();
+  localStorage->m_ReslicedImageVector[activeLayer] = activeReslicer->GetVtkOutput();
+
+  if (!this->ResliceInactiveLayers(renderer, image, worldGeometry))
   {
-    mitk::Image *layerImage = nullptr;
+    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+    {
+      if (lidx == activeLayer)
+        continue;
+
+      mitk::Image *layerImage = image->GetLayerImage(lidx);
+      mitk::ExtractSliceFilter *reslicer = localStorage->m_ReslicerVector[lidx];
+      reslicer->SetInput(layerImage);
+      reslicer->SetWorldGeometry(worldGeometry);
+      reslicer->SetTimeStep(this->GetTimestep());
+      reslicer->SetResliceTransformByGeometry(
+        layerImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+      reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+      reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+      reslicer->SetVtkOutputRequest(true);
+      reslicer->SetOutputDimensionality(2);
+      reslicer->SetOutputSpacingZDirection(1.0);
+      reslicer->SetOutputExtentZDirection(0, 0);
+      reslicer->Modified();
+      reslicer->UpdateLargestPossibleRegion();
+      localStorage->m_ReslicedImageVector[lidx] = reslicer->GetVtkOutput();
+    }
+  }
+
+  this->ComposeLabelImage(renderer);
+
+  // check for texture interpolation property
+  bool textureInterpolation = false;
+  node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+
+  // set the interpolation modus according to the property
+  localStorage->m_LabelTexture->SetInterpolate(textureInterpolation);
+
+  this->TransformActor(renderer);
+
+  // set the plane as input for the mapper
+  localStorage->m_LabelMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+  localStorage->m_LabelActor->GetProperty()->SetOpacity(opacity);
+
+  this->UpdateOutline(renderer);
+}
 
-    // set main input for ExtractSliceFilter
+bool mitk::LabelSetImageVtkMapper2D::ResliceInactiveLayers(mitk::BaseRenderer *renderer,
+                                                           mitk::LabelSetImage *image,
+                                                           const PlaneGeometry *worldGeometry)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  const int numberOfLayers = localStorage->m_NumberOfLayers;
+  const int activeLayer = image->GetActiveLayer();
+
+  vtkImageData *activeSlice = localStorage->m_ReslicedImageVector[activeLayer];
+  const int *extent = activeSlice->GetExtent();
+  const int width = extent[1] - extent[0] + 1;
+  const int height = extent[3] - extent[2] + 1;
+  const size_t numberOfPixels = static_cast<size_t>(width) * height;
+
+  localStorage->m_InsideMask.assign(numberOfPixels, 1);
+
+  // Curved geometries do not provide an affine mapping from slice pixels to voxels.
+  if (dynamic_cast<const AbstractTransformGeometry *>(worldGeometry) != nullptr)
+    return false;
+
+  const BaseGeometry *imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep());
+  vtkMatrix4x4 *resliceAxes = localStorage->m_ReslicerVector[activeLayer]->GetResliceAxes();
+  const mitk::ScalarType *spacing = localStorage->m_mmPerPixel;
+
+  // The reslicer maps the slice pixel (i, j) to the world position resliceAxes * (i * sx, j * sy, 0).
+  // Mapping three pixels to continuous voxel indices yields the affine pixel-to-index mapping.
+  auto sliceToIndex = [&](int i, int j) {
+    const double slicePoint[4] = {i * spacing[0], j * spacing[1], 0.0, 1.0};
+    double worldPoint[4];
+    resliceAxes->MultiplyPoint(slicePoint, worldPoint);
+
+    Point3D world;
+    world[0] = worldPoint[0];
+    world[1] = worldPoint[1];
+    world[2] = worldPoint[2];
+
+    Point3D index;
+    imageGeometry->WorldToIndex(world, index);
+    return index;
+  };
+
+  const Point3D origin = sliceToIndex(extent[0], extent[2]);
+  const Vector3D stepI = sliceToIndex(extent[0] + 1, extent[2]) - origin;
+  const Vector3D stepJ = sliceToIndex(extent[0], extent[2] + 1) - origin;
+
+  const long dimX = static_cast<long>(image->GetDimension(0));
+  const long dimY = static_cast<long>(image->GetDimension(1));
+  const long dimZ = static_cast<long>(image->GetDimension(2));
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const Label::PixelType *> layerBuffers;
+  std::vector<Label::PixelType *> sliceBuffers;
+
+  for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+  {
     if (lidx == activeLayer)
-      layerImage = image;
-    else
-      layerImage = image->GetLayerImage(lidx);
-
-    localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
-    localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetTimeStep(this->GetTimestep());
-
-    // set the transformation of the image to adapt reslice axis
-    localStorage->m_ReslicerVector[lidx]->SetResliceTransformByGeometry(
-      layerImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
-
-    // is the geometry of the slice based on the image image or the worldgeometry?
-    bool inPlaneResampleExtentByGeometry = false;
-    node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
-    localStorage->m_ReslicerVector[lidx]->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-    localStorage->m_ReslicerVector[lidx]->SetVtkOutputRequest(true);
-
-    // this is needed when thick mode was enabled before. These variables have to be reset to default values
-    localStorage->m_ReslicerVector[lidx]->SetOutputDimensionality(2);
-    localStorage->m_ReslicerVector[lidx]->SetOutputSpacingZDirection(1.0);
-    localStorage->m_ReslicerVector[lidx]->SetOutputExtentZDirection(0, 0);
-
-    // Bounds information for reslicing (only required if reference geometry is present)
-    // this used for generating a vtkPLaneSource with the right size
-    double sliceBounds[6];
-    sliceBounds[0] = 0.0;
-    sliceBounds[1] = 0.0;
-    sliceBounds[2] = 0.0;
-    sliceBounds[3] = 0.0;
-    sliceBounds[4] = 0.0;
-    sliceBounds[5] = 0.0;
-
-    localStorage->m_ReslicerVector[lidx]->GetClippedPlaneBounds(sliceBounds);
-
-    // setup the textured plane
-    this->GeneratePlane(renderer, sliceBounds);
-
-    // get the spacing of the slice
-    localStorage->m_mmPerPixel = localStorage->m_ReslicerVector[lidx]->GetOutputSpacing();
-    localStorage->m_ReslicerVector[lidx]->Modified();
-    // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
-    localStorage->m_ReslicerVector[lidx]->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImageVector[lidx] = localStorage->m_ReslicerVector[lidx]->GetVtkOutput();
-
-    const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
-
-    double textureClippingBounds[6];
-    for (auto &textureClippingBound : textureClippingBounds)
+      continue;
+
+    mitk::Image *layerImage = image->GetLayerImage(lidx);
+    accessors.emplace_back(new ImageReadAccessor(layerImage, layerImage->GetVolumeData(this->GetTimestep())));
+    layerBuffers.push_back(static_cast<const Label::PixelType *>(accessors.back()->GetData()));
+
+    vtkSmartPointer<vtkImageData> slice = vtkSmartPointer<vtkImageData>::New();
+    slice->SetExtent(extent[0], extent[1], extent[2], extent[3], 0, 0);
+    slice->SetSpacing(activeSlice->GetSpacing());
+    slice->SetOrigin(activeSlice->GetOrigin());
+    slice->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+    localStorage->m_ReslicedImageVector[lidx] = slice;
+    sliceBuffers.push_back(static_cast<Label::PixelType *>(slice->GetScalarPointer()));
+  }
+
+  const size_t numberOfInactiveLayers = layerBuffers.size();
+  unsigned char *insideMask = localStorage->m_InsideMask.data();
+
+  // Nearest neighbour sampling of all inactive layers in one pass over the slice.
+  size_t pixel = 0;
+  for (int j = 0; j < height; ++j)
+  {
+    for (int i = 0; i < width; ++i, ++pixel)
     {
-      textureClippingBound = 0.0;
-    }
+      const long x = static_cast<long>(std::floor(origin[0] + i * stepI[0] + j * stepJ[0] + 0.5));
+      const long y = static_cast<long>(std::floor(origin[1] + i * stepI[1] + j * stepJ[1] + 0.5));
+      const long z = static_cast<long>(std::floor(origin[2] + i * stepI[2] + j * stepJ[2] + 0.5));
+
+      if (x < 0 || y < 0 || z < 0 || x >= dimX || y >= dimY || z >= dimZ)
+      {
+        insideMask[pixel] = 0;
+        for (size_t l = 0; l < numberOfInactiveLayers; ++l)
+          sliceBuffers[l][pixel] = 0;
+        continue;
+      }
 
-    // Calculate the actual bounds of the transformed plane clipped by the
-    // dataset bounding box; this is required for drawing the texture at the
-    // correct position during 3D mapping.
-    mitk::PlaneClipping::CalculateClippedPlaneBounds(layerImage->GetGeometry(), planeGeometry, textureClippingBounds);
+      const size_t offset = static_cast<size_t>(x + dimX * (y + dimY * z));
+      for (size_t l = 0; l < numberOfInactiveLayers; ++l)
+        sliceBuffers[l][pixel] = layerBuffers[l][offset];
+    }
+  }
 
-    textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / localStorage->m_mmPerPixel[1] + 0.5);
-    textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / localStorage->m_mmPerPixel[1] + 0.5);
+  return true;
+}
 
-    // clipping bounds for cutting the imageLayer
-    localStorage->m_LevelWindowFilterVector[lidx]->SetClippingBounds(textureClippingBounds);
+void mitk::LabelSetImageVtkMapper2D::ComposeLabelImage(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  auto *image = dynamic_cast<mitk::LabelSetImage *>(this->GetDataNode()->GetData());
+  const int numberOfLayers = localStorage->m_NumberOfLayers;
 
-    localStorage->m_LevelWindowFilterVector[lidx]->SetLookupTable(
-      image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
+  if (numberOfLayers == 0 || localStorage->m_ReslicedImageVector[image->GetActiveLayer()] == nullptr)
+    return;
 
-    // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter)
-    localStorage->m_LayerTextureVector[lidx]->SetColorModeToDirectScalars();
+  vtkImageData *referenceSlice = localStorage->m_ReslicedImageVector[image->GetActiveLayer()];
+  const int *extent = referenceSlice->GetExtent();
+  const size_t numberOfPixels = static_cast<size_t>(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1);
 
-    // connect the imageLayer with the levelwindow filter
-    localStorage->m_LevelWindowFilterVector[lidx]->SetInputData(localStorage->m_ReslicedImageVector[lidx]);
-    // connect the texture with the output of the levelwindow filter
+  vtkImageData *labelImage = localStorage->m_LabelImage;
+  int *labelExtent = labelImage->GetExtent();
+  if (labelImage->GetNumberOfScalarComponents() != 4 || labelExtent[0] != extent[0] || labelExtent[1] != extent[1] ||
+      labelExtent[2] != extent[2] || labelExtent[3] != extent[3])
+  {
+    labelImage->SetExtent(extent[0], extent[1], extent[2], extent[3], 0, 0);
+    labelImage->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+  }
+  labelImage->SetSpacing(referenceSlice->GetSpacing());
+  labelImage->SetOrigin(referenceSlice->GetOrigin());
 
-    // check for texture interpolation property
-    bool textureInterpolation = false;
-    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+  // The label values are used directly as indices into the RGBA tables of the lookup tables.
+  std::vector<const Label::PixelType *> slices;
+  std::vector<const unsigned char *> colorTables;
+  std::vector<vtkIdType> numberOfColors;
+  for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+  {
+    vtkImageData *slice = localStorage->m_ReslicedImageVector[lidx];
+    if (slice == nullptr || slice->GetScalarPointer() == nullptr)
+      return;
 
-    // set the interpolation modus according to the property
-    localStorage->m_LayerTextureVector[lidx]->SetInterpolate(textureInterpolation);
+    vtkLookupTable *lookupTable = image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable();
+    slices.push_back(static_cast<const Label::PixelType *>(slice->GetScalarPointer()));
+    colorTables.push_back(lookupTable->GetPointer(0));
+    numberOfColors.push_back(lookupTable->GetNumberOfTableValues());
+  }
 
-    localStorage->m_LayerTextureVector[lidx]->SetInputConnection(
-      localStorage->m_LevelWindowFilterVector[lidx]->GetOutputPort());
+  const unsigned char *insideMask =
+    localStorage->m_InsideMask.size() == numberOfPixels ? localStorage->m_InsideMask.data() : nullptr;
+  auto *rgba = static_cast<unsigned char *>(labelImage->GetScalarPointer());
+  static const unsigned char transparent[4] = {0, 0, 0, 0};
 
-    this->TransformActor(renderer);
+  for (size_t pixel = 0; pixel < numberOfPixels; ++pixel, rgba += 4)
+  {
+    if (insideMask != nullptr && !insideMask[pixel])
+    {
+      std::copy(transparent, transparent + 4, rgba);
+      continue;
+    }
 
-    // set the plane as input for the mapper
-    localStorage->m_LayerMapperVector[lidx]->SetInputConnection(localStorage->m_Plane->GetOutputPort());
+    // Blend the layers back to front, the last layer is on top.
+    double color[3] = {0.0, 0.0, 0.0};
+    double alpha = 0.0;
+    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
+    {
+      const Label::PixelType value = slices[lidx][pixel];
+      if (value >= numberOfColors[lidx])
+        continue;
+
+      const unsigned char *layerColor = colorTables[lidx] + 4 * static_cast<size_t>(value);
+      if (layerColor[3] == 0)
+        continue;
+
+      const double layerAlpha = layerColor[3] / 255.0;
+      const double newAlpha = layerAlpha + alpha * (1.0 - layerAlpha);
+      for (int c = 0; c < 3; ++c)
+        color[c] = (layerColor[c] * layerAlpha + color[c] * alpha * (1.0 - layerAlpha)) / newAlpha;
+      alpha = newAlpha;
+    }
 
-    // set the texture for the actor
-    localStorage->m_LayerActorVector[lidx]->SetTexture(localStorage->m_LayerTextureVector[lidx]);
-    localStorage->m_LayerActorVector[lidx]->GetProperty()->SetOpacity(opacity);
+    rgba[0] = static_cast<unsigned char>(color[0] + 0.5);
+    rgba[1] = static_cast<unsigned char>(color[1] + 0.5);
+    rgba[2] = static_cast<unsigned char>(color[2] + 0.5);
+    rgba[3] = static_cast<unsigned char>(alpha * 255.0 + 0.5);
   }
 
-  mitk::Label* activeLabel = image->GetActiveLabel(activeLayer);
-  if (nullptr != activeLabel)
+  labelImage->Modified();
+}
+
+void mitk::LabelSetImageVtkMapper2D::UpdateOutline(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  mitk::DataNode *node = this->GetDataNode();
+  auto *image = dynamic_cast<mitk::LabelSetImage *>(node->GetData());
+  int activeLayer = image->GetActiveLayer();
+
+  float opacity = 1.0f;
+  node->GetOpacity(opacity, renderer, "opacity");
+
+  mitk::Label *activeLabel = image->GetActiveLabel(activeLayer);
+  vtkImageData *activeSlice = localStorage->m_NumberOfLayers > activeLayer
+                                ? localStorage->m_ReslicedImageVector[activeLayer].GetPointer()
+                                : nullptr;
+  if (nullptr != activeLabel && nullptr != activeSlice)
   {
     bool contourActive = false;
     node->GetBoolProperty("labelset.contour.active", contourActive, renderer);
     if (contourActive && activeLabel->GetVisible()) //contour rendering
     {
-      //generate contours/outlines
-      localStorage->m_OutlinePolyData =
-        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImageVector[activeLayer], activeLabel->GetValue());
+      // regenerate contours/outlines only if the slice or the label changed, colors
+      // and visibilities are applied to the actors below
+      const int labelValue = activeLabel->GetValue();
+      const float depth = this->CalculateLayerDepth(renderer);
+
+      // the reslicers are modified on every update, so the slice is compared by its geometry and values
+      std::vector<double> sliceGeometry;
+      vtkMatrix4x4 *resliceAxes = localStorage->m_ReslicerVector[activeLayer]->GetResliceAxes();
+      for (int row = 0; row < 4; ++row)
+        sliceGeometry.insert(sliceGeometry.end(), resliceAxes->Element[row], resliceAxes->Element[row] + 4);
+      sliceGeometry.insert(sliceGeometry.end(), localStorage->m_mmPerPixel, localStorage->m_mmPerPixel + 2);
+      const int *extent = activeSlice->GetExtent();
+      sliceGeometry.insert(sliceGeometry.end(), extent, extent + 6);
+
+      const auto *sliceValues = static_cast<const mitk::Label::PixelType *>(activeSlice->GetScalarPointer());
+      const auto numberOfValues = static_cast<size_t>(activeSlice->GetNumberOfPoints());
+
+      if (localStorage->m_OutlineSliceGeometry != sliceGeometry ||
+          localStorage->m_OutlineSliceValues.size() != numberOfValues ||
+          !std::equal(sliceValues, sliceValues + numberOfValues, localStorage->m_OutlineSliceValues.begin()) ||
+          localStorage->m_OutlineLabelValue != labelValue || localStorage->m_OutlineDepth != depth)
+      {
+        localStorage->m_OutlinePolyData = this->CreateOutlinePolyData(renderer, activeSlice, labelValue);
+        localStorage->m_OutlineSliceGeometry = sliceGeometry;
+        localStorage->m_OutlineSliceValues.assign(sliceValues, sliceValues + numberOfValues);
+        localStorage->m_OutlineLabelValue = labelValue;
+        localStorage->m_OutlineDepth = depth;
+        localStorage->m_OutlineMapper->SetInputData(localStorage->m_OutlinePolyData);
+      }
+
       localStorage->m_OutlineActor->SetVisibility(true);
       localStorage->m_OutlineShadowActor->SetVisibility(true);
       const mitk::Color& color = activeLabel->GetColor();
@@ -269,8 +462,6 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
       localStorage->m_OutlineActor->GetProperty()->SetOpacity(opacity);
       localStorage->m_OutlineShadowActor->GetProperty()->SetOpacity(opacity);
-
-      localStorage->m_OutlineMapper->SetInputData(localStorage->m_OutlinePolyData);
       return;
     }
   }
@@ -474,22 +665,20 @@ void mitk::LabelSetImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer, co
   localStorage->m_OutlineShadowActor->GetProperty()->SetColor(0, 0, 0);
 }
 
-void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer, int layer)
+void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer, int /*layer*/)
 {
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   this->GetDataNode()->GetOpacity(opacity, renderer, "opacity");
-  localStorage->m_LayerActorVector[layer]->GetProperty()->SetOpacity(opacity);
+  localStorage->m_LabelActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineShadowActor->GetProperty()->SetOpacity(opacity);
 }
 
-void mitk::LabelSetImageVtkMapper2D::ApplyLookuptable(mitk::BaseRenderer *renderer, int layer)
+void mitk::LabelSetImageVtkMapper2D::ApplyLookuptable(mitk::BaseRenderer *renderer, int /*layer*/)
 {
-  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
-  auto *input = dynamic_cast<mitk::LabelSetImage *>(this->GetDataNode()->GetData());
-  localStorage->m_LevelWindowFilterVector[layer]->SetLookupTable(
-    input->GetLabelSet(layer)->GetLookupTable()->GetVtkLookupTable());
+  // all layers share one texture, so the whole label image is composed again
+  this->ComposeLabelImage(renderer);
 }
 
 void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
@@ -530,12 +719,41 @@ void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
     this->GenerateDataForRenderer(renderer);
     localStorage->m_LastDataUpdateTime.Modified();
   }
-  else if ((localStorage->m_LastPropertyUpdateTime < node->GetPropertyList()->GetMTime()) ||
-           (localStorage->m_LastPropertyUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-           (localStorage->m_LastPropertyUpdateTime < image->GetPropertyList()->GetMTime()))
+  else
   {
-    this->GenerateDataForRenderer(renderer);
-    localStorage->m_LastPropertyUpdateTime.Modified();
+    bool lookupTableModified = false;
+    for (unsigned int lidx = 0; lidx < image->GetNumberOfLayers(); ++lidx)
+    {
+      if (localStorage->m_LastPropertyUpdateTime < image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable()->GetMTime())
+        lookupTableModified = true;
+    }
+
+    if (lookupTableModified || static_cast<int>(image->GetNumberOfLayers()) != localStorage->m_NumberOfLayers ||
+        (localStorage->m_LastPropertyUpdateTime < node->GetPropertyList()->GetMTime()) ||
+        (localStorage->m_LastPropertyUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
+        (localStorage->m_LastPropertyUpdateTime < image->GetPropertyList()->GetMTime()))
+    {
+      if (static_cast<int>(image->GetNumberOfLayers()) != localStorage->m_NumberOfLayers)
+      {
+        this->GenerateDataForRenderer(renderer);
+      }
+      else
+      {
+        // Only colors, visibilities or other properties changed: the resliced layers and the
+        // outline of the last update are reused.
+        float opacity = 1.0f;
+        node->GetOpacity(opacity, renderer, "opacity");
+        localStorage->m_LabelActor->GetProperty()->SetOpacity(opacity);
+
+        bool textureInterpolation = false;
+        node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+        localStorage->m_LabelTexture->SetInterpolate(textureInterpolation);
+
+        this->ComposeLabelImage(renderer);
+        this->UpdateOutline(renderer);
+      }
+      localStorage->m_LastPropertyUpdateTime.Modified();
+    }
   }
 }
 
@@ -579,17 +797,16 @@ void mitk::LabelSetImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or saggital
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ReslicerVector[0]->GetResliceAxes(); // same for all layers
+  auto *image = dynamic_cast<mitk::LabelSetImage *>(this->GetDataNode()->GetData());
+  vtkSmartPointer<vtkMatrix4x4> matrix =
+    localStorage->m_ReslicerVector[image->GetActiveLayer()]->GetResliceAxes(); // same for all layers
   trans->SetMatrix(matrix);
 
-  for (int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
-  {
-    // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
-    localStorage->m_LayerActorVector[lidx]->SetUserTransform(trans);
-    // transform the origin to center based coordinates, because MITK is center based.
-    localStorage->m_LayerActorVector[lidx]->SetPosition(
-      -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
-  }
+  // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
+  localStorage->m_LabelActor->SetUserTransform(trans);
+  // transform the origin to center based coordinates, because MITK is center based.
+  localStorage->m_LabelActor->SetPosition(
+    -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
   // same for outline actor
   localStorage->m_OutlineActor->SetUserTransform(trans);
   localStorage->m_OutlineActor->SetPosition(
@@ -638,13 +855,32 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlineActor = vtkSmartPointer<vtkActor>::New();
   m_OutlineMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
   m_OutlineShadowActor = vtkSmartPointer<vtkActor>::New();
+  m_LabelActor = vtkSmartPointer<vtkActor>::New();
+  m_LabelMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_LabelTexture = vtkSmartPointer<vtkNeverTranslucentTexture>::New();
+  m_LabelImage = vtkSmartPointer<vtkImageData>::New();
 
   m_NumberOfLayers = 0;
   m_mmPerPixel = nullptr;
+  m_OutlineLabelValue = -1;
+  m_OutlineDepth = 0.0f;
+
+  // do not repeat the texture (the image) and do not use a VTK lookup table,
+  // the label colors are mapped in ComposeLabelImage()
+  m_LabelTexture->RepeatOff();
+  m_LabelTexture->SetColorModeToDirectScalars();
+  m_LabelTexture->SetInputData(m_LabelImage);
+
+  m_LabelActor->SetMapper(m_LabelMapper);
+  m_LabelActor->SetTexture(m_LabelTexture);
 
   m_OutlineActor->SetMapper(m_OutlineMapper);
   m_OutlineShadowActor->SetMapper(m_OutlineMapper);
 
+  m_Actors->AddPart(m_LabelActor);
+  m_Actors->AddPart(m_OutlineShadowActor);
+  m_Actors->AddPart(m_OutlineActor);
+
   m_OutlineActor->SetVisibility(false);
   m_OutlineShadowActor->SetVisibility(false);
 }
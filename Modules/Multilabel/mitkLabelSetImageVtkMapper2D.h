@@ -42,6 +42,12 @@ namespace mitk
 {
 
   /** \brief Mapper to resample and display 2D slices of a 3D labelset image.
+   *
+   * All layers are rendered into a single RGBA texture. Only the active layer is resliced
+   * by an ExtractSliceFilter; the resulting slice geometry is shared with all other layers,
+   * which are sampled together in one nearest neighbour pass. The label values are mapped
+   * directly to colors through the lookup tables of the label sets. If only properties or
+   * label colors change, the resliced layers and the outline are reused.
    *
    * Properties that can be set for labelset images and influence this mapper are:
    *
@@ -87,14 +93,25 @@ namespace mitk
     public:
       vtkSmartPointer<vtkPropAssembly> m_Actors;
 
-      std::vector<vtkSmartPointer<vtkActor>> m_LayerActorVector;
-      std::vector<vtkSmartPointer<vtkPolyDataMapper>> m_LayerMapperVector;
+      /** \brief Actor, mapper and texture showing the combined labels of all layers. */
+      vtkSmartPointer<vtkActor> m_LabelActor;
+      vtkSmartPointer<vtkPolyDataMapper> m_LabelMapper;
+      vtkSmartPointer<vtkNeverTranslucentTexture> m_LabelTexture;
+
+      /** \brief RGBA image the label colors of all layers are blended into. */
+      vtkSmartPointer<vtkImageData> m_LabelImage;
+
+      /** \brief The resliced label values of each layer. */
       std::vector<vtkSmartPointer<vtkImageData>> m_ReslicedImageVector;
-      std::vector<vtkSmartPointer<vtkNeverTranslucentTexture>> m_LayerTextureVector;
+
+      /** \brief Marks the pixels of the resliced images that lie within the image volume. */
+      std::vector<unsigned char> m_InsideMask;
 
       vtkSmartPointer<vtkPolyData> m_EmptyPolyData;
       vtkSmartPointer<vtkPlaneSource> m_Plane;
 
+      /** \brief One reslicer per layer. Only the reslicer of the active layer is used for planar
+       * geometries, it defines the slice geometry all other layers are sampled with. */
       std::vector<mitk::ExtractSliceFilter::Pointer> m_ReslicerVector;
 
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
@@ -105,6 +122,14 @@ namespace mitk
       /** \brief A mapper for the outline */
       vtkSmartPointer<vtkPolyDataMapper> m_OutlineMapper;
 
+      /** \brief Slice geometry (reslice axes, spacing and extent), label values of the slice, label and
+       * depth the current outline was generated for. The outline is reused if none of them changed, e.g.
+       * if only colors or visibilities changed. MTimes are not used as the reslicers are always updated. */
+      std::vector<double> m_OutlineSliceGeometry;
+      std::vector<mitk::Label::PixelType> m_OutlineSliceValues;
+      int m_OutlineLabelValue;
+      float m_OutlineDepth;
+
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastDataUpdateTime;
 
@@ -116,10 +141,6 @@ namespace mitk
 
       int m_NumberOfLayers;
 
-      /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
-      // vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
-      std::vector<vtkSmartPointer<vtkMitkLevelWindowFilter>> m_LevelWindowFilterVector;
-
       /** \brief Default constructor of the local storage. */
       LocalStorage();
       /** \brief Default deconstructor of the local storage. */
@@ -217,10 +238,25 @@ namespace mitk
      */
     void ApplyLevelWindow(mitk::BaseRenderer *renderer);
 
+    /** \brief Samples all layers except the active one on the slice grid of the active layer's reslicer.
+     * The mapping from slice pixels to voxel indices is affine for planar geometries, so it is
+     * computed only once and all layers are sampled (nearest neighbour) in a single traversal.
+     * \return false if the world geometry is not planar and the layers have to be resliced separately.
+     */
+    bool ResliceInactiveLayers(mitk::BaseRenderer *renderer, mitk::LabelSetImage *image, const PlaneGeometry *worldGeometry);
+
+    /** \brief Maps the resliced label values of all layers through their lookup tables and blends
+     * them into the single RGBA texture image. */
+    void ComposeLabelImage(mitk::BaseRenderer *renderer);
+
+    /** \brief Updates the outline of the active label. The outline is only regenerated if the
+     * resliced slice, the label or the depth changed since the last call. */
+    void UpdateOutline(mitk::BaseRenderer *renderer);
+
     /** \brief Set the color of the image/polydata */
     void ApplyColor(mitk::BaseRenderer *renderer, const mitk::Color &color);
 
-    /** \brief Set the opacity of the actor. */
+    /** \brief Set the opacity of the actors. */
     void ApplyOpacity(mitk::BaseRenderer *renderer, int layer);
 
     /**
@@ -1,3 +1,4 @@
 set(MODULE_TESTS
 mitkPersistenceTest.cpp
+mitkPropertyListsJournalTest.cpp
 )
@@ -0,0 +1,180 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include <itksys/SystemTools.hxx>
+#include <mitkIOUtil.h>
+#include <mitkPersistenceService.h>
+#include <mitkProperties.h>
+#include <mitkPropertyListsJournal.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <fstream>
+
+class mitkPropertyListsJournalTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyListsJournalTestSuite);
+  MITK_TEST(Commit_Reopen_ReturnsLatestPropertyLists);
+  MITK_TEST(Refresh_CommitOfOtherJournal_ReportsChangedIds);
+  MITK_TEST(Open_IncompleteTransaction_IsIgnored);
+  MITK_TEST(Compact_RemovesSupersededRecords);
+  MITK_TEST(PersistenceService_SaveAndLoadJournal);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_FileName;
+
+  static mitk::PropertyList::Pointer CreatePropertyList(int value)
+  {
+    mitk::PropertyList::Pointer propertyList = mitk::PropertyList::New();
+    propertyList->SetIntProperty("value", value);
+    propertyList->SetStringProperty("name", ("list " + std::to_string(value)).c_str());
+    return propertyList;
+  }
+
+  static int GetValue(const mitk::PropertyList *propertyList)
+  {
+    int value = -1;
+    CPPUNIT_ASSERT(propertyList != nullptr);
+    CPPUNIT_ASSERT(propertyList->GetIntProperty("value", value));
+    return value;
+  }
+
+public:
+  void setUp() override
+  {
+    m_FileName = mitk::IOUtil::CreateTemporaryFile("PropertyListsJournalTestXXXXXX.journal");
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveFile(m_FileName.c_str());
+  }
+
+  void Commit_Reopen_ReturnsLatestPropertyLists()
+  {
+    mitk::PropertyListsJournal::Pointer journal = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(journal->Open(m_FileName));
+    CPPUNIT_ASSERT(journal->Commit({{"a", CreatePropertyList(1)}, {"b", CreatePropertyList(2)}}, {}));
+    CPPUNIT_ASSERT(journal->Commit({{"a", CreatePropertyList(3)}}, {"b"}));
+
+    mitk::PropertyListsJournal::Pointer reopened = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(reopened->Open(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), reopened->GetPropertyListIds().size());
+    CPPUNIT_ASSERT(!reopened->Contains("b"));
+    CPPUNIT_ASSERT(reopened->ReadPropertyList("b").IsNull());
+
+    mitk::PropertyList::Pointer propertyList = reopened->ReadPropertyList("a");
+    CPPUNIT_ASSERT_EQUAL(3, GetValue(propertyList));
+    std::string name;
+    CPPUNIT_ASSERT(propertyList->GetStringProperty("name", name));
+    CPPUNIT_ASSERT_EQUAL(std::string("list 3"), name);
+  }
+
+  void Refresh_CommitOfOtherJournal_ReportsChangedIds()
+  {
+    mitk::PropertyListsJournal::Pointer writer = mitk::PropertyListsJournal::New();
+    mitk::PropertyListsJournal::Pointer reader = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(writer->Open(m_FileName));
+    CPPUNIT_ASSERT(writer->Commit({{"a", CreatePropertyList(1)}, {"b", CreatePropertyList(2)}}, {}));
+    CPPUNIT_ASSERT(reader->Open(m_FileName));
+
+    CPPUNIT_ASSERT(writer->Commit({{"c", CreatePropertyList(3)}}, {"a"}));
+    std::vector<std::string> changedIds;
+    CPPUNIT_ASSERT(reader->Refresh(changedIds));
+    CPPUNIT_ASSERT(changedIds == std::vector<std::string>({"a", "c"}));
+    CPPUNIT_ASSERT(!reader->Contains("a"));
+    CPPUNIT_ASSERT_EQUAL(3, GetValue(reader->ReadPropertyList("c")));
+
+    // a compaction replaces the file, so the whole index is read again
+    CPPUNIT_ASSERT(writer->Compact());
+    CPPUNIT_ASSERT(reader->Refresh(changedIds));
+    CPPUNIT_ASSERT(changedIds == std::vector<std::string>({"b", "c"}));
+    CPPUNIT_ASSERT_EQUAL(2, GetValue(reader->ReadPropertyList("b")));
+  }
+
+  void Open_IncompleteTransaction_IsIgnored()
+  {
+    mitk::PropertyListsJournal::Pointer journal = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(journal->Open(m_FileName));
+    CPPUNIT_ASSERT(journal->Commit({{"a", CreatePropertyList(1)}}, {}));
+    const std::streamoff committedSize = journal->GetCommittedSize();
+
+    // a transaction that was interrupted while it was written
+    {
+      std::ofstream stream(m_FileName.c_str(), std::ios::binary | std::ios::app);
+      stream << "P 2 1 100 0\na<PropertyList><property key=\"value\"";
+    }
+
+    mitk::PropertyListsJournal::Pointer reopened = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(reopened->Open(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(committedSize, reopened->GetCommittedSize());
+    CPPUNIT_ASSERT_EQUAL(1, GetValue(reopened->ReadPropertyList("a")));
+
+    // the next commit must not append behind the incomplete transaction
+    CPPUNIT_ASSERT(reopened->Commit({{"b", CreatePropertyList(2)}}, {}));
+    mitk::PropertyListsJournal::Pointer third = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(third->Open(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(1, GetValue(third->ReadPropertyList("a")));
+    CPPUNIT_ASSERT_EQUAL(2, GetValue(third->ReadPropertyList("b")));
+  }
+
+  void Compact_RemovesSupersededRecords()
+  {
+    mitk::PropertyListsJournal::Pointer journal = mitk::PropertyListsJournal::New();
+    journal->SetCompactionThreshold(1.0);
+    CPPUNIT_ASSERT(journal->Open(m_FileName));
+    for (int i = 0; i < 100; ++i)
+      CPPUNIT_ASSERT(journal->Commit({{"a", CreatePropertyList(i)}, {"b", CreatePropertyList(-i)}}, {}));
+
+    const std::streamoff sizeBeforeCompaction = journal->GetCommittedSize();
+    CPPUNIT_ASSERT(journal->GetSupersededSize() > sizeBeforeCompaction / 2);
+    CPPUNIT_ASSERT(journal->Compact());
+    CPPUNIT_ASSERT(journal->GetCommittedSize() < sizeBeforeCompaction / 50);
+    CPPUNIT_ASSERT(!itksys::SystemTools::FileExists((m_FileName + ".tmp").c_str()));
+
+    mitk::PropertyListsJournal::Pointer reopened = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(reopened->Open(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(99, GetValue(reopened->ReadPropertyList("a")));
+    CPPUNIT_ASSERT_EQUAL(-99, GetValue(reopened->ReadPropertyList("b")));
+  }
+
+  void PersistenceService_SaveAndLoadJournal()
+  {
+    mitk::PersistenceService::LoadModule();
+    PERSISTENCE_GET_SERVICE_MACRO
+    CPPUNIT_ASSERT(persistenceService != nullptr);
+
+    std::string id = "PropertyListsJournalTest";
+    persistenceService->GetPropertyList(id)->SetIntProperty("value", 1);
+    CPPUNIT_ASSERT(persistenceService->Save(m_FileName));
+
+    // only the changed list is appended
+    mitk::PropertyListsJournal::Pointer journal = mitk::PropertyListsJournal::New();
+    CPPUNIT_ASSERT(journal->Open(m_FileName));
+    const std::streamoff sizeAfterFirstSave = journal->GetCommittedSize();
+    CPPUNIT_ASSERT(persistenceService->Save(m_FileName));
+    CPPUNIT_ASSERT(journal->Open(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(sizeAfterFirstSave, journal->GetCommittedSize());
+
+    persistenceService->GetPropertyList(id)->SetIntProperty("value", 2);
+    CPPUNIT_ASSERT(persistenceService->Save(m_FileName));
+    CPPUNIT_ASSERT(persistenceService->RemovePropertyList(id));
+
+    bool existed = false;
+    CPPUNIT_ASSERT(persistenceService->Load(m_FileName));
+    CPPUNIT_ASSERT_EQUAL(2, GetValue(persistenceService->GetPropertyList(id, &existed)));
+    CPPUNIT_ASSERT(existed);
+
+    CPPUNIT_ASSERT(persistenceService->RemovePropertyList(id));
+  }
+};
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyListsJournal)
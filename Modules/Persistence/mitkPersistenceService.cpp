@@ -37,6 +37,8 @@ void mitk::PersistenceService::Clear()
   this->Initialize();
   m_PropertyLists.clear();
   m_FileNamesToModifiedTimes.clear();
+  m_JournalFiles.clear();
+  m_PendingPropertyLists.clear();
 }
 
 mitk::PersistenceService::~PersistenceService()
@@ -47,7 +49,7 @@ mitk::PersistenceService::~PersistenceService()
 std::string mitk::PersistenceService::GetDefaultPersistenceFile()
 {
   this->Initialize();
-  std::string file = "PersistentData.xml";
+  std::string file = "PersistentData" + PropertyListsJournal::GetFileExtension();
   us::ModuleContext *context = us::GetModuleContext();
   std::string contextDataFile = context->GetDataFile(file);
 
@@ -69,6 +71,8 @@ mitk::PropertyList::Pointer mitk::PersistenceService::GetPropertyList(std::strin
     id = uidGen.GetUID();
   }
 
+  this->LoadPendingPropertyList(id);
+
   auto it = m_PropertyLists.find(id);
   if (it == m_PropertyLists.end())
   {
@@ -119,6 +123,11 @@ bool mitk::PersistenceService::Save(const std::string &fileName, bool appendChan
     }
   }
 
+  if (IsJournalFile(theFile))
+    return this->SaveJournal(theFile, appendChanges);
+
+  this->LoadPendingPropertyLists();
+
   bool createFile = !itksys::SystemTools::FileExists(theFile.c_str());
   if (!itksys::SystemTools::Touch(theFile.c_str(), createFile))
   {
@@ -201,6 +210,11 @@ bool mitk::PersistenceService::Load(const std::string &fileName, bool enforceRel
   if (!itksys::SystemTools::FileExists(theFile.c_str()))
     return false;
 
+  if (IsJournalFile(theFile))
+    return this->LoadJournal(theFile, enforceReload);
+
+  this->LoadPendingPropertyLists();
+
   bool xmlFile = false;
   if (itksys::SystemTools::GetFilenameLastExtension(theFile.c_str()) == ".xml")
     xmlFile = true;
@@ -294,6 +308,7 @@ std::string mitk::PersistenceService::GetPersistenceNodePropertyName()
 mitk::DataStorage::SetOfObjects::Pointer mitk::PersistenceService::GetDataNodes(mitk::DataStorage *ds)
 {
   this->Initialize();
+  this->LoadPendingPropertyLists();
   DataStorage::SetOfObjects::Pointer set = DataStorage::SetOfObjects::New();
 
   std::map<std::string, mitk::PropertyList::Pointer>::const_iterator it = m_PropertyLists.begin();
@@ -334,36 +349,7 @@ bool mitk::PersistenceService::RestorePropertyListsFromPersistentDataNodes(const
     {
       oneFound = true;
       MITK_DEBUG("mitk::PersistenceService") << "isPersistenceNode was true";
-      std::string name = node->GetName();
-
-      bool existed = false;
-      mitk::PropertyList::Pointer propList = this->GetPropertyList(name, &existed);
-
-      if (existed)
-      {
-        MITK_DEBUG("mitk::PersistenceService") << "calling replace observer before replacing values";
-        auto it = m_PropertyListReplacedObserver.begin();
-        while (it != m_PropertyListReplacedObserver.end())
-        {
-          (*it)->BeforePropertyListReplaced(name, propList);
-          ++it;
-        }
-      } // if( existed )
-
-      MITK_DEBUG("mitk::PersistenceService") << "replacing values";
-
-      this->ClonePropertyList(node->GetPropertyList(), propList);
-
-      if (existed)
-      {
-        MITK_DEBUG("mitk::PersistenceService") << "calling replace observer before replacing values";
-        auto it = m_PropertyListReplacedObserver.begin();
-        while (it != m_PropertyListReplacedObserver.end())
-        {
-          (*it)->AfterPropertyListReplaced(name, propList);
-          ++it;
-        }
-      } // if( existed )
+      this->ReplacePropertyList(node->GetName(), node->GetPropertyList());
     }   // if( isPersistenceNode )
   }     // for ( mitk::DataStorage::SetOfObjects::const_iterator sourceIter = allNodes->begin(); ...
 
@@ -379,13 +365,188 @@ bool mitk::PersistenceService::GetAutoLoadAndSave()
 bool mitk::PersistenceService::RemovePropertyList(std::string &id)
 {
   this->Initialize();
+  bool removed = m_PendingPropertyLists.erase(id) > 0;
   auto it = m_PropertyLists.find(id);
   if (it != m_PropertyLists.end())
   {
     m_PropertyLists.erase(it);
-    return true;
+    removed = true;
   }
-  return false;
+  return removed;
+}
+
+bool mitk::PersistenceService::IsJournalFile(const std::string &fileName)
+{
+  return itksys::SystemTools::GetFilenameLastExtension(fileName) == PropertyListsJournal::GetFileExtension();
+}
+
+void mitk::PersistenceService::ReplacePropertyList(const std::string &id, mitk::PropertyList *source)
+{
+  // a list that was not read from its journal yet has no users to inform
+  m_PendingPropertyLists.erase(id);
+
+  std::string name = id;
+  bool existed = false;
+  mitk::PropertyList::Pointer propList = this->GetPropertyList(name, &existed);
+
+  if (existed)
+  {
+    MITK_DEBUG("mitk::PersistenceService") << "calling replace observer before replacing values";
+    auto it = m_PropertyListReplacedObserver.begin();
+    while (it != m_PropertyListReplacedObserver.end())
+    {
+      (*it)->BeforePropertyListReplaced(name, propList);
+      ++it;
+    }
+  } // if( existed )
+
+  MITK_DEBUG("mitk::PersistenceService") << "replacing values";
+
+  this->ClonePropertyList(source, propList);
+
+  if (existed)
+  {
+    MITK_DEBUG("mitk::PersistenceService") << "calling replace observer before replacing values";
+    auto it = m_PropertyListReplacedObserver.begin();
+    while (it != m_PropertyListReplacedObserver.end())
+    {
+      (*it)->AfterPropertyListReplaced(name, propList);
+      ++it;
+    }
+  } // if( existed )
+}
+
+bool mitk::PersistenceService::SaveJournal(const std::string &fileName, bool appendChanges)
+{
+  JournalFile &journalFile = m_JournalFiles[fileName];
+  if (journalFile.Journal.IsNull())
+  {
+    journalFile.Journal = PropertyListsJournal::New();
+    if (!journalFile.Journal->Open(fileName))
+    {
+      m_JournalFiles.erase(fileName);
+      return false;
+    }
+  }
+  PropertyListsJournal *journal = journalFile.Journal;
+
+  // lists that were not read yet are unchanged, so only the ones of other journals have to be written
+  this->LoadPendingPropertyLists(fileName);
+
+  std::map<std::string, mitk::PropertyList::Pointer> changedPropertyLists;
+  for (const auto &propertyList : m_PropertyLists)
+  {
+    auto synchronized = journalFile.SynchronizedModifiedTimes.find(propertyList.first);
+    if (!journal->Contains(propertyList.first) || synchronized == journalFile.SynchronizedModifiedTimes.end() ||
+        propertyList.second->GetMTime() > synchronized->second)
+    {
+      changedPropertyLists.insert(propertyList);
+    }
+  }
+
+  std::vector<std::string> removedIds;
+  if (!appendChanges)
+  {
+    for (const auto &id : journal->GetPropertyListIds())
+    {
+      if (m_PropertyLists.find(id) == m_PropertyLists.end() &&
+          m_PendingPropertyLists.find(id) == m_PendingPropertyLists.end())
+        removedIds.push_back(id);
+    }
+  }
+
+  if (!journal->Commit(changedPropertyLists, removedIds))
+  {
+    MITK_ERROR("PersistenceService") << "Could not write to " << fileName;
+    return false;
+  }
+
+  for (const auto &propertyList : changedPropertyLists)
+    journalFile.SynchronizedModifiedTimes[propertyList.first] = propertyList.second->GetMTime();
+  for (const auto &id : removedIds)
+    journalFile.SynchronizedModifiedTimes.erase(id);
+
+  return true;
+}
+
+bool mitk::PersistenceService::LoadJournal(const std::string &fileName, bool enforceReload)
+{
+  JournalFile &journalFile = m_JournalFiles[fileName];
+  std::vector<std::string> changedIds;
+  if (journalFile.Journal.IsNull())
+  {
+    journalFile.Journal = PropertyListsJournal::New();
+    if (!journalFile.Journal->Open(fileName))
+    {
+      m_JournalFiles.erase(fileName);
+      return false;
+    }
+    enforceReload = true;
+  }
+  else if (!journalFile.Journal->Refresh(changedIds))
+  {
+    return false;
+  }
+  PropertyListsJournal *journal = journalFile.Journal;
+
+  // only transactions that were appended since the last read are applied, unless a reload is enforced
+  if (enforceReload)
+    changedIds = journal->GetPropertyListIds();
+
+  bool load = true;
+  for (const auto &id : changedIds)
+  {
+    if (!journal->Contains(id))
+      continue;
+
+    if (m_PropertyLists.find(id) == m_PropertyLists.end())
+    {
+      m_PendingPropertyLists[id] = fileName;
+      continue;
+    }
+
+    mitk::PropertyList::Pointer propertyList = journal->ReadPropertyList(id);
+    if (propertyList.IsNull())
+    {
+      load = false;
+      continue;
+    }
+
+    this->ReplacePropertyList(id, propertyList);
+    journalFile.SynchronizedModifiedTimes[id] = m_PropertyLists[id]->GetMTime();
+  }
+
+  return load;
+}
+
+void mitk::PersistenceService::LoadPendingPropertyList(const std::string &id)
+{
+  auto pending = m_PendingPropertyLists.find(id);
+  if (pending == m_PendingPropertyLists.end())
+    return;
+
+  JournalFile &journalFile = m_JournalFiles[pending->second];
+  m_PendingPropertyLists.erase(pending);
+
+  mitk::PropertyList::Pointer propertyList = journalFile.Journal->ReadPropertyList(id);
+  if (propertyList.IsNull())
+    return;
+
+  m_PropertyLists[id] = propertyList;
+  journalFile.SynchronizedModifiedTimes[id] = propertyList->GetMTime();
+}
+
+void mitk::PersistenceService::LoadPendingPropertyLists(const std::string &exceptFromFileName)
+{
+  std::vector<std::string> ids;
+  for (const auto &pending : m_PendingPropertyLists)
+  {
+    if (pending.second != exceptFromFileName)
+      ids.push_back(pending.first);
+  }
+
+  for (const auto &id : ids)
+    this->LoadPendingPropertyList(id);
 }
 
 void mitk::PersistenceService::Initialize()
@@ -396,8 +557,15 @@ void mitk::PersistenceService::Initialize()
 
   m_PropertyListsXmlFileReaderAndWriter = PropertyListsXmlFileReaderAndWriter::New();
 
-  // Load Default File in any case
-  this->Load();
+  // Load Default File in any case, the PropertyLists of former versions are taken over from the xml file
+  std::string defaultFile = this->GetDefaultPersistenceFile();
+  std::string legacyFile = itksys::SystemTools::GetFilenamePath(defaultFile);
+  legacyFile += (legacyFile.empty() ? "" : "/") + itksys::SystemTools::GetFilenameWithoutLastExtension(defaultFile);
+  legacyFile += ".xml";
+  if (!itksys::SystemTools::FileExists(defaultFile.c_str()) && itksys::SystemTools::FileExists(legacyFile.c_str()))
+    this->Load(legacyFile);
+  else
+    this->Load();
   // std::string id = mitk::PersistenceService::PERSISTENCE_PROPERTYLIST_NAME; //see bug 17729
   std::string id = GetPersistencePropertyListName();
   mitk::PropertyList::Pointer propList = this->GetPropertyList(id);
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define mitkPersistenceService_h
 
 #include "mitkIPersistenceService.h"
+#include "mitkPropertyListsJournal.h"
 #include "mitkPropertyListsXmlFileReaderAndWriter.h"
 #include "mitkSceneIO.h"
 #include <MitkPersistenceExports.h>
@@ -22,6 +23,11 @@ namespace mitk
 {
   ///
   /// implementation of the IPersistenceService
+  ///
+  /// Files with the extension PropertyListsJournal::GetFileExtension() are journals: Save() only appends the
+  /// PropertyLists that were changed or removed since they were written the last time and Load() only reads the
+  /// PropertyLists that are already in use. All other PropertyLists of a journal are read on demand in
+  /// GetPropertyList(). The default persistence file is a journal.
   /// \see IPersistenceService
   class MITKPERSISTENCE_EXPORT PersistenceService : public itk::LightObject, public mitk::IPersistenceService
   {
@@ -66,7 +72,21 @@ namespace mitk
     void Unitialize();
 
   private:
+    struct JournalFile
+    {
+      PropertyListsJournal::Pointer Journal;
+      /// modified times of the PropertyLists when they were written to or read from the journal
+      std::map<std::string, unsigned long> SynchronizedModifiedTimes;
+    };
+
+    static bool IsJournalFile(const std::string &fileName);
+
     void ClonePropertyList(mitk::PropertyList *from, mitk::PropertyList *to) const;
+    void ReplacePropertyList(const std::string &id, mitk::PropertyList *source);
+    bool SaveJournal(const std::string &fileName, bool appendChanges);
+    bool LoadJournal(const std::string &fileName, bool enforceReload);
+    void LoadPendingPropertyList(const std::string &id);
+    void LoadPendingPropertyLists(const std::string &exceptFromFileName = "");
     void Initialize();
     std::map<std::string, mitk::PropertyList::Pointer> m_PropertyLists;
     bool m_AutoLoadAndSave;
@@ -74,6 +94,9 @@ namespace mitk
     SceneIO::Pointer m_SceneIO;
     PropertyListsXmlFileReaderAndWriter::Pointer m_PropertyListsXmlFileReaderAndWriter;
     std::map<std::string, long int> m_FileNamesToModifiedTimes;
+    std::map<std::string, JournalFile> m_JournalFiles;
+    /// ids of the PropertyLists that are stored in a journal, but were not read yet, and the file name of the journal
+    std::map<std::string, std::string> m_PendingPropertyLists;
     bool m_Initialized;
     bool m_InInitialized;
   };
@@ -0,0 +1,645 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyListsJournal.h"
+#include "mitkBasePropertySerializer.h"
+
+#include <itksys/SystemTools.hxx>
+#include <tinyxml.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  const char *const JournalSignature = "MITKPropertyListsJournal";
+  const int JournalVersion = 1;
+
+  // small journals are not worth rewriting
+  const std::streamoff MinimumCompactionSize = 64 * 1024;
+
+  const char PutRecord = 'P';
+  const char RemoveRecord = 'R';
+  const char CommitRecord = 'C';
+
+  // flushing a stream only hands the data to the operating system, a power loss may still lose it
+  bool SyncFile(const std::string &fileName)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    const bool synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return synced;
+#else
+    const int file = open(fileName.c_str(), O_WRONLY);
+    if (file < 0)
+      return false;
+    const bool synced = fsync(file) == 0;
+    close(file);
+    return synced;
+#endif
+  }
+
+  // makes a rename durable, on Windows the rename is not part of the directory data that can be flushed
+  bool SyncDirectoryOf(const std::string &fileName)
+  {
+#ifdef _WIN32
+    (void)fileName;
+    return true;
+#else
+    std::string directory = itksys::SystemTools::GetFilenamePath(fileName);
+    if (directory.empty())
+      directory = ".";
+    const int file = open(directory.c_str(), O_RDONLY);
+    if (file < 0)
+      return false;
+    const bool synced = fsync(file) == 0;
+    close(file);
+    return synced;
+#endif
+  }
+
+  struct Record
+  {
+    char Type;
+    unsigned long long Transaction;
+    std::string Id;
+    std::string Payload;
+    std::streamoff PayloadOffset;
+    std::size_t PayloadLength;
+    std::streamoff Length;
+  };
+
+  // FNV-1a, only used to detect records that were not completely written
+  std::uint64_t ComputeChecksum(char type, unsigned long long transaction, const std::string &id,
+                                const std::string &payload)
+  {
+    std::uint64_t checksum = 14695981039346656037ULL;
+    auto update = [&checksum](const std::string &data) {
+      for (unsigned char c : data)
+      {
+        checksum ^= c;
+        checksum *= 1099511628211ULL;
+      }
+    };
+    update(std::string(1, type) + std::to_string(transaction));
+    update(id);
+    update(payload);
+    return checksum;
+  }
+
+  std::string FormatFileHeader(unsigned long generation)
+  {
+    std::ostringstream header;
+    header << JournalSignature << ' ' << JournalVersion << ' ' << generation << '\n';
+    return header.str();
+  }
+
+  /// \return the record, the payload starts at record.size() - payload.size() - 1
+  std::string FormatRecord(char type, unsigned long long transaction, const std::string &id,
+                           const std::string &payload)
+  {
+    std::ostringstream record;
+    record << type << ' ' << transaction << ' ' << id.size() << ' ' << payload.size() << ' ' << std::hex
+           << ComputeChecksum(type, transaction, id, payload) << '\n'
+           << id << payload << '\n';
+    return record.str();
+  }
+
+  bool ReadFileHeader(std::istream &stream, unsigned long &generation)
+  {
+    std::string line;
+    if (!std::getline(stream, line) || stream.eof())
+      return false;
+
+    std::istringstream fields(line);
+    std::string signature;
+    int version = 0;
+    return (fields >> signature >> version >> generation) && signature == JournalSignature &&
+           version == JournalVersion;
+  }
+
+  /// \return false if there is no complete and intact record at the current position of the stream
+  bool ReadRecord(std::istream &stream, std::streamoff fileSize, Record &record)
+  {
+    const std::streamoff begin = stream.tellg();
+
+    std::string line;
+    if (!std::getline(stream, line) || stream.eof())
+      return false;
+
+    std::istringstream fields(line);
+    unsigned long long idLength = 0;
+    unsigned long long payloadLength = 0;
+    std::uint64_t checksum = 0;
+    if (!(fields >> record.Type >> record.Transaction >> idLength >> payloadLength >> std::hex >> checksum))
+      return false;
+
+    const std::streamoff dataBegin = stream.tellg();
+    if (idLength + payloadLength >= static_cast<unsigned long long>(fileSize - dataBegin))
+      return false;
+
+    record.Id.resize(idLength);
+    record.Payload.resize(payloadLength);
+    stream.read(&record.Id[0], idLength);
+    stream.read(&record.Payload[0], payloadLength);
+
+    char terminator = 0;
+    if (!stream.get(terminator) || terminator != '\n')
+      return false;
+
+    if (checksum != ComputeChecksum(record.Type, record.Transaction, record.Id, record.Payload))
+      return false;
+
+    record.PayloadOffset = dataBegin + static_cast<std::streamoff>(idLength);
+    record.PayloadLength = record.Payload.size();
+    record.Length = static_cast<std::streamoff>(stream.tellg()) - begin;
+    return true;
+  }
+
+  TiXmlElement *SerializeProperty(const std::string &key, const mitk::BaseProperty *property)
+  {
+    const std::string serializerName = std::string(property->GetNameOfClass()) + "Serializer";
+    std::list<itk::LightObject::Pointer> serializers =
+      itk::ObjectFactoryBase::CreateAllInstance(serializerName.c_str());
+
+    for (const auto &object : serializers)
+    {
+      auto *serializer = dynamic_cast<mitk::BasePropertySerializer *>(object.GetPointer());
+      if (nullptr == serializer)
+        continue;
+
+      serializer->SetProperty(property);
+      TiXmlElement *valueElement = nullptr;
+      try
+      {
+        valueElement = serializer->Serialize();
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR("PropertyListsJournal") << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
+      }
+
+      if (nullptr == valueElement)
+        return nullptr;
+
+      auto keyElement = new TiXmlElement("property");
+      keyElement->SetAttribute("key", key);
+      keyElement->SetAttribute("type", property->GetNameOfClass());
+      keyElement->LinkEndChild(valueElement);
+      return keyElement;
+    }
+
+    return nullptr;
+  }
+
+  std::string SerializePropertyList(const std::string &id, const mitk::PropertyList *propertyList)
+  {
+    TiXmlElement propertyListElement("PropertyList");
+    for (const auto &property : *propertyList->GetMap())
+    {
+      TiXmlElement *propertyElement = SerializeProperty(property.first, property.second);
+      if (nullptr != propertyElement)
+      {
+        propertyListElement.LinkEndChild(propertyElement);
+      }
+      else
+      {
+        MITK_WARN("PropertyListsJournal") << "Property " << property.first << " of type "
+                                          << property.second->GetNameOfClass() << " in PropertyList " << id
+                                          << " cannot be serialized and is skipped";
+      }
+    }
+
+    TiXmlPrinter printer;
+    printer.SetStreamPrinting();
+    propertyListElement.Accept(&printer);
+    return printer.Str();
+  }
+
+  mitk::PropertyList::Pointer DeserializePropertyList(const std::string &id, const std::string &payload)
+  {
+    TiXmlDocument document;
+    document.Parse(payload.c_str());
+    TiXmlElement *propertyListElement = document.FirstChildElement("PropertyList");
+    if (document.Error() || nullptr == propertyListElement)
+    {
+      MITK_ERROR("PropertyListsJournal") << "Cannot parse PropertyList " << id << ": " << document.ErrorDesc();
+      return nullptr;
+    }
+
+    mitk::PropertyList::Pointer propertyList = mitk::PropertyList::New();
+    for (TiXmlElement *propertyElement = propertyListElement->FirstChildElement("property");
+         propertyElement != nullptr;
+         propertyElement = propertyElement->NextSiblingElement("property"))
+    {
+      const char *key = propertyElement->Attribute("key");
+      const char *type = propertyElement->Attribute("type");
+      if (nullptr == key || nullptr == type)
+        continue;
+
+      const std::string serializerName = std::string(type) + "Serializer";
+      std::list<itk::LightObject::Pointer> readers = itk::ObjectFactoryBase::CreateAllInstance(serializerName.c_str());
+
+      mitk::BaseProperty::Pointer property;
+      for (const auto &object : readers)
+      {
+        if (auto *reader = dynamic_cast<mitk::BasePropertySerializer *>(object.GetPointer()))
+        {
+          property = reader->Deserialize(propertyElement->FirstChildElement());
+          break;
+        }
+      }
+
+      if (property.IsNull())
+      {
+        MITK_ERROR("PropertyListsJournal") << "Cannot read property " << key << " of type " << type
+                                           << " in PropertyList " << id << ". Your data may be corrupted";
+        continue;
+      }
+      propertyList->SetProperty(key, property);
+    }
+
+    return propertyList;
+  }
+
+  std::streamoff GetFileSize(std::istream &stream)
+  {
+    stream.seekg(0, std::ios::end);
+    const std::streamoff fileSize = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+    return fileSize;
+  }
+
+  /// empty files, e.g. new temporary files, are treated like missing files
+  bool IsMissingOrEmpty(const std::string &fileName)
+  {
+    if (!itksys::SystemTools::FileExists(fileName.c_str(), true))
+      return true;
+
+    std::ifstream stream(fileName.c_str(), std::ios::binary);
+    return GetFileSize(stream) <= 0;
+  }
+}
+
+std::string mitk::PropertyListsJournal::GetFileExtension()
+{
+  return ".journal";
+}
+
+mitk::PropertyListsJournal::PropertyListsJournal() : m_CompactionThreshold(0.5)
+{
+  this->Reset();
+}
+
+mitk::PropertyListsJournal::~PropertyListsJournal()
+{
+}
+
+void mitk::PropertyListsJournal::Reset()
+{
+  m_Index.clear();
+  m_Generation = 0;
+  m_LastTransaction = 0;
+  m_HeaderSize = 0;
+  m_CommittedSize = 0;
+  m_LiveSize = 0;
+  m_HasIncompleteTail = false;
+}
+
+bool mitk::PropertyListsJournal::Open(const std::string &fileName)
+{
+  this->Reset();
+  m_FileName = fileName;
+
+  if (IsMissingOrEmpty(m_FileName))
+    return true;
+
+  std::vector<std::string> changedIds;
+  return this->ReadTransactions(0, changedIds);
+}
+
+bool mitk::PropertyListsJournal::Refresh(std::vector<std::string> &changedIds)
+{
+  changedIds.clear();
+  if (m_FileName.empty())
+    return false;
+
+  std::vector<std::string> knownIds = this->GetPropertyListIds();
+  if (IsMissingOrEmpty(m_FileName))
+  {
+    this->Reset();
+    changedIds = knownIds;
+    return true;
+  }
+
+  std::ifstream stream(m_FileName.c_str(), std::ios::binary);
+  const std::streamoff fileSize = GetFileSize(stream);
+  unsigned long generation = 0;
+  if (!ReadFileHeader(stream, generation))
+  {
+    MITK_ERROR("PropertyListsJournal") << m_FileName << " is not a PropertyLists journal";
+    return false;
+  }
+
+  if (m_HeaderSize > 0 && generation == m_Generation && fileSize >= m_CommittedSize)
+  {
+    return fileSize == m_CommittedSize || this->ReadTransactions(m_CommittedSize, changedIds);
+  }
+
+  // the file was compacted or replaced since it was read
+  this->Reset();
+  if (!this->ReadTransactions(0, changedIds))
+    return false;
+
+  changedIds.insert(changedIds.end(), knownIds.begin(), knownIds.end());
+  std::sort(changedIds.begin(), changedIds.end());
+  changedIds.erase(std::unique(changedIds.begin(), changedIds.end()), changedIds.end());
+  return true;
+}
+
+bool mitk::PropertyListsJournal::ReadTransactions(std::streamoff begin, std::vector<std::string> &changedIds)
+{
+  std::ifstream stream(m_FileName.c_str(), std::ios::binary);
+  if (!stream)
+  {
+    MITK_ERROR("PropertyListsJournal") << "Cannot read " << m_FileName;
+    return false;
+  }
+
+  const std::streamoff fileSize = GetFileSize(stream);
+  if (begin == 0)
+  {
+    if (!ReadFileHeader(stream, m_Generation))
+    {
+      MITK_ERROR("PropertyListsJournal") << m_FileName << " is not a PropertyLists journal";
+      return false;
+    }
+    m_HeaderSize = stream.tellg();
+    m_CommittedSize = m_HeaderSize;
+  }
+  else
+  {
+    stream.seekg(begin);
+  }
+
+  // records are only applied to the index once the commit record of their transaction was read
+  std::vector<Record> transaction;
+  Record record;
+  while (static_cast<std::streamoff>(stream.tellg()) < fileSize && ReadRecord(stream, fileSize, record))
+  {
+    record.Payload.clear();
+
+    if (record.Type == PutRecord || record.Type == RemoveRecord)
+    {
+      transaction.push_back(record);
+      continue;
+    }
+
+    if (record.Type != CommitRecord)
+      break;
+
+    const auto foreignRecord = std::find_if(transaction.begin(), transaction.end(), [&record](const Record &r) {
+      return r.Transaction != record.Transaction;
+    });
+    if (foreignRecord != transaction.end())
+      break;
+
+    for (const auto &change : transaction)
+    {
+      auto entry = m_Index.find(change.Id);
+      if (entry != m_Index.end())
+      {
+        m_LiveSize -= entry->second.RecordLength;
+        m_Index.erase(entry);
+      }
+
+      if (change.Type == PutRecord)
+      {
+        m_Index[change.Id] = {change.PayloadOffset, change.PayloadLength, change.Length};
+        m_LiveSize += change.Length;
+      }
+      changedIds.push_back(change.Id);
+    }
+
+    transaction.clear();
+    m_LastTransaction = record.Transaction;
+    m_CommittedSize = stream.tellg();
+  }
+
+  m_HasIncompleteTail = m_CommittedSize < fileSize;
+  if (m_HasIncompleteTail)
+  {
+    MITK_WARN("PropertyListsJournal") << "Ignoring " << (fileSize - m_CommittedSize)
+                                      << " bytes of incompletely written transactions in " << m_FileName;
+  }
+
+  std::sort(changedIds.begin(), changedIds.end());
+  changedIds.erase(std::unique(changedIds.begin(), changedIds.end()), changedIds.end());
+  return true;
+}
+
+std::string mitk::PropertyListsJournal::GetFileName() const
+{
+  return m_FileName;
+}
+
+bool mitk::PropertyListsJournal::Contains(const std::string &id) const
+{
+  return m_Index.find(id) != m_Index.end();
+}
+
+std::vector<std::string> mitk::PropertyListsJournal::GetPropertyListIds() const
+{
+  std::vector<std::string> ids;
+  ids.reserve(m_Index.size());
+  for (const auto &entry : m_Index)
+    ids.push_back(entry.first);
+  return ids;
+}
+
+mitk::PropertyList::Pointer mitk::PropertyListsJournal::ReadPropertyList(const std::string &id) const
+{
+  auto entry = m_Index.find(id);
+  if (entry == m_Index.end())
+    return nullptr;
+
+  std::ifstream stream(m_FileName.c_str(), std::ios::binary);
+  std::string payload(entry->second.PayloadLength, '\0');
+  stream.seekg(entry->second.PayloadOffset);
+  stream.read(&payload[0], payload.size());
+  if (!stream)
+  {
+    MITK_ERROR("PropertyListsJournal") << "Cannot read PropertyList " << id << " from " << m_FileName;
+    return nullptr;
+  }
+
+  return DeserializePropertyList(id, payload);
+}
+
+bool mitk::PropertyListsJournal::Commit(const std::map<std::string, mitk::PropertyList::Pointer> &changedPropertyLists,
+                                        const std::vector<std::string> &removedIds)
+{
+  // append behind the transactions of other writers, but never behind an incomplete transaction
+  std::vector<std::string> changedIds;
+  if (!this->Refresh(changedIds))
+    return false;
+  if (m_HasIncompleteTail && !this->Compact())
+    return false;
+
+  if (changedPropertyLists.empty() && removedIds.empty())
+    return true;
+
+  if (m_HeaderSize == 0)
+  {
+    std::ofstream stream(m_FileName.c_str(), std::ios::binary | std::ios::trunc);
+    const std::string header = FormatFileHeader(m_Generation);
+    stream << header;
+    stream.close();
+    if (!stream || !SyncFile(m_FileName) || !SyncDirectoryOf(m_FileName))
+    {
+      MITK_ERROR("PropertyListsJournal") << "Cannot create " << m_FileName;
+      return false;
+    }
+    m_HeaderSize = static_cast<std::streamoff>(header.size());
+    m_CommittedSize = m_HeaderSize;
+  }
+
+  // the whole transaction is written at once, an interrupted write leaves it without commit record
+  const unsigned long long transaction = m_LastTransaction + 1;
+  std::string data;
+  std::map<std::string, IndexEntry> newEntries;
+  for (const auto &propertyList : changedPropertyLists)
+  {
+    const std::string payload = SerializePropertyList(propertyList.first, propertyList.second);
+    const std::string record = FormatRecord(PutRecord, transaction, propertyList.first, payload);
+    const auto recordOffset = m_CommittedSize + static_cast<std::streamoff>(data.size());
+    const auto payloadOffset = recordOffset + static_cast<std::streamoff>(record.size() - payload.size() - 1);
+    newEntries[propertyList.first] = {payloadOffset, payload.size(), static_cast<std::streamoff>(record.size())};
+    data += record;
+  }
+
+  std::vector<std::string> removedEntries;
+  for (const auto &id : removedIds)
+  {
+    if (!this->Contains(id) || newEntries.find(id) != newEntries.end())
+      continue;
+    data += FormatRecord(RemoveRecord, transaction, id, "");
+    removedEntries.push_back(id);
+  }
+  data += FormatRecord(CommitRecord, transaction, "", "");
+
+  std::ofstream stream(m_FileName.c_str(), std::ios::binary | std::ios::app);
+  stream.write(data.data(), data.size());
+  stream.close();
+  if (!stream || !SyncFile(m_FileName))
+  {
+    MITK_ERROR("PropertyListsJournal") << "Cannot write to " << m_FileName;
+    m_HasIncompleteTail = true;
+    return false;
+  }
+
+  for (const auto &id : removedEntries)
+  {
+    m_LiveSize -= m_Index[id].RecordLength;
+    m_Index.erase(id);
+  }
+  for (const auto &entry : newEntries)
+  {
+    auto oldEntry = m_Index.find(entry.first);
+    if (oldEntry != m_Index.end())
+      m_LiveSize -= oldEntry->second.RecordLength;
+    m_Index[entry.first] = entry.second;
+    m_LiveSize += entry.second.RecordLength;
+  }
+  m_LastTransaction = transaction;
+  m_CommittedSize += static_cast<std::streamoff>(data.size());
+
+  const std::streamoff supersededSize = this->GetSupersededSize();
+  if (supersededSize > MinimumCompactionSize && supersededSize > m_CompactionThreshold * m_CommittedSize)
+  {
+    // the transaction is committed already, a failing compaction only costs disk space
+    this->Compact();
+  }
+
+  return true;
+}
+
+bool mitk::PropertyListsJournal::Compact()
+{
+  if (m_FileName.empty())
+    return false;
+  if (IsMissingOrEmpty(m_FileName))
+    return m_Index.empty();
+
+  const std::string temporaryFileName = m_FileName + ".tmp";
+  {
+    std::ifstream input(m_FileName.c_str(), std::ios::binary);
+    std::ofstream output(temporaryFileName.c_str(), std::ios::binary | std::ios::trunc);
+    output << FormatFileHeader(m_Generation + 1);
+
+    const unsigned long long transaction = 1;
+    std::string payload;
+    for (const auto &entry : m_Index)
+    {
+      payload.resize(entry.second.PayloadLength);
+      input.seekg(entry.second.PayloadOffset);
+      input.read(&payload[0], payload.size());
+      output << FormatRecord(PutRecord, transaction, entry.first, payload);
+    }
+    output << FormatRecord(CommitRecord, transaction, "", "");
+    output.close();
+
+    // the compacted journal must be on disk before it replaces the original one
+    if (!input || !output || !SyncFile(temporaryFileName))
+    {
+      MITK_ERROR("PropertyListsJournal") << "Cannot compact " << m_FileName;
+      itksys::SystemTools::RemoveFile(temporaryFileName.c_str());
+      return false;
+    }
+  }
+
+  // renaming replaces the journal atomically, readers see either the old or the new file
+  if (!itksys::SystemTools::RenameFile(temporaryFileName.c_str(), m_FileName.c_str()))
+  {
+    MITK_ERROR("PropertyListsJournal") << "Cannot replace " << m_FileName << " by the compacted journal";
+    itksys::SystemTools::RemoveFile(temporaryFileName.c_str());
+    return false;
+  }
+
+  if (!SyncDirectoryOf(m_FileName))
+    MITK_WARN("PropertyListsJournal") << "Cannot flush the directory of " << m_FileName;
+
+  return this->Open(m_FileName);
+}
+
+std::streamoff mitk::PropertyListsJournal::GetCommittedSize() const
+{
+  return m_CommittedSize;
+}
+
+std::streamoff mitk::PropertyListsJournal::GetSupersededSize() const
+{
+  return m_CommittedSize - m_HeaderSize - m_LiveSize;
+}
@@ -0,0 +1,129 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyListsJournal_h
+#define mitkPropertyListsJournal_h
+
+#include "mitkPropertyList.h"
+#include <MitkPersistenceExports.h>
+
+#include <ios>
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  ///
+  /// An append-only file of PropertyLists.
+  ///
+  /// Every Commit() appends one transaction: a record per changed or removed PropertyList, followed by a commit
+  /// record. Records carry their length and a checksum, so a transaction that was not completely written (e.g. due
+  /// to a crash) is detected and ignored when the file is read again. Saving a small change therefore costs time
+  /// proportional to the size of the change and not to the size of all PropertyLists.
+  ///
+  /// Reading the file only builds an index from PropertyList ids to the position of their most recent record.
+  /// A PropertyList is deserialized when it is requested with ReadPropertyList().
+  ///
+  /// Superseded records are removed by Compact(), which rewrites the file into a temporary file and renames it over
+  /// the original one. Commit() compacts automatically as soon as the superseded records take up more than
+  /// CompactionThreshold of the file and more than 64 KiB.
+  ///
+  /// Commit() and Compact() flush the written data to the disk before they return. There is no file lock: any
+  /// number of PropertyListsJournals may read the same file, but only one of them may write to it at a time.
+  ///
+  /// Properties are serialized with the BasePropertySerializer classes that are also used for scene files.
+  ///
+  class MITKPERSISTENCE_EXPORT PropertyListsJournal : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(PropertyListsJournal, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    static std::string GetFileExtension();
+
+    /// Fraction of superseded records in the file [0, 1] at which Commit() compacts the file, default 0.5
+    itkSetClampMacro(CompactionThreshold, double, 0.0, 1.0);
+    itkGetConstMacro(CompactionThreshold, double);
+
+    ///
+    /// Reads the index of the journal file. A file that does not exist is treated as an empty journal.
+    /// \return false if the file exists but is not a journal
+    ///
+    bool Open(const std::string &fileName);
+
+    ///
+    /// Reads the transactions that were appended to the file since it was read the last time, e.g. by another
+    /// PropertyListsJournal. If the file was compacted in the meantime, the whole index is read again.
+    /// \param changedIds ids of the PropertyLists which were changed or removed in the file
+    /// \return false if the file cannot be read
+    ///
+    bool Refresh(std::vector<std::string> &changedIds);
+
+    std::string GetFileName() const;
+
+    bool Contains(const std::string &id) const;
+
+    std::vector<std::string> GetPropertyListIds() const;
+
+    ///
+    /// Deserializes the most recently committed version of the PropertyList with the given id
+    /// \return nullptr if there is no such PropertyList or it cannot be read
+    ///
+    mitk::PropertyList::Pointer ReadPropertyList(const std::string &id) const;
+
+    ///
+    /// Appends one transaction that replaces the given PropertyLists and removes the PropertyLists with the given ids.
+    /// \return false if the transaction could not be written
+    ///
+    bool Commit(const std::map<std::string, mitk::PropertyList::Pointer> &changedPropertyLists,
+                const std::vector<std::string> &removedIds);
+
+    ///
+    /// Rewrites the file with one record per PropertyList.
+    /// \return false if the file could not be rewritten, the original file is unchanged in that case
+    ///
+    bool Compact();
+
+    /// \return size of the file up to the end of the last complete transaction in bytes
+    std::streamoff GetCommittedSize() const;
+
+    /// \return size of the records that were superseded by later transactions in bytes
+    std::streamoff GetSupersededSize() const;
+
+  protected:
+    PropertyListsJournal();
+    ~PropertyListsJournal() override;
+
+  private:
+    struct IndexEntry
+    {
+      std::streamoff PayloadOffset;
+      std::size_t PayloadLength;
+      std::streamoff RecordLength;
+    };
+
+    bool ReadTransactions(std::streamoff begin, std::vector<std::string> &changedIds);
+    void Reset();
+
+    std::string m_FileName;
+    std::map<std::string, IndexEntry> m_Index;
+    unsigned long m_Generation;
+    unsigned long long m_LastTransaction;
+    std::streamoff m_HeaderSize;
+    std::streamoff m_CommittedSize;
+    std::streamoff m_LiveSize;
+    bool m_HasIncompleteTail;
+    double m_CompactionThreshold;
+  };
+}
+
+#endif
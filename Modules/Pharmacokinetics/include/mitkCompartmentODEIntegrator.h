@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKCOMPARTMENTODEINTEGRATOR_H
+#define MITKCOMPARTMENTODEINTEGRATOR_H
+
+#include <memory>
+#include <vector>
+
+#include <itkArray.h>
+#include <vnl/vnl_matrix.h>
+#include <vnl/vnl_vector.h>
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** @class CompartmentODEIntegrator
+   * @brief Integrates linear compartment systems that are driven by an input curve (e.g. the AIF).
+   *
+   * A system is defined by the mass balance equations
+   *
+   * dx(t)/dt = A * x(t) + b * Ca(t),   x(0) = 0
+   *
+   * where x(t) are the concentrations of the compartments and Ca(t) is the input curve.
+   * The integration uses a fixed step size. Between two steps the input curve is linear, for which the
+   * system is solved exactly with the matrix exponential of the (augmented) system matrix. In contrast
+   * to explicit Runge-Kutta steppers the step is therefore stable for stiff systems (fast exchange rates)
+   * and its accuracy does not depend on the step size, apart from the sampling of the input curve.
+   *
+   * Several systems (e.g. the parameter sets of a numerical derivative, or several voxels) are advanced in
+   * lockstep; the states are stored system-interleaved so the update of one step is a loop over the systems.
+   *
+   * Optionally the sensitivities dx(t)/dp_i for parameters p_i are integrated alongside the states
+   * (forward sensitivity equations dS_i/dt = A * S_i + dA/dp_i * x + db/dp_i * Ca), which yields
+   * exact derivatives of the model signal for fitting.
+   *
+   * The input curve and the output time grid are preprocessed once by PrepareInput(); the result is
+   * cached, so all models of a fit sharing the same AIF and time grid share the preprocessing.
+   */
+  class MITKPHARMACOKINETICS_EXPORT CompartmentODEIntegrator
+  {
+  public:
+    typedef itk::Array<double> TimeGridType;
+    typedef itk::Array<double> InputCurveType;
+    typedef vnl_matrix<double> MatrixType;
+    typedef vnl_vector<double> VectorType;
+
+    /** Input curve sampled on the integration grid (t_k = k * StepSize, k = 0..Values.size()-1) and
+     * linear interpolation weights of the output time points between two integration steps.*/
+    struct PreparedInput
+    {
+      double StepSize;
+      std::vector<double> Values;
+
+      /** For every output time point: index k of the step [t_k, t_k+1] containing it and its weight towards t_k+1.*/
+      std::vector<unsigned int> OutputSteps;
+      std::vector<double> OutputWeights;
+
+      /** Output time points ordered by OutputSteps.*/
+      std::vector<unsigned int> OutputOrder;
+    };
+
+    typedef std::shared_ptr<const PreparedInput> PreparedInputPointer;
+
+    /** Linear system dx/dt = A * x + b * Ca(t). dA and db are the derivatives of A and b with respect to
+     * the parameters whose sensitivities should be computed; leave them empty if no sensitivities are needed.
+     * If db is not empty it must have the same number of elements as dA.*/
+    struct System
+    {
+      MatrixType A;
+      VectorType b;
+      std::vector<MatrixType> dA;
+      std::vector<VectorType> db;
+    };
+
+    /** Prepares the input curve for integration.
+     * @param outputGrid The time grid the results are needed for (in seconds, ascending).
+     * @param inputCurve The input curve given on outputGrid. It is interpolated linearly between the time points,
+     * is constant before the first time point and after the last one.
+     * @param stepSize Step size of the integration grid (in seconds). Must be positive.
+     * The integration starts at t = 0.*/
+    static PreparedInputPointer PrepareInput(const TimeGridType& outputGrid, const InputCurveType& inputCurve,
+                                             double stepSize);
+
+    /** Integrates the systems.
+     * @pre All systems must have the same number of states and the same number of sensitivities.
+     * @return For every system a matrix with one column per output time point. Rows 0..n-1 hold the states,
+     * row n*(1+i)+r holds dx_r/dp_i if sensitivities were requested.*/
+    static std::vector<MatrixType> Integrate(const PreparedInput& input, const std::vector<System>& systems);
+  };
+}
+
+#endif // MITKCOMPARTMENTODEINTEGRATOR_H
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define MITKNUMERICTWOCOMPARTMENTEXCHANGEMODEL_H
 
 #include "mitkAIFBasedModelBase.h"
+#include "mitkCompartmentODEIntegrator.h"
 #include "MitkPharmacokineticsExports.h"
 
 
@@ -27,8 +28,8 @@ namespace mitk
    * ve * dCi(t)/dt = PS * (Cp(t) - Ci(t))
    *
    * with concentration curve Cp(t) of the Blood Plasma p and Ce(t) of the Extracellular Extravascular Space(EES)(interstitial volume). CA(t) is the aterial concentration, i.e. the AIF
-   * Cp(t) and Ce(t) are found numerical via Runge-Kutta methode, implemented in Boosts numeric library ODEINT. Here we use a runge_kutta_cash_karp54 stepper with
-   * adaptive step size and error controll.
+   * Cp(t) and Ce(t) are found numerically by CompartmentODEIntegrator on a fixed grid with step size ODEINTStepSize (the AIF is linear between the grid points,
+   * each step is solved exactly). Several parameter sets (see GetSignals()) are integrated in lockstep, and the Jacobian is computed with the sensitivity equations.
    * From the resulting curves Cp(t) and Ce(t) the measured concentration Ctotal(t) is found vial
    *
    * Ctotal(t) = vp * Cp(t) + ve * Ce(t)
@@ -92,6 +93,8 @@ namespace mitk
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
 
+    bool ProvidesJacobian() const override;
+
 
   protected:
     NumericTwoCompartmentExchangeModel();
@@ -104,6 +107,9 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+    std::vector<ModelResultType> ComputeModelfunctions(const std::vector<ParametersType>& parameters) const override;
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         JacobianType& jacobian) const override;
 
     void SetStaticParameter(const ParameterNameType& name, const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
@@ -111,8 +117,11 @@ namespace mitk
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
+    /** Defines the mass balance equations for the parameters; with sensitivities for all parameters if requested.*/
+    CompartmentODEIntegrator::System GenerateSystem(const ParametersType& parameters, bool withSensitivities) const;
 
-
+    /** Prepares the AIF for the integration on the current time grid.*/
+    CompartmentODEIntegrator::PreparedInputPointer PrepareAIF() const;
 
     //No copy constructor allowed
     NumericTwoCompartmentExchangeModel(const Self& source);
@@ -14,11 +14,16 @@ found in the LICENSE file.
 #define MITKNUMERICTWOTISSUECOMPARTMENTMODEL_H
 
 #include "mitkAIFBasedModelBase.h"
+#include "mitkCompartmentODEIntegrator.h"
 #include "MitkPharmacokineticsExports.h"
 
 
 namespace mitk
 {
+  /** @class NumericTwoTissueCompartmentModel
+   * @brief Numeric implementation of the 2-tissue-compartment model (see TwoTissueCompartmentModelDifferentialEquations
+   * for the mass balance equations). The concentrations are integrated by CompartmentODEIntegrator with a fixed step
+   * size of 0.1 s; the Jacobian is computed with the sensitivity equations.*/
   class MITKPHARMACOKINETICS_EXPORT NumericTwoTissueCompartmentModel : public AIFBasedModelBase
   {
 
@@ -70,6 +75,8 @@ namespace mitk
 
     ParamterUnitMapType GetParameterUnits() const override;
 
+    bool ProvidesJacobian() const override;
+
   protected:
     NumericTwoTissueCompartmentModel();
     ~NumericTwoTissueCompartmentModel() override;
@@ -81,11 +88,15 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+    std::vector<ModelResultType> ComputeModelfunctions(const std::vector<ParametersType>& parameters) const override;
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         JacobianType& jacobian) const override;
 
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
-
+    /** Defines the mass balance equations for the parameters; with sensitivities for all parameters if requested.*/
+    CompartmentODEIntegrator::System GenerateSystem(const ParametersType& parameters, bool withSensitivities) const;
 
     //No copy constructor allowed
     NumericTwoTissueCompartmentModel(const Self& source);
@@ -0,0 +1,335 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompartmentODEIntegrator.h"
+
+#include <itkMacro.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <mutex>
+
+namespace
+{
+  typedef mitk::CompartmentODEIntegrator::MatrixType MatrixType;
+
+  /** Matrix exponential by scaling and squaring of a truncated Taylor series.*/
+  MatrixType MatrixExponential(const MatrixType& matrix)
+  {
+    const unsigned int size = matrix.rows();
+
+    double norm = 0;
+    for (unsigned int r = 0; r < size; ++r)
+    {
+      double rowSum = 0;
+      for (unsigned int c = 0; c < size; ++c)
+      {
+        rowSum += std::abs(matrix(r, c));
+      }
+      norm = std::max(norm, rowSum);
+    }
+
+    // non-finite parameters (e.g. proposed by an optimizer) yield a non-finite result
+    if (!std::isfinite(norm))
+    {
+      MatrixType result(size, size);
+      result.fill(std::numeric_limits<double>::quiet_NaN());
+      return result;
+    }
+
+    // scale the matrix to a norm <= 0.5, where 14 terms of the series are accurate to double precision.
+    // The exponential of larger norms overflows anyway, the number of squarings is limited for them.
+    const int maximumSquarings = 64;
+    int squarings = 0;
+    if (norm > 0.5)
+    {
+      squarings = static_cast<int>(std::min<double>(std::ceil(std::log2(norm / 0.5)), maximumSquarings));
+    }
+
+    const MatrixType scaled = matrix / std::ldexp(1.0, squarings);
+
+    MatrixType result(size, size);
+    result.set_identity();
+    MatrixType term = result;
+
+    for (unsigned int i = 1; i <= 14; ++i)
+    {
+      term = term * scaled / static_cast<double>(i);
+      result += term;
+    }
+
+    for (int i = 0; i < squarings; ++i)
+    {
+      result = result * result;
+    }
+
+    return result;
+  }
+
+  double InterpolateInput(const mitk::CompartmentODEIntegrator::TimeGridType& grid,
+                          const mitk::CompartmentODEIntegrator::InputCurveType& curve,
+                          double t,
+                          unsigned int& position)
+  {
+    const unsigned int size = grid.GetSize();
+
+    if (t <= grid[0])
+    {
+      return curve[0];
+    }
+    if (t >= grid[size - 1])
+    {
+      return curve[size - 1];
+    }
+
+    // t is increasing for consecutive calls, so the search continues at the last position.
+    while (position + 1 < size && grid[position + 1] < t)
+    {
+      ++position;
+    }
+
+    const double weight = (t - grid[position]) / (grid[position + 1] - grid[position]);
+    return (1 - weight) * curve[position] + weight * curve[position + 1];
+  }
+
+  struct CacheEntry
+  {
+    double StepSize;
+    mitk::CompartmentODEIntegrator::TimeGridType Grid;
+    mitk::CompartmentODEIntegrator::InputCurveType Curve;
+    mitk::CompartmentODEIntegrator::PreparedInputPointer Input;
+  };
+
+  /** The inputs prepared last. Usually all voxels of a fit share one AIF and time grid.*/
+  const std::size_t MaximumCacheSize = 8;
+  std::mutex cacheMutex;
+  std::list<CacheEntry> cache;
+}
+
+mitk::CompartmentODEIntegrator::PreparedInputPointer
+mitk::CompartmentODEIntegrator::PrepareInput(const TimeGridType& outputGrid, const InputCurveType& inputCurve,
+                                             double stepSize)
+{
+  if (outputGrid.GetSize() == 0)
+  {
+    itkGenericExceptionMacro("Cannot prepare input for integration. Time grid is empty.");
+  }
+  if (outputGrid.GetSize() != inputCurve.GetSize())
+  {
+    itkGenericExceptionMacro("Cannot prepare input for integration. Input curve and time grid have not the same size.");
+  }
+  if (!(stepSize > 0))
+  {
+    itkGenericExceptionMacro("Cannot prepare input for integration. Step size must be positive; step size: " << stepSize);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    for (auto pos = cache.begin(); pos != cache.end(); ++pos)
+    {
+      if (pos->StepSize == stepSize && pos->Grid == outputGrid && pos->Curve == inputCurve)
+      {
+        cache.splice(cache.begin(), cache, pos);
+        return cache.front().Input;
+      }
+    }
+  }
+
+  auto input = std::make_shared<PreparedInput>();
+  input->StepSize = stepSize;
+
+  const double endTime = *std::max_element(outputGrid.begin(), outputGrid.end());
+  const unsigned int steps = std::max(1u, static_cast<unsigned int>(std::ceil(endTime / stepSize)));
+
+  input->Values.resize(steps + 1);
+  unsigned int position = 0;
+  for (unsigned int k = 0; k <= steps; ++k)
+  {
+    input->Values[k] = InterpolateInput(outputGrid, inputCurve, k * stepSize, position);
+  }
+
+  const unsigned int outputSize = outputGrid.GetSize();
+  input->OutputSteps.resize(outputSize);
+  input->OutputWeights.resize(outputSize);
+
+  for (unsigned int j = 0; j < outputSize; ++j)
+  {
+    const double stepPosition = std::max(0.0, outputGrid[j] / stepSize);
+    unsigned int step = static_cast<unsigned int>(stepPosition);
+    double weight = stepPosition - step;
+
+    if (step >= steps)
+    {
+      step = steps - 1;
+      weight = 1.0;
+    }
+
+    input->OutputSteps[j] = step;
+    input->OutputWeights[j] = weight;
+  }
+
+  input->OutputOrder.resize(outputSize);
+  for (unsigned int j = 0; j < outputSize; ++j)
+  {
+    input->OutputOrder[j] = j;
+  }
+  std::stable_sort(input->OutputOrder.begin(), input->OutputOrder.end(),
+                   [&input](unsigned int a, unsigned int b) { return input->OutputSteps[a] < input->OutputSteps[b]; });
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  cache.push_front(CacheEntry{stepSize, outputGrid, inputCurve, input});
+  if (cache.size() > MaximumCacheSize)
+  {
+    cache.pop_back();
+  }
+
+  return input;
+}
+
+std::vector<mitk::CompartmentODEIntegrator::MatrixType>
+mitk::CompartmentODEIntegrator::Integrate(const PreparedInput& input, const std::vector<System>& systems)
+{
+  std::vector<MatrixType> results;
+
+  if (systems.empty())
+  {
+    return results;
+  }
+
+  const unsigned int stateCount = systems.front().A.rows();
+  const unsigned int parameterCount = systems.front().dA.size();
+  const unsigned int dimension = stateCount * (1 + parameterCount);
+  const unsigned int batchSize = systems.size();
+  const unsigned int outputSize = input.OutputSteps.size();
+  const double h = input.StepSize;
+
+  // Discretization of every system: x_k+1 = Phi * x_k + g0 * Ca_k + g1 * Ca_k+1, stored interleaved by system.
+  std::vector<double> phi(dimension * dimension * batchSize);
+  std::vector<double> g0(dimension * batchSize);
+  std::vector<double> g1(dimension * batchSize);
+
+  for (unsigned int s = 0; s < batchSize; ++s)
+  {
+    const System& system = systems[s];
+
+    if (system.A.rows() != stateCount || system.A.cols() != stateCount || system.b.size() != stateCount ||
+        system.dA.size() != parameterCount || (!system.db.empty() && system.db.size() != parameterCount))
+    {
+      itkGenericExceptionMacro("Cannot integrate systems. Systems have different or invalid dimensions.");
+    }
+
+    // augmented system [x; S_1 ... S_P; Ca; change of Ca over the step], Ca is linear within a step.
+    MatrixType augmented(dimension + 2, dimension + 2, 0.0);
+    for (unsigned int block = 0; block <= parameterCount; ++block)
+    {
+      augmented.update(system.A * h, block * stateCount, block * stateCount);
+
+      if (block > 0)
+      {
+        augmented.update(system.dA[block - 1] * h, block * stateCount, 0);
+      }
+
+      for (unsigned int r = 0; r < stateCount; ++r)
+      {
+        double inputFactor = system.b[r];
+        if (block > 0)
+        {
+          inputFactor = system.db.empty() ? 0.0 : system.db[block - 1][r];
+        }
+        augmented(block * stateCount + r, dimension) = inputFactor * h;
+      }
+    }
+    augmented(dimension, dimension + 1) = 1.0;
+
+    const MatrixType exponential = MatrixExponential(augmented);
+
+    for (unsigned int r = 0; r < dimension; ++r)
+    {
+      for (unsigned int c = 0; c < dimension; ++c)
+      {
+        phi[(r * dimension + c) * batchSize + s] = exponential(r, c);
+      }
+
+      // exponential(r, dimension + 1) maps the change of Ca over the step
+      g0[r * batchSize + s] = exponential(r, dimension) - exponential(r, dimension + 1);
+      g1[r * batchSize + s] = exponential(r, dimension + 1);
+    }
+  }
+
+  // skip the entries of Phi that vanish for all systems (e.g. the upper blocks of the sensitivity system)
+  std::vector<std::pair<unsigned int, unsigned int>> entries;
+  for (unsigned int r = 0; r < dimension; ++r)
+  {
+    for (unsigned int c = 0; c < dimension; ++c)
+    {
+      const double* values = &phi[(r * dimension + c) * batchSize];
+      if (std::any_of(values, values + batchSize, [](double value) { return value != 0.0; }))
+      {
+        entries.emplace_back(r, c);
+      }
+    }
+  }
+
+  results.assign(batchSize, MatrixType(dimension, outputSize, 0.0));
+
+  std::vector<double> state(dimension * batchSize, 0.0);
+  std::vector<double> next(dimension * batchSize);
+
+  const unsigned int steps = input.Values.size() - 1;
+  unsigned int orderPosition = 0;
+
+  for (unsigned int k = 0; k < steps && orderPosition < outputSize; ++k)
+  {
+    const double ca0 = input.Values[k];
+    const double ca1 = input.Values[k + 1];
+
+    for (unsigned int i = 0; i < dimension * batchSize; ++i)
+    {
+      next[i] = g0[i] * ca0 + g1[i] * ca1;
+    }
+
+    for (const auto& entry : entries)
+    {
+      const double* factors = &phi[(entry.first * dimension + entry.second) * batchSize];
+      const double* source = &state[entry.second * batchSize];
+      double* target = &next[entry.first * batchSize];
+
+      for (unsigned int s = 0; s < batchSize; ++s)
+      {
+        target[s] += factors[s] * source[s];
+      }
+    }
+
+    while (orderPosition < outputSize && input.OutputSteps[input.OutputOrder[orderPosition]] == k)
+    {
+      const unsigned int j = input.OutputOrder[orderPosition];
+      const double weight = input.OutputWeights[j];
+
+      for (unsigned int r = 0; r < dimension; ++r)
+      {
+        for (unsigned int s = 0; s < batchSize; ++s)
+        {
+          results[s](r, j) = (1 - weight) * state[r * batchSize + s] + weight * next[r * batchSize + s];
+        }
+      }
+
+      ++orderPosition;
+    }
+
+    state.swap(next);
+  }
+
+  return results;
+}
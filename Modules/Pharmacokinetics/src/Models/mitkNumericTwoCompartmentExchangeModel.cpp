@@ -12,11 +12,6 @@ found in the LICENSE file.
 
 #include "mitkNumericTwoCompartmentExchangeModel.h"
 #include "mitkAIFParametrizerHelper.h"
-#include "mitkTimeGridHelper.h"
-#include "mitkTwoCompartmentExchangeModelDifferentialEquations.h"
-#include <vnl/algo/vnl_fft_1d.h>
-#include <boost/numeric/odeint.hpp>
-#include <fstream>
 
 const std::string mitk::NumericTwoCompartmentExchangeModel::MODEL_DISPLAY_NAME =
   "Numeric Two Compartment Exchange Model";
@@ -52,7 +47,7 @@ std::string mitk::NumericTwoCompartmentExchangeModel::GetModelType() const
 };
 
 
-mitk::NumericTwoCompartmentExchangeModel::NumericTwoCompartmentExchangeModel()
+mitk::NumericTwoCompartmentExchangeModel::NumericTwoCompartmentExchangeModel() : m_ODEINTStepSize(0.05)
 {
 
 }
@@ -159,13 +154,14 @@ mitk::NumericTwoCompartmentExchangeModel::GetParameterUnits() const
   return result;
 };
 
-mitk::NumericTwoCompartmentExchangeModel::ModelResultType
-mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& parameters)
-const
+bool mitk::NumericTwoCompartmentExchangeModel::ProvidesJacobian() const
 {
-  typedef itk::Array<double> ConcentrationCurveType;
-  typedef std::vector<double> ConcentrationVectorType;
+  return true;
+};
 
+mitk::CompartmentODEIntegrator::PreparedInputPointer
+mitk::NumericTwoCompartmentExchangeModel::PrepareAIF() const
+{
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
@@ -174,103 +170,133 @@ const
   AterialInputFunctionType aterialInputFunction;
   aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
 
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
-
-  /** @brief Boost::numeric::odeint works with type std::vector<double> thus, aif and grid are converted to ModelParameters( of type std::vector)
-   */
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType aif = mitk::convertArrayToParameter(
-        aterialInputFunction);
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType grid =
-    mitk::convertArrayToParameter(m_TimeGrid);
-
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType aifODE = aif;
-  aifODE.push_back(aif[timeSteps - 1]);
-  mitk::TwoCompartmentExchangeModelDifferentialEquations::AIFType gridODE = grid;
-  gridODE.push_back(grid[timeSteps - 1] + (grid[timeSteps - 1] - grid[timeSteps - 2]));
-
-
+  return CompartmentODEIntegrator::PrepareInput(this->m_TimeGrid, aterialInputFunction, this->m_ODEINTStepSize);
+}
 
+mitk::CompartmentODEIntegrator::System
+mitk::NumericTwoCompartmentExchangeModel::GenerateSystem(const ParametersType& parameters, bool withSensitivities) const
+{
   //Model Parameters
   double F = (double) parameters[POSITION_PARAMETER_F] / 6000.0;
   double PS  = (double) parameters[POSITION_PARAMETER_PS] / 6000.0;
   double ve = (double) parameters[POSITION_PARAMETER_ve];
   double vp = (double) parameters[POSITION_PARAMETER_vp];
 
+  /** @brief Mass balance equations: vp * dCp/dt = F * (CA - Cp) - PS * (Cp - Ce); ve * dCe/dt = PS * (Cp - Ce)*/
+  CompartmentODEIntegrator::System system;
+  system.A.set_size(2, 2);
+  system.A(0, 0) = -(F + PS) / vp;
+  system.A(0, 1) = PS / vp;
+  system.A(1, 0) = PS / ve;
+  system.A(1, 1) = -PS / ve;
+  system.b.set_size(2);
+  system.b[0] = F / vp;
+  system.b[1] = 0.0;
+
+  if (withSensitivities)
+  {
+    system.dA.assign(NUMBER_OF_PARAMETERS, CompartmentODEIntegrator::MatrixType(2, 2, 0.0));
+    system.db.assign(NUMBER_OF_PARAMETERS, CompartmentODEIntegrator::VectorType(2, 0.0));
 
-  /** @brief Initialize class TwoCompartmentExchangeModelDifferentialEquations defining the differential equations. AIF and Grid must be set so that at step t the aterial Concentration Ca(t) can be interpolated from AIF*/
-  mitk::TwoCompartmentExchangeModelDifferentialEquations ode;
-  ode.initialize(F, PS, ve, vp);
-  ode.setAIF(aifODE);
-  ode.setAIFTimeGrid(gridODE);
+    system.dA[POSITION_PARAMETER_F](0, 0) = -1.0 / (6000.0 * vp);
+    system.db[POSITION_PARAMETER_F][0] = 1.0 / (6000.0 * vp);
 
-  state_type x(2);
-  x[0] = 0.0;
-  x[1] = 0.0;
-  typedef boost::numeric::odeint::runge_kutta_cash_karp54<state_type> error_stepper_type;
-  //typedef boost::numeric::odeint::runge_kutta4< state_type > stepper_type;
+    system.dA[POSITION_PARAMETER_PS](0, 0) = -1.0 / (6000.0 * vp);
+    system.dA[POSITION_PARAMETER_PS](0, 1) = 1.0 / (6000.0 * vp);
+    system.dA[POSITION_PARAMETER_PS](1, 0) = 1.0 / (6000.0 * ve);
+    system.dA[POSITION_PARAMETER_PS](1, 1) = -1.0 / (6000.0 * ve);
 
-  /** @brief Results of odeeint x[0] and x[1]*/
-  ConcentrationVectorType Cp;
-  ConcentrationVectorType Ce;
-  ConcentrationVectorType odeTimeGrid;
+    system.dA[POSITION_PARAMETER_ve](1, 0) = -PS / (ve * ve);
+    system.dA[POSITION_PARAMETER_ve](1, 1) = PS / (ve * ve);
 
-  error_stepper_type stepper;
+    system.dA[POSITION_PARAMETER_vp](0, 0) = (F + PS) / (vp * vp);
+    system.dA[POSITION_PARAMETER_vp](0, 1) = -PS / (vp * vp);
+    system.db[POSITION_PARAMETER_vp][0] = -F / (vp * vp);
+  }
 
+  return system;
+}
 
-  /** @brief Stepsize. Should be adapted by stepper (runge_kutta_cash_karp54) */
-//  const double dt = 0.05;
-   const double dt = this->m_ODEINTStepSize;
+mitk::NumericTwoCompartmentExchangeModel::ModelResultType
+mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& parameters)
+const
+{
+  return this->ComputeModelfunctions(std::vector<ParametersType>(1, parameters)).front();
+}
 
+std::vector<mitk::NumericTwoCompartmentExchangeModel::ModelResultType>
+mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunctions(const std::vector<ParametersType>& parameters) const
+{
+  CompartmentODEIntegrator::PreparedInputPointer aif = this->PrepareAIF();
 
-  /** @brief perform Step t -> t+dt to calculate approximate value x(t+dt)*/
-  for (double t = 0.0; t < this->m_TimeGrid(this->m_TimeGrid.GetSize() - 1) - 2*dt; t += dt)
+  std::vector<CompartmentODEIntegrator::System> systems;
+  systems.reserve(parameters.size());
+  for (const auto& parameterSet : parameters)
   {
-    stepper.do_step(ode, x, t, dt);
-    Cp.push_back(x[0]);
-    Ce.push_back(x[1]);
-    odeTimeGrid.push_back(t);
+    systems.push_back(this->GenerateSystem(parameterSet, false));
   }
 
-  /** @brief transfom result of Differential equations back to itk::Array and interpolate to m_TimeGrid (they are calculated on a different grid defined by stepsize of odeint)*/
-  ConcentrationCurveType plasmaConcentration = mitk::convertParameterToArray(Cp);
-  ConcentrationCurveType EESConcentration = mitk::convertParameterToArray(Ce);
-  ConcentrationCurveType rungeKuttaTimeGrid = mitk::convertParameterToArray(odeTimeGrid);
+  /** @brief Cp(t) and Ce(t) of all parameter sets, integrated in lockstep*/
+  const std::vector<CompartmentODEIntegrator::MatrixType> concentrations = CompartmentODEIntegrator::Integrate(*aif, systems);
 
-  mitk::ModelBase::ModelResultType C_Plasma = mitk::InterpolateSignalToNewTimeGrid(plasmaConcentration, rungeKuttaTimeGrid, m_TimeGrid);
-  mitk::ModelBase::ModelResultType C_EES = mitk::InterpolateSignalToNewTimeGrid(EESConcentration, rungeKuttaTimeGrid, m_TimeGrid);
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  std::vector<ModelResultType> signals;
+  signals.reserve(parameters.size());
 
+  for (std::size_t i = 0; i < parameters.size(); ++i)
+  {
+    double ve = (double) parameters[i][POSITION_PARAMETER_ve];
+    double vp = (double) parameters[i][POSITION_PARAMETER_vp];
+
+    //Signal that will be returned by ComputeModelFunction
+    ModelResultType signal(timeSteps);
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      signal[t] = vp * concentrations[i](0, t) + ve * concentrations[i](1, t);
+    }
+    signals.push_back(signal);
+  }
 
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
+  return signals;
+}
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator CePos = C_EES.begin();
+void mitk::NumericTwoCompartmentExchangeModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+    ModelResultType& signal, JacobianType& jacobian) const
+{
+  CompartmentODEIntegrator::PreparedInputPointer aif = this->PrepareAIF();
 
-  mitk::ModelBase::ModelResultType::const_iterator t = this->m_TimeGrid.begin();
-  mitk::ModelBase::ModelResultType::const_iterator Cin = aterialInputFunction.begin();
+  const std::vector<CompartmentODEIntegrator::MatrixType> results =
+    CompartmentODEIntegrator::Integrate(*aif, std::vector<CompartmentODEIntegrator::System>(1, this->GenerateSystem(parameters, true)));
+  const CompartmentODEIntegrator::MatrixType& concentrations = results.front();
 
+  double ve = (double) parameters[POSITION_PARAMETER_ve];
+  double vp = (double) parameters[POSITION_PARAMETER_vp];
 
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(timeSteps, NUMBER_OF_PARAMETERS);
 
-  for (mitk::ModelBase::ModelResultType::const_iterator CpPos = C_Plasma.begin();
-       CpPos != C_Plasma.end(); ++CpPos, ++CePos, ++signalPos, ++t, ++Cin)
+  for (unsigned int t = 0; t < timeSteps; ++t)
   {
-    *signalPos = vp * (*CpPos) + ve * (*CePos);
-
-  }
+    signal[t] = vp * concentrations(0, t) + ve * concentrations(1, t);
 
-  return signal;
+    for (unsigned int p = 0; p < NUMBER_OF_PARAMETERS; ++p)
+    {
+      // rows 2 + 2 * p and 3 + 2 * p hold the sensitivities of Cp and Ce
+      jacobian(t, p) = vp * concentrations(2 + 2 * p, t) + ve * concentrations(3 + 2 * p, t);
+    }
 
+    jacobian(t, POSITION_PARAMETER_ve) += concentrations(1, t);
+    jacobian(t, POSITION_PARAMETER_vp) += concentrations(0, t);
+  }
 }
 
-
-
-
 itk::LightObject::Pointer mitk::NumericTwoCompartmentExchangeModel::InternalClone() const
 {
   NumericTwoCompartmentExchangeModel::Pointer newClone = NumericTwoCompartmentExchangeModel::New();
 
   newClone->SetTimeGrid(this->m_TimeGrid);
+  newClone->SetODEINTStepSize(this->m_ODEINTStepSize);
 
   return newClone.GetPointer();
 }
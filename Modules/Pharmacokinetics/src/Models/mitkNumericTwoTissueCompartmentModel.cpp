@@ -12,11 +12,12 @@ found in the LICENSE file.
 
 #include "mitkNumericTwoTissueCompartmentModel.h"
 #include "mitkAIFParametrizerHelper.h"
-#include "mitkTimeGridHelper.h"
-#include "mitkTwoTissueCompartmentModelDifferentialEquations.h"
-#include <vnl/algo/vnl_fft_1d.h>
-#include <boost/numeric/odeint.hpp>
-#include <fstream>
+
+namespace
+{
+  /** Step size (in s) of the numeric integration.*/
+  const double IntegrationStepSize = 0.1;
+}
 
 const std::string mitk::NumericTwoTissueCompartmentModel::MODEL_DISPLAY_NAME =
   "Numeric Two Tissue Compartment Model";
@@ -97,12 +98,59 @@ mitk::NumericTwoTissueCompartmentModel::GetParameterUnits() const
 };
 
 
+bool mitk::NumericTwoTissueCompartmentModel::ProvidesJacobian() const
+{
+  return true;
+};
+
+mitk::CompartmentODEIntegrator::System
+mitk::NumericTwoTissueCompartmentModel::GenerateSystem(const ParametersType& parameters, bool withSensitivities) const
+{
+  //Model Parameters
+  double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
+  double k2 = (double)parameters[POSITION_PARAMETER_k2] / 60.0;
+  double k3 = (double)parameters[POSITION_PARAMETER_k3] / 60.0;
+  double k4 = (double)parameters[POSITION_PARAMETER_k4] / 60.0;
+
+  /** @brief Mass balance equations: dC1/dt = K1*Ca - (k2 + k3)*C1 + k4*C2; dC2/dt = k3*C1 - k4*C2*/
+  CompartmentODEIntegrator::System system;
+  system.A.set_size(2, 2);
+  system.A(0, 0) = -(k2 + k3);
+  system.A(0, 1) = k4;
+  system.A(1, 0) = k3;
+  system.A(1, 1) = -k4;
+  system.b.set_size(2);
+  system.b[0] = K1;
+  system.b[1] = 0.0;
+
+  if (withSensitivities)
+  {
+    system.dA.assign(NUMBER_OF_PARAMETERS, CompartmentODEIntegrator::MatrixType(2, 2, 0.0));
+    system.db.assign(NUMBER_OF_PARAMETERS, CompartmentODEIntegrator::VectorType(2, 0.0));
+
+    system.db[POSITION_PARAMETER_K1][0] = 1.0 / 60.0;
+
+    system.dA[POSITION_PARAMETER_k2](0, 0) = -1.0 / 60.0;
+
+    system.dA[POSITION_PARAMETER_k3](0, 0) = -1.0 / 60.0;
+    system.dA[POSITION_PARAMETER_k3](1, 0) = 1.0 / 60.0;
+
+    system.dA[POSITION_PARAMETER_k4](0, 1) = 1.0 / 60.0;
+    system.dA[POSITION_PARAMETER_k4](1, 1) = -1.0 / 60.0;
+  }
+
+  return system;
+}
+
 mitk::NumericTwoTissueCompartmentModel::ModelResultType
 mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& parameters) const
 {
-  typedef itk::Array<double> ConcentrationCurveType;
-  typedef std::vector<double> ConcentrationVectorType;
+  return this->ComputeModelfunctions(std::vector<ParametersType>(1, parameters)).front();
+}
 
+std::vector<mitk::NumericTwoTissueCompartmentModel::ModelResultType>
+mitk::NumericTwoTissueCompartmentModel::ComputeModelfunctions(const std::vector<ParametersType>& parameters) const
+{
   if (this->m_TimeGrid.GetSize() == 0)
   {
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
@@ -111,88 +159,76 @@ mitk::NumericTwoTissueCompartmentModel::ComputeModelfunction(const ParametersTyp
   AterialInputFunctionType aterialInputFunction;
   aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
 
-  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  CompartmentODEIntegrator::PreparedInputPointer aif =
+    CompartmentODEIntegrator::PrepareInput(this->m_TimeGrid, aterialInputFunction, IntegrationStepSize);
 
-  /** @brief Boost::numeric::odeint works with type std::vector<double> thus, aif and grid are converted to ModelParameters( of type std::vector)
-   */
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType aif = mitk::convertArrayToParameter(
-        aterialInputFunction);
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType grid = mitk::convertArrayToParameter(
-        m_TimeGrid);
-
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType aifODE = aif;
-  aifODE.push_back(aif[timeSteps - 1]);
-  mitk::TwoTissueCompartmentModelDifferentialEquations::AIFType gridODE = grid;
-  gridODE.push_back(grid[timeSteps - 1] + (grid[timeSteps - 1] - grid[timeSteps - 2]));
-
-  //Model Parameters
-  double K1 = (double)parameters[POSITION_PARAMETER_K1] / 60.0;
-  double k2 = (double)parameters[POSITION_PARAMETER_k2] / 60.0;
-  double k3 = (double)parameters[POSITION_PARAMETER_k3] / 60.0;
-  double k4 = (double)parameters[POSITION_PARAMETER_k4] / 60.0;
-  double VB = parameters[POSITION_PARAMETER_VB];
-
-
-  /** @brief Initialize class TwpTissueCompartmentModelDifferentialEquations defining the differential equations. AIF and Grid must be set so that at step t the aterial Concentration Ca(t) can be interpolated from AIF*/
-  mitk::TwoTissueCompartmentModelDifferentialEquations ode;
-  ode.initialize(K1, k2, k3, k4);
-  ode.setAIF(aifODE);
-  ode.setAIFTimeGrid(gridODE);
+  std::vector<CompartmentODEIntegrator::System> systems;
+  systems.reserve(parameters.size());
+  for (const auto& parameterSet : parameters)
+  {
+    systems.push_back(this->GenerateSystem(parameterSet, false));
+  }
 
-  state_type x(2);
-  x[0] = 0.0;
-  x[1] = 0.0;
-  typedef boost::numeric::odeint::runge_kutta_cash_karp54<state_type> error_stepper_type;
-  //typedef boost::numeric::odeint::runge_kutta4< state_type > stepper_type;
+  /** @brief C1(t) and C2(t) of all parameter sets, integrated in lockstep*/
+  const std::vector<CompartmentODEIntegrator::MatrixType> concentrations = CompartmentODEIntegrator::Integrate(*aif, systems);
 
-  /** @brief Results of odeeint x[0] and x[1]*/
-  ConcentrationVectorType C1;
-  ConcentrationVectorType C2;
-  ConcentrationVectorType odeTimeGrid;
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  std::vector<ModelResultType> signals;
+  signals.reserve(parameters.size());
 
-  error_stepper_type stepper;
-  /** @brief Stepsize. Should be adapted by stepper (runge_kutta_cash_karp54) */
-  const double dt = 0.1;
-  /** @brief perform Step t -> t+dt to calculate approximate value x(t+dt)*/
+  for (std::size_t i = 0; i < parameters.size(); ++i)
+  {
+    double VB = parameters[i][POSITION_PARAMETER_VB];
+
+    //Signal that will be returned by ComputeModelFunction
+    ModelResultType signal(timeSteps);
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      signal[t] = VB * aterialInputFunction[t] + (1 - VB) * (concentrations[i](0, t) + concentrations[i](1, t));
+    }
+    signals.push_back(signal);
+  }
 
-  double T = this->m_TimeGrid(timeSteps - 1) + (grid[timeSteps - 1] - grid[timeSteps - 2]);
+  return signals;
+}
 
-  for (double t = 0.0; t < T; t += dt)
+void mitk::NumericTwoTissueCompartmentModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+    ModelResultType& signal, JacobianType& jacobian) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
   {
-    stepper.do_step(ode, x, t, dt);
-    C1.push_back(x[0]);
-    C2.push_back(x[1]);
-    odeTimeGrid.push_back(t);
-
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  /** @brief transfom result of Differential equations back to itk::Array and interpolate to m_TimeGrid (they are calculated on a different grid defined by stepsize of odeint)*/
-  ConcentrationCurveType ConcentrationCompartment1 = mitk::convertParameterToArray(C1);
-  ConcentrationCurveType ConcentrationCompartment2 = mitk::convertParameterToArray(C2);
-  ConcentrationCurveType rungeKuttaTimeGrid = mitk::convertParameterToArray(odeTimeGrid);
+  AterialInputFunctionType aterialInputFunction;
+  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
 
-  mitk::ModelBase::ModelResultType C_1 = mitk::InterpolateSignalToNewTimeGrid(
-      ConcentrationCompartment1, rungeKuttaTimeGrid, m_TimeGrid);
-  mitk::ModelBase::ModelResultType C_2 = mitk::InterpolateSignalToNewTimeGrid(
-      ConcentrationCompartment2, rungeKuttaTimeGrid, m_TimeGrid);
+  CompartmentODEIntegrator::PreparedInputPointer aif =
+    CompartmentODEIntegrator::PrepareInput(this->m_TimeGrid, aterialInputFunction, IntegrationStepSize);
 
+  const std::vector<CompartmentODEIntegrator::MatrixType> results =
+    CompartmentODEIntegrator::Integrate(*aif, std::vector<CompartmentODEIntegrator::System>(1, this->GenerateSystem(parameters, true)));
+  const CompartmentODEIntegrator::MatrixType& concentrations = results.front();
 
-  //Signal that will be returned by ComputeModelFunction
-  mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator C1Pos = C_1.begin();
-  mitk::ModelBase::ModelResultType::const_iterator C2Pos = C_2.begin();
+  double VB = parameters[POSITION_PARAMETER_VB];
 
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(timeSteps, NUMBER_OF_PARAMETERS);
 
-  for (AterialInputFunctionType::const_iterator aifpos = aterialInputFunction.begin();
-       aifpos != aterialInputFunction.end(); ++aifpos, ++C1Pos, ++C2Pos, ++signalPos)
+  for (unsigned int t = 0; t < timeSteps; ++t)
   {
-    *signalPos = VB * (*aifpos) + (1 - VB) * (*C1Pos + *C2Pos);
-  }
+    const double tissue = concentrations(0, t) + concentrations(1, t);
+    signal[t] = VB * aterialInputFunction[t] + (1 - VB) * tissue;
 
-  return signal;
+    for (unsigned int p = 0; p < NUMBER_OF_PARAMETERS; ++p)
+    {
+      // rows 2 + 2 * p and 3 + 2 * p hold the sensitivities of C1 and C2
+      jacobian(t, p) = (1 - VB) * (concentrations(2 + 2 * p, t) + concentrations(3 + 2 * p, t));
+    }
 
+    jacobian(t, POSITION_PARAMETER_VB) = aterialInputFunction[t] - tissue;
+  }
 }
 
 itk::LightObject::Pointer mitk::NumericTwoTissueCompartmentModel::InternalClone() const
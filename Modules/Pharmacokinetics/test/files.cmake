@@ -1,4 +1,5 @@
 SET(MODULE_TESTS
   mitkDescriptivePharmacokineticBrixModelTest.cpp
+  mitkCompartmentODEIntegratorTest.cpp
   #ConvertToConcentrationTest.cpp
 )
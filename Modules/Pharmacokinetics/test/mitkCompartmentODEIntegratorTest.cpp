@@ -0,0 +1,191 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkTestingMacros.h"
+
+#include "mitkCompartmentODEIntegrator.h"
+#include "mitkNumericTwoCompartmentExchangeModel.h"
+#include "mitkNumericTwoTissueCompartmentModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  mitk::ModelBase::TimeGridType GenerateTimeGrid()
+  {
+    mitk::ModelBase::TimeGridType grid(30);
+    for (unsigned int i = 0; i < grid.size(); ++i)
+    {
+      grid[i] = 1.0 + 4.0 * i;
+    }
+    return grid;
+  }
+
+  mitk::AIFBasedModelBase::AterialInputFunctionType GenerateAIF(const mitk::ModelBase::TimeGridType& grid)
+  {
+    mitk::AIFBasedModelBase::AterialInputFunctionType aif(grid.size());
+    for (unsigned int i = 0; i < grid.size(); ++i)
+    {
+      const double t = grid[i] - 10.0;
+      aif[i] = t < 0 ? 0.0 : 5.0 * t * std::exp(-t / 4.0) + 0.5;
+    }
+    return aif;
+  }
+
+  /** Checks the Jacobian of the model against central differences of GetSignals().*/
+  bool CheckJacobian(const mitk::ModelBase* model, const mitk::ModelBase::ParametersType& parameters)
+  {
+    mitk::ModelBase::ModelResultType signal;
+    mitk::ModelBase::JacobianType jacobian;
+    model->GetSignalAndJacobian(parameters, signal, jacobian);
+
+    std::vector<mitk::ModelBase::ParametersType> shiftedParameters;
+    for (unsigned int p = 0; p < parameters.size(); ++p)
+    {
+      const double delta = 1e-6 * std::max(1.0, std::abs(parameters[p]));
+      mitk::ModelBase::ParametersType shifted = parameters;
+      shifted[p] -= delta;
+      shiftedParameters.push_back(shifted);
+      shifted[p] += 2 * delta;
+      shiftedParameters.push_back(shifted);
+    }
+
+    const std::vector<mitk::ModelBase::ModelResultType> signals = model->GetSignals(shiftedParameters);
+    const mitk::ModelBase::ModelResultType reference = model->GetSignal(parameters);
+
+    bool result = jacobian.rows() == signal.size() && jacobian.cols() == parameters.size();
+    for (unsigned int t = 0; result && t < signal.size(); ++t)
+    {
+      result = std::abs(signal[t] - reference[t]) < 1e-12;
+
+      for (unsigned int p = 0; result && p < parameters.size(); ++p)
+      {
+        const double delta = 1e-6 * std::max(1.0, std::abs(parameters[p]));
+        const double numeric = (signals[2 * p + 1][t] - signals[2 * p][t]) / (2 * delta);
+        result = std::abs(numeric - jacobian(t, p)) <= 1e-5 * (1.0 + std::abs(numeric));
+      }
+    }
+    return result;
+  }
+}
+
+int mitkCompartmentODEIntegratorTest(int /*argc*/, char* /*argv*/[])
+{
+  MITK_TEST_BEGIN("CompartmentODEIntegrator")
+
+  // one compartment with constant input: x(t) = 1 - exp(-k*t), which is integrated exactly
+  {
+    mitk::CompartmentODEIntegrator::TimeGridType grid(5);
+    mitk::CompartmentODEIntegrator::InputCurveType input(5, 1.0);
+    for (unsigned int i = 0; i < grid.size(); ++i)
+    {
+      grid[i] = 0.75 + 2.5 * i;
+    }
+
+    mitk::CompartmentODEIntegrator::System system;
+    system.A.set_size(1, 1);
+    system.A(0, 0) = -0.3;
+    system.b.set_size(1);
+    system.b[0] = 0.3;
+
+    const auto prepared = mitk::CompartmentODEIntegrator::PrepareInput(grid, input, 0.5);
+    MITK_TEST_CONDITION(prepared == mitk::CompartmentODEIntegrator::PrepareInput(grid, input, 0.5),
+                        "Testing reuse of prepared input");
+
+    const auto results =
+      mitk::CompartmentODEIntegrator::Integrate(*prepared, std::vector<mitk::CompartmentODEIntegrator::System>(1, system));
+
+    bool exact = results.size() == 1;
+    for (unsigned int j = 0; exact && j < grid.size(); ++j)
+    {
+      // linear interpolation between the steps is exact at the step times only
+      const double t = std::floor(grid[j] / 0.5) * 0.5;
+      const double w = grid[j] / 0.5 - std::floor(grid[j] / 0.5);
+      const double expected = (1 - w) * (1 - std::exp(-0.3 * t)) + w * (1 - std::exp(-0.3 * (t + 0.5)));
+      exact = std::abs(results[0](0, j) - expected) < 1e-12;
+    }
+    MITK_TEST_CONDITION(exact, "Testing exact solution of a one compartment system");
+  }
+
+  // stiff system: fast exchange must not oscillate or blow up
+  {
+    const mitk::ModelBase::TimeGridType grid = GenerateTimeGrid();
+
+    mitk::NumericTwoCompartmentExchangeModel::Pointer model = mitk::NumericTwoCompartmentExchangeModel::New();
+    model->SetTimeGrid(grid);
+    model->SetAterialInputFunctionValues(GenerateAIF(grid));
+    model->SetAterialInputFunctionTimeGrid(grid);
+    model->SetODEINTStepSize(0.5);
+
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60000.0;
+    parameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 60000.0;
+    parameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    parameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    // in equilibrium with the AIF: signal = (vp + ve) * AIF
+    const mitk::ModelBase::ModelResultType signal = model->GetSignal(parameters);
+    const mitk::AIFBasedModelBase::AterialInputFunctionType aif = GenerateAIF(grid);
+    MITK_TEST_CONDITION(std::abs(signal[grid.size() - 1] - 0.35 * aif[grid.size() - 1]) < 1e-3,
+                        "Testing stiff two compartment exchange system");
+  }
+
+  // Jacobians and batched signals of the numeric models
+  {
+    const mitk::ModelBase::TimeGridType grid = GenerateTimeGrid();
+
+    mitk::NumericTwoCompartmentExchangeModel::Pointer exchangeModel = mitk::NumericTwoCompartmentExchangeModel::New();
+    exchangeModel->SetTimeGrid(grid);
+    exchangeModel->SetAterialInputFunctionValues(GenerateAIF(grid));
+    exchangeModel->SetAterialInputFunctionTimeGrid(grid);
+    exchangeModel->SetODEINTStepSize(0.05);
+
+    mitk::ModelBase::ParametersType exchangeParameters(4);
+    exchangeParameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 120.0;
+    exchangeParameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 30.0;
+    exchangeParameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    exchangeParameters[mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    MITK_TEST_CONDITION(exchangeModel->ProvidesJacobian() && CheckJacobian(exchangeModel, exchangeParameters),
+                        "Testing Jacobian of NumericTwoCompartmentExchangeModel");
+
+    mitk::NumericTwoTissueCompartmentModel::Pointer tissueModel = mitk::NumericTwoTissueCompartmentModel::New();
+    tissueModel->SetTimeGrid(grid);
+    tissueModel->SetAterialInputFunctionValues(GenerateAIF(grid));
+    tissueModel->SetAterialInputFunctionTimeGrid(grid);
+
+    mitk::ModelBase::ParametersType tissueParameters(5);
+    tissueParameters[mitk::NumericTwoTissueCompartmentModel::POSITION_PARAMETER_K1] = 0.5;
+    tissueParameters[mitk::NumericTwoTissueCompartmentModel::POSITION_PARAMETER_k2] = 0.3;
+    tissueParameters[mitk::NumericTwoTissueCompartmentModel::POSITION_PARAMETER_k3] = 0.1;
+    tissueParameters[mitk::NumericTwoTissueCompartmentModel::POSITION_PARAMETER_k4] = 0.05;
+    tissueParameters[mitk::NumericTwoTissueCompartmentModel::POSITION_PARAMETER_VB] = 0.1;
+
+    MITK_TEST_CONDITION(tissueModel->ProvidesJacobian() && CheckJacobian(tissueModel, tissueParameters),
+                        "Testing Jacobian of NumericTwoTissueCompartmentModel");
+
+    std::vector<mitk::ModelBase::ParametersType> parameterSets(3, exchangeParameters);
+    parameterSets[1][mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.0;
+    parameterSets[2][mitk::NumericTwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.1;
+
+    const std::vector<mitk::ModelBase::ModelResultType> signals = exchangeModel->GetSignals(parameterSets);
+    bool equal = signals.size() == parameterSets.size();
+    for (std::size_t i = 0; equal && i < parameterSets.size(); ++i)
+    {
+      equal = signals[i] == exchangeModel->GetSignal(parameterSets[i]);
+    }
+    MITK_TEST_CONDITION(equal, "Testing batched signals");
+  }
+
+  MITK_TEST_END()
+}
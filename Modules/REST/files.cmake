@@ -1,6 +1,7 @@
 set(CPP_FILES
   mitkRESTClient.cpp
   mitkRESTServer.cpp
+  mitkRESTWorkerPool.cpp
   mitkIRESTManager.cpp
   mitkIRESTObserver.cpp
 )
@@ -46,6 +46,23 @@ namespace mitk
       Put
     };
 
+    /**
+     * @brief latency statistics of the requests which were received for one observer URI
+     *
+     * Times are given in milliseconds. The queue time is the time between receiving a request and the start of its
+     * handling by a worker thread, the latency is the time between receiving a request and the completion of its
+     * response.
+     */
+    struct RequestStatistics
+    {
+      std::size_t NumberOfRequests = 0;
+      std::size_t NumberOfFailedRequests = 0;
+      std::size_t NumberOfRejectedRequests = 0;
+      double MeanQueueTime = 0.0;
+      double MeanLatency = 0.0;
+      double MaxLatency = 0.0;
+    };
+
     /**
      * @brief Executes a HTTP request in the mitkRESTClient class
      *
@@ -114,16 +131,34 @@ namespace mitk
                                             const web::http::method &method,
                                             const mitk::RESTUtil::ParamMap &headers) = 0;
 
+    /**
+     * @brief Handles an incoming request asynchronously by a worker thread which notifies the observer
+     *
+     * The number of requests which are handled at the same time is limited per observer, see
+     * IRESTObserver::GetMaxConcurrentRequests(). Requests without JSON data are passed as stream to
+     * IRESTObserver::NotifyStream().
+     *
+     * @param uri defines the URI of the request
+     * @param request the incoming request
+     * @return task to wait for with the response
+     */
+    virtual pplx::task<web::http::http_response> HandleAsync(const web::uri &uri,
+                                                             const web::http::http_request &request) = 0;
+
     /**
      * @brief Handles the deletion of an observer for all or a specific uri
      *
+     * If the observer does not handle any uri afterwards, the method blocks until its queued and running requests
+     * are finished. Call it in the destructor of the derived observer, see IRESTObserver::~IRESTObserver().
+     *
      * @param observer the observer which shouldn't receive requests anymore
      * @param uri the uri for which the observer doesn't handle requests anymore (optional)
      */
     virtual void HandleDeleteObserver(IRESTObserver *observer, const web::uri &uri = {}) = 0;
 
     virtual const std::map<int, RESTServer *>& GetServerMap() = 0;
-    virtual const std::map<std::pair<int, utility::string_t>, IRESTObserver *>& GetObservers() = 0;
+    virtual std::map<std::pair<int, utility::string_t>, IRESTObserver *> GetObservers() = 0;
+    virtual std::map<std::pair<int, utility::string_t>, RequestStatistics> GetRequestStatistics() = 0;
 
   };
 }
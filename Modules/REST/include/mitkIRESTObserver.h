@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <cpprest/json.h>
 #include <cpprest/uri.h>
 #include <cpprest/http_client.h>
+#include <cpprest/streams.h>
 
 namespace mitk
 {
@@ -27,6 +28,11 @@ namespace mitk
     /**
      * @brief Deletes an observer and calls HandleDeleteObserver() in RESTManager class
      *
+     * Requests are handled by worker threads. When this destructor runs, the derived observer is destroyed already,
+     * so a request that is handled at the same time would call Notify() on a destroyed object. Derived observers that
+     * may still receive requests therefore have to call HandleDeleteObserver(this) in their own destructor, which
+     * waits for their queued and running requests.
+     *
      * @see HandleDeleteObserver()
      */
     virtual ~IRESTObserver();
@@ -43,6 +49,32 @@ namespace mitk
                                             const web::http::method &method,
                                             const mitk::RESTUtil::ParamMap &headers) = 0;
 
+    /**
+     * @brief Called instead of Notify() if the incoming request does not contain JSON data
+     *
+     * The body is not copied into memory before, so large binary data can be read chunk by chunk while it is
+     * received. Large response data can be streamed as well by setting an input stream as body of the response.
+     * The default implementation ignores the body and calls Notify() with an empty JSON value.
+     *
+     * @param uri the URI of the incoming request
+     * @param body the stream of the request body
+     * @param method the http method of the incoming request
+     * @param headers the http headers of the incoming request
+     * @return the response
+     */
+    virtual web::http::http_response NotifyStream(const web::uri &uri,
+                                                  const concurrency::streams::istream &body,
+                                                  const web::http::method &method,
+                                                  const mitk::RESTUtil::ParamMap &headers);
+
+    /**
+     * @brief Returns the maximum number of requests which are handled by this observer at the same time
+     *
+     * Notify() and NotifyStream() are called from the worker threads of the REST manager. The default of 1 serializes
+     * all requests of the observer. Observers that handle requests in a thread-safe way may return a larger number.
+     */
+    virtual unsigned int GetMaxConcurrentRequests() const;
+
 
   private:
   };
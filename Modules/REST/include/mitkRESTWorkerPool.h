@@ -0,0 +1,81 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRESTWorkerPool_h
+#define mitkRESTWorkerPool_h
+
+#include <MitkRESTExports.h>
+
+#include <functional>
+#include <memory>
+
+namespace mitk
+{
+  /**
+   * @class RESTWorkerPool
+   * @brief Bounded pool of worker threads which executes jobs with a concurrency limit per key.
+   *
+   * Every job is submitted with a key, e.g. the observer which handles a request. At most the given number of jobs
+   * of the same key run at the same time. Further jobs of that key wait in a queue of the key and do not occupy a
+   * worker thread, so a slow key cannot block the jobs of other keys as long as there are free workers.
+   *
+   * The number of waiting jobs of all keys is bounded. Submit() rejects a job instead of blocking the caller if the
+   * bound is reached.
+   */
+  class MITKREST_EXPORT RESTWorkerPool
+  {
+  public:
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Starts the worker threads
+     *
+     * @param numberOfThreads the number of worker threads, 0 selects the number of hardware threads but at least 4
+     * @param maxQueuedJobs the maximum number of jobs which wait for a worker thread
+     */
+    RESTWorkerPool(unsigned int numberOfThreads, std::size_t maxQueuedJobs);
+
+    /**
+     * @brief Executes all queued jobs and joins the worker threads
+     */
+    ~RESTWorkerPool();
+
+    unsigned int GetNumberOfThreads() const;
+    std::size_t GetMaxQueuedJobs() const;
+    std::size_t GetNumberOfQueuedJobs() const;
+
+    /**
+     * @brief Queues a job for execution by a worker thread
+     *
+     * Exceptions thrown by the job are logged and do not terminate the worker thread.
+     *
+     * @param key the key which identifies the jobs that share the concurrency limit
+     * @param maxConcurrentJobs the maximum number of jobs of the key which run at the same time, at least 1
+     * @param job the job
+     * @return false if the job was rejected since the maximum number of queued jobs is reached
+     */
+    bool Submit(const void *key, unsigned int maxConcurrentJobs, Job job);
+
+    /**
+     * @brief Blocks until all running and queued jobs of the given key are finished
+     *
+     * Returns immediately if called from a job of the same key, since it would wait for itself.
+     */
+    void WaitForIdle(const void *key);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> m_Impl;
+  };
+}
+
+#endif
@@ -27,3 +27,16 @@ mitk::IRESTObserver::~IRESTObserver()
       manager->HandleDeleteObserver(this);
   }
 }
+
+web::http::http_response mitk::IRESTObserver::NotifyStream(const web::uri &uri,
+                                                           const concurrency::streams::istream &,
+                                                           const web::http::method &method,
+                                                           const mitk::RESTUtil::ParamMap &headers)
+{
+  return this->Notify(uri, web::json::value(), method, headers);
+}
+
+unsigned int mitk::IRESTObserver::GetMaxConcurrentRequests() const
+{
+  return 1;
+}
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIRESTManager.h>
+#include <mitkLogMacros.h>
 #include <mitkRESTServer.h>
 
 #include <usGetModuleContext.h>
@@ -49,40 +50,44 @@ namespace mitk
     web::uri_builder builder(this->listener.uri());
     builder.append(request.absolute_uri());
 
-    auto uriString = builder.to_uri().to_string();
-
-    http_response response(status_codes::InternalError);
-    response.set_body(U("There went something wrong after receiving the request."));
-
     auto context = us::GetModuleContext();
     auto managerRef = context->GetServiceReference<IRESTManager>();
+    auto manager = managerRef ? context->GetService(managerRef) : nullptr;
 
-    if (managerRef)
+    if (nullptr == manager)
     {
-      auto manager = context->GetService(managerRef);
-      if (manager)
+      http_response response(status_codes::InternalError);
+      response.set_body(U("There went something wrong after receiving the request."));
+      request.reply(response);
+      return;
+    }
+
+    // The request is handled by a worker thread of the manager and the response is sent when it is completed,
+    // so the listener is not blocked by slow observers
+    manager->HandleAsync(builder.to_uri(), request).then([request](pplx::task<http_response> responseTask) {
+      http_response response(status_codes::InternalError);
+      response.set_body(U("There went something wrong after receiving the request."));
+
+      try
+      {
+        response = responseTask.get();
+      }
+      catch (const std::exception &e)
       {
-        // not every request contains JSON data
-        web::json::value data = {};
-        if (request.headers().content_type() == U("application/json"))
+        MITK_ERROR << "Handling the request failed: " << e.what();
+      }
+
+      request.reply(response).then([](pplx::task<void> replyTask) {
+        try
         {
-          data = request.extract_json().get();
+          replyTask.get();
         }
-
-        mitk::RESTUtil::ParamMap headers;
-        auto begin = request.headers().begin();
-        auto end = request.headers().end();
-
-        for (; begin != end; ++begin)
+        catch (const std::exception &e)
         {
-          headers.insert(mitk::RESTUtil::ParamMap::value_type(begin->first, begin->second));
+          MITK_WARN << "Sending the response failed: " << e.what();
         }
-
-        response = manager->Handle(builder.to_uri(), data, request.method(), headers);
-      }
-    }
-
-    request.reply(response);
+      });
+    });
   }
 } // namespace mitk
 
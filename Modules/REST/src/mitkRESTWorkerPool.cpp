@@ -0,0 +1,192 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRESTWorkerPool.h>
+
+#include <mitkLogMacros.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // key of the job which is executed by the current worker thread
+  thread_local const void *CurrentKey = nullptr;
+}
+
+namespace mitk
+{
+  class RESTWorkerPool::Impl
+  {
+  public:
+    struct KeyState
+    {
+      unsigned int NumberOfRunningJobs = 0;
+      unsigned int MaxConcurrentJobs = 1;
+      std::deque<Job> WaitingJobs;
+    };
+
+    void Work();
+
+    std::size_t MaxQueuedJobs;
+    std::size_t NumberOfQueuedJobs = 0;
+    bool Stop = false;
+
+    // jobs whose key had a free slot, in the order they may be executed
+    std::deque<std::pair<const void *, Job>> ReadyJobs;
+    std::map<const void *, KeyState> KeyStates;
+
+    mutable std::mutex Mutex;
+    std::condition_variable JobReady;
+    std::condition_variable JobFinished;
+    std::vector<std::thread> Threads;
+  };
+
+  void RESTWorkerPool::Impl::Work()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+
+    while (true)
+    {
+      this->JobReady.wait(lock, [this] { return this->Stop || !this->ReadyJobs.empty(); });
+
+      // the pool is only stopped after all jobs were executed
+      if (this->ReadyJobs.empty())
+        return;
+
+      auto key = this->ReadyJobs.front().first;
+      auto job = std::move(this->ReadyJobs.front().second);
+      this->ReadyJobs.pop_front();
+      --this->NumberOfQueuedJobs;
+
+      lock.unlock();
+      CurrentKey = key;
+
+      try
+      {
+        job();
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "REST worker job failed: " << e.what();
+      }
+      catch (...)
+      {
+        MITK_ERROR << "REST worker job failed with an unknown exception";
+      }
+
+      CurrentKey = nullptr;
+      lock.lock();
+
+      auto keyState = this->KeyStates.find(key);
+      --keyState->second.NumberOfRunningJobs;
+
+      // the slot of the finished job is handed over to the next waiting job of the same key
+      if (!keyState->second.WaitingJobs.empty() &&
+          keyState->second.NumberOfRunningJobs < keyState->second.MaxConcurrentJobs)
+      {
+        ++keyState->second.NumberOfRunningJobs;
+        this->ReadyJobs.emplace_back(key, std::move(keyState->second.WaitingJobs.front()));
+        keyState->second.WaitingJobs.pop_front();
+        this->JobReady.notify_one();
+      }
+      else if (0 == keyState->second.NumberOfRunningJobs && keyState->second.WaitingJobs.empty())
+      {
+        this->KeyStates.erase(keyState);
+      }
+
+      this->JobFinished.notify_all();
+    }
+  }
+} // namespace mitk
+
+mitk::RESTWorkerPool::RESTWorkerPool(unsigned int numberOfThreads, std::size_t maxQueuedJobs)
+  : m_Impl{std::make_unique<Impl>()}
+{
+  // handling a request mostly waits for I/O, so there are at least a few workers even on small machines
+  if (0 == numberOfThreads)
+    numberOfThreads = std::max(4u, std::thread::hardware_concurrency());
+
+  m_Impl->MaxQueuedJobs = maxQueuedJobs;
+
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+    m_Impl->Threads.emplace_back(&Impl::Work, m_Impl.get());
+}
+
+mitk::RESTWorkerPool::~RESTWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+    m_Impl->Stop = true;
+  }
+
+  m_Impl->JobReady.notify_all();
+
+  for (auto &thread : m_Impl->Threads)
+    thread.join();
+}
+
+unsigned int mitk::RESTWorkerPool::GetNumberOfThreads() const
+{
+  return static_cast<unsigned int>(m_Impl->Threads.size());
+}
+
+std::size_t mitk::RESTWorkerPool::GetMaxQueuedJobs() const
+{
+  return m_Impl->MaxQueuedJobs;
+}
+
+std::size_t mitk::RESTWorkerPool::GetNumberOfQueuedJobs() const
+{
+  std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+  return m_Impl->NumberOfQueuedJobs;
+}
+
+bool mitk::RESTWorkerPool::Submit(const void *key, unsigned int maxConcurrentJobs, Job job)
+{
+  std::lock_guard<std::mutex> lock(m_Impl->Mutex);
+
+  if (m_Impl->Stop || m_Impl->NumberOfQueuedJobs >= m_Impl->MaxQueuedJobs)
+    return false;
+
+  ++m_Impl->NumberOfQueuedJobs;
+
+  auto &keyState = m_Impl->KeyStates[key];
+  keyState.MaxConcurrentJobs = std::max(1u, maxConcurrentJobs);
+
+  if (keyState.NumberOfRunningJobs < keyState.MaxConcurrentJobs)
+  {
+    ++keyState.NumberOfRunningJobs;
+    m_Impl->ReadyJobs.emplace_back(key, std::move(job));
+    m_Impl->JobReady.notify_one();
+  }
+  else
+  {
+    keyState.WaitingJobs.push_back(std::move(job));
+  }
+
+  return true;
+}
+
+void mitk::RESTWorkerPool::WaitForIdle(const void *key)
+{
+  if (nullptr != CurrentKey && key == CurrentKey)
+    return;
+
+  std::unique_lock<std::mutex> lock(m_Impl->Mutex);
+  m_Impl->JobFinished.wait(lock, [this, key] { return 0 == m_Impl->KeyStates.count(key); });
+}
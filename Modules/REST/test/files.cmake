@@ -1,4 +1,5 @@
 set(MODULE_TESTS
   mitkRESTClientTest.cpp
   mitkRESTServerTest.cpp
+  mitkRESTWorkerPoolTest.cpp
 )
\ No newline at end of file
@@ -27,6 +27,82 @@ found in the LICENSE file.
 
 #include <vtkDebugLeaks.h>
 
+#include <cpprest/containerstream.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+  // Observer that keeps each request busy for a while and records how many requests it handled at the same time
+  class ConcurrentObserver : public mitk::IRESTObserver
+  {
+  public:
+    explicit ConcurrentObserver(unsigned int maxConcurrentRequests)
+      : m_MaxConcurrentRequests(maxConcurrentRequests), m_NumberOfRunningRequests(0), m_MaxNumberOfRunningRequests(0)
+    {
+    }
+
+    web::http::http_response Notify(const web::uri &,
+                                    const web::json::value &,
+                                    const web::http::method &,
+                                    const mitk::RESTUtil::ParamMap &) override
+    {
+      auto running = ++m_NumberOfRunningRequests;
+      auto max = m_MaxNumberOfRunningRequests.load();
+      while (running > max && !m_MaxNumberOfRunningRequests.compare_exchange_weak(max, running))
+      {
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      --m_NumberOfRunningRequests;
+
+      auto response = web::http::http_response(web::http::status_codes::OK);
+      response.set_body(web::json::value::object());
+      return response;
+    }
+
+    unsigned int GetMaxConcurrentRequests() const override { return m_MaxConcurrentRequests; }
+
+    int GetMaxNumberOfRunningRequests() const { return m_MaxNumberOfRunningRequests; }
+
+  private:
+    unsigned int m_MaxConcurrentRequests;
+    std::atomic<int> m_NumberOfRunningRequests;
+    std::atomic<int> m_MaxNumberOfRunningRequests;
+  };
+
+  // Observer that reads binary request bodies from the stream and responds with the number of received bytes
+  class StreamObserver : public mitk::IRESTObserver
+  {
+  public:
+    web::http::http_response Notify(const web::uri &,
+                                    const web::json::value &,
+                                    const web::http::method &,
+                                    const mitk::RESTUtil::ParamMap &) override
+    {
+      return web::http::http_response(web::http::status_codes::BadRequest);
+    }
+
+    web::http::http_response NotifyStream(const web::uri &,
+                                          const concurrency::streams::istream &body,
+                                          const web::http::method &,
+                                          const mitk::RESTUtil::ParamMap &) override
+    {
+      concurrency::streams::container_buffer<std::vector<uint8_t>> buffer;
+      body.read_to_end(buffer).wait();
+
+      web::json::value data;
+      data[U("size")] = web::json::value(static_cast<int>(buffer.collection().size()));
+
+      auto response = web::http::http_response(web::http::status_codes::OK);
+      response.set_body(data);
+      return response;
+    }
+  };
+}
+
 class mitkRESTServerTestSuite : public mitk::TestFixture, mitk::IRESTObserver
 {
   CPPUNIT_TEST_SUITE(mitkRESTServerTestSuite);
@@ -40,6 +116,8 @@ class mitkRESTServerTestSuite : public mitk::TestFixture, mitk::IRESTObserver
   MITK_TEST(OpenListenerGetRequestDifferentPath_ReturnNotFound);
   MITK_TEST(OpenListenerCloseAndReopen_Succeed);
   MITK_TEST(HandleHeader_Succeed);
+  MITK_TEST(ConcurrentRequests_HandledUpToObserverLimit);
+  MITK_TEST(BinaryRequest_BodyIsStreamedToObserver);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -247,6 +325,72 @@ public:
       }
     });
   }
+
+  void ConcurrentRequests_HandledUpToObserverLimit()
+  {
+    ConcurrentObserver observer(3);
+    m_Service->ReceiveRequest(U("http://localhost:8080/concurrenttest"), &observer);
+
+    std::atomic<int> count(0);
+    std::vector<pplx::task<void>> tasks;
+    for (int i = 0; i < 6; ++i)
+    {
+      tasks.emplace_back(m_Service->SendRequest(U("http://localhost:8080/concurrenttest"))
+                           .then([&](pplx::task<web::json::value> resultTask) {
+                             try
+                             {
+                               resultTask.get();
+                               ++count;
+                             }
+                             catch (const mitk::Exception &exception)
+                             {
+                               MITK_ERROR << exception.what();
+                             }
+                           }));
+    }
+    pplx::when_all(begin(tasks), end(tasks)).wait();
+
+    auto statistics = m_Service->GetRequestStatistics()[std::make_pair(8080, utility::string_t(U("/concurrenttest")))];
+    m_Service->HandleDeleteObserver(&observer);
+
+    CPPUNIT_ASSERT_MESSAGE("All requests were answered", 6 == count);
+    CPPUNIT_ASSERT_MESSAGE("Requests were handled at the same time", 1 < observer.GetMaxNumberOfRunningRequests());
+    CPPUNIT_ASSERT_MESSAGE("Observer limit was respected", 3 >= observer.GetMaxNumberOfRunningRequests());
+    CPPUNIT_ASSERT_MESSAGE("All requests are counted", 6 == statistics.NumberOfRequests);
+    CPPUNIT_ASSERT_MESSAGE("No request failed", 0 == statistics.NumberOfFailedRequests);
+    CPPUNIT_ASSERT_MESSAGE("Latency covers the handling time", 100.0 <= statistics.MaxLatency);
+  }
+
+  void BinaryRequest_BodyIsStreamedToObserver()
+  {
+    StreamObserver observer;
+    m_Service->ReceiveRequest(U("http://localhost:8080/streamtest"), &observer);
+
+    std::vector<unsigned char> content(1 << 20);
+    for (std::size_t i = 0; i < content.size(); ++i)
+      content[i] = static_cast<unsigned char>(i);
+
+    web::json::value result;
+    m_Service
+      ->SendBinaryRequest(U("http://localhost:8080/streamtest"), mitk::IRESTManager::RequestType::Post, &content)
+      .then([&](pplx::task<web::json::value> resultTask) {
+        try
+        {
+          result = resultTask.get();
+        }
+        catch (const mitk::Exception &exception)
+        {
+          MITK_ERROR << exception.what();
+        }
+      })
+      .wait();
+
+    m_Service->HandleDeleteObserver(&observer);
+
+    CPPUNIT_ASSERT_MESSAGE("Observer received a response", result.has_field(U("size")));
+    CPPUNIT_ASSERT_MESSAGE("Observer received the whole body",
+                           static_cast<int>(content.size()) == result[U("size")].as_integer());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkRESTServer)
@@ -0,0 +1,136 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkRESTWorkerPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+class mitkRESTWorkerPoolTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRESTWorkerPoolTestSuite);
+  MITK_TEST(JobsOfOneKey_RespectConcurrencyLimit);
+  MITK_TEST(JobsOfDifferentKeys_RunConcurrently);
+  MITK_TEST(FullQueue_RejectsJobs);
+  MITK_TEST(ThrowingJob_WorkerContinues);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  // Waits until the flag is set, but not forever to let a failing test finish
+  static bool WaitFor(const std::atomic<bool> &flag)
+  {
+    for (int i = 0; i < 500 && !flag; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    return flag;
+  }
+
+  void JobsOfOneKey_RespectConcurrencyLimit()
+  {
+    mitk::RESTWorkerPool pool(4, 100);
+    int key = 0;
+
+    std::atomic<int> numberOfRunningJobs(0);
+    std::atomic<int> maxNumberOfRunningJobs(0);
+    std::atomic<int> numberOfFinishedJobs(0);
+
+    for (int i = 0; i < 8; ++i)
+    {
+      auto submitted = pool.Submit(&key, 2, [&]() {
+        auto running = ++numberOfRunningJobs;
+        auto max = maxNumberOfRunningJobs.load();
+        while (running > max && !maxNumberOfRunningJobs.compare_exchange_weak(max, running))
+        {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --numberOfRunningJobs;
+        ++numberOfFinishedJobs;
+      });
+
+      CPPUNIT_ASSERT_MESSAGE("Job is accepted", submitted);
+    }
+
+    pool.WaitForIdle(&key);
+
+    CPPUNIT_ASSERT_MESSAGE("All jobs are finished", 8 == numberOfFinishedJobs);
+    CPPUNIT_ASSERT_MESSAGE("At most two jobs of the key ran at the same time", 2 >= maxNumberOfRunningJobs);
+    CPPUNIT_ASSERT_MESSAGE("Nothing is queued anymore", 0 == pool.GetNumberOfQueuedJobs());
+  }
+
+  void JobsOfDifferentKeys_RunConcurrently()
+  {
+    mitk::RESTWorkerPool pool(2, 100);
+    int slowKey = 0;
+    int fastKey = 0;
+
+    std::atomic<bool> fastJobFinished(false);
+    std::atomic<bool> slowJobSawFastJob(false);
+
+    // the slow job only finishes early if the fast job of the other key is not blocked by it
+    pool.Submit(&slowKey, 1, [&]() { slowJobSawFastJob = WaitFor(fastJobFinished); });
+    pool.Submit(&fastKey, 1, [&]() { fastJobFinished = true; });
+
+    pool.WaitForIdle(&slowKey);
+    pool.WaitForIdle(&fastKey);
+
+    CPPUNIT_ASSERT_MESSAGE("Job of another key ran while the first job was running", slowJobSawFastJob);
+  }
+
+  void FullQueue_RejectsJobs()
+  {
+    mitk::RESTWorkerPool pool(1, 2);
+    int key = 0;
+
+    std::atomic<bool> started(false);
+    std::atomic<bool> released(false);
+
+    pool.Submit(&key, 1, [&]() {
+      started = true;
+      WaitFor(released);
+    });
+
+    CPPUNIT_ASSERT_MESSAGE("Blocking job is started", WaitFor(started));
+
+    CPPUNIT_ASSERT_MESSAGE("First waiting job is accepted", pool.Submit(&key, 1, []() {}));
+    CPPUNIT_ASSERT_MESSAGE("Second waiting job is accepted", pool.Submit(&key, 1, []() {}));
+    CPPUNIT_ASSERT_MESSAGE("Third waiting job is rejected", !pool.Submit(&key, 1, []() {}));
+    CPPUNIT_ASSERT_MESSAGE("Two jobs are queued", 2 == pool.GetNumberOfQueuedJobs());
+
+    released = true;
+    pool.WaitForIdle(&key);
+
+    CPPUNIT_ASSERT_MESSAGE("Job is accepted again after the queue was drained", pool.Submit(&key, 1, []() {}));
+    pool.WaitForIdle(&key);
+  }
+
+  void ThrowingJob_WorkerContinues()
+  {
+    mitk::RESTWorkerPool pool(1, 10);
+    int key = 0;
+
+    std::atomic<bool> finished(false);
+
+    pool.Submit(&key, 1, []() { throw std::runtime_error("job failed"); });
+    pool.Submit(&key, 1, [&]() { finished = true; });
+    pool.WaitForIdle(&key);
+
+    CPPUNIT_ASSERT_MESSAGE("Job after a throwing job is executed", finished);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRESTWorkerPool)
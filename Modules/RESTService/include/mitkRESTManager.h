@@ -16,6 +16,10 @@ found in the LICENSE file.
 #include <MitkRESTServiceExports.h>
 #include <mitkIRESTManager.h>
 #include <mitkRESTUtil.h>
+#include <mitkRESTWorkerPool.h>
+
+#include <chrono>
+#include <mutex>
 
 namespace mitk
 {
@@ -102,9 +106,25 @@ namespace mitk
                                     const web::http::method &method,
                                     const mitk::RESTUtil::ParamMap &headers) override;
 
+    /**
+     * @brief Handles an incoming request asynchronously by a worker thread which notifies the observer
+     *
+     * Requests are rejected with status code 503 if the queue of the worker pool is full.
+     *
+     * @param uri defines the URI of the request
+     * @param request the incoming request
+     * @return task to wait for with the response
+     */
+    pplx::task<web::http::http_response> HandleAsync(const web::uri &uri,
+                                                     const web::http::http_request &request) override;
+
     /**
      * @brief Handles the deletion of an observer for all or a specific uri
      *
+     * If the observer does not handle any uri afterwards, the method blocks until its queued and running requests
+     * are finished. Afterwards the observer can be destroyed safely, which is why derived observers have to call this
+     * method in their own destructor: the call in IRESTObserver::~IRESTObserver() comes too late.
+     *
      * @param observer the observer which shouldn't receive requests anymore
      * @param uri the uri for which the observer doesn't handle requests anymore (optional)
      */
@@ -114,7 +134,8 @@ namespace mitk
      * @brief internal use only
      */
     const std::map<int, RESTServer *> &GetServerMap() override;
-    std::map<std::pair<int, utility::string_t>, IRESTObserver *> &GetObservers() override;
+    std::map<std::pair<int, utility::string_t>, IRESTObserver *> GetObservers() override;
+    std::map<std::pair<int, utility::string_t>, RequestStatistics> GetRequestStatistics() override;
 
   private:
     /**
@@ -145,8 +166,31 @@ namespace mitk
     void DeleteFromServerMap(const int port);
     void SetObservers(const std::pair<int, utility::string_t> key, IRESTObserver *observer);
 
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief notifies the observer about the request, called by a worker thread
+     *
+     * @return the response of the observer or an error response if the observer was deleted in the meantime
+     */
+    web::http::http_response NotifyObserver(const web::uri &uri,
+                                            const web::http::http_request &request,
+                                            IRESTObserver *observer);
+
+    void UpdateStatistics(const std::pair<int, utility::string_t> &key,
+                          Clock::time_point receiveTime,
+                          Clock::time_point startTime,
+                          bool failed);
+
     std::map<int, RESTServer *> m_ServerMap;                                  // Map with port server pairs
     std::map<std::pair<int, utility::string_t>, IRESTObserver *> m_Observers; // Map with all observers
+    std::map<std::pair<int, utility::string_t>, RequestStatistics> m_RequestStatistics;
+
+    // Guards the observer map against the worker threads, which only read it, and the request statistics
+    std::mutex m_Mutex;
+
+    // Declared last to be destroyed first, since queued requests refer to the other members
+    std::unique_ptr<RESTWorkerPool> m_WorkerPool;
   };
 } // namespace mitk
 
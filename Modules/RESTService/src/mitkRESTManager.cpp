@@ -18,7 +18,24 @@ found in the LICENSE file.
 #include <mitkExceptionMacro.h>
 #include <mitkLogMacros.h>
 
-mitk::RESTManager::RESTManager() {}
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  // Maximum number of received requests which wait for a worker thread
+  const std::size_t MaxQueuedRequests = 256;
+
+  web::http::http_response CreateNoObserverResponse()
+  {
+    MITK_WARN << "No Observer can handle the data";
+    web::http::http_response response(web::http::status_codes::BadGateway);
+    response.set_body(U("No one can handle the request under the given port."));
+    return response;
+  }
+}
+
+mitk::RESTManager::RESTManager() : m_WorkerPool{std::make_unique<RESTWorkerPool>(0, MaxQueuedRequests)} {}
 
 mitk::RESTManager::~RESTManager() {}
 
@@ -134,41 +151,154 @@ web::http::http_response mitk::RESTManager::Handle(const web::uri &uri,
 {
   // Checking if there is an observer for the port and path
   auto key = std::make_pair(uri.port(), uri.path());
-  if (0 != m_Observers.count(key))
+  IRESTObserver *observer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto observerPos = m_Observers.find(key);
+    if (observerPos != m_Observers.end())
+      observer = observerPos->second;
+  }
+
+  if (nullptr != observer)
   {
-    return m_Observers[key]->Notify(uri, body, method, headers);
+    return observer->Notify(uri, body, method, headers);
   }
   // No observer under this port, return null which results in status code 404 (s. RESTServer)
   else
   {
-    MITK_WARN << "No Observer can handle the data";
-    web::http::http_response response(web::http::status_codes::BadGateway);
-    response.set_body(U("No one can handle the request under the given port."));
+    return CreateNoObserverResponse();
+  }
+}
+
+pplx::task<web::http::http_response> mitk::RESTManager::HandleAsync(const web::uri &uri,
+                                                                    const web::http::http_request &request)
+{
+  auto receiveTime = Clock::now();
+  auto key = std::make_pair(uri.port(), uri.path());
+  pplx::task_completion_event<web::http::http_response> responseEvent;
+
+  // The observer is looked up and its request is queued under the same lock, so HandleDeleteObserver() either
+  // removes the observer before or waits for the request to be finished
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  auto observerPos = m_Observers.find(key);
+  if (observerPos == m_Observers.end())
+  {
+    lock.unlock();
+    return pplx::task_from_result(CreateNoObserverResponse());
+  }
+
+  auto observer = observerPos->second;
+  auto job = [this, uri, request, key, observer, receiveTime, responseEvent]() {
+    auto startTime = Clock::now();
+    auto response = this->NotifyObserver(uri, request, observer);
+    this->UpdateStatistics(key, receiveTime, startTime, response.status_code() >= 500);
+    responseEvent.set(response);
+  };
+
+  if (!m_WorkerPool->Submit(observer, observer->GetMaxConcurrentRequests(), job))
+  {
+    ++m_RequestStatistics[key].NumberOfRejectedRequests;
+    lock.unlock();
+
+    MITK_WARN << "Too many requests are queued, rejecting request for " << RESTUtil::convertToUtf8(uri.to_string());
+    web::http::http_response response(web::http::status_codes::ServiceUnavailable);
+    response.set_body(U("Too many requests are waiting to be handled."));
+    return pplx::task_from_result(response);
+  }
+
+  return pplx::create_task(responseEvent);
+}
+
+web::http::http_response mitk::RESTManager::NotifyObserver(const web::uri &uri,
+                                                           const web::http::http_request &request,
+                                                           IRESTObserver *observer)
+{
+  {
+    // the observer may have been deleted for this uri while the request was queued
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto observerPos = m_Observers.find(std::make_pair(uri.port(), uri.path()));
+    if (observerPos == m_Observers.end() || observerPos->second != observer)
+      return CreateNoObserverResponse();
+  }
+
+  mitk::RESTUtil::ParamMap headers;
+  for (const auto &header : request.headers())
+  {
+    headers.insert(mitk::RESTUtil::ParamMap::value_type(header.first, header.second));
+  }
+
+  try
+  {
+    // not every request contains JSON data, other bodies are passed as stream without copying them
+    if (request.headers().content_type() == U("application/json"))
+    {
+      auto data = request.extract_json().get();
+      return observer->Notify(uri, data, request.method(), headers);
+    }
+
+    return observer->NotifyStream(uri, request.body(), request.method(), headers);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Handling the request for " << RESTUtil::convertToUtf8(uri.to_string()) << " failed: " << e.what();
+    web::http::http_response response(web::http::status_codes::InternalError);
+    response.set_body(U("There went something wrong after receiving the request."));
     return response;
   }
 }
 
+void mitk::RESTManager::UpdateStatistics(const std::pair<int, utility::string_t> &key,
+                                         Clock::time_point receiveTime,
+                                         Clock::time_point startTime,
+                                         bool failed)
+{
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  auto endTime = Clock::now();
+  auto queueTime = Milliseconds(startTime - receiveTime).count();
+  auto latency = Milliseconds(endTime - receiveTime).count();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto &statistics = m_RequestStatistics[key];
+
+  // running means, so no sample has to be stored
+  ++statistics.NumberOfRequests;
+  auto n = static_cast<double>(statistics.NumberOfRequests);
+  statistics.MeanQueueTime += (queueTime - statistics.MeanQueueTime) / n;
+  statistics.MeanLatency += (latency - statistics.MeanLatency) / n;
+  statistics.MaxLatency = std::max(statistics.MaxLatency, latency);
+
+  if (failed)
+    ++statistics.NumberOfFailedRequests;
+}
+
 void mitk::RESTManager::HandleDeleteObserver(IRESTObserver *observer, const web::uri &uri)
 {
-  for (auto it = m_Observers.begin(); it != m_Observers.end();)
+  std::vector<int> portsWithoutObserver;
+  bool observerDeleted = true;
   {
-    mitk::IRESTObserver *obsMap = it->second;
-    // Check wether observer is at this place in map
-    if (observer == obsMap)
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_Observers.begin(); it != m_Observers.end();)
     {
-      // Check wether it is the right uri to be deleted
-      if (uri.is_empty() || uri.path() == it->first.second)
+      mitk::IRESTObserver *obsMap = it->second;
+      // Check wether observer is at this place in map
+      if (observer == obsMap)
       {
-        int port = it->first.first;
-        bool noObserverForPort = this->DeleteObserver(it);
-        if (noObserverForPort)
+        // Check wether it is the right uri to be deleted
+        if (uri.is_empty() || uri.path() == it->first.second)
+        {
+          int port = it->first.first;
+          bool noObserverForPort = this->DeleteObserver(it);
+          if (noObserverForPort)
+          {
+            //  there isn't an observer at this port, delete m_ServerMap entry for this port
+            portsWithoutObserver.push_back(port);
+          }
+        }
+        else
         {
-          //  there isn't an observer at this port, delete m_ServerMap entry for this port
-          // close listener
-          m_ServerMap[port]->CloseListener();
-          delete m_ServerMap[port];
-          // delete server from map
-          m_ServerMap.erase(port);
+          observerDeleted = false;
+          ++it;
         }
       }
       else
@@ -176,10 +306,19 @@ void mitk::RESTManager::HandleDeleteObserver(IRESTObserver *observer, const web:
         ++it;
       }
     }
-    else
-    {
-      ++it;
-    }
+  }
+
+  // the observer may be destroyed after this method returns, so its queued and running requests are finished first
+  if (observerDeleted)
+    m_WorkerPool->WaitForIdle(observer);
+
+  for (auto port : portsWithoutObserver)
+  {
+    // close listener
+    m_ServerMap[port]->CloseListener();
+    delete m_ServerMap[port];
+    // delete server from map
+    m_ServerMap.erase(port);
   }
 }
 
@@ -188,15 +327,24 @@ const std::map<int, mitk::RESTServer *> &mitk::RESTManager::GetServerMap()
   return m_ServerMap;
 }
 
-std::map<std::pair<int, utility::string_t>, mitk::IRESTObserver *> &mitk::RESTManager::GetObservers()
+std::map<std::pair<int, utility::string_t>, mitk::IRESTObserver *> mitk::RESTManager::GetObservers()
 {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   return m_Observers;
 }
 
+std::map<std::pair<int, utility::string_t>, mitk::IRESTManager::RequestStatistics> mitk::RESTManager::
+  GetRequestStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_RequestStatistics;
+}
+
 void mitk::RESTManager::AddObserver(const web::uri &uri, IRESTObserver *observer)
 {
   // new observer has to be added
   std::pair<int, utility::string_t> key(uri.port(), uri.path());
+  std::lock_guard<std::mutex> lock(m_Mutex);
   m_Observers[key] = observer;
 }
 
@@ -254,5 +402,6 @@ void mitk::RESTManager::DeleteFromServerMap(const int port)
 
 void mitk::RESTManager::SetObservers(const std::pair<int, utility::string_t> key, IRESTObserver *observer)
 {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   m_Observers[key] = observer;
 }
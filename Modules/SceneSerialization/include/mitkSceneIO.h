@@ -18,13 +18,12 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkNodePredicateBase.h"
 
-#include <Poco/Zip/ZipLocalFileHeader.h>
-
 class TiXmlElement;
 
 namespace mitk
 {
   class BaseData;
+  class BaseDataSerializer;
   class PropertyList;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
@@ -111,6 +110,25 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Number of threads used for (de)serializing the data of independent nodes and for extracting archive
+     * entries.
+     *
+     * 0 (the default) uses one thread per available core, 1 reads and writes scenes sequentially.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * \brief Archive entries of at least this size (in bytes) are stored without further compression.
+     *
+     * The files written by the data serializers (e.g. compressed nrrd images or vtp surfaces) are usually
+     * compressed by their writers already. Deflating them a second time is slow for large images and hardly
+     * reduces the archive size. Default is 1 MiB; 0 stores all entries uncompressed.
+     */
+    itkSetMacro(StoreUncompressedThreshold, unsigned long long);
+    itkGetConstMacro(StoreUncompressedThreshold, unsigned long long);
+
   protected:
     SceneIO();
     ~SceneIO() override;
@@ -120,14 +138,32 @@ namespace mitk
     TiXmlElement *SaveBaseData(BaseData *data, const std::string &filenamehint, bool &error);
     TiXmlElement *SavePropertyList(PropertyList *propertyList, const std::string &filenamehint);
 
-    void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
-    void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
+    /**
+     * \brief Creates and configures the serializer for data, nullptr if there is none.
+     *
+     * Serializers are created sequentially and can then be run concurrently.
+     */
+    itk::SmartPointer<BaseDataSerializer> CreateBaseDataSerializer(BaseData *data, const std::string &filenamehint);
+
+    /**
+     * \brief Extracts all entries of a scene archive to the working directory, using NumberOfThreads threads.
+     * \return the number of entries that could not be extracted.
+     */
+    unsigned int ExtractArchive(const std::string &filename);
+
+    /**
+     * \brief Writes all files of the working directory into a scene archive.
+     */
+    void WriteArchive(const std::string &filename);
 
     FailedBaseDataListType::Pointer m_FailedNodes;
     PropertyList::Pointer m_FailedProperties;
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+
+    unsigned int m_NumberOfThreads;
+    unsigned long long m_StoreUncompressedThreshold;
   };
 }
 
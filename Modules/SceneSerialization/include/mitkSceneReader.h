@@ -28,5 +28,16 @@ namespace mitk
     itkCloneMacro(Self);
 
       virtual bool LoadScene(TiXmlDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+      \brief Number of threads used to read the data of independent nodes, 0 (the default) uses all cores.
+    */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+  protected:
+    SceneReader();
+
+    unsigned int m_NumberOfThreads;
   };
 }
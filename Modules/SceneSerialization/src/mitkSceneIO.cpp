@@ -10,11 +10,14 @@ found in the LICENSE file.
 
 ============================================================================*/
 
-#include <Poco/Delegate.h>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
 #include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
-#include <Poco/Zip/Decompress.h>
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipStream.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
@@ -25,7 +28,9 @@ found in the LICENSE file.
 #include "mitkProgressBar.h"
 #include "mitkRenderingManager.h"
 #include "mitkStandaloneDataStorage.h"
+#include <mitkExceptionMacro.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkParallelFor.h>
 #include <mitkStandardFileLocations.h>
 
 #include <itkObjectFactoryBase.h>
@@ -34,11 +39,51 @@ found in the LICENSE file.
 
 #include <fstream>
 #include <mitkIOUtil.h>
+#include <mutex>
 #include <sstream>
 
 #include "itksys/SystemTools.hxx"
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  /** Recursively collects all files below directory, as paths relative to it. */
+  void CollectFiles(const Poco::Path &directory, const Poco::Path &relativeDirectory, std::vector<Poco::Path> &files)
+  {
+    for (Poco::DirectoryIterator iter(directory), end; iter != end; ++iter)
+    {
+      if (iter->isDirectory())
+      {
+        Poco::Path subdirectory(relativeDirectory);
+        subdirectory.pushDirectory(iter.name());
+        CollectFiles(Poco::Path(iter.path()).makeDirectory(), subdirectory, files);
+      }
+      else
+      {
+        Poco::Path file(relativeDirectory);
+        file.setFileName(iter.name());
+        files.push_back(file);
+      }
+    }
+  }
+
+  /** Archive entries must stay inside the extraction directory. */
+  bool IsSafeEntryName(const Poco::Path &entry)
+  {
+    if (entry.isAbsolute() || !entry.getDevice().empty())
+      return false;
+
+    for (int i = 0; i < entry.depth(); ++i)
+    {
+      if (entry[i] == "..")
+        return false;
+    }
+
+    return entry.getFileName() != "..";
+  }
+}
+
+mitk::SceneIO::SceneIO()
+  : m_WorkingDirectory(""), m_UnzipErrors(0), m_NumberOfThreads(0), m_StoreUncompressedThreshold(1024 * 1024)
 {
 }
 
@@ -117,18 +162,9 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
-  // unzip all filenames contents to temp dir
-  m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
+  // extract all entries to temp dir
+  file.close();
+  m_UnzipErrors = this->ExtractArchive(filename);
 
   if (m_UnzipErrors)
   {
@@ -205,6 +241,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
+  reader->SetNumberOfThreads(m_NumberOfThreads);
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
@@ -321,6 +358,18 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         }
       }
 
+      // the data files are written concurrently once the index has been built
+      struct DataJob
+      {
+        DataNode *node;
+        TiXmlElement *element;
+        BaseDataSerializer::Pointer serializer;
+        std::string filename;
+        std::string errorMessage;
+        bool error;
+      };
+      std::vector<DataJob> dataJobs;
+
       // write out objects, dependencies and properties
       for (auto iter = sceneNodes->begin(); iter != sceneNodes->end(); ++iter)
       {
@@ -358,13 +407,9 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           // store basedata
           if (BaseData *data = node->GetData())
           {
-            // std::string filenameHint( node->GetName() );
-            bool error(false);
-            TiXmlElement *dataElement(SaveBaseData(data, filenameHint, error)); // returns a reference to a file
-            if (error)
-            {
-              m_FailedNodes->push_back(node);
-            }
+            auto *dataElement = new TiXmlElement("data");
+            dataElement->SetAttribute("type", data->GetNameOfClass());
+            dataJobs.push_back({node, dataElement, CreateBaseDataSerializer(data, filenameHint), "", "", true});
 
             // store basedata properties
             PropertyList *propertyList = data->GetPropertyList();
@@ -406,9 +451,42 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         {
           MITK_WARN << "Ignoring nullptr node during scene serialization.";
         }
-
-        ProgressBar::GetInstance()->Progress();
       } // end for all nodes
+
+      // serialize the data of all nodes, each serializer writes its own file
+      mitk::ParallelFor(dataJobs.size(), m_NumberOfThreads, [&dataJobs](std::size_t i) {
+        DataJob &job = dataJobs[i];
+        if (job.serializer.IsNull())
+          return;
+
+        try
+        {
+          job.filename = job.serializer->Serialize();
+          job.error = false;
+        }
+        catch (std::exception &e)
+        {
+          job.errorMessage = e.what();
+        }
+      });
+
+      for (auto &job : dataJobs)
+      {
+        if (job.error)
+        {
+          if (job.serializer.IsNotNull())
+          {
+            MITK_ERROR << "Serializer " << job.serializer->GetNameOfClass() << " failed: " << job.errorMessage;
+          }
+          m_FailedNodes->push_back(job.node);
+        }
+        else
+        {
+          job.element->SetAttribute("file", job.filename);
+        }
+      }
+
+      ProgressBar::GetInstance()->Progress(sceneNodes->size());
     }   // end if sceneNodes
 
     std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
@@ -429,20 +507,8 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           deleteFile.remove();
         }
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
-        }
-        else
-        {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
-        }
+        this->WriteArchive(filename);
+
         try
         {
           Poco::File deleteDir(m_WorkingDirectory);
@@ -474,13 +540,37 @@ TiXmlElement *mitk::SceneIO::SaveBaseData(BaseData *data, const std::string &fil
   assert(data);
   error = true;
 
+  auto *element = new TiXmlElement("data");
+  element->SetAttribute("type", data->GetNameOfClass());
+
+  BaseDataSerializer::Pointer serializer = CreateBaseDataSerializer(data, filenamehint);
+  if (serializer.IsNotNull())
+  {
+    try
+    {
+      std::string writtenfilename = serializer->Serialize();
+      element->SetAttribute("file", writtenfilename);
+      error = false;
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
+    }
+  }
+
+  return element;
+}
+
+mitk::BaseDataSerializer::Pointer mitk::SceneIO::CreateBaseDataSerializer(BaseData *data,
+                                                                          const std::string &filenamehint)
+{
+  assert(data);
+
   // find correct serializer
   // the serializer must
   //  - create a file containing all information to recreate the BaseData object --> needs to know where to put this
   //  file (and a filename?)
   //  - TODO what to do about writers that creates one file per timestep?
-  auto *element = new TiXmlElement("data");
-  element->SetAttribute("type", data->GetNameOfClass());
 
   // construct name of serializer class
   std::string serializername(data->GetNameOfClass());
@@ -503,21 +593,11 @@ TiXmlElement *mitk::SceneIO::SaveBaseData(BaseData *data, const std::string &fil
       serializer->SetFilenameHint(filenamehint);
       std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
       serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
-      try
-      {
-        std::string writtenfilename = serializer->Serialize();
-        element->SetAttribute("file", writtenfilename);
-        error = false;
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
-      }
-      break;
+      return serializer;
     }
   }
 
-  return element;
+  return nullptr;
 }
 
 TiXmlElement *mitk::SceneIO::SavePropertyList(PropertyList *propertyList, const std::string &filenamehint)
@@ -563,15 +643,121 @@ const mitk::PropertyList *mitk::SceneIO::GetFailedProperties()
   return m_FailedProperties;
 }
 
-void mitk::SceneIO::OnUnzipError(const void * /*pSender*/,
-                                 std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info)
+unsigned int mitk::SceneIO::ExtractArchive(const std::string &filename)
 {
-  ++m_UnzipErrors;
-  MITK_ERROR << "Error while unzipping: " << info.second;
+  std::vector<Poco::Zip::ZipLocalFileHeader> entries;
+
+  try
+  {
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    Poco::Zip::ZipArchive archive(file);
+    for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+    {
+      entries.push_back(iter->second);
+    }
+  }
+  catch (std::exception &e)
+  {
+    MITK_ERROR << "Could not read the table of contents of '" << filename << "': " << e.what();
+    return 1;
+  }
+
+  Poco::Path workingDirectory(m_WorkingDirectory);
+  workingDirectory.makeDirectory();
+
+  std::mutex errorMutex;
+  unsigned int errors = 0;
+
+  // create the directory structure first, so that the entries can be extracted independently
+  std::vector<Poco::Path> targets(entries.size());
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    Poco::Path entryPath(entries[i].getFileName(), Poco::Path::PATH_UNIX);
+    if (!IsSafeEntryName(entryPath))
+    {
+      MITK_ERROR << "Error while unzipping " << entries[i].getFileName()
+                 << ": entry would be extracted outside of the working directory";
+      ++errors;
+      continue;
+    }
+
+    targets[i] = Poco::Path(workingDirectory, entryPath);
+    try
+    {
+      if (entries[i].isDirectory())
+      {
+        Poco::File(targets[i].makeDirectory()).createDirectories();
+      }
+      else
+      {
+        Poco::File(Poco::Path(targets[i]).makeParent()).createDirectories();
+      }
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Error while unzipping " << entries[i].getFileName() << ": " << e.what();
+      ++errors;
+      targets[i] = Poco::Path();
+    }
+  }
+
+  // every entry is extracted through its own stream, so independent entries are inflated concurrently
+  mitk::ParallelFor(entries.size(), m_NumberOfThreads, [&](std::size_t i) {
+    const Poco::Zip::ZipLocalFileHeader &entry = entries[i];
+    if (!entry.isFile() || targets[i].getFileName().empty())
+      return;
+
+    try
+    {
+      std::ifstream file(filename.c_str(), std::ios::binary);
+      Poco::Zip::ZipInputStream input(file, entry, true);
+      std::ofstream output(targets[i].toString().c_str(), std::ios::binary);
+      Poco::StreamCopier::copyStream(input, output);
+
+      if (!output.good())
+      {
+        mitkThrow() << "Could not write " << targets[i].toString();
+      }
+    }
+    catch (std::exception &e)
+    {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      ++errors;
+      MITK_ERROR << "Error while unzipping " << entry.getFileName() << ": " << e.what();
+    }
+  });
+
+  return errors;
 }
 
-void mitk::SceneIO::OnUnzipOk(const void * /*pSender*/,
-                              std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> & /*info*/)
+void mitk::SceneIO::WriteArchive(const std::string &filename)
 {
-  // MITK_INFO << "Unzipped ok: " << info.second.toString();
+  std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
+  if (!file.good())
+  {
+    mitkThrow() << "Could not open a zip file for writing: '" << filename << "'";
+  }
+
+  Poco::Path workingDirectory(m_WorkingDirectory);
+  workingDirectory.makeDirectory();
+
+  std::vector<Poco::Path> files;
+  CollectFiles(workingDirectory, Poco::Path(), files);
+
+  Poco::Zip::Compress zipper(file, true);
+  for (const auto &entry : files)
+  {
+    Poco::Path source(workingDirectory, entry);
+
+    // data files are mostly compressed by their writers already, so large ones are stored as they are
+    if (Poco::File(source).getSize() >= m_StoreUncompressedThreshold)
+    {
+      zipper.addFile(source, entry, Poco::Zip::ZipCommon::CM_STORE);
+    }
+    else
+    {
+      zipper.addFile(source, entry, Poco::Zip::ZipCommon::CM_DEFLATE, Poco::Zip::ZipCommon::CL_MAXIMUM);
+    }
+  }
+  zipper.close();
 }
@@ -12,6 +12,10 @@ found in the LICENSE file.
 
 #include "mitkSceneReader.h"
 
+mitk::SceneReader::SceneReader() : m_NumberOfThreads(0)
+{
+}
+
 bool mitk::SceneReader::LoadScene(TiXmlDocument &document, const std::string &workingDirectory, DataStorage *storage)
 {
   // find version node --> note version in some variable
@@ -45,6 +49,7 @@ bool mitk::SceneReader::LoadScene(TiXmlDocument &document, const std::string &wo
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetNumberOfThreads(m_NumberOfThreads);
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
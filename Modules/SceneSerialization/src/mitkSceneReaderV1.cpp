@@ -17,7 +17,13 @@ found in the LICENSE file.
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
 #include "mitkSerializerMacros.h"
+#include <mitkFileReaderSelector.h>
+#include <mitkLocaleSwitch.h>
+#include <mitkParallelFor.h>
 #include <mitkRenderingModeProperty.h>
+#include <mitkStringProperty.h>
+
+#include <map>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -47,6 +53,42 @@ namespace
     // question clearly
     return left.first.GetPointer() < right.first.GetPointer();
   }
+
+  /** Reads a file with a reader that was selected before, without reporting progress. */
+  mitk::BaseData::Pointer ReadWithReader(mitk::IFileReader *reader, const std::string &fileName, bool &error)
+  {
+    mitk::BaseData::Pointer data;
+    try
+    {
+      std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
+      if (baseData.size() > 1)
+      {
+        MITK_WARN << "Discarding multiple base data results from " << fileName << " except the first one.";
+      }
+      if (!baseData.empty())
+      {
+        data = baseData.front();
+      }
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Error during attempt to read '" << fileName << "'. Exception says: " << e.what();
+      error = true;
+    }
+
+    if (data.IsNull())
+    {
+      MITK_ERROR << "Error during attempt to read '" << fileName << "'. Factory returned nullptr object.";
+      error = true;
+    }
+    else
+    {
+      // like IOUtil::Load()
+      data->SetProperty("path", mitk::StringProperty::New(fileName));
+    }
+
+    return data;
+  }
 }
 
 bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &workingDirectory, DataStorage *storage)
@@ -75,10 +117,79 @@ bool mitk::SceneReaderV1::LoadScene(TiXmlDocument &document, const std::string &
 
   ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
 
+  std::vector<TiXmlElement *> dataElements;
   for (TiXmlElement *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    DataNodes.push_back(LoadBaseDataFromDataTag(element->FirstChildElement("data"), workingDirectory, error));
+    dataElements.push_back(element->FirstChildElement("data"));
+  }
+
+  // The readers are selected on this thread. Files of thread-safe readers (see IFileReader::IsThreadSafe())
+  // are read concurrently, all other files are read by IOUtil on this thread. A reader instance that was
+  // selected for several files is not thread-safe for them.
+  std::vector<std::string> fileNames(dataElements.size());
+  std::vector<FileReaderSelector> selectors;
+  std::vector<std::size_t> concurrentData;
+  std::vector<std::size_t> sequentialData;
+  {
+    std::vector<IFileReader *> readers(dataElements.size(), nullptr);
+    std::map<IFileReader *, int> readerCount;
+    for (std::size_t i = 0; i < dataElements.size(); ++i)
+    {
+      const char *filename = dataElements[i] ? dataElements[i]->Attribute("file") : nullptr;
+      if (filename && strlen(filename) != 0)
+        fileNames[i] = workingDirectory + Poco::Path::separator() + filename;
+
+      selectors.emplace_back(fileNames[i]);
+      if (!fileNames[i].empty() && !selectors.back().Get().empty())
+      {
+        readers[i] = selectors.back().GetSelected().GetReader();
+        ++readerCount[readers[i]];
+      }
+    }
+
+    for (std::size_t i = 0; i < dataElements.size(); ++i)
+    {
+      if (readers[i] != nullptr && readers[i]->IsThreadSafe() && readerCount[readers[i]] == 1)
+        concurrentData.push_back(i);
+      else
+        sequentialData.push_back(i);
+    }
+  }
+
+  std::vector<BaseData::Pointer> baseData(dataElements.size());
+  std::vector<char> dataErrors(dataElements.size(), 0);
+  {
+    // the readers switch the locale of the whole process, switching once here turns their switches into no-ops
+    LocaleSwitch localeSwitch("C");
+
+    ParallelLoop loop(concurrentData.size(), m_NumberOfThreads, [&](std::size_t c) {
+      const std::size_t i = concurrentData[c];
+      bool dataError(false);
+      baseData[i] = ReadWithReader(selectors[i].GetSelected().GetReader(), fileNames[i], dataError);
+      dataErrors[i] = dataError;
+    });
+
+    for (std::size_t i : sequentialData)
+    {
+      bool dataError(false);
+      baseData[i] = LoadBaseData(dataElements[i], workingDirectory, dataError);
+      dataErrors[i] = dataError;
+    }
+
+    loop.Wait();
+  }
+
+  for (std::size_t i = 0; i < dataElements.size(); ++i)
+  {
+    DataNode::Pointer node = DataNode::New();
+    if (baseData[i].IsNotNull())
+    {
+      node->SetData(baseData[i]);
+    }
+    error = error || dataErrors[i];
+
+    DataNodes.push_back(node);
     ProgressBar::GetInstance()->Progress();
   }
 
@@ -241,7 +352,23 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
                                                                      const std::string &workingDirectory,
                                                                      bool &error)
 {
-  DataNode::Pointer node;
+  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
+  DataNode::Pointer node = DataNode::New();
+
+  BaseData::Pointer data = LoadBaseData(dataElement, workingDirectory, error);
+  if (data.IsNotNull())
+  {
+    node->SetData(data);
+  }
+
+  return node;
+}
+
+mitk::BaseData::Pointer mitk::SceneReaderV1::LoadBaseData(TiXmlElement *dataElement,
+                                                          const std::string &workingDirectory,
+                                                          bool &error) const
+{
+  BaseData::Pointer data;
 
   if (dataElement)
   {
@@ -255,8 +382,7 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
         {
           MITK_WARN << "Discarding multiple base data results from " << filename << " except the first one.";
         }
-        node = DataNode::New();
-        node->SetData(baseData.front());
+        data = baseData.front();
       }
       catch (std::exception &e)
       {
@@ -264,7 +390,7 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
         error = true;
       }
 
-      if (node.IsNull())
+      if (data.IsNull())
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
         error = true;
@@ -272,13 +398,7 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(TiXmlElemen
     }
   }
 
-  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
-  if (node.IsNull())
-  {
-    node = DataNode::New();
-  }
-
-  return node;
+  return data;
 }
 
 void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList)
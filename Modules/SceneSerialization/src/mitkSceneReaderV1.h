@@ -33,6 +33,13 @@ namespace mitk
                                               const std::string &workingDirectory,
                                               bool &error);
 
+    /**
+      \brief reads the BaseData referenced by a XML <data> element, nullptr if there is none
+
+      Reads with IOUtil, which reports progress, so it is called on the thread that loads the scene.
+    */
+    BaseData::Pointer LoadBaseData(TiXmlElement *dataElement, const std::string &workingDirectory, bool &error) const;
+
     /**
       \brief reads all the properties from the XML document and recreates them in node
     */
@@ -26,6 +26,7 @@ found in the LICENSE file.
 
   Currently contains:
   - I/O tests: write some Storage, read it, compare
+  - the same with several threads and uncompressed archive entries
 
   Should be enhanced with:
   - tests about the interface of SceneIO, providing invalid arguments etc.
@@ -78,6 +79,7 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ParallelReconstructionOfScenes);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +127,43 @@ public:
     }
   }
 
+  void Test_ParallelReconstructionOfScenes()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    mitk::SceneIOTestScenarioProvider::ScenarioList scenarios = m_TestCaseProvider.GetAllScenarios();
+    for (auto scenario : scenarios)
+    {
+      if (!scenario.serializable)
+        continue;
+
+      MITK_TEST_OUTPUT(<< "\n===== Test_ParallelReconstructionOfScenes, scenario '" << scenario.key << "' =====");
+
+      // four threads, all entries stored uncompressed
+      std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+      mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+      writer->SetNumberOfThreads(4);
+      writer->SetStoreUncompressedThreshold(0);
+      mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+      CPPUNIT_ASSERT_MESSAGE(std::string("Save test scenario '") + scenario.key + "' to '" + archiveFilename + "'",
+                             writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+      mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+      reader->SetNumberOfThreads(4);
+      mitk::DataStorage::Pointer restoredStorage;
+      CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+      CPPUNIT_ASSERT_MESSAGE(std::string("Comparing restored test scenario '") + scenario.key + "'",
+                             mitk::DataStorageCompare(originalStorage,
+                                                      restoredStorage,
+                                                      mitk::DataStorageCompare::CMP_Hierarchy |
+                                                        mitk::DataStorageCompare::CMP_Data |
+                                                        mitk::DataStorageCompare::CMP_Properties |
+                                                        mitk::DataStorageCompare::CMP_Mappers,
+                                                      scenario.comparisonPrecision)
+                               .CompareVerbose());
+    }
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -0,0 +1,290 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBatchSliceInterpolator.h"
+#include "mitkShapeBasedInterpolationAlgorithm.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkParallelFor.h>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  typedef mitk::ShapeBasedInterpolationAlgorithm::DistanceImageType DistanceImageType;
+  typedef mitk::ShapeBasedInterpolationAlgorithm::BinarySliceType BinarySliceType;
+
+  /** Memory layout of the slices of a volume in one slice dimension. */
+  struct SliceLayout
+  {
+    SliceLayout(const itk::Size<3> &size, unsigned int sliceDimension)
+      : sliceDimension(sliceDimension),
+        uDimension(sliceDimension == 0 ? 1 : 0),
+        vDimension(sliceDimension == 2 ? 1 : 2),
+        numberOfSlices(size[sliceDimension]),
+        width(size[uDimension]),
+        height(size[vDimension])
+    {
+      const std::size_t strides[3] = {1, size[0], size[0] * size[1]};
+      sliceStride = strides[sliceDimension];
+      uStride = strides[uDimension];
+      vStride = strides[vDimension];
+    }
+
+    std::size_t GetOffset(unsigned int sliceIndex, std::size_t u, std::size_t v) const
+    {
+      return sliceIndex * sliceStride + u * uStride + v * vStride;
+    }
+
+    unsigned int sliceDimension;
+    unsigned int uDimension;
+    unsigned int vDimension;
+    unsigned int numberOfSlices;
+    std::size_t width;
+    std::size_t height;
+    std::size_t sliceStride;
+    std::size_t uStride;
+    std::size_t vStride;
+  };
+
+  /** A segmented slice next to interpolated slices. Its distance map is computed by the first slice that needs it
+      and released by the last one.*/
+  struct KeySlice
+  {
+    unsigned int sliceIndex = 0;
+    std::atomic<unsigned int> remainingUses{0};
+    std::once_flag distanceMapComputed;
+    DistanceImageType::Pointer distanceMap;
+  };
+
+  struct InterpolationTask
+  {
+    unsigned int sliceIndex;
+    std::size_t lowerKeySlice;
+    std::size_t upperKeySlice;
+  };
+
+  template <typename TPixel>
+  bool IsEmptySlice(const TPixel *volume, const SliceLayout &layout, unsigned int sliceIndex)
+  {
+    for (std::size_t v = 0; v < layout.height; ++v)
+    {
+      for (std::size_t u = 0; u < layout.width; ++u)
+      {
+        if (volume[layout.GetOffset(sliceIndex, u, v)] != 0)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename TPixel>
+  BinarySliceType::Pointer ExtractBinarySlice(const TPixel *volume,
+                                              const SliceLayout &layout,
+                                              const itk::Vector<double, 3> &spacing,
+                                              unsigned int sliceIndex)
+  {
+    BinarySliceType::RegionType region;
+    region.SetSize(0, layout.width);
+    region.SetSize(1, layout.height);
+
+    BinarySliceType::SpacingType sliceSpacing;
+    sliceSpacing[0] = spacing[layout.uDimension];
+    sliceSpacing[1] = spacing[layout.vDimension];
+
+    BinarySliceType::Pointer slice = BinarySliceType::New();
+    slice->SetRegions(region);
+    slice->SetSpacing(sliceSpacing);
+    slice->Allocate();
+
+    unsigned char *slicePixel = slice->GetBufferPointer();
+    for (std::size_t v = 0; v < layout.height; ++v)
+    {
+      for (std::size_t u = 0; u < layout.width; ++u)
+        *slicePixel++ = volume[layout.GetOffset(sliceIndex, u, v)] != 0 ? 1 : 0;
+    }
+    return slice;
+  }
+}
+
+mitk::BatchSliceInterpolator::BatchSliceInterpolator() : m_NumberOfThreads(0), m_Cancelled(false)
+{
+}
+
+mitk::BatchSliceInterpolator::~BatchSliceInterpolator()
+{
+}
+
+void mitk::BatchSliceInterpolator::SetProgressCallback(const ProgressCallbackType &callback)
+{
+  m_ProgressCallback = callback;
+}
+
+unsigned int mitk::BatchSliceInterpolator::Interpolate(const Image *segmentation,
+                                                       unsigned int sliceDimension,
+                                                       Image *result)
+{
+  m_Cancelled = false;
+
+  if (segmentation == nullptr || result == nullptr)
+    mitkThrow() << "Segmentation and result image must be set.";
+
+  if (segmentation->GetDimension() != 3 || sliceDimension > 2)
+    mitkThrow() << "Slice interpolation needs a 3D segmentation.";
+
+  if (result->GetDimension() < 3 || result->GetDimension(0) != segmentation->GetDimension(0) ||
+      result->GetDimension(1) != segmentation->GetDimension(1) ||
+      result->GetDimension(2) != segmentation->GetDimension(2) ||
+      result->GetPixelType() != segmentation->GetPixelType())
+    mitkThrow() << "The result image does not match the segmentation.";
+
+  unsigned int numberOfInterpolatedSlices = 0;
+  AccessFixedDimensionByItk_n(
+    segmentation, InterpolateVolume, 3, (sliceDimension, result, numberOfInterpolatedSlices));
+
+  return numberOfInterpolatedSlices;
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::BatchSliceInterpolator::InterpolateVolume(const itk::Image<TPixel, VImageDimension> *segmentation,
+                                                     unsigned int sliceDimension,
+                                                     Image *result,
+                                                     unsigned int &numberOfInterpolatedSlices)
+{
+  const SliceLayout layout(segmentation->GetLargestPossibleRegion().GetSize(), sliceDimension);
+  const TPixel *volume = segmentation->GetBufferPointer();
+
+  // find the key slices
+  std::vector<char> isKeySlice(layout.numberOfSlices, 0);
+  ParallelFor(layout.numberOfSlices, m_NumberOfThreads, [&](std::size_t s) {
+    isKeySlice[s] = IsEmptySlice(volume, layout, static_cast<unsigned int>(s)) ? 0 : 1;
+  });
+
+  // every empty slice between two key slices is interpolated from them; both tasks and key slices are sorted
+  // by slice index, so the threads work on neighboring slices and only a few distance maps exist at a time
+  std::vector<unsigned int> keySliceIndices;
+  std::vector<InterpolationTask> tasks;
+  for (unsigned int s = 0; s < layout.numberOfSlices; ++s)
+  {
+    if (!isKeySlice[s])
+      continue;
+
+    if (!keySliceIndices.empty() && s - keySliceIndices.back() > 1)
+    {
+      for (unsigned int gapSlice = keySliceIndices.back() + 1; gapSlice < s; ++gapSlice)
+        tasks.push_back({gapSlice, keySliceIndices.size() - 1, keySliceIndices.size()});
+    }
+    keySliceIndices.push_back(s);
+  }
+
+  const unsigned int numberOfTasks = static_cast<unsigned int>(tasks.size());
+  if (m_ProgressCallback && !m_ProgressCallback(0, numberOfTasks))
+    m_Cancelled = true;
+
+  if (tasks.empty() || m_Cancelled)
+    return;
+
+  std::vector<KeySlice> keySlices(keySliceIndices.size());
+  for (std::size_t k = 0; k < keySlices.size(); ++k)
+    keySlices[k].sliceIndex = keySliceIndices[k];
+
+  for (const auto &task : tasks)
+  {
+    ++keySlices[task.lowerKeySlice].remainingUses;
+    ++keySlices[task.upperKeySlice].remainingUses;
+  }
+
+  ImagePixelWriteAccessor<TPixel, VImageDimension> resultAccessor(result, result->GetVolumeData(0));
+  TPixel *target = resultAccessor.GetData();
+
+  const itk::Vector<double, 3> spacing = segmentation->GetSpacing();
+  auto getDistanceMap = [&](KeySlice &keySlice) -> const DistanceImageType * {
+    std::call_once(keySlice.distanceMapComputed, [&]() {
+      keySlice.distanceMap = ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(
+        ExtractBinarySlice(volume, layout, spacing, keySlice.sliceIndex));
+    });
+    return keySlice.distanceMap;
+  };
+
+  auto releaseDistanceMap = [](KeySlice &keySlice) {
+    if (--keySlice.remainingUses == 0)
+      keySlice.distanceMap = nullptr;
+  };
+
+  std::atomic<bool> cancelled(false);
+  std::atomic<unsigned int> finishedTasks(0);
+
+  auto interpolateSlice = [&](std::size_t i) {
+    if (cancelled)
+      return;
+
+    const InterpolationTask &task = tasks[i];
+    KeySlice &lowerKeySlice = keySlices[task.lowerKeySlice];
+    KeySlice &upperKeySlice = keySlices[task.upperKeySlice];
+
+    const ScalarType *lowerDistance = getDistanceMap(lowerKeySlice)->GetBufferPointer();
+    const ScalarType *upperDistance = getDistanceMap(upperKeySlice)->GetBufferPointer();
+
+    // same position of the slice between the key slices as in ShapeBasedInterpolationAlgorithm
+    const float ratio = (float)(task.sliceIndex - lowerKeySlice.sliceIndex) /
+                        (float)(upperKeySlice.sliceIndex - lowerKeySlice.sliceIndex);
+
+    for (std::size_t v = 0; v < layout.height; ++v)
+    {
+      for (std::size_t u = 0; u < layout.width; ++u, ++lowerDistance, ++upperDistance)
+      {
+        const bool inside = ShapeBasedInterpolationAlgorithm::IsInside(*lowerDistance, *upperDistance, ratio);
+        target[layout.GetOffset(task.sliceIndex, u, v)] = static_cast<TPixel>(inside ? 1 : 0);
+      }
+    }
+
+    releaseDistanceMap(lowerKeySlice);
+    releaseDistanceMap(upperKeySlice);
+    ++finishedTasks;
+  };
+
+  // The calling thread interpolates slices as well and reports the progress between them. An exception of the
+  // progress callback leaves this method after the loop has waited for the running slices.
+  ParallelLoop loop(tasks.size(), m_NumberOfThreads, interpolateSlice);
+
+  unsigned int reportedTasks = 0;
+  while (!cancelled && loop.RunNext())
+  {
+    if (m_ProgressCallback && finishedTasks != reportedTasks)
+    {
+      reportedTasks = finishedTasks;
+      if (!m_ProgressCallback(reportedTasks, numberOfTasks))
+        cancelled = true;
+    }
+  }
+
+  try
+  {
+    loop.Wait();
+  }
+  catch (const std::exception &e)
+  {
+    mitkThrow() << "Error in 2D interpolation: " << e.what();
+  }
+
+  if (!cancelled && m_ProgressCallback && reportedTasks != numberOfTasks)
+    m_ProgressCallback(numberOfTasks, numberOfTasks);
+
+  m_Cancelled = cancelled;
+  numberOfInterpolatedSlices = m_Cancelled ? finishedTasks.load() : numberOfTasks;
+}
@@ -0,0 +1,94 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBatchSliceInterpolator_h_Included
+#define mitkBatchSliceInterpolator_h_Included
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+
+#include <itkImage.h>
+
+#include <functional>
+
+namespace mitk
+{
+  /**
+   * \brief Interpolates all empty slices between segmented slices of a volume at once.
+   *
+   * A slice is a key slice if it contains any pixel other than 0. Every empty slice that lies between two key slices
+   * (in the direction of the slice dimension) is interpolated with the shape-based algorithm of
+   * ShapeBasedInterpolationAlgorithm, which gives the same results as interpolating the slices one by one with
+   * SegmentationInterpolationController.
+   *
+   * The distance map of each key slice is computed only once and released as soon as all slices next to it are
+   * interpolated. The slices are interpolated by a ParallelLoop and written directly into the result volume.
+   *
+   * The progress callback is called on the thread that calls Interpolate(), between the slices that this thread
+   * interpolates itself. It gets the number of interpolated slices and the total number of slices to interpolate,
+   * starting with 0 and ending with the total number. If it returns false, the interpolation is cancelled: slices
+   * that are not started yet are skipped, and Interpolate() returns after the running ones are finished.
+   */
+  class MITKSEGMENTATION_EXPORT BatchSliceInterpolator : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(BatchSliceInterpolator, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    typedef std::function<bool(unsigned int, unsigned int)> ProgressCallbackType;
+
+    /**
+      \brief Number of threads used for the interpolation, 0 (default) uses all available cores.
+    */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    void SetProgressCallback(const ProgressCallbackType &callback);
+
+    /**
+      \brief Interpolates the empty slices of a 3D segmentation.
+
+      \param segmentation 3D image, e.g. one time step of a segmentation.
+      \param sliceDimension Number of the dimension which is constant for all pixels of a slice.
+      \param result 3D image with the size and pixel type of \a segmentation. Interpolated slices are written into it
+             with the values 0 and 1, all other slices are not touched.
+
+      \return the number of interpolated slices. If the interpolation was cancelled, this is the number of slices that
+              were written before, the result should be discarded then.
+
+      \throw mitk::Exception if the images do not match or the interpolation fails.
+    */
+    unsigned int Interpolate(const Image *segmentation, unsigned int sliceDimension, Image *result);
+
+    /**
+      \brief Whether the last call of Interpolate() was cancelled by the progress callback.
+    */
+    itkGetConstMacro(Cancelled, bool);
+
+  protected:
+    BatchSliceInterpolator();
+    ~BatchSliceInterpolator() override;
+
+  private:
+    template <typename TPixel, unsigned int VImageDimension>
+    void InterpolateVolume(const itk::Image<TPixel, VImageDimension> *segmentation,
+                           unsigned int sliceDimension,
+                           Image *result,
+                           unsigned int &numberOfInterpolatedSlices);
+
+    ProgressCallbackType m_ProgressCallback;
+    unsigned int m_NumberOfThreads;
+    bool m_Cancelled;
+  };
+}
+
+#endif
@@ -13,16 +13,236 @@ found in the LICENSE file.
 #include "mitkContourModelSetToImageFilter.h"
 
 #include <mitkContourModelSet.h>
-#include <mitkContourModelUtils.h>
-#include <mitkExtractSliceFilter.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkParallelFor.h>
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkProgressBar.h>
 #include <mitkTimeHelper.h>
 
-#include <mitkVtkImageOverwrite.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace
+{
+  /** Closed polygons of the contours that lie in one slice, in the index coordinates (u, v) of the two axes that
+      span the slice (in ascending order).*/
+  struct SliceContours
+  {
+    typedef std::vector<mitk::Point2D> PolygonType;
+
+    unsigned int Axis;
+    int SliceIndex;
+    std::vector<PolygonType> Polygons;
+  };
+
+  /** Edge of a polygon, with u = UAtVMin + (v - VMin) * Slope.*/
+  struct Edge
+  {
+    double VMin;
+    double VMax;
+    double UAtVMin;
+    double Slope;
+  };
+
+  void GetSliceAxes(unsigned int axis, unsigned int &uAxis, unsigned int &vAxis)
+  {
+    uAxis = axis == 0 ? 1 : 0;
+    vAxis = axis == 2 ? 1 : 2;
+  }
+
+  /** Projects the vertices of the first time step of the contour into the index coordinates of the image. Fails if
+      the contour does not lie in a slice of one of the image axes.*/
+  bool ProjectContour(mitk::ContourModel *contour,
+                      const mitk::BaseGeometry *geometry,
+                      SliceContours::PolygonType &polygon,
+                      unsigned int &axis,
+                      int &sliceIndex)
+  {
+    std::vector<mitk::Point3D> indexPoints;
+    for (auto it = contour->Begin(); it != contour->End(); ++it)
+    {
+      mitk::Point3D indexPoint;
+      geometry->WorldToIndex((*it)->Coordinates, indexPoint);
+      indexPoints.push_back(indexPoint);
+    }
+
+    axis = 2;
+    sliceIndex = 0;
+    if (indexPoints.empty())
+      return true;
+
+    // the contour lies in the slice of the axis along which its vertices are (nearly) constant
+    double extent[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      auto range = std::minmax_element(indexPoints.begin(),
+                                       indexPoints.end(),
+                                       [i](const mitk::Point3D &a, const mitk::Point3D &b) { return a[i] < b[i]; });
+      extent[i] = (*range.second)[i] - (*range.first)[i];
+    }
+
+    axis = static_cast<unsigned int>(std::min_element(extent, extent + 3) - extent);
+    if (extent[axis] >= 0.5)
+      return false;
+
+    sliceIndex = static_cast<int>(std::lround(indexPoints.front()[axis]));
+
+    unsigned int uAxis, vAxis;
+    GetSliceAxes(axis, uAxis, vAxis);
+
+    polygon.reserve(indexPoints.size());
+    for (const auto &indexPoint : indexPoints)
+    {
+      mitk::Point2D point;
+      point[0] = indexPoint[uAxis];
+      point[1] = indexPoint[vAxis];
+      polygon.push_back(point);
+    }
+    return true;
+  }
+
+  /** Calls fillSpan(v, uBegin, uEnd) for the pixels whose centers lie on the border of the polygons.*/
+  template <typename TFillSpan>
+  void RasterizeBorder(const mitk::Point2D &a, const mitk::Point2D &b, int sizeU, int sizeV, TFillSpan fillSpan)
+  {
+    const auto &lower = a[1] < b[1] ? a : b;
+    const auto &upper = a[1] < b[1] ? b : a;
+
+    const int vBegin = std::max(0, static_cast<int>(std::ceil(lower[1] - mitk::eps)));
+    const int vEnd = std::min(sizeV - 1, static_cast<int>(std::floor(upper[1] + mitk::eps)));
+
+    for (int v = vBegin; v <= vEnd; ++v)
+    {
+      double uMin = std::min(a[0], b[0]);
+      double uMax = std::max(a[0], b[0]);
+
+      if (upper[1] - lower[1] > mitk::eps)
+      {
+        const double t = std::max(0.0, std::min(1.0, (v - lower[1]) / (upper[1] - lower[1])));
+        uMin = uMax = lower[0] + t * (upper[0] - lower[0]);
+      }
+
+      const int uBegin = std::max(0, static_cast<int>(std::ceil(uMin - mitk::eps)));
+      const int uEnd = std::min(sizeU - 1, static_cast<int>(std::floor(uMax + mitk::eps)));
+
+      if (uBegin <= uEnd)
+        fillSpan(v, uBegin, uEnd);
+    }
+  }
+
+  /** Fills the pixels whose centers lie inside the polygons with the even-odd rule, so polygons inside of other
+      polygons are holes. Pixels on the border of a polygon are filled as well. fillSpan(v, uBegin, uEnd) is called
+      for every run of pixels, with uEnd inclusive.*/
+  template <typename TFillSpan>
+  void RasterizePolygons(const std::vector<SliceContours::PolygonType> &polygons,
+                         int sizeU,
+                         int sizeV,
+                         TFillSpan fillSpan)
+  {
+    std::vector<Edge> edges;
+    for (const auto &polygon : polygons)
+    {
+      for (std::size_t i = 0; i < polygon.size(); ++i)
+      {
+        const auto &a = polygon[i];
+        const auto &b = polygon[(i + 1) % polygon.size()];
+
+        RasterizeBorder(a, b, sizeU, sizeV, fillSpan);
+
+        // horizontal edges never cross a row
+        if (a[1] == b[1])
+          continue;
+
+        const auto &lower = a[1] < b[1] ? a : b;
+        const auto &upper = a[1] < b[1] ? b : a;
+        edges.push_back({lower[1], upper[1], lower[0], (upper[0] - lower[0]) / (upper[1] - lower[1])});
+      }
+    }
+
+    if (edges.empty())
+      return;
+
+    std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.VMin < b.VMin; });
+
+    const int vBegin = std::max(0, static_cast<int>(std::ceil(edges.front().VMin)));
+    std::vector<Edge> activeEdges;
+    std::vector<double> crossings;
+    std::size_t nextEdge = 0;
+
+    for (int v = vBegin; v < sizeV; ++v)
+    {
+      // an edge crosses the rows in [VMin, VMax), so a vertex between two edges is counted once
+      for (; nextEdge < edges.size() && edges[nextEdge].VMin <= v; ++nextEdge)
+        activeEdges.push_back(edges[nextEdge]);
+
+      activeEdges.erase(std::remove_if(activeEdges.begin(),
+                                       activeEdges.end(),
+                                       [v](const Edge &edge) { return edge.VMax <= v; }),
+                        activeEdges.end());
+
+      if (activeEdges.empty())
+      {
+        if (nextEdge == edges.size())
+          break;
+        continue;
+      }
+
+      crossings.clear();
+      for (const auto &edge : activeEdges)
+        crossings.push_back(edge.UAtVMin + (v - edge.VMin) * edge.Slope);
+
+      std::sort(crossings.begin(), crossings.end());
+
+      for (std::size_t i = 0; i + 1 < crossings.size(); i += 2)
+      {
+        const int uBegin = std::max(0, static_cast<int>(std::ceil(crossings[i])));
+        const int uEnd = std::min(sizeU - 1, static_cast<int>(std::floor(crossings[i + 1])));
+
+        if (uBegin <= uEnd)
+          fillSpan(v, uBegin, uEnd);
+      }
+    }
+  }
+
+  /** Fills the slices with 1. The slices of one axis are filled in parallel, as they do not share voxels.*/
+  template <typename TPixel>
+  void FillSlices(const mitk::PixelType &,
+                  void *data,
+                  const unsigned int *size,
+                  const std::vector<SliceContours> &slices,
+                  unsigned int numberOfThreads)
+  {
+    auto *volume = static_cast<TPixel *>(data);
+    const std::size_t strides[3] = {1, size[0], std::size_t(size[0]) * size[1]};
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      std::vector<const SliceContours *> axisSlices;
+      for (const auto &slice : slices)
+      {
+        if (slice.Axis == axis)
+          axisSlices.push_back(&slice);
+      }
+
+      unsigned int uAxis, vAxis;
+      GetSliceAxes(axis, uAxis, vAxis);
+
+      mitk::ParallelFor(axisSlices.size(), numberOfThreads, [&](std::size_t i) {
+        TPixel *sliceData = volume + axisSlices[i]->SliceIndex * strides[axis];
+
+        RasterizePolygons(axisSlices[i]->Polygons, size[uAxis], size[vAxis], [&](int v, int uBegin, int uEnd) {
+          TPixel *row = sliceData + v * strides[vAxis];
+          for (int u = uBegin; u <= uEnd; ++u)
+            row[u * strides[uAxis]] = 1;
+        });
+      });
+    }
+  }
+}
 
 mitk::ContourModelSetToImageFilter::ContourModelSetToImageFilter()
-  : m_MakeOutputBinary(true), m_TimeStep(0), m_ReferenceImage(nullptr)
+  : m_MakeOutputBinary(true), m_TimeStep(0), m_NumberOfThreads(0), m_ReferenceImage(nullptr)
 {
   // Create the output.
   itk::DataObject::Pointer output = this->MakeOutput(0);
@@ -132,107 +352,50 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
     return;
   }
 
-  mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
-
-  // Create mitkVtkImageOverwrite which is needed to write the slice back into the volume
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  const mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
+  const unsigned int size[3] = {
+    outputImage->GetDimension(0), outputImage->GetDimension(1), outputImage->GetDimension(2)};
 
-  // Create ExtractSliceFilter for extracting the corresponding slices from the volume
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(outputImage);
-  extractor->SetTimeStep(m_TimeStep);
-  extractor->SetResliceTransformByGeometry(outputImageGeo);
+  // 1. Project the contours into the index coordinates of the slices they lie in, grouped by slice
+  std::map<std::pair<unsigned int, int>, std::size_t> sliceNumbers;
+  std::vector<SliceContours> slices;
 
-  // Fill each contour of the contourmodelset into the image
-  auto it = contourSet->Begin();
-  auto end = contourSet->End();
-  while (it != end)
+  for (auto it = contourSet->Begin(); it != contourSet->End(); ++it)
   {
-    mitk::ContourModel *contour = it->GetPointer();
-
-    // 1. Create slice geometry using the contour points
-    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
-    mitk::Point3D point3D, tempPoint;
-    mitk::Vector3D normal;
-
-    mitk::Image::Pointer slice;
-
+    SliceContours::PolygonType polygon;
+    unsigned int axis;
     int sliceIndex;
-    bool isFrontside = true;
-    bool isRotated = false;
-
-    // Determine plane orientation
-    point3D = contour->GetVertexAt(0)->Coordinates;
-    tempPoint = contour->GetVertexAt(contour->GetNumberOfVertices() * 0.25)->Coordinates;
-    mitk::Vector3D vec = point3D - tempPoint;
-    vec.Normalize();
-    outputImageGeo->WorldToIndex(point3D, point3D);
-
-    mitk::PlaneGeometry::PlaneOrientation orientation;
-    if (mitk::Equal(vec[0], 0))
-    {
-      orientation = mitk::PlaneGeometry::Sagittal;
-      sliceIndex = point3D[0];
-    }
-    else if (mitk::Equal(vec[1], 0))
-    {
-      orientation = mitk::PlaneGeometry::Frontal;
-      sliceIndex = point3D[1];
-    }
-    else if (mitk::Equal(vec[2], 0))
-    {
-      orientation = mitk::PlaneGeometry::Axial;
-      sliceIndex = point3D[2];
-    }
-    else
+
+    if (!ProjectContour(*it, outputImageGeo, polygon, axis, sliceIndex))
     {
-      // TODO Maybe rotate geometry to extract slice?
       MITK_ERROR
         << "Cannot detect correct slice number! Only axial, sagittal and frontal oriented contours are supported!";
+      mitk::ProgressBar::GetInstance()->Progress(num_contours);
       return;
     }
 
-    // Initialize plane using the detected orientation
-    plane->InitializeStandardPlane(outputImageGeo, orientation, sliceIndex, isFrontside, isRotated);
-    point3D = plane->GetOrigin();
-    normal = plane->GetNormal();
-    normal.Normalize();
-    point3D += normal * 0.5; // pixelspacing is 1, so half the spacing is 0.5
-    plane->SetOrigin(point3D);
+    if (polygon.empty() || sliceIndex < 0 || sliceIndex >= static_cast<int>(size[axis]))
+      continue;
 
-    // 2. Extract slice at the given position
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(false);
-    reslice->SetOverwriteMode(false);
-
-    extractor->Modified();
-    extractor->Update();
-
-    slice = extractor->GetOutput();
-    slice->DisconnectPipeline();
-
-    // 3. Fill contour into slice
-    mitk::ContourModel::Pointer projectedContour =
-      mitk::ContourModelUtils::ProjectContourTo2DSlice(slice, contour, true, false);
-    mitk::ContourModelUtils::FillContourInSlice(projectedContour, slice, outputImage);
-
-    // 4. Write slice back into image volume
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
+    auto sliceNumber = sliceNumbers.emplace(std::make_pair(axis, sliceIndex), slices.size());
+    if (sliceNumber.second)
+    {
+      SliceContours slice;
+      slice.Axis = axis;
+      slice.SliceIndex = sliceIndex;
+      slices.push_back(slice);
+    }
 
-    extractor->Modified();
-    extractor->Update();
+    slices[sliceNumber.first->second].Polygons.push_back(polygon);
+  }
 
-    reslice->SetInputSlice(nullptr);
+  // 2. Fill the slices directly into the output volume
+  mitk::ImageWriteAccessor accessor(outputImage, outputImage->GetVolumeData(m_TimeStep));
+  const mitk::PixelType pixelType = outputImage->GetPixelType();
 
-    // Progress
-    mitk::ProgressBar::GetInstance()->Progress();
+  mitkPixelTypeMultiplex4(FillSlices, pixelType, accessor.GetData(), size, slices, m_NumberOfThreads);
 
-    ++it;
-  }
+  mitk::ProgressBar::GetInstance()->Progress(num_contours);
 
   outputImage->Modified();
   outputImage->GetVtkImageData()->Modified();
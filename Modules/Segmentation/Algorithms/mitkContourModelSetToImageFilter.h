@@ -22,6 +22,11 @@ namespace mitk
 
   /**
     * @brief Fills a given mitk::ContourModelSet into a given mitk::Image
+    *
+    * Every contour has to lie in an axial, sagittal or frontal slice of the image. The contours are grouped by slice
+    * and each slice is filled with a scanline algorithm using the even-odd rule, so contours inside of other contours
+    * of the same slice are holes. The slices are filled in parallel, directly into the output volume.
+    *
     * @ingroup Process
     */
   class MITKSEGMENTATION_EXPORT ContourModelSetToImageFilter : public ImageSource
@@ -36,6 +41,12 @@ namespace mitk
 
     itkSetMacro(TimeStep, unsigned int);
 
+    /**
+       * @brief Number of threads used for filling the slices, 0 (default) uses all available cores.
+       */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
     /**
        * Allocates a new output object and returns it. Currently the
        * index idx is not evaluated.
@@ -85,6 +96,8 @@ namespace mitk
 
     unsigned int m_TimeStep;
 
+    unsigned int m_NumberOfThreads;
+
     const mitk::Image *m_ReferenceImage;
   };
 }
@@ -31,8 +31,9 @@ mitk::DiffSliceOperation::DiffSliceOperation(mitk::Image *imageVolume,
                                              Image *slice,
                                              SlicedGeometry3D *sliceGeometry,
                                              unsigned int timestep,
-                                             BaseGeometry *currentWorldGeometry)
-  : Operation(1)
+                                             BaseGeometry *currentWorldGeometry,
+                                             const itk::ImageRegion<2> &sliceRegion)
+  : Operation(1), m_SliceRegion(sliceRegion)
 
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
+#include <itkImageRegion.h>
 #include <vtkSmartPointer.h>
 
 namespace mitk
@@ -32,6 +33,7 @@ namespace mitk
      slice                  the slice to be applied.
      timestep               the timestep in an 4D image.
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
+     sliceRegion            the region of the whole slice that is covered by slice (optional).
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
   */
@@ -50,12 +52,15 @@ namespace mitk
     */
     DiffSliceOperation();
 
-    /** \brief */
+    /** \brief Creates an operation for a slice or, if \a sliceRegion is not empty, for a region of a slice.
+      In the latter case \a slice has the size of the region and only the region is applied to the volume.
+    */
     DiffSliceOperation(mitk::Image *imageVolume,
                        mitk::Image *slice,
                        SlicedGeometry3D *sliceGeometry,
                        unsigned int timestep,
-                       BaseGeometry *currentWorldGeometry);
+                       BaseGeometry *currentWorldGeometry,
+                       const itk::ImageRegion<2> &sliceRegion = itk::ImageRegion<2>());
 
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
@@ -81,6 +86,8 @@ namespace mitk
     void SetCurrentWorldGeometry(BaseGeometry *worldGeometry) { this->m_WorldGeometry = worldGeometry; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     BaseGeometry *GetWorldGeometry() { return this->m_WorldGeometry; }
+    /** \brief Get the region of the whole slice that is applied. An empty region denotes the whole slice.*/
+    const itk::ImageRegion<2> &GetSliceRegion() const { return this->m_SliceRegion; }
   protected:
     ~DiffSliceOperation() override;
 
@@ -99,6 +106,8 @@ namespace mitk
 
     BaseGeometry::Pointer m_WorldGeometry;
 
+    itk::ImageRegion<2> m_SliceRegion;
+
     bool m_ImageIsValid;
 
     unsigned long m_DeleteObserverTag;
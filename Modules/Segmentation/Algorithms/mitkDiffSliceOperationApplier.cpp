@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperation.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
+#include "mitkSliceRegionWriter.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkVtkImageOverwrite.h>
 
@@ -40,27 +41,40 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
   // chak if the operation is valid
   if (imageOperation->IsValid())
   {
-    // the actual overwrite filter (vtk)
-    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
     mitk::Image::Pointer slice = imageOperation->GetSlice();
-    // Set the slice as 'input'
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
-    // a wrapper for vtkImageOverwrite
-    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-    extractor->SetInput(imageOperation->GetImage());
-    extractor->SetTimeStep(imageOperation->GetTimeStep());
-    extractor->SetWorldGeometry(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()));
-    extractor->SetVtkOutputRequest(true);
-    extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
-
-    extractor->Modified();
-    extractor->Update();
+
+    if (imageOperation->GetSliceRegion().GetNumberOfPixels() > 0)
+    {
+      // only a region of the slice is stored
+      SliceRegionWriter::WriteRegion(imageOperation->GetImage(),
+                                     imageOperation->GetTimeStep(),
+                                     dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()),
+                                     slice,
+                                     imageOperation->GetSliceRegion());
+    }
+    else
+    {
+      // the actual overwrite filter (vtk)
+      vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+      // Set the slice as 'input'
+      reslice->SetInputSlice(slice->GetVtkImageData());
+
+      // set overwrite mode to true to write back to the image volume
+      reslice->SetOverwriteMode(true);
+      reslice->Modified();
+
+      // a wrapper for vtkImageOverwrite
+      mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+      extractor->SetInput(imageOperation->GetImage());
+      extractor->SetTimeStep(imageOperation->GetTimeStep());
+      extractor->SetWorldGeometry(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+      extractor->SetVtkOutputRequest(true);
+      extractor->SetResliceTransformByGeometry(imageOperation->GetImage()->GetGeometry(imageOperation->GetTimeStep()));
+
+      extractor->Modified();
+      extractor->Update();
+    }
 
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
@@ -222,6 +222,9 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
 
   mitk::Image::ConstPointer input = dynamic_cast<const mitk::Image *>(this->GetInput());
 
+  std::vector<mitk::Point3D> pathPoints;
+  pathPoints.reserve(shortestPath.size());
+
   ShortestPathType::const_iterator pathIterator = shortestPath.begin();
 
   while (pathIterator != shortestPath.end())
@@ -232,10 +235,12 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
     currentPoint[2] = 0.0;
 
     input->GetGeometry()->IndexToWorld(currentPoint, currentPoint);
-    output->AddVertex(currentPoint, false, m_TimeStep);
+    pathPoints.push_back(currentPoint);
 
     pathIterator++;
   }
+
+  output->AddVertices(pathPoints, false, m_TimeStep);
 }
 
 bool mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMap(mitk::ContourModel *path)
@@ -12,10 +12,9 @@ found in the LICENSE file.
 
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 #include "mitkImageAccessByItk.h"
-#include "mitkImageCast.h"
-#include <mitkITKImageImport.h>
 
 #include <itkFastChamferDistanceImageFilter.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
 #include <itkInvertIntensityImageFilter.h>
 #include <itkIsoContourDistanceImageFilter.h>
 #include <itkSubtractImageFilter.h>
@@ -31,30 +30,42 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   unsigned int /*timeStep*/,
   Image::ConstPointer /*referenceImage*/)
 {
-  mitk::Image::Pointer lowerDistanceImage = mitk::Image::New();
+  DistanceImageType::Pointer lowerDistanceImage;
   AccessFixedDimensionByItk_1(lowerSlice, ComputeDistanceMap, 2, lowerDistanceImage);
 
-  mitk::Image::Pointer upperDistanceImage = mitk::Image::New();
+  DistanceImageType::Pointer upperDistanceImage;
   AccessFixedDimensionByItk_1(upperSlice, ComputeDistanceMap, 2, upperDistanceImage);
 
   // calculate where the current slice is in comparison to the lower and upper neighboring slices
   float ratio = (float)(requestedIndex - lowerSliceIndex) / (float)(upperSliceIndex - lowerSliceIndex);
-  AccessFixedDimensionByItk_3(
-    resultImage, InterpolateIntermediateSlice, 2, upperDistanceImage, lowerDistanceImage, ratio);
+  AccessFixedDimensionByItk_3(resultImage,
+                              InterpolateIntermediateSlice,
+                              2,
+                              lowerDistanceImage.GetPointer(),
+                              upperDistanceImage.GetPointer(),
+                              ratio);
 
   return resultImage;
 }
 
+mitk::ShapeBasedInterpolationAlgorithm::DistanceImageType::Pointer
+  mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const BinarySliceType *binarySlice)
+{
+  DistanceImageType::Pointer result;
+  ComputeDistanceMap(binarySlice, result);
+  return result;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *binaryImage,
-                                                                mitk::Image::Pointer &result)
+                                                                DistanceImageType::Pointer &result)
 {
   typedef itk::Image<TPixel, VImageDimension> DistanceFilterInputImageType;
 
-  typedef itk::FastChamferDistanceImageFilter<DistanceFilterImageType, DistanceFilterImageType> DistanceFilterType;
-  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceFilterImageType> IsoContourType;
+  typedef itk::FastChamferDistanceImageFilter<DistanceImageType, DistanceImageType> DistanceFilterType;
+  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceImageType> IsoContourType;
   typedef itk::InvertIntensityImageFilter<DistanceFilterInputImageType> InvertIntensityImageFilterType;
-  typedef itk::SubtractImageFilter<DistanceFilterImageType, DistanceFilterImageType> SubtractImageFilterType;
+  typedef itk::SubtractImageFilter<DistanceImageType, DistanceImageType> SubtractImageFilterType;
 
   typename DistanceFilterType::Pointer distanceFilter = DistanceFilterType::New();
   typename DistanceFilterType::Pointer distanceFilterInverted = DistanceFilterType::New();
@@ -90,45 +101,35 @@ void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image
   subtractImageFilter->SetInput1(distanceFilterInverted->GetOutput());
   subtractImageFilter->Update();
 
-  result = mitk::GrabItkImageMemory(subtractImageFilter->GetOutput());
+  result = subtractImageFilter->GetOutput();
+  result->DisconnectPipeline();
 }
 
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                                                          const mitk::Image::Pointer &lower,
-                                                                          const mitk::Image::Pointer &upper,
+                                                                          const DistanceImageType *lower,
+                                                                          const DistanceImageType *upper,
                                                                           float ratio)
 {
-  typename DistanceFilterImageType::Pointer lowerITK = DistanceFilterImageType::New();
-  typename DistanceFilterImageType::Pointer upperITK = DistanceFilterImageType::New();
-
-  CastToItkImage(lower, lowerITK);
-  CastToItkImage(upper, upperITK);
-
-  itk::ImageRegionConstIteratorWithIndex<DistanceFilterImageType> lowerIter(lowerITK,
-                                                                            lowerITK->GetLargestPossibleRegion());
+  itk::ImageRegionConstIteratorWithIndex<DistanceImageType> lowerIter(lower, lower->GetLargestPossibleRegion());
 
   lowerIter.GoToBegin();
 
-  if (!lowerITK->GetLargestPossibleRegion().IsInside(upperITK->GetLargestPossibleRegion()) ||
-      !lowerITK->GetLargestPossibleRegion().IsInside(result->GetLargestPossibleRegion()))
+  if (!lower->GetLargestPossibleRegion().IsInside(upper->GetLargestPossibleRegion()) ||
+      !lower->GetLargestPossibleRegion().IsInside(result->GetLargestPossibleRegion()))
   {
     // TODO Exception etc.
     MITK_ERROR << "The regions of the slices for the 2D interpolation are not equally sized!";
     return;
   }
 
-  float weight[2] = {1.0f - ratio, ratio};
-
   while (!lowerIter.IsAtEnd())
   {
-    typename DistanceFilterImageType::PixelType lowerPixelVal = lowerIter.Get();
-    typename DistanceFilterImageType::PixelType upperPixelVal = upperITK->GetPixel(lowerIter.GetIndex());
-
-    typename DistanceFilterImageType::PixelType intermediatePixelVal =
-      (weight[0] * upperPixelVal + weight[1] * lowerPixelVal > 0 ? 0 : 1);
+    typename DistanceImageType::PixelType lowerPixelVal = lowerIter.Get();
+    typename DistanceImageType::PixelType upperPixelVal = upper->GetPixel(lowerIter.GetIndex());
 
-    result->SetPixel(lowerIter.GetIndex(), static_cast<TPixel>(intermediatePixelVal));
+    result->SetPixel(lowerIter.GetIndex(),
+                     static_cast<TPixel>(IsInside(lowerPixelVal, upperPixelVal, ratio) ? 1 : 0));
 
     ++lowerIter;
   }
@@ -47,16 +47,34 @@ namespace mitk
                                  unsigned int timeStep,
                                  Image::ConstPointer referenceImage) override;
 
-  private:
-    typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
+    typedef itk::Image<mitk::ScalarType, 2> DistanceImageType;
+    typedef itk::Image<unsigned char, 2> BinarySliceType;
+
+    /**
+      \brief Computes the signed distance map of a binary slice (values 0 and 1).
+
+      Distances are negative inside and positive outside of the segmentation.
+    */
+    static DistanceImageType::Pointer ComputeDistanceMap(const BinarySliceType *binarySlice);
 
+    /**
+      \brief Decides whether a pixel belongs to the interpolated segmentation.
+
+      \param ratio position of the interpolated slice between the lower (0) and the upper (1) slice.
+    */
+    static bool IsInside(mitk::ScalarType lowerDistance, mitk::ScalarType upperDistance, float ratio)
+    {
+      return (1.0f - ratio) * lowerDistance + ratio * upperDistance <= 0;
+    }
+
+  private:
     template <typename TPixel, unsigned int VImageDimension>
-    void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, mitk::Image::Pointer &result);
+    static void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, DistanceImageType::Pointer &result);
 
     template <typename TPixel, unsigned int VImageDimension>
     void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                      const mitk::Image::Pointer &lowerDistanceImage,
-                                      const mitk::Image::Pointer &upperDistanceImage,
+                                      const DistanceImageType *lowerDistanceImage,
+                                      const DistanceImageType *upperDistanceImage,
                                       float ratio);
   };
 
@@ -0,0 +1,370 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSliceRegionWriter.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+  typedef mitk::SliceRegionWriter::RegionType RegionType;
+
+  /** Tolerance (in voxels) for slice pixels to count as voxel centers.*/
+  const double VoxelCenterTolerance = 1e-3;
+
+  /** Voxel of the first pixel of a region and the voxel offsets of one step along the slice axes.*/
+  struct VoxelMapping
+  {
+    itk::Index<3> origin;
+    itk::Offset<3> axis[2];
+  };
+
+  mitk::ExtractSliceFilter::Pointer CreateExtractor(const mitk::Image *volume,
+                                                    unsigned int timeStep,
+                                                    const mitk::PlaneGeometry *plane,
+                                                    const RegionType &region,
+                                                    vtkImageReslice *reslice)
+  {
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(volume);
+    extractor->SetTimeStep(timeStep);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(true);
+    extractor->SetResliceTransformByGeometry(volume->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
+    extractor->SetOutputRegion(region.GetIndex(0), region.GetIndex(1), region.GetSize(0), region.GetSize(1));
+    extractor->UpdateOutputInformation();
+
+    const mitk::Image *output = extractor->GetOutput();
+    if (output->GetDimension(0) != region.GetSize(0) || output->GetDimension(1) != region.GetSize(1))
+    {
+      mitkThrow() << "Region " << region.GetIndex() << " " << region.GetSize() << " exceeds the slice.";
+    }
+
+    return extractor;
+  }
+
+  /** Determines whether the pixels of the region are voxel centers of the volume and the slice axes are aligned
+   * with the volume axes. Only the corners of the region are checked, the mapping is affine.*/
+  bool ComputeVoxelMapping(const mitk::Image *volume,
+                           unsigned int timeStep,
+                           const mitk::PlaneGeometry *plane,
+                           mitk::ExtractSliceFilter *extractor,
+                           const RegionType &region,
+                           VoxelMapping &mapping)
+  {
+    const mitk::BaseGeometry *volumeGeometry = volume->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+    const mitk::Point3D origin = extractor->GetOutput()->GetGeometry()->GetOrigin();
+    const mitk::ScalarType *spacing = extractor->GetOutputSpacing();
+
+    mitk::Vector3D axes[2] = {plane->GetAxisVector(0), plane->GetAxisVector(1)};
+
+    mitk::Point3D originIndex;
+    volumeGeometry->WorldToIndex(origin, originIndex);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      mapping.origin[i] = std::lround(originIndex[i]);
+    }
+
+    int alignedAxis[2] = {-1, -1};
+    for (unsigned int a = 0; a < 2; ++a)
+    {
+      axes[a].Normalize();
+      axes[a] *= spacing[a];
+
+      mitk::Vector3D axisIndex;
+      volumeGeometry->WorldToIndex(axes[a], axisIndex);
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        mapping.axis[a][i] = std::lround(axisIndex[i]);
+        if (std::abs(axisIndex[i] - mapping.axis[a][i]) > VoxelCenterTolerance)
+          return false;
+
+        if (mapping.axis[a][i] != 0)
+        {
+          if (alignedAxis[a] != -1 || std::abs(mapping.axis[a][i]) != 1)
+            return false;
+          alignedAxis[a] = i;
+        }
+      }
+    }
+
+    if (alignedAxis[0] == -1 || alignedAxis[1] == -1 || alignedAxis[0] == alignedAxis[1])
+      return false;
+
+    const itk::OffsetValueType corners[2][2] = {{0, static_cast<itk::OffsetValueType>(region.GetSize(0)) - 1},
+                                                {0, static_cast<itk::OffsetValueType>(region.GetSize(1)) - 1}};
+    for (const auto x : corners[0])
+    {
+      for (const auto y : corners[1])
+      {
+        mitk::Point3D cornerIndex;
+        volumeGeometry->WorldToIndex(origin + axes[0] * x + axes[1] * y, cornerIndex);
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          const itk::IndexValueType voxel = mapping.origin[i] + mapping.axis[0][i] * x + mapping.axis[1][i] * y;
+          if (std::abs(cornerIndex[i] - voxel) > VoxelCenterTolerance || voxel < 0 ||
+              voxel >= static_cast<itk::IndexValueType>(volume->GetDimension(i)))
+            return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /** Calls copy(volumeOffset, regionOffset, numberOfBytes) for the runs of pixels of the region that are contiguous
+   * in the volume memory. The offsets are in bytes.*/
+  template <typename TCopy>
+  void ForEachRun(const mitk::Image *volume, const VoxelMapping &mapping, const RegionType &region, TCopy copy)
+  {
+    const std::ptrdiff_t pixelSize = volume->GetPixelType().GetSize();
+    const std::ptrdiff_t strides[3] = {pixelSize,
+                                       pixelSize * volume->GetDimension(0),
+                                       pixelSize * volume->GetDimension(0) * volume->GetDimension(1)};
+
+    std::ptrdiff_t rowStart = 0;
+    std::ptrdiff_t columnStride = 0;
+    std::ptrdiff_t rowStride = 0;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      rowStart += mapping.origin[i] * strides[i];
+      columnStride += mapping.axis[0][i] * strides[i];
+      rowStride += mapping.axis[1][i] * strides[i];
+    }
+
+    const std::ptrdiff_t width = region.GetSize(0);
+    const std::ptrdiff_t height = region.GetSize(1);
+    for (std::ptrdiff_t y = 0; y < height; ++y, rowStart += rowStride)
+    {
+      if (columnStride == pixelSize)
+      {
+        copy(rowStart, y * width * pixelSize, width * pixelSize);
+      }
+      else
+      {
+        std::ptrdiff_t voxel = rowStart;
+        for (std::ptrdiff_t x = 0; x < width; ++x, voxel += columnStride)
+        {
+          copy(voxel, (y * width + x) * pixelSize, pixelSize);
+        }
+      }
+    }
+  }
+
+  bool IsSlice(const mitk::Image *image)
+  {
+    return image != nullptr && image->IsInitialized() && image->GetDimension(2) == 1;
+  }
+}
+
+mitk::SliceRegionWriter::SliceRegionWriter()
+{
+}
+
+mitk::SliceRegionWriter::~SliceRegionWriter()
+{
+}
+
+mitk::SliceRegionWriter::RegionType mitk::SliceRegionWriter::GetLargestPossibleRegion(const Image *slice)
+{
+  RegionType region;
+  if (IsSlice(slice))
+  {
+    region.SetSize(0, slice->GetDimension(0));
+    region.SetSize(1, slice->GetDimension(1));
+  }
+  return region;
+}
+
+mitk::SliceRegionWriter::RegionType mitk::SliceRegionWriter::ComputeDifferenceRegion(const Image *originalSlice,
+                                                                                     const Image *modifiedSlice)
+{
+  if (!IsSlice(originalSlice) || !IsSlice(modifiedSlice) ||
+      originalSlice->GetDimension(0) != modifiedSlice->GetDimension(0) ||
+      originalSlice->GetDimension(1) != modifiedSlice->GetDimension(1) ||
+      !(originalSlice->GetPixelType() == modifiedSlice->GetPixelType()))
+  {
+    return GetLargestPossibleRegion(modifiedSlice);
+  }
+
+  ImageReadAccessor originalAccessor(originalSlice);
+  ImageReadAccessor modifiedAccessor(modifiedSlice);
+  const auto *original = static_cast<const char *>(originalAccessor.GetData());
+  const auto *modified = static_cast<const char *>(modifiedAccessor.GetData());
+
+  const std::size_t pixelSize = modifiedSlice->GetPixelType().GetSize();
+  const std::size_t width = modifiedSlice->GetDimension(0);
+  const std::size_t height = modifiedSlice->GetDimension(1);
+  const std::size_t rowSize = width * pixelSize;
+
+  std::size_t minX = width;
+  std::size_t maxX = 0;
+  std::size_t minY = height;
+  std::size_t maxY = 0;
+  for (std::size_t y = 0; y < height; ++y, original += rowSize, modified += rowSize)
+  {
+    if (0 == std::memcmp(original, modified, rowSize))
+      continue;
+
+    std::size_t first = 0;
+    while (0 == std::memcmp(original + first * pixelSize, modified + first * pixelSize, pixelSize))
+      ++first;
+
+    std::size_t last = width - 1;
+    while (0 == std::memcmp(original + last * pixelSize, modified + last * pixelSize, pixelSize))
+      --last;
+
+    minX = std::min(minX, first);
+    maxX = std::max(maxX, last);
+    minY = std::min(minY, y);
+    maxY = y;
+  }
+
+  RegionType region;
+  if (minY < height)
+  {
+    region.SetIndex(0, minX);
+    region.SetIndex(1, minY);
+    region.SetSize(0, maxX - minX + 1);
+    region.SetSize(1, maxY - minY + 1);
+  }
+  return region;
+}
+
+mitk::Image::Pointer mitk::SliceRegionWriter::CropSlice(const Image *slice, const RegionType &region)
+{
+  if (!IsSlice(slice) || 0 == region.GetNumberOfPixels() || !GetLargestPossibleRegion(slice).IsInside(region))
+  {
+    mitkThrow() << "Region " << region.GetIndex() << " " << region.GetSize() << " is not inside the slice.";
+  }
+
+  // the geometry of the region: the slice geometry starting at the first pixel of the region
+  PlaneGeometry::Pointer geometry = slice->GetSlicedGeometry()->GetPlaneGeometry(0)->Clone();
+  Point3D origin;
+  origin[0] = region.GetIndex(0);
+  origin[1] = region.GetIndex(1);
+  origin[2] = 0.0;
+  geometry->IndexToWorld(origin, origin);
+  geometry->SetOrigin(origin);
+
+  BoundingBox::BoundsArrayType bounds;
+  bounds.Fill(0.0);
+  bounds[1] = region.GetSize(0);
+  bounds[3] = region.GetSize(1);
+  bounds[5] = 1.0;
+  geometry->SetBounds(bounds);
+
+  Image::Pointer result = Image::New();
+  result->Initialize(slice->GetPixelType(), 1, *geometry);
+
+  ImageReadAccessor sliceAccessor(slice);
+  ImageWriteAccessor resultAccessor(result);
+
+  const std::size_t pixelSize = slice->GetPixelType().GetSize();
+  const std::size_t sliceRowSize = slice->GetDimension(0) * pixelSize;
+  const std::size_t rowSize = region.GetSize(0) * pixelSize;
+
+  const char *source = static_cast<const char *>(sliceAccessor.GetData()) + region.GetIndex(1) * sliceRowSize +
+                       region.GetIndex(0) * pixelSize;
+  char *target = static_cast<char *>(resultAccessor.GetData());
+  for (std::size_t y = 0; y < region.GetSize(1); ++y, source += sliceRowSize, target += rowSize)
+  {
+    std::memcpy(target, source, rowSize);
+  }
+
+  return result;
+}
+
+mitk::Image::Pointer mitk::SliceRegionWriter::ExtractRegion(const Image *volume,
+                                                            unsigned int timeStep,
+                                                            const PlaneGeometry *plane,
+                                                            const RegionType &region)
+{
+  // use the same reslicer as SegTool2D to extract exactly the same pixels
+  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  reslice->SetOverwriteMode(false);
+
+  ExtractSliceFilter::Pointer extractor = CreateExtractor(volume, timeStep, plane, region, reslice);
+
+  Image::Pointer result = Image::New();
+  result->Initialize(volume->GetPixelType(), 1, *extractor->GetOutput()->GetSlicedGeometry()->GetPlaneGeometry(0));
+
+  VoxelMapping mapping;
+  if (ComputeVoxelMapping(volume, timeStep, plane, extractor, region, mapping))
+  {
+    ImageReadAccessor volumeAccessor(volume, volume->GetVolumeData(timeStep));
+    ImageWriteAccessor resultAccessor(result);
+
+    const auto *volumeData = static_cast<const char *>(volumeAccessor.GetData());
+    auto *resultData = static_cast<char *>(resultAccessor.GetData());
+    ForEachRun(volume, mapping, region, [&](std::ptrdiff_t volumeOffset, std::ptrdiff_t regionOffset, std::size_t size) {
+      std::memcpy(resultData + regionOffset, volumeData + volumeOffset, size);
+    });
+  }
+  else
+  {
+    extractor->Modified();
+    extractor->Update();
+    result->SetVolume(extractor->GetVtkOutput()->GetScalarPointer());
+  }
+
+  return result;
+}
+
+void mitk::SliceRegionWriter::WriteRegion(
+  Image *volume, unsigned int timeStep, const PlaneGeometry *plane, const Image *regionSlice, const RegionType &region)
+{
+  if (!IsSlice(regionSlice) || regionSlice->GetDimension(0) != region.GetSize(0) ||
+      regionSlice->GetDimension(1) != region.GetSize(1) || !(regionSlice->GetPixelType() == volume->GetPixelType()))
+  {
+    mitkThrow() << "The region slice does not match the region or the pixel type of the volume.";
+  }
+
+  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  ExtractSliceFilter::Pointer extractor = CreateExtractor(volume, timeStep, plane, region, reslice);
+
+  VoxelMapping mapping;
+  if (ComputeVoxelMapping(volume, timeStep, plane, extractor, region, mapping))
+  {
+    ImageWriteAccessor volumeAccessor(volume, volume->GetVolumeData(timeStep));
+    ImageReadAccessor regionAccessor(regionSlice);
+
+    auto *volumeData = static_cast<char *>(volumeAccessor.GetData());
+    const auto *regionData = static_cast<const char *>(regionAccessor.GetData());
+    ForEachRun(volume, mapping, region, [&](std::ptrdiff_t volumeOffset, std::ptrdiff_t regionOffset, std::size_t size) {
+      std::memcpy(volumeData + volumeOffset, regionData + regionOffset, size);
+    });
+  }
+  else
+  {
+    // reverse reslicing of the region only; the reslicer writes the pixels of its output (the region) into the volume
+    reslice->SetInputSlice(const_cast<Image *>(regionSlice)->GetVtkImageData());
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    extractor->Modified();
+    extractor->Update();
+  }
+}
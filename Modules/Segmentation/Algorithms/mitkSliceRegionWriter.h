@@ -0,0 +1,85 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSliceRegionWriter_h_Included
+#define mitkSliceRegionWriter_h_Included
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkImageRegion.h>
+
+namespace mitk
+{
+  /**
+   * \brief Reads and writes rectangular regions of slices of an image volume.
+   *
+   * The slices are the ones extracted by SegTool2D::GetAffectedImageSliceAs2DImage(), i.e. by ExtractSliceFilter
+   * with mitkVtkImageOverwrite. Regions are given in pixel indices of the whole slice.
+   *
+   * If the pixels of the slice fall onto voxel centers of the volume and the slice axes are aligned with the volume
+   * axes, the rows of the region are copied directly from or into the volume memory. Otherwise the region is
+   * (reverse) resliced by mitkVtkImageOverwrite, restricted to the region.
+   */
+  class MITKSEGMENTATION_EXPORT SliceRegionWriter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(SliceRegionWriter, itk::Object);
+
+    typedef itk::ImageRegion<2> RegionType;
+
+    /**
+      \brief Returns the region covering the whole 2D image.
+    */
+    static RegionType GetLargestPossibleRegion(const Image *slice);
+
+    /**
+      \brief Returns the bounding box of all pixels that differ between the two 2D images.
+
+      The images need to have the same size and pixel type, otherwise the whole region of \a modifiedSlice is
+      returned. The region is empty if the images are equal.
+    */
+    static RegionType ComputeDifferenceRegion(const Image *originalSlice, const Image *modifiedSlice);
+
+    /**
+      \brief Copies a region of a 2D image into a new image of the size of the region.
+    */
+    static Image::Pointer CropSlice(const Image *slice, const RegionType &region);
+
+    /**
+      \brief Extracts a region of the slice defined by \a plane from the volume.
+    */
+    static Image::Pointer ExtractRegion(const Image *volume,
+                                        unsigned int timeStep,
+                                        const PlaneGeometry *plane,
+                                        const RegionType &region);
+
+    /**
+      \brief Writes \a regionSlice into the region of the slice defined by \a plane.
+
+      \a regionSlice has the size of \a region and the pixel type of the volume, e.g. the result of CropSlice() or
+      ExtractRegion(). The volume is not marked as modified.
+    */
+    static void WriteRegion(Image *volume,
+                            unsigned int timeStep,
+                            const PlaneGeometry *plane,
+                            const Image *regionSlice,
+                            const RegionType &region);
+
+  protected:
+    SliceRegionWriter();
+    ~SliceRegionWriter() override;
+  };
+}
+
+#endif
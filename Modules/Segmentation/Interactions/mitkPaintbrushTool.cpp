@@ -68,6 +68,7 @@ void mitk::PaintbrushTool::Deactivated()
   if (m_ToolManager->GetDataStorage()->Exists(m_WorkingNode))
     m_ToolManager->GetDataStorage()->Remove(m_WorkingNode);
   m_WorkingSlice = nullptr;
+  m_OriginalSlice = nullptr;
   m_CurrentPlane = nullptr;
   m_ToolManager->WorkingDataChanged -=
     mitk::MessageDelegate<mitk::PaintbrushTool>(this, &mitk::PaintbrushTool::OnToolManagerWorkingDataModified);
@@ -495,7 +496,11 @@ void mitk::PaintbrushTool::OnMouseReleased(StateMachineAction *, InteractionEven
   if (!positionEvent)
     return;
 
-  this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone());
+  // only the region touched by the brush is written back; if nothing changed (e.g. painting over pixels that
+  // already had the label), neither the image nor the undo stack is touched
+  const SliceRegionType dirtyRegion = SliceRegionWriter::ComputeDifferenceRegion(m_OriginalSlice, m_WorkingSlice);
+  if (dirtyRegion.GetNumberOfPixels() > 0)
+    this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone(), dirtyRegion);
 
   // deactivate visibility of helper node
   m_WorkingNode->SetVisibility(false);
@@ -540,7 +545,8 @@ void mitk::PaintbrushTool::CheckIfCurrentSliceHasChanged(const InteractionPositi
   if (m_CurrentPlane.IsNull() || m_WorkingSlice.IsNull())
   {
     m_CurrentPlane = planeGeometry;
-    m_WorkingSlice = SegTool2D::GetAffectedImageSliceAs2DImage(event, image)->Clone();
+    m_OriginalSlice = SegTool2D::GetAffectedImageSliceAs2DImage(event, image);
+    m_WorkingSlice = m_OriginalSlice->Clone();
     m_WorkingNode->ReplaceProperty("color", workingNode->GetProperty("color"));
     m_WorkingNode->SetData(m_WorkingSlice);
   }
@@ -558,7 +564,8 @@ void mitk::PaintbrushTool::CheckIfCurrentSliceHasChanged(const InteractionPositi
       m_WorkingSlice = nullptr;
       m_WorkingNode = nullptr;
       m_CurrentPlane = planeGeometry;
-      m_WorkingSlice = SegTool2D::GetAffectedImageSliceAs2DImage(event, image)->Clone();
+      m_OriginalSlice = SegTool2D::GetAffectedImageSliceAs2DImage(event, image);
+      m_WorkingSlice = m_OriginalSlice->Clone();
 
       m_WorkingNode = mitk::DataNode::New();
       m_WorkingNode->SetProperty("levelwindow", mitk::LevelWindowProperty::New(mitk::LevelWindow(0, 1)));
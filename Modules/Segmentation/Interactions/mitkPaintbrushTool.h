@@ -93,6 +93,8 @@ namespace mitk
     int m_LastContourSize;
 
     Image::Pointer m_WorkingSlice;
+    /** The slice as extracted from the working image, to determine the region modified by painting.*/
+    Image::Pointer m_OriginalSlice;
     PlaneGeometry::ConstPointer m_CurrentPlane;
     DataNode::Pointer m_WorkingNode;
     mitk::Point3D m_LastPosition;
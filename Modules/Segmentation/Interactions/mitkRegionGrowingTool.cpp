@@ -611,6 +611,8 @@ void mitk::RegionGrowingTool::OnMouseReleased(StateMachineAction *, InteractionE
 
       MITK_DEBUG << "Filling Segmentation";
 
+      Image::Pointer originalSlice = m_WorkingSlice->Clone();
+
       if (labelImage != nullptr)
       {
         // m_PaintingPixelValue only decides whether to paint or not
@@ -630,7 +632,10 @@ void mitk::RegionGrowingTool::OnMouseReleased(StateMachineAction *, InteractionE
                                                     m_WorkingSlice,
                                                     m_PaintingPixelValue);
       }
-      this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice);
+      // only the filled region is written back; if nothing changed, neither the image nor the undo stack is touched
+      const SliceRegionType dirtyRegion = SliceRegionWriter::ComputeDifferenceRegion(originalSlice, m_WorkingSlice);
+      if (dirtyRegion.GetNumberOfPixels() > 0)
+        this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice, dirtyRegion);
       FeedbackContourTool::SetFeedbackContourVisible(false);
     }
 
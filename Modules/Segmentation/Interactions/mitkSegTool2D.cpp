@@ -288,7 +288,9 @@ mitk::Image::Pointer mitk::SegTool2D::GetAffectedReferenceSlice(const Interactio
   }
 }
 
-void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent, Image *slice)
+void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent,
+                                                  Image *slice,
+                                                  const SliceRegionType &dirtyRegion)
 {
   if (!positionEvent)
     return;
@@ -302,18 +304,19 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent
     DataNode *workingNode(m_ToolManager->GetWorkingData(0));
     auto *image = dynamic_cast<Image *>(workingNode->GetData());
     unsigned int timeStep = positionEvent->GetSender()->GetTimeStep(image);
-    this->WriteBackSegmentationResult(planeGeometry, slice, timeStep);
+    this->WriteBackSegmentationResult(planeGeometry, slice, timeStep, dirtyRegion);
   }
 }
 
 void mitk::SegTool2D::WriteBackSegmentationResult(const PlaneGeometry *planeGeometry,
                                                   Image *slice,
-                                                  unsigned int timeStep)
+                                                  unsigned int timeStep,
+                                                  const SliceRegionType &dirtyRegion)
 {
   if (!planeGeometry || !slice)
     return;
 
-  SliceInformation sliceInfo(slice, const_cast<mitk::PlaneGeometry *>(planeGeometry), timeStep);
+  SliceInformation sliceInfo(slice, const_cast<mitk::PlaneGeometry *>(planeGeometry), timeStep, dirtyRegion);
   this->WriteSliceToVolume(sliceInfo);
   DataNode *workingNode(m_ToolManager->GetWorkingData(0));
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
@@ -368,51 +371,78 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   DataNode *workingNode(m_ToolManager->GetWorkingData(0));
   auto *image = dynamic_cast<Image *>(workingNode->GetData());
 
-  /*============= BEGIN undo/redo feature block ========================*/
-  // Create undo operation by caching the not yet modified slices
-  mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
-  auto *undoOperation =
-    new DiffSliceOperation(image,
-                           originalSlice,
-                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
-  /*============= END undo/redo feature block ========================*/
-
-  // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
-  // reslicer
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-  // Set the slice as 'input'
-  reslice->SetInputSlice(sliceInfo.slice->GetVtkImageData());
-
-  // set overwrite mode to true to write back to the image volume
-  reslice->SetOverwriteMode(true);
-  reslice->Modified();
-
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(image);
-  extractor->SetTimeStep(sliceInfo.timestep);
-  extractor->SetWorldGeometry(sliceInfo.plane);
-  extractor->SetVtkOutputRequest(false);
-  extractor->SetResliceTransformByGeometry(image->GetGeometry(sliceInfo.timestep));
+  DiffSliceOperation *undoOperation = nullptr;
+  DiffSliceOperation *doOperation = nullptr;
 
-  extractor->Modified();
-  extractor->Update();
+  if (sliceInfo.dirtyRegion.GetNumberOfPixels() > 0)
+  {
+    // only the modified region is written back and stored for undo/redo
+    mitk::Image::Pointer originalRegion =
+      SliceRegionWriter::ExtractRegion(image, sliceInfo.timestep, sliceInfo.plane, sliceInfo.dirtyRegion);
+    mitk::Image::Pointer editedRegion = SliceRegionWriter::CropSlice(sliceInfo.slice, sliceInfo.dirtyRegion);
+
+    undoOperation = new DiffSliceOperation(image,
+                                           originalRegion,
+                                           dynamic_cast<SlicedGeometry3D *>(originalRegion->GetGeometry()),
+                                           sliceInfo.timestep,
+                                           sliceInfo.plane,
+                                           sliceInfo.dirtyRegion);
+
+    SliceRegionWriter::WriteRegion(image, sliceInfo.timestep, sliceInfo.plane, editedRegion, sliceInfo.dirtyRegion);
+
+    doOperation = new DiffSliceOperation(image,
+                                         editedRegion,
+                                         dynamic_cast<SlicedGeometry3D *>(editedRegion->GetGeometry()),
+                                         sliceInfo.timestep,
+                                         sliceInfo.plane,
+                                         sliceInfo.dirtyRegion);
+  }
+  else
+  {
+    /*============= BEGIN undo/redo feature block ========================*/
+    // Create undo operation by caching the not yet modified slices
+    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, image, sliceInfo.timestep);
+    undoOperation = new DiffSliceOperation(image,
+                                           originalSlice,
+                                           dynamic_cast<SlicedGeometry3D *>(originalSlice->GetGeometry()),
+                                           sliceInfo.timestep,
+                                           sliceInfo.plane);
+    /*============= END undo/redo feature block ========================*/
+
+    // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
+    // reslicer
+    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+    // Set the slice as 'input'
+    reslice->SetInputSlice(sliceInfo.slice->GetVtkImageData());
+
+    // set overwrite mode to true to write back to the image volume
+    reslice->SetOverwriteMode(true);
+    reslice->Modified();
+
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(image);
+    extractor->SetTimeStep(sliceInfo.timestep);
+    extractor->SetWorldGeometry(sliceInfo.plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(image->GetGeometry(sliceInfo.timestep));
+
+    extractor->Modified();
+    extractor->Update();
+
+    // specify the undo operation with the edited slice
+    doOperation = new DiffSliceOperation(image,
+                                         extractor->GetOutput(),
+                                         dynamic_cast<SlicedGeometry3D *>(sliceInfo.slice->GetGeometry()),
+                                         sliceInfo.timestep,
+                                         sliceInfo.plane);
+  }
 
   // the image was modified within the pipeline, but not marked so
   image->Modified();
   image->GetVtkImageData()->Modified();
 
   /*============= BEGIN undo/redo feature block ========================*/
-  // specify the undo operation with the edited slice
-  auto *doOperation =
-    new DiffSliceOperation(image,
-                           extractor->GetOutput(),
-                           dynamic_cast<SlicedGeometry3D *>(sliceInfo.slice->GetGeometry()),
-                           sliceInfo.timestep,
-                           sliceInfo.plane);
-
   // create an operation event for the undo stack
   OperationEvent *undoStackItem =
     new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
@@ -25,6 +25,7 @@ found in the LICENSE file.
 #include "mitkRestorePlanePositionOperation.h"
 
 #include <mitkDiffSliceOperation.h>
+#include <mitkSliceRegionWriter.h>
 
 namespace mitk
 {
@@ -96,18 +97,26 @@ namespace mitk
     SegTool2D(const char *, const us::Module *interactorModule = nullptr); // purposely hidden
     ~SegTool2D() override;
 
+    typedef SliceRegionWriter::RegionType SliceRegionType;
+
     struct SliceInformation
     {
       mitk::Image::Pointer slice;
       mitk::PlaneGeometry *plane;
       unsigned int timestep;
+      /** Region of the slice that was modified. An empty region denotes the whole slice.*/
+      SliceRegionType dirtyRegion;
 
       SliceInformation() {}
-      SliceInformation(mitk::Image *slice, mitk::PlaneGeometry *plane, unsigned int timestep)
+      SliceInformation(mitk::Image *slice,
+                       mitk::PlaneGeometry *plane,
+                       unsigned int timestep,
+                       const SliceRegionType &dirtyRegion = SliceRegionType())
       {
         this->slice = slice;
         this->plane = plane;
         this->timestep = timestep;
+        this->dirtyRegion = dirtyRegion;
       }
     };
 
@@ -158,9 +167,22 @@ namespace mitk
     */
     Image::Pointer GetAffectedReferenceSlice(const InteractionPositionEvent *);
 
-    void WriteBackSegmentationResult(const InteractionPositionEvent *, Image *);
+    /**
+      \brief Writes the edited slice back into the working image and creates the undo operation.
 
-    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry, Image *, unsigned int timeStep);
+      \param dirtyRegion The region of the slice that was modified by the tool. Only this region is written into the
+      working image and stored for undo/redo. An empty region (default) writes the whole slice, so tools that
+      computed an empty difference region (nothing changed) must not call this method.
+      \sa SliceRegionWriter::ComputeDifferenceRegion
+    */
+    void WriteBackSegmentationResult(const InteractionPositionEvent *,
+                                     Image *,
+                                     const SliceRegionType &dirtyRegion = SliceRegionType());
+
+    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry,
+                                     Image *,
+                                     unsigned int timeStep,
+                                     const SliceRegionType &dirtyRegion = SliceRegionType());
 
     void WriteBackSegmentationResult(const std::vector<SliceInformation> &sliceList, bool writeSliceToVolume = true);
 
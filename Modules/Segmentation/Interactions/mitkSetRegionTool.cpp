@@ -170,10 +170,15 @@ void mitk::SetRegionTool::OnMouseReleased(StateMachineAction *, InteractionEvent
     activeColor = labelImage->GetActiveLabel()->GetValue();
   }
 
+  Image::Pointer originalSlice = slice->Clone();
+
   mitk::ContourModelUtils::FillContourInSlice(
     projectedContour, timeStep, slice, image, m_PaintingPixelValue * activeColor);
 
-  this->WriteBackSegmentationResult(positionEvent, slice);
+  // only the filled region is written back; if nothing changed, neither the image nor the undo stack is touched
+  const SliceRegionType dirtyRegion = SliceRegionWriter::ComputeDifferenceRegion(originalSlice, slice);
+  if (dirtyRegion.GetNumberOfPixels() > 0)
+    this->WriteBackSegmentationResult(positionEvent, slice, dirtyRegion);
 }
 
 void mitk::SetRegionTool::OnMouseMoved(mitk::StateMachineAction *, mitk::InteractionEvent *)
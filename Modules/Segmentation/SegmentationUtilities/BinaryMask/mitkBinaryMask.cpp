@@ -0,0 +1,525 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBinaryMask.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkParallelFor.h>
+#include <mitkPixelTypeMultiplex.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+
+namespace
+{
+  typedef mitk::BinaryMask::WordType WordType;
+
+  const unsigned int BitsPerWord = 64;
+
+  /** Sets the bits of out that are the bits of in, moved by shift bits (positive shifts move towards higher x).*/
+  void ShiftOr(const WordType *in, std::size_t inWords, WordType *out, std::size_t outWords, std::ptrdiff_t shift)
+  {
+    const std::ptrdiff_t wordShift = shift >= 0 ? shift / BitsPerWord : -((-shift + BitsPerWord - 1) / BitsPerWord);
+    const unsigned int bitShift = static_cast<unsigned int>(shift - wordShift * BitsPerWord);
+    const std::ptrdiff_t numberOfOutWords = static_cast<std::ptrdiff_t>(outWords);
+
+    for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(inWords); ++i)
+    {
+      const WordType word = in[i];
+      if (word == 0)
+        continue;
+
+      const std::ptrdiff_t target = i + wordShift;
+      if (target >= 0 && target < numberOfOutWords)
+        out[target] |= word << bitShift;
+      if (bitShift != 0 && target + 1 >= 0 && target + 1 < numberOfOutWords)
+        out[target + 1] |= word >> (BitsPerWord - bitShift);
+    }
+  }
+
+  /** Dilates a row by halfLength voxels in both directions. The extension towards higher x is done first, so no bit
+      that is needed later is shifted out of the row. buffer needs the size of a row.*/
+  void DilateRow(const WordType *in,
+                 WordType *out,
+                 WordType *buffer,
+                 std::size_t numberOfWords,
+                 WordType lastWordMask,
+                 unsigned int halfLength)
+  {
+    std::copy(in, in + numberOfWords, out);
+
+    for (int direction = 1; direction >= -1; direction -= 2)
+    {
+      // out covers the offsets [0, covered] in the current direction, adding a copy shifted by at most covered + 1
+      // keeps them contiguous
+      unsigned int covered = 0;
+      while (covered < halfLength)
+      {
+        const unsigned int step = std::min(covered + 1, halfLength - covered);
+        std::copy(out, out + numberOfWords, buffer);
+        ShiftOr(buffer, numberOfWords, out, numberOfWords, direction * static_cast<std::ptrdiff_t>(step));
+        covered += step;
+      }
+    }
+
+    out[numberOfWords - 1] &= lastWordMask;
+  }
+
+  template <typename TPixel>
+  void PackVoxels(const mitk::PixelType &,
+                  const void *data,
+                  const unsigned int *size,
+                  std::size_t wordsPerRow,
+                  WordType *words,
+                  const double *labelValue)
+  {
+    const TPixel *pixels = static_cast<const TPixel *>(data);
+    const bool compareLabel = labelValue != nullptr;
+    const TPixel label = compareLabel ? static_cast<TPixel>(*labelValue) : 0;
+
+    mitk::ParallelForRanges(std::size_t(size[1]) * size[2], 0, [=](std::size_t begin, std::size_t end) {
+      for (std::size_t row = begin; row < end; ++row)
+      {
+        const TPixel *rowPixels = pixels + row * size[0];
+        WordType *rowWords = words + row * wordsPerRow;
+
+        for (unsigned int x = 0; x < size[0]; ++x)
+        {
+          if (compareLabel ? rowPixels[x] == label : rowPixels[x] != 0)
+            rowWords[x / BitsPerWord] |= WordType(1) << (x % BitsPerWord);
+        }
+      }
+    });
+  }
+
+  template <typename TPixel>
+  void UnpackVoxels(const mitk::PixelType &,
+                    void *data,
+                    const unsigned int *size,
+                    std::size_t wordsPerRow,
+                    const WordType *words,
+                    const double *labelValue)
+  {
+    TPixel *pixels = static_cast<TPixel *>(data);
+    const bool writeLabel = labelValue != nullptr;
+    const TPixel label = writeLabel ? static_cast<TPixel>(*labelValue) : 0;
+
+    mitk::ParallelForRanges(std::size_t(size[1]) * size[2], 0, [=](std::size_t begin, std::size_t end) {
+      for (std::size_t row = begin; row < end; ++row)
+      {
+        TPixel *rowPixels = pixels + row * size[0];
+        const WordType *rowWords = words + row * wordsPerRow;
+
+        for (unsigned int x = 0; x < size[0]; ++x)
+        {
+          const bool foreground = 0 != ((rowWords[x / BitsPerWord] >> (x % BitsPerWord)) & 1);
+
+          if (!writeLabel)
+            rowPixels[x] = foreground ? 1 : 0;
+          else if (foreground)
+            rowPixels[x] = label;
+          else if (rowPixels[x] == label)
+            rowPixels[x] = 0;
+        }
+      }
+    });
+  }
+
+  void ValidateImage(const mitk::Image *image, unsigned int timeStep)
+  {
+    if (image == nullptr)
+      mitkThrow() << "Image is nullptr!";
+
+    if (image->GetPixelType().GetNumberOfComponents() != 1)
+      mitkThrow() << "Image is not a scalar image!";
+
+    if (image->GetDimension() < 2 || image->GetDimension() > 4)
+      mitkThrow() << "Image is neither a 2D, 3D nor a 3D+t image!";
+
+    if (timeStep >= image->GetTimeSteps())
+      mitkThrow() << "Image has no time step " << timeStep << "!";
+  }
+}
+
+mitk::BinaryMask::StructuringElementType mitk::BinaryMask::CreateBall(unsigned int radiusX,
+                                                                      unsigned int radiusY,
+                                                                      unsigned int radiusZ)
+{
+  // itk::BinaryBallStructuringElement contains the offsets d with sum((d_i / (radius_i + 0.5))^2) <= 1, which is
+  // sum(4 * d_i^2 * product of (2 * radius_j + 1)^2 for j != i) <= product of (2 * radius_i + 1)^2 in integers
+  const long long diameter[3] = {2ll * radiusX + 1, 2ll * radiusY + 1, 2ll * radiusZ + 1};
+  const long long squaredDiameter[3] = {
+    diameter[0] * diameter[0], diameter[1] * diameter[1], diameter[2] * diameter[2]};
+  const long long limit = squaredDiameter[0] * squaredDiameter[1] * squaredDiameter[2];
+  const long long weight[3] = {4 * squaredDiameter[1] * squaredDiameter[2],
+                               4 * squaredDiameter[0] * squaredDiameter[2],
+                               4 * squaredDiameter[0] * squaredDiameter[1]};
+
+  StructuringElementType structuringElement;
+  for (int z = -static_cast<int>(radiusZ); z <= static_cast<int>(radiusZ); ++z)
+  {
+    for (int y = -static_cast<int>(radiusY); y <= static_cast<int>(radiusY); ++y)
+    {
+      const long long remaining = limit - weight[1] * y * y - weight[2] * z * z;
+      if (remaining < 0)
+        continue;
+
+      unsigned int halfLength = 0;
+      while (halfLength < radiusX && weight[0] * (halfLength + 1) * (halfLength + 1) <= remaining)
+        ++halfLength;
+
+      structuringElement.push_back({y, z, halfLength});
+    }
+  }
+  return structuringElement;
+}
+
+mitk::BinaryMask::StructuringElementType mitk::BinaryMask::CreateCross(unsigned int radiusX,
+                                                                       unsigned int radiusY,
+                                                                       unsigned int radiusZ)
+{
+  StructuringElementType structuringElement;
+  structuringElement.push_back({0, 0, radiusX});
+
+  for (int y = 1; y <= static_cast<int>(radiusY); ++y)
+  {
+    structuringElement.push_back({-y, 0, 0});
+    structuringElement.push_back({y, 0, 0});
+  }
+
+  for (int z = 1; z <= static_cast<int>(radiusZ); ++z)
+  {
+    structuringElement.push_back({0, -z, 0});
+    structuringElement.push_back({0, z, 0});
+  }
+  return structuringElement;
+}
+
+mitk::BinaryMask::BinaryMask(unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ)
+  : m_Size{sizeX, sizeY, sizeZ},
+    m_WordsPerRow((sizeX + BitsPerWord - 1) / BitsPerWord),
+    m_LastWordMask(sizeX % BitsPerWord == 0 ? ~WordType(0) : (WordType(1) << (sizeX % BitsPerWord)) - 1),
+    m_Words(m_WordsPerRow * sizeY * sizeZ, 0)
+{
+}
+
+mitk::BinaryMask mitk::BinaryMask::FromImage(const Image *image, unsigned int timeStep)
+{
+  return ReadImage(image, timeStep, nullptr);
+}
+
+mitk::BinaryMask mitk::BinaryMask::FromLabel(const Image *image, double labelValue, unsigned int timeStep)
+{
+  return ReadImage(image, timeStep, &labelValue);
+}
+
+mitk::BinaryMask mitk::BinaryMask::ReadImage(const Image *image, unsigned int timeStep, const double *labelValue)
+{
+  ValidateImage(image, timeStep);
+
+  BinaryMask mask(image->GetDimension(0), image->GetDimension(1), image->GetDimension(2));
+
+  ImageReadAccessor accessor(image, image->GetVolumeData(timeStep));
+  const PixelType pixelType = image->GetPixelType();
+  mitkPixelTypeMultiplex5(
+    PackVoxels, pixelType, accessor.GetData(), mask.m_Size, mask.m_WordsPerRow, mask.m_Words.data(), labelValue);
+  return mask;
+}
+
+void mitk::BinaryMask::WriteToImage(Image *image, unsigned int timeStep) const
+{
+  this->WriteImage(image, timeStep, nullptr);
+}
+
+void mitk::BinaryMask::WriteLabelToImage(Image *image, double labelValue, unsigned int timeStep) const
+{
+  this->WriteImage(image, timeStep, &labelValue);
+}
+
+void mitk::BinaryMask::WriteImage(Image *image, unsigned int timeStep, const double *labelValue) const
+{
+  ValidateImage(image, timeStep);
+
+  if (image->GetDimension(0) != m_Size[0] || image->GetDimension(1) != m_Size[1] ||
+      image->GetDimension(2) != m_Size[2])
+    mitkThrow() << "Image and mask have different sizes!";
+
+  ImageWriteAccessor accessor(image, image->GetVolumeData(timeStep));
+  const PixelType pixelType = image->GetPixelType();
+  mitkPixelTypeMultiplex5(
+    UnpackVoxels, pixelType, accessor.GetData(), m_Size, m_WordsPerRow, m_Words.data(), labelValue);
+}
+
+bool mitk::BinaryMask::Get(unsigned int x, unsigned int y, unsigned int z) const
+{
+  return 0 != ((this->GetRow(y, z)[x / BitsPerWord] >> (x % BitsPerWord)) & 1);
+}
+
+void mitk::BinaryMask::Set(unsigned int x, unsigned int y, unsigned int z, bool foreground)
+{
+  const WordType bit = WordType(1) << (x % BitsPerWord);
+  WordType &word = this->GetRow(y, z)[x / BitsPerWord];
+  word = foreground ? word | bit : word & ~bit;
+}
+
+std::size_t mitk::BinaryMask::GetNumberOfForegroundVoxels() const
+{
+  std::size_t count = 0;
+  for (WordType word : m_Words)
+  {
+    // clear the lowest bit until the word is empty
+    for (; word != 0; word &= word - 1)
+      ++count;
+  }
+  return count;
+}
+
+bool mitk::BinaryMask::operator==(const BinaryMask &other) const
+{
+  return std::equal(m_Size, m_Size + 3, other.m_Size) && m_Words == other.m_Words;
+}
+
+mitk::BinaryMask &mitk::BinaryMask::operator&=(const BinaryMask &other)
+{
+  this->CheckSize(other);
+  const WordType *otherWords = other.m_Words.data();
+  WordType *words = m_Words.data();
+
+  mitk::ParallelForRanges(m_Words.size(), 0, [=](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      words[i] &= otherWords[i];
+  });
+  return *this;
+}
+
+mitk::BinaryMask &mitk::BinaryMask::operator|=(const BinaryMask &other)
+{
+  this->CheckSize(other);
+  const WordType *otherWords = other.m_Words.data();
+  WordType *words = m_Words.data();
+
+  mitk::ParallelForRanges(m_Words.size(), 0, [=](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      words[i] |= otherWords[i];
+  });
+  return *this;
+}
+
+mitk::BinaryMask &mitk::BinaryMask::operator^=(const BinaryMask &other)
+{
+  this->CheckSize(other);
+  const WordType *otherWords = other.m_Words.data();
+  WordType *words = m_Words.data();
+
+  mitk::ParallelForRanges(m_Words.size(), 0, [=](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      words[i] ^= otherWords[i];
+  });
+  return *this;
+}
+
+mitk::BinaryMask &mitk::BinaryMask::Subtract(const BinaryMask &other)
+{
+  this->CheckSize(other);
+  const WordType *otherWords = other.m_Words.data();
+  WordType *words = m_Words.data();
+
+  mitk::ParallelForRanges(m_Words.size(), 0, [=](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      words[i] &= ~otherWords[i];
+  });
+  return *this;
+}
+
+void mitk::BinaryMask::Invert()
+{
+  if (m_Words.empty())
+    return;
+
+  WordType *words = m_Words.data();
+  const std::size_t wordsPerRow = m_WordsPerRow;
+  const WordType lastWordMask = m_LastWordMask;
+
+  mitk::ParallelForRanges(std::size_t(m_Size[1]) * m_Size[2], 0, [=](std::size_t begin, std::size_t end) {
+    for (std::size_t row = begin; row < end; ++row)
+    {
+      WordType *rowWords = words + row * wordsPerRow;
+      for (std::size_t i = 0; i < wordsPerRow; ++i)
+        rowWords[i] = ~rowWords[i];
+
+      rowWords[wordsPerRow - 1] &= lastWordMask;
+    }
+  });
+}
+
+void mitk::BinaryMask::Dilate(const StructuringElementType &structuringElement)
+{
+  if (m_Words.empty())
+    return;
+
+  // the distinct half lengths of the runs; every source slice is dilated along x once for each of them
+  std::vector<unsigned int> halfLengths;
+  int minimumZ = 0;
+  for (const auto &run : structuringElement)
+  {
+    halfLengths.push_back(run.halfLength);
+    minimumZ = std::min(minimumZ, run.z);
+  }
+  std::sort(halfLengths.begin(), halfLengths.end());
+  halfLengths.erase(std::unique(halfLengths.begin(), halfLengths.end()), halfLengths.end());
+
+  std::vector<std::size_t> halfLengthIndices;
+  for (const auto &run : structuringElement)
+  {
+    halfLengthIndices.push_back(static_cast<std::size_t>(
+      std::lower_bound(halfLengths.begin(), halfLengths.end(), run.halfLength) - halfLengths.begin()));
+  }
+
+  BinaryMask result(m_Size[0], m_Size[1], m_Size[2]);
+  const std::size_t wordsPerRow = m_WordsPerRow;
+  const std::size_t wordsPerSlice = wordsPerRow * m_Size[1];
+  const int sizeY = static_cast<int>(m_Size[1]);
+  const int sizeZ = static_cast<int>(m_Size[2]);
+
+  mitk::ParallelForRanges(m_Size[2], 0, [&](std::size_t zBegin, std::size_t zEnd) {
+    // dilated rows of the source slices that are needed by the current slice, for each half length
+    std::map<int, std::vector<WordType>> dilatedSlices;
+    std::vector<WordType> buffer(wordsPerRow);
+
+    auto getDilatedSlice = [&](int sourceZ) -> const std::vector<WordType> & {
+      std::vector<WordType> &dilatedSlice = dilatedSlices[sourceZ];
+      if (dilatedSlice.empty())
+      {
+        dilatedSlice.resize(halfLengths.size() * wordsPerSlice);
+        for (std::size_t h = 0; h < halfLengths.size(); ++h)
+        {
+          for (int y = 0; y < sizeY; ++y)
+          {
+            DilateRow(this->GetRow(y, sourceZ),
+                      &dilatedSlice[h * wordsPerSlice + y * wordsPerRow],
+                      buffer.data(),
+                      wordsPerRow,
+                      m_LastWordMask,
+                      halfLengths[h]);
+          }
+        }
+      }
+      return dilatedSlice;
+    };
+
+    for (int z = static_cast<int>(zBegin); z < static_cast<int>(zEnd); ++z)
+    {
+      dilatedSlices.erase(dilatedSlices.begin(), dilatedSlices.lower_bound(z + minimumZ));
+
+      for (std::size_t r = 0; r < structuringElement.size(); ++r)
+      {
+        const Run &run = structuringElement[r];
+        const int sourceZ = z + run.z;
+        if (sourceZ < 0 || sourceZ >= sizeZ)
+          continue;
+
+        const WordType *dilatedRows = &getDilatedSlice(sourceZ)[halfLengthIndices[r] * wordsPerSlice];
+
+        for (int y = std::max(0, -run.y); y < std::min(sizeY, sizeY - run.y); ++y)
+        {
+          const WordType *source = dilatedRows + (y + run.y) * wordsPerRow;
+          WordType *target = result.GetRow(y, z);
+          for (std::size_t i = 0; i < wordsPerRow; ++i)
+            target[i] |= source[i];
+        }
+      }
+    }
+  });
+
+  m_Words.swap(result.m_Words);
+}
+
+void mitk::BinaryMask::Erode(const StructuringElementType &structuringElement)
+{
+  // voxels outside of the volume are foreground, so they are background of the inverted mask
+  this->Invert();
+  this->Dilate(structuringElement);
+  this->Invert();
+}
+
+void mitk::BinaryMask::Closing(const StructuringElementType &structuringElement)
+{
+  if (m_Words.empty())
+    return;
+
+  unsigned int padding[3] = {0, 0, 0};
+  for (const auto &run : structuringElement)
+  {
+    padding[0] = std::max(padding[0], run.halfLength);
+    padding[1] = std::max(padding[1], static_cast<unsigned int>(std::abs(run.y)));
+    padding[2] = std::max(padding[2], static_cast<unsigned int>(std::abs(run.z)));
+  }
+
+  BinaryMask padded = this->Pad(padding);
+  padded.Dilate(structuringElement);
+  padded.Erode(structuringElement);
+  *this = padded.Crop(padding, m_Size);
+}
+
+void mitk::BinaryMask::Opening(const StructuringElementType &structuringElement)
+{
+  this->Erode(structuringElement);
+  this->Dilate(structuringElement);
+}
+
+void mitk::BinaryMask::CheckSize(const BinaryMask &other) const
+{
+  if (!std::equal(m_Size, m_Size + 3, other.m_Size))
+    mitkThrow() << "Masks have different sizes!";
+}
+
+mitk::BinaryMask mitk::BinaryMask::Pad(const unsigned int offset[3]) const
+{
+  BinaryMask padded(m_Size[0] + 2 * offset[0], m_Size[1] + 2 * offset[1], m_Size[2] + 2 * offset[2]);
+
+  for (unsigned int z = 0; z < m_Size[2]; ++z)
+  {
+    for (unsigned int y = 0; y < m_Size[1]; ++y)
+    {
+      ShiftOr(this->GetRow(y, z),
+              m_WordsPerRow,
+              padded.GetRow(y + offset[1], z + offset[2]),
+              padded.m_WordsPerRow,
+              offset[0]);
+    }
+  }
+  return padded;
+}
+
+mitk::BinaryMask mitk::BinaryMask::Crop(const unsigned int offset[3], const unsigned int size[3]) const
+{
+  BinaryMask cropped(size[0], size[1], size[2]);
+
+  for (unsigned int z = 0; z < size[2]; ++z)
+  {
+    for (unsigned int y = 0; y < size[1]; ++y)
+    {
+      WordType *row = cropped.GetRow(y, z);
+      ShiftOr(this->GetRow(y + offset[1], z + offset[2]),
+              m_WordsPerRow,
+              row,
+              cropped.m_WordsPerRow,
+              -static_cast<std::ptrdiff_t>(offset[0]));
+      row[cropped.m_WordsPerRow - 1] &= cropped.m_LastWordMask;
+    }
+  }
+  return cropped;
+}
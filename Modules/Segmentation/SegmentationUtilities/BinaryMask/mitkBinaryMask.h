@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBinaryMask_h
+#define mitkBinaryMask_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Binary 3D volume with one bit per voxel.
+   *
+   * Each row of voxels along x is stored in whole 64 bit words, so the boolean operations process 64 voxels at once.
+   * The bits behind the last voxel of a row are always 0. 2D images are masks with one slice.
+   *
+   * Morphological operations use structuring elements that are decomposed into runs along x: for every (y, z)
+   * offset of the element, the rows are dilated by the half length of the run with word shifts and combined with
+   * the result. Voxels outside of the volume are background, except for erosions, which treat them as foreground
+   * (like itk::BinaryErodeImageFilter).
+   *
+   * Masks are read from and written to the pixel memory of an image time step directly, e.g. from a layer of a
+   * LabelSetImage (LabelSetImage::GetLayerImage()). All operations on whole masks run on several threads.
+   */
+  class MITKSEGMENTATION_EXPORT BinaryMask
+  {
+  public:
+    typedef std::uint64_t WordType;
+
+    /** \brief Run of a structuring element along x, from x offset -halfLength to +halfLength.
+     */
+    struct Run
+    {
+      int y;
+      int z;
+      unsigned int halfLength;
+    };
+
+    /** \brief Structuring element as a point symmetric set of runs.
+     */
+    typedef std::vector<Run> StructuringElementType;
+
+    /** \brief Creates the runs of the ellipsoid of itk::BinaryBallStructuringElement with the given radii.
+     */
+    static StructuringElementType CreateBall(unsigned int radiusX, unsigned int radiusY, unsigned int radiusZ);
+
+    /** \brief Creates the runs of itk::BinaryCrossStructuringElement with the given radii.
+     */
+    static StructuringElementType CreateCross(unsigned int radiusX, unsigned int radiusY, unsigned int radiusZ);
+
+    /** \brief Creates an empty mask of the given size.
+     */
+    BinaryMask(unsigned int sizeX = 0, unsigned int sizeY = 0, unsigned int sizeZ = 0);
+
+    /** \brief Creates a mask of all voxels of an image time step that are not 0.
+     *
+     * Throws an mitk::Exception if the image is not a scalar 2D, 3D or 3D+t image.
+     */
+    static BinaryMask FromImage(const Image *image, unsigned int timeStep = 0);
+
+    /** \brief Creates a mask of all voxels of an image time step with the given label value.
+     */
+    static BinaryMask FromLabel(const Image *image, double labelValue, unsigned int timeStep = 0);
+
+    /** \brief Writes the mask into an image time step of the same size, with 1 for foreground and 0 for background.
+     *
+     * The image is not marked as modified.
+     */
+    void WriteToImage(Image *image, unsigned int timeStep = 0) const;
+
+    /** \brief Writes the mask as a label into an image time step of the same size.
+     *
+     * Foreground voxels get the label value, voxels with the label value that are not part of the mask get 0 and all
+     * other voxels keep their value. The image is not marked as modified.
+     */
+    void WriteLabelToImage(Image *image, double labelValue, unsigned int timeStep = 0) const;
+
+    unsigned int GetSize(unsigned int dimension) const { return m_Size[dimension]; }
+    bool Get(unsigned int x, unsigned int y, unsigned int z) const;
+    void Set(unsigned int x, unsigned int y, unsigned int z, bool foreground);
+
+    std::size_t GetNumberOfForegroundVoxels() const;
+
+    bool operator==(const BinaryMask &other) const;
+    bool operator!=(const BinaryMask &other) const { return !(*this == other); }
+
+    ///@{
+    /** \brief Voxel-wise boolean operations with a mask of the same size.
+     *
+     * Throw an mitk::Exception if the sizes differ.
+     */
+    BinaryMask &operator&=(const BinaryMask &other);
+    BinaryMask &operator|=(const BinaryMask &other);
+    BinaryMask &operator^=(const BinaryMask &other);
+    BinaryMask &Subtract(const BinaryMask &other);
+    ///@}
+
+    void Invert();
+
+    ///@{
+    /** \brief Morphological operations with a point symmetric structuring element.
+     *
+     * Closing pads the mask by the extent of the structuring element, so the border of the volume does not close
+     * (like itk::BinaryMorphologicalClosingImageFilter).
+     */
+    void Dilate(const StructuringElementType &structuringElement);
+    void Erode(const StructuringElementType &structuringElement);
+    void Closing(const StructuringElementType &structuringElement);
+    void Opening(const StructuringElementType &structuringElement);
+    ///@}
+
+  private:
+    /** \brief Reads the voxels that are not 0 or, if \a labelValue is given, the voxels with this value.
+     */
+    static BinaryMask ReadImage(const Image *image, unsigned int timeStep, const double *labelValue);
+
+    /** \brief Writes the mask as binary image or, if \a labelValue is given, as label.
+     */
+    void WriteImage(Image *image, unsigned int timeStep, const double *labelValue) const;
+
+    WordType *GetRow(unsigned int y, unsigned int z)
+    {
+      return &m_Words[(std::size_t(z) * m_Size[1] + y) * m_WordsPerRow];
+    }
+
+    const WordType *GetRow(unsigned int y, unsigned int z) const
+    {
+      return &m_Words[(std::size_t(z) * m_Size[1] + y) * m_WordsPerRow];
+    }
+
+    void CheckSize(const BinaryMask &other) const;
+
+    /** \brief Copies this mask into a larger mask, shifted by the offset.
+     */
+    BinaryMask Pad(const unsigned int offset[3]) const;
+
+    /** \brief Copies the region of this mask starting at the offset into a mask of the given size.
+     */
+    BinaryMask Crop(const unsigned int offset[3], const unsigned int size[3]) const;
+
+    unsigned int m_Size[3];
+    std::size_t m_WordsPerRow;
+    WordType m_LastWordMask;
+    std::vector<WordType> m_Words;
+  };
+}
+
+#endif
@@ -11,33 +11,21 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkBooleanOperation.h"
-#include <itkAndImageFilter.h>
-#include <itkNotImageFilter.h>
-#include <itkOrImageFilter.h>
+#include <mitkBinaryMask.h>
 #include <mitkExceptionMacro.h>
-#include <mitkImageCast.h>
-#include <mitkImageTimeSelector.h>
 
-typedef itk::Image<mitk::Label::PixelType, 3> ImageType;
-
-static mitk::Image::Pointer Get3DSegmentation(mitk::Image::Pointer segmentation, unsigned int time)
+/** Creates a segmentation of the voxels of the mask, with the geometry of the given time step of the input.*/
+static mitk::LabelSetImage::Pointer CreateResult(const mitk::BinaryMask &mask,
+                                                 mitk::Image::Pointer input,
+                                                 unsigned int time)
 {
-  if (segmentation->GetDimension() != 4)
-    return segmentation;
-
-  auto imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(segmentation);
-  imageTimeSelector->SetTimeNr(static_cast<int>(time));
+  auto tempResult = mitk::Image::New();
+  tempResult->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), *input->GetSlicedGeometry(time));
+  mask.WriteToImage(tempResult);
 
-  imageTimeSelector->UpdateLargestPossibleRegion();
-
-  return imageTimeSelector->GetOutput();
-}
+  auto result = mitk::LabelSetImage::New();
+  result->InitializeByLabeledImage(tempResult);
 
-static ImageType::Pointer CastTo3DItkImage(mitk::Image::Pointer segmentation, unsigned int time)
-{
-  ImageType::Pointer result;
-  mitk::CastToItkImage(Get3DSegmentation(segmentation, time), result);
   return result;
 }
 
@@ -74,71 +62,26 @@ mitk::LabelSetImage::Pointer mitk::BooleanOperation::GetResult() const
 
 mitk::LabelSetImage::Pointer mitk::BooleanOperation::GetDifference() const
 {
-  auto input1 = CastTo3DItkImage(m_SegmentationA, m_Time);
-  auto input2 = CastTo3DItkImage(m_SegmentationB, m_Time);
-
-  auto notFilter = itk::NotImageFilter<ImageType, ImageType>::New();
-  notFilter->SetInput(input2);
+  auto mask = BinaryMask::FromImage(m_SegmentationA, m_Time);
+  mask.Subtract(BinaryMask::FromImage(m_SegmentationB, m_Time));
 
-  auto andFilter = itk::AndImageFilter<ImageType, ImageType>::New();
-  andFilter->SetInput1(input1);
-  andFilter->SetInput2(notFilter->GetOutput());
-
-  andFilter->UpdateLargestPossibleRegion();
-
-  auto tempResult = Image::New();
-  CastToMitkImage<ImageType>(andFilter->GetOutput(), tempResult);
-
-  tempResult->DisconnectPipeline();
-
-  auto result = mitk::LabelSetImage::New();
-  result->InitializeByLabeledImage(tempResult);
-
-  return result;
+  return CreateResult(mask, m_SegmentationA, m_Time);
 }
 
 mitk::LabelSetImage::Pointer mitk::BooleanOperation::GetIntersection() const
 {
-  auto input1 = CastTo3DItkImage(m_SegmentationA, m_Time);
-  auto input2 = CastTo3DItkImage(m_SegmentationB, m_Time);
+  auto mask = BinaryMask::FromImage(m_SegmentationA, m_Time);
+  mask &= BinaryMask::FromImage(m_SegmentationB, m_Time);
 
-  auto andFilter = itk::AndImageFilter<ImageType, ImageType>::New();
-  andFilter->SetInput1(input1);
-  andFilter->SetInput2(input2);
-
-  andFilter->UpdateLargestPossibleRegion();
-
-  auto tempResult = Image::New();
-  CastToMitkImage<ImageType>(andFilter->GetOutput(), tempResult);
-
-  tempResult->DisconnectPipeline();
-
-  auto result = mitk::LabelSetImage::New();
-  result->InitializeByLabeledImage(tempResult);
-
-  return result;
+  return CreateResult(mask, m_SegmentationA, m_Time);
 }
 
 mitk::LabelSetImage::Pointer mitk::BooleanOperation::GetUnion() const
 {
-  auto input1 = CastTo3DItkImage(m_SegmentationA, m_Time);
-  auto input2 = CastTo3DItkImage(m_SegmentationB, m_Time);
+  auto mask = BinaryMask::FromImage(m_SegmentationA, m_Time);
+  mask |= BinaryMask::FromImage(m_SegmentationB, m_Time);
 
-  auto orFilter = itk::OrImageFilter<ImageType, ImageType>::New();
-  orFilter->SetInput1(input1);
-  orFilter->SetInput2(input2);
-
-  orFilter->UpdateLargestPossibleRegion();
-
-  auto tempResult = Image::New();
-  CastToMitkImage<ImageType>(orFilter->GetOutput(), tempResult);
-
-  tempResult->DisconnectPipeline();
-
-  auto result = mitk::LabelSetImage::New();
-  result->InitializeByLabeledImage(tempResult);
-
-  return result;
+  return CreateResult(mask, m_SegmentationA, m_Time);
 }
 
 void mitk::BooleanOperation::ValidateSegmentation(mitk::Image::Pointer segmentation) const
@@ -21,7 +21,8 @@ namespace mitk
   /** \brief Executes a boolean operation on two different segmentations.
    *
    * All parameters of the boolean operations must be specified during construction.
-   * The actual operation is executed when calling GetResult().
+   * The actual operation is executed when calling GetResult(). All voxels that are not 0 are treated as foreground
+   * and the result contains the label 1.
    */
   class MITKSEGMENTATION_EXPORT BooleanOperation
   {
@@ -11,51 +11,82 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkMorphologicalOperations.h"
-#include <itkBinaryBallStructuringElement.h>
-#include <itkBinaryCrossStructuringElement.h>
-#include <itkBinaryDilateImageFilter.h>
-#include <itkBinaryErodeImageFilter.h>
 #include <itkBinaryFillholeImageFilter.h>
-#include <itkBinaryMorphologicalClosingImageFilter.h>
-#include <itkBinaryMorphologicalOpeningImageFilter.h>
+#include <mitkBinaryMask.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkImageTimeSelector.h>
 
-void mitk::MorphologicalOperations::Closing(mitk::Image::Pointer &image,
-                                            int factor,
-                                            mitk::MorphologicalOperations::StructuralElementType structuralElement)
-{
-  MITK_INFO << "Start Closing...";
-
-  auto timeSteps = static_cast<int>(image->GetTimeSteps());
+#include <algorithm>
 
-  if (timeSteps > 1)
+namespace
+{
+  mitk::BinaryMask::StructuringElementType CreateStructuringElement(
+    mitk::MorphologicalOperations::StructuralElementType structuralElementFlag, int factor)
   {
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(image);
+    typedef mitk::MorphologicalOperations Self;
 
-    for (int t = 0; t < timeSteps; ++t)
+    const auto radius = static_cast<unsigned int>(std::max(factor, 0));
+    unsigned int size[3] = {0, 0, 0};
+
+    switch (structuralElementFlag)
     {
-      MITK_INFO << "  Processing time step " << t;
+      case Self::Ball_Axial:
+      case Self::Cross_Axial:
+        size[0] = radius;
+        size[1] = radius;
+        break;
+      case Self::Ball_Coronal:
+      case Self::Cross_Coronal:
+        size[0] = radius;
+        size[2] = radius;
+        break;
+      case Self::Ball_Sagital:
+      case Self::Cross_Sagital:
+        size[1] = radius;
+        size[2] = radius;
+        break;
+      case Self::Ball:
+      case Self::Cross:
+        std::fill(size, size + 3, radius);
+        break;
+    }
 
-      timeSelector->SetTimeNr(t);
-      timeSelector->Update();
+    return structuralElementFlag & (Self::Ball_Axial | Self::Ball_Coronal | Self::Ball_Sagital)
+             ? mitk::BinaryMask::CreateBall(size[0], size[1], size[2])
+             : mitk::BinaryMask::CreateCross(size[0], size[1], size[2]);
+  }
 
-      mitk::Image::Pointer img3D = timeSelector->GetOutput();
-      img3D->DisconnectPipeline();
+  /** Applies the operation to the voxels with the value 1 of every time step, in place. Voxels with other values are
+      not changed, unless the operation sets them to 1.*/
+  template <typename TOperation>
+  void ApplyToAllTimeSteps(mitk::Image *image, TOperation operation)
+  {
+    const auto timeSteps = image->GetTimeSteps();
 
-      AccessByItk_3(img3D, itkClosing, img3D, factor, structuralElement);
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      if (timeSteps > 1)
+        MITK_INFO << "  Processing time step " << t;
 
-      mitk::ImageReadAccessor accessor(img3D);
-      image->SetVolume(accessor.GetData(), t);
+      auto mask = mitk::BinaryMask::FromLabel(image, 1, t);
+      operation(mask);
+      mask.WriteLabelToImage(image, 1, t);
     }
+
+    image->Modified();
   }
-  else
-  {
-    AccessByItk_3(image, itkClosing, image, factor, structuralElement);
-  }
+}
+
+void mitk::MorphologicalOperations::Closing(mitk::Image::Pointer &image,
+                                            int factor,
+                                            mitk::MorphologicalOperations::StructuralElementType structuralElement)
+{
+  MITK_INFO << "Start Closing...";
+
+  const auto structuringElement = CreateStructuringElement(structuralElement, factor);
+  ApplyToAllTimeSteps(image, [&](BinaryMask &mask) { mask.Closing(structuringElement); });
 
   MITK_INFO << "Finished Closing";
 }
@@ -66,33 +97,8 @@ void mitk::MorphologicalOperations::Erode(mitk::Image::Pointer &image,
 {
   MITK_INFO << "Start Erode...";
 
-  auto timeSteps = static_cast<int>(image->GetTimeSteps());
-
-  if (timeSteps > 1)
-  {
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(image);
-
-    for (int t = 0; t < timeSteps; ++t)
-    {
-      MITK_INFO << "  Processing time step " << t;
-
-      timeSelector->SetTimeNr(t);
-      timeSelector->Update();
-
-      mitk::Image::Pointer img3D = timeSelector->GetOutput();
-      img3D->DisconnectPipeline();
-
-      AccessByItk_3(img3D, itkErode, img3D, factor, structuralElement);
-
-      mitk::ImageReadAccessor accessor(img3D);
-      image->SetVolume(accessor.GetData(), t);
-    }
-  }
-  else
-  {
-    AccessByItk_3(image, itkErode, image, factor, structuralElement);
-  }
+  const auto structuringElement = CreateStructuringElement(structuralElement, factor);
+  ApplyToAllTimeSteps(image, [&](BinaryMask &mask) { mask.Erode(structuringElement); });
 
   MITK_INFO << "Finished Erode";
 }
@@ -103,33 +109,8 @@ void mitk::MorphologicalOperations::Dilate(mitk::Image::Pointer &image,
 {
   MITK_INFO << "Start Dilate...";
 
-  auto timeSteps = static_cast<int>(image->GetTimeSteps());
-
-  if (timeSteps > 1)
-  {
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(image);
-
-    for (int t = 0; t < timeSteps; ++t)
-    {
-      MITK_INFO << "  Processing time step " << t;
-
-      timeSelector->SetTimeNr(t);
-      timeSelector->Update();
-
-      mitk::Image::Pointer img3D = timeSelector->GetOutput();
-      img3D->DisconnectPipeline();
-
-      AccessByItk_3(img3D, itkDilate, img3D, factor, structuralElement);
-
-      mitk::ImageReadAccessor accessor(img3D);
-      image->SetVolume(accessor.GetData(), t);
-    }
-  }
-  else
-  {
-    AccessByItk_3(image, itkDilate, image, factor, structuralElement);
-  }
+  const auto structuringElement = CreateStructuringElement(structuralElement, factor);
+  ApplyToAllTimeSteps(image, [&](BinaryMask &mask) { mask.Dilate(structuringElement); });
 
   MITK_INFO << "Finished Dilate";
 }
@@ -140,33 +121,8 @@ void mitk::MorphologicalOperations::Opening(mitk::Image::Pointer &image,
 {
   MITK_INFO << "Start Opening...";
 
-  auto timeSteps = static_cast<int>(image->GetTimeSteps());
-
-  if (timeSteps > 1)
-  {
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(image);
-
-    for (int t = 0; t < timeSteps; ++t)
-    {
-      MITK_INFO << "  Processing time step " << t;
-
-      timeSelector->SetTimeNr(t);
-      timeSelector->Update();
-
-      mitk::Image::Pointer img3D = timeSelector->GetOutput();
-      img3D->DisconnectPipeline();
-
-      AccessByItk_3(img3D, itkOpening, img3D, factor, structuralElement);
-
-      mitk::ImageReadAccessor accessor(img3D);
-      image->SetVolume(accessor.GetData(), t);
-    }
-  }
-  else
-  {
-    AccessByItk_3(image, itkOpening, image, factor, structuralElement);
-  }
+  const auto structuringElement = CreateStructuringElement(structuralElement, factor);
+  ApplyToAllTimeSteps(image, [&](BinaryMask &mask) { mask.Opening(structuringElement); });
 
   MITK_INFO << "Finished Opening";
 }
@@ -206,164 +162,6 @@ void mitk::MorphologicalOperations::FillHoles(mitk::Image::Pointer &image)
   MITK_INFO << "Finished FillHole";
 }
 
-template <typename TPixel, unsigned int VDimension>
-void mitk::MorphologicalOperations::itkClosing(
-  itk::Image<TPixel, VDimension> *sourceImage,
-  mitk::Image::Pointer &resultImage,
-  int factor,
-  mitk::MorphologicalOperations::StructuralElementType structuralElementFlags)
-{
-  typedef itk::Image<TPixel, VDimension> ImageType;
-  typedef itk::BinaryBallStructuringElement<TPixel, VDimension> BallType;
-  typedef itk::BinaryCrossStructuringElement<TPixel, VDimension> CrossType;
-  typedef typename itk::BinaryMorphologicalClosingImageFilter<ImageType, ImageType, BallType> BallClosingFilterType;
-  typedef typename itk::BinaryMorphologicalClosingImageFilter<ImageType, ImageType, CrossType> CrossClosingFilterType;
-
-  if (structuralElementFlags & (Ball_Axial | Ball_Coronal | Ball_Sagital))
-  {
-    BallType ball = CreateStructuringElement<BallType>(structuralElementFlags, factor);
-
-    typename BallClosingFilterType::Pointer closingFilter = BallClosingFilterType::New();
-    closingFilter->SetKernel(ball);
-    closingFilter->SetInput(sourceImage);
-    closingFilter->SetForegroundValue(1);
-    closingFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(closingFilter->GetOutput(), resultImage);
-  }
-  else
-  {
-    CrossType cross = CreateStructuringElement<CrossType>(structuralElementFlags, factor);
-
-    typename CrossClosingFilterType::Pointer closingFilter = CrossClosingFilterType::New();
-    closingFilter->SetKernel(cross);
-    closingFilter->SetInput(sourceImage);
-    closingFilter->SetForegroundValue(1);
-    closingFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(closingFilter->GetOutput(), resultImage);
-  }
-}
-
-template <typename TPixel, unsigned int VDimension>
-void mitk::MorphologicalOperations::itkErode(
-  itk::Image<TPixel, VDimension> *sourceImage,
-  mitk::Image::Pointer &resultImage,
-  int factor,
-  mitk::MorphologicalOperations::StructuralElementType structuralElementFlags)
-{
-  typedef itk::Image<TPixel, VDimension> ImageType;
-  typedef itk::BinaryBallStructuringElement<TPixel, VDimension> BallType;
-  typedef itk::BinaryCrossStructuringElement<TPixel, VDimension> CrossType;
-  typedef typename itk::BinaryErodeImageFilter<ImageType, ImageType, BallType> BallErodeFilterType;
-  typedef typename itk::BinaryErodeImageFilter<ImageType, ImageType, CrossType> CrossErodeFilterType;
-
-  if (structuralElementFlags & (Ball_Axial | Ball_Coronal | Ball_Sagital))
-  {
-    BallType ball = CreateStructuringElement<BallType>(structuralElementFlags, factor);
-
-    typename BallErodeFilterType::Pointer erodeFilter = BallErodeFilterType::New();
-    erodeFilter->SetKernel(ball);
-    erodeFilter->SetInput(sourceImage);
-    erodeFilter->SetErodeValue(1);
-    erodeFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(erodeFilter->GetOutput(), resultImage);
-  }
-  else
-  {
-    CrossType cross = CreateStructuringElement<CrossType>(structuralElementFlags, factor);
-
-    typename CrossErodeFilterType::Pointer erodeFilter = CrossErodeFilterType::New();
-    erodeFilter->SetKernel(cross);
-    erodeFilter->SetInput(sourceImage);
-    erodeFilter->SetErodeValue(1);
-    erodeFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(erodeFilter->GetOutput(), resultImage);
-  }
-}
-
-template <typename TPixel, unsigned int VDimension>
-void mitk::MorphologicalOperations::itkDilate(
-  itk::Image<TPixel, VDimension> *sourceImage,
-  mitk::Image::Pointer &resultImage,
-  int factor,
-  mitk::MorphologicalOperations::StructuralElementType structuralElementFlags)
-{
-  typedef itk::Image<TPixel, VDimension> ImageType;
-  typedef itk::BinaryBallStructuringElement<TPixel, VDimension> BallType;
-  typedef itk::BinaryCrossStructuringElement<TPixel, VDimension> CrossType;
-  typedef typename itk::BinaryDilateImageFilter<ImageType, ImageType, BallType> BallDilateFilterType;
-  typedef typename itk::BinaryDilateImageFilter<ImageType, ImageType, CrossType> CrossDilateFilterType;
-
-  if (structuralElementFlags & (Ball_Axial | Ball_Coronal | Ball_Sagital))
-  {
-    BallType ball = CreateStructuringElement<BallType>(structuralElementFlags, factor);
-
-    typename BallDilateFilterType::Pointer dilateFilter = BallDilateFilterType::New();
-    dilateFilter->SetKernel(ball);
-    dilateFilter->SetInput(sourceImage);
-    dilateFilter->SetDilateValue(1);
-    dilateFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(dilateFilter->GetOutput(), resultImage);
-  }
-  else
-  {
-    CrossType cross = CreateStructuringElement<CrossType>(structuralElementFlags, factor);
-
-    typename CrossDilateFilterType::Pointer dilateFilter = CrossDilateFilterType::New();
-    dilateFilter->SetKernel(cross);
-    dilateFilter->SetInput(sourceImage);
-    dilateFilter->SetDilateValue(1);
-    dilateFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(dilateFilter->GetOutput(), resultImage);
-  }
-}
-
-template <typename TPixel, unsigned int VDimension>
-void mitk::MorphologicalOperations::itkOpening(
-  itk::Image<TPixel, VDimension> *sourceImage,
-  mitk::Image::Pointer &resultImage,
-  int factor,
-  mitk::MorphologicalOperations::StructuralElementType structuralElementFlags)
-{
-  typedef itk::Image<TPixel, VDimension> ImageType;
-  typedef itk::BinaryBallStructuringElement<TPixel, VDimension> BallType;
-  typedef itk::BinaryCrossStructuringElement<TPixel, VDimension> CrossType;
-  typedef typename itk::BinaryMorphologicalOpeningImageFilter<ImageType, ImageType, BallType> BallOpeningFiltertype;
-  typedef typename itk::BinaryMorphologicalOpeningImageFilter<ImageType, ImageType, CrossType> CrossOpeningFiltertype;
-
-  if (structuralElementFlags & (Ball_Axial | Ball_Coronal | Ball_Sagital))
-  {
-    BallType ball = CreateStructuringElement<BallType>(structuralElementFlags, factor);
-
-    typename BallOpeningFiltertype::Pointer openingFilter = BallOpeningFiltertype::New();
-    openingFilter->SetKernel(ball);
-    openingFilter->SetInput(sourceImage);
-    openingFilter->SetForegroundValue(1);
-    openingFilter->SetBackgroundValue(0);
-    openingFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(openingFilter->GetOutput(), resultImage);
-  }
-  else
-  {
-    CrossType cross = CreateStructuringElement<CrossType>(structuralElementFlags, factor);
-
-    typename CrossOpeningFiltertype::Pointer openingFilter = CrossOpeningFiltertype::New();
-    openingFilter->SetKernel(cross);
-    openingFilter->SetInput(sourceImage);
-    openingFilter->SetForegroundValue(1);
-    openingFilter->SetBackgroundValue(0);
-    openingFilter->UpdateLargestPossibleRegion();
-
-    mitk::CastToMitkImage(openingFilter->GetOutput(), resultImage);
-  }
-}
-
 template <typename TPixel, unsigned int VDimension>
 void mitk::MorphologicalOperations::itkFillHoles(itk::Image<TPixel, VDimension> *sourceImage,
                                                  mitk::Image::Pointer &resultImage)
@@ -378,37 +176,3 @@ void mitk::MorphologicalOperations::itkFillHoles(itk::Image<TPixel, VDimension>
 
   mitk::CastToMitkImage(fillHoleFilter->GetOutput(), resultImage);
 }
-
-template <class TStructuringElement>
-TStructuringElement  mitk::MorphologicalOperations::CreateStructuringElement(StructuralElementType structuralElementFlag, int factor)
-{
-  TStructuringElement strElem;
-  typename TStructuringElement::SizeType size;
-  size.Fill(0);
-  switch (structuralElementFlag)
-  {
-  case Ball_Axial:
-  case Cross_Axial:
-    size.SetElement(0, factor);
-    size.SetElement(1, factor);
-    break;
-  case Ball_Coronal:
-  case Cross_Coronal:
-    size.SetElement(0, factor);
-    size.SetElement(2, factor);
-    break;
-  case Ball_Sagital:
-  case Cross_Sagital:
-    size.SetElement(1, factor);
-    size.SetElement(2, factor);
-    break;
-  case Ball:
-  case Cross:
-    size.Fill(factor);
-    break;
-  }
-
-  strElem.SetRadius(size);
-  strElem.CreateStructuringElement();
-  return strElem;
-}
@@ -39,6 +39,9 @@ namespace mitk
 
     ///@{
     /** \brief Perform morphological operation on 2D, 3D or 3D+t segmentation.
+     *
+     * The operations process the voxels with the value 1. Closing, Erode, Dilate and Opening work in place on the
+     * pixel memory of the image with bit-packed masks (see BinaryMask).
      */
     static void Closing(mitk::Image::Pointer &image, int factor, StructuralElementType structuralElement);
     static void Erode(mitk::Image::Pointer &image, int factor, StructuralElementType structuralElement);
@@ -50,39 +53,10 @@ namespace mitk
   private:
     MorphologicalOperations();
 
-    template <class TStructuringElement>
-    static TStructuringElement CreateStructuringElement(StructuralElementType structuralElementFlag, int factor);
-
-    ///@{
-    /** \brief Perform morphological operation by using corresponding ITK filter.
+    /** \brief Fill holes by using the corresponding ITK filter.
      */
     template <typename TPixel, unsigned int VDimension>
-    static void itkClosing(itk::Image<TPixel, VDimension> *sourceImage,
-                           mitk::Image::Pointer &resultImage,
-                           int factor,
-                           StructuralElementType structuralElement);
-
-    template <typename TPixel, unsigned int VDimension>
-    static void itkErode(itk::Image<TPixel, VDimension> *sourceImage,
-                         mitk::Image::Pointer &resultImage,
-                         int factor,
-                         StructuralElementType structuralElement);
-
-    template <typename TPixel, unsigned int VDimension>
-    static void itkDilate(itk::Image<TPixel, VDimension> *sourceImage,
-                          mitk::Image::Pointer &resultImage,
-                          int factor,
-                          StructuralElementType structuralElement);
-
-    template <typename TPixel, unsigned int VDimension>
-    static void itkOpening(itk::Image<TPixel, VDimension> *sourceImage,
-                           mitk::Image::Pointer &resultImage,
-                           int factor,
-                           StructuralElementType structuralElement);
-
-    template <typename TPixel, unsigned int VDimension>
     static void itkFillHoles(itk::Image<TPixel, VDimension> *sourceImage, mitk::Image::Pointer &resultImage);
-    ///@}
   };
 }
 
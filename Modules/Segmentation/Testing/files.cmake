@@ -1,4 +1,5 @@
 set(MODULE_TESTS
+  mitkBinaryMaskTest.cpp
   mitkContourMapper2DTest.cpp
   mitkContourTest.cpp
   mitkContourModelSetToImageFilterTest.cpp
@@ -8,6 +9,7 @@ set(MODULE_TESTS
   mitkSegmentationInterpolationTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
+  mitkSliceRegionWriterTest.cpp
 #  mitkToolManagerTest.cpp
   mitkToolManagerProviderTest.cpp
   mitkManualSegmentationToSurfaceFilterTest.cpp #new cpp unit style
@@ -0,0 +1,225 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkBinaryMask.h>
+#include <mitkImageCast.h>
+#include <mitkMorphologicalOperations.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkBinaryBallStructuringElement.h>
+#include <itkBinaryCrossStructuringElement.h>
+#include <itkBinaryDilateImageFilter.h>
+#include <itkBinaryErodeImageFilter.h>
+#include <itkBinaryMorphologicalClosingImageFilter.h>
+#include <itkImageRegionIterator.h>
+
+#include <random>
+
+class mitkBinaryMaskTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBinaryMaskTestSuite);
+  MITK_TEST(FromLabel_WriteLabelToImage_RoundTrip);
+  MITK_TEST(BooleanOperations_MatchVoxelwiseOperations);
+  MITK_TEST(BooleanOperations_DifferentSizes_Throws);
+  MITK_TEST(Dilate_Ball_MatchesItk);
+  MITK_TEST(Erode_Ball_MatchesItk);
+  MITK_TEST(Dilate_Cross_MatchesItk);
+  MITK_TEST(Erode_Cross_MatchesItk);
+  MITK_TEST(Closing_MatchesItk);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<unsigned char, 3> ImageType;
+  typedef itk::BinaryBallStructuringElement<unsigned char, 3> BallType;
+  typedef itk::BinaryCrossStructuringElement<unsigned char, 3> CrossType;
+
+  /** 70 x 13 x 9 voxels, so rows span two words, with the values 0, 1 and 2.*/
+  ImageType::Pointer m_ItkImage;
+  mitk::Image::Pointer m_Image;
+
+  template <class TStructuringElement>
+  static TStructuringElement CreateItkStructuringElement(unsigned int radiusX,
+                                                         unsigned int radiusY,
+                                                         unsigned int radiusZ)
+  {
+    typename TStructuringElement::SizeType radius;
+    radius[0] = radiusX;
+    radius[1] = radiusY;
+    radius[2] = radiusZ;
+
+    TStructuringElement structuringElement;
+    structuringElement.SetRadius(radius);
+    structuringElement.CreateStructuringElement();
+    return structuringElement;
+  }
+
+  template <class TFilter>
+  mitk::BinaryMask RunItkFilter(TFilter *filter)
+  {
+    filter->SetInput(m_ItkImage);
+    filter->UpdateLargestPossibleRegion();
+
+    mitk::Image::Pointer result;
+    mitk::CastToMitkImage(filter->GetOutput(), result);
+    return mitk::BinaryMask::FromLabel(result, 1);
+  }
+
+  template <class TStructuringElement>
+  mitk::BinaryMask ItkDilate(const TStructuringElement &structuringElement)
+  {
+    auto filter = itk::BinaryDilateImageFilter<ImageType, ImageType, TStructuringElement>::New();
+    filter->SetKernel(structuringElement);
+    filter->SetDilateValue(1);
+    return this->RunItkFilter(filter.GetPointer());
+  }
+
+  template <class TStructuringElement>
+  mitk::BinaryMask ItkErode(const TStructuringElement &structuringElement)
+  {
+    auto filter = itk::BinaryErodeImageFilter<ImageType, ImageType, TStructuringElement>::New();
+    filter->SetKernel(structuringElement);
+    filter->SetErodeValue(1);
+    return this->RunItkFilter(filter.GetPointer());
+  }
+
+public:
+  void setUp() override
+  {
+    ImageType::RegionType region;
+    region.SetSize(0, 70);
+    region.SetSize(1, 13);
+    region.SetSize(2, 9);
+
+    m_ItkImage = ImageType::New();
+    m_ItkImage->SetRegions(region);
+    m_ItkImage->Allocate();
+
+    std::mt19937 generator(42);
+    std::discrete_distribution<int> distribution({6, 3, 1});
+
+    itk::ImageRegionIterator<ImageType> it(m_ItkImage, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      it.Set(static_cast<unsigned char>(distribution(generator)));
+
+    mitk::CastToMitkImage(m_ItkImage, m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_ItkImage = nullptr;
+    m_Image = nullptr;
+  }
+
+  void FromLabel_WriteLabelToImage_RoundTrip()
+  {
+    auto mask = mitk::BinaryMask::FromLabel(m_Image, 1);
+    CPPUNIT_ASSERT_EQUAL(70u, mask.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(13u, mask.GetSize(1));
+    CPPUNIT_ASSERT_EQUAL(9u, mask.GetSize(2));
+
+    std::size_t numberOfLabelVoxels = 0;
+    itk::ImageRegionIterator<ImageType> it(m_ItkImage, m_ItkImage->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      CPPUNIT_ASSERT_EQUAL(it.Get() == 1, mask.Get(index[0], index[1], index[2]));
+      numberOfLabelVoxels += it.Get() == 1 ? 1 : 0;
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfLabelVoxels, mask.GetNumberOfForegroundVoxels());
+
+    auto otherLabel = mitk::BinaryMask::FromLabel(m_Image, 2);
+    mask.Set(0, 0, 0, !mask.Get(0, 0, 0));
+    mask.Subtract(otherLabel);
+    mask.WriteLabelToImage(m_Image, 1);
+
+    CPPUNIT_ASSERT_MESSAGE("Written label does not match the mask", mask == mitk::BinaryMask::FromLabel(m_Image, 1));
+    CPPUNIT_ASSERT_MESSAGE("Other labels were changed", otherLabel == mitk::BinaryMask::FromLabel(m_Image, 2));
+  }
+
+  void BooleanOperations_MatchVoxelwiseOperations()
+  {
+    const auto label1 = mitk::BinaryMask::FromLabel(m_Image, 1);
+    const auto label2 = mitk::BinaryMask::FromLabel(m_Image, 2);
+    const auto nonzero = mitk::BinaryMask::FromImage(m_Image);
+
+    auto unionMask = label1;
+    unionMask |= label2;
+    CPPUNIT_ASSERT(unionMask == nonzero);
+
+    auto intersection = label1;
+    intersection &= nonzero;
+    CPPUNIT_ASSERT(intersection == label1);
+
+    auto exclusive = nonzero;
+    exclusive ^= label1;
+    CPPUNIT_ASSERT(exclusive == label2);
+
+    auto difference = nonzero;
+    difference.Subtract(label2);
+    CPPUNIT_ASSERT(difference == label1);
+
+    auto background = nonzero;
+    background.Invert();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(70 * 13 * 9),
+                         background.GetNumberOfForegroundVoxels() + nonzero.GetNumberOfForegroundVoxels());
+    background &= nonzero;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), background.GetNumberOfForegroundVoxels());
+  }
+
+  void BooleanOperations_DifferentSizes_Throws()
+  {
+    auto mask = mitk::BinaryMask::FromImage(m_Image);
+    CPPUNIT_ASSERT_THROW(mask &= mitk::BinaryMask(70, 13, 8), mitk::Exception);
+  }
+
+  void Dilate_Ball_MatchesItk()
+  {
+    auto mask = mitk::BinaryMask::FromLabel(m_Image, 1);
+    mask.Dilate(mitk::BinaryMask::CreateBall(3, 2, 1));
+    CPPUNIT_ASSERT(mask == this->ItkDilate(CreateItkStructuringElement<BallType>(3, 2, 1)));
+  }
+
+  void Erode_Ball_MatchesItk()
+  {
+    auto mask = mitk::BinaryMask::FromLabel(m_Image, 1);
+    mask.Erode(mitk::BinaryMask::CreateBall(1, 1, 1));
+    CPPUNIT_ASSERT(mask == this->ItkErode(CreateItkStructuringElement<BallType>(1, 1, 1)));
+  }
+
+  void Dilate_Cross_MatchesItk()
+  {
+    auto mask = mitk::BinaryMask::FromLabel(m_Image, 1);
+    mask.Dilate(mitk::BinaryMask::CreateCross(2, 2, 0));
+    CPPUNIT_ASSERT(mask == this->ItkDilate(CreateItkStructuringElement<CrossType>(2, 2, 0)));
+  }
+
+  void Erode_Cross_MatchesItk()
+  {
+    auto mask = mitk::BinaryMask::FromLabel(m_Image, 1);
+    mask.Erode(mitk::BinaryMask::CreateCross(1, 1, 1));
+    CPPUNIT_ASSERT(mask == this->ItkErode(CreateItkStructuringElement<CrossType>(1, 1, 1)));
+  }
+
+  void Closing_MatchesItk()
+  {
+    auto filter = itk::BinaryMorphologicalClosingImageFilter<ImageType, ImageType, BallType>::New();
+    filter->SetKernel(CreateItkStructuringElement<BallType>(2, 2, 2));
+    filter->SetForegroundValue(1);
+    const auto expected = this->RunItkFilter(filter.GetPointer());
+
+    mitk::MorphologicalOperations::Closing(m_Image, 2, mitk::MorphologicalOperations::Ball);
+    CPPUNIT_ASSERT(expected == mitk::BinaryMask::FromLabel(m_Image, 1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBinaryMask)
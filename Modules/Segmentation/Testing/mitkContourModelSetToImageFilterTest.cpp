@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include <mitkContourModelSetToImageFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
@@ -21,12 +22,33 @@ class mitkContourModelSetToImageFilterTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkContourModelSetToImageFilterTestSuite);
   MITK_TEST(TestFillContourSetIntoImage);
+  MITK_TEST(TestFillContoursWithHoles);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::ContourModelSetToImageFilter::Pointer m_ContourFiller;
 
 public:
+  static mitk::ContourModel::Pointer CreateRectangle(
+    unsigned int axis, double slice, double uMin, double vMin, double uMax, double vMax)
+  {
+    const unsigned int uAxis = axis == 0 ? 1 : 0;
+    const unsigned int vAxis = axis == 2 ? 1 : 2;
+    const double corners[4][2] = {{uMin, vMin}, {uMax, vMin}, {uMax, vMax}, {uMin, vMax}};
+
+    auto contour = mitk::ContourModel::New();
+    for (const auto &corner : corners)
+    {
+      mitk::Point3D point;
+      point[axis] = slice;
+      point[uAxis] = corner[0];
+      point[vAxis] = corner[1];
+      contour->AddVertex(point);
+    }
+    contour->Close();
+    return contour;
+  }
+
   void setUp() override
   {
     m_ContourFiller = mitk::ContourModelSetToImageFilter::New();
@@ -51,6 +73,51 @@ public:
 
     MITK_ASSERT_EQUAL(refImage, filledImage, "Error filling contours into image");
   }
+
+  void TestFillContoursWithHoles()
+  {
+    // spacing 1 and origin 0, so world and index coordinates are the same
+    const unsigned int dimensions[3] = {20, 20, 5};
+    auto refImage = mitk::Image::New();
+    refImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    auto contourSet = mitk::ContourModelSet::New();
+    contourSet->AddContourModel(CreateRectangle(2, 2, 2.5, 2.5, 12.5, 12.5));
+    contourSet->AddContourModel(CreateRectangle(2, 2, 5.5, 5.5, 8.5, 8.5)); // hole
+    contourSet->AddContourModel(CreateRectangle(0, 15, 3, 1, 6, 3));     // border on pixel centers
+
+    m_ContourFiller->SetImage(refImage);
+    m_ContourFiller->SetInput(contourSet);
+    m_ContourFiller->SetNumberOfThreads(3);
+    m_ContourFiller->Update();
+
+    mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(m_ContourFiller->GetOutput());
+
+    unsigned int numberOfForegroundVoxels = 0;
+    for (unsigned int z = 0; z < dimensions[2]; ++z)
+    {
+      for (unsigned int y = 0; y < dimensions[1]; ++y)
+      {
+        for (unsigned int x = 0; x < dimensions[0]; ++x)
+        {
+          itk::Index<3> index;
+          index[0] = x;
+          index[1] = y;
+          index[2] = z;
+          numberOfForegroundVoxels += accessor.GetPixelByIndex(index) == 1 ? 1 : 0;
+        }
+      }
+    }
+
+    const itk::Index<3> inside = {{3, 12, 2}};
+    const itk::Index<3> hole = {{7, 7, 2}};
+    const itk::Index<3> border = {{15, 6, 3}};
+
+    CPPUNIT_ASSERT_EQUAL(1, int(accessor.GetPixelByIndex(inside)));
+    CPPUNIT_ASSERT_EQUAL(0, int(accessor.GetPixelByIndex(hole)));
+    CPPUNIT_ASSERT_EQUAL(1, int(accessor.GetPixelByIndex(border)));
+    CPPUNIT_ASSERT_EQUAL(100u - 9u + 4u * 3u, numberOfForegroundVoxels);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourModelSetToImageFilter)
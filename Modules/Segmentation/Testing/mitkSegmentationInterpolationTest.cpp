@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include <mitkTestingMacros.h>
 
 // other
+#include <mitkBatchSliceInterpolator.h>
 #include <mitkExtractSliceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
@@ -31,11 +32,15 @@ class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Frontal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_Axial_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_Frontal_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_Sagittal_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(BatchInterpolation_Cancelled_ResultIsEmpty);
+  MITK_TEST(BatchInterpolation_CancelledWhileInterpolating_StopsEarly);
   CPPUNIT_TEST_SUITE_END();
 
 private:
-  // The tests all do the same, only in different directions
-  void testRoutine(mitk::SliceNavigationController::ViewDirection viewDirection)
+  static int GetSliceDimension(mitk::SliceNavigationController::ViewDirection viewDirection)
   {
     int dim;
     switch (viewDirection)
@@ -53,7 +58,11 @@ private:
         dim = -1;
         break;
     }
+    return dim;
+  }
 
+  void FillSegmentation(int dim)
+  {
     /* Fill segmentation
      *
      * 1st slice: 3x3 square segmentation
@@ -83,6 +92,53 @@ private:
       currentPoint[dim] = m_CenterPoint[dim] + 1;
       writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
     }
+  }
+
+  void CheckInterpolation(mitk::Image *image, int dim)
+  {
+    // Check a 4x4 square, the center of which needs to be filled
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(image);
+    itk::Index<3> currentPoint = m_CenterPoint;
+
+    for (int i = -1; i <= 2; ++i)
+    {
+      for (int j = -1; j <= 2; ++j)
+      {
+        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
+        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+
+        if (i == -1 || i == 2 || j == -1 || j == 2)
+        {
+          CPPUNIT_ASSERT_MESSAGE("Have false positive segmentation.",
+                                 readAccess.GetPixelByIndexSafe(currentPoint) == 0);
+        }
+        else
+        {
+          CPPUNIT_ASSERT_MESSAGE("Have false negative segmentation.",
+                                 readAccess.GetPixelByIndexSafe(currentPoint) == 1);
+        }
+      }
+    }
+  }
+
+  mitk::Image::Pointer CreateEmptyImage()
+  {
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(m_SegmentationImage);
+
+    mitk::ImageWriteAccessor imageAccessor(image);
+    memset(imageAccessor.GetData(),
+           0,
+           sizeof(mitk::Tool::DefaultSegmentationDataType) * image->GetDimension(0) * image->GetDimension(1) *
+             image->GetDimension(2));
+    return image;
+  }
+
+  // The tests all do the same, only in different directions
+  void testRoutine(mitk::SliceNavigationController::ViewDirection viewDirection)
+  {
+    const int dim = GetSliceDimension(viewDirection);
+    FillSegmentation(dim);
 
     //        mitk::IOUtil::Save(m_SegmentationImage, "SOME PATH");
 
@@ -119,29 +175,30 @@ private:
 
     //        mitk::IOUtil::Save(m_SegmentationImage, "SOME PATH");
 
-    // Check a 4x4 square, the center of which needs to be filled
-    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(m_SegmentationImage);
-    currentPoint = m_CenterPoint;
+    CheckInterpolation(m_SegmentationImage, dim);
+  }
 
-    for (int i = -1; i <= 2; ++i)
-    {
-      for (int j = -1; j <= 2; ++j)
-      {
-        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
-        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+  void batchTestRoutine(mitk::SliceNavigationController::ViewDirection viewDirection)
+  {
+    const int dim = GetSliceDimension(viewDirection);
+    FillSegmentation(dim);
 
-        if (i == -1 || i == 2 || j == -1 || j == 2)
-        {
-          CPPUNIT_ASSERT_MESSAGE("Have false positive segmentation.",
-                                 readAccess.GetPixelByIndexSafe(currentPoint) == 0);
-        }
-        else
-        {
-          CPPUNIT_ASSERT_MESSAGE("Have false negative segmentation.",
-                                 readAccess.GetPixelByIndexSafe(currentPoint) == 1);
-        }
-      }
-    }
+    mitk::Image::Pointer result = CreateEmptyImage();
+    mitk::BatchSliceInterpolator::Pointer interpolator = mitk::BatchSliceInterpolator::New();
+
+    unsigned int progress = 0;
+    interpolator->SetProgressCallback([&progress](unsigned int interpolatedSlices, unsigned int numberOfSlices) {
+      CPPUNIT_ASSERT_MESSAGE("Progress exceeds the number of slices.", interpolatedSlices <= numberOfSlices);
+      progress = interpolatedSlices;
+      return true;
+    });
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+      "Wrong number of interpolated slices.", 1u, interpolator->Interpolate(m_SegmentationImage, dim, result));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Progress did not reach the end.", 1u, progress);
+    CPPUNIT_ASSERT_MESSAGE("Interpolation was cancelled.", !interpolator->GetCancelled());
+
+    CheckInterpolation(result, dim);
   }
 
   mitk::Image::Pointer m_ReferenceImage;
@@ -199,6 +256,70 @@ public:
     mitk::SliceNavigationController::ViewDirection viewDirection = mitk::SliceNavigationController::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void Equal_Axial_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue()
+  {
+    batchTestRoutine(mitk::SliceNavigationController::Axial);
+  }
+
+  void Equal_Frontal_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue()
+  {
+    batchTestRoutine(mitk::SliceNavigationController::Frontal);
+  }
+
+  void Equal_Sagittal_TestBatchInterpolationAndReferenceInterpolation_ReturnsTrue()
+  {
+    batchTestRoutine(mitk::SliceNavigationController::Sagittal);
+  }
+
+  void BatchInterpolation_Cancelled_ResultIsEmpty()
+  {
+    FillSegmentation(2);
+
+    mitk::Image::Pointer result = CreateEmptyImage();
+    mitk::BatchSliceInterpolator::Pointer interpolator = mitk::BatchSliceInterpolator::New();
+    interpolator->SetProgressCallback([](unsigned int, unsigned int) { return false; });
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+      "Slices interpolated after cancelling.", 0u, interpolator->Interpolate(m_SegmentationImage, 2, result));
+    CPPUNIT_ASSERT_MESSAGE("Interpolation was not cancelled.", interpolator->GetCancelled());
+
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(result);
+    CPPUNIT_ASSERT_MESSAGE("Cancelled interpolation wrote into the result.",
+                           readAccess.GetPixelByIndexSafe(m_CenterPoint) == 0);
+  }
+
+  void BatchInterpolation_CancelledWhileInterpolating_StopsEarly()
+  {
+    // key slices at both ends of the volume, so all slices in between are interpolated
+    const unsigned int numberOfSlices = m_SegmentationImage->GetDimension(2);
+    CPPUNIT_ASSERT_MESSAGE("Test image has too few slices.", numberOfSlices > 3);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+      itk::Index<3> currentPoint = m_CenterPoint;
+      currentPoint[2] = 0;
+      writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+      currentPoint[2] = numberOfSlices - 1;
+      writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+    }
+
+    mitk::Image::Pointer result = CreateEmptyImage();
+    mitk::BatchSliceInterpolator::Pointer interpolator = mitk::BatchSliceInterpolator::New();
+    interpolator->SetNumberOfThreads(1);
+
+    // cancel at the first progress report after the start
+    unsigned int slicesToInterpolate = 0;
+    interpolator->SetProgressCallback([&](unsigned int interpolatedSlices, unsigned int numberOfSlicesToInterpolate) {
+      slicesToInterpolate = numberOfSlicesToInterpolate;
+      return interpolatedSlices == 0;
+    });
+
+    const unsigned int interpolatedSlices = interpolator->Interpolate(m_SegmentationImage, 2, result);
+
+    CPPUNIT_ASSERT_MESSAGE("Interpolation was not cancelled.", interpolator->GetCancelled());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong number of slices to interpolate.", numberOfSlices - 2, slicesToInterpolate);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Interpolation went on after cancelling.", 1u, interpolatedSlices);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
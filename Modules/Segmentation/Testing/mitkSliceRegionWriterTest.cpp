@@ -0,0 +1,221 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkRotationOperation.h>
+#include <mitkSliceRegionWriter.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <vtkSmartPointer.h>
+
+#include <cstring>
+
+namespace
+{
+  const int SliceRegionWriterTestVolumeSize = 32;
+
+  typedef mitk::SliceRegionWriter::RegionType RegionType;
+  typedef mitk::ImagePixelReadAccessor<unsigned short, 2> SliceReadAccessorType;
+  typedef mitk::ImagePixelWriteAccessor<unsigned short, 2> SliceWriteAccessorType;
+
+  mitk::Image::Pointer CreateVolume()
+  {
+    typedef itk::Image<unsigned short, 3> ImageType;
+
+    ImageType::Pointer image = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize(0, SliceRegionWriterTestVolumeSize);
+    region.SetSize(1, SliceRegionWriterTestVolumeSize);
+    region.SetSize(2, SliceRegionWriterTestVolumeSize);
+    image->SetRegions(region);
+    image->SetSpacing(1.0);
+    image->Allocate();
+
+    // distinct values for all voxels
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType index = it.GetIndex();
+      it.Set(index[0] + SliceRegionWriterTestVolumeSize * (index[1] + SliceRegionWriterTestVolumeSize * index[2]));
+    }
+
+    mitk::Image::Pointer volume;
+    mitk::CastToMitkImage(image, volume);
+    return volume;
+  }
+
+  mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Image *volume, float degree)
+  {
+    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(volume->GetGeometry(), mitk::PlaneGeometry::Axial, 13, true, false);
+    mitk::Vector3D normal = plane->GetNormal();
+    normal.Normalize();
+    plane->SetOrigin(plane->GetOrigin() + normal * 0.5); // pixelspacing is 1, so half the spacing is 0.5
+
+    if (degree != 0)
+    {
+      mitk::Vector3D rotationVector = plane->GetAxisVector(0);
+      rotationVector.Normalize();
+
+      auto op = new mitk::RotationOperation(mitk::OpROTATE, plane->GetCenter(), rotationVector, degree);
+      plane->ExecuteOperation(op);
+      delete op;
+    }
+    return plane;
+  }
+
+  /** Extracts the whole slice the way SegTool2D does.*/
+  mitk::Image::Pointer ExtractSlice(const mitk::Image *volume, const mitk::PlaneGeometry *plane)
+  {
+    vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslice->SetOverwriteMode(false);
+
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(volume);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetResliceTransformByGeometry(volume->GetGeometry());
+    extractor->Update();
+
+    mitk::Image::Pointer slice = extractor->GetOutput();
+    slice->DisconnectPipeline();
+    return slice;
+  }
+
+  bool IsEqualData(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    if (image1->GetDimension(0) != image2->GetDimension(0) || image1->GetDimension(1) != image2->GetDimension(1) ||
+        image1->GetDimension(2) != image2->GetDimension(2))
+      return false;
+
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+    const std::size_t size = image1->GetDimension(0) * image1->GetDimension(1) * image1->GetDimension(2) *
+                             image1->GetPixelType().GetSize();
+    return 0 == std::memcmp(accessor1.GetData(), accessor2.GetData(), size);
+  }
+
+  void FillRegion(mitk::Image *regionSlice, unsigned short value)
+  {
+    SliceWriteAccessorType accessor(regionSlice);
+    const itk::IndexValueType width = regionSlice->GetDimension(0);
+    const itk::IndexValueType height = regionSlice->GetDimension(1);
+
+    itk::Index<2> index;
+    for (index[1] = 0; index[1] < height; ++index[1])
+      for (index[0] = 0; index[0] < width; ++index[0])
+        accessor.SetPixelByIndex(index, value);
+  }
+
+  /** Checks the pixels of the slice: value inside the region and, if checkOutside, the original values outside.*/
+  bool CheckSlice(
+    mitk::Image *slice, mitk::Image *originalSlice, const RegionType &region, unsigned short value, bool checkOutside)
+  {
+    SliceReadAccessorType accessor(slice);
+    SliceReadAccessorType originalAccessor(originalSlice);
+
+    const itk::IndexValueType width = slice->GetDimension(0);
+    const itk::IndexValueType height = slice->GetDimension(1);
+
+    itk::Index<2> index;
+    for (index[1] = 0; index[1] < height; ++index[1])
+    {
+      for (index[0] = 0; index[0] < width; ++index[0])
+      {
+        if (region.IsInside(index))
+        {
+          if (accessor.GetPixelByIndex(index) != value)
+            return false;
+        }
+        else if (checkOutside && accessor.GetPixelByIndex(index) != originalAccessor.GetPixelByIndex(index))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void TestRegionRoundTrip(float degree, const std::string &description)
+  {
+    mitk::Image::Pointer volume = CreateVolume();
+    mitk::PlaneGeometry::Pointer plane = CreatePlane(volume, degree);
+    mitk::Image::Pointer slice = ExtractSlice(volume, plane);
+
+    RegionType region;
+    region.SetIndex(0, 5);
+    region.SetIndex(1, 6);
+    region.SetSize(0, 10);
+    region.SetSize(1, 8);
+
+    mitk::Image::Pointer regionSlice = mitk::SliceRegionWriter::ExtractRegion(volume, 0, plane, region);
+    MITK_TEST_CONDITION(IsEqualData(regionSlice, mitk::SliceRegionWriter::CropSlice(slice, region)),
+                        "Testing extraction of a region of the " << description << " slice");
+
+    mitk::Image::Pointer volumeBefore = volume->Clone();
+    mitk::SliceRegionWriter::WriteRegion(volume, 0, plane, regionSlice, region);
+    MITK_TEST_CONDITION(IsEqualData(volume, volumeBefore),
+                        "Testing write back of an unmodified region of the " << description << " slice");
+
+    FillRegion(regionSlice, 7);
+    mitk::SliceRegionWriter::WriteRegion(volume, 0, plane, regionSlice, region);
+
+    // in an oblique slice, pixels outside the region may be sampled from the voxels of the region
+    MITK_TEST_CONDITION(CheckSlice(ExtractSlice(volume, plane), slice, region, 7, degree == 0),
+                        "Testing write back of a modified region of the " << description << " slice");
+  }
+}
+
+int mitkSliceRegionWriterTest(int, char *[])
+{
+  MITK_TEST_BEGIN("mitkSliceRegionWriterTest")
+
+  // difference region
+  {
+    mitk::Image::Pointer volume = CreateVolume();
+    mitk::Image::Pointer slice = ExtractSlice(volume, CreatePlane(volume, 0));
+    mitk::Image::Pointer modifiedSlice = slice->Clone();
+
+    MITK_TEST_CONDITION(mitk::SliceRegionWriter::ComputeDifferenceRegion(slice, modifiedSlice).GetNumberOfPixels() == 0,
+                        "Testing difference region of equal slices");
+
+    {
+      SliceWriteAccessorType accessor(modifiedSlice);
+      itk::Index<2> index;
+      index[0] = 3;
+      index[1] = 7;
+      accessor.SetPixelByIndex(index, 0);
+      index[0] = 10;
+      index[1] = 4;
+      accessor.SetPixelByIndex(index, 0);
+    }
+
+    const RegionType region = mitk::SliceRegionWriter::ComputeDifferenceRegion(slice, modifiedSlice);
+    MITK_TEST_CONDITION(region.GetIndex(0) == 3 && region.GetIndex(1) == 4 && region.GetSize(0) == 8 &&
+                          region.GetSize(1) == 4,
+                        "Testing difference region of modified slices");
+  }
+
+  TestRegionRoundTrip(0, "axis aligned");
+  TestRegionRoundTrip(45, "oblique");
+
+  MITK_TEST_END()
+}
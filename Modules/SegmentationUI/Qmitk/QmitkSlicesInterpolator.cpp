@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "QmitkStdMultiWidget.h"
 
 #include "mitkApplyDiffImageOperation.h"
+#include "mitkBatchSliceInterpolator.h"
 #include "mitkColorProperty.h"
 #include "mitkCoreObjectFactory.h"
 #include "mitkDiffImageApplier.h"
@@ -45,6 +46,7 @@ found in the LICENSE file.
 #include <QCursor>
 #include <QMenu>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QVBoxLayout>
 
@@ -711,55 +713,56 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
                diffImage->GetDimension(2));
     }
 
-    // Since we need to shift the plane it must be clone so that the original plane isn't altered
-    mitk::PlaneGeometry::Pointer reslicePlane = slicer->GetCurrentPlaneGeometry()->Clone();
-
     int sliceDimension(-1);
     int sliceIndex(-1);
-    mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, reslicePlane, sliceDimension, sliceIndex);
+    mitk::SegTool2D::DetermineAffectedImageSlice(
+      m_Segmentation, slicer->GetCurrentPlaneGeometry(), sliceDimension, sliceIndex);
 
-    unsigned int zslices = m_Segmentation->GetDimension(sliceDimension);
-    mitk::ProgressBar::GetInstance()->AddStepsToDo(zslices);
+    // interpolate all slices at once, the progress is reported on the GUI thread and the interpolation can be
+    // cancelled with the progress dialog
+    QProgressDialog progressDialog(tr("Interpolating slices..."), tr("Cancel"), 0, 0, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
 
-    mitk::Point3D origin = reslicePlane->GetOrigin();
     unsigned int totalChangedSlices(0);
-
-    for (unsigned int sliceIndex = 0; sliceIndex < zslices; ++sliceIndex)
-    {
-      // Transforming the current origin of the reslice plane
-      // so that it matches the one of the next slice
-      m_Segmentation->GetSlicedGeometry()->WorldToIndex(origin, origin);
-      origin[sliceDimension] = sliceIndex;
-      m_Segmentation->GetSlicedGeometry()->IndexToWorld(origin, origin);
-      reslicePlane->SetOrigin(origin);
-      // Set the slice as 'input'
-      mitk::Image::Pointer interpolation =
-        m_Interpolator->Interpolate(sliceDimension, sliceIndex, reslicePlane, timeStep);
-
-      if (interpolation.IsNotNull()) // we don't check if interpolation is necessary/sensible - but m_Interpolator does
+    unsigned int slicesToInterpolate(0);
+    unsigned int reportedSlices(0);
+    mitk::BatchSliceInterpolator::Pointer batchInterpolator = mitk::BatchSliceInterpolator::New();
+    batchInterpolator->SetProgressCallback([&](unsigned int interpolatedSlices, unsigned int numberOfSlices) {
+      if (interpolatedSlices == 0)
       {
-        // Setting up the reslicing pipeline which allows us to write the interpolation results back into
-        // the image volume
-        vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-        // set overwrite mode to true to write back to the image volume
-        reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-        reslice->SetOverwriteMode(true);
-        reslice->Modified();
-
-        mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
-        diffslicewriter->SetInput(diffImage);
-        diffslicewriter->SetTimeStep(0);
-        diffslicewriter->SetWorldGeometry(reslicePlane);
-        diffslicewriter->SetVtkOutputRequest(true);
-        diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-
-        diffslicewriter->Modified();
-        diffslicewriter->Update();
-        ++totalChangedSlices;
+        slicesToInterpolate = numberOfSlices;
+        mitk::ProgressBar::GetInstance()->AddStepsToDo(numberOfSlices);
+        progressDialog.setMaximum(static_cast<int>(numberOfSlices));
       }
-      mitk::ProgressBar::GetInstance()->Progress();
+      else
+      {
+        mitk::ProgressBar::GetInstance()->Progress(interpolatedSlices - reportedSlices);
+      }
+
+      reportedSlices = interpolatedSlices;
+
+      // a modal dialog processes the events, so the cancel button is handled here
+      progressDialog.setValue(static_cast<int>(interpolatedSlices));
+      return !progressDialog.wasCanceled();
+    });
+
+    try
+    {
+      totalChangedSlices = batchInterpolator->Interpolate(image3D, sliceDimension, diffImage);
+
+      // the slices written before the cancellation are discarded
+      if (batchInterpolator->GetCancelled())
+        totalChangedSlices = 0;
+    }
+    catch (const mitk::Exception &e)
+    {
+      MITK_ERROR << "Error in 2D interpolation: " << e.GetDescription();
+      totalChangedSlices = 0;
     }
+    if (reportedSlices < slicesToInterpolate)
+      mitk::ProgressBar::GetInstance()->Progress(slicesToInterpolate - reportedSlices);
+    progressDialog.reset();
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 
     if (totalChangedSlices > 0)
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkSemanticRelationsInference.h"
 #include "mitkSemanticRelationsIntegration.h"
 #include "mitkSemanticRelationsDataStorageAccess.h"
+#include "mitkRelationIndex.h"
 #include "mitkRelationStorage.h"
 #include "mitkControlPointManager.h"
 #include "mitkDICOMHelper.h"
@@ -27,6 +28,7 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkVectorProperty.h>
 
 // mitk persistence
 #include <mitkPersistenceService.h>
@@ -38,6 +40,7 @@ class mitkSemanticRelationsTestSuite : public mitk::TestFixture
   MITK_TEST(InferenceTest);
   MITK_TEST(DataStorageAccessTest);
   MITK_TEST(RemoveAndUnlinkTest);
+  MITK_TEST(RelationIndexTest);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -95,6 +98,13 @@ public:
     MITK_INFO << "=== RemoveAndUnlinkTest end ===";
   }
 
+  void RelationIndexTest()
+  {
+    MITK_INFO << "=== RelationIndexTest start ===";
+    IndexQueries();
+    MITK_INFO << "=== RelationIndexTest end ===";
+  }
+
   //////////////////////////////////////////////////////////////////////////
   // SPECIFIC TESTS
   //////////////////////////////////////////////////////////////////////////
@@ -803,6 +813,75 @@ public:
     CPPUNIT_ASSERT_MESSAGE("One lesions should be stored", allLesions.size() == 1);
   }
 
+  // RelationIndexTest
+  void IndexQueries()
+  {
+    MITK_INFO << "=== IndexQueries";
+
+    auto setStrings = [](mitk::PropertyList* propertyList, const std::string& key, const std::vector<std::string>& value)
+    {
+      auto vectorProperty = mitk::VectorProperty<std::string>::New();
+      vectorProperty->SetValue(value);
+      propertyList->SetProperty(key, vectorProperty);
+    };
+
+    // storage data of a case with two control points, two images, three segmentations and two lesions
+    auto propertyList = mitk::PropertyList::New();
+    setStrings(propertyList, "controlpoints", { "cp1", "cp2" });
+    auto firstDate = mitk::VectorProperty<int>::New();
+    firstDate->SetValue({ 2019, 1, 10 });
+    propertyList->SetProperty("cp1", firstDate);
+    auto secondDate = mitk::VectorProperty<int>::New();
+    secondDate->SetValue({ 2019, 6, 20 });
+    propertyList->SetProperty("cp2", secondDate);
+    setStrings(propertyList, "informationtypes", { "CT", "MR" });
+    setStrings(propertyList, "images", { "image1", "image2", "image3" });
+    setStrings(propertyList, "image1", { "CT", "cp1" });
+    setStrings(propertyList, "image2", { "MR", "cp2" });
+    setStrings(propertyList, "image3", { "CT" });
+    setStrings(propertyList, "lesions", { "lesion1", "lesion2" });
+    setStrings(propertyList, "lesion1", { "first lesion", "class1" });
+    setStrings(propertyList, "lesion2", { "second lesion", "class1" });
+    propertyList->SetStringProperty("class1", "tumor");
+    setStrings(propertyList, "segmentations", { "seg1", "seg2", "seg3" });
+    setStrings(propertyList, "seg1", { "image1", "lesion1" });
+    setStrings(propertyList, "seg2", { "image2", "lesion1" });
+    setStrings(propertyList, "seg3", { "image2", "" });
+
+    mitk::RelationIndex relationIndex(propertyList);
+    CPPUNIT_ASSERT_MESSAGE("Index should be up to date", relationIndex.IsUpToDate(propertyList));
+
+    CPPUNIT_ASSERT_MESSAGE("Two lesions should be stored", relationIndex.GetAllLesions().size() == 2);
+    CPPUNIT_ASSERT_MESSAGE("Lesion class should be stored", relationIndex.GetLesion("lesion2").lesionClass.classType == "tumor");
+    CPPUNIT_ASSERT_MESSAGE("Segmentation should represent lesion1", relationIndex.GetLesionOfSegmentation("seg2").UID == "lesion1");
+    CPPUNIT_ASSERT_MESSAGE("Segmentation should not represent a lesion", relationIndex.GetLesionOfSegmentation("seg3").UID.empty());
+
+    CPPUNIT_ASSERT_MESSAGE("Image with incorrect storage data should not be indexed", !relationIndex.ContainsImage("image3")
+      && relationIndex.GetAllImageIDs().size() == 3);
+    CPPUNIT_ASSERT_MESSAGE("Image should refer to cp2", relationIndex.GetControlPointOfImage("image2").date == boost::gregorian::date(2019, 6, 20));
+    CPPUNIT_ASSERT_MESSAGE("One image should be of type CT", relationIndex.GetAllImageIDsOfInformationType("CT") == mitk::SemanticTypes::IDVector({ "image1" }));
+    CPPUNIT_ASSERT_MESSAGE("Two segmentations should refer to image2", relationIndex.GetAllSegmentationIDsOfImage("image2").size() == 2);
+
+    CPPUNIT_ASSERT_MESSAGE("Lesion should be visible on two images",
+      relationIndex.GetAllImageIDsOfLesion("lesion1") == mitk::SemanticTypes::IDVector({ "image1", "image2" }));
+    auto lesionUIDsOfControlPoint = relationIndex.GetAllLesionUIDsOfImages(relationIndex.GetAllImageIDsOfControlPoint("cp2"));
+    CPPUNIT_ASSERT_MESSAGE("Only lesion1 should be visible at cp2", lesionUIDsOfControlPoint.size() == 1 && lesionUIDsOfControlPoint.count("lesion1") == 1);
+
+    // changing a vector property in place does not modify the property list, the changed table has to be updated
+    auto segmentationData = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty("seg3"));
+    segmentationData->SetValue({ "image2", "lesion2" });
+    relationIndex.Update(propertyList, mitk::RelationIndex::SegmentationTable);
+    CPPUNIT_ASSERT_MESSAGE("Index should be up to date", relationIndex.IsUpToDate(propertyList));
+    CPPUNIT_ASSERT_MESSAGE("Lesion2 should be visible on image2", relationIndex.GetAllImageIDsOfLesion("lesion2") == mitk::SemanticTypes::IDVector({ "image2" }));
+    CPPUNIT_ASSERT_MESSAGE("Lesion of other table should be kept", relationIndex.GetLesion("lesion2").name == "second lesion");
+
+    // adding a property modifies the property list and has to invalidate the index
+    setStrings(propertyList, "image3", { "MR", "cp1" });
+    CPPUNIT_ASSERT_MESSAGE("Index should be outdated", !relationIndex.IsUpToDate(propertyList));
+
+    mitk::RelationIndex updatedRelationIndex(propertyList);
+    CPPUNIT_ASSERT_MESSAGE("Two images should be of type MR", updatedRelationIndex.GetAllImageIDsOfInformationType("MR") == mitk::SemanticTypes::IDVector({ "image2", "image3" }));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSemanticRelations)
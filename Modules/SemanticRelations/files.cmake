@@ -6,6 +6,7 @@ set(CPP_FILES
   mitkLesionData.cpp
   mitkLesionManager.cpp
   mitkNodePredicates.cpp
+  mitkRelationIndex.cpp
   mitkRelationStorage.cpp
   mitkSemanticRelationsDataStorageAccess.cpp
   mitkSemanticRelationsInference.cpp
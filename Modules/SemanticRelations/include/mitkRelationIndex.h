@@ -0,0 +1,198 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKRELATIONINDEX_H
+#define MITKRELATIONINDEX_H
+
+#include <MitkSemanticRelationsExports.h>
+
+// semantic relations module
+#include "mitkSemanticTypes.h"
+
+// mitk core
+#include <mitkPropertyList.h>
+
+// c++
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mitk
+{
+  /**
+  * @brief In-memory index of the semantic relations of a single case.
+  *
+  *   The relations of a case are stored as properties of the case's property list (see 'RelationStorage').
+  *   The index reads this property list once and keeps the instances in typed tables with hash indices on
+  *   their UIDs and on the relations between them (image - control point, image - information type,
+  *   segmentation - image and segmentation - lesion). Queries and joins therefore cost time proportional
+  *   to the size of their result instead of the size of the case.
+  *
+  *   Only instances that are listed in the ID vectors of the case ("images", "segmentations", "lesions",
+  *   "controlpoints", "examinationperiods") and that have correct storage data are indexed. 'GetAllImageIDs' and
+  *   'GetAllSegmentationIDs' return the stored ID vectors unfiltered, as 'RelationStorage' always did.
+  *
+  *   The index is a snapshot and does not observe the property list. 'IsUpToDate' compares the modified time of
+  *   the property list itself with the one at the last update, without visiting the properties of the list. Setting
+  *   the value of a contained property does not modify the property list, so a writer that changes properties in
+  *   place has to call 'Update' for the changed tables, as 'RelationStorage' does.
+  */
+  class MITKSEMANTICRELATIONS_EXPORT RelationIndex
+  {
+  public:
+    /**
+    * @brief Builds the index in a single pass over the storage data of a case.
+    *
+    * @param propertyList   The property list that stores the relations of the case. May be nullptr for an empty index.
+    */
+    explicit RelationIndex(const PropertyList* propertyList);
+
+    /**
+    * @brief The tables of the index. Each table is read only from its own properties of the case.
+    */
+    enum Table : unsigned int
+    {
+      ImageTable = 1,
+      SegmentationTable = 2,
+      LesionTable = 4,
+      ControlPointTable = 8,
+      ExaminationPeriodTable = 16,
+      InformationTypeTable = 32,
+      AllTables = 63
+    };
+
+    /**
+    * @brief Reads the given tables again after their storage data was changed.
+    *
+    * @param propertyList   The property list that stores the relations of the case. If it is not the property list
+    *                       of the index, all tables are read from it.
+    * @param tables         The combination of the 'Table' values of the changed tables.
+    */
+    void Update(const PropertyList* propertyList, unsigned int tables);
+
+    /**
+    * @brief Return true, if the index was built from the given property list and the list was not modified since
+    *        the last update.
+    */
+    bool IsUpToDate(const PropertyList* propertyList) const;
+
+    const SemanticTypes::LesionVector& GetAllLesions() const;
+    bool ContainsLesion(const SemanticTypes::ID& lesionUID) const;
+    /**
+    * @brief Return the lesion with the given UID or an empty lesion, if the lesion is not contained.
+    */
+    SemanticTypes::Lesion GetLesion(const SemanticTypes::ID& lesionUID) const;
+    SemanticTypes::Lesion GetLesionOfSegmentation(const SemanticTypes::ID& segmentationID) const;
+
+    const SemanticTypes::ControlPointVector& GetAllControlPoints() const;
+    bool ContainsControlPoint(const SemanticTypes::ID& controlPointUID) const;
+    /**
+    * @brief Return the control point with the given UID or an empty control point, if the control point is not contained.
+    */
+    SemanticTypes::ControlPoint GetControlPoint(const SemanticTypes::ID& controlPointUID) const;
+    SemanticTypes::ControlPoint GetControlPointOfImage(const SemanticTypes::ID& imageID) const;
+    /**
+    * @brief Return the control point UID that is stored for the given image, even if it does not refer to a contained control point.
+    */
+    SemanticTypes::ID GetControlPointUIDOfImage(const SemanticTypes::ID& imageID) const;
+
+    const SemanticTypes::ExaminationPeriodVector& GetAllExaminationPeriods() const;
+    bool ContainsExaminationPeriod(const SemanticTypes::ID& examinationPeriodUID) const;
+
+    const SemanticTypes::InformationTypeVector& GetAllInformationTypes() const;
+    bool ContainsInformationType(const SemanticTypes::InformationType& informationType) const;
+    SemanticTypes::InformationType GetInformationTypeOfImage(const SemanticTypes::ID& imageID) const;
+
+    const SemanticTypes::IDVector& GetAllImageIDs() const;
+    bool ContainsImage(const SemanticTypes::ID& imageID) const;
+    /**
+    * @brief Return the IDs of all images that refer to the given control point UID, in storage order.
+    */
+    const SemanticTypes::IDVector& GetAllImageIDsOfControlPoint(const SemanticTypes::ID& controlPointUID) const;
+    /**
+    * @brief Return the IDs of all images that refer to the given information type, in storage order.
+    */
+    const SemanticTypes::IDVector& GetAllImageIDsOfInformationType(const SemanticTypes::InformationType& informationType) const;
+    /**
+    * @brief Return the sorted, unique IDs of the images of all segmentations that refer to the given lesion UID.
+    */
+    SemanticTypes::IDVector GetAllImageIDsOfLesion(const SemanticTypes::ID& lesionUID) const;
+
+    const SemanticTypes::IDVector& GetAllSegmentationIDs() const;
+    bool ContainsSegmentation(const SemanticTypes::ID& segmentationID) const;
+    /**
+    * @brief Return the IDs of all segmentations that refer to the given image ID, in storage order.
+    */
+    const SemanticTypes::IDVector& GetAllSegmentationIDsOfImage(const SemanticTypes::ID& imageID) const;
+    /**
+    * @brief Return the IDs of all segmentations that refer to the given lesion UID, in storage order.
+    */
+    const SemanticTypes::IDVector& GetAllSegmentationIDsOfLesion(const SemanticTypes::ID& lesionUID) const;
+    SemanticTypes::ID GetImageIDOfSegmentation(const SemanticTypes::ID& segmentationID) const;
+
+    /**
+    * @brief Return the UIDs of all lesions that are referred to by a segmentation of one of the given images.
+    */
+    std::unordered_set<SemanticTypes::ID> GetAllLesionUIDsOfImages(const SemanticTypes::IDVector& imageIDs) const;
+
+  private:
+
+    struct ImageRow
+    {
+      SemanticTypes::InformationType informationType;
+      SemanticTypes::ID controlPointUID;
+    };
+
+    struct SegmentationRow
+    {
+      SemanticTypes::ID imageID;
+      SemanticTypes::ID lesionUID;
+    };
+
+    using IDIndex = std::unordered_map<SemanticTypes::ID, SemanticTypes::IDVector>;
+
+    static const SemanticTypes::IDVector& Find(const IDIndex& index, const SemanticTypes::ID& key);
+
+    void ReadImages(const PropertyList* propertyList);
+    void ReadSegmentations(const PropertyList* propertyList);
+    void ReadLesions(const PropertyList* propertyList);
+    void ReadControlPoints(const PropertyList* propertyList);
+    void ReadExaminationPeriods(const PropertyList* propertyList);
+    void ReadInformationTypes(const PropertyList* propertyList);
+
+    PropertyList::ConstPointer m_PropertyList;
+    unsigned long m_MTime;
+
+    SemanticTypes::IDVector m_ImageIDs;
+    std::unordered_map<SemanticTypes::ID, ImageRow> m_Images;
+    IDIndex m_ImagesByControlPoint;
+    IDIndex m_ImagesByInformationType;
+
+    SemanticTypes::IDVector m_SegmentationIDs;
+    std::unordered_map<SemanticTypes::ID, SegmentationRow> m_Segmentations;
+    IDIndex m_SegmentationsByImage;
+    IDIndex m_SegmentationsByLesion;
+
+    SemanticTypes::LesionVector m_Lesions;
+    std::unordered_map<SemanticTypes::ID, std::size_t> m_LesionsByUID;
+
+    SemanticTypes::ControlPointVector m_ControlPoints;
+    std::unordered_map<SemanticTypes::ID, std::size_t> m_ControlPointsByUID;
+
+    SemanticTypes::ExaminationPeriodVector m_ExaminationPeriods;
+    std::unordered_set<SemanticTypes::ID> m_ExaminationPeriodUIDs;
+
+    SemanticTypes::InformationTypeVector m_InformationTypes;
+    std::unordered_set<SemanticTypes::InformationType> m_InformationTypeSet;
+  };
+} // namespace mitk
+
+#endif // MITKRELATIONINDEX_H
@@ -16,12 +16,23 @@ found in the LICENSE file.
 #include <MitkSemanticRelationsExports.h>
 
 // semantic relations module
+#include "mitkRelationIndex.h"
 #include "mitkSemanticTypes.h"
 
+// c++
+#include <memory>
+
 namespace mitk
 {
   namespace RelationStorage
   {
+    /**
+    * @brief Return the relation index of the given case or nullptr, if the case does not exist.
+    *        The index is cached and updated by the functions that write the storage data of the case. It is rebuilt if
+    *        the property list of the case was replaced or modified otherwise since the last call.
+    */
+    MITKSEMANTICRELATIONS_EXPORT std::shared_ptr<const RelationIndex> GetRelationIndex(const SemanticTypes::CaseID& caseID);
+
     MITKSEMANTICRELATIONS_EXPORT SemanticTypes::LesionVector GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID);
     SemanticTypes::Lesion GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID);
 
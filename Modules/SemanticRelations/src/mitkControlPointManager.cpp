@@ -38,21 +38,13 @@ mitk::SemanticTypes::ControlPoint mitk::GenerateControlPoint(const DataNode* dat
 
 mitk::SemanticTypes::ControlPoint mitk::GetControlPointByUID(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& controlPointUID)
 {
-  auto lambda = [&controlPointUID](const SemanticTypes::ControlPoint& currentControlPoint)
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
-    return currentControlPoint.UID == controlPointUID;
-  };
-
-  SemanticTypes::ControlPointVector allControlPoints = RelationStorage::GetAllControlPointsOfCase(caseID);
-  const auto existingControlPoint = std::find_if(allControlPoints.begin(), allControlPoints.end(), lambda);
-
-  mitk::SemanticTypes::ControlPoint controlPoint;
-  if (existingControlPoint != allControlPoints.end())
-  {
-    controlPoint = *existingControlPoint;
+    return SemanticTypes::ControlPoint();
   }
 
-  return controlPoint;
+  return relationIndex->GetControlPoint(controlPointUID);
 }
 
 mitk::SemanticTypes::ControlPoint mitk::FindExistingControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
@@ -0,0 +1,431 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRelationIndex.h"
+
+// mitk core
+#include <mitkStringProperty.h>
+#include <mitkVectorProperty.h>
+
+// c++
+#include <algorithm>
+
+namespace
+{
+  const std::vector<std::string>* GetStringVector(const mitk::PropertyList* propertyList, const std::string& key)
+  {
+    auto vectorProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(key));
+    if (nullptr == vectorProperty)
+    {
+      return nullptr;
+    }
+
+    return &vectorProperty->GetValue();
+  }
+}
+
+mitk::RelationIndex::RelationIndex(const PropertyList* propertyList)
+  : m_PropertyList(propertyList)
+  , m_MTime(0)
+{
+  this->Update(propertyList, AllTables);
+}
+
+void mitk::RelationIndex::Update(const PropertyList* propertyList, unsigned int tables)
+{
+  if (propertyList != m_PropertyList.GetPointer())
+  {
+    *this = RelationIndex(propertyList);
+    return;
+  }
+
+  if (nullptr == propertyList)
+  {
+    return;
+  }
+
+  if (0 != (tables & ImageTable))
+  {
+    this->ReadImages(propertyList);
+  }
+  if (0 != (tables & SegmentationTable))
+  {
+    this->ReadSegmentations(propertyList);
+  }
+  if (0 != (tables & LesionTable))
+  {
+    this->ReadLesions(propertyList);
+  }
+  if (0 != (tables & ControlPointTable))
+  {
+    this->ReadControlPoints(propertyList);
+  }
+  if (0 != (tables & ExaminationPeriodTable))
+  {
+    this->ReadExaminationPeriods(propertyList);
+  }
+  if (0 != (tables & InformationTypeTable))
+  {
+    this->ReadInformationTypes(propertyList);
+  }
+
+  // the modified time of the list itself; 'PropertyList::GetMTime' would visit all properties
+  m_MTime = propertyList->itk::Object::GetMTime();
+}
+
+bool mitk::RelationIndex::IsUpToDate(const PropertyList* propertyList) const
+{
+  return propertyList == m_PropertyList.GetPointer()
+    && (nullptr == propertyList || propertyList->itk::Object::GetMTime() == m_MTime);
+}
+
+const mitk::SemanticTypes::LesionVector& mitk::RelationIndex::GetAllLesions() const
+{
+  return m_Lesions;
+}
+
+bool mitk::RelationIndex::ContainsLesion(const SemanticTypes::ID& lesionUID) const
+{
+  return m_LesionsByUID.find(lesionUID) != m_LesionsByUID.end();
+}
+
+mitk::SemanticTypes::Lesion mitk::RelationIndex::GetLesion(const SemanticTypes::ID& lesionUID) const
+{
+  const auto lesion = m_LesionsByUID.find(lesionUID);
+  if (lesion == m_LesionsByUID.end())
+  {
+    return SemanticTypes::Lesion();
+  }
+
+  return m_Lesions[lesion->second];
+}
+
+mitk::SemanticTypes::Lesion mitk::RelationIndex::GetLesionOfSegmentation(const SemanticTypes::ID& segmentationID) const
+{
+  const auto segmentation = m_Segmentations.find(segmentationID);
+  if (segmentation == m_Segmentations.end() || segmentation->second.lesionUID.empty())
+  {
+    return SemanticTypes::Lesion();
+  }
+
+  return this->GetLesion(segmentation->second.lesionUID);
+}
+
+const mitk::SemanticTypes::ControlPointVector& mitk::RelationIndex::GetAllControlPoints() const
+{
+  return m_ControlPoints;
+}
+
+bool mitk::RelationIndex::ContainsControlPoint(const SemanticTypes::ID& controlPointUID) const
+{
+  return m_ControlPointsByUID.find(controlPointUID) != m_ControlPointsByUID.end();
+}
+
+mitk::SemanticTypes::ControlPoint mitk::RelationIndex::GetControlPoint(const SemanticTypes::ID& controlPointUID) const
+{
+  const auto controlPoint = m_ControlPointsByUID.find(controlPointUID);
+  if (controlPoint == m_ControlPointsByUID.end())
+  {
+    return SemanticTypes::ControlPoint();
+  }
+
+  return m_ControlPoints[controlPoint->second];
+}
+
+mitk::SemanticTypes::ControlPoint mitk::RelationIndex::GetControlPointOfImage(const SemanticTypes::ID& imageID) const
+{
+  return this->GetControlPoint(this->GetControlPointUIDOfImage(imageID));
+}
+
+mitk::SemanticTypes::ID mitk::RelationIndex::GetControlPointUIDOfImage(const SemanticTypes::ID& imageID) const
+{
+  const auto image = m_Images.find(imageID);
+  return image == m_Images.end() ? SemanticTypes::ID() : image->second.controlPointUID;
+}
+
+const mitk::SemanticTypes::ExaminationPeriodVector& mitk::RelationIndex::GetAllExaminationPeriods() const
+{
+  return m_ExaminationPeriods;
+}
+
+bool mitk::RelationIndex::ContainsExaminationPeriod(const SemanticTypes::ID& examinationPeriodUID) const
+{
+  return m_ExaminationPeriodUIDs.find(examinationPeriodUID) != m_ExaminationPeriodUIDs.end();
+}
+
+const mitk::SemanticTypes::InformationTypeVector& mitk::RelationIndex::GetAllInformationTypes() const
+{
+  return m_InformationTypes;
+}
+
+bool mitk::RelationIndex::ContainsInformationType(const SemanticTypes::InformationType& informationType) const
+{
+  return m_InformationTypeSet.find(informationType) != m_InformationTypeSet.end();
+}
+
+mitk::SemanticTypes::InformationType mitk::RelationIndex::GetInformationTypeOfImage(const SemanticTypes::ID& imageID) const
+{
+  const auto image = m_Images.find(imageID);
+  return image == m_Images.end() ? SemanticTypes::InformationType() : image->second.informationType;
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllImageIDs() const
+{
+  return m_ImageIDs;
+}
+
+bool mitk::RelationIndex::ContainsImage(const SemanticTypes::ID& imageID) const
+{
+  return m_Images.find(imageID) != m_Images.end();
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllImageIDsOfControlPoint(const SemanticTypes::ID& controlPointUID) const
+{
+  return Find(m_ImagesByControlPoint, controlPointUID);
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllImageIDsOfInformationType(const SemanticTypes::InformationType& informationType) const
+{
+  return Find(m_ImagesByInformationType, informationType);
+}
+
+mitk::SemanticTypes::IDVector mitk::RelationIndex::GetAllImageIDsOfLesion(const SemanticTypes::ID& lesionUID) const
+{
+  SemanticTypes::IDVector allImageIDsOfLesion;
+  for (const auto& segmentationID : this->GetAllSegmentationIDsOfLesion(lesionUID))
+  {
+    const auto& imageID = m_Segmentations.at(segmentationID).imageID;
+    if (!imageID.empty())
+    {
+      allImageIDsOfLesion.push_back(imageID);
+    }
+  }
+
+  std::sort(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end());
+  allImageIDsOfLesion.erase(std::unique(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end()), allImageIDsOfLesion.end());
+
+  return allImageIDsOfLesion;
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllSegmentationIDs() const
+{
+  return m_SegmentationIDs;
+}
+
+bool mitk::RelationIndex::ContainsSegmentation(const SemanticTypes::ID& segmentationID) const
+{
+  return m_Segmentations.find(segmentationID) != m_Segmentations.end();
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllSegmentationIDsOfImage(const SemanticTypes::ID& imageID) const
+{
+  return Find(m_SegmentationsByImage, imageID);
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::GetAllSegmentationIDsOfLesion(const SemanticTypes::ID& lesionUID) const
+{
+  return Find(m_SegmentationsByLesion, lesionUID);
+}
+
+mitk::SemanticTypes::ID mitk::RelationIndex::GetImageIDOfSegmentation(const SemanticTypes::ID& segmentationID) const
+{
+  const auto segmentation = m_Segmentations.find(segmentationID);
+  return segmentation == m_Segmentations.end() ? SemanticTypes::ID() : segmentation->second.imageID;
+}
+
+std::unordered_set<mitk::SemanticTypes::ID> mitk::RelationIndex::GetAllLesionUIDsOfImages(const SemanticTypes::IDVector& imageIDs) const
+{
+  std::unordered_set<SemanticTypes::ID> allLesionUIDs;
+  for (const auto& imageID : imageIDs)
+  {
+    for (const auto& segmentationID : this->GetAllSegmentationIDsOfImage(imageID))
+    {
+      const auto& lesionUID = m_Segmentations.at(segmentationID).lesionUID;
+      if (!lesionUID.empty())
+      {
+        allLesionUIDs.insert(lesionUID);
+      }
+    }
+  }
+
+  return allLesionUIDs;
+}
+
+const mitk::SemanticTypes::IDVector& mitk::RelationIndex::Find(const IDIndex& index, const SemanticTypes::ID& key)
+{
+  static const SemanticTypes::IDVector empty;
+
+  const auto ids = index.find(key);
+  return ids == index.end() ? empty : ids->second;
+}
+
+void mitk::RelationIndex::ReadImages(const PropertyList* propertyList)
+{
+  m_ImageIDs.clear();
+  m_Images.clear();
+  m_ImagesByControlPoint.clear();
+  m_ImagesByInformationType.clear();
+
+  // images (0. information type 1. control point ID)
+  auto imageIDs = GetStringVector(propertyList, "images");
+  if (nullptr != imageIDs)
+  {
+    m_ImageIDs = *imageIDs;
+    for (const auto& imageID : m_ImageIDs)
+    {
+      auto imageData = GetStringVector(propertyList, imageID);
+      if (nullptr == imageData || imageData->size() != 2)
+      {
+        continue;
+      }
+
+      ImageRow& image = m_Images[imageID];
+      image.informationType = (*imageData)[0];
+      image.controlPointUID = (*imageData)[1];
+      m_ImagesByInformationType[image.informationType].push_back(imageID);
+      m_ImagesByControlPoint[image.controlPointUID].push_back(imageID);
+    }
+  }
+}
+
+void mitk::RelationIndex::ReadSegmentations(const PropertyList* propertyList)
+{
+  m_SegmentationIDs.clear();
+  m_Segmentations.clear();
+  m_SegmentationsByImage.clear();
+  m_SegmentationsByLesion.clear();
+
+  // segmentations (0. image ID 1. lesion ID)
+  auto segmentationIDs = GetStringVector(propertyList, "segmentations");
+  if (nullptr != segmentationIDs)
+  {
+    m_SegmentationIDs = *segmentationIDs;
+    for (const auto& segmentationID : m_SegmentationIDs)
+    {
+      auto segmentationData = GetStringVector(propertyList, segmentationID);
+      if (nullptr == segmentationData || segmentationData->size() != 2)
+      {
+        continue;
+      }
+
+      SegmentationRow& segmentation = m_Segmentations[segmentationID];
+      segmentation.imageID = (*segmentationData)[0];
+      segmentation.lesionUID = (*segmentationData)[1];
+      m_SegmentationsByImage[segmentation.imageID].push_back(segmentationID);
+      m_SegmentationsByLesion[segmentation.lesionUID].push_back(segmentationID);
+    }
+  }
+}
+
+void mitk::RelationIndex::ReadLesions(const PropertyList* propertyList)
+{
+  m_Lesions.clear();
+  m_LesionsByUID.clear();
+
+  // lesions (0. name 1. lesion class UID), the lesion class type is stored with the lesion class UID as key
+  auto lesionUIDs = GetStringVector(propertyList, "lesions");
+  if (nullptr != lesionUIDs)
+  {
+    for (const auto& lesionUID : *lesionUIDs)
+    {
+      auto lesionData = GetStringVector(propertyList, lesionUID);
+      if (nullptr == lesionData || lesionData->size() != 2)
+      {
+        continue;
+      }
+
+      auto lesionClassProperty = dynamic_cast<StringProperty*>(propertyList->GetProperty((*lesionData)[1]));
+      if (nullptr == lesionClassProperty)
+      {
+        continue;
+      }
+
+      SemanticTypes::Lesion lesion;
+      lesion.UID = lesionUID;
+      lesion.name = (*lesionData)[0];
+      lesion.lesionClass.UID = (*lesionData)[1];
+      lesion.lesionClass.classType = lesionClassProperty->GetValue();
+
+      m_LesionsByUID.emplace(lesionUID, m_Lesions.size());
+      m_Lesions.push_back(lesion);
+    }
+  }
+}
+
+void mitk::RelationIndex::ReadControlPoints(const PropertyList* propertyList)
+{
+  m_ControlPoints.clear();
+  m_ControlPointsByUID.clear();
+
+  // control points (0. year 1. month 2. day)
+  auto controlPointUIDs = GetStringVector(propertyList, "controlpoints");
+  if (nullptr != controlPointUIDs)
+  {
+    for (const auto& controlPointUID : *controlPointUIDs)
+    {
+      auto controlPointProperty = dynamic_cast<VectorProperty<int>*>(propertyList->GetProperty(controlPointUID));
+      if (nullptr == controlPointProperty || controlPointProperty->GetValue().size() != 3)
+      {
+        continue;
+      }
+
+      const auto& date = controlPointProperty->GetValue();
+      SemanticTypes::ControlPoint controlPoint;
+      controlPoint.UID = controlPointUID;
+      controlPoint.date = boost::gregorian::date(date[0], date[1], date[2]);
+
+      m_ControlPointsByUID.emplace(controlPointUID, m_ControlPoints.size());
+      m_ControlPoints.push_back(controlPoint);
+    }
+  }
+}
+
+void mitk::RelationIndex::ReadExaminationPeriods(const PropertyList* propertyList)
+{
+  m_ExaminationPeriods.clear();
+  m_ExaminationPeriodUIDs.clear();
+
+  // examination periods (0. name 1. - n. control point UIDs)
+  auto examinationPeriodUIDs = GetStringVector(propertyList, "examinationperiods");
+  if (nullptr != examinationPeriodUIDs)
+  {
+    for (const auto& examinationPeriodUID : *examinationPeriodUIDs)
+    {
+      auto examinationPeriodData = GetStringVector(propertyList, examinationPeriodUID);
+      if (nullptr == examinationPeriodData || examinationPeriodData->empty())
+      {
+        continue;
+      }
+
+      SemanticTypes::ExaminationPeriod examinationPeriod;
+      examinationPeriod.UID = examinationPeriodUID;
+      examinationPeriod.name = examinationPeriodData->front();
+      examinationPeriod.controlPointUIDs.assign(examinationPeriodData->begin() + 1, examinationPeriodData->end());
+
+      m_ExaminationPeriodUIDs.insert(examinationPeriodUID);
+      m_ExaminationPeriods.push_back(examinationPeriod);
+    }
+  }
+}
+
+void mitk::RelationIndex::ReadInformationTypes(const PropertyList* propertyList)
+{
+  m_InformationTypes.clear();
+  m_InformationTypeSet.clear();
+
+  auto informationTypes = GetStringVector(propertyList, "informationtypes");
+  if (nullptr != informationTypes)
+  {
+    m_InformationTypes = *informationTypes;
+    m_InformationTypeSet.insert(m_InformationTypes.begin(), m_InformationTypes.end());
+  }
+}
@@ -25,16 +25,39 @@ found in the LICENSE file.
 // c++
 #include <algorithm>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace
 {
-  std::vector<mitk::SemanticTypes::CaseID> GetCaseIDs()
+  // The case IDs and the relation indices of the cases are cached. The case IDs are valid as long as the property list
+  // of the case IDs is not replaced or modified. The relation index of a case is updated by the writing functions below
+  // and validated by the modified time of the property list of the case (see 'RelationIndex::IsUpToDate').
+  struct StorageCache
+  {
+    mitk::PropertyList::ConstPointer caseIDsPropertyList;
+    unsigned long caseIDsModifiedTime = 0;
+    std::vector<mitk::SemanticTypes::CaseID> caseIDs;
+    std::unordered_set<mitk::SemanticTypes::CaseID> caseIDSet;
+    std::unordered_map<mitk::SemanticTypes::CaseID, std::shared_ptr<mitk::RelationIndex>> relationIndices;
+  };
+
+  StorageCache& GetCache()
+  {
+    static StorageCache storageCache;
+    return storageCache;
+  }
+
+  StorageCache& GetStorageCache()
   {
+    StorageCache& storageCache = GetCache();
+
     PERSISTENCE_GET_SERVICE_MACRO
     if (nullptr == persistenceService)
     {
       MITK_DEBUG << "Persistence service could not be loaded";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+      storageCache = StorageCache();
+      return storageCache;
     }
     // the property list is valid for a certain scenario and contains all the case IDs of the radiological user's MITK session
     std::string listIdentifier = "caseIDs";
@@ -42,33 +65,61 @@ namespace
     if (nullptr == propertyList)
     {
       MITK_DEBUG << "Could not find the property list " << listIdentifier << " for the current MITK workbench / session.";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+      storageCache = StorageCache();
+      return storageCache;
     }
+
+    // the list contains a single property, which is changed in place by 'AddCase'
+    if (propertyList.GetPointer() == storageCache.caseIDsPropertyList.GetPointer()
+      && propertyList->GetMTime() == storageCache.caseIDsModifiedTime)
+    {
+      return storageCache;
+    }
+
+    storageCache.caseIDsPropertyList = propertyList.GetPointer();
+    storageCache.caseIDsModifiedTime = propertyList->GetMTime();
+    storageCache.caseIDs.clear();
     // retrieve a vector property that contains all case IDs
     mitk::VectorProperty<std::string>* caseIDsVectorProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(listIdentifier));
     if (nullptr == caseIDsVectorProperty)
     {
       MITK_DEBUG << "Could not find the property " << listIdentifier << " for the " << listIdentifier << " property list.";
-      return std::vector<mitk::SemanticTypes::CaseID>();
+    }
+    else
+    {
+      storageCache.caseIDs = caseIDsVectorProperty->GetValue();
+    }
+
+    storageCache.caseIDSet = std::unordered_set<mitk::SemanticTypes::CaseID>(storageCache.caseIDs.begin(), storageCache.caseIDs.end());
+    // drop the relation indices of removed cases
+    for (auto it = storageCache.relationIndices.begin(); it != storageCache.relationIndices.end();)
+    {
+      it = storageCache.caseIDSet.count(it->first) > 0 ? std::next(it) : storageCache.relationIndices.erase(it);
     }
 
-    return caseIDsVectorProperty->GetValue();
+    return storageCache;
   }
 
-  bool CaseIDExists(const mitk::SemanticTypes::CaseID& caseID)
+  std::vector<mitk::SemanticTypes::CaseID> GetCaseIDs()
   {
-    auto allCaseIDs = GetCaseIDs();
-    auto existingCase = std::find(allCaseIDs.begin(), allCaseIDs.end(), caseID);
-    if (existingCase == allCaseIDs.end())
-    {
-      return false;
-    }
+    return GetStorageCache().caseIDs;
+  }
 
-    return true;
+  bool CaseIDExists(const mitk::SemanticTypes::CaseID& caseID)
+  {
+    return GetStorageCache().caseIDSet.count(caseID) > 0;
   }
 
-  mitk::PropertyList::Pointer GetStorageData(const mitk::SemanticTypes::CaseID& caseID)
+  mitk::PropertyList::Pointer GetStorageData(const StorageCache& storageCache, const mitk::SemanticTypes::CaseID& caseID)
   {
+    // The persistence service may create a new property list with the given ID, if no property list is found.
+    // Since we don't want to return a new property list but rather inform the user that the given case
+    // is not a valid, stored case, we will return nullptr in that case.
+    if (0 == storageCache.caseIDSet.count(caseID))
+    {
+      return nullptr;
+    }
+
     // access the storage
     PERSISTENCE_GET_SERVICE_MACRO
     if (nullptr == persistenceService)
@@ -77,587 +128,251 @@ namespace
       return nullptr;
     }
 
-    // The persistence service may create a new property list with the given ID, if no property list is found.
-    // Since we don't want to return a new property list but rather inform the user that the given case
-    // is not a valid, stored case, we will return nullptr in that case.
-    if (CaseIDExists(caseID))
-    {
-      // the property list is valid for a whole case and contains all the properties for the current case
-      return persistenceService->GetPropertyList(const_cast<mitk::SemanticTypes::CaseID&>(caseID));
-    }
-
-    return nullptr;
+    // the property list is valid for a whole case and contains all the properties for the current case
+    return persistenceService->GetPropertyList(const_cast<mitk::SemanticTypes::CaseID&>(caseID));
   }
 
-  mitk::SemanticTypes::Lesion GenerateLesion(const mitk::SemanticTypes::CaseID& caseID, const mitk::SemanticTypes::ID& lesionID)
+  mitk::PropertyList::Pointer GetStorageData(const mitk::SemanticTypes::CaseID& caseID)
   {
-    mitk::PropertyList::Pointer propertyList = GetStorageData(caseID);
-    if (nullptr == propertyList)
-    {
-      MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-      return mitk::SemanticTypes::Lesion();
-    }
-
-    mitk::VectorProperty<std::string>* lesionDataProperty = dynamic_cast<mitk::VectorProperty<std::string>*>(propertyList->GetProperty(lesionID));
-    if (nullptr == lesionDataProperty)
-    {
-      MITK_DEBUG << "Lesion " << lesionID << " not found. Lesion can not be retrieved.";
-      return mitk::SemanticTypes::Lesion();
-    }
-
-    std::vector<std::string> lesionData = lesionDataProperty->GetValue();
-    // a lesion date has to have exactly two values (the name of the lesion and the UID of the lesion class)
-    if (lesionData.size() != 2)
-    {
-      MITK_DEBUG << "Incorrect lesion data storage. Not two (2) strings of the lesion name and the lesion UID are stored.";
-      return mitk::SemanticTypes::Lesion();
-    }
-
-    // the lesion class ID is stored as the second property
-    std::string lesionClassID = lesionData[1];
-    mitk::StringProperty* lesionClassProperty = dynamic_cast<mitk::StringProperty*>(propertyList->GetProperty(lesionClassID));
-    if (nullptr != lesionClassProperty)
-    {
-      mitk::SemanticTypes::LesionClass generatedLesionClass;
-      generatedLesionClass.UID = lesionClassID;
-      generatedLesionClass.classType = lesionClassProperty->GetValue();
-
-      mitk::SemanticTypes::Lesion generatedLesion;
-      generatedLesion.UID = lesionID;
-      generatedLesion.name = lesionData[0];
-      generatedLesion.lesionClass = generatedLesionClass;
-
-      return generatedLesion;
-    }
-
-    MITK_DEBUG << "Incorrect lesion class storage. Lesion " << lesionID << " can not be retrieved.";
-    return mitk::SemanticTypes::Lesion();
+    return GetStorageData(GetStorageCache(), caseID);
   }
 
-  mitk::SemanticTypes::ControlPoint GenerateControlpoint(const mitk::SemanticTypes::CaseID& caseID, const mitk::SemanticTypes::ID& controlPointUID)
+  // Writing functions change the properties of a case in place, which does not modify the property list of the case.
+  // When a writing function returns, the tables of the relation index that it may have changed are read again.
+  // An index that is still used by a caller is copied before, so the caller keeps an unchanged index. An index that
+  // was outdated before the writing function started is removed and rebuilt by the next query.
+  class RelationIndexUpdate
   {
-    mitk::PropertyList::Pointer propertyList = GetStorageData(caseID);
-    if (nullptr == propertyList)
+  public:
+    RelationIndexUpdate(const mitk::SemanticTypes::CaseID& caseID, const mitk::PropertyList* propertyList, unsigned int tables)
+      : m_CaseID(caseID)
+      , m_PropertyList(propertyList)
+      , m_Tables(tables)
+      , m_WasUpToDate(false)
     {
-      MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-      return mitk::SemanticTypes::ControlPoint();
+      // the case ID was validated by the writing function already
+      const auto& relationIndices = GetCache().relationIndices;
+      auto relationIndex = relationIndices.find(m_CaseID);
+      m_WasUpToDate = relationIndex != relationIndices.end() && relationIndex->second->IsUpToDate(m_PropertyList);
     }
 
-    // retrieve a vector property that contains the integer values of the date of a control point (0. year 1. month 2. day)
-    mitk::VectorProperty<int>* controlPointVectorProperty = dynamic_cast<mitk::VectorProperty<int>*>(propertyList->GetProperty(controlPointUID));
-    if (nullptr == controlPointVectorProperty)
+    ~RelationIndexUpdate()
     {
-      MITK_DEBUG << "Could not find the control point " << controlPointUID << " in the storage.";
-      return mitk::SemanticTypes::ControlPoint();
-    }
+      auto& relationIndices = GetCache().relationIndices;
+      auto relationIndex = relationIndices.find(m_CaseID);
+      if (relationIndex == relationIndices.end())
+      {
+        return;
+      }
 
-    std::vector<int> controlPointVectorPropertyValue = controlPointVectorProperty->GetValue();
-    // a control point has to have exactly three integer values (year, month and day)
-    if (controlPointVectorPropertyValue.size() != 3)
-    {
-      MITK_DEBUG << "Incorrect control point storage. Not three (3) values of the date are stored.";
-      return mitk::SemanticTypes::ControlPoint();
-    }
+      if (!m_WasUpToDate)
+      {
+        relationIndices.erase(relationIndex);
+        return;
+      }
+
+      if (relationIndex->second.use_count() > 1)
+      {
+        relationIndex->second = std::make_shared<mitk::RelationIndex>(*relationIndex->second);
+      }
 
-    // set the values of the control point
-    mitk::SemanticTypes::ControlPoint generatedControlPoint;
-    generatedControlPoint.UID = controlPointUID;
-    generatedControlPoint.date = boost::gregorian::date(controlPointVectorPropertyValue[0],
-      controlPointVectorPropertyValue[1],
-      controlPointVectorPropertyValue[2]);
+      relationIndex->second->Update(m_PropertyList, m_Tables);
+    }
 
-    return generatedControlPoint;
-  }
+  private:
+    const mitk::SemanticTypes::CaseID m_CaseID;
+    const mitk::PropertyList* m_PropertyList;
+    const unsigned int m_Tables;
+    bool m_WasUpToDate;
+  };
 }
 
-mitk::SemanticTypes::LesionVector mitk::RelationStorage::GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID)
+std::shared_ptr<const mitk::RelationIndex> mitk::RelationStorage::GetRelationIndex(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
+  StorageCache& storageCache = GetStorageCache();
+  PropertyList::Pointer propertyList = GetStorageData(storageCache, caseID);
   if (nullptr == propertyList)
   {
-    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::LesionVector();
-  }
-  // retrieve a vector property that contains the valid lesion-IDs for the current case
-  VectorProperty<std::string>* lesionsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
-  if (nullptr == lesionsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any lesion in the storage.";
-    return SemanticTypes::LesionVector();
+    storageCache.relationIndices.erase(caseID);
+    return nullptr;
   }
 
-  std::vector<std::string> lesionsVectorPropertyValue = lesionsVectorProperty->GetValue();
-  SemanticTypes::LesionVector allLesionsOfCase;
-  for (const auto& lesionID : lesionsVectorPropertyValue)
+  // writing functions update the index themselves, other changes of the property list rebuild it
+  auto& relationIndex = storageCache.relationIndices[caseID];
+  if (nullptr == relationIndex || !relationIndex->IsUpToDate(propertyList))
   {
-    SemanticTypes::Lesion generatedLesion = GenerateLesion(caseID, lesionID);
-    if (!generatedLesion.UID.empty())
-    {
-      allLesionsOfCase.push_back(generatedLesion);
-    }
+    relationIndex = std::make_shared<RelationIndex>(propertyList);
   }
 
-  return allLesionsOfCase;
+  return relationIndex;
 }
 
-mitk::SemanticTypes::Lesion mitk::RelationStorage::GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
+mitk::SemanticTypes::LesionVector mitk::RelationStorage::GetAllLesionsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
-    return SemanticTypes::Lesion();
-  }
-
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
-    return SemanticTypes::Lesion();
+    return SemanticTypes::LesionVector();
   }
 
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
-    return SemanticTypes::Lesion();
-  }
+  return relationIndex->GetAllLesions();
+}
 
-  std::string lesionID = segmentationVectorPropertyValue[1];
-  if (lesionID.empty())
+mitk::SemanticTypes::Lesion mitk::RelationStorage::GetLesionOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
+{
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
-    // segmentation does not refer to any lesion; return empty lesion
+    MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::Lesion();
   }
 
-  return GenerateLesion(caseID, lesionID);
+  return relationIndex->GetLesionOfSegmentation(segmentationID);
 }
 
 mitk::SemanticTypes::ControlPointVector mitk::RelationStorage::GetAllControlPointsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ControlPointVector();
   }
 
-  // retrieve a vector property that contains the valid control point-IDs for the current case
-  VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
-  if (nullptr == controlPointsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any control points in the storage.";
-    return SemanticTypes::ControlPointVector();
-  }
-
-  std::vector<std::string> controlPointsVectorPropertyValue = controlPointsVectorProperty->GetValue();
-  SemanticTypes::ControlPointVector allControlPointsOfCase;
-  for (const auto& controlPointUID : controlPointsVectorPropertyValue)
-  {
-    SemanticTypes::ControlPoint generatedControlPoint = GenerateControlpoint(caseID, controlPointUID);
-    if (!generatedControlPoint.UID.empty())
-    {
-      allControlPointsOfCase.push_back(generatedControlPoint);
-    }
-  }
-
-  return allControlPointsOfCase;
+  return relationIndex->GetAllControlPoints();
 }
 
 mitk::SemanticTypes::ControlPoint mitk::RelationStorage::GetControlPointOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ControlPoint();
   }
-  // retrieve a vector property that contains the information type and the referenced ID of a control point (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  SemanticTypes::ControlPoint controlPoint;
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  // the second value of the image vector is the ID of the referenced control point
-  std::string controlPointID = imageVectorPropertyValue[1];
-  // retrieve a vector property that contains the integer values of the date of a control point (0. year 1. month 2. day)
-  VectorProperty<int>* controlPointVectorProperty = dynamic_cast<VectorProperty<int>*>(propertyList->GetProperty(controlPointID));
-  if (nullptr == controlPointVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the control point " << controlPointID << " in the storage.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  std::vector<int> controlPointVectorPropertyValue = controlPointVectorProperty->GetValue();
-  // a control point has to have exactly three integer values (year, month and day)
-  if (controlPointVectorPropertyValue.size() != 3)
-  {
-    MITK_DEBUG << "Incorrect control point storage. Not three (3) values of the date are stored.";
-    return SemanticTypes::ControlPoint();
-  }
-
-  // set the values of the control point
-  controlPoint.UID = controlPointID;
-  controlPoint.date = boost::gregorian::date(controlPointVectorPropertyValue[0],
-                                             controlPointVectorPropertyValue[1],
-                                             controlPointVectorPropertyValue[2]);
 
-  return controlPoint;
+  return relationIndex->GetControlPointOfImage(imageID);
 }
 
 mitk::SemanticTypes::ExaminationPeriodVector mitk::RelationStorage::GetAllExaminationPeriodsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ExaminationPeriodVector();
   }
 
-  // retrieve a vector property that contains the valid examination period UIDs for the current case
-  VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
-  if (nullptr == examinationPeriodsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any examination periods in the storage.";
-    return SemanticTypes::ExaminationPeriodVector();
-  }
-
-  std::vector<std::string> examinationPeriodsVectorPropertyValue = examinationPeriodsVectorProperty->GetValue();
-  SemanticTypes::ExaminationPeriodVector allExaminationPeriods;
-  for (const auto& examinationPeriodID : examinationPeriodsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the represented control point-IDs
-    VectorProperty<std::string>::Pointer examinationPeriodVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriodID));
-    if (nullptr == examinationPeriodVectorProperty)
-    {
-      MITK_DEBUG << "Could not find the examination period " << examinationPeriodID << " in the storage.";
-      continue;
-    }
-
-    std::vector<std::string> examinationPeriodVectorPropertyValue = examinationPeriodVectorProperty->GetValue();
-    // an examination period has an arbitrary number of vector values (name and control point UIDs) (at least one for the name)
-    if (examinationPeriodVectorPropertyValue.empty())
-    {
-      MITK_DEBUG << "Incorrect examination period storage. At least one (1) value for the examination period name has to be stored.";
-      continue;
-    }
-    else
-    {
-      // set the values of the name and the control points
-      SemanticTypes::ExaminationPeriod generatedExaminationPeriod;
-      generatedExaminationPeriod.UID = examinationPeriodID;
-      generatedExaminationPeriod.name = examinationPeriodVectorPropertyValue[0];
-      for (size_t i = 1; i < examinationPeriodVectorPropertyValue.size(); ++i)
-      {
-        generatedExaminationPeriod.controlPointUIDs.push_back(examinationPeriodVectorPropertyValue[i]);
-      }
-
-      allExaminationPeriods.push_back(generatedExaminationPeriod);
-    }
-  }
-  return allExaminationPeriods;
+  return relationIndex->GetAllExaminationPeriods();
 }
 
 mitk::SemanticTypes::InformationTypeVector mitk::RelationStorage::GetAllInformationTypesOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::InformationTypeVector();
   }
-  // retrieve a vector property that contains the valid information types of the current case
-  VectorProperty<std::string>* informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
-  if (nullptr == informationTypesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any information types in the storage.";
-    return SemanticTypes::InformationTypeVector();
-  }
 
-  return informationTypesVectorProperty->GetValue();
+  return relationIndex->GetAllInformationTypes();
 }
 
 mitk::SemanticTypes::InformationType mitk::RelationStorage::GetInformationTypeOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::InformationType();
   }
-  // retrieve a vector property that contains the information type and the referenced ID of an image (0. information type 1. control point ID)
-  VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-  if (nullptr == imageVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the image " << imageID << " in the storage.";
-    return SemanticTypes::InformationType();
-  }
-
-  std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-  // an image has to have exactly two values (the information type and the ID of the control point)
-  if (imageVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect data storage. Not two (2) values stored.";
-    return SemanticTypes::InformationType();
-  }
 
-  // the first value of the image vector is the information type
-  return imageVectorPropertyValue[0];
+  return relationIndex->GetInformationTypeOfImage(imageID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
 
-  return imagesVectorProperty->GetValue();
+  return relationIndex->GetAllImageIDs();
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allImageIDsOfControlPoint;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the image vector is the ID of the referenced control point
-    if (imageVectorPropertyValue[1] == controlPoint.UID)
-    {
-      allImageIDsOfControlPoint.push_back(imageID);
-    }
-  }
 
-  return allImageIDsOfControlPoint;
+  return relationIndex->GetAllImageIDsOfControlPoint(controlPoint.UID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllImageIDsOfInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid image-IDs of the current case
-  VectorProperty<std::string>* imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
-  if (nullptr == imagesVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any image in the storage.";
-    return SemanticTypes::IDVector();
-  }
 
-  mitk::SemanticTypes::IDVector allImageIDsOfInformationType;
-  std::vector<std::string> imagesVectorPropertyValue = imagesVectorProperty->GetValue();
-  for (const auto& imageID : imagesVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
-    VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
-    if (nullptr == imageVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> imageVectorPropertyValue = imageVectorProperty->GetValue();
-    // an image has to have exactly two values (the information type and the ID of the control point)
-    if (imageVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the image vector is the ID of the referenced information type
-    if (imageVectorPropertyValue[0] == informationType)
-    {
-      allImageIDsOfInformationType.push_back(imageID);
-    }
-  }
-
-  return allImageIDsOfInformationType;
+  return relationIndex->GetAllImageIDsOfInformationType(informationType);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfCase(const SemanticTypes::CaseID& caseID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
 
-  return segmentationsVectorProperty->GetValue();
+  return relationIndex->GetAllSegmentationIDs();
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfImage(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& imageID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfImage;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the first value of the segmentation vector is the ID of the referenced image
-    if (segmentationVectorPropertyValue[0] == imageID)
-    {
-      allSegmentationIDsOfImage.push_back(segmentationID);
-    }
-  }
 
-  return allSegmentationIDsOfImage;
+  return relationIndex->GetAllSegmentationIDsOfImage(imageID);
 }
 
 mitk::SemanticTypes::IDVector mitk::RelationStorage::GetAllSegmentationIDsOfLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::IDVector();
   }
-  // retrieve a vector property that contains the valid segmentation-IDs for the current case
-  VectorProperty<std::string>* segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
-  if (nullptr == segmentationsVectorProperty)
-  {
-    MITK_DEBUG << "Could not find any segmentation in the storage.";
-    return SemanticTypes::IDVector();
-  }
-
-  mitk::SemanticTypes::IDVector allSegmentationIDsOfLesion;
-  std::vector<std::string> segmentationsVectorPropertyValue = segmentationsVectorProperty->GetValue();
-  for (const auto& segmentationID : segmentationsVectorPropertyValue)
-  {
-    // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-    VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-    if (nullptr == segmentationVectorProperty)
-    {
-      continue;
-    }
-
-    std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-    // a segmentation has to have exactly two values (the ID of the referenced image and the ID of the referenced lesion)
-    if (segmentationVectorPropertyValue.size() != 2)
-    {
-      continue;
-    }
-
-    // the second value of the segmentation vector is the ID of the referenced lesion
-    if (segmentationVectorPropertyValue[1] == lesion.UID)
-    {
-      allSegmentationIDsOfLesion.push_back(segmentationID);
-    }
-  }
 
-  return allSegmentationIDsOfLesion;
+  return relationIndex->GetAllSegmentationIDsOfLesion(lesion.UID);
 }
 
 mitk::SemanticTypes::ID mitk::RelationStorage::GetImageIDOfSegmentation(const SemanticTypes::CaseID& caseID, const SemanticTypes::ID& segmentationID)
 {
-  PropertyList::Pointer propertyList = GetStorageData(caseID);
-  if (nullptr == propertyList)
+  auto relationIndex = GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
   {
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return SemanticTypes::ID();
   }
 
-  // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
-  VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
-  if (nullptr == segmentationVectorProperty)
-  {
-    MITK_DEBUG << "Could not find the segmentation " << segmentationID << " in the storage.";
-    return SemanticTypes::ID();
-  }
-
-  std::vector<std::string> segmentationVectorPropertyValue = segmentationVectorProperty->GetValue();
-  // the lesion ID of a segmentation is the second value in the vector
-  if (segmentationVectorPropertyValue.size() != 2)
-  {
-    MITK_DEBUG << "Incorrect segmentation storage. Not two (2) IDs stored.";
-    return SemanticTypes::ID();
-  }
-
-  return segmentationVectorPropertyValue[0];
+  return relationIndex->GetImageIDOfSegmentation(segmentationID);
 }
 
 std::vector<mitk::SemanticTypes::CaseID> mitk::RelationStorage::GetAllCaseIDs()
@@ -718,6 +433,7 @@ void mitk::RelationStorage::AddImage(const SemanticTypes::CaseID& caseID, const
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable);
 
   // retrieve a vector property that contains the valid image-IDs for the current case
   VectorProperty<std::string>::Pointer imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
@@ -758,6 +474,7 @@ void mitk::RelationStorage::RemoveImage(const SemanticTypes::CaseID& caseID, con
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable);
 
   // retrieve a vector property that contains the valid image-IDs for the current case
   VectorProperty<std::string>::Pointer imagesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("images"));
@@ -793,6 +510,7 @@ void mitk::RelationStorage::AddSegmentation(const SemanticTypes::CaseID& caseID,
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::SegmentationTable);
 
   // retrieve a vector property that contains the valid segmentation-IDs for the current case
   VectorProperty<std::string>::Pointer segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
@@ -834,6 +552,7 @@ void mitk::RelationStorage::RemoveSegmentation(const SemanticTypes::CaseID& case
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::SegmentationTable);
 
   // retrieve a vector property that contains the valid segmentation-IDs for the current case
   VectorProperty<std::string>::Pointer segmentationsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("segmentations"));
@@ -869,6 +588,7 @@ void mitk::RelationStorage::AddLesion(const SemanticTypes::CaseID& caseID, const
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::LesionTable);
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>::Pointer lesionsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   std::vector<std::string> lesionsVectorPropertyValue;
@@ -914,6 +634,7 @@ void mitk::RelationStorage::OverwriteLesion(const SemanticTypes::CaseID& caseID,
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::LesionTable);
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -952,6 +673,7 @@ void mitk::RelationStorage::LinkSegmentationToLesion(const SemanticTypes::CaseID
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::SegmentationTable);
   // retrieve a vector property that contains the valid lesion-IDs for the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -997,6 +719,7 @@ void mitk::RelationStorage::UnlinkSegmentationFromLesion(const SemanticTypes::Ca
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::SegmentationTable);
   // retrieve a vector property that contains the referenced ID of a segmentation (0. image ID 1. lesion ID)
   VectorProperty<std::string>* segmentationVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(segmentationID));
   if (nullptr == segmentationVectorProperty)
@@ -1027,6 +750,7 @@ void mitk::RelationStorage::RemoveLesion(const SemanticTypes::CaseID& caseID, co
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::LesionTable);
   // retrieve a vector property that contains the valid lesions of the current case
   VectorProperty<std::string>* lesionVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("lesions"));
   if (nullptr == lesionVectorProperty)
@@ -1080,6 +804,7 @@ void mitk::RelationStorage::RemoveLesionClass(const SemanticTypes::CaseID& caseI
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::LesionTable);
 
   // retrieve a vector property that contains the lesion class
   StringProperty* lesionClassProperty = dynamic_cast<StringProperty*>(propertyList->GetProperty(lesionClassID));
@@ -1132,6 +857,7 @@ void mitk::RelationStorage::AddControlPoint(const SemanticTypes::CaseID& caseID,
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ControlPointTable);
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>::Pointer controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   std::vector<std::string> controlPointsVectorPropertyValue;
@@ -1175,6 +901,7 @@ void mitk::RelationStorage::LinkImageToControlPoint(const SemanticTypes::CaseID&
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable);
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   if (nullptr == controlPointsVectorProperty)
@@ -1221,6 +948,7 @@ void mitk::RelationStorage::UnlinkImageFromControlPoint(const SemanticTypes::Cas
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable);
   // retrieve a vector property that contains the referenced ID of a date (0. information type 1. control point ID)
   VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
   if (nullptr == imageVectorProperty)
@@ -1251,6 +979,7 @@ void mitk::RelationStorage::RemoveControlPoint(const SemanticTypes::CaseID& case
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ControlPointTable);
   // retrieve a vector property that contains the valid controlPoint UIDs for the current case
   VectorProperty<std::string>* controlPointsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("controlpoints"));
   if (nullptr == controlPointsVectorProperty)
@@ -1285,6 +1014,7 @@ void mitk::RelationStorage::AddExaminationPeriod(const SemanticTypes::CaseID& ca
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ExaminationPeriodTable);
   // retrieve a vector property that contains the valid examination period UIDs for the current case
   VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
   std::vector<std::string> examinationPeriodsVectorPropertyValue;
@@ -1325,6 +1055,7 @@ void mitk::RelationStorage::RenameExaminationPeriod(const SemanticTypes::CaseID&
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ExaminationPeriodTable);
   // retrieve a vector property that contains the data of the given examination period
   VectorProperty<std::string>* examinationPeriodDataVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
   if (nullptr == examinationPeriodDataVectorProperty)
@@ -1357,6 +1088,7 @@ void mitk::RelationStorage::AddControlPointToExaminationPeriod(const SemanticTyp
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ExaminationPeriodTable);
 
   // retrieve a vector property that contains the represented control point UIDs of the given examination period
   VectorProperty<std::string>* controlPointUIDsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
@@ -1370,10 +1102,11 @@ void mitk::RelationStorage::AddControlPointToExaminationPeriod(const SemanticTyp
   // store the control point UID
   controlPointUIDsVectorPropertyValue.push_back(controlPoint.UID);
   // sort the vector according to the date of the control points referenced by the UIDs
-  auto lambda = [&caseID](const SemanticTypes::ID& leftControlPointUID, const SemanticTypes::ID& rightControlPointUID)
+  auto relationIndex = GetRelationIndex(caseID);
+  auto lambda = [&relationIndex](const SemanticTypes::ID& leftControlPointUID, const SemanticTypes::ID& rightControlPointUID)
   {
-    const auto& leftControlPoint = GenerateControlpoint(caseID, leftControlPointUID);
-    const auto& rightControlPoint = GenerateControlpoint(caseID, rightControlPointUID);
+    const auto& leftControlPoint = relationIndex->GetControlPoint(leftControlPointUID);
+    const auto& rightControlPoint = relationIndex->GetControlPoint(rightControlPointUID);
 
     return leftControlPoint.date <= rightControlPoint.date;
   };
@@ -1391,6 +1124,7 @@ void mitk::RelationStorage::RemoveControlPointFromExaminationPeriod(const Semant
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ExaminationPeriodTable);
 
   // retrieve a vector property that contains the represented control point UIDs of the given examination period
   VectorProperty<std::string>* controlPointUIDsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(examinationPeriod.UID));
@@ -1430,6 +1164,7 @@ void mitk::RelationStorage::RemoveExaminationPeriod(const SemanticTypes::CaseID&
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ExaminationPeriodTable);
   // retrieve a vector property that contains the valid examination period UIDs for the current case
   VectorProperty<std::string>::Pointer examinationPeriodsVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("examinationperiods"));
   if (nullptr == examinationPeriodsVectorProperty)
@@ -1463,6 +1198,7 @@ void mitk::RelationStorage::AddInformationTypeToImage(const SemanticTypes::CaseI
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable | RelationIndex::InformationTypeTable);
   // retrieve a vector property that contains the valid information types of the current case
   VectorProperty<std::string>::Pointer informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
   std::vector<std::string> informationTypesVectorPropertyValue;
@@ -1514,6 +1250,7 @@ void mitk::RelationStorage::RemoveInformationTypeFromImage(const SemanticTypes::
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::ImageTable);
   // retrieve a vector property that contains the referenced ID of an image (0. information type 1. control point ID)
   VectorProperty<std::string>* imageVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty(imageID));
   if (nullptr == imageVectorProperty)
@@ -1544,6 +1281,7 @@ void mitk::RelationStorage::RemoveInformationType(const SemanticTypes::CaseID& c
     MITK_DEBUG << "Could not find the property list " << caseID << " for the current MITK workbench / session.";
     return;
   }
+  RelationIndexUpdate relationIndexUpdate(caseID, propertyList, RelationIndex::InformationTypeTable);
   // retrieve a vector property that contains the valid information types of the current case
   VectorProperty<std::string>* informationTypesVectorProperty = dynamic_cast<VectorProperty<std::string>*>(propertyList->GetProperty("informationtypes"));
   if (nullptr == informationTypesVectorProperty)
@@ -13,12 +13,14 @@ found in the LICENSE file.
 #include "mitkSemanticRelationsInference.h"
 
 // semantic relations module
-#include "mitkControlPointManager.h"
 #include "mitkDICOMHelper.h"
 #include "mitkNodePredicates.h"
 #include "mitkRelationStorage.h"
 #include "mitkSemanticRelationException.h"
 
+// c++
+#include <unordered_set>
+
 /************************************************************************/
 /* functions to get instances / attributes                              */
 /************************************************************************/
@@ -92,45 +94,48 @@ mitk::SemanticTypes::LesionVector mitk::SemanticRelationsInference::GetAllLesion
   }
 
   SemanticTypes::LesionVector allLesionsOfImage;
-  // 1. get all segmentations that are connected to the given image
-  // 2. get the lesion of each segmentation
-  // 3. guarantee uniqueness of lesions
-  SemanticTypes::IDVector allSegmentationIDsOfImage = RelationStorage::GetAllSegmentationIDsOfImage(caseID, imageID);
-  for (const auto& segmentationID : allSegmentationIDsOfImage)
-  {
-    // get represented lesion of the current segmentation
-    SemanticTypes::Lesion representedLesion = RelationStorage::GetLesionOfSegmentation(caseID, segmentationID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return allLesionsOfImage;
+  }
+
+  // join the segmentations of the given image with their lesions; the UIDs are unique
+  for (const auto& lesionUID : relationIndex->GetAllLesionUIDsOfImages({ imageID }))
+  {
+    SemanticTypes::Lesion representedLesion = relationIndex->GetLesion(lesionUID);
     if (!representedLesion.UID.empty())
     {
       allLesionsOfImage.push_back(representedLesion);
     }
   }
 
-  // remove duplicate entries
   auto lessThan = [](const SemanticTypes::Lesion& lesionLeft, const SemanticTypes::Lesion& lesionRight)
   {
     return lesionLeft.UID < lesionRight.UID;
   };
 
-  auto equal = [](const SemanticTypes::Lesion& lesionLeft, const SemanticTypes::Lesion& lesionRight)
-  {
-    return lesionLeft.UID == lesionRight.UID;
-  };
-
   std::sort(allLesionsOfImage.begin(), allLesionsOfImage.end(), lessThan);
-  allLesionsOfImage.erase(std::unique(allLesionsOfImage.begin(), allLesionsOfImage.end(), equal), allLesionsOfImage.end());
 
   return allLesionsOfImage;
 }
 
 mitk::SemanticTypes::LesionVector mitk::SemanticRelationsInference::GetAllLesionsOfControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  SemanticTypes::LesionVector allLesions = RelationStorage::GetAllLesionsOfCase(caseID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return SemanticTypes::LesionVector();
+  }
+
+  // join the images of the given control point with their segmentations and the lesions of these segmentations
+  const auto lesionUIDsOfControlPoint = relationIndex->GetAllLesionUIDsOfImages(relationIndex->GetAllImageIDsOfControlPoint(controlPoint.UID));
+  SemanticTypes::LesionVector allLesions = relationIndex->GetAllLesions();
 
   // filter the lesions: use only those, where the associated data is connected to image data that refers to the given control point using a lambda function
-  auto lambda = [&caseID, &controlPoint](const SemanticTypes::Lesion& lesion)
+  auto lambda = [&lesionUIDsOfControlPoint](const SemanticTypes::Lesion& lesion)
   {
-    return !SpecificImageExists(caseID, lesion, controlPoint);
+    return lesionUIDsOfControlPoint.count(lesion.UID) == 0;
   };
 
   allLesions.erase(std::remove_if(allLesions.begin(), allLesions.end(), lambda), allLesions.end());
@@ -140,12 +145,20 @@ mitk::SemanticTypes::LesionVector mitk::SemanticRelationsInference::GetAllLesion
 
 mitk::SemanticTypes::LesionVector mitk::SemanticRelationsInference::GetAllLesionsOfInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  SemanticTypes::LesionVector allLesions = RelationStorage::GetAllLesionsOfCase(caseID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return SemanticTypes::LesionVector();
+  }
+
+  // join the images of the given information type with their segmentations and the lesions of these segmentations
+  const auto lesionUIDsOfInformationType = relationIndex->GetAllLesionUIDsOfImages(relationIndex->GetAllImageIDsOfInformationType(informationType));
+  SemanticTypes::LesionVector allLesions = relationIndex->GetAllLesions();
 
   // filter the lesions: use only those, where the associated data is connected to image data that refers to the given information type using a lambda function
-  auto lambda = [&caseID, &informationType](const SemanticTypes::Lesion& lesion)
+  auto lambda = [&lesionUIDsOfInformationType](const SemanticTypes::Lesion& lesion)
   {
-    return !SpecificImageExists(caseID, lesion, informationType);
+    return lesionUIDsOfInformationType.count(lesion.UID) == 0;
   };
 
   allLesions.erase(std::remove_if(allLesions.begin(), allLesions.end(), lambda), allLesions.end());
@@ -269,9 +282,10 @@ bool mitk::SemanticRelationsInference::IsLesionPresentAtControlPoint(const Seman
     mitkReThrow(e) << "Cannot get all image IDs of the given lesion to determine the lesion presence.";
   }
 
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
   for (const auto& imageIDOfLesion : allImageIDsOfLesion)
   {
-    auto imageControlPoint = RelationStorage::GetControlPointOfImage(caseID, imageIDOfLesion);
+    auto imageControlPoint = relationIndex->GetControlPointOfImage(imageIDOfLesion);
     if (imageControlPoint.date == controlPoint.date)
     {
       return true;
@@ -295,16 +309,20 @@ bool mitk::SemanticRelationsInference::InstanceExists(const DataNode* dataNode)
     return false;
   }
 
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return false;
+  }
+
   if (NodePredicates::GetImagePredicate()->CheckNode(dataNode))
   {
-    SemanticTypes::IDVector allImageIDsOfCase = RelationStorage::GetAllImageIDsOfCase(caseID);
-    return std::find(allImageIDsOfCase.begin(), allImageIDsOfCase.end(), dataNodeID) != allImageIDsOfCase.end();
+    return relationIndex->ContainsImage(dataNodeID);
   }
 
   if (NodePredicates::GetSegmentationPredicate()->CheckNode(dataNode))
   {
-    SemanticTypes::IDVector allSegmentationIDsOfCase = RelationStorage::GetAllSegmentationIDsOfCase(caseID);
-    return std::find(allSegmentationIDsOfCase.begin(), allSegmentationIDsOfCase.end(), dataNodeID) != allSegmentationIDsOfCase.end();
+    return relationIndex->ContainsSegmentation(dataNodeID);
   }
 
   return false;
@@ -312,45 +330,20 @@ bool mitk::SemanticRelationsInference::InstanceExists(const DataNode* dataNode)
 
 bool mitk::SemanticRelationsInference::InstanceExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  SemanticTypes::LesionVector allLesions = RelationStorage::GetAllLesionsOfCase(caseID);
-
-  // filter all lesions: check for equality with the given lesion using a lambda function
-  auto lambda = [&lesion](const SemanticTypes::Lesion& currentLesion)
-  {
-    return currentLesion.UID == lesion.UID;
-  };
-
-  const auto existingLesion = std::find_if(allLesions.begin(), allLesions.end(), lambda);
-
-  return existingLesion != allLesions.end();
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  return nullptr != relationIndex && relationIndex->ContainsLesion(lesion.UID);
 }
 
 mitk::SemanticTypes::IDVector mitk::SemanticRelationsInference::GetAllImageIDsOfLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  if (!InstanceExists(caseID, lesion))
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex || !relationIndex->ContainsLesion(lesion.UID))
   {
     mitkThrowException(SemanticRelationException) << "Could not find an existing lesion instance for the given caseID " << caseID << " and lesion " << lesion.UID << ".";
   }
 
-  SemanticTypes::IDVector allImageIDsOfLesion;
-  // 1. get all segmentations that define the lesion
-  // 2. get the parentID (imageID) of each segmentation
-  // 3. guarantee uniqueness of image IDs
-  SemanticTypes::IDVector allSegmentationIDsOfLesion = RelationStorage::GetAllSegmentationIDsOfLesion(caseID, lesion);
-  for (const auto& segmentationID : allSegmentationIDsOfLesion)
-  {
-    // get parent ID of the current segmentation ID
-    SemanticTypes::ID imageID = RelationStorage::GetImageIDOfSegmentation(caseID, segmentationID);
-    if(!imageID.empty())
-    {
-      allImageIDsOfLesion.push_back(imageID);
-    }
-  }
-
-  std::sort(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end());
-  allImageIDsOfLesion.erase(std::unique(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end()), allImageIDsOfLesion.end());
-
-  return allImageIDsOfLesion;
+  // join the segmentations that define the lesion with their parent images
+  return relationIndex->GetAllImageIDsOfLesion(lesion.UID);
 }
 
 mitk::SemanticTypes::IDVector mitk::SemanticRelationsInference::GetAllImageIDsOfExaminationPeriod(const SemanticTypes::CaseID& caseID, const SemanticTypes::ExaminationPeriod& examinationPeriod)
@@ -360,14 +353,15 @@ mitk::SemanticTypes::IDVector mitk::SemanticRelationsInference::GetAllImageIDsOf
     mitkThrowException(SemanticRelationException) << "Could not find an existing examination period for the given caseID " << caseID << " and examination period " << examinationPeriod.name << ".";
   }
 
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
   SemanticTypes::IDVector allImageIDsOfExaminationPeriod;
   // 1. get all control point UIDs of the examination period
   // 2. get all images of each control points to find all images of the examination period
   SemanticTypes::ControlPoint controlPoint;
   for (const auto& controlPointUID : examinationPeriod.controlPointUIDs)
   {
-    controlPoint = GetControlPointByUID(caseID, controlPointUID);
-    auto allImageIDsOfControlPoint = RelationStorage::GetAllImageIDsOfControlPoint(caseID, controlPoint);
+    controlPoint = relationIndex->GetControlPoint(controlPointUID);
+    const auto& allImageIDsOfControlPoint = relationIndex->GetAllImageIDsOfControlPoint(controlPoint.UID);
     allImageIDsOfExaminationPeriod.insert(allImageIDsOfExaminationPeriod.end(), allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end());
   }
 
@@ -398,12 +392,28 @@ mitk::SemanticTypes::ControlPoint mitk::SemanticRelationsInference::GetControlPo
 
 mitk::SemanticTypes::ControlPointVector mitk::SemanticRelationsInference::GetAllControlPointsOfLesion(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion)
 {
-  SemanticTypes::ControlPointVector allControlPoints = RelationStorage::GetAllControlPointsOfCase(caseID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex || !relationIndex->ContainsLesion(lesion.UID))
+  {
+    return SemanticTypes::ControlPointVector();
+  }
+
+  // join the segmentations of the given lesion with their images and the control points of these images
+  std::unordered_set<SemanticTypes::ID> controlPointUIDsOfLesion;
+  for (const auto& imageID : relationIndex->GetAllImageIDsOfLesion(lesion.UID))
+  {
+    if (relationIndex->ContainsImage(imageID))
+    {
+      controlPointUIDsOfLesion.insert(relationIndex->GetControlPointUIDOfImage(imageID));
+    }
+  }
+
+  SemanticTypes::ControlPointVector allControlPoints = relationIndex->GetAllControlPoints();
 
   // filter the control points: use only those, where the associated image data has a segmentation that refers to the given lesion using a lambda function
-  auto lambda = [&caseID, &lesion](const SemanticTypes::ControlPoint& controlPoint)
+  auto lambda = [&controlPointUIDsOfLesion](const SemanticTypes::ControlPoint& controlPoint)
   {
-    return !SpecificImageExists(caseID, lesion, controlPoint);
+    return controlPointUIDsOfLesion.count(controlPoint.UID) == 0;
   };
 
   allControlPoints.erase(std::remove_if(allControlPoints.begin(), allControlPoints.end(), lambda), allControlPoints.end());
@@ -413,12 +423,25 @@ mitk::SemanticTypes::ControlPointVector mitk::SemanticRelationsInference::GetAll
 
 mitk::SemanticTypes::ControlPointVector mitk::SemanticRelationsInference::GetAllControlPointsOfInformationType(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  SemanticTypes::ControlPointVector allControlPoints = RelationStorage::GetAllControlPointsOfCase(caseID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return SemanticTypes::ControlPointVector();
+  }
+
+  // join the images of the given information type with their control points
+  std::unordered_set<SemanticTypes::ID> controlPointUIDsOfInformationType;
+  for (const auto& imageID : relationIndex->GetAllImageIDsOfInformationType(informationType))
+  {
+    controlPointUIDsOfInformationType.insert(relationIndex->GetControlPointUIDOfImage(imageID));
+  }
+
+  SemanticTypes::ControlPointVector allControlPoints = relationIndex->GetAllControlPoints();
 
   // filter the control points: use only those, where the associated image data refers to the given information type using a lambda function
-  auto lambda = [&caseID, &informationType](const SemanticTypes::ControlPoint& controlPoint)
+  auto lambda = [&controlPointUIDsOfInformationType](const SemanticTypes::ControlPoint& controlPoint)
   {
-    return !SpecificImageExists(caseID, informationType, controlPoint);
+    return controlPointUIDsOfInformationType.count(controlPoint.UID) == 0;
   };
 
   allControlPoints.erase(std::remove_if(allControlPoints.begin(), allControlPoints.end(), lambda), allControlPoints.end());
@@ -428,38 +451,14 @@ mitk::SemanticTypes::ControlPointVector mitk::SemanticRelationsInference::GetAll
 
 bool mitk::SemanticRelationsInference::InstanceExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  SemanticTypes::ControlPointVector allControlPoints = RelationStorage::GetAllControlPointsOfCase(caseID);
-
-  // filter all control points: check for equality with the given control point using a lambda function
-  auto lambda = [&controlPoint](const SemanticTypes::ControlPoint& currentControlPoint) { return currentControlPoint.UID == controlPoint.UID; };
-  const auto existingControlPoint = std::find_if(allControlPoints.begin(), allControlPoints.end(), lambda);
-
-  if (existingControlPoint != allControlPoints.end())
-  {
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  return nullptr != relationIndex && relationIndex->ContainsControlPoint(controlPoint.UID);
 }
 
 bool mitk::SemanticRelationsInference::InstanceExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::ExaminationPeriod& examinationPeriod)
 {
-  SemanticTypes::ExaminationPeriodVector allExaminationPeriods = RelationStorage::GetAllExaminationPeriodsOfCase(caseID);
-
-  // filter all examination periods: check for equality with the given examination period using a lambda function
-  auto lambda = [&examinationPeriod](const SemanticTypes::ExaminationPeriod& currentExaminationPeriod) { return currentExaminationPeriod.UID == examinationPeriod.UID; };
-  const auto existingExaminationPeriod = std::find_if(allExaminationPeriods.begin(), allExaminationPeriods.end(), lambda);
-
-  if (existingExaminationPeriod != allExaminationPeriods.end())
-  {
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  return nullptr != relationIndex && relationIndex->ContainsExaminationPeriod(examinationPeriod.UID);
 }
 
 mitk::SemanticTypes::InformationType mitk::SemanticRelationsInference::GetInformationTypeOfImage(const DataNode* imageNode)
@@ -486,12 +485,25 @@ mitk::SemanticTypes::InformationType mitk::SemanticRelationsInference::GetInform
 
 mitk::SemanticTypes::InformationTypeVector mitk::SemanticRelationsInference::GetAllInformationTypesOfControlPoint(const SemanticTypes::CaseID& caseID, const SemanticTypes::ControlPoint& controlPoint)
 {
-  SemanticTypes::InformationTypeVector allInformationTypes = RelationStorage::GetAllInformationTypesOfCase(caseID);
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return SemanticTypes::InformationTypeVector();
+  }
+
+  // join the images of the given control point with their information types
+  std::unordered_set<SemanticTypes::InformationType> informationTypesOfControlPoint;
+  for (const auto& imageID : relationIndex->GetAllImageIDsOfControlPoint(controlPoint.UID))
+  {
+    informationTypesOfControlPoint.insert(relationIndex->GetInformationTypeOfImage(imageID));
+  }
+
+  SemanticTypes::InformationTypeVector allInformationTypes = relationIndex->GetAllInformationTypes();
 
   // filter the information types: use only those, where the associated data refers to the given control point using a lambda function
-  auto lambda = [&caseID, &controlPoint](const SemanticTypes::InformationType& informationType)
+  auto lambda = [&informationTypesOfControlPoint](const SemanticTypes::InformationType& informationType)
   {
-    return !SpecificImageExists(caseID, informationType, controlPoint);
+    return informationTypesOfControlPoint.count(informationType) == 0;
   };
 
   allInformationTypes.erase(std::remove_if(allInformationTypes.begin(), allInformationTypes.end(), lambda), allInformationTypes.end());
@@ -501,87 +513,54 @@ mitk::SemanticTypes::InformationTypeVector mitk::SemanticRelationsInference::Get
 
 bool mitk::SemanticRelationsInference::InstanceExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType)
 {
-  SemanticTypes::InformationTypeVector allInformationTypes = RelationStorage::GetAllInformationTypesOfCase(caseID);
-
-  // filter all information types: check for equality with the given information type using a lambda function
-  auto lambda = [&informationType](const SemanticTypes::InformationType& currentInformationType) { return currentInformationType == informationType; };
-  const auto existingInformationType = std::find_if(allInformationTypes.begin(), allInformationTypes.end(), lambda);
-
-  if (existingInformationType != allInformationTypes.end())
-  {
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  return nullptr != relationIndex && relationIndex->ContainsInformationType(informationType);
 }
 
 bool mitk::SemanticRelationsInference::SpecificImageExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion, const SemanticTypes::InformationType& informationType)
 {
-  SemanticTypes::IDVector allImageIDsOfLesion;
-  try
-  {
-    allImageIDsOfLesion = GetAllImageIDsOfLesion(caseID, lesion);
-  }
-  catch (const SemanticRelationException&)
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex || !relationIndex->ContainsLesion(lesion.UID))
   {
     return false;
   }
 
-  SemanticTypes::IDVector allImageIDsOfInformationType = RelationStorage::GetAllImageIDsOfInformationType(caseID, informationType);
-
-  std::sort(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end());
-  std::sort(allImageIDsOfInformationType.begin(), allImageIDsOfInformationType.end());
-  SemanticTypes::IDVector allImageIDsIntersection;
-  // set_intersection removes duplicated nodes, since 'GetAllImageIDsOfInformationType' only contains at most one of each node
-  std::set_intersection(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end(),
-    allImageIDsOfInformationType.begin(), allImageIDsOfInformationType.end(),
-    std::back_inserter(allImageIDsIntersection));
-
-  // if the vector of intersecting image IDs is empty, the information type does not contain the lesion
-  return !allImageIDsIntersection.empty();
+  // join the segmentations of the given lesion with their images and check the information type of these images
+  const auto allImageIDsOfLesion = relationIndex->GetAllImageIDsOfLesion(lesion.UID);
+  return std::any_of(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end(), [&relationIndex, &informationType](const SemanticTypes::ID& imageID)
+  {
+    return relationIndex->ContainsImage(imageID) && relationIndex->GetInformationTypeOfImage(imageID) == informationType;
+  });
 }
 
 bool mitk::SemanticRelationsInference::SpecificImageExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::Lesion& lesion, const SemanticTypes::ControlPoint& controlPoint)
 {
-  SemanticTypes::IDVector allImageIDsOfLesion;
-  try
-  {
-    allImageIDsOfLesion = GetAllImageIDsOfLesion(caseID, lesion);
-  }
-  catch (const SemanticRelationException&)
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex || !relationIndex->ContainsLesion(lesion.UID))
   {
     return false;
   }
 
-  SemanticTypes::IDVector allImageIDsOfControlPoint = RelationStorage::GetAllImageIDsOfControlPoint(caseID, controlPoint);
-
-  std::sort(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end());
-  std::sort(allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end());
-  SemanticTypes::IDVector allImageIDsIntersection;
-  // set_intersection removes duplicated nodes, since 'GetAllImageIDsOfControlPoint' only contains at most one of each node
-  std::set_intersection(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end(),
-    allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end(),
-    std::back_inserter(allImageIDsIntersection));
-
-  // if the vector of intersecting image IDs is empty, the control point does not contain the lesion
-  return !allImageIDsIntersection.empty();
+  // join the segmentations of the given lesion with their images and check the control point of these images
+  const auto allImageIDsOfLesion = relationIndex->GetAllImageIDsOfLesion(lesion.UID);
+  return std::any_of(allImageIDsOfLesion.begin(), allImageIDsOfLesion.end(), [&relationIndex, &controlPoint](const SemanticTypes::ID& imageID)
+  {
+    return relationIndex->ContainsImage(imageID) && relationIndex->GetControlPointUIDOfImage(imageID) == controlPoint.UID;
+  });
 }
 
 bool mitk::SemanticRelationsInference::SpecificImageExists(const SemanticTypes::CaseID& caseID, const SemanticTypes::InformationType& informationType, const SemanticTypes::ControlPoint& controlPoint)
 {
-  SemanticTypes::IDVector allImageIDsOfInformationType = RelationStorage::GetAllImageIDsOfInformationType(caseID, informationType);
-  SemanticTypes::IDVector allImageIDsOfControlPoint = RelationStorage::GetAllImageIDsOfControlPoint(caseID, controlPoint);
-
-  std::sort(allImageIDsOfInformationType.begin(), allImageIDsOfInformationType.end());
-  std::sort(allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end());
-  SemanticTypes::IDVector allImageIDsIntersection;
-  // set_intersection removes duplicated nodes
-  std::set_intersection(allImageIDsOfInformationType.begin(), allImageIDsOfInformationType.end(),
-    allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end(),
-    std::back_inserter(allImageIDsIntersection));
+  auto relationIndex = RelationStorage::GetRelationIndex(caseID);
+  if (nullptr == relationIndex)
+  {
+    return false;
+  }
 
-  // if the vector of intersecting image IDs is empty no image exists for the given information type and control point
-  return !allImageIDsIntersection.empty();
+  // check the information type of the images of the given control point
+  const auto& allImageIDsOfControlPoint = relationIndex->GetAllImageIDsOfControlPoint(controlPoint.UID);
+  return std::any_of(allImageIDsOfControlPoint.begin(), allImageIDsOfControlPoint.end(), [&relationIndex, &informationType](const SemanticTypes::ID& imageID)
+  {
+    return relationIndex->GetInformationTypeOfImage(imageID) == informationType;
+  });
 }
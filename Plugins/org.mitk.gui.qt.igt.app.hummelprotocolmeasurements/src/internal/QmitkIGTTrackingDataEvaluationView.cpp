@@ -1103,8 +1103,9 @@ mitk::Quaternion QmitkIGTTrackingDataEvaluationView::GetSLERPAverage(mitk::Navig
   mitk::Quaternion average;
 
   //build a vector of quaternions from the evaulation filter (caution always takes the first (0) input of the filter
+  //only the logged samples are available, these may be fewer than the analysed ones for long recordings
   std::vector<mitk::Quaternion> quaternions = std::vector<mitk::Quaternion>();
-  for (int i = 0; i < evaluationFilter->GetNumberOfAnalysedNavigationData(0); i++)
+  for (unsigned int i = 0; i < evaluationFilter->GetNumberOfLoggedNavigationData(0); i++)
   {
     mitk::Quaternion currentq = evaluationFilter->GetLoggedOrientation(i, 0);
 